@@ -1,84 +1,122 @@
-classdef AttitudeQuaternionEKF < iDynTree.IAttitudeEstimator & iDynTree.DiscreteExtendedKalmanFilterHelper
+classdef AttitudeQuaternionEKF < iDynTree.IAttitudeEstimator
   methods
-    function this = swig_this(self)
-      this = iDynTreeMEX(3, self);
-    end
     function self = AttitudeQuaternionEKF(varargin)
       self@iDynTree.IAttitudeEstimator(SwigRef.Null);
-      self@iDynTree.DiscreteExtendedKalmanFilterHelper(SwigRef.Null);
       if nargin==1 && strcmp(class(varargin{1}),'SwigRef')
         if ~isnull(varargin{1})
           self.swigPtr = varargin{1}.swigPtr;
         end
       else
-        tmp = iDynTreeMEX(1685, varargin{:});
+        tmp = iDynTreeMEX(1688, varargin{:});
         self.swigPtr = tmp.swigPtr;
         tmp.SwigClear();
       end
     end
     function varargout = getParameters(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1686, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1689, self, varargin{:});
     end
     function varargout = setParameters(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1687, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1690, self, varargin{:});
     end
     function varargout = setGravityDirection(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1688, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1691, self, varargin{:});
     end
     function varargout = setTimeStepInSeconds(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1689, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1692, self, varargin{:});
     end
     function varargout = setBiasCorrelationTimeFactor(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1690, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1693, self, varargin{:});
     end
     function varargout = useMagnetometerMeasurements(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1691, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1694, self, varargin{:});
     end
     function varargout = setMeasurementNoiseVariance(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1692, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1695, self, varargin{:});
     end
     function varargout = setSystemNoiseVariance(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1693, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1696, self, varargin{:});
     end
     function varargout = setInitialStateCovariance(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1694, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1697, self, varargin{:});
     end
     function varargout = initializeFilter(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1695, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1698, self, varargin{:});
     end
     function varargout = updateFilterWithMeasurements(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1696, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1699, self, varargin{:});
     end
     function varargout = propagateStates(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1697, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1700, self, varargin{:});
     end
     function varargout = getOrientationEstimateAsRotationMatrix(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1698, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1701, self, varargin{:});
     end
     function varargout = getOrientationEstimateAsQuaternion(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1699, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1702, self, varargin{:});
     end
     function varargout = getOrientationEstimateAsRPY(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1700, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1703, self, varargin{:});
     end
     function varargout = getInternalStateSize(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1701, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1704, self, varargin{:});
     end
     function varargout = getInternalState(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1702, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1705, self, varargin{:});
     end
     function varargout = getDefaultInternalInitialState(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1703, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1706, self, varargin{:});
     end
     function varargout = setInternalState(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1704, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1707, self, varargin{:});
     end
     function varargout = setInternalStateInitialOrientation(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1705, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1708, self, varargin{:});
+    end
+    function varargout = ekfPredict(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1709, self, varargin{:});
+    end
+    function varargout = ekfUpdate(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1710, self, varargin{:});
+    end
+    function varargout = ekfInit(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1711, self, varargin{:});
+    end
+    function varargout = ekfReset(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1712, self, varargin{:});
+    end
+    function varargout = ekfSetMeasurementVector(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1713, self, varargin{:});
+    end
+    function varargout = ekfSetInputVector(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1714, self, varargin{:});
+    end
+    function varargout = ekfSetInitialState(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1715, self, varargin{:});
+    end
+    function varargout = ekfSetStateCovariance(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1716, self, varargin{:});
+    end
+    function varargout = ekfSetSystemNoiseCovariance(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1717, self, varargin{:});
+    end
+    function varargout = ekfSetMeasurementNoiseCovariance(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1718, self, varargin{:});
+    end
+    function varargout = ekfGetStates(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1719, self, varargin{:});
+    end
+    function varargout = ekfGetStateCovariance(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1720, self, varargin{:});
+    end
+    function varargout = ekfSetUpdateMode(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1721, self, varargin{:});
+    end
+    function varargout = ekfGetUpdateMode(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1722, self, varargin{:});
     end
     function delete(self)
       if self.swigPtr
-        iDynTreeMEX(1706, self);
+        iDynTreeMEX(1723, self);
         self.SwigClear();
       end
     end
@@ -7,100 +7,100 @@ classdef AttitudeQuaternionEKFParameters < SwigRef
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1663, self);
+        varargout{1} = iDynTreeMEX(1666, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1664, self, varargin{1});
+        iDynTreeMEX(1667, self, varargin{1});
       end
     end
     function varargout = bias_correlation_time_factor(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1665, self);
+        varargout{1} = iDynTreeMEX(1668, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1666, self, varargin{1});
+        iDynTreeMEX(1669, self, varargin{1});
       end
     end
     function varargout = accelerometer_noise_variance(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1667, self);
+        varargout{1} = iDynTreeMEX(1670, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1668, self, varargin{1});
+        iDynTreeMEX(1671, self, varargin{1});
       end
     end
     function varargout = magnetometer_noise_variance(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1669, self);
+        varargout{1} = iDynTreeMEX(1672, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1670, self, varargin{1});
+        iDynTreeMEX(1673, self, varargin{1});
       end
     end
     function varargout = gyroscope_noise_variance(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1671, self);
+        varargout{1} = iDynTreeMEX(1674, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1672, self, varargin{1});
+        iDynTreeMEX(1675, self, varargin{1});
       end
     end
     function varargout = gyro_bias_noise_variance(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1673, self);
+        varargout{1} = iDynTreeMEX(1676, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1674, self, varargin{1});
+        iDynTreeMEX(1677, self, varargin{1});
       end
     end
     function varargout = initial_orientation_error_variance(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1675, self);
+        varargout{1} = iDynTreeMEX(1678, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1676, self, varargin{1});
+        iDynTreeMEX(1679, self, varargin{1});
       end
     end
     function varargout = initial_ang_vel_error_variance(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1677, self);
+        varargout{1} = iDynTreeMEX(1680, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1678, self, varargin{1});
+        iDynTreeMEX(1681, self, varargin{1});
       end
     end
     function varargout = initial_gyro_bias_error_variance(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1679, self);
+        varargout{1} = iDynTreeMEX(1682, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1680, self, varargin{1});
+        iDynTreeMEX(1683, self, varargin{1});
       end
     end
     function varargout = use_magnetometer_measurements(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1681, self);
+        varargout{1} = iDynTreeMEX(1684, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1682, self, varargin{1});
+        iDynTreeMEX(1685, self, varargin{1});
       end
     end
     function self = AttitudeQuaternionEKFParameters(varargin)
@@ -109,14 +109,14 @@ classdef AttitudeQuaternionEKFParameters < SwigRef
           self.swigPtr = varargin{1}.swigPtr;
         end
       else
-        tmp = iDynTreeMEX(1683, varargin{:});
+        tmp = iDynTreeMEX(1686, varargin{:});
         self.swigPtr = tmp.swigPtr;
         tmp.SwigClear();
       end
     end
     function delete(self)
       if self.swigPtr
-        iDynTreeMEX(1684, self);
+        iDynTreeMEX(1687, self);
         self.SwigClear();
       end
     end
@@ -7,40 +7,40 @@ classdef ColorViz < SwigRef
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1793, self);
+        varargout{1} = iDynTreeMEX(1810, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1794, self, varargin{1});
+        iDynTreeMEX(1811, self, varargin{1});
       end
     end
     function varargout = g(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1795, self);
+        varargout{1} = iDynTreeMEX(1812, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1796, self, varargin{1});
+        iDynTreeMEX(1813, self, varargin{1});
       end
     end
     function varargout = b(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1797, self);
+        varargout{1} = iDynTreeMEX(1814, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1798, self, varargin{1});
+        iDynTreeMEX(1815, self, varargin{1});
       end
     end
     function varargout = a(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1799, self);
+        varargout{1} = iDynTreeMEX(1816, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1800, self, varargin{1});
+        iDynTreeMEX(1817, self, varargin{1});
       end
     end
     function self = ColorViz(varargin)
@@ -49,14 +49,14 @@ classdef ColorViz < SwigRef
           self.swigPtr = varargin{1}.swigPtr;
         end
       else
-        tmp = iDynTreeMEX(1801, varargin{:});
+        tmp = iDynTreeMEX(1818, varargin{:});
         self.swigPtr = tmp.swigPtr;
         tmp.SwigClear();
       end
     end
     function delete(self)
       if self.swigPtr
-        iDynTreeMEX(1802, self);
+        iDynTreeMEX(1819, self);
         self.SwigClear();
       end
     end
@@ -4,118 +4,118 @@ classdef ConvexHullProjectionConstraint < SwigRef
       this = iDynTreeMEX(3, self);
     end
     function varargout = setActive(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1901, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1918, self, varargin{:});
     end
     function varargout = isActive(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1902, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1919, self, varargin{:});
     end
     function varargout = getNrOfConstraints(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1903, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1920, self, varargin{:});
     end
     function varargout = projectedConvexHull(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1904, self);
+        varargout{1} = iDynTreeMEX(1921, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1905, self, varargin{1});
+        iDynTreeMEX(1922, self, varargin{1});
       end
     end
     function varargout = A(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1906, self);
+        varargout{1} = iDynTreeMEX(1923, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1907, self, varargin{1});
+        iDynTreeMEX(1924, self, varargin{1});
       end
     end
     function varargout = b(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1908, self);
+        varargout{1} = iDynTreeMEX(1925, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1909, self, varargin{1});
+        iDynTreeMEX(1926, self, varargin{1});
       end
     end
     function varargout = P(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1910, self);
+        varargout{1} = iDynTreeMEX(1927, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1911, self, varargin{1});
+        iDynTreeMEX(1928, self, varargin{1});
       end
     end
     function varargout = Pdirection(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1912, self);
+        varargout{1} = iDynTreeMEX(1929, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1913, self, varargin{1});
+        iDynTreeMEX(1930, self, varargin{1});
       end
     end
     function varargout = AtimesP(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1914, self);
+        varargout{1} = iDynTreeMEX(1931, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1915, self, varargin{1});
+        iDynTreeMEX(1932, self, varargin{1});
       end
     end
     function varargout = o(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1916, self);
+        varargout{1} = iDynTreeMEX(1933, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1917, self, varargin{1});
+        iDynTreeMEX(1934, self, varargin{1});
       end
     end
     function varargout = buildConvexHull(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1918, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1935, self, varargin{:});
     end
     function varargout = supportFrameIndices(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1919, self);
+        varargout{1} = iDynTreeMEX(1936, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1920, self, varargin{1});
+        iDynTreeMEX(1937, self, varargin{1});
       end
     end
     function varargout = absoluteFrame_X_supportFrame(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1921, self);
+        varargout{1} = iDynTreeMEX(1938, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1922, self, varargin{1});
+        iDynTreeMEX(1939, self, varargin{1});
       end
     end
     function varargout = project(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1923, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1940, self, varargin{:});
     end
     function varargout = computeMargin(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1924, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1941, self, varargin{:});
     end
     function varargout = setProjectionAlongDirection(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1925, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1942, self, varargin{:});
     end
     function varargout = projectAlongDirection(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1926, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1943, self, varargin{:});
     end
     function self = ConvexHullProjectionConstraint(varargin)
       if nargin==1 && strcmp(class(varargin{1}),'SwigRef')
@@ -123,14 +123,14 @@ classdef ConvexHullProjectionConstraint < SwigRef
           self.swigPtr = varargin{1}.swigPtr;
         end
       else
-        tmp = iDynTreeMEX(1927, varargin{:});
+        tmp = iDynTreeMEX(1944, varargin{:});
         self.swigPtr = tmp.swigPtr;
         tmp.SwigClear();
       end
     end
     function delete(self)
       if self.swigPtr
-        iDynTreeMEX(1928, self);
+        iDynTreeMEX(1945, self);
         self.SwigClear();
       end
     end
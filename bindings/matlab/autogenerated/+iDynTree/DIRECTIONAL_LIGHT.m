@@ -1,7 +1,7 @@
 function v = DIRECTIONAL_LIGHT()
   persistent vInitialized;
   if isempty(vInitialized)
-    vInitialized = iDynTreeMEX(0, 33);
+    vInitialized = iDynTreeMEX(0, 37);
   end
   v = vInitialized;
 end
@@ -60,9 +60,15 @@ classdef DiscreteExtendedKalmanFilterHelper < SwigRef
     function varargout = ekfGetStateCovariance(self,varargin)
       [varargout{1:nargout}] = iDynTreeMEX(1658, self, varargin{:});
     end
+    function varargout = ekfSetUpdateMode(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1659, self, varargin{:});
+    end
+    function varargout = ekfGetUpdateMode(self,varargin)
+      [varargout{1:nargout}] = iDynTreeMEX(1660, self, varargin{:});
+    end
     function delete(self)
       if self.swigPtr
-        iDynTreeMEX(1659, self);
+        iDynTreeMEX(1661, self);
         self.SwigClear();
       end
     end
@@ -0,0 +1,7 @@
+function v = EKF_UPDATE_CHOLESKY()
+  persistent vInitialized;
+  if isempty(vInitialized)
+    vInitialized = iDynTreeMEX(0, 33);
+  end
+  v = vInitialized;
+end
@@ -0,0 +1,7 @@
+function v = EKF_UPDATE_JOSEPH()
+  persistent vInitialized;
+  if isempty(vInitialized)
+    vInitialized = iDynTreeMEX(0, 34);
+  end
+  v = vInitialized;
+end
@@ -0,0 +1,7 @@
+function v = EKF_UPDATE_SEQUENTIAL()
+  persistent vInitialized;
+  if isempty(vInitialized)
+    vInitialized = iDynTreeMEX(0, 35);
+  end
+  v = vInitialized;
+end
@@ -0,0 +1,7 @@
+function v = EKF_UPDATE_STANDARD()
+  persistent vInitialized;
+  if isempty(vInitialized)
+    vInitialized = iDynTreeMEX(0, 32);
+  end
+  v = vInitialized;
+end
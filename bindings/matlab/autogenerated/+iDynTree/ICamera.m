@@ -5,18 +5,18 @@ classdef ICamera < SwigRef
     end
     function delete(self)
       if self.swigPtr
-        iDynTreeMEX(1789, self);
+        iDynTreeMEX(1806, self);
         self.SwigClear();
       end
     end
     function varargout = setPosition(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1790, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1807, self, varargin{:});
     end
     function varargout = setTarget(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1791, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1808, self, varargin{:});
     end
     function varargout = setUpVector(self,varargin)
-      [varargout{1:nargout}] = iDynTreeMEX(1792, self, varargin{:});
+      [varargout{1:nargout}] = iDynTreeMEX(1809, self, varargin{:});
     end
     function self = ICamera(varargin)
       if nargin==1 && strcmp(class(varargin{1}),'SwigRef')
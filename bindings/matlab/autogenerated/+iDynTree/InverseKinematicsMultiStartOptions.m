@@ -0,0 +1,86 @@
+classdef InverseKinematicsMultiStartOptions < SwigRef
+  methods
+    function this = swig_this(self)
+      this = iDynTreeMEX(3, self);
+    end
+    function varargout = jointsSeeds(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1947, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1948, self, varargin{1});
+      end
+    end
+    function varargout = nrOfRandomSeeds(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1949, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1950, self, varargin{1});
+      end
+    end
+    function varargout = randomSeed(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1951, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1952, self, varargin{1});
+      end
+    end
+    function varargout = nrOfThreads(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1953, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1954, self, varargin{1});
+      end
+    end
+    function varargout = costThreshold(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1955, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1956, self, varargin{1});
+      end
+    end
+    function varargout = distinctSolutionsTolerance(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1957, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1958, self, varargin{1});
+      end
+    end
+    function self = InverseKinematicsMultiStartOptions(varargin)
+      if nargin==1 && strcmp(class(varargin{1}),'SwigRef')
+        if ~isnull(varargin{1})
+          self.swigPtr = varargin{1}.swigPtr;
+        end
+      else
+        tmp = iDynTreeMEX(1959, varargin{:});
+        self.swigPtr = tmp.swigPtr;
+        tmp.SwigClear();
+      end
+    end
+    function delete(self)
+      if self.swigPtr
+        iDynTreeMEX(1960, self);
+        self.SwigClear();
+      end
+    end
+  end
+  methods(Static)
+  end
+end
@@ -1,7 +1,7 @@
 function v = InverseKinematicsRotationParametrizationQuaternion()
   persistent vInitialized;
   if isempty(vInitialized)
-    vInitialized = iDynTreeMEX(0, 34);
+    vInitialized = iDynTreeMEX(0, 38);
   end
   v = vInitialized;
 end
@@ -1,7 +1,7 @@
 function v = InverseKinematicsRotationParametrizationRollPitchYaw()
   persistent vInitialized;
   if isempty(vInitialized)
-    vInitialized = iDynTreeMEX(0, 35);
+    vInitialized = iDynTreeMEX(0, 39);
   end
   v = vInitialized;
 end
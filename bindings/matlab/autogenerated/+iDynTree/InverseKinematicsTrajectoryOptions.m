@@ -0,0 +1,56 @@
+classdef InverseKinematicsTrajectoryOptions < SwigRef
+  methods
+    function this = swig_this(self)
+      this = iDynTreeMEX(3, self);
+    end
+    function varargout = nrOfSegments(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1961, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1962, self, varargin{1});
+      end
+    end
+    function varargout = nrOfThreads(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1963, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1964, self, varargin{1});
+      end
+    end
+    function varargout = smoothnessWeight(self, varargin)
+      narginchk(1, 2)
+      if nargin==1
+        nargoutchk(0, 1)
+        varargout{1} = iDynTreeMEX(1965, self);
+      else
+        nargoutchk(0, 0)
+        iDynTreeMEX(1966, self, varargin{1});
+      end
+    end
+    function self = InverseKinematicsTrajectoryOptions(varargin)
+      if nargin==1 && strcmp(class(varargin{1}),'SwigRef')
+        if ~isnull(varargin{1})
+          self.swigPtr = varargin{1}.swigPtr;
+        end
+      else
+        tmp = iDynTreeMEX(1967, varargin{:});
+        self.swigPtr = tmp.swigPtr;
+        tmp.SwigClear();
+      end
+    end
+    function delete(self)
+      if self.swigPtr
+        iDynTreeMEX(1968, self);
+        self.SwigClear();
+      end
+    end
+  end
+  methods(Static)
+  end
+end
@@ -1,7 +1,7 @@
 function v = InverseKinematicsTreatTargetAsConstraintPositionOnly()
   persistent vInitialized;
   if isempty(vInitialized)
-    vInitialized = iDynTreeMEX(0, 37);
+    vInitialized = iDynTreeMEX(0, 41);
   end
   v = vInitialized;
 end
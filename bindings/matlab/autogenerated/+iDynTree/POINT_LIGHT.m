@@ -1,7 +1,7 @@
 function v = POINT_LIGHT()
   persistent vInitialized;
   if isempty(vInitialized)
-    vInitialized = iDynTreeMEX(0, 32);
+    vInitialized = iDynTreeMEX(0, 36);
   end
   v = vInitialized;
 end
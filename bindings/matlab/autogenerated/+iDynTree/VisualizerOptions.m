@@ -7,40 +7,40 @@ classdef VisualizerOptions < SwigRef
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1858, self);
+        varargout{1} = iDynTreeMEX(1875, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1859, self, varargin{1});
+        iDynTreeMEX(1876, self, varargin{1});
       end
     end
     function varargout = winWidth(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1860, self);
+        varargout{1} = iDynTreeMEX(1877, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1861, self, varargin{1});
+        iDynTreeMEX(1878, self, varargin{1});
       end
     end
     function varargout = winHeight(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1862, self);
+        varargout{1} = iDynTreeMEX(1879, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1863, self, varargin{1});
+        iDynTreeMEX(1880, self, varargin{1});
       end
     end
     function varargout = rootFrameArrowsDimension(self, varargin)
       narginchk(1, 2)
       if nargin==1
         nargoutchk(0, 1)
-        varargout{1} = iDynTreeMEX(1864, self);
+        varargout{1} = iDynTreeMEX(1881, self);
       else
         nargoutchk(0, 0)
-        iDynTreeMEX(1865, self, varargin{1});
+        iDynTreeMEX(1882, self, varargin{1});
       end
     end
     function self = VisualizerOptions(varargin)
@@ -49,14 +49,14 @@ classdef VisualizerOptions < SwigRef
           self.swigPtr = varargin{1}.swigPtr;
         end
       else
-        tmp = iDynTreeMEX(1866, varargin{:});
+        tmp = iDynTreeMEX(1883, varargin{:});
         self.swigPtr = tmp.swigPtr;
         tmp.SwigClear();
       end
     end
     function delete(self)
       if self.swigPtr
-        iDynTreeMEX(1867, self);
+        iDynTreeMEX(1884, self);
         self.SwigClear();
       end
     end
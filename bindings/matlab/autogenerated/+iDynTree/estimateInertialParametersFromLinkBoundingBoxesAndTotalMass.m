@@ -1,3 +1,3 @@
 function varargout = estimateInertialParametersFromLinkBoundingBoxesAndTotalMass(varargin)
-  [varargout{1:nargout}] = iDynTreeMEX(1707, varargin{:});
+  [varargout{1:nargout}] = iDynTreeMEX(1724, varargin{:});
 end
@@ -1,3 +1,3 @@
 function v = output_dimensions_with_magnetometer()
-  v = iDynTreeMEX(1660);
+  v = iDynTreeMEX(1662);
 end
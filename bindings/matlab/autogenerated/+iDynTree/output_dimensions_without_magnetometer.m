@@ -1,3 +1,3 @@
 function v = output_dimensions_without_magnetometer()
-  v = iDynTreeMEX(1661);
+  v = iDynTreeMEX(1663);
 end
@@ -0,0 +1,3 @@
+function v = qekf_state_dimensions()
+  v = iDynTreeMEX(1665);
+end
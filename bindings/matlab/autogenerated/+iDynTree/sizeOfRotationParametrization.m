@@ -1,3 +1,3 @@
 function varargout = sizeOfRotationParametrization(varargin)
-  [varargout{1:nargout}] = iDynTreeMEX(1929, varargin{:});
+  [varargout{1:nargout}] = iDynTreeMEX(1946, varargin{:});
 end
@@ -62,6 +62,11 @@ if(NOT TARGET LibXml2::LibXml2)
   find_package(LibXml2 REQUIRED)
 endif()
 
+# Threads are used for the parallel computations (i.e. iDynTree::ThreadPool)
+if(NOT TARGET Threads::Threads)
+  find_package(Threads REQUIRED)
+endif()
+
 idyntree_handle_dependency(YARP COMPONENTS os dev math rosmsg idl_tools MAIN_TARGET YARP::YARP_os)
 set(YARP_REQUIRED_VERSION 3.3)
 if(IDYNTREE_USES_YARP AND YARP_FOUND)
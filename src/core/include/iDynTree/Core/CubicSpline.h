@@ -15,6 +15,8 @@
 #include <vector>
 #include <iDynTree/Core/VectorFixSize.h>
 #include <iDynTree/Core/VectorDynSize.h>
+#include <iDynTree/Core/MatrixView.h>
+#include <iDynTree/Core/Span.h>
 
 namespace iDynTree
 {
@@ -47,6 +49,106 @@ namespace iDynTree
         double evaluatePoint(double t);
         double evaluatePoint(double t, double& velocity, double& acceleration);
     };
+
+    /**
+     * Set of cubic splines, one for each channel, sharing the same time knots.
+     *
+     * Each channel is interpolated as in CubicSpline, but the intermediate velocities of all the channels
+     * are computed with a single factorization of the (shared) tridiagonal system, and the coefficients are
+     * stored segment by segment, with the same coefficient of all the channels stored contiguously.
+     * In this way a single segment lookup is needed to evaluate all the channels, and the evaluation
+     * of the channels is vectorized.
+     *
+     * The segment used in the last evaluation is cached, so that the lookup takes constant time
+     * when the spline is evaluated at increasing times (as in a control loop), while a binary search is used otherwise.
+     */
+    class MultiCubicSpline {
+        size_t m_nrOfChannels;
+        iDynTree::VectorDynSize m_time;
+        iDynTree::VectorDynSize m_T;
+        std::vector<double> m_y; ///< knots x channels, row major
+        std::vector<double> m_velocities; ///< knots x channels, row major
+        std::vector<double> m_coefficients; ///< for each segment, 4 planes of size equal to the number of channels
+        std::vector<double> m_thomasBuffer; ///< modified super-diagonal of the tridiagonal system
+        std::vector<double> m_evaluationBuffer; ///< used to evaluate the splines on column major matrices
+
+        std::vector<double> m_v0;
+        std::vector<double> m_vf;
+        std::vector<double> m_a0;
+        std::vector<double> m_af;
+
+        size_t m_lastSegment;
+        bool m_areCoefficientsUpdated;
+
+        bool computePhasesDuration();
+        void computeIntermediateVelocities();
+        bool computeCoefficients();
+        size_t findSegment(double t);
+        bool checkCoefficients(const char* methodName);
+        void evaluateChannels(double t, double* positions, double* velocities, double* accelerations);
+
+    public:
+        MultiCubicSpline();
+
+        /**
+         * Set the knots of the splines.
+         *
+         * If the number of channels changes, the initial and final conditions are set to zero.
+         *
+         * @param[in] time the time of the knots, strictly increasing.
+         * @param[in] yData matrix with a row for each knot and a column for each channel.
+         * @return true if all went well, false otherwise.
+         */
+        bool setData(const iDynTree::VectorDynSize& time, iDynTree::MatrixView<const double> yData);
+
+        /**
+         * Set the initial velocity and acceleration of each channel. Their size must be equal to getNrOfChannels().
+         */
+        bool setInitialConditions(iDynTree::Span<const double> initialVelocities,
+                                  iDynTree::Span<const double> initialAccelerations);
+
+        /**
+         * Set the final velocity and acceleration of each channel. Their size must be equal to getNrOfChannels().
+         */
+        bool setFinalConditions(iDynTree::Span<const double> finalVelocities,
+                                iDynTree::Span<const double> finalAccelerations);
+
+        size_t getNrOfChannels() const;
+
+        size_t getNrOfKnots() const;
+
+        /**
+         * Evaluate all the channels at time t.
+         *
+         * Before the first knot (after the last one), the position of the first (last) knot
+         * and the initial (final) conditions are returned.
+         *
+         * @param[out] positions the position of each channel, of size getNrOfChannels().
+         * @return true if all went well, false otherwise.
+         */
+        bool evaluatePoint(double t, iDynTree::Span<double> positions);
+
+        bool evaluatePoint(double t,
+                           iDynTree::Span<double> positions,
+                           iDynTree::Span<double> velocities,
+                           iDynTree::Span<double> accelerations);
+
+        /**
+         * Evaluate all the channels at a sequence of times.
+         *
+         * The evaluation is faster if the times are sorted in increasing order.
+         *
+         * @param[in] times the evaluation times.
+         * @param[out] positions matrix with a row for each time and a column for each channel.
+         * @return true if all went well, false otherwise.
+         */
+        bool evaluateTrajectory(iDynTree::Span<const double> times, iDynTree::MatrixView<double> positions);
+
+        bool evaluateTrajectory(iDynTree::Span<const double> times,
+                                iDynTree::MatrixView<double> positions,
+                                iDynTree::MatrixView<double> velocities,
+                                iDynTree::MatrixView<double> accelerations);
+    };
 }
 
 #endif
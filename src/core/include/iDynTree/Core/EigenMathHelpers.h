@@ -13,6 +13,8 @@
 
 #include <Eigen/Dense>
 
+#include <algorithm>
+
 namespace iDynTree
 {
 
@@ -70,6 +72,437 @@ void pseudoInverse(const MapType A,
     pseudoInverse_helper1(A, svdDecomposition, Apinv, tolerance, computationOptions);
 }
 
+/**
+ * Method used by PseudoInverseSolver.
+ */
+enum class PseudoInverseSolverMethod
+{
+    /**
+     * Singular value decomposition, the singular values lower than the tolerance are discarded.
+     */
+    TruncatedSVD,
+
+    /**
+     * Damped least squares (Tikhonov regularization), i.e. \f$ A^T (A A^T + \lambda^2 I)^{-1} \f$,
+     * computed with the Cholesky decomposition of the smallest of \f$ A A^T \f$ and \f$ A^T A \f$.
+     */
+    DampedLeastSquares,
+
+    /**
+     * Complete orthogonal decomposition (rank revealing QR), the pivots lower than the tolerance are discarded.
+     * It is faster than the SVD, and gives the same minimum norm solution.
+     */
+    CompleteOrthogonalDecomposition
+};
+
+/**
+ * Solver of \f$ x = A^\dagger b \f$ that reuses its workspace between calls.
+ *
+ * Differently from pseudoInverse, the decompositions and all the intermediate buffers are
+ * stored in the object, so once it has been resized (or after the first call to compute())
+ * repeated calls of compute() and solve() with matrices of the same size do not allocate memory.
+ * solve() never forms the explicit pseudo-inverse, that can still be obtained with pseudoInverse().
+ *
+ * Usage:
+ * \code
+ * PseudoInverseSolver solver(rows, cols, PseudoInverseSolverMethod::DampedLeastSquares);
+ * solver.setDamping(1e-2);
+ * // at each control cycle
+ * solver.compute(J);
+ * solver.solve(v, qdot);
+ * \endcode
+ */
+class PseudoInverseSolver
+{
+public:
+    PseudoInverseSolver(PseudoInverseSolverMethod method = PseudoInverseSolverMethod::TruncatedSVD)
+    : m_method(method)
+    , m_tolerance(1e-9)
+    , m_damping(1e-3)
+    , m_rows(0)
+    , m_cols(0)
+    , m_rank(0)
+    , m_isComputed(false)
+    {
+    }
+
+    PseudoInverseSolver(Eigen::Index rows, Eigen::Index cols,
+                        PseudoInverseSolverMethod method = PseudoInverseSolverMethod::TruncatedSVD)
+    : PseudoInverseSolver(method)
+    {
+        resize(rows, cols);
+    }
+
+    /**
+     * Allocate the workspace for the decomposition of a rows x cols matrix with the current method.
+     */
+    void resize(Eigen::Index rows, Eigen::Index cols)
+    {
+        m_rows = rows;
+        m_cols = cols;
+        m_isComputed = false;
+        const Eigen::Index minSize = (std::min)(rows, cols);
+
+        switch (m_method)
+        {
+            case PseudoInverseSolverMethod::TruncatedSVD:
+                m_svd = Eigen::JacobiSVD<Eigen::MatrixXd>(rows, cols, Eigen::ComputeThinU | Eigen::ComputeThinV);
+                m_singularValuesInverse.resize(minSize);
+                m_workspace.resize(minSize);
+                m_matrixWorkspace.resize(cols, minSize);
+                break;
+            case PseudoInverseSolverMethod::DampedLeastSquares:
+                // A is stored as the minSize x maxSize matrix M (A if rows <= cols, A^T otherwise),
+                // so that all the workspaces have the same shape for wide and tall matrices
+                m_matrix.resize(minSize, (std::max)(rows, cols));
+                m_llt = Eigen::LLT<Eigen::MatrixXd>(minSize);
+                m_dampedMatrix.resize(minSize, minSize);
+                m_workspace.resize(minSize);
+                m_matrixWorkspace.resize(minSize, (std::max)(rows, cols));
+                break;
+            case PseudoInverseSolverMethod::CompleteOrthogonalDecomposition:
+                m_cod = Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd>(rows, cols);
+                m_workspace.resize((std::max)(rows, cols));
+                m_householderWorkspace.resize((std::max)(rows, cols));
+                m_rhs.resize(rows);
+                break;
+        }
+    }
+
+    void setMethod(PseudoInverseSolverMethod method)
+    {
+        if (method != m_method)
+        {
+            m_method = method;
+            resize(m_rows, m_cols);
+        }
+    }
+
+    PseudoInverseSolverMethod method() const
+    {
+        return m_method;
+    }
+
+    /**
+     * Set the tolerance used by TruncatedSVD and CompleteOrthogonalDecomposition:
+     * the singular values (pivots) not greater than the tolerance are considered zero.
+     */
+    void setTolerance(double tolerance)
+    {
+        m_tolerance = tolerance;
+    }
+
+    double tolerance() const
+    {
+        return m_tolerance;
+    }
+
+    /**
+     * Set the damping factor \f$ \lambda \f$ used by DampedLeastSquares.
+     */
+    void setDamping(double damping)
+    {
+        m_damping = damping;
+    }
+
+    double damping() const
+    {
+        return m_damping;
+    }
+
+    Eigen::Index rows() const
+    {
+        return m_rows;
+    }
+
+    Eigen::Index cols() const
+    {
+        return m_cols;
+    }
+
+    /**
+     * Rank of the decomposed matrix, i.e. the number of singular values (pivots) greater than the tolerance.
+     * For DampedLeastSquares, the smallest dimension of the matrix.
+     */
+    Eigen::Index rank() const
+    {
+        return m_rank;
+    }
+
+    /**
+     * Decompose A. If the size of A differs from the one of the workspace, the workspace is resized.
+     *
+     * @return true if all went well, false otherwise.
+     */
+    template <typename Derived>
+    bool compute(const Eigen::MatrixBase<Derived>& A)
+    {
+        if (A.rows() != m_rows || A.cols() != m_cols)
+        {
+            resize(A.rows(), A.cols());
+        }
+
+        m_isComputed = false;
+        const Eigen::Index minSize = (std::min)(m_rows, m_cols);
+
+        switch (m_method)
+        {
+            case PseudoInverseSolverMethod::TruncatedSVD:
+            {
+                m_svd.compute(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+                m_rank = 0;
+                for (Eigen::Index idx = 0; idx < minSize; idx++)
+                {
+                    if (m_tolerance > 0 && m_svd.singularValues()(idx) > m_tolerance)
+                    {
+                        m_singularValuesInverse(idx) = 1.0 / m_svd.singularValues()(idx);
+                        m_rank++;
+                    }
+                    else
+                    {
+                        m_singularValuesInverse(idx) = 0.0;
+                    }
+                }
+                break;
+            }
+            case PseudoInverseSolverMethod::DampedLeastSquares:
+            {
+                // M M^T is A A^T for wide matrices and A^T A for tall ones
+                if (m_rows <= m_cols)
+                {
+                    m_matrix = A;
+                }
+                else
+                {
+                    m_matrix = A.transpose();
+                }
+                m_dampedMatrix.noalias() = m_matrix * m_matrix.transpose();
+                m_dampedMatrix.diagonal().array() += m_damping * m_damping;
+                m_llt.compute(m_dampedMatrix);
+                if (m_llt.info() != Eigen::Success)
+                {
+                    return false;
+                }
+                m_rank = minSize;
+                break;
+            }
+            case PseudoInverseSolverMethod::CompleteOrthogonalDecomposition:
+            {
+                // The Z and T factors are built with the rank given by the threshold set before the decomposition,
+                // while Eigen needs a threshold relative to the maximum pivot, that is known only after it.
+                // If the two ranks differ, decompose A again with the threshold corresponding to the tolerance.
+                m_cod.compute(A);
+                const double maxPivot = m_cod.maxPivot();
+                if (maxPivot > m_tolerance && maxPivot > 0)
+                {
+                    const Eigen::Index decompositionRank = m_cod.rank();
+                    m_cod.setThreshold(m_tolerance / maxPivot);
+                    if (m_cod.rank() != decompositionRank)
+                    {
+                        m_cod.compute(A);
+                    }
+                    m_rank = m_cod.rank();
+                }
+                else
+                {
+                    m_rank = 0;
+                }
+                break;
+            }
+        }
+
+        m_isComputed = true;
+        return true;
+    }
+
+    /**
+     * Compute \f$ x = A^\dagger b \f$, where A is the matrix passed to the last call of compute().
+     *
+     * @param[in] b vector of size rows().
+     * @param[out] x vector of size cols(), it can be an Eigen::Map.
+     * @return true if all went well, false otherwise.
+     */
+    template <typename RhsType, typename SolutionType>
+    bool solve(const Eigen::MatrixBase<RhsType>& b, const Eigen::MatrixBase<SolutionType>& x_)
+    {
+        Eigen::MatrixBase<SolutionType>& x = const_cast<Eigen::MatrixBase<SolutionType>&>(x_);
+
+        if (!m_isComputed || b.rows() != m_rows || b.cols() != 1 || x.rows() != m_cols || x.cols() != 1)
+        {
+            return false;
+        }
+
+        switch (m_method)
+        {
+            case PseudoInverseSolverMethod::TruncatedSVD:
+            {
+                // x = V S^-1 U^T b
+                const Eigen::Index minSize = m_singularValuesInverse.size();
+                m_workspace.noalias() = m_svd.matrixU().leftCols(minSize).transpose() * b;
+                m_workspace.array() *= m_singularValuesInverse.array();
+                x.noalias() = m_svd.matrixV().leftCols(minSize) * m_workspace;
+                break;
+            }
+            case PseudoInverseSolverMethod::DampedLeastSquares:
+            {
+                if (m_rows <= m_cols)
+                {
+                    // x = A^T (A A^T + l^2 I)^-1 b
+                    m_workspace = b;
+                    m_llt.solveInPlace(m_workspace);
+                    x.noalias() = m_matrix.transpose() * m_workspace;
+                }
+                else
+                {
+                    // x = (A^T A + l^2 I)^-1 A^T b
+                    x.noalias() = m_matrix * b;
+                    m_llt.solveInPlace(x);
+                }
+                break;
+            }
+            case PseudoInverseSolverMethod::CompleteOrthogonalDecomposition:
+            {
+                solveCOD(b, x);
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Compute the explicit pseudo-inverse of the matrix passed to the last call of compute().
+     *
+     * @param[out] Apinv matrix of size cols() x rows(), it can be an Eigen::Map.
+     * @return true if all went well, false otherwise.
+     */
+    template <typename PinvType>
+    bool pseudoInverse(const Eigen::MatrixBase<PinvType>& Apinv_)
+    {
+        Eigen::MatrixBase<PinvType>& Apinv = const_cast<Eigen::MatrixBase<PinvType>&>(Apinv_);
+
+        if (!m_isComputed || Apinv.rows() != m_cols || Apinv.cols() != m_rows)
+        {
+            return false;
+        }
+
+        switch (m_method)
+        {
+            case PseudoInverseSolverMethod::TruncatedSVD:
+            {
+                const Eigen::Index minSize = m_singularValuesInverse.size();
+                m_matrixWorkspace.noalias() = m_svd.matrixV().leftCols(minSize) * m_singularValuesInverse.asDiagonal();
+                Apinv.noalias() = m_matrixWorkspace * m_svd.matrixU().leftCols(minSize).transpose();
+                break;
+            }
+            case PseudoInverseSolverMethod::DampedLeastSquares:
+            {
+                // (M M^T + l^2 I)^-1 M, that is the transpose of the pseudo-inverse
+                // for wide matrices and the pseudo-inverse for tall ones
+                m_matrixWorkspace = m_matrix;
+                m_llt.solveInPlace(m_matrixWorkspace);
+                if (m_rows <= m_cols)
+                {
+                    Apinv = m_matrixWorkspace.transpose();
+                }
+                else
+                {
+                    Apinv = m_matrixWorkspace;
+                }
+                break;
+            }
+            case PseudoInverseSolverMethod::CompleteOrthogonalDecomposition:
+            {
+                for (Eigen::Index col = 0; col < m_rows; col++)
+                {
+                    m_rhs.setZero();
+                    m_rhs(col) = 1.0;
+                    solveCOD(m_rhs, Apinv.col(col));
+                }
+                break;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    // Same algorithm of CompleteOrthogonalDecomposition::solve, using the preallocated workspace
+    template <typename RhsType, typename SolutionType>
+    void solveCOD(const Eigen::MatrixBase<RhsType>& b, const Eigen::MatrixBase<SolutionType>& x_)
+    {
+        Eigen::MatrixBase<SolutionType>& x = const_cast<Eigen::MatrixBase<SolutionType>&>(x_);
+
+        if (m_rank == 0)
+        {
+            x.setZero();
+            return;
+        }
+
+        // c = Q^T b
+        Eigen::VectorBlock<Eigen::VectorXd> c = m_workspace.head(m_rows);
+        c = b;
+        for (Eigen::Index k = 0; k < m_rank; ++k)
+        {
+            c.tail(m_rows - k).applyHouseholderOnTheLeft(m_cod.matrixQTZ().col(k).tail(m_rows - k - 1),
+                                                         m_cod.hCoeffs()(k), m_householderWorkspace.data());
+        }
+
+        // Solve T z = c(1:rank)
+        m_cod.matrixT().topLeftCorner(m_rank, m_rank).template triangularView<Eigen::Upper>().solveInPlace(c.head(m_rank));
+
+        // y = Z^T [z; 0], stored in the head of the workspace
+        Eigen::VectorBlock<Eigen::VectorXd> y = m_workspace.head(m_cols);
+        if (m_rows < m_cols)
+        {
+            y.tail(m_cols - m_rows).setZero();
+        }
+        y.segment(m_rank, (std::min)(m_rows, m_cols) - m_rank).setZero();
+        if (m_rank < m_cols)
+        {
+            for (Eigen::Index k = 0; k < m_rank; ++k)
+            {
+                if (k != m_rank - 1)
+                {
+                    std::swap(y(k), y(m_rank - 1));
+                }
+                y.segment(m_rank - 1, m_cols - m_rank + 1)
+                    .applyHouseholderOnTheLeft(m_cod.matrixQTZ().row(k).tail(m_cols - m_rank).transpose(),
+                                               m_cod.zCoeffs()(k), m_householderWorkspace.data());
+                if (k != m_rank - 1)
+                {
+                    std::swap(y(k), y(m_rank - 1));
+                }
+            }
+        }
+
+        // x = P y
+        x.noalias() = m_cod.colsPermutation() * y;
+    }
+
+    PseudoInverseSolverMethod m_method;
+    double m_tolerance;
+    double m_damping;
+    Eigen::Index m_rows;
+    Eigen::Index m_cols;
+    Eigen::Index m_rank;
+    bool m_isComputed;
+
+    // Decompositions
+    Eigen::JacobiSVD<Eigen::MatrixXd> m_svd;
+    Eigen::LLT<Eigen::MatrixXd> m_llt;
+    Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd> m_cod;
+
+    // Workspace
+    Eigen::MatrixXd m_matrix;
+    Eigen::MatrixXd m_dampedMatrix;
+    Eigen::MatrixXd m_matrixWorkspace;
+    Eigen::VectorXd m_singularValuesInverse;
+    Eigen::VectorXd m_workspace;
+    Eigen::VectorXd m_householderWorkspace;
+    Eigen::VectorXd m_rhs;
+};
+
 }
 
 #endif
@@ -13,6 +13,7 @@
 
 #include <Eigen/SparseCore>
 #include <iDynTree/Core/SparseMatrix.h>
+#include <iDynTree/Core/SparseMatrixAssembler.h>
 
 namespace iDynTree
 {
@@ -62,6 +63,42 @@ inline Eigen::Map<const Eigen::SparseMatrix<double, Eigen::ColMajor> > toEigen(c
                                                                            0); //compressed format
 }
 
+//SparseMatrixAssembler helpers
+//The maps share the storage of the assembler, only the values can be modified through them
+inline Eigen::Map< Eigen::SparseMatrix<double, Eigen::RowMajor> > toEigen(iDynTree::SparseMatrixAssembler<iDynTree::RowMajor> & assembler)
+{
+    const iDynTree::SparseMatrix<iDynTree::RowMajor>& mat = assembler.matrix();
+    return Eigen::Map<Eigen::SparseMatrix<double, Eigen::RowMajor> >(mat.rows(),
+                                                                     mat.columns(),
+                                                                     mat.numberOfNonZeros(),
+                                                                     const_cast<int*>(mat.outerIndicesBuffer()),
+                                                                     const_cast<int*>(mat.innerIndicesBuffer()),
+                                                                     assembler.valuesBuffer(),
+                                                                     0); //compressed format
+}
+
+inline Eigen::Map<const Eigen::SparseMatrix<double, Eigen::RowMajor> > toEigen(const iDynTree::SparseMatrixAssembler<iDynTree::RowMajor> & assembler)
+{
+    return toEigen(assembler.matrix());
+}
+
+inline Eigen::Map< Eigen::SparseMatrix<double, Eigen::ColMajor> > toEigen(iDynTree::SparseMatrixAssembler<iDynTree::ColumnMajor> & assembler)
+{
+    const iDynTree::SparseMatrix<iDynTree::ColumnMajor>& mat = assembler.matrix();
+    return Eigen::Map<Eigen::SparseMatrix<double, Eigen::ColMajor> >(mat.rows(),
+                                                                     mat.columns(),
+                                                                     mat.numberOfNonZeros(),
+                                                                     const_cast<int*>(mat.outerIndicesBuffer()),
+                                                                     const_cast<int*>(mat.innerIndicesBuffer()),
+                                                                     assembler.valuesBuffer(),
+                                                                     0); //compressed format
+}
+
+inline Eigen::Map<const Eigen::SparseMatrix<double, Eigen::ColMajor> > toEigen(const iDynTree::SparseMatrixAssembler<iDynTree::ColumnMajor> & assembler)
+{
+    return toEigen(assembler.matrix());
+}
+
 }
 
 #endif /* IDYNTREE_EIGEN_SPARSE_HELPERS_H */
@@ -14,10 +14,13 @@
 
 #include <iDynTree/Core/Rotation.h>
 #include <iDynTree/Core/GeomVector3.h>
+#include <iDynTree/Core/MatrixFixSize.h>
 #include <vector>
 
 namespace iDynTree
 {
+    class ThreadPool;
+
     /**
      * @brief Struct containing the options for geodesicL2MeanRotation and geodesicL2WeightedMeanRotation.
      */
@@ -28,6 +31,76 @@ namespace iDynTree
         int maxIterations{-1}; /** Max number of iterations for the refinement loop. **/
         bool verbose{false}; /** Add a message when the solution is found. **/
         double stepSize{1.0}; /** Step-size for the refinement loop. **/
+        bool useChordalMeanAsInitialGuess{false}; /** Start the refinement loop from the chordal mean instead of the first rotation. **/
+    };
+
+    /**
+     * @brief Struct containing the options for chordalL2MeanRotation and chordalL2WeightedMeanRotation.
+     */
+    struct ChordalL2MeanOptions
+    {
+        iDynTree::ThreadPool* threadPool{nullptr}; /** If not null, the rotations are accumulated in parallel on this pool. **/
+        size_t minRotationsPerTask{4096}; /** Minimum number of rotations accumulated by each parallel task. **/
+    };
+
+    /**
+     * @brief Streaming accumulator for the chordal L2 mean of rotations.
+     *
+     * The chordal L2 mean in the quaternion space is the unit quaternion maximizing
+     * \f$ \sum_i w_i (q^\top q_i)^2 \f$, i.e. the eigenvector associated to the largest eigenvalue of the
+     * symmetric 4x4 matrix \f$ M = \sum_i w_i q_i q_i^\top \f$ (see Sec. 5.4 of "Rotation Averaging",
+     * available at http://users.cecs.anu.edu.au/~hongdong/rotationaveraging.pdf). Since \f$ M \f$ does not
+     * depend on the sign of the quaternions, the rotations can be accumulated one at a time, and the
+     * accumulators of different sets of rotations can be merged.
+     */
+    class ChordalMeanRotationAccumulator
+    {
+        iDynTree::Matrix4x4 m_accumulator;
+        double m_totalWeight;
+        size_t m_numberOfRotations;
+
+    public:
+        ChordalMeanRotationAccumulator();
+
+        /**
+         * @brief Remove all the accumulated rotations.
+         */
+        void reset();
+
+        /**
+         * @brief Add a rotation to the accumulator.
+         * @param rotation The rotation to add.
+         * @param weight The weight of the rotation, it must be non-negative.
+         * @return false in case of failure, true otherwise.
+         */
+        bool addRotation(const iDynTree::Rotation& rotation, double weight = 1.0);
+
+        /**
+         * @brief Add the rotations accumulated by another accumulator.
+         */
+        void merge(const ChordalMeanRotationAccumulator& other);
+
+        /**
+         * @brief Get the number of accumulated rotations.
+         */
+        size_t getNumberOfRotations() const;
+
+        /**
+         * @brief Get the sum of the weights of the accumulated rotations.
+         */
+        double getTotalWeight() const;
+
+        /**
+         * @brief Get the accumulated matrix \f$ M \f$.
+         */
+        const iDynTree::Matrix4x4& getAccumulatedMatrix() const;
+
+        /**
+         * @brief Compute the chordal mean of the accumulated rotations.
+         * @param meanRotation The mean rotation.
+         * @return false in case of failure (for example if no rotation was accumulated), true otherwise.
+         */
+        bool getMeanRotation(iDynTree::Rotation& meanRotation) const;
     };
 
     /**
@@ -82,6 +155,39 @@ namespace iDynTree
                                          const std::vector<double>& weights,
                                          iDynTree::Rotation& meanRotation,
                                          const GeodesicL2MeanOptions& options = GeodesicL2MeanOptions());
+
+    /**
+     * @brief Computes the chordal L2 mean amongst the provided rotations.
+     *
+     * Inside it calls chordalL2WeightedMeanRotation.
+     *
+     * @param inputRotations The rotations to average.
+     * @param meanRotation The mean rotation.
+     * @param options The options for the accumulation of the rotations.
+     * @return false in case of failure, true otherwise.
+     */
+    bool chordalL2MeanRotation(const std::vector<iDynTree::Rotation>& inputRotations,
+                               iDynTree::Rotation& meanRotation,
+                               const ChordalL2MeanOptions& options = ChordalL2MeanOptions());
+
+    /**
+     * @brief Computes the weighted chordal L2 mean amongst the provided rotations.
+     *
+     * The mean is computed in closed form as described in ChordalMeanRotationAccumulator,
+     * without iterations. It is close to the geodesic mean when the rotations are not too spread,
+     * so it can be used in place of it or as initial guess of geodesicL2WeightedMeanRotation.
+     * For large inputs, the accumulation can be split on the threads of a ThreadPool.
+     *
+     * @param inputRotations The rotations to average.
+     * @param weights The weights for each rotation. If this vector is empty assumes that each weight is 1.0 (equivalent to chordalL2MeanRotation)
+     * @param meanRotation The weighted mean rotation.
+     * @param options The options for the accumulation of the rotations.
+     * @return false in case of failure, true otherwise.
+     */
+    bool chordalL2WeightedMeanRotation(const std::vector<iDynTree::Rotation>& inputRotations,
+                                       const std::vector<double>& weights,
+                                       iDynTree::Rotation& meanRotation,
+                                       const ChordalL2MeanOptions& options = ChordalL2MeanOptions());
 }
 
 #endif // IDYNTREE_SO3UTILS_H
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef IDYNTREE_SPARSE_MATRIX_ASSEMBLER_H
+#define IDYNTREE_SPARSE_MATRIX_ASSEMBLER_H
+
+#include <iDynTree/Core/MatrixView.h>
+#include <iDynTree/Core/SparseMatrix.h>
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace iDynTree {
+
+    template <MatrixStorageOrdering ordering>
+    class SparseMatrixAssembler;
+}
+
+/**
+ * \brief Assembler of a sparse matrix with a fixed sparsity pattern
+ *
+ * Many algorithms (estimators, optimal control problems, QP-based controllers) fill at every step
+ * a sparse matrix whose sparsity pattern never changes. This class splits the assembly in two phases:
+ *
+ * - a symbolic phase, in which the (row, column) position of each non zero element is registered
+ *   with addNonZero() or addDenseBlock(). Each call returns a *slot*, i.e. a stable integer handle
+ *   of the element. The pattern is then compressed by calling finalize().
+ * - a numeric phase, in which the values are written with setSlot() and addToSlot(). These methods
+ *   access directly the compressed value buffer, so they have constant cost and do not allocate memory.
+ *
+ * If the same position is registered more than once, the corresponding slots refer to the same value,
+ * so calling addToSlot() on all of them sums up the contributions (as for duplicated triplets).
+ *
+ * The values are stored in a SparseMatrix, which can be accessed with matrix() or mapped
+ * without copies to an Eigen sparse matrix with the toEigen() functions in EigenSparseHelpers.h.
+ *
+ * The patterns of several assemblers can be joined with merge(), for example to assemble the blocks of a
+ * KKT system that are filled by different components.
+ *
+ * \warning This class is still in active development, and so API interface can change between iDynTree versions.
+ */
+template <iDynTree::MatrixStorageOrdering ordering>
+class iDynTree::SparseMatrixAssembler
+{
+private:
+    std::size_t m_rows;
+    std::size_t m_columns;
+
+    std::vector<int> m_slotRows; /**< row of the element of each slot */
+    std::vector<int> m_slotColumns; /**< column of the element of each slot */
+    std::vector<std::size_t> m_slotValueIndices; /**< index in the values buffer of the element of each slot */
+
+    bool m_isFinalized;
+    iDynTree::SparseMatrix<ordering> m_matrix;
+
+public:
+
+    /**
+     * Creates an assembler for an empty matrix.
+     */
+    SparseMatrixAssembler();
+
+    /**
+     * Creates an assembler for a matrix of the specified dimensions, with no non zero elements.
+     */
+    SparseMatrixAssembler(std::size_t rows, std::size_t cols);
+
+    /**
+     * Set the dimensions of the matrix, and remove all the registered elements.
+     */
+    void resize(std::size_t rows, std::size_t cols);
+
+    /**
+     * Reserve memory for the specified number of slots.
+     */
+    void reserve(std::size_t numberOfSlots);
+
+    /**
+     * Returns the number of rows of the matrix.
+     */
+    std::size_t rows() const;
+
+    /**
+     * Returns the number of columns of the matrix.
+     */
+    std::size_t columns() const;
+
+    /**
+     * Returns the number of registered slots.
+     */
+    std::size_t numberOfSlots() const;
+
+    /**
+     * Returns the number of non zero elements of the matrix, i.e. the number of distinct positions
+     * of the registered slots.
+     *
+     * \note it is meaningful only after finalize().
+     */
+    std::size_t numberOfNonZeros() const;
+
+    /**
+     * Register an element of the pattern.
+     *
+     * \note this invalidates the compressed pattern, finalize() must be called again before using the slots.
+     * @param[in] row row of the element.
+     * @param[in] col column of the element.
+     * @param[out] slot the slot of the element.
+     * @return true if all went well, false if the element is outside the matrix.
+     */
+    bool addNonZero(std::size_t row, std::size_t col, std::size_t& slot);
+
+    /**
+     * Register all the elements of a dense block of the pattern.
+     *
+     * The slots of the block are consecutive and ordered row by row, i.e. the element (i, j) of the
+     * block has slot firstSlot + i*blockCols + j. This is the ordering expected by setBlock() and addToBlock().
+     *
+     * \note this invalidates the compressed pattern, finalize() must be called again before using the slots.
+     * @param[in] startRow first row of the block.
+     * @param[in] startCol first column of the block.
+     * @param[in] blockRows number of rows of the block.
+     * @param[in] blockCols number of columns of the block.
+     * @param[out] firstSlot the slot of the first element of the block.
+     * @return true if all went well, false if the block is outside the matrix.
+     */
+    bool addDenseBlock(std::size_t startRow, std::size_t startCol,
+                       std::size_t blockRows, std::size_t blockCols,
+                       std::size_t& firstSlot);
+
+    /**
+     * Add the pattern of another assembler to the one of this assembler.
+     *
+     * The pattern of other is shifted by (startRow, startCol), and the slots of other are appended to the slots of
+     * this assembler: the slot i of other corresponds to the slot slotOffset + i of this assembler.
+     *
+     * \note this invalidates the compressed pattern, finalize() must be called again before using the slots.
+     * @param[in] other the assembler whose pattern is merged.
+     * @param[in] startRow row of this matrix corresponding to the first row of other.
+     * @param[in] startCol column of this matrix corresponding to the first column of other.
+     * @param[out] slotOffset the slot of this assembler corresponding to the first slot of other.
+     * @return true if all went well, false if the pattern of other is outside the matrix.
+     */
+    bool merge(const SparseMatrixAssembler& other,
+               std::size_t startRow, std::size_t startCol,
+               std::size_t& slotOffset);
+
+    /**
+     * Compress the registered pattern and compute the position of each slot in the value buffer.
+     *
+     * All the values are set to zero.
+     * \warning this function performs memory allocation.
+     */
+    void finalize();
+
+    /**
+     * Returns true if the pattern has been compressed and no element has been registered since.
+     */
+    bool isFinalized() const;
+
+    /**
+     * Get the slot of the element at the specified position.
+     *
+     * If the position has been registered more than once, the first registered slot is returned.
+     * \note this method performs a search, get the slots when registering the elements to avoid it.
+     * @return true if the element is in the pattern, false otherwise.
+     */
+    bool getSlot(std::size_t row, std::size_t col, std::size_t& slot) const;
+
+    /**
+     * Set all the values of the matrix to zero, without modifying the pattern.
+     */
+    void zero();
+
+    /**
+     * Set the value of the element of a slot.
+     */
+    inline void setSlot(std::size_t slot, double value)
+    {
+        assert(m_isFinalized && slot < m_slotValueIndices.size());
+        m_matrix.valuesBuffer()[m_slotValueIndices[slot]] = value;
+    }
+
+    /**
+     * Add a value to the element of a slot.
+     */
+    inline void addToSlot(std::size_t slot, double value)
+    {
+        assert(m_isFinalized && slot < m_slotValueIndices.size());
+        m_matrix.valuesBuffer()[m_slotValueIndices[slot]] += value;
+    }
+
+    /**
+     * Get the value of the element of a slot.
+     */
+    inline double getSlotValue(std::size_t slot) const
+    {
+        assert(m_isFinalized && slot < m_slotValueIndices.size());
+        return m_matrix.valuesBuffer()[m_slotValueIndices[slot]];
+    }
+
+    /**
+     * Set the values of a block registered with addDenseBlock().
+     *
+     * @param[in] firstSlot the slot returned by addDenseBlock().
+     * @param[in] block the values of the block.
+     * @return true if all went well, false otherwise.
+     */
+    bool setBlock(std::size_t firstSlot, MatrixView<const double> block);
+
+    /**
+     * Add the values of a block to the elements of a block registered with addDenseBlock().
+     *
+     * @param[in] firstSlot the slot returned by addDenseBlock().
+     * @param[in] block the values to be added.
+     * @return true if all went well, false otherwise.
+     */
+    bool addToBlock(std::size_t firstSlot, MatrixView<const double> block);
+
+    /**
+     * Get the assembled matrix.
+     *
+     * Its pattern is the one compressed by the last call to finalize().
+     */
+    const iDynTree::SparseMatrix<ordering>& matrix() const;
+
+    /**
+     * Raw access to the values of the assembled matrix, in the order of the compressed storage.
+     */
+    double* valuesBuffer();
+
+    double const * valuesBuffer() const;
+};
+
+#endif /* end of include guard: IDYNTREE_SPARSE_MATRIX_ASSEMBLER_H */
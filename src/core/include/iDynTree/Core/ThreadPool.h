@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef IDYNTREE_THREAD_POOL_H
+#define IDYNTREE_THREAD_POOL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace iDynTree
+{
+    /**
+     * \brief Persistent pool of worker threads used to run independent computations in parallel.
+     *
+     * The threads are created once (in the constructor or in resize) and then wait for work,
+     * so that the cost of a parallelFor call is just the synchronization of the threads.
+     * The calling thread takes part in the computation, so a pool with zero worker threads
+     * simply runs all the tasks sequentially in the calling thread.
+     *
+     * parallelFor calls on the same pool from different threads are serialized.
+     *
+     * @warning This class is still in active development, and so API interface can change between iDynTree versions.
+     * \ingroup iDynTreeExperimental
+     */
+    class ThreadPool
+    {
+        class ThreadPoolPimpl;
+        ThreadPoolPimpl* m_pimpl;
+
+        // Copy is forbidden
+        ThreadPool(const ThreadPool& other);
+        ThreadPool& operator=(const ThreadPool& other);
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param[in] nrOfWorkerThreads number of threads created in addition to the calling one.
+         */
+        explicit ThreadPool(const std::size_t nrOfWorkerThreads = 0);
+
+        /**
+         * Destructor, it joins all the worker threads.
+         */
+        ~ThreadPool();
+
+        /**
+         * Change the number of worker threads of the pool.
+         *
+         * @param[in] nrOfWorkerThreads number of threads created in addition to the calling one.
+         */
+        void resize(const std::size_t nrOfWorkerThreads);
+
+        /**
+         * Get the number of worker threads of the pool, not including the calling thread.
+         */
+        std::size_t getNrOfWorkerThreads() const;
+
+        /**
+         * Get the number of threads that are available in the system, or 1 if it can not be detected.
+         */
+        static std::size_t getNrOfAvailableHardwareThreads();
+
+        /**
+         * Call task(i) for each i in [0, nrOfTasks), distributing the calls among the
+         * worker threads and the calling thread.
+         *
+         * The method returns only once all the tasks are completed.
+         * The order in which the tasks are executed is not specified, so each task
+         * should write its results in a location that depends only on its index.
+         *
+         * @param[in] nrOfTasks number of tasks to execute.
+         * @param[in] task function called with the index of each task.
+         */
+        void parallelFor(const std::size_t nrOfTasks, const std::function<void(std::size_t)>& task);
+    };
+}
+
+#endif /* IDYNTREE_THREAD_POOL_H */
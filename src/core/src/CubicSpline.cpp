@@ -10,9 +10,11 @@
 
 #include <iDynTree/Core/CubicSpline.h>
 #include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Utils.h>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 #include <Eigen/SparseLU>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -238,3 +240,365 @@ double iDynTree::CubicSpline::evaluatePoint(double t, double &velocity, double &
     acceleration = 2*coeff(2) + 6*coeff(3)*(dt);
     return position;
 }
+
+iDynTree::MultiCubicSpline::MultiCubicSpline()
+:m_nrOfChannels(0)
+,m_lastSegment(0)
+,m_areCoefficientsUpdated(false)
+{
+}
+
+bool iDynTree::MultiCubicSpline::setData(const iDynTree::VectorDynSize& time, iDynTree::MatrixView<const double> yData)
+{
+    if(time.size() < 2){
+        reportError("MultiCubicSpline", "setData", "At least two data points are needed to compute the spline.");
+        return false;
+    }
+
+    if(static_cast<size_t>(yData.rows()) != time.size() || yData.cols() == 0){
+        reportError("MultiCubicSpline", "setData", "The input data are expected to have a row for each time and at least one column.");
+        return false;
+    }
+
+    size_t nrOfKnots = time.size();
+    size_t nrOfChannels = static_cast<size_t>(yData.cols());
+
+    if(nrOfChannels != m_nrOfChannels){
+        m_nrOfChannels = nrOfChannels;
+        m_v0.assign(nrOfChannels, 0.0);
+        m_vf.assign(nrOfChannels, 0.0);
+        m_a0.assign(nrOfChannels, 0.0);
+        m_af.assign(nrOfChannels, 0.0);
+        m_evaluationBuffer.resize(3*nrOfChannels);
+    }
+
+    m_time = time;
+    m_T.resize(nrOfKnots - 1);
+    m_y.resize(nrOfKnots*nrOfChannels);
+    m_velocities.resize(nrOfKnots*nrOfChannels);
+    m_coefficients.resize(4*(nrOfKnots - 1)*nrOfChannels);
+    m_thomasBuffer.resize(nrOfKnots);
+
+    for(size_t i = 0; i < nrOfKnots; ++i){
+        for(size_t c = 0; c < nrOfChannels; ++c){
+            m_y[i*nrOfChannels + c] = yData(i, c);
+        }
+    }
+
+    m_lastSegment = 0;
+    m_areCoefficientsUpdated = false;
+
+    return true;
+}
+
+bool iDynTree::MultiCubicSpline::setInitialConditions(iDynTree::Span<const double> initialVelocities,
+                                                      iDynTree::Span<const double> initialAccelerations)
+{
+    if(static_cast<size_t>(initialVelocities.size()) != m_nrOfChannels
+       || static_cast<size_t>(initialAccelerations.size()) != m_nrOfChannels){
+        reportError("MultiCubicSpline", "setInitialConditions", "The initial conditions should have a element for each channel, call setData first.");
+        return false;
+    }
+
+    std::copy(initialVelocities.begin(), initialVelocities.end(), m_v0.begin());
+    std::copy(initialAccelerations.begin(), initialAccelerations.end(), m_a0.begin());
+
+    // The initial condition has been updated. The coefficients have to be recomputed.
+    m_areCoefficientsUpdated = false;
+    return true;
+}
+
+bool iDynTree::MultiCubicSpline::setFinalConditions(iDynTree::Span<const double> finalVelocities,
+                                                    iDynTree::Span<const double> finalAccelerations)
+{
+    if(static_cast<size_t>(finalVelocities.size()) != m_nrOfChannels
+       || static_cast<size_t>(finalAccelerations.size()) != m_nrOfChannels){
+        reportError("MultiCubicSpline", "setFinalConditions", "The final conditions should have a element for each channel, call setData first.");
+        return false;
+    }
+
+    std::copy(finalVelocities.begin(), finalVelocities.end(), m_vf.begin());
+    std::copy(finalAccelerations.begin(), finalAccelerations.end(), m_af.begin());
+
+    // The final condition has been updated. The coefficients have to be recomputed.
+    m_areCoefficientsUpdated = false;
+    return true;
+}
+
+size_t iDynTree::MultiCubicSpline::getNrOfChannels() const
+{
+    return m_nrOfChannels;
+}
+
+size_t iDynTree::MultiCubicSpline::getNrOfKnots() const
+{
+    return m_time.size();
+}
+
+bool iDynTree::MultiCubicSpline::computePhasesDuration()
+{
+    for (size_t i = 0; i < m_time.size() - 1; ++i){
+
+        m_T(i) = m_time(i+1) - m_time(i);
+
+        if(m_T(i) <= 0){
+            reportError("MultiCubicSpline", "computePhasesDuration", "The input points are expected to be consecutive, strictly increasing in the time variable.");
+            return false;
+        }
+    }
+    return true;
+}
+
+void iDynTree::MultiCubicSpline::computeIntermediateVelocities()
+{
+    // The velocities of the internal knots solve the tridiagonal system (the same of CubicSpline)
+    // T(i+1)*v(i) + 2*(T(i) + T(i+1))*v(i+1) + T(i)*v(i+2) = 3*(T(i)^2*(y(i+2) - y(i+1)) + T(i+1)^2*(y(i+1) - y(i)))/(T(i)*T(i+1))
+    // whose matrix is shared by all the channels. It is strictly diagonally dominant, so it is solved
+    // with the Thomas algorithm, operating on the rows of all the channels at once.
+    typedef Eigen::Map<Eigen::ArrayXd> ChannelsMap;
+    const Eigen::Index nrOfChannels = static_cast<Eigen::Index>(m_nrOfChannels);
+    const size_t nrOfInternalKnots = m_time.size() - 2;
+
+    for(size_t i = 0; i < nrOfInternalKnots; ++i){
+        ChannelsMap rhs(m_velocities.data() + (i+1)*m_nrOfChannels, nrOfChannels);
+        Eigen::Map<const Eigen::ArrayXd> y0(m_y.data() + i*m_nrOfChannels, nrOfChannels);
+        Eigen::Map<const Eigen::ArrayXd> y1(m_y.data() + (i+1)*m_nrOfChannels, nrOfChannels);
+        Eigen::Map<const Eigen::ArrayXd> y2(m_y.data() + (i+2)*m_nrOfChannels, nrOfChannels);
+
+        rhs = (m_T(i)*m_T(i)*(y2 - y1) + m_T(i+1)*m_T(i+1)*(y1 - y0))*3/(m_T(i)*m_T(i+1));
+
+        if(i == 0){
+            rhs -= m_T(1)*Eigen::Map<const Eigen::ArrayXd>(m_v0.data(), nrOfChannels);
+        }
+        if(i == nrOfInternalKnots - 1){
+            rhs -= m_T(i)*Eigen::Map<const Eigen::ArrayXd>(m_vf.data(), nrOfChannels);
+        }
+
+        // Forward elimination
+        double diagonal = 2*(m_T(i) + m_T(i+1));
+        if(i > 0){
+            double subDiagonal = m_T(i+1);
+            diagonal -= subDiagonal*m_thomasBuffer[i-1];
+            rhs -= subDiagonal*ChannelsMap(m_velocities.data() + i*m_nrOfChannels, nrOfChannels);
+        }
+        m_thomasBuffer[i] = m_T(i)/diagonal;
+        rhs /= diagonal;
+    }
+
+    // Back substitution
+    for(size_t i = nrOfInternalKnots - 1; i > 0; --i){
+        ChannelsMap(m_velocities.data() + i*m_nrOfChannels, nrOfChannels) -=
+            m_thomasBuffer[i-1]*ChannelsMap(m_velocities.data() + (i+1)*m_nrOfChannels, nrOfChannels);
+    }
+}
+
+bool iDynTree::MultiCubicSpline::computeCoefficients()
+{
+    // the coefficients are updated. No need to recompute them
+    if(m_areCoefficientsUpdated){
+        return true;
+    }
+
+    if(!this->computePhasesDuration())
+        return false;
+
+    std::copy(m_v0.begin(), m_v0.end(), m_velocities.begin());
+    std::copy(m_vf.begin(), m_vf.end(), m_velocities.end() - m_nrOfChannels);
+
+    if(m_time.size() > 2){
+        this->computeIntermediateVelocities();
+    }
+
+    const Eigen::Index nrOfChannels = static_cast<Eigen::Index>(m_nrOfChannels);
+    for(size_t i = 0; i < m_time.size() - 1; ++i){
+        Eigen::Map<const Eigen::ArrayXd> y0(m_y.data() + i*m_nrOfChannels, nrOfChannels);
+        Eigen::Map<const Eigen::ArrayXd> y1(m_y.data() + (i+1)*m_nrOfChannels, nrOfChannels);
+        Eigen::Map<const Eigen::ArrayXd> v0(m_velocities.data() + i*m_nrOfChannels, nrOfChannels);
+        Eigen::Map<const Eigen::ArrayXd> v1(m_velocities.data() + (i+1)*m_nrOfChannels, nrOfChannels);
+
+        double* segmentCoefficients = m_coefficients.data() + 4*i*m_nrOfChannels;
+        double T = m_T(i);
+        Eigen::Map<Eigen::ArrayXd>(segmentCoefficients, nrOfChannels) = y0;
+        Eigen::Map<Eigen::ArrayXd>(segmentCoefficients + m_nrOfChannels, nrOfChannels) = v0;
+        Eigen::Map<Eigen::ArrayXd>(segmentCoefficients + 2*m_nrOfChannels, nrOfChannels) = (3*(y1 - y0)/T - 2*v0 - v1)/T;
+        Eigen::Map<Eigen::ArrayXd>(segmentCoefficients + 3*m_nrOfChannels, nrOfChannels) = (2*(y0 - y1)/T + v0 + v1)/(T*T);
+    }
+
+    // The coefficients are now updated.
+    m_areCoefficientsUpdated = true;
+
+    return true;
+}
+
+bool iDynTree::MultiCubicSpline::checkCoefficients(const char* methodName)
+{
+    if(m_time.size() == 0){
+        reportError("MultiCubicSpline", methodName, "First you have to load data!");
+        return false;
+    }
+
+    // The coefficients are not updated. It's time to compute them.
+    if(!this->computeCoefficients()){
+        reportError("MultiCubicSpline", methodName, "Unable to compute the internal coefficients of the cubic splines.");
+        return false;
+    }
+
+    return true;
+}
+
+size_t iDynTree::MultiCubicSpline::findSegment(double t)
+{
+    // Check the segment of the last evaluation and the following one,
+    // as in most of the cases the spline is evaluated at increasing times
+    size_t lastKnot = m_time.size() - 1;
+    if(t >= m_time(m_lastSegment)){
+        if(t < m_time(m_lastSegment + 1)){
+            return m_lastSegment;
+        }
+        if(m_lastSegment + 2 <= lastKnot && t < m_time(m_lastSegment + 2)){
+            return ++m_lastSegment;
+        }
+    }
+
+    // Last index for which t >= m_time(index) holds
+    const double* timeBegin = m_time.data();
+    const double* knot = std::upper_bound(timeBegin, timeBegin + lastKnot, t);
+    m_lastSegment = static_cast<size_t>(knot - timeBegin) - 1;
+    return m_lastSegment;
+}
+
+void iDynTree::MultiCubicSpline::evaluateChannels(double t, double* positions, double* velocities, double* accelerations)
+{
+    typedef Eigen::Map<Eigen::ArrayXd> ChannelsMap;
+    typedef Eigen::Map<const Eigen::ArrayXd> ChannelsConstMap;
+    const Eigen::Index nrOfChannels = static_cast<Eigen::Index>(m_nrOfChannels);
+
+    if(t < m_time(0) || t >= m_time(m_time.size() - 1)){
+        bool isBefore = t < m_time(0);
+        const double* y = isBefore ? m_y.data() : m_y.data() + (m_time.size() - 1)*m_nrOfChannels;
+        ChannelsMap(positions, nrOfChannels) = ChannelsConstMap(y, nrOfChannels);
+        if(velocities){
+            ChannelsMap(velocities, nrOfChannels) = ChannelsConstMap(isBefore ? m_v0.data() : m_vf.data(), nrOfChannels);
+        }
+        if(accelerations){
+            ChannelsMap(accelerations, nrOfChannels) = ChannelsConstMap(isBefore ? m_a0.data() : m_af.data(), nrOfChannels);
+        }
+        return;
+    }
+
+    size_t segment = findSegment(t);
+    const double* coefficients = m_coefficients.data() + 4*segment*m_nrOfChannels;
+    ChannelsConstMap c0(coefficients, nrOfChannels);
+    ChannelsConstMap c1(coefficients + m_nrOfChannels, nrOfChannels);
+    ChannelsConstMap c2(coefficients + 2*m_nrOfChannels, nrOfChannels);
+    ChannelsConstMap c3(coefficients + 3*m_nrOfChannels, nrOfChannels);
+    double dt = t - m_time(segment);
+
+    ChannelsMap(positions, nrOfChannels) = c0 + dt*(c1 + dt*(c2 + dt*c3));
+    if(velocities){
+        ChannelsMap(velocities, nrOfChannels) = c1 + dt*(2*c2 + 3*dt*c3);
+    }
+    if(accelerations){
+        ChannelsMap(accelerations, nrOfChannels) = 2*c2 + 6*dt*c3;
+    }
+}
+
+bool iDynTree::MultiCubicSpline::evaluatePoint(double t, iDynTree::Span<double> positions)
+{
+    if(!checkCoefficients("evaluatePoint")){
+        return false;
+    }
+
+    if(static_cast<size_t>(positions.size()) != m_nrOfChannels){
+        reportError("MultiCubicSpline", "evaluatePoint", "The output should have a element for each channel.");
+        return false;
+    }
+
+    evaluateChannels(t, positions.data(), nullptr, nullptr);
+    return true;
+}
+
+bool iDynTree::MultiCubicSpline::evaluatePoint(double t,
+                                               iDynTree::Span<double> positions,
+                                               iDynTree::Span<double> velocities,
+                                               iDynTree::Span<double> accelerations)
+{
+    if(!checkCoefficients("evaluatePoint")){
+        return false;
+    }
+
+    if(static_cast<size_t>(positions.size()) != m_nrOfChannels
+       || static_cast<size_t>(velocities.size()) != m_nrOfChannels
+       || static_cast<size_t>(accelerations.size()) != m_nrOfChannels){
+        reportError("MultiCubicSpline", "evaluatePoint", "The outputs should have a element for each channel.");
+        return false;
+    }
+
+    evaluateChannels(t, positions.data(), velocities.data(), accelerations.data());
+    return true;
+}
+
+bool iDynTree::MultiCubicSpline::evaluateTrajectory(iDynTree::Span<const double> times, iDynTree::MatrixView<double> positions)
+{
+    if(!checkCoefficients("evaluateTrajectory")){
+        return false;
+    }
+
+    if(positions.rows() != times.size() || static_cast<size_t>(positions.cols()) != m_nrOfChannels){
+        reportError("MultiCubicSpline", "evaluateTrajectory", "The output should have a row for each time and a column for each channel.");
+        return false;
+    }
+
+    const bool isRowMajor = positions.storageOrder() == iDynTree::MatrixStorageOrdering::RowMajor;
+    for(std::ptrdiff_t i = 0; i < times.size(); ++i){
+        double* positionsRow = isRowMajor ? positions.data() + i*m_nrOfChannels : m_evaluationBuffer.data();
+        evaluateChannels(times(i), positionsRow, nullptr, nullptr);
+
+        if(!isRowMajor){
+            for(size_t c = 0; c < m_nrOfChannels; ++c){
+                positions(i, c) = positionsRow[c];
+            }
+        }
+    }
+
+    return true;
+}
+
+bool iDynTree::MultiCubicSpline::evaluateTrajectory(iDynTree::Span<const double> times,
+                                                    iDynTree::MatrixView<double> positions,
+                                                    iDynTree::MatrixView<double> velocities,
+                                                    iDynTree::MatrixView<double> accelerations)
+{
+    if(!checkCoefficients("evaluateTrajectory")){
+        return false;
+    }
+
+    iDynTree::MatrixView<double> outputs[3] = {positions, velocities, accelerations};
+    bool isRowMajor[3];
+    for(size_t k = 0; k < 3; ++k){
+        if(outputs[k].rows() != times.size() || static_cast<size_t>(outputs[k].cols()) != m_nrOfChannels){
+            reportError("MultiCubicSpline", "evaluateTrajectory", "The outputs should have a row for each time and a column for each channel.");
+            return false;
+        }
+        isRowMajor[k] = outputs[k].storageOrder() == iDynTree::MatrixStorageOrdering::RowMajor;
+    }
+
+    double* rows[3];
+    for(std::ptrdiff_t i = 0; i < times.size(); ++i){
+        for(size_t k = 0; k < 3; ++k){
+            rows[k] = isRowMajor[k] ? outputs[k].data() + i*m_nrOfChannels : m_evaluationBuffer.data() + k*m_nrOfChannels;
+        }
+
+        evaluateChannels(times(i), rows[0], rows[1], rows[2]);
+
+        for(size_t k = 0; k < 3; ++k){
+            if(!isRowMajor[k]){
+                for(size_t c = 0; c < m_nrOfChannels; ++c){
+                    outputs[k](i, c) = rows[k][c];
+                }
+            }
+        }
+    }
+
+    return true;
+}
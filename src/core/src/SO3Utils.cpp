@@ -12,7 +12,11 @@
 #include <iDynTree/Core/SO3Utils.h>
 #include <iDynTree/Core/Utils.h>
 #include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/ThreadPool.h>
 
+#include <Eigen/Eigenvalues>
+
+#include <algorithm>
 #include <cmath>
 #include <chrono>
 #include <string>
@@ -101,7 +105,18 @@ bool iDynTree::geodesicL2WeightedMeanRotation(const std::vector<iDynTree::Rotati
     }
 
     // initial condition for optimization
-    meanRotation = inputRotations[0];
+    if (options.useChordalMeanAsInitialGuess)
+    {
+        if (!chordalL2WeightedMeanRotation(inputRotations, weights, meanRotation))
+        {
+            iDynTree::reportError("SO3Utils", "geodesicL2WeightedMeanRotation", "Failed to compute the chordal mean used as initial guess.");
+            return false;
+        }
+    }
+    else
+    {
+        meanRotation = inputRotations[0];
+    }
 
     bool optimal_R_found{false};
     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
@@ -186,3 +201,151 @@ bool iDynTree::geodesicL2WeightedMeanRotation(const std::vector<iDynTree::Rotati
     return true;
 }
 
+iDynTree::ChordalMeanRotationAccumulator::ChordalMeanRotationAccumulator()
+{
+    reset();
+}
+
+void iDynTree::ChordalMeanRotationAccumulator::reset()
+{
+    m_accumulator.zero();
+    m_totalWeight = 0.0;
+    m_numberOfRotations = 0;
+}
+
+bool iDynTree::ChordalMeanRotationAccumulator::addRotation(const iDynTree::Rotation& rotation, double weight)
+{
+    if (weight < 0.0)
+    {
+        iDynTree::reportError("ChordalMeanRotationAccumulator", "addRotation", "The weight is supposed to be non-negative.");
+        return false;
+    }
+
+    iDynTree::Vector4 quaternion = rotation.asQuaternion();
+    Eigen::Vector4d q = iDynTree::toEigen(quaternion);
+    iDynTree::toEigen(m_accumulator).noalias() += weight * q * q.transpose();
+    m_totalWeight += weight;
+    m_numberOfRotations++;
+    return true;
+}
+
+void iDynTree::ChordalMeanRotationAccumulator::merge(const ChordalMeanRotationAccumulator& other)
+{
+    iDynTree::toEigen(m_accumulator) += iDynTree::toEigen(other.m_accumulator);
+    m_totalWeight += other.m_totalWeight;
+    m_numberOfRotations += other.m_numberOfRotations;
+}
+
+size_t iDynTree::ChordalMeanRotationAccumulator::getNumberOfRotations() const
+{
+    return m_numberOfRotations;
+}
+
+double iDynTree::ChordalMeanRotationAccumulator::getTotalWeight() const
+{
+    return m_totalWeight;
+}
+
+const iDynTree::Matrix4x4& iDynTree::ChordalMeanRotationAccumulator::getAccumulatedMatrix() const
+{
+    return m_accumulator;
+}
+
+bool iDynTree::ChordalMeanRotationAccumulator::getMeanRotation(iDynTree::Rotation& meanRotation) const
+{
+    if (m_totalWeight <= 0.0)
+    {
+        iDynTree::reportError("ChordalMeanRotationAccumulator", "getMeanRotation", "No rotation with positive weight has been accumulated.");
+        return false;
+    }
+
+    // The eigenvalues are sorted in increasing order
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> eigenSolver(iDynTree::toEigen(m_accumulator));
+    if (eigenSolver.info() != Eigen::Success)
+    {
+        iDynTree::reportError("ChordalMeanRotationAccumulator", "getMeanRotation", "Failed to compute the eigenvectors of the accumulated matrix.");
+        return false;
+    }
+
+    iDynTree::Vector4 meanQuaternion;
+    iDynTree::toEigen(meanQuaternion) = eigenSolver.eigenvectors().col(3);
+    if (meanQuaternion(0) < 0.0)
+    {
+        iDynTree::toEigen(meanQuaternion) *= -1.0;
+    }
+
+    meanRotation = iDynTree::Rotation::RotationFromQuaternion(meanQuaternion);
+    return true;
+}
+
+bool iDynTree::chordalL2MeanRotation(const std::vector<iDynTree::Rotation>& inputRotations,
+                                     iDynTree::Rotation& meanRotation,
+                                     const ChordalL2MeanOptions& options)
+{
+    return chordalL2WeightedMeanRotation(inputRotations, std::vector<double>(), meanRotation, options);
+}
+
+bool iDynTree::chordalL2WeightedMeanRotation(const std::vector<iDynTree::Rotation>& inputRotations,
+                                             const std::vector<double>& weights,
+                                             iDynTree::Rotation& meanRotation,
+                                             const ChordalL2MeanOptions& options)
+{
+    if (!inputRotations.size())
+    {
+        iDynTree::reportError("SO3Utils", "chordalL2WeightedMeanRotation", "Empty inputRotations vector.");
+        return false;
+    }
+
+    if (weights.size() && (inputRotations.size() != weights.size()))
+    {
+        iDynTree::reportError("SO3Utils", "chordalL2WeightedMeanRotation", "Vectors size mismatch: weights and inputRotations must be same size.");
+        return false;
+    }
+
+    for (size_t i = 0; i < weights.size(); ++i)
+    {
+        if (weights[i] < 0.0)
+        {
+            std::stringstream ss;
+            ss << "The weight at index " << i << " is negative.";
+            iDynTree::reportError("SO3Utils", "chordalL2WeightedMeanRotation", ss.str().c_str());
+            return false;
+        }
+    }
+
+    // Each task accumulates a contiguous chunk of the rotations in its own accumulator
+    size_t nrRot = inputRotations.size();
+    size_t nrOfTasks = 1;
+    if (options.threadPool)
+    {
+        nrOfTasks = std::min(options.threadPool->getNrOfWorkerThreads() + 1,
+                             std::max<size_t>(nrRot / std::max<size_t>(options.minRotationsPerTask, 1), 1));
+    }
+
+    std::vector<ChordalMeanRotationAccumulator> accumulators(nrOfTasks);
+    auto accumulateChunk = [&inputRotations, &weights, &accumulators, nrRot, nrOfTasks](size_t chunk)
+    {
+        size_t begin = (nrRot * chunk) / nrOfTasks;
+        size_t end = (nrRot * (chunk + 1)) / nrOfTasks;
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            accumulators[chunk].addRotation(inputRotations[idx], weights.size() ? weights[idx] : 1.0);
+        }
+    };
+
+    if (nrOfTasks > 1)
+    {
+        options.threadPool->parallelFor(nrOfTasks, accumulateChunk);
+    }
+    else
+    {
+        accumulateChunk(0);
+    }
+
+    for (size_t chunk = 1; chunk < nrOfTasks; ++chunk)
+    {
+        accumulators[0].merge(accumulators[chunk]);
+    }
+
+    return accumulators[0].getMeanRotation(meanRotation);
+}
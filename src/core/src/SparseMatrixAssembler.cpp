@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Core/SparseMatrixAssembler.h>
+
+#include <iDynTree/Core/Triplets.h>
+#include <iDynTree/Core/Utils.h>
+
+#include <algorithm>
+
+namespace iDynTree {
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    SparseMatrixAssembler<ordering>::SparseMatrixAssembler() : SparseMatrixAssembler(0, 0) {}
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    SparseMatrixAssembler<ordering>::SparseMatrixAssembler(std::size_t rows, std::size_t cols)
+    : m_rows(rows)
+    , m_columns(cols)
+    , m_isFinalized(false)
+    , m_matrix(rows, cols)
+    { }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    void SparseMatrixAssembler<ordering>::resize(std::size_t rows, std::size_t cols)
+    {
+        m_rows = rows;
+        m_columns = cols;
+        m_slotRows.clear();
+        m_slotColumns.clear();
+        m_slotValueIndices.clear();
+        m_isFinalized = false;
+        m_matrix.resize(rows, cols);
+        m_matrix.zero();
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    void SparseMatrixAssembler<ordering>::reserve(std::size_t numberOfSlots)
+    {
+        m_slotRows.reserve(numberOfSlots);
+        m_slotColumns.reserve(numberOfSlots);
+        m_slotValueIndices.reserve(numberOfSlots);
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    std::size_t SparseMatrixAssembler<ordering>::rows() const { return m_rows; }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    std::size_t SparseMatrixAssembler<ordering>::columns() const { return m_columns; }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    std::size_t SparseMatrixAssembler<ordering>::numberOfSlots() const { return m_slotRows.size(); }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    std::size_t SparseMatrixAssembler<ordering>::numberOfNonZeros() const { return m_matrix.numberOfNonZeros(); }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    bool SparseMatrixAssembler<ordering>::addNonZero(std::size_t row, std::size_t col, std::size_t& slot)
+    {
+        if (row >= m_rows || col >= m_columns)
+        {
+            reportError("SparseMatrixAssembler", "addNonZero", "The element is outside the matrix.");
+            return false;
+        }
+
+        slot = m_slotRows.size();
+        m_slotRows.push_back(static_cast<int>(row));
+        m_slotColumns.push_back(static_cast<int>(col));
+        m_isFinalized = false;
+        return true;
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    bool SparseMatrixAssembler<ordering>::addDenseBlock(std::size_t startRow, std::size_t startCol,
+                                                        std::size_t blockRows, std::size_t blockCols,
+                                                        std::size_t& firstSlot)
+    {
+        if (startRow + blockRows > m_rows || startCol + blockCols > m_columns)
+        {
+            reportError("SparseMatrixAssembler", "addDenseBlock", "The block is outside the matrix.");
+            return false;
+        }
+
+        firstSlot = m_slotRows.size();
+        reserve(m_slotRows.size() + blockRows * blockCols);
+        for (std::size_t row = 0; row < blockRows; ++row)
+        {
+            for (std::size_t col = 0; col < blockCols; ++col)
+            {
+                m_slotRows.push_back(static_cast<int>(startRow + row));
+                m_slotColumns.push_back(static_cast<int>(startCol + col));
+            }
+        }
+        m_isFinalized = false;
+        return true;
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    bool SparseMatrixAssembler<ordering>::merge(const SparseMatrixAssembler& other,
+                                                std::size_t startRow, std::size_t startCol,
+                                                std::size_t& slotOffset)
+    {
+        if (startRow + other.m_rows > m_rows || startCol + other.m_columns > m_columns)
+        {
+            reportError("SparseMatrixAssembler", "merge", "The pattern of the merged assembler is outside the matrix.");
+            return false;
+        }
+
+        // Copy the slots of other first, in case other is this assembler
+        const std::size_t otherSlots = other.m_slotRows.size();
+        slotOffset = m_slotRows.size();
+        reserve(slotOffset + otherSlots);
+        for (std::size_t slot = 0; slot < otherSlots; ++slot)
+        {
+            m_slotRows.push_back(static_cast<int>(startRow) + other.m_slotRows[slot]);
+            m_slotColumns.push_back(static_cast<int>(startCol) + other.m_slotColumns[slot]);
+        }
+        m_isFinalized = false;
+        return true;
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    void SparseMatrixAssembler<ordering>::finalize()
+    {
+        iDynTree::Triplets triplets;
+        triplets.reserve(m_slotRows.size());
+        for (std::size_t slot = 0; slot < m_slotRows.size(); ++slot)
+        {
+            triplets.pushTriplet(Triplet(m_slotRows[slot], m_slotColumns[slot], 0.0));
+        }
+
+        m_matrix.resize(m_rows, m_columns);
+        m_matrix.zero();
+        m_matrix.setFromTriplets(triplets);
+
+        // Find the position of each slot in the compressed storage
+        const int* outerStarts = m_matrix.outerIndicesBuffer();
+        const int* innerIndices = m_matrix.innerIndicesBuffer();
+        m_slotValueIndices.resize(m_slotRows.size());
+        for (std::size_t slot = 0; slot < m_slotRows.size(); ++slot)
+        {
+            const int outer = ordering == iDynTree::RowMajor ? m_slotRows[slot] : m_slotColumns[slot];
+            const int inner = ordering == iDynTree::RowMajor ? m_slotColumns[slot] : m_slotRows[slot];
+            const int* found = std::lower_bound(innerIndices + outerStarts[outer],
+                                                innerIndices + outerStarts[outer + 1], inner);
+            assert(found != innerIndices + outerStarts[outer + 1] && *found == inner);
+            m_slotValueIndices[slot] = static_cast<std::size_t>(found - innerIndices);
+        }
+
+        m_isFinalized = true;
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    bool SparseMatrixAssembler<ordering>::isFinalized() const { return m_isFinalized; }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    bool SparseMatrixAssembler<ordering>::getSlot(std::size_t row, std::size_t col, std::size_t& slot) const
+    {
+        for (std::size_t i = 0; i < m_slotRows.size(); ++i)
+        {
+            if (static_cast<std::size_t>(m_slotRows[i]) == row && static_cast<std::size_t>(m_slotColumns[i]) == col)
+            {
+                slot = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    void SparseMatrixAssembler<ordering>::zero()
+    {
+        std::fill(m_matrix.valuesBuffer(), m_matrix.valuesBuffer() + m_matrix.numberOfNonZeros(), 0.0);
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    bool SparseMatrixAssembler<ordering>::setBlock(std::size_t firstSlot, MatrixView<const double> block)
+    {
+        const std::size_t blockSize = static_cast<std::size_t>(block.rows() * block.cols());
+        if (!m_isFinalized || firstSlot + blockSize > m_slotValueIndices.size())
+        {
+            reportError("SparseMatrixAssembler", "setBlock", "The pattern is not finalized or the block does not match the slots.");
+            return false;
+        }
+
+        double* values = m_matrix.valuesBuffer();
+        std::size_t slot = firstSlot;
+        for (std::ptrdiff_t row = 0; row < block.rows(); ++row)
+        {
+            for (std::ptrdiff_t col = 0; col < block.cols(); ++col)
+            {
+                values[m_slotValueIndices[slot++]] = block(row, col);
+            }
+        }
+        return true;
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    bool SparseMatrixAssembler<ordering>::addToBlock(std::size_t firstSlot, MatrixView<const double> block)
+    {
+        const std::size_t blockSize = static_cast<std::size_t>(block.rows() * block.cols());
+        if (!m_isFinalized || firstSlot + blockSize > m_slotValueIndices.size())
+        {
+            reportError("SparseMatrixAssembler", "addToBlock", "The pattern is not finalized or the block does not match the slots.");
+            return false;
+        }
+
+        double* values = m_matrix.valuesBuffer();
+        std::size_t slot = firstSlot;
+        for (std::ptrdiff_t row = 0; row < block.rows(); ++row)
+        {
+            for (std::ptrdiff_t col = 0; col < block.cols(); ++col)
+            {
+                values[m_slotValueIndices[slot++]] += block(row, col);
+            }
+        }
+        return true;
+    }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    const iDynTree::SparseMatrix<ordering>& SparseMatrixAssembler<ordering>::matrix() const { return m_matrix; }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    double* SparseMatrixAssembler<ordering>::valuesBuffer() { return m_matrix.valuesBuffer(); }
+
+    template <iDynTree::MatrixStorageOrdering ordering>
+    double const * SparseMatrixAssembler<ordering>::valuesBuffer() const { return m_matrix.valuesBuffer(); }
+
+}
+
+template class iDynTree::SparseMatrixAssembler<iDynTree::RowMajor>;
+template class iDynTree::SparseMatrixAssembler<iDynTree::ColumnMajor>;
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Core/ThreadPool.h>
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iDynTree
+{
+
+class ThreadPool::ThreadPoolPimpl
+{
+public:
+    std::vector<std::thread> workers;
+
+    // Protects all the following variables, except nextTask
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+
+    // Serializes the parallelFor calls
+    std::mutex callMutex;
+
+    const std::function<void(std::size_t)>* task;
+    std::size_t nrOfTasks;
+    std::atomic<std::size_t> nextTask;
+    std::size_t nrOfBusyWorkers;
+    unsigned long generation;
+    bool stop;
+
+    ThreadPoolPimpl()
+    : task(nullptr)
+    , nrOfTasks(0)
+    , nextTask(0)
+    , nrOfBusyWorkers(0)
+    , generation(0)
+    , stop(false)
+    {
+    }
+
+    void runTasks()
+    {
+        for (std::size_t t = nextTask.fetch_add(1); t < nrOfTasks; t = nextTask.fetch_add(1))
+        {
+            (*task)(t);
+        }
+    }
+
+    void workerLoop(unsigned long lastGeneration)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workAvailable.wait(lock, [&]{ return stop || generation != lastGeneration; });
+                if (stop)
+                {
+                    return;
+                }
+                lastGeneration = generation;
+            }
+
+            runTasks();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                nrOfBusyWorkers--;
+                if (nrOfBusyWorkers == 0)
+                {
+                    workDone.notify_one();
+                }
+            }
+        }
+    }
+
+    void startWorkers(const std::size_t nrOfWorkerThreads)
+    {
+        unsigned long currentGeneration;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = false;
+            currentGeneration = generation;
+        }
+
+        workers.reserve(nrOfWorkerThreads);
+        for (std::size_t w = 0; w < nrOfWorkerThreads; w++)
+        {
+            workers.emplace_back(&ThreadPoolPimpl::workerLoop, this, currentGeneration);
+        }
+    }
+
+    void stopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        workAvailable.notify_all();
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        workers.clear();
+    }
+};
+
+ThreadPool::ThreadPool(const std::size_t nrOfWorkerThreads)
+: m_pimpl(new ThreadPoolPimpl())
+{
+    assert(m_pimpl);
+    m_pimpl->startWorkers(nrOfWorkerThreads);
+}
+
+ThreadPool::~ThreadPool()
+{
+    assert(m_pimpl);
+    m_pimpl->stopWorkers();
+    delete m_pimpl;
+    m_pimpl = nullptr;
+}
+
+void ThreadPool::resize(const std::size_t nrOfWorkerThreads)
+{
+    assert(m_pimpl);
+    std::lock_guard<std::mutex> callLock(m_pimpl->callMutex);
+    if (nrOfWorkerThreads == m_pimpl->workers.size())
+    {
+        return;
+    }
+    m_pimpl->stopWorkers();
+    m_pimpl->startWorkers(nrOfWorkerThreads);
+}
+
+std::size_t ThreadPool::getNrOfWorkerThreads() const
+{
+    assert(m_pimpl);
+    return m_pimpl->workers.size();
+}
+
+std::size_t ThreadPool::getNrOfAvailableHardwareThreads()
+{
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+void ThreadPool::parallelFor(const std::size_t nrOfTasks, const std::function<void(std::size_t)>& task)
+{
+    assert(m_pimpl);
+    std::lock_guard<std::mutex> callLock(m_pimpl->callMutex);
+
+    // Nothing to distribute: avoid waking up the workers
+    if (m_pimpl->workers.empty() || nrOfTasks <= 1)
+    {
+        for (std::size_t t = 0; t < nrOfTasks; t++)
+        {
+            task(t);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_pimpl->mutex);
+        m_pimpl->task = &task;
+        m_pimpl->nrOfTasks = nrOfTasks;
+        m_pimpl->nextTask = 0;
+        m_pimpl->nrOfBusyWorkers = m_pimpl->workers.size();
+        m_pimpl->generation++;
+    }
+    m_pimpl->workAvailable.notify_all();
+
+    // The calling thread works as well
+    m_pimpl->runTasks();
+
+    std::unique_lock<std::mutex> lock(m_pimpl->mutex);
+    m_pimpl->workDone.wait(lock, [&]{ return m_pimpl->nrOfBusyWorkers == 0; });
+    m_pimpl->task = nullptr;
+}
+
+}
@@ -8,7 +8,9 @@
 #include "iDynTree/Core/CubicSpline.h"
 #include "iDynTree/Core/TestUtils.h"
 #include "iDynTree/Core/VectorFixSize.h"
+#include "iDynTree/Core/MatrixDynSize.h"
 #include <cmath>
+#include <vector>
 
 using namespace iDynTree;
 using namespace std;
@@ -80,7 +82,103 @@ bool splineTest(){
     return true;
 }
 
+bool multiSplineTest(){
+    const size_t nrOfChannels = 7;
+    const size_t nrOfKnots = 21;
+
+    // Each channel is a cubic polynomial, that is interpolated exactly
+    std::vector<Vector4> parameters(nrOfChannels);
+    for(size_t c = 0; c < nrOfChannels; ++c)
+        for(size_t i = 0; i < 4; ++i)
+            parameters[c](i) = getRandomDouble(-1.0, 1.0);
+
+    double initialTime = 1.0;
+    double finalTime = 2.0;
+    VectorDynSize tVec(nrOfKnots);
+    MatrixDynSize yData(nrOfKnots, nrOfChannels);
+    VectorDynSize v0(nrOfChannels), a0(nrOfChannels), vf(nrOfChannels), af(nrOfChannels);
+    for(size_t i = 0; i < nrOfKnots; ++i){
+        // Not evenly spaced knots
+        tVec(i) = initialTime + (finalTime - initialTime)*pow(static_cast<double>(i)/(nrOfKnots - 1), 1.5);
+        for(size_t c = 0; c < nrOfChannels; ++c){
+            const Vector4& p = parameters[c];
+            yData(i, c) = p(0) + p(1)*tVec(i) + p(2)*pow(tVec(i),2) + p(3)*pow(tVec(i),3);
+        }
+    }
+    for(size_t c = 0; c < nrOfChannels; ++c){
+        const Vector4& p = parameters[c];
+        v0(c) = p(1) + 2*p(2)*initialTime + 3*p(3)*pow(initialTime,2);
+        a0(c) = 2*p(2) + 6*p(3)*initialTime;
+        vf(c) = p(1) + 2*p(2)*finalTime + 3*p(3)*pow(finalTime,2);
+        af(c) = 2*p(2) + 6*p(3)*finalTime;
+    }
+
+    MultiCubicSpline spline;
+    assertTrue(!spline.setInitialConditions(make_span(v0), make_span(a0)));
+    assertTrue(spline.setData(tVec, yData));
+    assertTrue(spline.getNrOfChannels() == nrOfChannels);
+    assertTrue(spline.getNrOfKnots() == nrOfKnots);
+    assertTrue(spline.setInitialConditions(make_span(v0), make_span(a0)));
+    assertTrue(spline.setFinalConditions(make_span(vf), make_span(af)));
+
+    // Increasing times, then random times and outside the knots
+    const size_t nrOfTimes = 300;
+    VectorDynSize times(nrOfTimes);
+    for(size_t i = 0; i < nrOfTimes; ++i){
+        times(i) = (i < 200) ? initialTime + (finalTime - initialTime)*i/199.0 : getRandomDouble(0.5, 2.5);
+    }
+
+    MatrixDynSize positions(nrOfTimes, nrOfChannels);
+    MatrixDynSize velocities(nrOfTimes, nrOfChannels);
+    std::vector<double> accelerationsColMajor(nrOfTimes*nrOfChannels);
+    MatrixView<double> accelerations(accelerationsColMajor.data(), nrOfTimes, nrOfChannels, MatrixStorageOrdering::ColumnMajor);
+    assertTrue(spline.evaluateTrajectory(make_span(times), positions, velocities, accelerations));
+
+    VectorDynSize position(nrOfChannels), velocity(nrOfChannels), acceleration(nrOfChannels);
+    for(size_t i = 0; i < nrOfTimes; ++i){
+        double t = std::min(std::max(times(i), initialTime), finalTime);
+        assertTrue(spline.evaluatePoint(times(i), make_span(position), make_span(velocity), make_span(acceleration)));
+        for(size_t c = 0; c < nrOfChannels; ++c){
+            const Vector4& p = parameters[c];
+            assertDoubleAreEqual(p(0) + p(1)*t + p(2)*pow(t,2) + p(3)*pow(t,3), positions(i, c), 1e-9, "Pos i = ", i);
+            assertDoubleAreEqual(p(1) + 2*p(2)*t + 3*p(3)*pow(t,2), velocities(i, c), 1e-8, "Vel i = ", i);
+            assertDoubleAreEqual(2*p(2) + 6*p(3)*t, accelerations(i, c), 1e-6, "Acc i = ", i);
+            assertDoubleAreEqual(positions(i, c), position(c), 1e-12, "Pos i = ", i);
+            assertDoubleAreEqual(velocities(i, c), velocity(c), 1e-12, "Vel i = ", i);
+            assertDoubleAreEqual(accelerations(i, c), acceleration(c), 1e-12, "Acc i = ", i);
+        }
+    }
+
+    // Random data: each channel is the same as the scalar spline
+    for(size_t i = 0; i < nrOfKnots; ++i)
+        for(size_t c = 0; c < nrOfChannels; ++c)
+            yData(i, c) = getRandomDouble(-1.0, 1.0);
+    assertTrue(spline.setData(tVec, yData));
+
+    for(size_t c = 0; c < nrOfChannels; ++c){
+        CubicSpline scalarSpline;
+        VectorDynSize yChannel(nrOfKnots);
+        for(size_t i = 0; i < nrOfKnots; ++i)
+            yChannel(i) = yData(i, c);
+        assertTrue(scalarSpline.setData(tVec, yChannel));
+        scalarSpline.setInitialConditions(v0(c), a0(c));
+        scalarSpline.setFinalConditions(vf(c), af(c));
+
+        for(size_t i = 0; i < nrOfTimes; ++i){
+            assertTrue(spline.evaluatePoint(times(i), make_span(position)));
+            assertDoubleAreEqual(scalarSpline.evaluatePoint(times(i)), position(c), 1e-9, "Pos i = ", i);
+        }
+    }
+
+    // Wrong sizes
+    assertTrue(!spline.evaluatePoint(1.5, make_span(times)));
+    assertTrue(!spline.evaluateTrajectory(make_span(times), MatrixView<double>(yData)));
+    assertTrue(!spline.setData(tVec, MatrixView<const double>(positions)));
+    return true;
+}
+
 int main(){
     assertTrue(splineTest());
+    assertTrue(multiSplineTest());
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+// Check that the solver does not allocate memory once its workspace is allocated
+#define EIGEN_RUNTIME_NO_MALLOC
+
+#include <iDynTree/Core/EigenMathHelpers.h>
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/MatrixDynSize.h>
+#include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Core/VectorDynSize.h>
+
+#include <Eigen/QR>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace iDynTree;
+
+Eigen::MatrixXd getRandomMatrixOfRank(Eigen::Index rows, Eigen::Index cols, Eigen::Index rank)
+{
+    MatrixDynSize left(rows, rank), right(rank, cols);
+    getRandomMatrix(left);
+    getRandomMatrix(right);
+    return toEigen(left) * toEigen(right);
+}
+
+void checkSolver(PseudoInverseSolverMethod method, Eigen::Index rows, Eigen::Index cols, Eigen::Index rank)
+{
+    const double tol = 1e-7;
+    Eigen::MatrixXd A = getRandomMatrixOfRank(rows, cols, rank);
+
+    // Reference pseudo-inverse
+    Eigen::MatrixXd expectedPinv(cols, rows);
+    typedef Eigen::Map<Eigen::MatrixXd> MapType;
+    pseudoInverse(MapType(A.data(), rows, cols), MapType(expectedPinv.data(), cols, rows), tol);
+
+    PseudoInverseSolver solver(rows, cols, method);
+    solver.setTolerance(tol);
+    const double damping = 1e-2;
+    solver.setDamping(damping);
+    if (method == PseudoInverseSolverMethod::DampedLeastSquares)
+    {
+        expectedPinv = A.transpose() * (A * A.transpose() + damping * damping * Eigen::MatrixXd::Identity(rows, rows)).inverse();
+    }
+
+    // The same solver is reused for several matrices of the same size
+    for (int i = 0; i < 3; i++)
+    {
+        Eigen::internal::set_is_malloc_allowed(false);
+        ASSERT_IS_TRUE(solver.compute(A));
+        Eigen::internal::set_is_malloc_allowed(true);
+        if (method != PseudoInverseSolverMethod::DampedLeastSquares)
+        {
+            ASSERT_EQUAL_DOUBLE(solver.rank(), rank);
+        }
+
+        MatrixDynSize pinv(cols, rows);
+        ASSERT_IS_TRUE(solver.pseudoInverse(toEigen(pinv)));
+        ASSERT_EQUAL_MATRIX_TOL(pinv, MatrixView<const double>(expectedPinv), 1e-6);
+
+        VectorDynSize b(rows), x(cols);
+        getRandomVector(b);
+        Eigen::internal::set_is_malloc_allowed(false);
+        ASSERT_IS_TRUE(solver.solve(toEigen(b), toEigen(x)));
+        ASSERT_IS_TRUE(solver.pseudoInverse(toEigen(pinv)));
+        Eigen::internal::set_is_malloc_allowed(true);
+        Eigen::VectorXd expectedX = expectedPinv * toEigen(b);
+        ASSERT_EQUAL_VECTOR_TOL(x, Span<const double>(expectedX.data(), cols), 1e-6);
+
+        // Wrong sizes
+        VectorDynSize wrongX(cols + 1);
+        ASSERT_IS_FALSE(solver.solve(toEigen(b), toEigen(wrongX)));
+    }
+}
+
+void checkSmallSingularValues(PseudoInverseSolverMethod method, Eigen::Index rows, Eigen::Index cols)
+{
+    // Singular values between the default threshold of Eigen and the tolerance must be truncated
+    const double tol = 1e-3;
+    const Eigen::Index minSize = std::min(rows, cols);
+    Eigen::VectorXd singularValues = Eigen::VectorXd::LinSpaced(minSize, 10.0, 0.5);
+    singularValues(minSize - 1) = 1e-6;
+    singularValues(minSize - 2) = 1e-8;
+    Eigen::MatrixXd U = Eigen::HouseholderQR<Eigen::MatrixXd>(Eigen::MatrixXd::Random(rows, rows)).householderQ();
+    Eigen::MatrixXd V = Eigen::HouseholderQR<Eigen::MatrixXd>(Eigen::MatrixXd::Random(cols, cols)).householderQ();
+    Eigen::MatrixXd A = U.leftCols(minSize) * singularValues.asDiagonal() * V.leftCols(minSize).transpose();
+    Eigen::MatrixXd fullRankA = U.leftCols(minSize) * Eigen::VectorXd::LinSpaced(minSize, 1000.0, 0.5).asDiagonal() * V.leftCols(minSize).transpose();
+
+    // Reference pseudo-inverse, computed with the truncated SVD
+    Eigen::VectorXd singularValuesInverse = Eigen::VectorXd::Zero(minSize);
+    singularValuesInverse.head(minSize - 2) = singularValues.head(minSize - 2).cwiseInverse();
+    Eigen::MatrixXd expectedPinv = V.leftCols(minSize) * singularValuesInverse.asDiagonal() * U.leftCols(minSize).transpose();
+
+    // The matrix is decomposed by a new solver, and again after a full rank matrix with a different threshold
+    PseudoInverseSolver solver(rows, cols, method);
+    solver.setTolerance(tol);
+    for (int i = 0; i < 2; i++)
+    {
+        if (i > 0)
+        {
+            ASSERT_IS_TRUE(solver.compute(fullRankA));
+            ASSERT_EQUAL_DOUBLE(solver.rank(), minSize);
+        }
+
+        Eigen::internal::set_is_malloc_allowed(false);
+        ASSERT_IS_TRUE(solver.compute(A));
+        Eigen::internal::set_is_malloc_allowed(true);
+        ASSERT_EQUAL_DOUBLE(solver.rank(), minSize - 2);
+
+        MatrixDynSize pinv(cols, rows);
+        ASSERT_IS_TRUE(solver.pseudoInverse(toEigen(pinv)));
+        ASSERT_EQUAL_MATRIX_TOL(pinv, MatrixView<const double>(expectedPinv), 1e-6);
+
+        VectorDynSize b(rows), x(cols);
+        getRandomVector(b);
+        ASSERT_IS_TRUE(solver.solve(toEigen(b), toEigen(x)));
+        Eigen::VectorXd expectedX = expectedPinv * toEigen(b);
+        ASSERT_EQUAL_VECTOR_TOL(x, Span<const double>(expectedX.data(), cols), 1e-6);
+    }
+}
+
+int main()
+{
+    const PseudoInverseSolverMethod methods[] = {PseudoInverseSolverMethod::TruncatedSVD,
+                                                 PseudoInverseSolverMethod::DampedLeastSquares,
+                                                 PseudoInverseSolverMethod::CompleteOrthogonalDecomposition};
+
+    for (PseudoInverseSolverMethod method : methods)
+    {
+        // Square, wide and tall matrices, with full and deficient rank
+        checkSolver(method, 6, 6, 6);
+        checkSolver(method, 6, 20, 6);
+        checkSolver(method, 20, 6, 6);
+        if (method != PseudoInverseSolverMethod::DampedLeastSquares)
+        {
+            checkSolver(method, 6, 6, 4);
+            checkSolver(method, 6, 20, 3);
+            checkSolver(method, 20, 6, 5);
+            checkSmallSingularValues(method, 6, 6);
+            checkSmallSingularValues(method, 6, 20);
+            checkSmallSingularValues(method, 20, 6);
+        }
+    }
+
+    // Changing the method and the size of the matrix
+    PseudoInverseSolver solver;
+    Eigen::MatrixXd A = getRandomMatrixOfRank(5, 8, 5);
+    Eigen::VectorXd b = Eigen::VectorXd::Random(5);
+    Eigen::VectorXd x(8), expectedX(8);
+    ASSERT_IS_FALSE(solver.solve(b, x));
+    ASSERT_IS_TRUE(solver.compute(A));
+    ASSERT_IS_TRUE(solver.solve(b, expectedX));
+    solver.setMethod(PseudoInverseSolverMethod::CompleteOrthogonalDecomposition);
+    ASSERT_IS_TRUE(solver.compute(A));
+    ASSERT_IS_TRUE(solver.solve(b, x));
+    ASSERT_IS_TRUE(x.isApprox(expectedX, 1e-8));
+
+    return EXIT_SUCCESS;
+}
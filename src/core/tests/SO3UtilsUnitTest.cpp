@@ -8,6 +8,7 @@
 #include <iDynTree/Core/Utils.h>
 #include <iDynTree/Core/TestUtils.h>
 #include <iDynTree/Core/SO3Utils.h>
+#include <iDynTree/Core/ThreadPool.h>
 #include <iDynTree/Core/EigenHelpers.h>
 #include <Eigen/Dense>
 
@@ -135,6 +136,73 @@ void checkMeanRotation()
 
 }
 
+void checkChordalMeanRotation()
+{
+    // Rotations symmetrically perturbed around a center have the center as mean
+    iDynTree::Rotation center = iDynTree::getRandomRotation();
+    std::vector<iDynTree::Rotation> rotations;
+    std::vector<double> weights;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        iDynTree::AngularMotionVector3 perturbation;
+        iDynTree::getRandomVector(perturbation, -0.8, 0.8);
+        double weight = iDynTree::getRandomDouble();
+        rotations.push_back(center * perturbation.exp());
+        weights.push_back(weight);
+        toEigen(perturbation) *= -1.0;
+        rotations.push_back(center * perturbation.exp());
+        weights.push_back(weight);
+    }
+
+    iDynTree::Rotation chordalMean;
+    ASSERT_IS_TRUE(iDynTree::chordalL2WeightedMeanRotation(rotations, weights, chordalMean));
+    ASSERT_IS_TRUE(iDynTree::isValidRotationMatrix(chordalMean));
+    ASSERT_EQUAL_MATRIX_TOL(chordalMean, center, 1e-9);
+
+    // Streaming accumulation
+    iDynTree::ChordalMeanRotationAccumulator accumulator;
+    ASSERT_IS_FALSE(accumulator.getMeanRotation(chordalMean));
+    ASSERT_IS_FALSE(accumulator.addRotation(center, -1.0));
+    for (size_t i = 0; i < rotations.size(); ++i)
+    {
+        ASSERT_IS_TRUE(accumulator.addRotation(rotations[i], weights[i]));
+    }
+    ASSERT_EQUAL_DOUBLE(accumulator.getNumberOfRotations(), rotations.size());
+    ASSERT_EQUAL_DOUBLE(accumulator.getTotalWeight(), std::accumulate(weights.begin(), weights.end(), 0.0));
+    ASSERT_IS_TRUE(accumulator.getMeanRotation(chordalMean));
+    ASSERT_EQUAL_MATRIX_TOL(chordalMean, center, 1e-9);
+
+    // Multithreaded accumulation on a non symmetric set of rotations
+    rotations.clear();
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        iDynTree::AngularMotionVector3 perturbation;
+        iDynTree::getRandomVector(perturbation, -0.3, 0.3);
+        rotations.push_back(center * perturbation.exp());
+    }
+
+    iDynTree::Rotation singleThreadMean, multiThreadMean;
+    ASSERT_IS_TRUE(iDynTree::chordalL2MeanRotation(rotations, singleThreadMean));
+    iDynTree::ThreadPool threadPool(3);
+    iDynTree::ChordalL2MeanOptions options;
+    options.threadPool = &threadPool;
+    options.minRotationsPerTask = 100;
+    ASSERT_IS_TRUE(iDynTree::chordalL2MeanRotation(rotations, multiThreadMean, options));
+    ASSERT_EQUAL_MATRIX_TOL(singleThreadMean, multiThreadMean, 1e-9);
+
+    // The chordal mean is close to the geodesic one, and can be used as its initial guess
+    iDynTree::Rotation geodesicMean;
+    iDynTree::GeodesicL2MeanOptions geodesicOptions;
+    geodesicOptions.useChordalMeanAsInitialGuess = true;
+    geodesicOptions.maxIterations = 1000;
+    geodesicOptions.tolerance = 1e-8;
+    ASSERT_IS_TRUE(iDynTree::geodesicL2MeanRotation(rotations, geodesicMean, geodesicOptions));
+    ASSERT_IS_TRUE(iDynTree::geodesicL2Distance(geodesicMean, singleThreadMean) < 1e-2);
+
+    ASSERT_IS_FALSE(iDynTree::chordalL2MeanRotation(std::vector<iDynTree::Rotation>(), chordalMean));
+    ASSERT_IS_FALSE(iDynTree::chordalL2WeightedMeanRotation(rotations, std::vector<double>(3, 1.0), chordalMean));
+}
+
 int main()
 {
 
@@ -142,6 +210,7 @@ int main()
     checkGeodesicDistance();
     checkWeightedMeanRotation();
     checkMeanRotation();
+    checkChordalMeanRotation();
 
     return EXIT_SUCCESS;
 }
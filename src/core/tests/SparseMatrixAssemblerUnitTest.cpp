@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Core/SparseMatrixAssembler.h>
+#include <iDynTree/Core/EigenSparseHelpers.h>
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/MatrixDynSize.h>
+#include <iDynTree/Core/TestUtils.h>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace iDynTree;
+
+template <iDynTree::MatrixStorageOrdering ordering>
+void checkAssembledMatrix(SparseMatrixAssembler<ordering>& assembler, const Eigen::MatrixXd& expected)
+{
+    Eigen::MatrixXd assembled = toEigen(assembler);
+    ASSERT_IS_TRUE(assembled.isApprox(expected));
+    for (std::size_t row = 0; row < assembler.rows(); ++row) {
+        for (std::size_t col = 0; col < assembler.columns(); ++col) {
+            ASSERT_EQUAL_DOUBLE(assembler.matrix()(row, col), expected(row, col));
+        }
+    }
+}
+
+template <iDynTree::MatrixStorageOrdering ordering>
+void testAssembly()
+{
+    SparseMatrixAssembler<ordering> assembler(6, 8);
+
+    // Symbolic phase: single elements (with a duplicated position) and a dense block
+    std::size_t slot02, slot51, slot02Duplicated, blockSlot;
+    ASSERT_IS_TRUE(assembler.addNonZero(0, 2, slot02));
+    ASSERT_IS_TRUE(assembler.addNonZero(5, 1, slot51));
+    ASSERT_IS_TRUE(assembler.addNonZero(0, 2, slot02Duplicated));
+    ASSERT_IS_TRUE(assembler.addDenseBlock(2, 4, 3, 2, blockSlot));
+    ASSERT_IS_FALSE(assembler.addNonZero(6, 0, slot02));
+    ASSERT_IS_FALSE(assembler.addDenseBlock(4, 4, 3, 2, blockSlot));
+    ASSERT_IS_FALSE(assembler.isFinalized());
+    ASSERT_EQUAL_DOUBLE(assembler.numberOfSlots(), 9);
+
+    assembler.finalize();
+    ASSERT_IS_TRUE(assembler.isFinalized());
+    ASSERT_EQUAL_DOUBLE(assembler.numberOfNonZeros(), 8);
+
+    std::size_t slot;
+    ASSERT_IS_TRUE(assembler.getSlot(5, 1, slot));
+    ASSERT_EQUAL_DOUBLE(slot, slot51);
+    ASSERT_IS_FALSE(assembler.getSlot(1, 1, slot));
+
+    // Numeric phase, repeated as at each step of an algorithm
+    const double* valuesBuffer = assembler.valuesBuffer();
+    for (int step = 0; step < 3; ++step) {
+        Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(6, 8);
+        MatrixDynSize block(3, 2);
+        getRandomMatrix(block);
+
+        assembler.zero();
+        double value = getRandomDouble();
+        assembler.setSlot(slot51, value);
+        expected(5, 1) = value;
+        value = getRandomDouble();
+        assembler.addToSlot(slot02, value);
+        expected(0, 2) += value;
+        value = getRandomDouble();
+        assembler.addToSlot(slot02Duplicated, value);
+        expected(0, 2) += value;
+        ASSERT_IS_TRUE(assembler.setBlock(blockSlot, block));
+        ASSERT_IS_TRUE(assembler.addToBlock(blockSlot, block));
+        expected.block(2, 4, 3, 2) = 2.0 * toEigen(block);
+
+        ASSERT_EQUAL_DOUBLE(assembler.getSlotValue(slot02), expected(0, 2));
+        checkAssembledMatrix(assembler, expected);
+
+        // The pattern and its storage are not modified by the numeric phase
+        ASSERT_IS_TRUE(assembler.valuesBuffer() == valuesBuffer);
+        ASSERT_EQUAL_DOUBLE(assembler.numberOfNonZeros(), 8);
+    }
+
+    // The Eigen map shares the storage of the assembler
+    auto map = toEigen(assembler);
+    ASSERT_IS_TRUE(map.valuePtr() == assembler.valuesBuffer());
+    const double valueBeforeScaling = assembler.getSlotValue(slot51);
+    map.coeffs() *= 2.0;
+    ASSERT_EQUAL_DOUBLE(assembler.getSlotValue(slot51), 2.0 * valueBeforeScaling);
+
+    MatrixDynSize wrongBlock(3, 3);
+    ASSERT_IS_FALSE(assembler.setBlock(blockSlot + 1, wrongBlock));
+}
+
+template <iDynTree::MatrixStorageOrdering ordering>
+void testMerge()
+{
+    // Two components fill the blocks of a larger matrix, with an overlapping element
+    SparseMatrixAssembler<ordering> first(3, 3), second(2, 4);
+    std::size_t firstSlot, secondSlot, diagonalSlot;
+    ASSERT_IS_TRUE(first.addDenseBlock(0, 0, 3, 3, firstSlot));
+    ASSERT_IS_TRUE(second.addNonZero(0, 0, secondSlot));
+    ASSERT_IS_TRUE(second.addNonZero(1, 3, diagonalSlot));
+
+    SparseMatrixAssembler<ordering> merged(5, 7);
+    std::size_t firstOffset, secondOffset, selfOffset;
+    ASSERT_IS_TRUE(merged.merge(first, 0, 0, firstOffset));
+    ASSERT_IS_TRUE(merged.merge(second, 2, 2, secondOffset));
+    ASSERT_IS_FALSE(merged.merge(second, 4, 2, selfOffset));
+    ASSERT_EQUAL_DOUBLE(firstOffset, 0);
+    ASSERT_EQUAL_DOUBLE(secondOffset, 9);
+    merged.finalize();
+
+    // (2, 2) is in the pattern of both components
+    ASSERT_EQUAL_DOUBLE(merged.numberOfNonZeros(), 10);
+
+    Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(5, 7);
+    MatrixDynSize block(3, 3);
+    getRandomMatrix(block);
+    ASSERT_IS_TRUE(merged.setBlock(firstOffset + firstSlot, block));
+    expected.topLeftCorner<3, 3>() = toEigen(block);
+    merged.addToSlot(secondOffset + secondSlot, 1.0);
+    expected(2, 2) += 1.0;
+    merged.addToSlot(secondOffset + diagonalSlot, 3.0);
+    expected(3, 5) += 3.0;
+    checkAssembledMatrix(merged, expected);
+
+    // Merging an assembler with itself duplicates its slots
+    ASSERT_IS_TRUE(first.merge(first, 0, 0, selfOffset));
+    ASSERT_EQUAL_DOUBLE(first.numberOfSlots(), 18);
+    first.finalize();
+    ASSERT_EQUAL_DOUBLE(first.numberOfNonZeros(), 9);
+
+    // The assembler can be reused with a different size
+    merged.resize(2, 2);
+    merged.finalize();
+    ASSERT_EQUAL_DOUBLE(merged.numberOfSlots(), 0);
+    ASSERT_EQUAL_DOUBLE(merged.numberOfNonZeros(), 0);
+    checkAssembledMatrix(merged, Eigen::MatrixXd::Zero(2, 2));
+}
+
+int main()
+{
+    testAssembly<iDynTree::RowMajor>();
+    testAssembly<iDynTree::ColumnMajor>();
+    testMerge<iDynTree::RowMajor>();
+    testMerge<iDynTree::ColumnMajor>();
+
+    return EXIT_SUCCESS;
+}
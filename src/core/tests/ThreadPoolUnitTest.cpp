@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Core/ThreadPool.h>
+#include <iDynTree/Core/TestUtils.h>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace iDynTree;
+
+void checkParallelFor(ThreadPool& pool, const size_t nrOfTasks)
+{
+    std::vector<size_t> results(nrOfTasks, 0);
+    for (size_t repetition = 0; repetition < 10; repetition++)
+    {
+        pool.parallelFor(nrOfTasks, [&](size_t task) { results[task] += task; });
+    }
+
+    for (size_t task = 0; task < nrOfTasks; task++)
+    {
+        ASSERT_IS_TRUE(results[task] == 10 * task);
+    }
+}
+
+int main()
+{
+    ThreadPool sequentialPool;
+    ASSERT_IS_TRUE(sequentialPool.getNrOfWorkerThreads() == 0);
+    checkParallelFor(sequentialPool, 0);
+    checkParallelFor(sequentialPool, 7);
+
+    ThreadPool pool(3);
+    ASSERT_IS_TRUE(pool.getNrOfWorkerThreads() == 3);
+    checkParallelFor(pool, 1);
+    checkParallelFor(pool, 2);
+    checkParallelFor(pool, 1000);
+
+    pool.resize(1);
+    ASSERT_IS_TRUE(pool.getNrOfWorkerThreads() == 1);
+    checkParallelFor(pool, 100);
+
+    ASSERT_IS_TRUE(ThreadPool::getNrOfAvailableHardwareThreads() >= 1);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef IDYNTREE_ATTITUDE_ESTIMATOR_BATCH_H
+#define IDYNTREE_ATTITUDE_ESTIMATOR_BATCH_H
+
+#include <iDynTree/Estimation/AttitudeEstimator.h>
+#include <iDynTree/Estimation/AttitudeMahonyFilter.h>
+#include <iDynTree/Estimation/AttitudeQuaternionEKF.h>
+#include <iDynTree/Core/Direction.h>
+#include <iDynTree/Core/MatrixView.h>
+#include <iDynTree/Core/Span.h>
+
+#include <vector>
+
+namespace iDynTree
+{
+
+/**
+ * Type of the attitude estimator run for each IMU of an AttitudeEstimatorBatch.
+ */
+enum AttitudeEstimatorBatchFilterType
+{
+    ATTITUDE_BATCH_MAHONY_FILTER,  ///< explicit complementary filter, same equations of AttitudeMahonyFilter
+    ATTITUDE_BATCH_QUATERNION_EKF  ///< quaternion EKF, same equations of AttitudeQuaternionEKF
+};
+
+/**
+ * @class AttitudeEstimatorBatch Runs the attitude estimators of several IMUs in lock-step.
+ *
+ * All the IMUs share the same filter type and parameters, and are updated together
+ * with the measurements of a single tick passed as contiguous buffers, in which the
+ * 3 elements of the i-th IMU start at index 3*i.
+ *
+ * The orientation estimates are stored as 4 contiguous planes (one for each quaternion element,
+ * real part first), so that the Mahony filter equations are evaluated for all the IMUs at once
+ * by vectorized kernels. For the quaternion EKF, the filters are stored contiguously and
+ * called directly (without virtual dispatch), and their quaternions are written to the planes
+ * after each step.
+ *
+ * Usage:
+ * - call init() with the number of IMUs and the filter type,
+ * - optionally set the filter parameters, the gravity direction and the initial orientations,
+ * - in a loop, call propagateStates() and updateFilterWithMeasurements(),
+ *   and read the estimates with getOrientationEstimatesAsQuaternions().
+ */
+class AttitudeEstimatorBatch
+{
+public:
+    AttitudeEstimatorBatch();
+
+    /**
+     * @brief Allocate the filters of nrOfIMUs IMUs, with identity initial orientation.
+     * The parameters previously set for the selected filter type are kept.
+     * @param[in] nrOfIMUs number of IMUs
+     * @param[in] filterType type of the filter run for each IMU
+     * @return true/false if successful/not
+     */
+    bool init(const size_t nrOfIMUs, const AttitudeEstimatorBatchFilterType filterType);
+
+    /**
+     * @brief Get the number of IMUs handled by the batch.
+     */
+    size_t getNrOfIMUs() const;
+
+    /**
+     * @brief Get the type of the filter run for each IMU.
+     */
+    AttitudeEstimatorBatchFilterType getFilterType() const;
+
+    /**
+     * @brief Set the parameters used by the Mahony filters.
+     * This does not reset the internal state.
+     * @param[in] params Mahony filter parameters
+     */
+    void setMahonyFilterParameters(const AttitudeMahonyFilterParameters& params);
+
+    /**
+     * @brief Set the parameters used by the quaternion EKFs.
+     * If the filter type is ATTITUDE_BATCH_QUATERNION_EKF, this re-initializes the covariance
+     * matrices of the filters, keeping their current state estimate.
+     * @param[in] params quaternion EKF parameters
+     * @return true/false if successful/not
+     */
+    bool setQuaternionEKFParameters(const AttitudeQuaternionEKFParameters& params);
+
+    /**
+     * @brief Set the gravity direction assumed by all the filters.
+     * @param[in] gravity_dir gravity direction
+     */
+    void setGravityDirection(const iDynTree::Direction& gravity_dir);
+
+    /**
+     * @brief Set the initial orientation of all the IMUs.
+     * @param[in] orientations \f$ N \times 4 \f$ matrix, the i-th row is the quaternion of the i-th IMU
+     * @return true/false if successful/not
+     */
+    bool setInternalStateInitialOrientations(MatrixView<const double> orientations);
+
+    /**
+     * @brief Pass the measurements of all the IMUs to the filters.
+     * @param[in] linAccMeas accelerometer measurements, of size 3*getNrOfIMUs()
+     * @param[in] gyroMeas gyroscope measurements, of size 3*getNrOfIMUs()
+     * @return true/false if successful/not
+     */
+    bool updateFilterWithMeasurements(Span<const double> linAccMeas,
+                                      Span<const double> gyroMeas);
+
+    /**
+     * @brief Pass the measurements of all the IMUs to the filters.
+     * The magnetometer measurements are ignored if the filters do not use them.
+     * @param[in] linAccMeas accelerometer measurements, of size 3*getNrOfIMUs()
+     * @param[in] gyroMeas gyroscope measurements, of size 3*getNrOfIMUs()
+     * @param[in] magMeas magnetometer measurements, of size 3*getNrOfIMUs()
+     * @return true/false if successful/not
+     */
+    bool updateFilterWithMeasurements(Span<const double> linAccMeas,
+                                      Span<const double> gyroMeas,
+                                      Span<const double> magMeas);
+
+    /**
+     * @brief Propagate the states of all the filters.
+     * @return true/false if successful/not
+     */
+    bool propagateStates();
+
+    /**
+     * @brief Get the orientation estimates of all the IMUs.
+     * @return \f$ N \times 4 \f$ column major view on the internal buffer, the i-th row is the
+     *         quaternion of the i-th IMU. The view is valid until the next call to init().
+     */
+    MatrixView<const double> getOrientationEstimatesAsQuaternions() const;
+
+    /**
+     * @brief Get the orientation estimate of a single IMU.
+     * @param[in] imuIndex index of the IMU
+     * @param[out] q orientation estimate
+     * @return true/false if successful/not
+     */
+    bool getOrientationEstimateAsQuaternion(const size_t imuIndex, iDynTree::UnitQuaternion& q) const;
+
+private:
+    bool checkMeasurementsSize(Span<const double> meas, const char* measurementType, const char* methodName) const;
+    bool updateMahonyFilters(Span<const double> linAccMeas,
+                             Span<const double> gyroMeas,
+                             Span<const double> magMeas);
+    bool updateQuaternionEKFs(Span<const double> linAccMeas,
+                              Span<const double> gyroMeas,
+                              Span<const double> magMeas);
+    void copyQuaternionEKFOrientations();
+
+    size_t m_nrOfIMUs;
+    AttitudeEstimatorBatchFilterType m_filterType;
+    AttitudeMahonyFilterParameters m_params_mahony;
+    AttitudeQuaternionEKFParameters m_params_qekf;
+    iDynTree::Direction m_gravity_direction;
+    iDynTree::Direction m_earth_magnetic_field_direction;
+
+    // Planes of the SoA state, each of them contains one element for each IMU
+    std::vector<double> m_orientations;      ///< 4 planes, quaternions
+    std::vector<double> m_angular_velocities; ///< 3 planes, Mahony angular velocity estimates
+    std::vector<double> m_gyroscope_biases;  ///< 3 planes, Mahony gyroscope bias estimates
+    std::vector<double> m_omega_mes;         ///< 3 planes, Mahony vectorial estimate from accelerometer and magnetometer
+    std::vector<double> m_Omega_y;           ///< 3 planes, last gyroscope measurements
+    std::vector<double> m_workspace;         ///< scratch planes used by the Mahony kernels
+
+    std::vector<iDynTree::AttitudeQuaternionEKF> m_qekfs;
+};
+
+}
+
+#endif
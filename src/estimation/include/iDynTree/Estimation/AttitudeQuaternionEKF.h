@@ -12,7 +12,7 @@
 #define ATTITUDE_QUATERNION_EKF_H
 
 #include <iDynTree/Estimation/AttitudeEstimator.h>
-#include <iDynTree/Estimation/ExtendedKalmanFilter.h>
+#include <iDynTree/Estimation/ExtendedKalmanFilterFixedSize.h>
 #include <iDynTree/Core/Direction.h>
 
 namespace iDynTree
@@ -20,6 +20,7 @@ namespace iDynTree
     const unsigned int output_dimensions_with_magnetometer = 4;        ///< dimension of \f$ \mathbb{R}^3 \times \mathbb{R} \f$ accelerometer measurements and magnetometer yaw measurement
     const unsigned int output_dimensions_without_magnetometer = 3;     ///< dimension of \f$ \mathbb{R}^3 \f$ accelerometer measurements
     const unsigned int input_dimensions = 3;                           ///< dimension of \f$ \mathbb{R}^3 \f$ gyroscope measurements
+    const unsigned int qekf_state_dimensions = 10;                     ///< dimension of the state of the quaternion EKF, \f$ \mathbb{R}^4 \times \mathbb{R}^3 \times \mathbb{R}^3 \f$
 
     /**
      * @struct AttitudeQuaternionEKFParameters Parameters to set up the quaternion EKF
@@ -98,7 +99,7 @@ namespace iDynTree
      * The usage of the QEKF should follow the decribed procedure below,
      * - instantiate the filter
      * - set parameters
-     * - call initializeFilter() (this is necessary for resizing the buffers, the user should call this method after setting parameters)
+     * - call initializeFilter() (this is necessary for setting the covariances, the user should call this method after setting parameters)
      * - use setInternalState() to set initial state (The filter will throw an error, if this is not called atleast once, this enforces the user to set intial state)
      * - Once initialized, the following filter methods can be run in a loop to get the orientation estimates,
      *     - propagateStates() method to propagate the states and covariance
@@ -109,10 +110,30 @@ namespace iDynTree
      * and sets the previous estiamted state as the inital state.
      * @note calling other set parameter methods does not reset the filter, since they are not associated with changing the output dimensions
      *
+     * The filter is implemented on top of DiscreteExtendedKalmanFilterFixedSizeHelper, so all its buffers are fixed size and no
+     * dynamic memory allocation is performed while running the filter. The filter always has four outputs: if the magnetometer
+     * measurements are not used, the fourth output is a dummy measurement with zero value, zero prediction, a zero row in the
+     * measurement Jacobian and unit variance. The innovation covariance is then block diagonal, with the dummy block equal to
+     * the variance, so the fourth column of the Kalman gain is zero and the update is the same of a filter with three outputs.
+     * The unit variance only keeps the innovation covariance positive definite, its value does not change the estimate.
+     *
      */
-    class AttitudeQuaternionEKF : public IAttitudeEstimator,
-                                  public DiscreteExtendedKalmanFilterHelper
+    class AttitudeQuaternionEKF : public IAttitudeEstimator
+#ifndef SWIG
+                                , public DiscreteExtendedKalmanFilterFixedSizeHelper<AttitudeQuaternionEKF,
+                                                                                     qekf_state_dimensions,
+                                                                                     input_dimensions,
+                                                                                     output_dimensions_with_magnetometer>
+#endif
     {
+#ifndef SWIG
+        typedef DiscreteExtendedKalmanFilterFixedSizeHelper<AttitudeQuaternionEKF,
+                                                            qekf_state_dimensions,
+                                                            input_dimensions,
+                                                            output_dimensions_with_magnetometer> FixedSizeHelper;
+        friend FixedSizeHelper;
+#endif
+
     public:
         AttitudeQuaternionEKF();
 
@@ -194,10 +215,7 @@ namespace iDynTree
         bool setInitialStateCovariance(double orientation_var, double ang_vel_var, double gyro_bias_var);
 
         /**
-         * @brief intializes the filter by resizing buffers and setting parameters
-         * - sets state, output and input dimensions for the ekf
-         * - resizes internal buffers
-         * - calls ekfInit()
+         * @brief intializes the filter by setting parameters
          * - sets system noise, measurement noise and initial state covariance
          * - if successful sets initialized flag to true
          * @return true/false if successful/not
@@ -220,6 +238,35 @@ namespace iDynTree
         bool setInternalState(const iDynTree::Span<double> & stateBuffer) override;
         bool setInternalStateInitialOrientation(const iDynTree::Span<double>& orientationBuffer) override;
 
+        /** @name Extended Kalman filter interface
+         * Methods of DiscreteExtendedKalmanFilterHelper, with the same signatures of the dynamic size filter
+         * that this class implemented before being ported to DiscreteExtendedKalmanFilterFixedSizeHelper
+         * (the fixed size helper is not exposed in the bindings). The sizes of the filter cannot be changed:
+         * the state has qekf_state_dimensions elements, the input has input_dimensions elements, and the measurements
+         * have output_dimensions_with_magnetometer elements, or output_dimensions_without_magnetometer elements
+         * if the magnetometer measurements are not used (in that case, the dummy fourth output is set internally).
+         */
+        ///@{
+        bool ekfPredict();
+        bool ekfUpdate();
+
+        /**
+         * @brief Check that the filter is ready to be used, the buffers have a fixed size and are never resized
+         */
+        bool ekfInit();
+        void ekfReset();
+        bool ekfSetMeasurementVector(const iDynTree::Span<double>& y);
+        bool ekfSetInputVector(const iDynTree::Span<double>& u);
+        bool ekfSetInitialState(const iDynTree::Span<double>& x0);
+        bool ekfSetStateCovariance(const iDynTree::Span<double>& P);
+        bool ekfSetSystemNoiseCovariance(const iDynTree::Span<double>& Q);
+        bool ekfSetMeasurementNoiseCovariance(const iDynTree::Span<double>& R);
+        bool ekfGetStates(const iDynTree::Span<double>& x) const;
+        bool ekfGetStateCovariance(const iDynTree::Span<double>& P) const;
+        void ekfSetUpdateMode(const EKFUpdateMode& mode);
+        EKFUpdateMode ekfGetUpdateMode() const;
+        ///@}
+
     protected:
         AttitudeEstimatorState m_state_qekf, m_initial_state_qekf;
         AttitudeQuaternionEKFParameters m_params_qekf;   ///< struct holding the QEKF parameters
@@ -232,9 +279,9 @@ namespace iDynTree
          * \f$ u = \begin{bmatrix} y_{gyro}_x & y_{gyro}_y & y_{gyro}_z \end{bmatrix}^T \f$
          * \f$ f(X, u) = \begin{bmatrix} q_{k} \otimes \text{exp}(\omega \Delta T) \\ y_{gyro} - b \\ (1 - \lambda_{b} \Delta t)b \end{bmatrix}\f$
          */
-        bool ekf_f(const iDynTree::VectorDynSize& x_k,
-               const iDynTree::VectorDynSize& u_k,
-               iDynTree::VectorDynSize& xhat_k_plus_one) override;
+        bool ekf_f(const StateVector& x_k,
+                   const InputVector& u_k,
+                   StateVector& xhat_k_plus_one);
 
         /**
          * discrete measurement prediction
@@ -242,18 +289,18 @@ namespace iDynTree
          * \f$ h_{acc}(X) = R^T \begin{bmatrix} 0 \\  0 \\ -1 \end{bmatrix} \f$
          * \f$ h_{mag}(X) = atan2(tan(yaw))\f$
          */
-        bool ekf_h(const iDynTree::VectorDynSize& xhat_k_plus_one,
-               iDynTree::VectorDynSize& zhat_k_plus_one) override;
+        bool ekf_h(const StateVector& xhat_k_plus_one,
+                   OutputVector& zhat_k_plus_one);
 
         /**
          * @brief Describes the system Jacobian necessary for the propagation of predicted state covariance
          *        The analytical Jacobian describing the partial derivative of the system propagation with respect to the state
          * @param[in] x system state
+         * @param[in] u system input, not used as the Jacobian does not depend on it
          * @param[out] F system Jacobian
          * @return bool true/false if successful or not
          */
-        bool ekfComputeJacobianF(iDynTree::VectorDynSize& x, iDynTree::MatrixDynSize& F) override;
-        bool ekfComputeJacobianF(iDynTree::VectorDynSize& x, iDynTree::VectorDynSize& u, iDynTree::MatrixDynSize& F) override;
+        bool ekfComputeJacobianF(const StateVector& x, const InputVector& u, StateMatrix& F);
 
         /**
          * @brief Describes the measurement Jacobian necessary for computing Kalman gain and updating the predicted state and its covariance
@@ -262,7 +309,7 @@ namespace iDynTree
          * @param[out] H measurement Jacobian
          * @return bool true/false if successful or not
          */
-        bool ekfComputeJacobianH(iDynTree::VectorDynSize& x, iDynTree::MatrixDynSize& H) override;
+        bool ekfComputeJacobianH(const StateVector& x, OutputJacobianMatrix& H);
 
         /** @brief prepares the system noise covariance matrix using internal struct params
          * system  model is as good as gyroscope measurement and bias estimate
@@ -272,32 +319,33 @@ namespace iDynTree
          * \f$ U = diag(\begin{bmatrix} \sigma_{gyro}^{2} I_{3 \times 3} & \sigma_{gyrobias}^{2} I_{3 \times 3} \end{bmatrix}) \f$
          * @param[in] Q matrix container as reference
          */
-        void prepareSystemNoiseCovarianceMatrix(iDynTree::MatrixDynSize &Q);
+        void prepareSystemNoiseCovarianceMatrix(StateMatrix &Q);
 
         /** @brief prepares the measurement noise covariance matrix using internal struct parameters
          * measurement noise depends only on accelerometer measurement along x-,y- and z- directions
          * along with magnetometer z-direction if included
          * measurement noise covariance can be descibed as,
          * \f$ R = \begin{bmatrix} \sigma_{acc}^{2} I_{3 \times 3} & 0_{3 \times 1} \\ 0_{1 \times 3} & \sigma_{mag}^{2}\f$
-         * if magnetometer measurements is also considered. In case of magnetometer measurements not being considered, it is reduced
-         * to the \f$ 3 \times 3 \f$ matrix
+         * if magnetometer measurements is also considered. In case of magnetometer measurements not being considered,
+         * the magnetometer measurement and its prediction are always zero and its Jacobian is zero, so the unit
+         * variance used in its place does not affect the update of the accelerometer measurements
          * @param[in] R matrix container as reference
          */
-        void prepareMeasurementNoiseCovarianceMatrix(iDynTree::MatrixDynSize &R);
+        void prepareMeasurementNoiseCovarianceMatrix(OutputMatrix &R);
 
         /**
-         * @brief serializes the state struct to state x of VectorDynSize
+         * @brief serializes the state struct to state x of StateVector
          */
         void serializeStateVector();
 
         /**
-         * @brief deserializes state x of VectorDynSize to the state struct
+         * @brief deserializes state x of StateVector to the state struct
          */
         void deserializeStateVector();
 
         /**
          * @brief serializes the accelerometer and magenetometer measurements into y vector
-         * since DiscreteExtendedKalmanFilter expects a VectorDynSize including all necessary measurements
+         * since the filter expects a vector including all necessary measurements
          */
         void serializeMeasurementVector();
 
@@ -317,13 +365,9 @@ namespace iDynTree
         iDynTree::LinearAccelerometerMeasurements m_Acc_y;       ///< 3d accelerometer measurement giving proper classical acceleration expressed in body frame
         double m_Mag_y;                                          ///< magnetometer yaw measurement expressed in body frame
 
-        iDynTree::VectorDynSize m_x;                             ///< state vector for the EKF - orientation, angular velocity, gyro bias
-        iDynTree::VectorDynSize m_y;                             ///< measurement vector for the EKF - accelerometer (and magnetometer yaw)
-        iDynTree::VectorDynSize m_u;                             ///< input vector for the EKF - gyroscope measurement
+        StateVector m_x;                                         ///< state vector for the EKF - orientation, angular velocity, gyro bias
+        OutputVector m_y;                                        ///< measurement vector for the EKF - accelerometer (and magnetometer yaw)
 
-        size_t m_state_size;                                     ///< state dimensions
-        size_t m_output_size;                                    ///< output dimensions
-        size_t m_input_size;                                     ///< input dimensions
         bool m_initialized{false};                               ///< flag to check if QEKF is initialized
 
         iDynTree::Matrix4x4 m_Id4;                               ///< \f$ 4 \times 4 \f$  identity matrix
@@ -75,6 +75,82 @@ namespace iDynTree {
         void getLastEstimate(iDynTree::VectorDynSize& lastEstimate) const;
         const iDynTree::VectorDynSize& getLastEstimate() const;
 
+        /**
+         * @name Fixed-lag smoothing
+         *
+         * When the window length is greater than one, doEstimate() stacks the information
+         * of the last windowLength samples and couples the dynamic variables of consecutive
+         * samples with a process model, i.e. a random walk on the dynamic variables
+         * \f$ d_{k+1} = d_k + w_k \f$, with \f$ w_k \sim \mathcal{N}(0, \Sigma_p) \f$, and,
+         * optionally, the trapezoidal integration of the joint accelerations into the
+         * measured joint velocities:
+         * \f[ \dot{s}_{k+1} - \dot{s}_k = \frac{\Delta t}{2} (\ddot{s}_k + \ddot{s}_{k+1}) + v_k,
+         *     v_k \sim \mathcal{N}(0, \sigma^2_{\ddot{s}} I) \f]
+         *
+         * The resulting block-banded sparse system is factorized at each call of doEstimate().
+         * Its sparsity pattern and the fill-reducing ordering are computed only while the window
+         * is filling up (or when the window parameters change), while for the following
+         * samples only the numerical values are updated, so that the cost per new sample is constant.
+         *
+         * The oldest sample is dropped from the window when a new one is added.
+         * getLastEstimate() returns the estimate of the most recent sample of the window.
+         */
+        ///@{
+
+        /**
+         * Set the number of samples of the sliding window.
+         *
+         * @param[in] windowLength number of samples stacked in the window. A value of 1 (the default) disables the smoothing.
+         * @param[in] samplingTime time in seconds between two consecutive calls of doEstimate().
+         * @return true if all went well, false otherwise.
+         * @note Changing the window resets the samples stored in it.
+         */
+        bool setFixedLagWindow(const size_t windowLength, const double samplingTime);
+
+        /**
+         * Get the number of samples of the sliding window.
+         */
+        size_t getFixedLagWindowLength() const;
+
+        /**
+         * Get the number of samples currently stored in the sliding window.
+         */
+        size_t getNrOfSamplesInWindow() const;
+
+        /**
+         * Remove all the samples stored in the sliding window.
+         */
+        void resetFixedLagWindow();
+
+        /**
+         * Set the covariance \f$ \Sigma_p \f$ of the random walk process model on the dynamic variables.
+         *
+         * By default it is the identity matrix.
+         * @return true if all went well, false if the size of the covariance does not match the number of dynamic variables.
+         */
+        bool setProcessModelCovariance(const iDynTree::SparseMatrix<iDynTree::ColumnMajor>& covariance);
+
+        const iDynTree::SparseMatrix<iDynTree::ColumnMajor>& processModelCovarianceInverse() const; // Sigma_p^-1
+
+        /**
+         * Set the variance \f$ \sigma^2_{\ddot{s}} \f$ of the integration of the joint accelerations
+         * into the joint velocities.
+         *
+         * A non-positive value (the default) disables the coupling.
+         */
+        void setJointAccelerationIntegrationVariance(const double variance);
+
+        /**
+         * Get the smoothed estimate of the sample that was added lag calls of doEstimate() ago.
+         *
+         * @param[in] lag 0 for the most recent sample, getNrOfSamplesInWindow()-1 for the oldest one.
+         * @param[out] estimate the smoothed estimate of the dynamic variables of the requested sample.
+         * @return true if all went well, false if the requested sample is not in the window.
+         */
+        bool getSmoothedEstimate(const size_t lag, iDynTree::VectorDynSize& estimate) const;
+
+        ///@}
+
 
     };
 }
@@ -21,10 +21,16 @@
 #include <iDynTree/Model/FreeFloatingState.h>
 #include <iDynTree/Model/LinkTraversalsCache.h>
 
+#include <iDynTree/Core/MatrixView.h>
+
 #include <iDynTree/Sensors/Sensors.h>
+#include <iDynTree/Sensors/PredictSensorsMeasurements.h>
+
+#include <vector>
 
 namespace iDynTree
 {
+class ThreadPool;
 
 /**
  * \brief Estimator for external wrenches and joint torques using internal F/T sensors.
@@ -58,6 +64,9 @@ class ExtWrenchesAndJointTorquesEstimator
     /**< Traveral used for the dynamics computations */
     Traversal m_dynamicTraversal;
 
+    /**< Precomputed data to simulate the sensors with m_dynamicTraversal */
+    SensorsPredictionPlan m_sensorsPredictionPlan;
+
     /**
      * Vector of Traversal used for the kinematic computations.
      * m_kinematicTraversals.getTraversalWithLinkAsBase(l) contains the traversal with base link l .
@@ -73,6 +82,12 @@ class ExtWrenchesAndJointTorquesEstimator
 
     estimateExternalWrenchesBuffers m_calibBufs;
     estimateExternalWrenchesBuffers m_bufs;
+
+    /**
+     * Persistent pool of threads used for estimating the submodels in parallel,
+     * it is created only if the parallel estimation is enabled.
+     */
+    ThreadPool * m_threadPool;
     
     /**
      * Disable copy constructor and copy operator
@@ -134,6 +149,36 @@ public:
                                                       const std::string filetype="");
 
 
+    /**
+     * Set the method used to compute the pseudo inverse of the estimation equations.
+     *
+     * The pseudo inverse of each submodel is anyhow recomputed only when the
+     * unknown contacts or the joint positions of the submodel change.
+     * By default JACOBI_SVD_PSEUDOINVERSE is used.
+     *
+     * @param[in] method the method used to compute the pseudo inverse.
+     */
+    void setPseudoInverseMethod(const ExternalWrenchesPseudoInverseMethod method);
+
+    /**
+     * Enable the estimation of the submodels in parallel.
+     *
+     * The estimation problems of the submodels (one for each part of the model
+     * delimited by the six axis F/T sensors) are independent once the kinematics is known.
+     * If enabled, estimateExtWrenchesAndJointTorques distributes them on a persistent pool of
+     * threads owned by this class, to reduce the latency of the estimation. The results
+     * do not depend on the number of threads used.
+     *
+     * @param[in] nrOfWorkerThreads number of threads used in addition to the calling one.
+     *                              0 (the default) disables the parallel estimation.
+     */
+    void setNrOfEstimationWorkerThreads(const size_t nrOfWorkerThreads);
+
+    /**
+     * Get the number of threads used for the estimation in addition to the calling one.
+     */
+    size_t getNrOfEstimationWorkerThreads() const;
+
     /**
      * Get used model.
      *
@@ -259,6 +304,49 @@ public:
                                                   LinkContactWrenches & estimatedContactWrenches,
                                                   JointDOFsDoubleArray & estimatedJointTorques);
 
+    /**
+     * \brief Estimate the external wrenches and the joint torques for all the samples of a recorded dataset.
+     *
+     * The result is the same of calling updateKinematicsFromFloatingBase and estimateExtWrenchesAndJointTorques
+     * for each sample, but the samples are split in contiguous chunks that are processed in parallel by the
+     * threads set with setNrOfEstimationWorkerThreads (sequentially if no worker thread is set), each chunk
+     * using its own estimation buffers. The kinematic information set with the updateKinematics* methods is not modified.
+     *
+     * All the input and output matrices have one row for each sample.
+     *
+     * @param[in] jointPos nrOfSamples x getNrOfPosCoords() matrix of the joint positions.
+     * @param[in] jointVel nrOfSamples x getNrOfDOFs() matrix of the joint velocities.
+     * @param[in] jointAcc nrOfSamples x getNrOfDOFs() matrix of the joint accelerations.
+     * @param[in] floatingFrame the index of the frame for which kinematic information is provided.
+     * @param[in] properClassicalLinearAcceleration nrOfSamples x 3 matrix of the proper classical acceleration
+     *                                              of the floating frame, see updateKinematicsFromFloatingBase.
+     * @param[in] angularVel nrOfSamples x 3 matrix of the angular velocity of the floating frame.
+     * @param[in] angularAcc nrOfSamples x 3 matrix of the angular acceleration of the floating frame.
+     * @param[in] ftSensorsMeasures nrOfSamples x 6*nrOfFTSensors matrix of the measurements of the F/T sensors,
+     *                              the columns 6*i ... 6*i+5 contain the force and the torque measured by
+     *                              the i-th six axis force torque sensor of sensors().
+     * @param[in] contactSets the different sets of unknown external wrenches present in the dataset.
+     * @param[in] contactSetOfSample vector of nrOfSamples elements, the index in contactSets of the unknowns of each sample.
+     * @param[out] estimatedContactWrenches nrOfSamples x (at least) 6*maxNrOfContacts matrix, where maxNrOfContacts is the largest
+     *                                      number of contacts in the used contact sets. The estimated contact wrenches of
+     *                                      each sample are stored six columns each, ordered by link index and then by
+     *                                      contact index in the link. The remaining columns are set to zero.
+     * @param[out] estimatedJointTorques nrOfSamples x getNrOfDOFs() matrix of the estimated joint torques.
+     * @return true if all went ok, false otherwise.
+     */
+    bool estimateExtWrenchesAndJointTorquesBatch(MatrixView<const double> jointPos,
+                                                 MatrixView<const double> jointVel,
+                                                 MatrixView<const double> jointAcc,
+                                                 const FrameIndex & floatingFrame,
+                                                 MatrixView<const double> properClassicalLinearAcceleration,
+                                                 MatrixView<const double> angularVel,
+                                                 MatrixView<const double> angularAcc,
+                                                 MatrixView<const double> ftSensorsMeasures,
+                                                 const std::vector<LinkUnknownWrenchContacts> & contactSets,
+                                                 const std::vector<size_t> & contactSetOfSample,
+                                                 MatrixView<double> estimatedContactWrenches,
+                                                 MatrixView<double> estimatedJointTorques);
+
     /**
      * Check if the kinematics set in the model are the one of a fixed model.
      *
@@ -18,6 +18,38 @@
 
 namespace iDynTree
 {
+    /**
+     * Method used by DiscreteExtendedKalmanFilterHelper::ekfUpdate() to compute
+     * the Kalman gain and the updated state covariance.
+     */
+    enum EKFUpdateMode
+    {
+        /**
+         * Kalman gain computed with the explicit inverse of the innovation covariance,
+         * and covariance updated as \f$ P = \hat{P} - K H \hat{P} \f$ (default).
+         */
+        EKF_UPDATE_STANDARD,
+
+        /**
+         * Kalman gain computed with a Cholesky solve of the innovation covariance,
+         * and covariance updated as \f$ P = \hat{P} - K H \hat{P} \f$ .
+         */
+        EKF_UPDATE_CHOLESKY,
+
+        /**
+         * Kalman gain computed with a Cholesky solve of the innovation covariance,
+         * and covariance updated in the Joseph form \f$ P = (I - K H) \hat{P} (I - K H)^T + K R K^T \f$ ,
+         * that keeps the covariance symmetric and positive definite in long runs.
+         */
+        EKF_UPDATE_JOSEPH,
+
+        /**
+         * The measurements are processed one at a time as scalar updates, without
+         * factorizing the innovation covariance. Valid only if the measurement noise covariance is diagonal.
+         */
+        EKF_UPDATE_SEQUENTIAL
+    };
+
 
     /**
      * @class DiscreteExtendedKalmanFilterHelper naive base class implementation of discrete EKF with additive Gaussian noise
@@ -141,6 +173,8 @@ namespace iDynTree
          *        Updated covariance \f$ P_{k+1} = \hat{P}_{k+1} - (K_{k+1} H \hat{P}_{k+1}) \f$
          *        Updated state estimate \f$ x_{k+1} = \hat{x}_{k+1} + K_{k+1} \tilde{y}_{k+1} \f$
          *
+         * @note the way in which the Kalman gain and the updated covariance are computed
+         *       can be chosen with ekfSetUpdateMode(), see EKFUpdateMode
          * @warning this function can be called only after setting up the filter properly through ekfInit() step
          * @note this function should be once called every step, after setting up the measurement vector using ekfSetMeasurementVector() method
          * @warning setting up the measurement vector everytime before calling the ekfUpdate() method is crucial, the update step is not performed if this step is skipped
@@ -292,6 +326,20 @@ namespace iDynTree
          */
         bool ekfGetStateCovariance(const iDynTree::Span<double> &P) const;
 
+        /**
+         * @brief Set the method used by ekfUpdate() to compute the Kalman gain and the updated covariance
+         * @param[in] mode the update mode, see EKFUpdateMode
+         * @note the EKF_UPDATE_SEQUENTIAL mode can be used only if the measurement noise covariance is diagonal,
+         *       otherwise ekfUpdate() will fail
+         */
+        void ekfSetUpdateMode(const EKFUpdateMode& mode) { m_update_mode = mode; }
+
+        /**
+         * @brief Get the method used by ekfUpdate() to compute the Kalman gain and the updated covariance
+         * @return the update mode, see EKFUpdateMode
+         */
+        EKFUpdateMode ekfGetUpdateMode() const { return m_update_mode; }
+
    protected:
         /**
         * function template to ignore unused parameters
@@ -316,6 +364,15 @@ namespace iDynTree
         iDynTree::MatrixDynSize m_S;                   ///< innovation covariance
         iDynTree::MatrixDynSize m_K;                   ///< Kalman gain
         iDynTree::MatrixDynSize m_R;                   ///< measurement noise covariance
+        iDynTree::VectorDynSize m_z;                   ///< predicted measurement, then innovation
+        iDynTree::MatrixDynSize m_PHt;                 ///< workspace for the product of the predicted covariance and the transposed measurement jacobian
+        iDynTree::MatrixDynSize m_Kt;                  ///< workspace for the transposed Kalman gain
+        iDynTree::MatrixDynSize m_IKH;                 ///< workspace for the Joseph form update
+        iDynTree::MatrixDynSize m_XX;                  ///< workspace for the products of state sized matrices
+        iDynTree::MatrixDynSize m_KR;                  ///< workspace for the Joseph form update
+        iDynTree::MatrixDynSize m_Schol;               ///< workspace for the Cholesky factor of the innovation covariance
+        EKFUpdateMode m_update_mode{EKF_UPDATE_STANDARD}; ///< method used in the update step
+        bool m_R_is_diagonal{true};                    ///< flag to check if the measurement noise covariance is diagonal
         bool m_is_initialized{false};                  ///< flag to check if filter is properly initialized
         bool m_measurement_updated{false};             ///< flag to check if measurement is updated at each update step
         bool m_input_updated{false};                   ///< flag to check if control input is updated at each prediction step
@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef EXTENDED_KALMAN_FILTER_FIXED_SIZE_H
+#define EXTENDED_KALMAN_FILTER_FIXED_SIZE_H
+
+#include <iDynTree/Estimation/ExtendedKalmanFilter.h>
+#include <iDynTree/Core/VectorFixSize.h>
+#include <iDynTree/Core/MatrixFixSize.h>
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Span.h>
+#include <iDynTree/Core/Utils.h>
+
+#include <Eigen/Cholesky>
+
+namespace iDynTree
+{
+
+    /**
+     * @class DiscreteExtendedKalmanFilterFixedSizeHelper discrete EKF with additive Gaussian noise and compile-time dimensions
+     *
+     * This class implements the same equations of DiscreteExtendedKalmanFilterHelper,
+     * but the dimensions of the state, input and output are template parameters,
+     * so all the vectors and matrices of the filter are fixed size and stored in the object itself,
+     * and the prediction and update steps do not perform any dynamic memory allocation.
+     * This is meant for small filters that need to run at high rates, such as AttitudeQuaternionEKF.
+     *
+     * The system model is provided by the Derived class (curiously recurring template pattern),
+     * that must implement the following methods (that can be private, if this class is declared as friend):
+     *
+     * \code
+     * bool ekf_f(const StateVector& x_k, const InputVector& u_k, StateVector& xhat_k_plus_one);
+     * bool ekf_h(const StateVector& xhat_k_plus_one, OutputVector& zhat_k_plus_one);
+     * bool ekfComputeJacobianF(const StateVector& x, const InputVector& u, StateMatrix& F);
+     * bool ekfComputeJacobianH(const StateVector& x, OutputJacobianMatrix& H);
+     * \endcode
+     *
+     * with the same meaning of the corresponding virtual methods of DiscreteExtendedKalmanFilterHelper.
+     * As the model methods are resolved at compile time, they can be inlined in the filter steps.
+     *
+     * Before running the filter, the initial state, the initial state covariance and
+     * the noise covariances should be set, then the filter can be run by
+     *  - calling ekfSetInputVector() to set the control inputs and then calling ekfPredict() at each prediction step, and
+     *  - calling ekfSetMeasurementVector() to set the measurements and then calling ekfUpdate() at each update step
+     *
+     * @warning This class is still in active development, and so API interface can change between iDynTree versions.
+     * \ingroup iDynTreeExperimental
+     */
+    template <class Derived, unsigned int StateSize, unsigned int InputSize, unsigned int OutputSize>
+    class DiscreteExtendedKalmanFilterFixedSizeHelper
+    {
+    public:
+        typedef iDynTree::VectorFixSize<StateSize> StateVector;
+        typedef iDynTree::VectorFixSize<InputSize> InputVector;
+        typedef iDynTree::VectorFixSize<OutputSize> OutputVector;
+        typedef iDynTree::MatrixFixSize<StateSize, StateSize> StateMatrix;
+        typedef iDynTree::MatrixFixSize<OutputSize, StateSize> OutputJacobianMatrix;
+        typedef iDynTree::MatrixFixSize<OutputSize, OutputSize> OutputMatrix;
+
+        DiscreteExtendedKalmanFilterFixedSizeHelper()
+        {
+            m_x.zero();
+            m_xhat.zero();
+            m_u.zero();
+            m_y.zero();
+            m_F.zero();
+            m_P.zero();
+            m_Phat.zero();
+            m_Q.zero();
+            m_H.zero();
+            m_R.zero();
+        }
+
+        /**
+         * @brief Implements the Discrete EKF prediction equation, see DiscreteExtendedKalmanFilterHelper::ekfPredict()
+         * @return bool true/false if successful or not
+         */
+        bool ekfPredict()
+        {
+            if (!m_initial_state_set)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfPredict", "initial state not set.");
+                return false;
+            }
+
+            if (!m_initial_state_covariance_set)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfPredict", "initial state covariance not set.");
+                return false;
+            }
+
+            if (!m_input_updated)
+            {
+                iDynTree::reportWarning("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfPredict", "input not updated. using old input");
+            }
+
+            // propagate states and compute jacobian
+            if (!derived().ekf_f(m_x, m_u, m_xhat) ||           ///< \f$ \hat{x}_{k+1} = f(x_k, u_k) \f$
+                !derived().ekfComputeJacobianF(m_x, m_u, m_F))  ///< \f$ F \mid_{x = x_k} \f$
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfPredict", "system model evaluation failed.");
+                return false;
+            }
+
+            using iDynTree::toEigen;
+            auto F(toEigen(m_F));
+
+            // propagate covariance
+            toEigen(m_Phat) = F*toEigen(m_P)*F.transpose() + toEigen(m_Q);   ///< \f$ \hat{P}_{k+1} = F_k P_k F_k^T + Q \f$
+            m_input_updated = false;
+            return true;
+        }
+
+        /**
+         * @brief Implements the Discrete EKF update equation, see DiscreteExtendedKalmanFilterHelper::ekfUpdate()
+         * @note the way in which the Kalman gain and the updated covariance are computed
+         *       can be chosen with ekfSetUpdateMode(), see EKFUpdateMode
+         * @return bool true/false if successful or not
+         */
+        bool ekfUpdate()
+        {
+            if (!m_initial_state_set)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfUpdate", "initial state not set.");
+                return false;
+            }
+
+            if (!m_initial_state_covariance_set)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfUpdate", "initial state covariance not set.");
+                return false;
+            }
+
+            if (!m_measurement_updated)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfUpdate", "measurements not updated.");
+                return false;
+            }
+
+            if (m_update_mode == EKF_UPDATE_SEQUENTIAL && !m_R_is_diagonal)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfUpdate", "sequential update requires a diagonal measurement noise covariance.");
+                return false;
+            }
+
+            OutputVector z;
+            if (!derived().ekf_h(m_xhat, z) ||                   ///< \f$ z_{k+1} = h(\hat{x}_{k+1}) \f$
+                !derived().ekfComputeJacobianH(m_xhat, m_H))     ///< \f$ H \mid_{x = \hat{x}_{k+1}} \f$
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfUpdate", "measurement model evaluation failed.");
+                return false;
+            }
+
+            using iDynTree::toEigen;
+            auto P(toEigen(m_P));
+            auto Phat(toEigen(m_Phat));
+            auto H(toEigen(m_H));
+            auto R(toEigen(m_R));
+            auto x(toEigen(m_x));
+            auto xhat(toEigen(m_xhat));
+            Eigen::Matrix<double, OutputSize, 1> y = toEigen(m_y) - toEigen(z);    ///< innovation \f$ \tilde{y}_{k+1} = y_{k+1} - z_{k+1} \f$
+            Eigen::Matrix<double, StateSize, OutputSize> PHt = Phat*H.transpose();
+
+            if (m_update_mode == EKF_UPDATE_SEQUENTIAL)
+            {
+                x = xhat;
+                P = Phat;
+                for (unsigned int i = 0; i < OutputSize; i++)
+                {
+                    Eigen::Matrix<double, StateSize, 1> Ph = P*H.row(i).transpose();
+                    double s = H.row(i).dot(Ph) + R(i, i);
+                    if (!(s > 0.0))
+                    {
+                        iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfUpdate", "innovation covariance is not positive definite.");
+                        return false;
+                    }
+                    double innovation = y(i) - H.row(i).dot(x - xhat);
+                    x += (innovation/s)*Ph;
+                    P -= (Ph/s)*Ph.transpose();
+                }
+
+                m_measurement_updated = false;
+                return true;
+            }
+
+            Eigen::Matrix<double, OutputSize, OutputSize> S = H*PHt + R;    ///< \f$ S_{k+1} = H_{k+1} \hat{P}_{k+1} H_{k+1}^T + R \f$
+            Eigen::Matrix<double, StateSize, OutputSize> K;
+
+            if (m_update_mode == EKF_UPDATE_STANDARD)
+            {
+                K = PHt*S.inverse();                                           ///< \f$ K_{k+1} = \hat{P}_{k+1} H_{k+1}^T S_{k+1}^{-1} \f$
+            }
+            else
+            {
+                Eigen::LLT<Eigen::Matrix<double, OutputSize, OutputSize> > llt(S);
+                if (llt.info() != Eigen::Success)
+                {
+                    iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", "ekfUpdate", "innovation covariance is not positive definite.");
+                    return false;
+                }
+                K = llt.solve(PHt.transpose()).transpose();
+            }
+
+            if (m_update_mode == EKF_UPDATE_JOSEPH)
+            {
+                Eigen::Matrix<double, StateSize, StateSize> IKH = Eigen::Matrix<double, StateSize, StateSize>::Identity() - K*H;
+                P = IKH*Phat*IKH.transpose() + K*R*K.transpose();   ///< \f$ P_{k+1} = (I - K_{k+1} H) \hat{P}_{k+1} (I - K_{k+1} H)^T + K_{k+1} R K_{k+1}^T \f$
+            }
+            else
+            {
+                P = Phat - K*PHt.transpose();                        ///< \f$ P_{k+1} = \hat{P}_{k+1} - (K_{k+1} H \hat{P}_{k+1}) \f$
+            }
+
+            x = xhat + K*y;                                          ///< \f$ x_{k+1} = \hat{x}_{k+1} + K_{k+1} \tilde{y}_{k+1} \f$
+
+            m_measurement_updated = false;
+            return true;
+        }
+
+        /**
+         * @brief Resets the filter flags, see DiscreteExtendedKalmanFilterHelper::ekfReset()
+         */
+        void ekfReset()
+        {
+            m_measurement_updated = false;
+            m_input_updated = false;
+            m_initial_state_set = false;
+            m_initial_state_covariance_set = false;
+        }
+
+        /**
+         * @brief Set measurement vector at every time step
+         * @param[in] y measurement vector
+         */
+        void ekfSetMeasurementVector(const OutputVector& y)
+        {
+            m_y = y;
+            m_measurement_updated = true;
+        }
+
+        /**
+         * @brief Set measurement vector at every time step
+         * the measurement vector size and output size should match
+         * @param[in] y iDynTree::Span object to access the measurement vector
+         * @return bool true/false if successful or not
+         */
+        bool ekfSetMeasurementVector(const iDynTree::Span<const double>& y)
+        {
+            if (!copyFromSpan(y, m_y.data(), OutputSize, "ekfSetMeasurementVector"))
+            {
+                return false;
+            }
+            m_measurement_updated = true;
+            return true;
+        }
+
+        /**
+         * @brief Set input vector at every time step
+         * @param[in] u input vector
+         */
+        void ekfSetInputVector(const InputVector& u)
+        {
+            m_u = u;
+            m_input_updated = true;
+        }
+
+        /**
+         * @brief Set input vector at every time step
+         * the input vector size and input size should match
+         * @param[in] u iDynTree::Span object to access the input vector
+         * @return bool true/false if successful or not
+         */
+        bool ekfSetInputVector(const iDynTree::Span<const double>& u)
+        {
+            if (!copyFromSpan(u, m_u.data(), InputSize, "ekfSetInputVector"))
+            {
+                return false;
+            }
+            m_input_updated = true;
+            return true;
+        }
+
+        /**
+         * @brief Set initial state
+         * @param[in] x0 initial state vector
+         */
+        void ekfSetInitialState(const StateVector& x0)
+        {
+            m_x = x0;
+            m_initial_state_set = true;
+        }
+
+        /**
+         * @brief Set initial state
+         * the size of x0 and state size should match
+         * @param[in] x0 iDynTree::Span object to access the state vector
+         * @return bool true/false if successful or not
+         */
+        bool ekfSetInitialState(const iDynTree::Span<const double>& x0)
+        {
+            if (!copyFromSpan(x0, m_x.data(), StateSize, "ekfSetInitialState"))
+            {
+                return false;
+            }
+            m_initial_state_set = true;
+            return true;
+        }
+
+        /**
+         * @brief Set state covariance matrix
+         * @param[in] P state covariance matrix
+         */
+        void ekfSetStateCovariance(const StateMatrix& P)
+        {
+            m_P = P;
+            m_initial_state_covariance_set = true;
+        }
+
+        /**
+         * @brief Set state covariance matrix
+         * the size of P and (state size*state size) should match
+         * @param[in] P iDynTree::Span object to access the state covariance matrix, in row-major ordering
+         * @return bool true/false if successful or not
+         */
+        bool ekfSetStateCovariance(const iDynTree::Span<const double>& P)
+        {
+            if (!copyFromSpan(P, m_P.data(), StateSize*StateSize, "ekfSetStateCovariance"))
+            {
+                return false;
+            }
+            m_initial_state_covariance_set = true;
+            return true;
+        }
+
+        /**
+         * @brief Set system noise covariance matrix
+         * @param[in] Q system noise covariance matrix
+         */
+        void ekfSetSystemNoiseCovariance(const StateMatrix& Q)
+        {
+            m_Q = Q;
+        }
+
+        /**
+         * @brief Set system noise covariance matrix
+         * the size of Q and (state size*state size) should match
+         * @param[in] Q iDynTree::Span object to access the system noise covariance matrix, in row-major ordering
+         * @return bool true/false if successful or not
+         */
+        bool ekfSetSystemNoiseCovariance(const iDynTree::Span<const double>& Q)
+        {
+            return copyFromSpan(Q, m_Q.data(), StateSize*StateSize, "ekfSetSystemNoiseCovariance");
+        }
+
+        /**
+         * @brief Set measurement noise covariance matrix
+         * @param[in] R measurement noise covariance matrix
+         */
+        void ekfSetMeasurementNoiseCovariance(const OutputMatrix& R)
+        {
+            m_R = R;
+            updateMeasurementNoiseCovarianceStructure();
+        }
+
+        /**
+         * @brief Set measurement noise covariance matrix
+         * the size of R and (output size*output size) should match
+         * @param[in] R iDynTree::Span object to access the measurement noise covariance matrix, in row-major ordering
+         * @return bool true/false if successful or not
+         */
+        bool ekfSetMeasurementNoiseCovariance(const iDynTree::Span<const double>& R)
+        {
+            if (!copyFromSpan(R, m_R.data(), OutputSize*OutputSize, "ekfSetMeasurementNoiseCovariance"))
+            {
+                return false;
+            }
+            updateMeasurementNoiseCovarianceStructure();
+            return true;
+        }
+
+        /**
+         * @brief Get current internal state of the filter
+         */
+        const StateVector& ekfStates() const { return m_x; }
+
+        /**
+         * @brief Get current state covariance matrix of the filter
+         */
+        const StateMatrix& ekfStateCovariance() const { return m_P; }
+
+        /**
+         * @brief Get current internal state of the filter
+         * the size of x and state size should match
+         * @param[out] x iDynTree::Span object to copy the internal state vector into
+         * @return bool true/false if successful or not
+         */
+        bool ekfGetStates(const iDynTree::Span<double>& x) const
+        {
+            return copyToSpan(m_x.data(), StateSize, x, "ekfGetStates");
+        }
+
+        /**
+         * @brief Get state covariance matrix
+         * the size of P and (state size*state size) should match
+         * @param[out] P iDynTree::Span object to copy the internal state covariance matrix onto, in row-major ordering
+         * @return bool true/false if successful or not
+         */
+        bool ekfGetStateCovariance(const iDynTree::Span<double>& P) const
+        {
+            return copyToSpan(m_P.data(), StateSize*StateSize, P, "ekfGetStateCovariance");
+        }
+
+        /**
+         * @brief Set the method used by ekfUpdate() to compute the Kalman gain and the updated covariance
+         * @param[in] mode the update mode, see EKFUpdateMode
+         */
+        void ekfSetUpdateMode(const EKFUpdateMode& mode) { m_update_mode = mode; }
+
+        /**
+         * @brief Get the method used by ekfUpdate() to compute the Kalman gain and the updated covariance
+         * @return the update mode, see EKFUpdateMode
+         */
+        EKFUpdateMode ekfGetUpdateMode() const { return m_update_mode; }
+
+    protected:
+        /**
+        * function template to ignore unused parameters
+        */
+        template <typename T>
+        void ignore(T &&) { }
+
+    private:
+        Derived& derived() { return *static_cast<Derived*>(this); }
+
+        bool copyFromSpan(const iDynTree::Span<const double>& in, double* out, const size_t size, const char* method)
+        {
+            if ((size_t)in.size() != size)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", method, "size mismatch");
+                return false;
+            }
+
+            for (size_t i = 0; i < size; i++)
+            {
+                out[i] = in(i);
+            }
+            return true;
+        }
+
+        bool copyToSpan(const double* in, const size_t size, const iDynTree::Span<double>& out, const char* method) const
+        {
+            if ((size_t)out.size() != size)
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterFixedSizeHelper", method, "size mismatch");
+                return false;
+            }
+
+            for (size_t i = 0; i < size; i++)
+            {
+                out(i) = in[i];
+            }
+            return true;
+        }
+
+        void updateMeasurementNoiseCovarianceStructure()
+        {
+            m_R_is_diagonal = true;
+            for (unsigned int i = 0; i < OutputSize; i++)
+            {
+                for (unsigned int j = 0; j < OutputSize; j++)
+                {
+                    if (i != j && m_R(i, j) != 0.0)
+                    {
+                        m_R_is_diagonal = false;
+                    }
+                }
+            }
+        }
+
+        StateVector m_x;                               ///< state at time instant k
+        InputVector m_u;                               ///< input at time instant k
+        OutputVector m_y;                              ///< measurements at time instant k
+        StateVector m_xhat;                            ///< predicted state at time instant k before updating measurements
+
+        StateMatrix m_F;                               ///< System jacobian
+        StateMatrix m_P;                               ///< State covariance
+        StateMatrix m_Phat;                            ///< State covariance estimate before updating measurements
+        StateMatrix m_Q;                               ///< system noise covariance
+        OutputJacobianMatrix m_H;                      ///< measurement jacobian
+        OutputMatrix m_R;                              ///< measurement noise covariance
+        EKFUpdateMode m_update_mode{EKF_UPDATE_STANDARD}; ///< method used in the update step
+        bool m_R_is_diagonal{true};                    ///< flag to check if the measurement noise covariance is diagonal
+        bool m_measurement_updated{false};             ///< flag to check if measurement is updated at each update step
+        bool m_input_updated{false};                   ///< flag to check if control input is updated at each prediction step
+        bool m_initial_state_set{false};               ///< flag to check if the initial state of the filter is set
+        bool m_initial_state_covariance_set{false};    ///< flag to check if the initial covariance is set properly
+    };
+}
+
+#endif
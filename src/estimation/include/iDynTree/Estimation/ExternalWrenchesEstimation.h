@@ -17,6 +17,10 @@
 #include <iDynTree/Core/VectorDynSize.h>
 #include <iDynTree/Core/VectorFixSize.h>
 
+#ifndef SWIG
+#include <iDynTree/Core/EigenMathHelpers.h>
+#endif
+
 #include <iDynTree/Model/Indices.h>
 #include <iDynTree/Model/LinkState.h>
 
@@ -34,6 +38,7 @@ class LinkVelArray;
 class LinkAccArray;
 class JointPosDoubleArray;
 class JointDOFsDoubleArray;
+class ThreadPool;
 
 /**
  * Type of a UnknownWrenchContact.
@@ -214,6 +219,25 @@ public:
     std::string toString(const Model & model) const;
 };
 
+/**
+ * Method used to compute the pseudo inverse of the matrices of the estimation equations.
+ */
+enum ExternalWrenchesPseudoInverseMethod
+{
+    /**
+     * Truncated pseudo inverse computed with a Jacobi SVD.
+     * Singular values smaller than the tolerance used by the estimation are considered to be zero.
+     */
+    JACOBI_SVD_PSEUDOINVERSE,
+
+    /**
+     * Pseudo inverse computed with a complete orthogonal decomposition (rank-revealing QR).
+     * This is cheaper than the SVD, and the rank is determined using the estimation tolerance
+     * relatively to the biggest pivot of the decomposition.
+     */
+    COMPLETE_ORTHOGONAL_DECOMPOSITION_PSEUDOINVERSE
+};
+
 struct estimateExternalWrenchesBuffers
 {
     estimateExternalWrenchesBuffers();
@@ -244,6 +268,29 @@ struct estimateExternalWrenchesBuffers
     std::vector<Vector6> b;
     std::vector<MatrixDynSize> pinvA;
 
+    /**
+     * Method used to compute pinvA, by default JACOBI_SVD_PSEUDOINVERSE.
+     */
+    ExternalWrenchesPseudoInverseMethod pseudoInverseMethod;
+
+    /**
+     * The A matrix of a submodel only depends on the unknown contacts and on the
+     * joint positions of the submodel. For this reason pinvA is recomputed only
+     * if A is different from the matrix stored in decomposedA, i.e. the one used
+     * for the last computation of pinvA, or if pseudoInverseMethod changed.
+     * Clear these vectors to force the computation of pinvA at the next estimation.
+     */
+    std::vector<MatrixDynSize> decomposedA;
+    std::vector<ExternalWrenchesPseudoInverseMethod> decomposedAMethod;
+
+#ifndef SWIG
+    /**
+     * Solvers used to compute pinvA with COMPLETE_ORTHOGONAL_DECOMPOSITION_PSEUDOINVERSE,
+     * whose workspace is reused as long as the size of A does not change.
+     */
+    std::vector<PseudoInverseSolver> pseudoInverseSolvers;
+#endif
+
     /**
      * We compute the b term for each subtree
      * in a iterative way, so we need a buffer
@@ -305,6 +352,29 @@ bool estimateExternalWrenches(const Model& model,
                                     estimateExternalWrenchesBuffers & bufs,
                                     LinkContactWrenches & outputContactWrenches);
 
+/**
+ * \brief Estimate the external wrenches, solving the submodels in parallel.
+ *
+ * Once the kinematics is known, the estimation problems of the submodels are independent.
+ * This version of estimateExternalWrenches distributes them on the threads of the specified
+ * pool. The results are the same of the sequential version, as each submodel writes only
+ * the buffers and the contact wrenches of its own links.
+ *
+ * @param[in] threadPool the pool of threads used to estimate the submodels.
+ * @see estimateExternalWrenches for the documentation of the other parameters.
+ */
+bool estimateExternalWrenches(const Model& model,
+                              const SubModelDecomposition& subModels,
+                              const SensorsList& sensors,
+                              const LinkUnknownWrenchContacts & unknownWrenches,
+                              const JointPosDoubleArray & jointPos,
+                              const LinkVelArray & linkVel,
+                              const LinkAccArray & linkProperAcc,
+                              const SensorsMeasurements & ftSensorsMeasurements,
+                                    estimateExternalWrenchesBuffers & bufs,
+                                    LinkContactWrenches & outputContactWrenches,
+                                    ThreadPool & threadPool);
+
 /**
  * \brief Modified forward kinematics for torque/force estimation.
  *
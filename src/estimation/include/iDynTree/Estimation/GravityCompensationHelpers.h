@@ -17,6 +17,7 @@
 #include <iDynTree/Model/Dynamics.h>
 
 #include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/MatrixView.h>
 #include <iDynTree/Core/Utils.h>
 #include <iDynTree/Core/ClassicalAcc.h>
 
@@ -95,38 +96,50 @@ namespace iDynTree
      * @return true if successful, false otherwise
      */
     bool getGravityCompensationTorques(iDynTree::JointDOFsDoubleArray& jointTrqs);
-    
-  private:
+
     /**
-     * @brief Helper function for kinematic traversal dynamic allocation
-     * @param[in] nrOfLinks number of links to be allocated in the traversal
+     * @brief Get the gravity compensation torques for several joint configurations
+     * with the same gravity vector, for example to generate a lookup table.
+     *
+     * The kinematic information set with updateKinematicsFromGravity or
+     * updateKinematicsFromProperAcceleration is not modified.
+     *
+     * @param[in] jointPositions \f$ N \times n \f$ matrix, the i-th row contains the joint positions of the i-th configuration
+     * @param[in] floatingFrame the frame index for which gravity vector is provided
+     * @param[in] gravity gravity acceleration of the origin of the specified frame,
+     *                    expresssed in the specified frame orientation
+     * @param[out] jointTrqs \f$ N \times n \f$ matrix, the i-th row contains the gravity compensation
+     *                       torques of the i-th configuration
+     * @return true if successful, false otherwise
      */
-    void allocKinematicTraversals(const size_t nrOfLinks);
-    
+    bool getGravityCompensationTorquesBatch(iDynTree::MatrixView<const double> jointPositions,
+                                            const iDynTree::FrameIndex& floatingFrame,
+                                            const iDynTree::Vector3& gravity,
+                                            iDynTree::MatrixView<double> jointTrqs);
+
+  private:
     /**
-     * @brief Helper function for kinematic traversal dynamic deallocation
+     * @brief Check the floating frame and get the proper acceleration of its link
+     * @return true if successful, false otherwise
      */
-    void freeKinematicTraversals();
-    
+    bool getLinkProperAcceleration(const iDynTree::FrameIndex& floatingFrame,
+                                   const iDynTree::Vector3& properClassicalLinearAcceleration,
+                                   const char* methodName,
+                                   iDynTree::LinkIndex& floatingLinkIndex,
+                                   iDynTree::Vector3& linkProperAcceleration) const;
+
     bool m_isModelValid;          ///< flag to check validity of the model
     bool m_isKinematicsUpdated;   ///< flag to check if kinematics of the robot is updated
     iDynTree::Model m_model;      ///< robot model for gravity compensation estimation
     
     iDynTree::Traversal m_dynamicTraversal; ///< Traversal used for dynamic computations
-    
-    /**
-     * Vector of Traversal used for the kinematic computations.
-     * m_kinematicTraversals[l] contains the traversal with base link l .
-     */
-    std::vector<iDynTree::Traversal*> m_kinematicTraversals;
-    
+
     iDynTree::JointPosDoubleArray m_jointPos;                         ///< joint positions
-    iDynTree::JointDOFsDoubleArray m_jointDofsZero;                   ///< zero DOFArrays for joint velocities and joint accelerations
-    iDynTree::LinkVelArray m_linkVels;                                ///< link velocities
-    iDynTree::LinkAccArray m_linkProperAccs;                          ///< link proper accelerations
-    iDynTree::LinkNetExternalWrenches m_linkNetExternalWrenchesZero;  ///< link external wrenches set to zero
-    iDynTree::LinkInternalWrenches m_linkIntWrenches;                 ///< link internal wrenches
-    iDynTree::FreeFloatingGeneralizedTorques m_generalizedTorques;    ///< generalized torques 
+    iDynTree::LinkIndex m_floatingLinkIndex;                          ///< link for which the proper acceleration is known
+    iDynTree::Vector3 m_floatingLinkProperAcc;                        ///< proper acceleration of m_floatingLinkIndex, in link frame
+    iDynTree::GravityGeneralizedForcesInternalBuffers m_gravityForcesBuffers; ///< buffers of the gravity forces computation
+    iDynTree::FreeFloatingGeneralizedTorques m_generalizedTorques;    ///< generalized torques
+    iDynTree::JointPosDoubleArray m_batchJointPos;                    ///< joint positions used by getGravityCompensationTorquesBatch
   };
 }
 #endif
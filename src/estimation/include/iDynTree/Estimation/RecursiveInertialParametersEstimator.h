@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef IDYNTREE_RECURSIVE_INERTIAL_PARAMETERS_ESTIMATOR_H
+#define IDYNTREE_RECURSIVE_INERTIAL_PARAMETERS_ESTIMATOR_H
+
+#include <iDynTree/Core/MatrixView.h>
+#include <iDynTree/Core/Span.h>
+
+#include <string>
+
+namespace iDynTree
+{
+class Model;
+class VectorDynSize;
+class Twist;
+class SpatialAcc;
+class JointPosDoubleArray;
+class JointDOFsDoubleArray;
+class FreeFloatingGeneralizedTorques;
+
+/**
+ * \ingroup iDynTreeEstimation
+ *
+ * Online estimator of the inertial parameters of a model.
+ *
+ * The inverse dynamics of the model is linear in its inertial parameters \f$ \pi \f$ (10 for each link,
+ * ordered as in SpatialInertia::asVector()):
+ * \f[ \tau_k = Y_k \pi \f]
+ * where \f$ \tau_k \f$ are the base wrench and the joint torques of the k-th sample, and \f$ Y_k \f$
+ * is the regressor computed by InverseDynamicsInertialParametersRegressor().
+ *
+ * The estimator stores the information form of the weighted least squares problem with exponential forgetting:
+ * \f[ \Lambda_k = \lambda \Lambda_{k-1} + Y_k^T W Y_k, \quad \eta_k = \lambda \eta_{k-1} + Y_k^T W \tau_k \f]
+ * where \f$ \lambda \f$ is the forgetting factor and \f$ W \f$ the diagonal matrix of the measurement weights.
+ * The update exploits the block sparsity of the regressor: the row of a joint DOF only depends
+ * on the parameters of the links in the subtree of the joint, so only the corresponding blocks of
+ * \f$ \Lambda \f$ are updated. The per-sample cost is bounded and the update does not allocate memory.
+ *
+ * At a lower rate, computeEstimate() solves
+ * \f[ (\Lambda_k + \mu I) \hat{\pi} = \eta_k + \mu \pi_{prior} \f]
+ * where \f$ \mu \f$ is the prior weight, and projects the parameters of each link on the
+ * set of physically consistent parameters (positive mass and non-negative central second moments of mass).
+ *
+ * Usage:
+ * - call setModel(), the inertial parameters of the model are used as prior,
+ * - for each sample, call update() (or updateWithRegressor() if the regressor is computed elsewhere),
+ * - when a new estimate is needed, call computeEstimate() and getEstimatedInertialParameters().
+ *
+ * \warning This class is still in active development, and so API interface can change between iDynTree versions.
+ */
+class RecursiveInertialParametersEstimator
+{
+    class RecursiveInertialParametersEstimatorPimpl;
+    RecursiveInertialParametersEstimatorPimpl* m_pimpl;
+
+    // Disable copy
+    RecursiveInertialParametersEstimator(const RecursiveInertialParametersEstimator& other) = delete;
+    RecursiveInertialParametersEstimator& operator=(const RecursiveInertialParametersEstimator& other) = delete;
+
+public:
+    RecursiveInertialParametersEstimator();
+    ~RecursiveInertialParametersEstimator();
+
+    /**
+     * Set the model whose inertial parameters are estimated, and reset the estimator.
+     *
+     * The inertial parameters of the model are used as prior, and as estimate until computeEstimate() is called.
+     *
+     * @param[in] model the model.
+     * @param[in] baseLink name of the link w.r.t. which the base wrench is expressed,
+     *                     if empty the default base of the model is used.
+     * @return true if all went well, false otherwise.
+     */
+    bool setModel(const Model& model, const std::string& baseLink = "");
+
+    /**
+     * Check if a valid model has been set.
+     */
+    bool isValid() const;
+
+    /**
+     * Get the number of estimated inertial parameters, i.e. 10 times the number of links.
+     */
+    size_t getNrOfInertialParameters() const;
+
+    /**
+     * Get the number of measured generalized forces, i.e. 6 plus the number of DOFs.
+     */
+    size_t getNrOfMeasurements() const;
+
+    /**
+     * Set the forgetting factor \f$ \lambda \f$, in (0, 1]. The default is 1 (no forgetting).
+     *
+     * The information of a sample is halved after \f$ \log(0.5)/\log(\lambda) \f$ samples.
+     */
+    bool setForgettingFactor(const double forgettingFactor);
+
+    /**
+     * Get the forgetting factor.
+     */
+    double getForgettingFactor() const;
+
+    /**
+     * Set the weight \f$ \mu \f$ of the prior, it must be non-negative. The default is 1e-3.
+     */
+    bool setPriorWeight(const double priorWeight);
+
+    /**
+     * Set the prior inertial parameters \f$ \pi_{prior} \f$, of size getNrOfInertialParameters().
+     */
+    bool setPriorInertialParameters(const VectorDynSize& priorParameters);
+
+    /**
+     * Set the weights of the measured generalized forces, of size getNrOfMeasurements().
+     *
+     * The weights must be non-negative, and the measurements with zero weight are ignored
+     * (for example the base wrench, if it is not measured). By default all the weights are 1.
+     */
+    bool setMeasurementsWeights(const VectorDynSize& weights);
+
+    /**
+     * Set the minimum mass of a link used in the physical-consistency projection. The default is 1e-3 kg.
+     */
+    bool setMinimumLinkMass(const double minimumLinkMass);
+
+    /**
+     * Remove the information of all the processed samples, and set the estimate to the prior.
+     */
+    void reset();
+
+    /**
+     * Process a sample of the robot state and of the measured generalized forces.
+     *
+     * @param[in] jointPos the joint positions.
+     * @param[in] baseVel the velocity of the base link, expressed in the base frame (left-trivialized).
+     * @param[in] jointVel the joint velocities.
+     * @param[in] baseProperAcc the proper acceleration (i.e. acceleration minus gravity) of the base link,
+     *                          expressed in the base frame (left-trivialized).
+     * @param[in] jointAcc the joint accelerations.
+     * @param[in] measuredGeneralizedForces the measured base wrench (expressed in the base frame) and joint torques.
+     * @return true if all went well, false otherwise.
+     */
+    bool update(const JointPosDoubleArray& jointPos,
+                const Twist& baseVel,
+                const JointDOFsDoubleArray& jointVel,
+                const SpatialAcc& baseProperAcc,
+                const JointDOFsDoubleArray& jointAcc,
+                const FreeFloatingGeneralizedTorques& measuredGeneralizedForces);
+
+    /**
+     * Process a sample given its regressor.
+     *
+     * @param[in] regressor \f$ (6+n) \times 10 l \f$ regressor, it must have the same sparsity pattern of the
+     *                      one computed by InverseDynamicsInertialParametersRegressor() with the model and base link
+     *                      passed to setModel(). The elements outside the pattern are ignored.
+     * @param[in] measuredGeneralizedForces the measured base wrench (linear part first) and joint torques.
+     * @return true if all went well, false otherwise.
+     */
+    bool updateWithRegressor(MatrixView<const double> regressor,
+                             Span<const double> measuredGeneralizedForces);
+
+    /**
+     * Get the number of samples processed since the last reset.
+     */
+    size_t getNrOfProcessedSamples() const;
+
+    /**
+     * Compute the estimate of the inertial parameters from the information of the processed samples.
+     *
+     * This method factorizes a dense matrix of the size of the inertial parameters,
+     * so it is meant to be called at a lower rate than update().
+     *
+     * @return true if all went well, false otherwise.
+     */
+    bool computeEstimate();
+
+    /**
+     * Get the physically consistent estimate computed by the last call to computeEstimate().
+     */
+    const VectorDynSize& getEstimatedInertialParameters() const;
+
+    /**
+     * Get the estimate computed by the last call to computeEstimate(), before the physical-consistency projection.
+     */
+    const VectorDynSize& getUnconstrainedInertialParameters() const;
+};
+
+}
+
+#endif
@@ -98,6 +98,38 @@ class SimpleLeggedOdometry
      */
     Transform m_world_H_fixedLink;
 
+    /**
+     * If true, updateKinematics only computes the links on the path
+     * between the base of the traversal and the fixed link.
+     */
+    bool m_usePartialForwardKinematics;
+
+    /**
+     * Joint positions passed to the last call to updateKinematics.
+     */
+    JointPosDoubleArray m_jointPos;
+
+    /**
+     * Links on the path between the base of the traversal (excluded)
+     * and the fixed link (included), ordered from the base to the fixed link.
+     * This is updated every time the fixed link changes.
+     */
+    std::vector<LinkIndex> m_fixedLinkPath;
+
+    /**
+     * For each link, non-zero if the corresponding element of m_base_H_link
+     * has been computed for the joint positions of the last updateKinematics.
+     */
+    std::vector<char> m_isLinkPoseUpdated;
+
+    /**
+     * Buffer used to compute on request the links that are not on m_fixedLinkPath.
+     */
+    std::vector<LinkIndex> m_linkPathBuffer;
+
+    void updateFixedLinkPath();
+    const Transform& getBase_H_link(const LinkIndex link);
+
 public:
     /**
      * Constructor
@@ -133,6 +165,26 @@ public:
      */
     bool updateKinematics(JointPosDoubleArray & jointPos);
 
+    /**
+     * Enable or disable the partial forward kinematics (default: disabled).
+     *
+     * If disabled, updateKinematics computes the forward kinematics of all the links of the model.
+     * If enabled, updateKinematics only evaluates the joint transforms on the path between
+     * the base of the model and the link currently considered fixed, that is precomputed
+     * every time the fixed link is changed. The pose of any other link is computed the
+     * first time it is requested after updateKinematics, reusing the poses already computed
+     * in the same tick, so querying many frames (for example several candidate contact frames)
+     * only evaluates the joints on their paths once.
+     *
+     * The results are the same in both modes.
+     */
+    void setUsePartialForwardKinematics(const bool usePartialForwardKinematics);
+
+    /**
+     * Return true if the partial forward kinematics is enabled, false otherwise.
+     */
+    bool usePartialForwardKinematics() const;
+
     /**
      * Initialize the odometry.
      * This method initializes the world location w.r.t. to a frame
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef IDYNTREE_SKIN_TAXEL_PATCHES_H
+#define IDYNTREE_SKIN_TAXEL_PATCHES_H
+
+#include <iDynTree/Core/MatrixView.h>
+#include <iDynTree/Core/Span.h>
+
+#include <iDynTree/Model/Indices.h>
+#include <iDynTree/Model/LinkState.h>
+#include <iDynTree/Model/Model.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace iDynTree
+{
+class LinkUnknownWrenchContacts;
+
+/**
+ * \ingroup iDynTreeEstimation
+ *
+ * Compact representation of the taxels of a tactile skin.
+ *
+ * The taxels are grouped in patches, each one rigidly attached to a link of the model.
+ * Instead of representing each patch as a separate sensor, all the taxels of all the patches
+ * are stored in a single buffer: for each patch, the taxel normals, the moments of the normals
+ * around the link origin and the taxel positions are stored as contiguous planes,
+ * all expressed in the link frame.
+ *
+ * The measurements of a tick are passed as a single buffer with one element for each taxel,
+ * containing the magnitude of the force (in Newton) pressing the taxel. The patches are stored
+ * one after the other in the order in which they were added, and the taxels of each patch
+ * are stored in the order of the rows passed to addPatch(). The force applied by the environment
+ * on the link through the i-th taxel is \f$ -f_i n_i \f$, where \f$ f_i \f$ is the measured force
+ * and \f$ n_i \f$ is the outward normal of the taxel.
+ *
+ * Usage:
+ * - call init() with the model,
+ * - call addPatch() for each patch of the skin,
+ * - for each tick, call computeLinkNetExternalWrenches() or computeUnknownWrenchContacts()
+ *   with the taxel measurements.
+ */
+class SkinTaxelPatches
+{
+public:
+    SkinTaxelPatches();
+
+    /**
+     * Set the model to which the patches are attached, removing all the existing patches.
+     *
+     * @return true if all went well, false otherwise.
+     */
+    bool init(const Model& model);
+
+    /**
+     * Add a patch of taxels rigidly attached to a frame of the model.
+     *
+     * @param[in] frameName name of the frame in which positions and normals are expressed.
+     * @param[in] taxelPositions \f$ N \times 3 \f$ matrix, the i-th row is the position of the i-th taxel.
+     * @param[in] taxelNormals \f$ N \times 3 \f$ matrix, the i-th row is the outward normal of the i-th taxel,
+     *                         it is normalized internally.
+     * @param[in] contactId unique id of the patch, propagated to the UnknownWrenchContact of the patch.
+     * @return true if all went well, false otherwise.
+     */
+    bool addPatch(const std::string& frameName,
+                  MatrixView<const double> taxelPositions,
+                  MatrixView<const double> taxelNormals,
+                  const unsigned long contactId);
+
+    /**
+     * Get the number of patches.
+     */
+    size_t getNrOfPatches() const;
+
+    /**
+     * Get the total number of taxels, i.e. the size of the taxel measurements buffer.
+     */
+    size_t getNrOfTaxels() const;
+
+    /**
+     * Get the number of taxels of a patch.
+     */
+    size_t getNrOfTaxelsOfPatch(const size_t patchIndex) const;
+
+    /**
+     * Get the index in the taxel measurements buffer of the first taxel of a patch.
+     */
+    size_t getTaxelsOffsetOfPatch(const size_t patchIndex) const;
+
+    /**
+     * Get the index of the link to which a patch is attached.
+     */
+    LinkIndex getLinkOfPatch(const size_t patchIndex) const;
+
+    /**
+     * Get the contact id of a patch.
+     */
+    unsigned long getContactIdOfPatch(const size_t patchIndex) const;
+
+    /**
+     * Get the index of the patch with a given contact id.
+     *
+     * @return true if the patch was found, false otherwise.
+     */
+    bool getPatchIndex(const unsigned long contactId, size_t& patchIndex) const;
+
+    /**
+     * Compute the wrench applied on each patch.
+     *
+     * @param[in] taxelForces force measured by each taxel, of size getNrOfTaxels().
+     * @param[out] patchesWrenches \f$ P \times 6 \f$ matrix, the i-th row is the wrench (linear part first)
+     *                             applied on the i-th patch, with the orientation of the link frame
+     *                             and w.r.t. the link origin.
+     * @return true if all went well, false otherwise.
+     */
+    bool computePatchesWrenches(Span<const double> taxelForces,
+                                MatrixView<double> patchesWrenches) const;
+
+    /**
+     * Compute the net external wrench applied by the skin on each link.
+     *
+     * The wrenches of the links without patches are set to zero.
+     *
+     * @param[in] taxelForces force measured by each taxel, of size getNrOfTaxels().
+     * @param[out] netWrenches net external wrenches, resized to the number of links of the model if necessary.
+     * @return true if all went well, false otherwise.
+     */
+    bool computeLinkNetExternalWrenches(Span<const double> taxelForces,
+                                        LinkNetExternalWrenches& netWrenches) const;
+
+    /**
+     * Add an unknown contact for each patch in contact.
+     *
+     * A patch is in contact if at least one of its taxels measures a force above activationThreshold.
+     * The contact point is the center of pressure of the active taxels, and the force direction
+     * is the opposite of the force-weighted mean of their normals. If the normals cancel out, the contact is
+     * added as PURE_FORCE, otherwise as PURE_FORCE_WITH_KNOWN_DIRECTION.
+     *
+     * The contacts are appended to the existing ones.
+     *
+     * @param[in] taxelForces force measured by each taxel, of size getNrOfTaxels().
+     * @param[in] activationThreshold minimum force of an active taxel.
+     * @param[out] unknowns unknown contacts, it must be sized for the model passed to init().
+     * @return true if all went well, false otherwise.
+     */
+    bool computeUnknownWrenchContacts(Span<const double> taxelForces,
+                                      const double activationThreshold,
+                                      LinkUnknownWrenchContacts& unknowns);
+
+private:
+    bool checkTaxelForcesSize(Span<const double> taxelForces, const char* methodName) const;
+    bool isValidPatch(const size_t patchIndex, const char* methodName) const;
+
+    iDynTree::Model m_model;
+
+    // Patches data
+    std::vector<LinkIndex> m_patchLinks;
+    std::vector<unsigned long> m_patchContactIds;
+    std::vector<size_t> m_patchOffsets; ///< offset of the first taxel, one more element than the patches
+    std::unordered_map<unsigned long, size_t> m_contactIdToPatch;
+
+    /**
+     * For each patch, 9 planes of size equal to the number of taxels of the patch:
+     * normals, moments of the normals around the link origin and positions, all in link frame.
+     * The planes of a patch start at 9 times the offset of its first taxel.
+     */
+    std::vector<double> m_taxelPlanes;
+
+    std::vector<double> m_activeForces; ///< workspace for computeUnknownWrenchContacts
+};
+
+}
+
+#endif
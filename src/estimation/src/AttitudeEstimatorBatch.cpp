@@ -0,0 +1,467 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/AttitudeEstimatorBatch.h>
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Utils.h>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <sstream>
+
+namespace iDynTree
+{
+
+namespace
+{
+    // Each row of a planes array contains one element of a vector for all the IMUs
+    typedef Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> PlanesArray;
+    typedef Eigen::Map<PlanesArray> PlanesMap;
+    // Measurements are passed with the 3 elements of each IMU stored contiguously
+    typedef Eigen::Map<const Eigen::Array<double, 3, Eigen::Dynamic> > InterleavedMeasurementsMap;
+
+    const size_t nrOfWorkspacePlanes = 13;
+
+    /**
+     * Copy the measurements in meas planes and normalize them,
+     * fails if any of the measurements has zero norm or is not a number.
+     */
+    bool getUnitVectorPlanes(Span<const double> measBuffer,
+                             Eigen::Ref<PlanesArray> meas,
+                             Eigen::Ref<PlanesArray> norm,
+                             const char* measurementType)
+    {
+        InterleavedMeasurementsMap interleavedMeas(measBuffer.data(), 3, meas.cols());
+        meas = interleavedMeas;
+        norm = (meas.row(0).square() + meas.row(1).square() + meas.row(2).square()).sqrt();
+
+        if (!(norm > 0.0).all())
+        {
+            Eigen::Index imu = 0;
+            while (norm(0, imu) > 0.0)
+            {
+                imu++;
+            }
+            std::stringstream ss;
+            ss << "the " << measurementType << " measurement of IMU " << imu << " is zero or not a number.";
+            reportError("AttitudeEstimatorBatch", "updateFilterWithMeasurements", ss.str().c_str());
+            return false;
+        }
+
+        for (int i = 0; i < 3; i++)
+        {
+            meas.row(i) /= norm;
+        }
+
+        return true;
+    }
+
+    /**
+     * Add to omega_mes the Mahony vectorial correction \f$ -(\frac{k}{2} (v \hat{v}^T - \hat{v} v^T) )^{\vee} = \frac{k}{2} v \times \hat{v} \f$
+     * where \f$ \hat{v} = {^A}R_B^T d \f$ is the direction d expressed in the body frame.
+     */
+    void addVectorialCorrection(const Eigen::Ref<const PlanesArray>& q,
+                                const Eigen::Ref<const PlanesArray>& unitMeas,
+                                const iDynTree::Direction& d,
+                                const double confidence,
+                                Eigen::Ref<PlanesArray> vHat,
+                                Eigen::Ref<PlanesArray> omega_mes)
+    {
+        auto w = q.row(0);
+        auto x = q.row(1);
+        auto y = q.row(2);
+        auto z = q.row(3);
+
+        vHat.row(0) = (1.0 - 2.0*(y*y + z*z))*d(0) + 2.0*(x*y + w*z)*d(1) + 2.0*(x*z - w*y)*d(2);
+        vHat.row(1) = 2.0*(x*y - w*z)*d(0) + (1.0 - 2.0*(x*x + z*z))*d(1) + 2.0*(y*z + w*x)*d(2);
+        vHat.row(2) = 2.0*(x*z + w*y)*d(0) + 2.0*(y*z - w*x)*d(1) + (1.0 - 2.0*(x*x + y*y))*d(2);
+
+        const double k = 0.5*confidence;
+        omega_mes.row(0) += k*(unitMeas.row(1)*vHat.row(2) - unitMeas.row(2)*vHat.row(1));
+        omega_mes.row(1) += k*(unitMeas.row(2)*vHat.row(0) - unitMeas.row(0)*vHat.row(2));
+        omega_mes.row(2) += k*(unitMeas.row(0)*vHat.row(1) - unitMeas.row(1)*vHat.row(0));
+    }
+}
+
+AttitudeEstimatorBatch::AttitudeEstimatorBatch(): m_nrOfIMUs(0),
+                                                  m_filterType(ATTITUDE_BATCH_MAHONY_FILTER)
+{
+    // same defaults of AttitudeMahonyFilter
+    m_params_mahony.time_step_in_seconds = 0.01;
+    m_params_mahony.kp = 1.0;
+    m_params_mahony.ki = 0.0;
+    m_params_mahony.use_magnetometer_measurements = false;
+    m_params_mahony.confidence_magnetometer_measurements = 0.0;
+
+    m_gravity_direction.zero();
+    m_gravity_direction(2) = 1.0;
+
+    m_earth_magnetic_field_direction.zero();
+    m_earth_magnetic_field_direction(2) = 1.0;
+}
+
+bool AttitudeEstimatorBatch::init(const size_t nrOfIMUs, const AttitudeEstimatorBatchFilterType filterType)
+{
+    m_nrOfIMUs = nrOfIMUs;
+    m_filterType = filterType;
+
+    m_orientations.assign(4*m_nrOfIMUs, 0.0);
+    std::fill(m_orientations.begin(), m_orientations.begin() + m_nrOfIMUs, 1.0);
+    m_angular_velocities.assign(3*m_nrOfIMUs, 0.0);
+    m_gyroscope_biases.assign(3*m_nrOfIMUs, 0.0);
+    m_omega_mes.assign(3*m_nrOfIMUs, 0.0);
+    m_Omega_y.assign(3*m_nrOfIMUs, 0.0);
+    m_workspace.assign(nrOfWorkspacePlanes*m_nrOfIMUs, 0.0);
+
+    m_qekfs.clear();
+    if (m_filterType == ATTITUDE_BATCH_QUATERNION_EKF)
+    {
+        m_qekfs.resize(m_nrOfIMUs);
+
+        iDynTree::UnitQuaternion identity;
+        identity.zero();
+        identity(0) = 1.0;
+        iDynTree::Span<double> identitySpan(identity.data(), identity.size());
+
+        bool ok = true;
+        for (auto& qekf : m_qekfs)
+        {
+            qekf.setParameters(m_params_qekf);
+            qekf.setGravityDirection(m_gravity_direction);
+            ok = qekf.initializeFilter() && ok;
+            ok = qekf.setInternalStateInitialOrientation(identitySpan) && ok;
+        }
+
+        if (!ok)
+        {
+            reportError("AttitudeEstimatorBatch", "init", "Error in initializing the quaternion EKFs.");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t AttitudeEstimatorBatch::getNrOfIMUs() const
+{
+    return m_nrOfIMUs;
+}
+
+AttitudeEstimatorBatchFilterType AttitudeEstimatorBatch::getFilterType() const
+{
+    return m_filterType;
+}
+
+void AttitudeEstimatorBatch::setMahonyFilterParameters(const AttitudeMahonyFilterParameters& params)
+{
+    m_params_mahony = params;
+}
+
+bool AttitudeEstimatorBatch::setQuaternionEKFParameters(const AttitudeQuaternionEKFParameters& params)
+{
+    m_params_qekf = params;
+
+    bool ok = true;
+    for (auto& qekf : m_qekfs)
+    {
+        qekf.setParameters(m_params_qekf);
+        ok = qekf.initializeFilter() && ok;
+    }
+
+    if (!ok)
+    {
+        reportError("AttitudeEstimatorBatch", "setQuaternionEKFParameters", "Error in initializing the quaternion EKFs.");
+    }
+
+    return ok;
+}
+
+void AttitudeEstimatorBatch::setGravityDirection(const iDynTree::Direction& gravity_dir)
+{
+    m_gravity_direction = gravity_dir;
+    for (auto& qekf : m_qekfs)
+    {
+        qekf.setGravityDirection(m_gravity_direction);
+    }
+}
+
+bool AttitudeEstimatorBatch::setInternalStateInitialOrientations(MatrixView<const double> orientations)
+{
+    if (orientations.rows() != static_cast<std::ptrdiff_t>(m_nrOfIMUs) || orientations.cols() != 4)
+    {
+        std::stringstream ss;
+        ss << "Expected a " << m_nrOfIMUs << "x4 matrix of orientations, got a "
+           << orientations.rows() << "x" << orientations.cols() << " matrix.";
+        reportError("AttitudeEstimatorBatch", "setInternalStateInitialOrientations", ss.str().c_str());
+        return false;
+    }
+
+    for (size_t imu = 0; imu < m_nrOfIMUs; imu++)
+    {
+        for (size_t i = 0; i < 4; i++)
+        {
+            m_orientations[i*m_nrOfIMUs + imu] = orientations(imu, i);
+        }
+    }
+
+    for (size_t imu = 0; imu < m_qekfs.size(); imu++)
+    {
+        iDynTree::UnitQuaternion q;
+        for (size_t i = 0; i < 4; i++)
+        {
+            q(i) = orientations(imu, i);
+        }
+        iDynTree::Span<double> qSpan(q.data(), q.size());
+        m_qekfs[imu].setInternalStateInitialOrientation(qSpan);
+    }
+
+    return true;
+}
+
+bool AttitudeEstimatorBatch::checkMeasurementsSize(Span<const double> meas,
+                                                   const char* measurementType,
+                                                   const char* methodName) const
+{
+    if (meas.size() != static_cast<Span<const double>::index_type>(3*m_nrOfIMUs))
+    {
+        std::stringstream ss;
+        ss << "Expected " << 3*m_nrOfIMUs << " " << measurementType << " measurements, got " << meas.size() << ".";
+        reportError("AttitudeEstimatorBatch", methodName, ss.str().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool AttitudeEstimatorBatch::updateFilterWithMeasurements(Span<const double> linAccMeas,
+                                                          Span<const double> gyroMeas)
+{
+    if (!checkMeasurementsSize(linAccMeas, "linear acceleration", "updateFilterWithMeasurements") ||
+        !checkMeasurementsSize(gyroMeas, "gyroscope", "updateFilterWithMeasurements"))
+    {
+        return false;
+    }
+
+    if (m_filterType == ATTITUDE_BATCH_MAHONY_FILTER)
+    {
+        return updateMahonyFilters(linAccMeas, gyroMeas, Span<const double>());
+    }
+
+    return updateQuaternionEKFs(linAccMeas, gyroMeas, Span<const double>());
+}
+
+bool AttitudeEstimatorBatch::updateFilterWithMeasurements(Span<const double> linAccMeas,
+                                                          Span<const double> gyroMeas,
+                                                          Span<const double> magMeas)
+{
+    if (!checkMeasurementsSize(linAccMeas, "linear acceleration", "updateFilterWithMeasurements") ||
+        !checkMeasurementsSize(gyroMeas, "gyroscope", "updateFilterWithMeasurements") ||
+        !checkMeasurementsSize(magMeas, "magnetometer", "updateFilterWithMeasurements"))
+    {
+        return false;
+    }
+
+    if (m_filterType == ATTITUDE_BATCH_MAHONY_FILTER)
+    {
+        return updateMahonyFilters(linAccMeas, gyroMeas, magMeas);
+    }
+
+    return updateQuaternionEKFs(linAccMeas, gyroMeas, magMeas);
+}
+
+bool AttitudeEstimatorBatch::updateMahonyFilters(Span<const double> linAccMeas,
+                                                 Span<const double> gyroMeas,
+                                                 Span<const double> magMeas)
+{
+    const Eigen::Index n = static_cast<Eigen::Index>(m_nrOfIMUs);
+    const bool useMagnetometer = m_params_mahony.use_magnetometer_measurements && magMeas.size() > 0;
+
+    InterleavedMeasurementsMap gyro(gyroMeas.data(), 3, n);
+    if (gyro.hasNaN())
+    {
+        reportError("AttitudeEstimatorBatch", "updateFilterWithMeasurements", "gyroscope measurements contain NaN values.");
+        return false;
+    }
+
+    PlanesMap q(m_orientations.data(), 4, n);
+    PlanesMap workspace(m_workspace.data(), nrOfWorkspacePlanes, n);
+    auto accUnit = workspace.middleRows(0, 3);
+    auto magUnit = workspace.middleRows(3, 3);
+    auto vHat = workspace.middleRows(6, 3);
+    auto omega_mes = workspace.middleRows(9, 3);
+    auto norm = workspace.middleRows(12, 1);
+
+    if (!getUnitVectorPlanes(linAccMeas, accUnit, norm, "linear acceleration"))
+    {
+        return false;
+    }
+
+    if (useMagnetometer && !getUnitVectorPlanes(magMeas, magUnit, norm, "magnetometer"))
+    {
+        return false;
+    }
+
+    omega_mes.setZero();
+    addVectorialCorrection(q, accUnit, m_gravity_direction,
+                           1 - m_params_mahony.confidence_magnetometer_measurements,
+                           vHat, omega_mes);
+    if (useMagnetometer)
+    {
+        addVectorialCorrection(q, magUnit, m_earth_magnetic_field_direction,
+                               m_params_mahony.confidence_magnetometer_measurements,
+                               vHat, omega_mes);
+    }
+
+    PlanesMap(m_omega_mes.data(), 3, n) = omega_mes;
+    PlanesMap(m_Omega_y.data(), 3, n) = gyro;
+
+    return true;
+}
+
+bool AttitudeEstimatorBatch::updateQuaternionEKFs(Span<const double> linAccMeas,
+                                                  Span<const double> gyroMeas,
+                                                  Span<const double> magMeas)
+{
+    bool ok = true;
+    for (size_t imu = 0; imu < m_nrOfIMUs && ok; imu++)
+    {
+        iDynTree::LinearAccelerometerMeasurements linAcc(linAccMeas.data() + 3*imu, 3);
+        iDynTree::GyroscopeMeasurements gyro(gyroMeas.data() + 3*imu, 3);
+
+        // qualified calls to skip the virtual dispatch
+        if (magMeas.size() > 0)
+        {
+            iDynTree::MagnetometerMeasurements mag(magMeas.data() + 3*imu, 3);
+            ok = m_qekfs[imu].AttitudeQuaternionEKF::updateFilterWithMeasurements(linAcc, gyro, mag);
+        }
+        else
+        {
+            ok = m_qekfs[imu].AttitudeQuaternionEKF::updateFilterWithMeasurements(linAcc, gyro);
+        }
+
+        if (!ok)
+        {
+            std::stringstream ss;
+            ss << "Error in updating the quaternion EKF of IMU " << imu << ".";
+            reportError("AttitudeEstimatorBatch", "updateFilterWithMeasurements", ss.str().c_str());
+        }
+    }
+
+    copyQuaternionEKFOrientations();
+    return ok;
+}
+
+bool AttitudeEstimatorBatch::propagateStates()
+{
+    if (m_filterType == ATTITUDE_BATCH_QUATERNION_EKF)
+    {
+        bool ok = true;
+        for (size_t imu = 0; imu < m_nrOfIMUs && ok; imu++)
+        {
+            ok = m_qekfs[imu].AttitudeQuaternionEKF::propagateStates();
+            if (!ok)
+            {
+                std::stringstream ss;
+                ss << "Error in propagating the states of the quaternion EKF of IMU " << imu << ".";
+                reportError("AttitudeEstimatorBatch", "propagateStates", ss.str().c_str());
+            }
+        }
+
+        copyQuaternionEKFOrientations();
+        return ok;
+    }
+
+    const Eigen::Index n = static_cast<Eigen::Index>(m_nrOfIMUs);
+    const double dt = m_params_mahony.time_step_in_seconds;
+
+    PlanesMap q(m_orientations.data(), 4, n);
+    PlanesMap Omega(m_angular_velocities.data(), 3, n);
+    PlanesMap b(m_gyroscope_biases.data(), 3, n);
+    PlanesMap Omega_y(m_Omega_y.data(), 3, n);
+    PlanesMap omega_mes(m_omega_mes.data(), 3, n);
+
+    PlanesMap workspace(m_workspace.data(), nrOfWorkspacePlanes, n);
+    auto gyroUpdate = workspace.middleRows(0, 3);
+    auto correction = workspace.middleRows(3, 4);
+    auto qNext = workspace.middleRows(7, 4);
+    auto angle = workspace.middleRows(11, 1);
+    auto norm = workspace.middleRows(12, 1);
+
+    // compute the correction from the measurements, as the exponential of gyroUpdate
+    gyroUpdate = (Omega_y - b + omega_mes*m_params_mahony.kp)*(dt*0.5);
+    angle = (gyroUpdate.row(0).square() + gyroUpdate.row(1).square() + gyroUpdate.row(2).square()).sqrt();
+    correction.row(0) = (angle*0.5).cos();
+    norm = (angle > 0.0).select((angle*0.5).sin()/angle, 0.0);
+    for (int i = 0; i < 3; i++)
+    {
+        correction.row(i+1) = gyroUpdate.row(i)*norm;
+    }
+
+    // system dynamics equations, qNext = q \circ correction
+    qNext.row(0) = q.row(0)*correction.row(0) - q.row(1)*correction.row(1) - q.row(2)*correction.row(2) - q.row(3)*correction.row(3);
+    qNext.row(1) = q.row(1)*correction.row(0) + q.row(0)*correction.row(1) - q.row(3)*correction.row(2) + q.row(2)*correction.row(3);
+    qNext.row(2) = q.row(2)*correction.row(0) + q.row(3)*correction.row(1) + q.row(0)*correction.row(2) - q.row(1)*correction.row(3);
+    qNext.row(3) = q.row(3)*correction.row(0) - q.row(2)*correction.row(1) + q.row(1)*correction.row(2) + q.row(0)*correction.row(3);
+
+    norm = (qNext.row(0).square() + qNext.row(1).square() + qNext.row(2).square() + qNext.row(3).square()).sqrt();
+    if (!(norm > 0.0).all())
+    {
+        reportError("AttitudeEstimatorBatch", "propagateStates", "invalid quaternion with zero norm");
+        return false;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        q.row(i) = qNext.row(i)/norm;
+    }
+
+    Omega = Omega_y - b;
+    b -= omega_mes*(m_params_mahony.ki*dt);
+
+    return true;
+}
+
+void AttitudeEstimatorBatch::copyQuaternionEKFOrientations()
+{
+    iDynTree::UnitQuaternion q;
+    for (size_t imu = 0; imu < m_nrOfIMUs; imu++)
+    {
+        m_qekfs[imu].AttitudeQuaternionEKF::getOrientationEstimateAsQuaternion(q);
+        for (size_t i = 0; i < 4; i++)
+        {
+            m_orientations[i*m_nrOfIMUs + imu] = q(i);
+        }
+    }
+}
+
+MatrixView<const double> AttitudeEstimatorBatch::getOrientationEstimatesAsQuaternions() const
+{
+    // the 4xN row major planes are seen as a Nx4 column major matrix
+    return MatrixView<const double>(m_orientations.data(), m_nrOfIMUs, 4, MatrixStorageOrdering::ColumnMajor);
+}
+
+bool AttitudeEstimatorBatch::getOrientationEstimateAsQuaternion(const size_t imuIndex, iDynTree::UnitQuaternion& q) const
+{
+    if (imuIndex >= m_nrOfIMUs)
+    {
+        reportError("AttitudeEstimatorBatch", "getOrientationEstimateAsQuaternion", "IMU index out of range.");
+        return false;
+    }
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        q(i) = m_orientations[i*m_nrOfIMUs + imuIndex];
+    }
+
+    return true;
+}
+
+}
@@ -19,11 +19,6 @@ void iDynTree::AttitudeQuaternionEKF::serializeStateVector()
     auto Omega(toEigen(m_state_qekf.m_angular_velocity));
     auto b(toEigen(m_state_qekf.m_gyroscope_bias));
 
-    if (m_x.size() != m_state_size)
-    {
-        m_x.resize(m_state_size);
-    }
-
     x.block<4, 1>(0, 0) = q;
     x.block<3, 1>(4, 0) = Omega;
     x.block<3, 1>(7, 0) = b;
@@ -42,53 +37,38 @@ void iDynTree::AttitudeQuaternionEKF::deserializeStateVector()
     b = x.block<3, 1>(7, 0);
 }
 
-void iDynTree::AttitudeQuaternionEKF::prepareSystemNoiseCovarianceMatrix(iDynTree::MatrixDynSize &Q)
+void iDynTree::AttitudeQuaternionEKF::prepareSystemNoiseCovarianceMatrix(StateMatrix &Q)
 {
     using iDynTree::toEigen;
 
-    if (Q.rows() != m_state_size && Q.cols() != m_state_size)
-    {
-        Q.resize(m_state_size, m_state_size);
-    }
-
-
-    iDynTree::MatrixDynSize Fu_dyn(m_state_size, m_input_size + m_state_qekf.m_gyroscope_bias.size());
-    Fu_dyn.zero();
-    iDynTree::Matrix6x6 U_dyn;
-    U_dyn.zero();
-
-    auto F_u(toEigen(Fu_dyn));
-    auto U(toEigen(U_dyn));
     auto Id3(toEigen(m_Id3));
     auto Q_(toEigen(Q));
 
-    F_u.block<3, 3>(4, 0) = Id3;
-    F_u.block<3,3>(7, 3) = Id3;
-
-    U.block<3, 3>(0, 0) = Id3*m_params_qekf.gyroscope_noise_variance;
-    U.block<3, 3>(3, 3) = Id3*m_params_qekf.gyro_bias_noise_variance;
-
-    Q_ = F_u*U*F_u.transpose();
+    // Q = F_u*U*F_u^T, with F_u selecting the angular velocity and the gyro bias blocks
+    Q_.setZero();
+    Q_.block<3, 3>(4, 4) = Id3*m_params_qekf.gyroscope_noise_variance;
+    Q_.block<3, 3>(7, 7) = Id3*m_params_qekf.gyro_bias_noise_variance;
 }
 
-void iDynTree::AttitudeQuaternionEKF::prepareMeasurementNoiseCovarianceMatrix(iDynTree::MatrixDynSize& R)
+void iDynTree::AttitudeQuaternionEKF::prepareMeasurementNoiseCovarianceMatrix(OutputMatrix& R)
 {
     using iDynTree::toEigen;
 
-    if (R.rows() != m_output_size && R.cols() != m_output_size)
-    {
-        R.resize(m_output_size, m_output_size);
-        R.zero();
-    }
-
     auto R_(toEigen(R));
     auto Id3(toEigen(m_Id3));
 
+    R_.setZero();
     R_.block<3, 3>(0, 0) = Id3*m_params_qekf.accelerometer_noise_variance;
     if (m_params_qekf.use_magnetometer_measurements)
     {
         R_(3, 3) = m_params_qekf.magnetometer_noise_variance;
     }
+    else
+    {
+        // dummy measurement, see ekf_h: any positive variance keeps the innovation covariance
+        // positive definite without affecting the update, as the dummy row of H is zero
+        R_(3, 3) = 1.0;
+    }
 }
 
 iDynTree::AttitudeQuaternionEKF::AttitudeQuaternionEKF()
@@ -104,6 +84,8 @@ iDynTree::AttitudeQuaternionEKF::AttitudeQuaternionEKF()
 
     m_Omega_y.zero();
     m_Acc_y.zero();
+    m_Mag_y = 0.0;
+    m_y.zero();
     m_Acc_y(2) = 1; // TODO: validate this assumption at initial step
 
     m_gravity_direction.zero();
@@ -112,38 +94,15 @@ iDynTree::AttitudeQuaternionEKF::AttitudeQuaternionEKF()
     using iDynTree::toEigen;
     toEigen(m_Id4).setIdentity();
     toEigen(m_Id3).setIdentity();
+
+    serializeStateVector();
 }
 
 bool iDynTree::AttitudeQuaternionEKF::initializeFilter()
 {
-    m_state_size = this->getInternalStateSize();
-
-    if (m_params_qekf.use_magnetometer_measurements)
-    {
-        m_output_size = output_dimensions_with_magnetometer;
-    }
-    else
-    {
-        m_output_size = output_dimensions_without_magnetometer;
-    }
-
-    ekfSetStateSize(m_state_size);
-    m_x.resize(m_state_size);
     serializeStateVector();
-    ekfSetOutputSize(m_output_size);
-
-    m_y.resize(m_output_size);
-    m_input_size = input_dimensions;
-    ekfSetInputSize(m_input_size);
-    m_u.resize(m_input_size);
-
-    // ekfinit resizes and initializes the filter matrices and vectors to zero - dont move it frome here
-    if (!ekfInit())
-    {
-        return false;
-    }
 
-    // once the buffers are resized and zeroed, setup the matrices
+    // setup the covariance matrices
     if (!setInitialStateCovariance(m_params_qekf.initial_orientation_error_variance,
                                    m_params_qekf.initial_ang_vel_error_variance,
                                    m_params_qekf.initial_gyro_bias_error_variance))
@@ -169,69 +128,47 @@ bool iDynTree::AttitudeQuaternionEKF::initializeFilter()
 
 bool iDynTree::AttitudeQuaternionEKF::propagateStates()
 {
-    iDynTree::Span<double> Omega_y_span(m_Omega_y.data(), m_Omega_y.size());
-    bool ok  = ekfSetInputVector(Omega_y_span);
-    ok = ekfPredict() && ok;
-    iDynTree::Span<double> x_span(m_x.data(), m_x.size());
-    if (ekfGetStates(x_span))
-    {
-        deserializeStateVector();
-        m_orientationInSO3 = iDynTree::Rotation::RotationFromQuaternion(m_state_qekf.m_orientation);
-        m_orientationInRPY = m_orientationInSO3.asRPY();
-    }
-    else
-    {
-        iDynTree::reportError("AttitudeQuaternionEKF", "updateFilterWithMeasurements", "could not get recent state estimate");
-        return false;
-    }
+    FixedSizeHelper::ekfSetInputVector(m_Omega_y);
+    bool ok = FixedSizeHelper::ekfPredict();
+    m_x = ekfStates();
+    deserializeStateVector();
+    m_orientationInSO3 = iDynTree::Rotation::RotationFromQuaternion(m_state_qekf.m_orientation);
+    m_orientationInRPY = m_orientationInSO3.asRPY();
     return ok;
 }
 
 void iDynTree::AttitudeQuaternionEKF::serializeMeasurementVector()
 {
     using iDynTree::toEigen;
-    if (m_y.size() != m_output_size)
-    {
-        m_y.resize(m_output_size);
-    }
 
     toEigen(m_y).block<3, 1>(0, 0) = toEigen(m_Acc_y);
     if (m_params_qekf.use_magnetometer_measurements)
     {
         m_y(3) = m_Mag_y;
     }
+    else
+    {
+        // dummy measurement, see ekf_h
+        m_y(3) = 0.0;
+    }
 }
 
 bool iDynTree::AttitudeQuaternionEKF::callEkfUpdate()
 {
     serializeMeasurementVector();
-    iDynTree::Span<double> y_span(m_y.data(), m_y.size());
-    bool ok = ekfSetMeasurementVector(y_span);
-    ok = ekfUpdate() && ok;
+    FixedSizeHelper::ekfSetMeasurementVector(m_y);
+    bool ok = FixedSizeHelper::ekfUpdate();
 
-    iDynTree::Span<double> x_span(m_x.data(), m_x.size());
-    if (ekfGetStates(x_span))
-    {
-        deserializeStateVector();
-        m_orientationInSO3 = iDynTree::Rotation::RotationFromQuaternion(m_state_qekf.m_orientation);
-        m_orientationInRPY = m_orientationInSO3.asRPY();
-    }
-    else
-    {
-        iDynTree::reportError("AttitudeQuaternionEKF", "updateFilterWithMeasurements", "could not get recent state estimate");
-        return false;
-    }
+    m_x = ekfStates();
+    deserializeStateVector();
+    m_orientationInSO3 = iDynTree::Rotation::RotationFromQuaternion(m_state_qekf.m_orientation);
+    m_orientationInRPY = m_orientationInSO3.asRPY();
     return ok;
 }
 
 
 bool iDynTree::AttitudeQuaternionEKF::updateFilterWithMeasurements(const iDynTree::LinearAccelerometerMeasurements& linAccMeas, const iDynTree::GyroscopeMeasurements& gyroMeas, const iDynTree::MagnetometerMeasurements& magMeas)
 {
-    if (m_y.size() != m_output_size)
-    {
-        m_y.resize(m_output_size);
-    }
-
     if (!checkValidMeasurement(linAccMeas, "linear acceleration", true)) { return false; }
     if (!checkValidMeasurement(gyroMeas, "gyroscope", false)) { return false; }
     if (!checkValidMeasurement(magMeas, "magnetometer", true)) { return false; }
@@ -287,30 +224,10 @@ bool iDynTree::AttitudeQuaternionEKF::updateFilterWithMeasurements(const iDynTre
     return ok;
 }
 
-bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianF(iDynTree::VectorDynSize& x, iDynTree::VectorDynSize& u, iDynTree::MatrixDynSize& F)
-{
-    ignore(u);
-    ignore(x);
-    ignore(F);
-    return false;
-}
-
-
-bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianF(iDynTree::VectorDynSize& x, iDynTree::MatrixDynSize& F)
+bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianF(const StateVector& x, const InputVector& u, StateMatrix& F)
 {
     using iDynTree::toEigen;
-
-    if (x.size() != m_state_size)
-    {
-        reportError("AttitudeQuaternionEKF", "computejacobianF", "state size mismatch");
-        return false;
-    }
-
-    if (F.rows() != m_state_size || F.cols() != m_state_size)
-    {
-        reportError("AttitudeQuaternionEKF", "computejacobianF", "jacobian matrix size mismatch");
-        return false;
-    }
+    ignore(u);
 
     F.zero();
 
@@ -330,8 +247,7 @@ bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianF(iDynTree::VectorDynSiz
     dfq_by_dq(0, 3) = dfq_by_dq(2, 1) = -ang_vel(2);
     toEigen(dfq_by_dq) *= (m_params_qekf.time_step_in_seconds/2.0);
 
-    iDynTree::MatrixDynSize dfq_by_dangvel;
-    dfq_by_dangvel.resize(4, 3);
+    iDynTree::MatrixFixSize<4, 3> dfq_by_dangvel;
     dfq_by_dangvel(0, 0) = dfq_by_dangvel(2, 2) = -q(1);
     dfq_by_dangvel(0, 1) = dfq_by_dangvel(3, 0) = -q(2);
     dfq_by_dangvel(0, 2) = dfq_by_dangvel(1, 1) = -q(3);
@@ -355,28 +271,15 @@ bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianF(iDynTree::VectorDynSiz
     return true;
 }
 
-bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianH(iDynTree::VectorDynSize& x, iDynTree::MatrixDynSize& H)
+bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianH(const StateVector& x, OutputJacobianMatrix& H)
 {
     using iDynTree::toEigen;
 
-    if (x.size() != m_state_size)
-    {
-        reportError("AttitudeQuaternionEKF", "computejacobianH", "state size mismatch");
-        return false;
-    }
-
-    if (H.rows() != m_output_size || H.cols() != m_state_size)
-    {
-        reportError("AttitudeQuaternionEKF", "computejacobianH", "jacobian matrix size mismatch");
-        return false;
-    }
-
     H.zero();
     iDynTree::UnitQuaternion q;
     toEigen(q) = toEigen(x).block<4,1>(0, 0);
 
-    iDynTree::MatrixDynSize dhacc_by_dq;
-    dhacc_by_dq.resize(3, 4);
+    iDynTree::MatrixFixSize<3, 4> dhacc_by_dq;
     dhacc_by_dq(0, 0) = dhacc_by_dq(2, 2) = q(2);
     dhacc_by_dq(0, 1) = dhacc_by_dq(1, 2) = -q(3);
     dhacc_by_dq(0, 3) = dhacc_by_dq(1, 0) = -q(1);
@@ -402,7 +305,8 @@ bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianH(iDynTree::VectorDynSiz
 
     toEigen(H).block<3, 4>(0, 0) = toEigen(dhacc_by_dq);
 
-    if (m_output_size == output_dimensions_with_magnetometer)
+    // without magnetometer, the dummy measurement does not depend on the state
+    if (m_params_qekf.use_magnetometer_measurements)
     {
         double q0q3{q(0)*q(3)};
         double q1q2{q(1)*q(2)};
@@ -425,20 +329,8 @@ bool iDynTree::AttitudeQuaternionEKF::ekfComputeJacobianH(iDynTree::VectorDynSiz
     return true;
 }
 
-bool iDynTree::AttitudeQuaternionEKF::ekf_f(const iDynTree::VectorDynSize& x_k, const iDynTree::VectorDynSize& u_k, iDynTree::VectorDynSize& xhat_k_plus_one)
+bool iDynTree::AttitudeQuaternionEKF::ekf_f(const StateVector& x_k, const InputVector& u_k, StateVector& xhat_k_plus_one)
 {
-    if (x_k.size() != m_x.size() || xhat_k_plus_one.size() != m_x.size())
-    {
-        reportError("AttitudeQuaternionEKF", "ekf_f", "state size mismatch");
-        return false;
-    }
-
-    if (u_k.size() != m_u.size())
-    {
-        reportError("AttitudeQuaternionEKF", "ekf_f", "input size mismatch");
-        return false;
-    }
-
     iDynTree::UnitQuaternion orientation;
     iDynTree::Vector3 ang_vel, gyro_bias;
 
@@ -478,20 +370,8 @@ bool iDynTree::AttitudeQuaternionEKF::ekf_f(const iDynTree::VectorDynSize& x_k,
     return true;
 }
 
-bool iDynTree::AttitudeQuaternionEKF::ekf_h(const iDynTree::VectorDynSize& xhat_k_plus_one, iDynTree::VectorDynSize& zhat_k_plus_one)
+bool iDynTree::AttitudeQuaternionEKF::ekf_h(const StateVector& xhat_k_plus_one, OutputVector& zhat_k_plus_one)
 {
-    if (xhat_k_plus_one.size() != m_x.size())
-    {
-        reportError("AttitudeQuaternionEKF", "h", "predicted state size mismatch");
-        return false;
-    }
-
-    if (zhat_k_plus_one.size() != m_y.size())
-    {
-        reportError("AttitudeQuaternionEKF", "h", "output size mismatch");
-        return false;
-    }
-
     // following computation is the same as R^T e_3
     iDynTree::UnitQuaternion q;
     toEigen(q) = toEigen(xhat_k_plus_one).block<4,1>(0, 0);
@@ -522,12 +402,17 @@ bool iDynTree::AttitudeQuaternionEKF::ekf_h(const iDynTree::VectorDynSize& xhat_
     }
 
     // magnetometer measurement gives us yaw
-    if (m_output_size == output_dimensions_with_magnetometer)
+    if (m_params_qekf.use_magnetometer_measurements)
     {
         double q0q3{q(0)*q(3)};
         double q1q2{q(1)*q(2)};
         zhat_k_plus_one(3) = std::atan2(2*(q0q3+q1q2), 1 - 2*(q2squared + q3squared));
     }
+    else
+    {
+        // dummy measurement with zero innovation, that does not affect the update
+        zhat_k_plus_one(3) = 0.0;
+    }
 
     return true;
 }
@@ -537,12 +422,10 @@ bool iDynTree::AttitudeQuaternionEKF::setMeasurementNoiseVariance(double acc, do
     m_params_qekf.accelerometer_noise_variance = acc;
     m_params_qekf.magnetometer_noise_variance = mag;
 
-    iDynTree::MatrixDynSize R = iDynTree::MatrixDynSize(m_output_size, m_output_size);
+    OutputMatrix R;
     prepareMeasurementNoiseCovarianceMatrix(R);
-
-    iDynTree::Span<double> R_span(R.data(), R.capacity());
-    bool ok = ekfSetMeasurementNoiseCovariance(R_span);
-    return ok;
+    FixedSizeHelper::ekfSetMeasurementNoiseCovariance(R);
+    return true;
 }
 
 bool iDynTree::AttitudeQuaternionEKF::setSystemNoiseVariance(double gyro, double gyro_bias)
@@ -550,18 +433,18 @@ bool iDynTree::AttitudeQuaternionEKF::setSystemNoiseVariance(double gyro, double
     m_params_qekf.gyroscope_noise_variance = gyro;
     m_params_qekf.gyro_bias_noise_variance = gyro_bias;
 
-    iDynTree::MatrixDynSize Q = iDynTree::MatrixDynSize(m_state_size, m_state_size);
+    StateMatrix Q;
     prepareSystemNoiseCovarianceMatrix(Q);
-    iDynTree::Span<double> Q_span(Q.data(), Q.capacity());
-    bool ok = ekfSetSystemNoiseCovariance(Q_span);
-    return ok;
+    FixedSizeHelper::ekfSetSystemNoiseCovariance(Q);
+    return true;
 }
 
 bool iDynTree::AttitudeQuaternionEKF::setInitialStateCovariance(double orientation_var, double ang_vel_var, double gyro_bias_var)
 {
     using iDynTree::toEigen;
 
-    iDynTree::MatrixDynSize P(m_state_size, m_state_size);
+    StateMatrix P;
+    P.zero();
 
     auto P_eig(toEigen(P));
     auto Id3(toEigen(m_Id3));
@@ -571,9 +454,8 @@ bool iDynTree::AttitudeQuaternionEKF::setInitialStateCovariance(double orientati
     P_eig.block<3,3>(4,4) = Id3*ang_vel_var;
     P_eig.block<3,3>(7,7) = Id3*gyro_bias_var;
 
-    iDynTree::Span<double> P_span(P.data(), P.capacity());
-    bool ok = ekfSetStateCovariance(P_span);
-    return ok;
+    FixedSizeHelper::ekfSetStateCovariance(P);
+    return true;
 }
 
 
@@ -655,9 +537,8 @@ bool iDynTree::AttitudeQuaternionEKF::setInternalState(const iDynTree::Span< dou
 
     m_initial_state_qekf = m_state_qekf;
     serializeStateVector();
-    iDynTree::Span<double> x0_span(m_x.data(), m_x.size());
-    bool ok = ekfSetInitialState(x0_span);
-    return ok;
+    FixedSizeHelper::ekfSetInitialState(m_x);
+    return true;
 }
 
 bool iDynTree::AttitudeQuaternionEKF::setInternalStateInitialOrientation(const iDynTree::Span< double >& orientationBuffer)
@@ -675,10 +556,9 @@ bool iDynTree::AttitudeQuaternionEKF::setInternalStateInitialOrientation(const i
 
     m_initial_state_qekf = m_state_qekf;
     serializeStateVector();
-    iDynTree::Span<double> x0_span(m_x.data(), m_x.size());
-    bool ok = ekfSetInitialState(x0_span);
+    FixedSizeHelper::ekfSetInitialState(m_x);
 
-    return ok;
+    return true;
 }
 
 
@@ -690,13 +570,8 @@ bool iDynTree::AttitudeQuaternionEKF::useMagnetometerMeasurements(bool use_magne
     }
 
     // store current state estimate and variance
-    iDynTree::VectorDynSize x(m_x);
-    iDynTree::MatrixDynSize P(m_x.size(), m_x.size());
-    iDynTree::Span<double> P_span(P.data(), P.capacity());
-    if (!ekfGetStateCovariance(P_span))
-    {
-        return false;
-    }
+    StateVector x(m_x);
+    const StateMatrix& P = ekfStateCovariance();
 
     // get variances
     double orientation_var{P(0,0)};
@@ -704,7 +579,7 @@ bool iDynTree::AttitudeQuaternionEKF::useMagnetometerMeasurements(bool use_magne
     double gyro_bias_var{P(7,7)};
 
     m_params_qekf.use_magnetometer_measurements = use_magnetometer_measurements;
-    ekfReset();
+    FixedSizeHelper::ekfReset();
 
     bool ok = initializeFilter();
     iDynTree::Span<double> x_span(x.data(), x.size());
@@ -718,3 +593,95 @@ void iDynTree::AttitudeQuaternionEKF::setGravityDirection(const iDynTree::Direct
     m_gravity_direction = gravity_dir;
 }
 
+bool iDynTree::AttitudeQuaternionEKF::ekfPredict()
+{
+    return FixedSizeHelper::ekfPredict();
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfUpdate()
+{
+    return FixedSizeHelper::ekfUpdate();
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfInit()
+{
+    return true;
+}
+
+void iDynTree::AttitudeQuaternionEKF::ekfReset()
+{
+    FixedSizeHelper::ekfReset();
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfSetMeasurementVector(const iDynTree::Span<double>& y)
+{
+    if (m_params_qekf.use_magnetometer_measurements || y.size() != output_dimensions_without_magnetometer)
+    {
+        return FixedSizeHelper::ekfSetMeasurementVector(iDynTree::Span<const double>(y.data(), y.size()));
+    }
+
+    // Measurements of the filter without the magnetometer, followed by the dummy measurement
+    OutputVector y_with_dummy;
+    toEigen(y_with_dummy).head<output_dimensions_without_magnetometer>() = toEigen(y);
+    y_with_dummy(3) = 0.0;
+    FixedSizeHelper::ekfSetMeasurementVector(y_with_dummy);
+    return true;
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfSetInputVector(const iDynTree::Span<double>& u)
+{
+    return FixedSizeHelper::ekfSetInputVector(iDynTree::Span<const double>(u.data(), u.size()));
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfSetInitialState(const iDynTree::Span<double>& x0)
+{
+    return FixedSizeHelper::ekfSetInitialState(iDynTree::Span<const double>(x0.data(), x0.size()));
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfSetStateCovariance(const iDynTree::Span<double>& P)
+{
+    return FixedSizeHelper::ekfSetStateCovariance(iDynTree::Span<const double>(P.data(), P.size()));
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfSetSystemNoiseCovariance(const iDynTree::Span<double>& Q)
+{
+    return FixedSizeHelper::ekfSetSystemNoiseCovariance(iDynTree::Span<const double>(Q.data(), Q.size()));
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfSetMeasurementNoiseCovariance(const iDynTree::Span<double>& R)
+{
+    const size_t sizeWithoutMagnetometer = output_dimensions_without_magnetometer*output_dimensions_without_magnetometer;
+    if (m_params_qekf.use_magnetometer_measurements || static_cast<size_t>(R.size()) != sizeWithoutMagnetometer)
+    {
+        return FixedSizeHelper::ekfSetMeasurementNoiseCovariance(iDynTree::Span<const double>(R.data(), R.size()));
+    }
+
+    // Covariance of the filter without the magnetometer, with unit variance for the dummy measurement
+    OutputMatrix R_with_dummy;
+    R_with_dummy.zero();
+    using RowMajorMatrix3d = Eigen::Matrix<double, 3, 3, Eigen::RowMajor>;
+    toEigen(R_with_dummy).topLeftCorner<3, 3>() = Eigen::Map<const RowMajorMatrix3d>(R.data());
+    R_with_dummy(3, 3) = 1.0;
+    FixedSizeHelper::ekfSetMeasurementNoiseCovariance(R_with_dummy);
+    return true;
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfGetStates(const iDynTree::Span<double>& x) const
+{
+    return FixedSizeHelper::ekfGetStates(x);
+}
+
+bool iDynTree::AttitudeQuaternionEKF::ekfGetStateCovariance(const iDynTree::Span<double>& P) const
+{
+    return FixedSizeHelper::ekfGetStateCovariance(P);
+}
+
+void iDynTree::AttitudeQuaternionEKF::ekfSetUpdateMode(const EKFUpdateMode& mode)
+{
+    FixedSizeHelper::ekfSetUpdateMode(mode);
+}
+
+iDynTree::EKFUpdateMode iDynTree::AttitudeQuaternionEKF::ekfGetUpdateMode() const
+{
+    return FixedSizeHelper::ekfGetUpdateMode();
+}
@@ -19,7 +19,9 @@
 #include <Eigen/SparseCore>
 #include <Eigen/SparseCholesky>
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 namespace iDynTree {
 
@@ -65,15 +67,54 @@ namespace iDynTree {
         Eigen::SimplicialLDLT<Eigen::SparseMatrix<double, Eigen::ColMajor> > covarianceDynamicsPriorInverseDecomposition;
         Eigen::SimplicialLDLT<Eigen::SparseMatrix<double, Eigen::ColMajor> > covarianceDynamicsAPosterioriInverseDecomposition;
 
+        // Fixed-lag smoothing parameters
+        size_t windowLength;
+        double windowSamplingTime;
+        iDynTree::SparseMatrix<iDynTree::ColumnMajor> priorProcessModelCovarianceInverse; // Sigma_p^-1
+        double jointAccelerationIntegrationVariance;
+        std::vector<std::ptrdiff_t> jointAccelerationOffsets;
+
+        // Ring buffer containing the information form (Lambda_k, eta_k) of the samples in the window
+        std::vector<std::vector<double> > windowSamplesInformationMatrixValues;
+        std::vector<iDynTree::VectorDynSize> windowSamplesInformationVector;
+        std::vector<iDynTree::JointDOFsDoubleArray> windowSamplesJointsVelocity;
+        size_t windowOldestSample;
+        size_t windowNrOfSamples;
+
+        // Sparsity pattern of the information matrix of a single sample
+        std::vector<int> sampleInformationOuterIndices;
+        std::vector<int> sampleInformationInnerIndices;
+
+        // Stacked system of the window: its structure is computed once for each number of samples
+        bool windowStructureIsValid;
+        size_t windowStructureNrOfSamples;
+        Eigen::SparseMatrix<double, Eigen::ColMajor> windowInformationMatrix;
+        std::vector<double> windowProcessModelValues;
+        std::vector<int> windowSamplesSlots;
+        Eigen::VectorXd windowInformationVector;
+        Eigen::VectorXd windowEstimate;
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double, Eigen::ColMajor> > windowInformationMatrixDecomposition;
+
         BerdySparseMAPSolverPimpl(BerdyHelper& berdyHelper)
         : berdy(berdyHelper)
         , valid(false)
+        , windowLength(1)
+        , windowSamplingTime(0.0)
+        , jointAccelerationIntegrationVariance(0.0)
+        , windowOldestSample(0)
+        , windowNrOfSamples(0)
+        , windowStructureIsValid(false)
+        , windowStructureNrOfSamples(0)
         {
             initialize();
         }
 
         bool initialize();
-        void computeMAP(bool computePermutation);
+        void computeMAP(bool computePermutation, bool computeAPosterioriEstimate = true);
+        void resetWindow();
+        void addLastSampleToWindow();
+        void buildWindowStructure();
+        void computeWindowMAP();
         static bool invertSparseMatrix(const iDynTree::SparseMatrix<iDynTree::ColumnMajor>&in, iDynTree::SparseMatrix<iDynTree::ColumnMajor>& inverted);
     };
 
@@ -220,7 +261,14 @@ namespace iDynTree {
         Eigen::internal::set_is_malloc_allowed(false);
 #endif
         bool computePermutation = false;
-        m_pimpl->computeMAP(computePermutation);
+        if (m_pimpl->windowLength > 1) {
+            // The a posteriori of the single sample is not needed, as it is computed on the whole window
+            m_pimpl->computeMAP(computePermutation, false);
+            m_pimpl->addLastSampleToWindow();
+            m_pimpl->computeWindowMAP();
+        } else {
+            m_pimpl->computeMAP(computePermutation);
+        }
 
 #ifdef EIGEN_RUNTIME_NO_MALLOC
         Eigen::internal::set_is_malloc_allowed(true);
@@ -240,7 +288,268 @@ namespace iDynTree {
         return m_pimpl->expectedDynamicsAPosteriori;
     }
 
-    void BerdySparseMAPSolver::BerdySparseMAPSolverPimpl::computeMAP(bool computePermutation)
+    bool BerdySparseMAPSolver::setFixedLagWindow(const size_t windowLength, const double samplingTime)
+    {
+        assert(m_pimpl);
+        if (windowLength < 1) {
+            reportError("BerdySparseMAPSolver", "setFixedLagWindow", "The window should contain at least one sample.");
+            return false;
+        }
+        if (windowLength > 1 && samplingTime <= 0) {
+            reportError("BerdySparseMAPSolver", "setFixedLagWindow", "The sampling time should be positive.");
+            return false;
+        }
+        m_pimpl->windowLength = windowLength;
+        m_pimpl->windowSamplingTime = samplingTime;
+
+        m_pimpl->windowSamplesInformationMatrixValues.resize(windowLength);
+        m_pimpl->windowSamplesInformationVector.resize(windowLength);
+        m_pimpl->windowSamplesJointsVelocity.resize(windowLength);
+        m_pimpl->resetWindow();
+        return true;
+    }
+
+    size_t BerdySparseMAPSolver::getFixedLagWindowLength() const
+    {
+        assert(m_pimpl);
+        return m_pimpl->windowLength;
+    }
+
+    size_t BerdySparseMAPSolver::getNrOfSamplesInWindow() const
+    {
+        assert(m_pimpl);
+        return m_pimpl->windowNrOfSamples;
+    }
+
+    void BerdySparseMAPSolver::resetFixedLagWindow()
+    {
+        assert(m_pimpl);
+        m_pimpl->resetWindow();
+    }
+
+    bool BerdySparseMAPSolver::setProcessModelCovariance(const iDynTree::SparseMatrix<iDynTree::ColumnMajor>& covariance)
+    {
+        assert(m_pimpl);
+        if (covariance.rows() != m_pimpl->priorProcessModelCovarianceInverse.rows()
+            || covariance.columns() != m_pimpl->priorProcessModelCovarianceInverse.columns()) {
+            reportError("BerdySparseMAPSolver", "setProcessModelCovariance", "The covariance should be a square matrix of the size of the dynamic variables.");
+            return false;
+        }
+        if (!BerdySparseMAPSolver::BerdySparseMAPSolverPimpl::invertSparseMatrix(covariance, m_pimpl->priorProcessModelCovarianceInverse)) {
+            reportError("BerdySparseMAPSolver", "setProcessModelCovariance", "The covariance is not invertible.");
+            return false;
+        }
+        m_pimpl->windowStructureIsValid = false;
+        return true;
+    }
+
+    const iDynTree::SparseMatrix<iDynTree::ColumnMajor>& BerdySparseMAPSolver::processModelCovarianceInverse() const
+    {
+        assert(m_pimpl);
+        return m_pimpl->priorProcessModelCovarianceInverse;
+    }
+
+    void BerdySparseMAPSolver::setJointAccelerationIntegrationVariance(const double variance)
+    {
+        assert(m_pimpl);
+        m_pimpl->jointAccelerationIntegrationVariance = variance;
+        m_pimpl->windowStructureIsValid = false;
+    }
+
+    bool BerdySparseMAPSolver::getSmoothedEstimate(const size_t lag, iDynTree::VectorDynSize& estimate) const
+    {
+        assert(m_pimpl);
+        if (m_pimpl->windowLength == 1 && lag == 0) {
+            estimate = m_pimpl->expectedDynamicsAPosteriori;
+            return true;
+        }
+        if (lag >= m_pimpl->windowNrOfSamples) {
+            reportError("BerdySparseMAPSolver", "getSmoothedEstimate", "The requested sample is not in the window.");
+            return false;
+        }
+        size_t numberOfDynVariables = m_pimpl->berdy.getNrOfDynamicVariables();
+        size_t block = m_pimpl->windowNrOfSamples - 1 - lag;
+        estimate.resize(numberOfDynVariables);
+        toEigen(estimate) = m_pimpl->windowEstimate.segment(block * numberOfDynVariables, numberOfDynVariables);
+        return true;
+    }
+
+    void BerdySparseMAPSolver::BerdySparseMAPSolverPimpl::resetWindow()
+    {
+        windowOldestSample = 0;
+        windowNrOfSamples = 0;
+        windowStructureIsValid = false;
+    }
+
+    void BerdySparseMAPSolver::BerdySparseMAPSolverPimpl::addLastSampleToWindow()
+    {
+        covarianceDynamicsAPosterioriInverse.makeCompressed();
+        const Eigen::Index nonZeros = covarianceDynamicsAPosterioriInverse.nonZeros();
+        const Eigen::Index outerSize = covarianceDynamicsAPosterioriInverse.outerSize();
+
+        // If the sparsity pattern of the single sample changed, the samples in the window cannot be reused
+        bool samePattern = static_cast<Eigen::Index>(sampleInformationInnerIndices.size()) == nonZeros
+            && static_cast<Eigen::Index>(sampleInformationOuterIndices.size()) == outerSize + 1
+            && std::equal(sampleInformationOuterIndices.begin(), sampleInformationOuterIndices.end(),
+                          covarianceDynamicsAPosterioriInverse.outerIndexPtr())
+            && std::equal(sampleInformationInnerIndices.begin(), sampleInformationInnerIndices.end(),
+                          covarianceDynamicsAPosterioriInverse.innerIndexPtr());
+        if (!samePattern) {
+            sampleInformationOuterIndices.assign(covarianceDynamicsAPosterioriInverse.outerIndexPtr(),
+                                                 covarianceDynamicsAPosterioriInverse.outerIndexPtr() + outerSize + 1);
+            sampleInformationInnerIndices.assign(covarianceDynamicsAPosterioriInverse.innerIndexPtr(),
+                                                 covarianceDynamicsAPosterioriInverse.innerIndexPtr() + nonZeros);
+            resetWindow();
+        }
+
+        size_t sample;
+        if (windowNrOfSamples < windowLength) {
+            sample = (windowOldestSample + windowNrOfSamples) % windowLength;
+            windowNrOfSamples++;
+        } else {
+            // Drop the oldest sample
+            sample = windowOldestSample;
+            windowOldestSample = (windowOldestSample + 1) % windowLength;
+        }
+
+        windowSamplesInformationMatrixValues[sample].assign(covarianceDynamicsAPosterioriInverse.valuePtr(),
+                                                            covarianceDynamicsAPosterioriInverse.valuePtr() + nonZeros);
+        windowSamplesInformationVector[sample] = expectedDynamicsAPosterioriRHS;
+        windowSamplesJointsVelocity[sample] = jointsVelocity;
+    }
+
+    void BerdySparseMAPSolver::BerdySparseMAPSolverPimpl::buildWindowStructure()
+    {
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+        Eigen::internal::set_is_malloc_allowed(true);
+#endif
+        const size_t numberOfDynVariables = berdy.getNrOfDynamicVariables();
+        const size_t numberOfSamples = windowNrOfSamples;
+        const size_t sampleNonZeros = sampleInformationInnerIndices.size();
+        const bool useJointAccelerationIntegration = jointAccelerationIntegrationVariance > 0;
+        const double jointAccelerationWeight = useJointAccelerationIntegration ?
+            windowSamplingTime * windowSamplingTime / (4.0 * jointAccelerationIntegrationVariance) : 0.0;
+
+        // The samples information enter with zero values: the triplets are only used to get the structure
+        iDynTree::Triplets triplets;
+        triplets.reserve(numberOfSamples * (sampleNonZeros
+                                            + 4 * priorProcessModelCovarianceInverse.numberOfNonZeros()
+                                            + 4 * jointAccelerationOffsets.size()));
+        for (size_t block = 0; block < numberOfSamples; ++block) {
+            const size_t blockOffset = block * numberOfDynVariables;
+            for (size_t col = 0; col < numberOfDynVariables; ++col) {
+                for (int k = sampleInformationOuterIndices[col]; k < sampleInformationOuterIndices[col + 1]; ++k) {
+                    triplets.pushTriplet(iDynTree::Triplet(blockOffset + sampleInformationInnerIndices[k],
+                                                           blockOffset + col, 0.0));
+                }
+            }
+        }
+
+        // Process model: coupling of consecutive samples
+        Eigen::Map<Eigen::SparseMatrix<double, Eigen::ColMajor> > processModel = toEigen(priorProcessModelCovarianceInverse);
+        for (size_t block = 0; block + 1 < numberOfSamples; ++block) {
+            const size_t current = block * numberOfDynVariables;
+            const size_t next = current + numberOfDynVariables;
+            for (Eigen::Index k = 0; k < processModel.outerSize(); ++k) {
+                for (Eigen::Map<Eigen::SparseMatrix<double, Eigen::ColMajor> >::InnerIterator it(processModel, k); it; ++it) {
+                    triplets.pushTriplet(iDynTree::Triplet(current + it.row(), current + it.col(), it.value()));
+                    triplets.pushTriplet(iDynTree::Triplet(next + it.row(), next + it.col(), it.value()));
+                    triplets.pushTriplet(iDynTree::Triplet(current + it.row(), next + it.col(), -it.value()));
+                    triplets.pushTriplet(iDynTree::Triplet(next + it.row(), current + it.col(), -it.value()));
+                }
+            }
+
+            if (!useJointAccelerationIntegration) continue;
+            for (std::ptrdiff_t offset : jointAccelerationOffsets) {
+                triplets.pushTriplet(iDynTree::Triplet(current + offset, current + offset, jointAccelerationWeight));
+                triplets.pushTriplet(iDynTree::Triplet(next + offset, next + offset, jointAccelerationWeight));
+                triplets.pushTriplet(iDynTree::Triplet(current + offset, next + offset, jointAccelerationWeight));
+                triplets.pushTriplet(iDynTree::Triplet(next + offset, current + offset, jointAccelerationWeight));
+            }
+        }
+
+        const Eigen::Index windowSize = numberOfSamples * numberOfDynVariables;
+        iDynTree::SparseMatrix<iDynTree::ColumnMajor> stackedMatrix(windowSize, windowSize);
+        stackedMatrix.setFromTriplets(triplets);
+        windowInformationMatrix = toEigen(stackedMatrix);
+        windowInformationMatrix.makeCompressed();
+
+        // Values of the process model: they are the starting point of the numeric update
+        windowProcessModelValues.assign(windowInformationMatrix.valuePtr(),
+                                        windowInformationMatrix.valuePtr() + windowInformationMatrix.nonZeros());
+
+        // Map each nonzero of each sample into the corresponding slot of the stacked matrix
+        windowSamplesSlots.resize(numberOfSamples * sampleNonZeros);
+        const int* stackedOuter = windowInformationMatrix.outerIndexPtr();
+        const int* stackedInner = windowInformationMatrix.innerIndexPtr();
+        for (size_t block = 0; block < numberOfSamples; ++block) {
+            const size_t blockOffset = block * numberOfDynVariables;
+            for (size_t col = 0; col < numberOfDynVariables; ++col) {
+                const int* columnBegin = stackedInner + stackedOuter[blockOffset + col];
+                const int* columnEnd = stackedInner + stackedOuter[blockOffset + col + 1];
+                for (int k = sampleInformationOuterIndices[col]; k < sampleInformationOuterIndices[col + 1]; ++k) {
+                    const int* slot = std::lower_bound(columnBegin, columnEnd,
+                                                       static_cast<int>(blockOffset + sampleInformationInnerIndices[k]));
+                    assert(slot != columnEnd);
+                    windowSamplesSlots[block * sampleNonZeros + k] = static_cast<int>(slot - stackedInner);
+                }
+            }
+        }
+
+        windowInformationVector.resize(windowSize);
+        windowEstimate.resize(windowSize);
+        windowInformationMatrixDecomposition.analyzePattern(windowInformationMatrix);
+
+        windowStructureNrOfSamples = numberOfSamples;
+        windowStructureIsValid = true;
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+        Eigen::internal::set_is_malloc_allowed(false);
+#endif
+    }
+
+    void BerdySparseMAPSolver::BerdySparseMAPSolverPimpl::computeWindowMAP()
+    {
+        if (!windowStructureIsValid || windowStructureNrOfSamples != windowNrOfSamples) {
+            buildWindowStructure();
+        }
+
+        const size_t numberOfDynVariables = berdy.getNrOfDynamicVariables();
+        const size_t sampleNonZeros = sampleInformationInnerIndices.size();
+
+        // Numeric update of the stacked information matrix and vector
+        double* values = windowInformationMatrix.valuePtr();
+        std::copy(windowProcessModelValues.begin(), windowProcessModelValues.end(), values);
+        for (size_t block = 0; block < windowNrOfSamples; ++block) {
+            const size_t sample = (windowOldestSample + block) % windowLength;
+            const std::vector<double>& sampleValues = windowSamplesInformationMatrixValues[sample];
+            const int* slots = windowSamplesSlots.data() + block * sampleNonZeros;
+            for (size_t k = 0; k < sampleNonZeros; ++k) {
+                values[slots[k]] += sampleValues[k];
+            }
+            windowInformationVector.segment(block * numberOfDynVariables, numberOfDynVariables) = toEigen(windowSamplesInformationVector[sample]);
+        }
+
+        if (jointAccelerationIntegrationVariance > 0) {
+            const double weight = windowSamplingTime / (2.0 * jointAccelerationIntegrationVariance);
+            for (size_t block = 0; block + 1 < windowNrOfSamples; ++block) {
+                const JointDOFsDoubleArray& currentVelocity = windowSamplesJointsVelocity[(windowOldestSample + block) % windowLength];
+                const JointDOFsDoubleArray& nextVelocity = windowSamplesJointsVelocity[(windowOldestSample + block + 1) % windowLength];
+                for (size_t dof = 0; dof < jointAccelerationOffsets.size(); ++dof) {
+                    const double velocityIncrement = weight * (nextVelocity(dof) - currentVelocity(dof));
+                    windowInformationVector(block * numberOfDynVariables + jointAccelerationOffsets[dof]) += velocityIncrement;
+                    windowInformationVector((block + 1) * numberOfDynVariables + jointAccelerationOffsets[dof]) += velocityIncrement;
+                }
+            }
+        }
+
+        windowInformationMatrixDecomposition.factorize(windowInformationMatrix);
+        windowEstimate = windowInformationMatrixDecomposition.solve(windowInformationVector);
+
+        // The last estimate is the one of the most recent sample
+        toEigen(expectedDynamicsAPosteriori) = windowEstimate.segment((windowNrOfSamples - 1) * numberOfDynVariables, numberOfDynVariables);
+    }
+
+    void BerdySparseMAPSolver::BerdySparseMAPSolverPimpl::computeMAP(bool computePermutation, bool computeAPosterioriEstimate)
     {
         /*
          * Get berdy matrices
@@ -284,6 +593,12 @@ namespace iDynTree {
         covarianceDynamicsAPosterioriInverse = covarianceDynamicsPriorInverse;
         covarianceDynamicsAPosterioriInverse += toEigen(measurementsMatrix).transpose() * toEigen(priorMeasurementsCovarianceInverse) * toEigen(measurementsMatrix);
 
+        if (!computeAPosterioriEstimate) {
+            // Only the information form of the a posteriori is needed
+            toEigen(expectedDynamicsAPosterioriRHS) = (toEigen(measurementsMatrix).transpose() * toEigen(priorMeasurementsCovarianceInverse) * (toEigen(measurements) - toEigen(measurementsBias)) + covarianceDynamicsPriorInverse * toEigen(expectedDynamicsPrior));
+            return;
+        }
+
         // decompose m_covarianceDynamicsAPosterioriInverse
         if (computePermutation) {
             //        m_intermediateQuantities.covarianceDynamicsAPosterioriInverseDecomposition.analyzePattern(toEigen(m_covarianceDynamicsAPosterioriInverse));
@@ -348,6 +663,24 @@ namespace iDynTree {
         priorDynamicsRegularizationExpectedValue.resize(numberOfDynVariables);
         priorDynamicsRegularizationExpectedValue.zero();
 
+        priorProcessModelCovarianceInverse.resize(numberOfDynVariables, numberOfDynVariables);
+        identityTriplets.clear();
+        identityTriplets.reserve(numberOfDynVariables);
+        identityTriplets.setDiagonalMatrix(0, 0, 1.0, numberOfDynVariables);
+        priorProcessModelCovarianceInverse.setFromTriplets(identityTriplets);
+
+        jointAccelerationOffsets.clear();
+        for (DOFIndex dof = 0; dof < static_cast<DOFIndex>(berdy.model().getNrOfDOFs()); ++dof) {
+            IndexRange range = berdy.getRangeDOFVariable(DOF_ACCELERATION, dof);
+            if (!range.isValid()) {
+                // The integration of the joint accelerations cannot be used
+                jointAccelerationOffsets.clear();
+                break;
+            }
+            jointAccelerationOffsets.push_back(range.offset);
+        }
+        resetWindow();
+
         Vector3 initialGravity;
         initialGravity.zero();
         initialGravity(2) = -9.81;
@@ -15,6 +15,7 @@
 #include <iDynTree/Core/EigenMathHelpers.h>
 #include <iDynTree/Core/SpatialMomentum.h>
 #include <iDynTree/Core/ClassicalAcc.h>
+#include <iDynTree/Core/ThreadPool.h>
 
 #include <iDynTree/Model/Model.h>
 #include <iDynTree/Model/Traversal.h>
@@ -34,11 +35,94 @@
 
 #include <iDynTree/Core/EigenHelpers.h>
 
+#include <algorithm>
 #include <sstream>
 
 namespace iDynTree
 {
 
+namespace
+{
+
+bool propagateKinematicsFromFloatingFrame(const Model& model,
+                                          const Traversal& kinematicTraversal,
+                                          const FrameIndex floatingFrame,
+                                          const Vector3& properClassicalLinearAcceleration,
+                                          const Vector3& angularVel,
+                                          const Vector3& angularAcc,
+                                          const JointPosDoubleArray& jointPos,
+                                          const JointDOFsDoubleArray& jointVel,
+                                          const JointDOFsDoubleArray& jointAcc,
+                                                LinkVelArray& linkVels,
+                                                LinkAccArray& linkProperAccs)
+{
+    // To initialize the kinematic propagation, we should first convert the kinematics
+    // information from the frame in which they are specified to the main frame of the link
+    Transform link_H_frame = model.getFrameTransform(floatingFrame);
+
+    // Convert the twist from the additional  frame to the link frame
+    Twist      base_vel_frame, base_vel_link;
+    Vector3 zero3;
+    zero3.zero();
+    base_vel_frame.setLinearVec3(zero3);
+    base_vel_frame.setAngularVec3(angularVel);
+    base_vel_link = link_H_frame*base_vel_frame;
+
+    // Convert the acceleration from the additional  frame to the link frame
+    SpatialAcc base_acc_frame, base_acc_link;
+    ClassicalAcc  base_classical_acc_link;
+    base_acc_frame.setLinearVec3(properClassicalLinearAcceleration);
+    base_acc_frame.setAngularVec3(angularAcc);
+    base_acc_link = link_H_frame*base_acc_frame;
+    base_classical_acc_link.fromSpatial(base_acc_link,base_vel_link);
+
+    // Propagate the kinematics information
+    return dynamicsEstimationForwardVelAccKinematics(model,kinematicTraversal,
+                                                     base_classical_acc_link.getLinearVec3(),
+                                                     base_vel_link.getAngularVec3(),
+                                                     base_classical_acc_link.getAngularVec3(),
+                                                     jointPos,jointVel,jointAcc,
+                                                     linkVels,linkProperAccs);
+}
+
+/**
+ * Buffers used to process a chunk of samples in
+ * ExtWrenchesAndJointTorquesEstimator::estimateExtWrenchesAndJointTorquesBatch
+ */
+struct BatchEstimationChunkBuffers
+{
+    JointPosDoubleArray jointPos;
+    JointDOFsDoubleArray jointVel;
+    JointDOFsDoubleArray jointAcc;
+    LinkVelArray linkVels;
+    LinkAccArray linkProperAccs;
+    LinkNetExternalWrenches linkNetExternalWrenches;
+    LinkInternalWrenches linkIntWrenches;
+    FreeFloatingGeneralizedTorques generalizedTorques;
+    SensorsMeasurements ftSensorsMeasures;
+    LinkContactWrenches contactWrenches;
+    estimateExternalWrenchesBuffers bufs;
+    bool ok;
+
+    void resize(const Model& model, const SubModelDecomposition& submodels, const SensorsList& sensors)
+    {
+        jointPos.resize(model);
+        jointVel.resize(model);
+        jointAcc.resize(model);
+        linkVels.resize(model);
+        linkProperAccs.resize(model);
+        linkNetExternalWrenches.resize(model);
+        linkIntWrenches.resize(model);
+        generalizedTorques.resize(model);
+        ftSensorsMeasures.resize(sensors);
+        contactWrenches.resize(model);
+        bufs.resize(submodels);
+        ok = true;
+    }
+};
+
+}
+
 ExtWrenchesAndJointTorquesEstimator::ExtWrenchesAndJointTorquesEstimator():
     m_model(),
     m_submodels(),
@@ -46,6 +130,7 @@ ExtWrenchesAndJointTorquesEstimator::ExtWrenchesAndJointTorquesEstimator():
     m_isModelValid(false),
     m_isKinematicsUpdated(false),
     m_dynamicTraversal(),
+    m_sensorsPredictionPlan(),
     m_kinematicTraversals(),
     m_jointPos(),
     m_linkVels(),
@@ -54,13 +139,19 @@ ExtWrenchesAndJointTorquesEstimator::ExtWrenchesAndJointTorquesEstimator():
     m_linkIntWrenches(),
     m_generalizedTorques(),
     m_calibBufs(),
-    m_bufs()
+    m_bufs(),
+    m_threadPool(0)
 {
 
 }
 
 ExtWrenchesAndJointTorquesEstimator::~ExtWrenchesAndJointTorquesEstimator()
 {
+    if( m_threadPool )
+    {
+        delete m_threadPool;
+        m_threadPool = 0;
+    }
 }
 
 
@@ -111,6 +202,10 @@ bool ExtWrenchesAndJointTorquesEstimator::setModelAndSensors(const Model& _model
     m_bufs.resize(m_submodels);
     m_calibBufs.resize(1,_model.getNrOfLinks());
 
+    // if some sensor is not supported by the plan, the sensors are simulated
+    // with predictSensorsMeasurementsFromRawBuffers
+    m_sensorsPredictionPlan.init(m_model,m_sensors,m_dynamicTraversal);
+
     // set that the model is valid
     m_isModelValid = true;
 
@@ -172,6 +267,35 @@ bool ExtWrenchesAndJointTorquesEstimator::loadModelAndSensorsFromFileWithSpecifi
     return setModelAndSensors(_modelReduced,_sensorsReduced);
 }
 
+void ExtWrenchesAndJointTorquesEstimator::setPseudoInverseMethod(const ExternalWrenchesPseudoInverseMethod method)
+{
+    m_bufs.pseudoInverseMethod = method;
+    m_calibBufs.pseudoInverseMethod = method;
+}
+
+void ExtWrenchesAndJointTorquesEstimator::setNrOfEstimationWorkerThreads(const size_t nrOfWorkerThreads)
+{
+    if( nrOfWorkerThreads == 0 )
+    {
+        delete m_threadPool;
+        m_threadPool = 0;
+        return;
+    }
+
+    if( !m_threadPool )
+    {
+        m_threadPool = new ThreadPool(nrOfWorkerThreads);
+    }
+    else
+    {
+        m_threadPool->resize(nrOfWorkerThreads);
+    }
+}
+
+size_t ExtWrenchesAndJointTorquesEstimator::getNrOfEstimationWorkerThreads() const
+{
+    return m_threadPool ? m_threadPool->getNrOfWorkerThreads() : 0;
+}
 
 const Model& ExtWrenchesAndJointTorquesEstimator::model() const
 {
@@ -237,33 +361,9 @@ bool ExtWrenchesAndJointTorquesEstimator::updateKinematicsFromFloatingBase(const
     // Get link of the specified frame
     LinkIndex floatingLinkIndex = m_model.getFrameLink(floatingFrame);
 
-    // To initialize the kinematic propagation, we should first convert the kinematics
-    // information from the frame in which they are specified to the main frame of the link
-    Transform link_H_frame = m_model.getFrameTransform(floatingFrame);
-
-    // Convert the twist from the additional  frame to the link frame
-    Twist      base_vel_frame, base_vel_link;
-    Vector3 zero3;
-    zero3.zero();
-    base_vel_frame.setLinearVec3(zero3);
-    base_vel_frame.setAngularVec3(angularVel);
-    base_vel_link = link_H_frame*base_vel_frame;
-
-    // Convert the acceleration from the additional  frame to the link frame
-    SpatialAcc base_acc_frame, base_acc_link;
-    ClassicalAcc  base_classical_acc_link;
-    base_acc_frame.setLinearVec3(properClassicalLinearAcceleration);
-    base_acc_frame.setAngularVec3(angularAcc);
-    base_acc_link = link_H_frame*base_acc_frame;
-    base_classical_acc_link.fromSpatial(base_acc_link,base_vel_link);
-
-    // Propagate the kinematics information
-    bool ok = dynamicsEstimationForwardVelAccKinematics(m_model,m_kinematicTraversals.getTraversalWithLinkAsBase(m_model,floatingLinkIndex),
-                                                        base_classical_acc_link.getLinearVec3(),
-                                                        base_vel_link.getAngularVec3(),
-                                                        base_classical_acc_link.getAngularVec3(),
-                                                        jointPos,jointVel,jointAcc,
-                                                        m_linkVels,m_linkProperAccs);
+    bool ok = propagateKinematicsFromFloatingFrame(m_model,m_kinematicTraversals.getTraversalWithLinkAsBase(m_model,floatingLinkIndex),
+                                                   floatingFrame,properClassicalLinearAcceleration,angularVel,angularAcc,
+                                                   jointPos,jointVel,jointAcc,m_linkVels,m_linkProperAccs);
 
     // Store joint positions
     m_jointPos = jointPos;
@@ -333,8 +433,15 @@ bool ExtWrenchesAndJointTorquesEstimator::computeExpectedFTSensorsMeasurements(c
     /**
      * Simulate FT sensor measurements
      */
-    predictSensorsMeasurementsFromRawBuffers(m_model,m_sensors,m_dynamicTraversal,
-                                             m_linkVels,m_linkProperAccs,m_linkIntWrenches,predictedMeasures);
+    if( m_sensorsPredictionPlan.isValid() )
+    {
+        m_sensorsPredictionPlan.predictSensorsMeasurements(m_linkVels,m_linkProperAccs,m_linkIntWrenches,predictedMeasures);
+    }
+    else
+    {
+        predictSensorsMeasurementsFromRawBuffers(m_model,m_sensors,m_dynamicTraversal,
+                                                 m_linkVels,m_linkProperAccs,m_linkIntWrenches,predictedMeasures);
+    }
 
 
     /**
@@ -368,9 +475,20 @@ bool ExtWrenchesAndJointTorquesEstimator::estimateExtWrenchesAndJointTorques(con
     /**
      * Compute external forces
      */
-    bool ok = estimateExternalWrenches(m_model,m_submodels,m_sensors,
-                                       unknowns,m_jointPos,m_linkVels,m_linkProperAccs,
-                                       ftSensorsMeasures,m_bufs,estimateContactWrenches);
+    bool ok = false;
+    if( m_threadPool )
+    {
+        ok = estimateExternalWrenches(m_model,m_submodels,m_sensors,
+                                      unknowns,m_jointPos,m_linkVels,m_linkProperAccs,
+                                      ftSensorsMeasures,m_bufs,estimateContactWrenches,
+                                      *m_threadPool);
+    }
+    else
+    {
+        ok = estimateExternalWrenches(m_model,m_submodels,m_sensors,
+                                      unknowns,m_jointPos,m_linkVels,m_linkProperAccs,
+                                      ftSensorsMeasures,m_bufs,estimateContactWrenches);
+    }
 
     if( !ok )
     {
@@ -412,6 +530,202 @@ bool ExtWrenchesAndJointTorquesEstimator::estimateExtWrenchesAndJointTorques(con
     return ok;
 }
 
+bool ExtWrenchesAndJointTorquesEstimator::estimateExtWrenchesAndJointTorquesBatch(MatrixView<const double> jointPos,
+                                                                                  MatrixView<const double> jointVel,
+                                                                                  MatrixView<const double> jointAcc,
+                                                                                  const FrameIndex& floatingFrame,
+                                                                                  MatrixView<const double> properClassicalLinearAcceleration,
+                                                                                  MatrixView<const double> angularVel,
+                                                                                  MatrixView<const double> angularAcc,
+                                                                                  MatrixView<const double> ftSensorsMeasures,
+                                                                                  const std::vector<LinkUnknownWrenchContacts>& contactSets,
+                                                                                  const std::vector<size_t>& contactSetOfSample,
+                                                                                  MatrixView<double> estimatedContactWrenches,
+                                                                                  MatrixView<double> estimatedJointTorques)
+{
+    if( !m_isModelValid )
+    {
+        reportError("ExtWrenchesAndJointTorquesEstimator","estimateExtWrenchesAndJointTorquesBatch",
+                    "Model and sensors information not set.");
+        return false;
+    }
+
+    if( floatingFrame == FRAME_INVALID_INDEX ||
+        floatingFrame < 0 || floatingFrame >= static_cast<FrameIndex>(m_model.getNrOfFrames()) )
+    {
+        reportError("ExtWrenchesAndJointTorquesEstimator","estimateExtWrenchesAndJointTorquesBatch","Unknown frame index specified.");
+        return false;
+    }
+
+    const size_t nrOfSamples = contactSetOfSample.size();
+    const size_t nrOfPosCoords = m_model.getNrOfPosCoords();
+    const size_t nrOfDOFs = m_model.getNrOfDOFs();
+    const size_t nrOfFTs = m_sensors.getNrOfSensors(SIX_AXIS_FORCE_TORQUE);
+
+    bool sizesAreConsistent = static_cast<size_t>(jointPos.rows()) == nrOfSamples
+                           && static_cast<size_t>(jointPos.cols()) == nrOfPosCoords
+                           && static_cast<size_t>(jointVel.rows()) == nrOfSamples
+                           && static_cast<size_t>(jointVel.cols()) == nrOfDOFs
+                           && static_cast<size_t>(jointAcc.rows()) == nrOfSamples
+                           && static_cast<size_t>(jointAcc.cols()) == nrOfDOFs
+                           && static_cast<size_t>(properClassicalLinearAcceleration.rows()) == nrOfSamples
+                           && properClassicalLinearAcceleration.cols() == 3
+                           && static_cast<size_t>(angularVel.rows()) == nrOfSamples
+                           && angularVel.cols() == 3
+                           && static_cast<size_t>(angularAcc.rows()) == nrOfSamples
+                           && angularAcc.cols() == 3
+                           && static_cast<size_t>(ftSensorsMeasures.rows()) == nrOfSamples
+                           && static_cast<size_t>(ftSensorsMeasures.cols()) == 6*nrOfFTs
+                           && static_cast<size_t>(estimatedContactWrenches.rows()) == nrOfSamples
+                           && static_cast<size_t>(estimatedJointTorques.rows()) == nrOfSamples
+                           && static_cast<size_t>(estimatedJointTorques.cols()) == nrOfDOFs;
+
+    if( !sizesAreConsistent )
+    {
+        reportError("ExtWrenchesAndJointTorquesEstimator","estimateExtWrenchesAndJointTorquesBatch",
+                    "The size of the input or output matrices is not consistent with the model, the sensors or the number of samples.");
+        return false;
+    }
+
+    // Number of contacts of each contact set, used to check the size of the contact wrenches output
+    std::vector<size_t> nrOfContactsOfSet(contactSets.size(),0);
+    for(size_t set=0; set < contactSets.size(); set++)
+    {
+        for(LinkIndex lnkIdx=0; lnkIdx < static_cast<LinkIndex>(m_model.getNrOfLinks()); lnkIdx++)
+        {
+            nrOfContactsOfSet[set] += contactSets[set].getNrOfContactsForLink(lnkIdx);
+        }
+    }
+
+    for(size_t sample=0; sample < nrOfSamples; sample++)
+    {
+        if( contactSetOfSample[sample] >= contactSets.size() ||
+            6*nrOfContactsOfSet[contactSetOfSample[sample]] > static_cast<size_t>(estimatedContactWrenches.cols()) )
+        {
+            std::stringstream ss;
+            ss << "Contact set of sample " << sample << " is not valid or has more contacts than the estimatedContactWrenches columns allow.";
+            reportError("ExtWrenchesAndJointTorquesEstimator","estimateExtWrenchesAndJointTorquesBatch",ss.str().c_str());
+            return false;
+        }
+    }
+
+    // The traversal is computed here, as the traversal cache is not thread safe
+    const Traversal & kinematicTraversal =
+        m_kinematicTraversals.getTraversalWithLinkAsBase(m_model,m_model.getFrameLink(floatingFrame));
+
+    // Each chunk of contiguous samples is processed by a single thread with its own buffers,
+    // so that the pseudo inverse cache of the buffers is effective for long static contact phases
+    const size_t nrOfChunks = std::max<size_t>(1,std::min<size_t>(nrOfSamples,
+                                                                  m_threadPool ? m_threadPool->getNrOfWorkerThreads()+1 : 1));
+    const size_t samplesPerChunk = nrOfSamples/nrOfChunks;
+    const size_t nrOfChunksWithOneMoreSample = nrOfSamples%nrOfChunks;
+
+    std::vector<BatchEstimationChunkBuffers> chunkBuffers(nrOfChunks);
+    for(size_t chunk=0; chunk < nrOfChunks; chunk++)
+    {
+        chunkBuffers[chunk].resize(m_model,m_submodels,m_sensors);
+        chunkBuffers[chunk].bufs.pseudoInverseMethod = m_bufs.pseudoInverseMethod;
+    }
+
+    auto estimateChunk = [&](const size_t chunk)
+    {
+        BatchEstimationChunkBuffers & chunkBufs = chunkBuffers[chunk];
+        const size_t firstSample = chunk*samplesPerChunk + std::min(chunk,nrOfChunksWithOneMoreSample);
+        const size_t endSample = firstSample + samplesPerChunk + (chunk < nrOfChunksWithOneMoreSample ? 1 : 0);
+
+        Vector3 properAcc, angVel, angAcc;
+        Wrench ftMeasure;
+
+        for(size_t sample=firstSample; sample < endSample && chunkBufs.ok; sample++)
+        {
+            for(size_t i=0; i < nrOfPosCoords; i++)
+            {
+                chunkBufs.jointPos(i) = jointPos(sample,i);
+            }
+
+            for(size_t i=0; i < nrOfDOFs; i++)
+            {
+                chunkBufs.jointVel(i) = jointVel(sample,i);
+                chunkBufs.jointAcc(i) = jointAcc(sample,i);
+            }
+
+            for(unsigned int i=0; i < 3; i++)
+            {
+                properAcc(i) = properClassicalLinearAcceleration(sample,i);
+                angVel(i) = angularVel(sample,i);
+                angAcc(i) = angularAcc(sample,i);
+            }
+
+            for(size_t ft=0; ft < nrOfFTs; ft++)
+            {
+                for(unsigned int i=0; i < 6; i++)
+                {
+                    ftMeasure(i) = ftSensorsMeasures(sample,6*ft+i);
+                }
+                chunkBufs.ftSensorsMeasures.setMeasurement(SIX_AXIS_FORCE_TORQUE,ft,ftMeasure);
+            }
+
+            const LinkUnknownWrenchContacts & unknowns = contactSets[contactSetOfSample[sample]];
+
+            chunkBufs.ok = propagateKinematicsFromFloatingFrame(m_model,kinematicTraversal,floatingFrame,
+                                                                properAcc,angVel,angAcc,
+                                                                chunkBufs.jointPos,chunkBufs.jointVel,chunkBufs.jointAcc,
+                                                                chunkBufs.linkVels,chunkBufs.linkProperAccs)
+                        && estimateExternalWrenches(m_model,m_submodels,m_sensors,
+                                                    unknowns,chunkBufs.jointPos,chunkBufs.linkVels,chunkBufs.linkProperAccs,
+                                                    chunkBufs.ftSensorsMeasures,chunkBufs.bufs,chunkBufs.contactWrenches)
+                        && chunkBufs.contactWrenches.computeNetWrenches(chunkBufs.linkNetExternalWrenches)
+                        && RNEADynamicPhase(m_model,m_dynamicTraversal,chunkBufs.jointPos,chunkBufs.linkVels,chunkBufs.linkProperAccs,
+                                            chunkBufs.linkNetExternalWrenches,chunkBufs.linkIntWrenches,chunkBufs.generalizedTorques);
+
+            // Copy the results in the output matrices
+            size_t col = 0;
+            for(LinkIndex lnkIdx=0; lnkIdx < static_cast<LinkIndex>(m_model.getNrOfLinks()); lnkIdx++)
+            {
+                for(size_t contact=0; contact < chunkBufs.contactWrenches.getNrOfContactsForLink(lnkIdx); contact++)
+                {
+                    const Wrench & contactWrench = chunkBufs.contactWrenches.contactWrench(lnkIdx,contact).contactWrench();
+                    for(unsigned int i=0; i < 6; i++)
+                    {
+                        estimatedContactWrenches(sample,col++) = contactWrench(i);
+                    }
+                }
+            }
+
+            for(; col < static_cast<size_t>(estimatedContactWrenches.cols()); col++)
+            {
+                estimatedContactWrenches(sample,col) = 0.0;
+            }
+
+            for(size_t i=0; i < nrOfDOFs; i++)
+            {
+                estimatedJointTorques(sample,i) = chunkBufs.generalizedTorques.jointTorques()(i);
+            }
+        }
+    };
+
+    if( m_threadPool )
+    {
+        m_threadPool->parallelFor(nrOfChunks,estimateChunk);
+    }
+    else
+    {
+        estimateChunk(0);
+    }
+
+    for(size_t chunk=0; chunk < nrOfChunks; chunk++)
+    {
+        if( !chunkBuffers[chunk].ok )
+        {
+            reportError("ExtWrenchesAndJointTorquesEstimator","estimateExtWrenchesAndJointTorquesBatch",
+                        "Error in estimating the external wrenches and joint torques of one of the samples.");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool ExtWrenchesAndJointTorquesEstimator::checkThatTheModelIsStill(const double gravityNorm,
                                                                    const double properAccTol,
                                                                    const double verbose)
@@ -11,6 +11,8 @@
 #include <iDynTree/Estimation/ExtendedKalmanFilter.h>
 #include <iDynTree/Core/EigenHelpers.h>
 
+#include <Eigen/Cholesky>
+
 iDynTree::DiscreteExtendedKalmanFilterHelper::DiscreteExtendedKalmanFilterHelper()
 {
 
@@ -104,6 +106,17 @@ bool iDynTree::DiscreteExtendedKalmanFilterHelper::ekfInit()
     m_K.zero();
     m_R.resize(m_dim_Y, m_dim_Y);
     m_R.zero();
+    m_R_is_diagonal = true;
+
+    // workspaces of the update step
+    m_z.resize(m_dim_Y);
+    m_z.zero();
+    m_PHt.resize(m_dim_X, m_dim_Y);
+    m_Kt.resize(m_dim_Y, m_dim_X);
+    m_IKH.resize(m_dim_X, m_dim_X);
+    m_XX.resize(m_dim_X, m_dim_X);
+    m_KR.resize(m_dim_X, m_dim_Y);
+    m_Schol.resize(m_dim_Y, m_dim_Y);
 
     m_is_initialized = true;
     return m_is_initialized;
@@ -144,8 +157,12 @@ bool iDynTree::DiscreteExtendedKalmanFilterHelper::ekfPredict()
     auto F(toEigen(m_F));
     auto Q(toEigen(m_Q));
 
+    auto FP(toEigen(m_XX));
+
     // propagate covariance
-    Phat = F*P*(F.transpose()) + Q;           ///< \f$ \hat{P}_{k+1} = F_k P_k F_k^T + Q \f$
+    FP.noalias() = F*P;
+    Phat.noalias() = FP*(F.transpose());
+    Phat += Q;                                ///< \f$ \hat{P}_{k+1} = F_k P_k F_k^T + Q \f$
     m_input_updated = false;
     return true;
 }
@@ -176,9 +193,13 @@ bool iDynTree::DiscreteExtendedKalmanFilterHelper::ekfUpdate()
         return false;
     }
 
-    iDynTree::VectorDynSize z;
-    z.resize(m_dim_Y);
-    ekf_h(m_xhat, z);                             ///< \f$ z_{k+1} = h(\hat{x}_{k+1}) \f$
+    if (m_update_mode == EKF_UPDATE_SEQUENTIAL && !m_R_is_diagonal)
+    {
+        iDynTree::reportError("DiscreteExtendedKalmanFilterHelper", "ekfUpdate", "sequential update requires a diagonal measurement noise covariance.");
+        return false;
+    }
+
+    ekf_h(m_xhat, m_z);                           ///< \f$ z_{k+1} = h(\hat{x}_{k+1}) \f$
     ekfComputeJacobianH(m_xhat, m_H);            ///< \f$ H \mid_{x = \hat{x}_{k+1}} \f$
 
     using iDynTree::toEigen;
@@ -190,12 +211,88 @@ bool iDynTree::DiscreteExtendedKalmanFilterHelper::ekfUpdate()
     auto R(toEigen(m_R));
     auto x(toEigen(m_x));
     auto xhat(toEigen(m_xhat));
-    auto y(toEigen(m_y) - toEigen(z));        ///< innovation \f$ \tilde{y}_{k+1} = y_{k+1} - z_{k+1} \f$
+    auto y(toEigen(m_z));
+    y = toEigen(m_y) - y;                     ///< innovation \f$ \tilde{y}_{k+1} = y_{k+1} - z_{k+1} \f$
+
+    if (m_update_mode == EKF_UPDATE_STANDARD)
+    {
+        S = H*Phat*(H.transpose()) + R;             ///< \f$ S_{k+1} = H_{k+1} \hat{P}_{k+1} H_{k+1}^T + R \f$
+        K = Phat*(H.transpose())*(S.inverse());       ///< \f$ K_{k+1} = \hat{P}_{k+1} H_{k+1}^T S_{k+1}^{-1} \f$
+        P = Phat - (K*H*Phat);                    ///< \f$ P_{k+1} = \hat{P}_{k+1} - (K_{k+1} H \hat{P}_{k+1}) \f$
+        x = xhat + K*y;                           ///< \f$ x_{k+1} = \hat{x}_{k+1} + K_{k+1} \tilde{y}_{k+1} \f$
+
+        m_measurement_updated = false;
+        return true;
+    }
+
+    auto PHt(toEigen(m_PHt));
+
+    if (m_update_mode == EKF_UPDATE_SEQUENTIAL)
+    {
+        // Each scalar measurement i is processed using the state and covariance updated with the
+        // measurements 0...i-1, the innovation is corrected for the already applied state update
+        x = xhat;
+        P = Phat;
+        for (size_t i = 0; i < m_dim_Y; i++)
+        {
+            auto Ph(PHt.col(i));
+            Ph.noalias() = P*(H.row(i).transpose());
+            double s = H.row(i).dot(Ph) + R(i, i);
+            if (!(s > 0.0))
+            {
+                iDynTree::reportError("DiscreteExtendedKalmanFilterHelper", "ekfUpdate", "innovation covariance is not positive definite.");
+                return false;
+            }
+            double innovation = y(i) - H.row(i).dot(x - xhat);
+            x += (innovation/s)*Ph;
+            P.noalias() -= (Ph/s)*(Ph.transpose());
+        }
+
+        m_measurement_updated = false;
+        return true;
+    }
+
+    auto Kt(toEigen(m_Kt));
 
-    S = H*Phat*(H.transpose()) + R;             ///< \f$ S_{k+1} = H_{k+1} \hat{P}_{k+1} H_{k+1}^T + R \f$
-    K = Phat*(H.transpose())*(S.inverse());       ///< \f$ K_{k+1} = \hat{P}_{k+1} H_{k+1}^T S_{k+1}^{-1} \f$
-    P = Phat - (K*H*Phat);                    ///< \f$ P_{k+1} = \hat{P}_{k+1} - (K_{k+1} H \hat{P}_{k+1}) \f$
-    x = xhat + K*y;                           ///< \f$ x_{k+1} = \hat{x}_{k+1} + K_{k+1} \tilde{y}_{k+1} \f$
+    PHt.noalias() = Phat*(H.transpose());
+    S.noalias() = H*PHt;
+    S += R;                                   ///< \f$ S_{k+1} = H_{k+1} \hat{P}_{k+1} H_{k+1}^T + R \f$
+
+    // In place factorization in a separate workspace, so that S is preserved
+    auto Schol(toEigen(m_Schol));
+    Schol = S;
+    Eigen::LLT<Eigen::Ref<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > > llt(Schol);
+    if (llt.info() != Eigen::Success)
+    {
+        iDynTree::reportError("DiscreteExtendedKalmanFilterHelper", "ekfUpdate", "innovation covariance is not positive definite.");
+        return false;
+    }
+
+    Kt = PHt.transpose();
+    llt.solveInPlace(Kt);
+    K = Kt.transpose();                       ///< \f$ K_{k+1} = \hat{P}_{k+1} H_{k+1}^T S_{k+1}^{-1} \f$
+
+    if (m_update_mode == EKF_UPDATE_JOSEPH)
+    {
+        auto IKH(toEigen(m_IKH));
+        auto IKHPhat(toEigen(m_XX));
+        auto KR(toEigen(m_KR));
+
+        IKH.setIdentity();
+        IKH.noalias() -= K*H;
+        IKHPhat.noalias() = IKH*Phat;
+        P.noalias() = IKHPhat*(IKH.transpose());
+        KR.noalias() = K*R;
+        P.noalias() += KR*(K.transpose());    ///< \f$ P_{k+1} = (I - K_{k+1} H) \hat{P}_{k+1} (I - K_{k+1} H)^T + K_{k+1} R K_{k+1}^T \f$
+    }
+    else
+    {
+        P = Phat;
+        P.noalias() -= K*(PHt.transpose());   ///< \f$ P_{k+1} = \hat{P}_{k+1} - (K_{k+1} H \hat{P}_{k+1}) \f$
+    }
+
+    x = xhat;
+    x.noalias() += K*y;                       ///< \f$ x_{k+1} = \hat{x}_{k+1} + K_{k+1} \tilde{y}_{k+1} \f$
 
     m_measurement_updated = false;
     return true;
@@ -287,6 +384,19 @@ bool iDynTree::DiscreteExtendedKalmanFilterHelper::ekfSetMeasurementNoiseCovaria
     }
 
     m_R = iDynTree::MatrixDynSize(R.data(), m_dim_Y, m_dim_Y);
+
+    m_R_is_diagonal = true;
+    for (size_t i = 0; i < m_dim_Y; i++)
+    {
+        for (size_t j = 0; j < m_dim_Y; j++)
+        {
+            if (i != j && m_R(i, j) != 0.0)
+            {
+                m_R_is_diagonal = false;
+            }
+        }
+    }
+
     return true;
 }
 
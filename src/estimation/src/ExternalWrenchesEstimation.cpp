@@ -12,6 +12,7 @@
 #include <iDynTree/Core/EigenHelpers.h>
 #include <iDynTree/Core/EigenMathHelpers.h>
 #include <iDynTree/Core/SpatialMomentum.h>
+#include <iDynTree/Core/ThreadPool.h>
 
 #include <iDynTree/Model/Model.h>
 #include <iDynTree/Model/Traversal.h>
@@ -24,6 +25,9 @@
 #include <iDynTree/Sensors/Sensors.h>
 #include <iDynTree/Sensors/SixAxisForceTorqueSensor.h>
 
+#include <atomic>
+#include <limits>
+
 namespace iDynTree
 {
 
@@ -178,18 +182,21 @@ std::string LinkUnknownWrenchContacts::toString(const Model& model) const
     return ss.str();
 }
 
-estimateExternalWrenchesBuffers::estimateExternalWrenchesBuffers()
+estimateExternalWrenchesBuffers::estimateExternalWrenchesBuffers():
+    pseudoInverseMethod(JACOBI_SVD_PSEUDOINVERSE)
 {
     resize(0,0);
 }
 
 
-estimateExternalWrenchesBuffers::estimateExternalWrenchesBuffers(const SubModelDecomposition& subModels)
+estimateExternalWrenchesBuffers::estimateExternalWrenchesBuffers(const SubModelDecomposition& subModels):
+    pseudoInverseMethod(JACOBI_SVD_PSEUDOINVERSE)
 {
     resize(subModels);
 }
 
-estimateExternalWrenchesBuffers::estimateExternalWrenchesBuffers(const size_t nrOfSubModels, const size_t nrOfLinks)
+estimateExternalWrenchesBuffers::estimateExternalWrenchesBuffers(const size_t nrOfSubModels, const size_t nrOfLinks):
+    pseudoInverseMethod(JACOBI_SVD_PSEUDOINVERSE)
 {
     resize(nrOfSubModels,nrOfLinks);
 }
@@ -207,6 +214,11 @@ void estimateExternalWrenchesBuffers::resize(const size_t nrOfSubModels, const s
     b.resize(nrOfSubModels);
     pinvA.resize(nrOfSubModels);
 
+    // Invalidate the cached decompositions
+    decomposedA.assign(nrOfSubModels, MatrixDynSize(0,0));
+    decomposedAMethod.assign(nrOfSubModels, pseudoInverseMethod);
+    pseudoInverseSolvers.assign(nrOfSubModels, PseudoInverseSolver(PseudoInverseSolverMethod::CompleteOrthogonalDecomposition));
+
     b_contacts_subtree.resize(nrOfLinks);
 
     subModelBase_H_link.resize(nrOfLinks);
@@ -503,6 +515,52 @@ void computeMatrixOfEstimationEquationAndExtWrenchKnownTerms(const Model& model,
      }
 }
 
+/**
+ * Compute bufs.pinvA[subModelIndex], if bufs.A[subModelIndex] changed since the last time it was decomposed.
+ */
+void computePseudoInverseOfEstimationEquationMatrix(const size_t subModelIndex,
+                                                    const double tol,
+                                                          estimateExternalWrenchesBuffers& bufs)
+{
+    MatrixDynSize & A = bufs.A[subModelIndex];
+    MatrixDynSize & decomposedA = bufs.decomposedA[subModelIndex];
+
+    // A depends only on the contacts and on the joint positions of the submodel:
+    // if it is exactly the one already decomposed, pinvA is still valid
+    if( bufs.decomposedAMethod[subModelIndex] == bufs.pseudoInverseMethod &&
+        decomposedA.rows() == A.rows() && decomposedA.cols() == A.cols() &&
+        toEigen(decomposedA) == toEigen(A) )
+    {
+        return;
+    }
+
+    switch( bufs.pseudoInverseMethod )
+    {
+        case JACOBI_SVD_PSEUDOINVERSE:
+            pseudoInverse(toEigen(A),
+                          toEigen(bufs.pinvA[subModelIndex]),
+                          tol);
+            break;
+        case COMPLETE_ORTHOGONAL_DECOMPOSITION_PSEUDOINVERSE:
+        {
+            PseudoInverseSolver & solver = bufs.pseudoInverseSolvers[subModelIndex];
+            solver.setTolerance(tol);
+            if( !solver.compute(toEigen(A)) ||
+                !solver.pseudoInverse(toEigen(bufs.pinvA[subModelIndex])) )
+            {
+                toEigen(bufs.pinvA[subModelIndex]).setConstant(std::numeric_limits<double>::quiet_NaN());
+            }
+        }
+            break;
+        default:
+            assert(false);
+            break;
+    }
+
+    decomposedA = A;
+    bufs.decomposedAMethod[subModelIndex] = bufs.pseudoInverseMethod;
+}
+
 void storeResultsOfEstimation(const Traversal& traversal,
                               const LinkUnknownWrenchContacts& unknownWrenches,
                               const size_t subModelIndex,
@@ -604,10 +662,8 @@ bool estimateExternalWrenchesWithoutInternalFT(const Model& model,
    // If A has no unkowns then pseudoInverse can not be computed
    // In that case, we do not compute the x vector because it will have zero elements 
    if (bufs.A[subModelIndex].rows() > 0 && bufs.A[subModelIndex].cols() > 0) {
-       // Now we compute the pseudo inverse
-       pseudoInverse(toEigen(bufs.A[subModelIndex]),
-                     toEigen(bufs.pinvA[subModelIndex]),
-                     tol);
+       // Now we compute the pseudo inverse (if A changed since the last call)
+       computePseudoInverseOfEstimationEquationMatrix(subModelIndex,tol,bufs);
 
        // Now we compute the unknowns
        toEigen(bufs.x[subModelIndex]) = toEigen(bufs.pinvA[subModelIndex])*toEigen(bufs.b[subModelIndex]);
@@ -622,6 +678,69 @@ bool estimateExternalWrenchesWithoutInternalFT(const Model& model,
 }
 
 
+/**
+ * Estimate the unknown wrenches of a single submodel.
+ *
+ * Each submodel only writes the buffers and the output contact wrenches
+ * of its own links, so different submodels can be estimated concurrently.
+ */
+bool estimateExternalWrenchesOfSubModel(const Model& model,
+                                        const SubModelDecomposition& subModels,
+                                        const SensorsList& sensors,
+                                        const LinkUnknownWrenchContacts& unknownWrenches,
+                                        const JointPosDoubleArray & jointPos,
+                                        const LinkVelArray& linkVel,
+                                        const LinkAccArray& linkProperAcc,
+                                        const SensorsMeasurements& ftSensorsMeasurements,
+                                        const size_t sm,
+                                              estimateExternalWrenchesBuffers& bufs,
+                                              LinkContactWrenches& outputContactWrenches)
+{
+    /**< value extracted from old iDynContact */
+    double tol = 1e-7;
+
+    // Number of unknowns for this submodel
+    const Traversal & subModelTraversal = subModels.getTraversal(sm);
+
+    // First compute the known term of the estimation for each link:
+    // this loop is similar to the dynamic phase of the RNEA
+    // \todo pimp up performance as done in RNEADynamicPhase
+    Wrench knownTerms = computeKnownTermsOfEstimationEquationWithInternalFT(model,subModelTraversal,
+                            sensors,jointPos,linkVel,linkProperAcc,ftSensorsMeasurements,bufs);
+
+    // Copy knownTerms in the buffers used for estimation
+    bufs.b[sm] = knownTerms.asVector();
+
+    // Now we compute the A matrix
+    computeMatrixOfEstimationEquationAndExtWrenchKnownTerms(model,subModelTraversal,unknownWrenches,jointPos,sm,bufs);
+
+    // If A has no unkowns then pseudoInverse can not be computed
+    // In that case, we do not compute the x vector because it will have zero elements 
+    if (bufs.A[sm].rows() > 0 && bufs.A[sm].cols() > 0) {
+        // Now we compute the pseudo inverse (if A changed since the last call)
+        computePseudoInverseOfEstimationEquationMatrix(sm,tol,bufs);
+
+        // Now we compute the unknowns
+        toEigen(bufs.x[sm]) = toEigen(bufs.pinvA[sm])*toEigen(bufs.b[sm]);
+    }
+
+    // Check if there are any nan in the estimation results
+    for(size_t i=0; i < bufs.x[sm].size(); i++)
+    {
+        if( std::isnan(bufs.x[sm](i)) )
+        {
+            return false;
+        }
+    }
+
+    // We copy the estimated unknowns in the outputContactWrenches
+    // Note that the logic of conversion between input/output contacts should be
+    // the same used before in computeMatrixOfEstimationEquation
+    storeResultsOfEstimation(subModelTraversal,unknownWrenches,sm,bufs,outputContactWrenches);
+
+    return true;
+}
+
 bool estimateExternalWrenches(const Model& model,
                               const SubModelDecomposition& subModels,
                               const SensorsList& sensors,
@@ -633,63 +752,53 @@ bool estimateExternalWrenches(const Model& model,
                                     estimateExternalWrenchesBuffers& bufs,
                                     LinkContactWrenches& outputContactWrenches)
 {
-    /**< value extracted from old iDynContact */
-    double tol = 1e-7;
-
     // Resize the output data structure
     outputContactWrenches.resize(model);
 
     // Solve the problem for each submodel
     for(size_t sm=0; sm < subModels.getNrOfSubModels(); sm++ )
     {
-        // Number of unknowns for this submodel
-        const Traversal & subModelTraversal = subModels.getTraversal(sm);
-
-        // First compute the known term of the estimation for each link:
-        // this loop is similar to the dynamic phase of the RNEA
-        // \todo pimp up performance as done in RNEADynamicPhase
-        Wrench knownTerms = computeKnownTermsOfEstimationEquationWithInternalFT(model,subModelTraversal,
-                                sensors,jointPos,linkVel,linkProperAcc,ftSensorsMeasurements,bufs);
-
-        // Copy knownTerms in the buffers used for estimation
-        bufs.b[sm] = knownTerms.asVector();
-
-        // Now we compute the A matrix
-        computeMatrixOfEstimationEquationAndExtWrenchKnownTerms(model,subModelTraversal,unknownWrenches,jointPos,sm,bufs);
-
-        // If A has no unkowns then pseudoInverse can not be computed
-        // In that case, we do not compute the x vector because it will have zero elements 
-        if (bufs.A[sm].rows() > 0 && bufs.A[sm].cols() > 0) {
-            // Now we compute the pseudo inverse
-            pseudoInverse(toEigen(bufs.A[sm]),
-                          toEigen(bufs.pinvA[sm]),
-                          tol);
-
-            // Now we compute the unknowns
-            toEigen(bufs.x[sm]) = toEigen(bufs.pinvA[sm])*toEigen(bufs.b[sm]);
-        }
-
-        // Check if there are any nan in the estimation results
-        bool someResultIsNan = false;
-        for(size_t i=0; i < bufs.x[sm].size(); i++)
+        if( !estimateExternalWrenchesOfSubModel(model,subModels,sensors,unknownWrenches,jointPos,linkVel,linkProperAcc,
+                                                ftSensorsMeasurements,sm,bufs,outputContactWrenches) )
         {
-            if( std::isnan(bufs.x[sm](i)) )
-            {
-                someResultIsNan = true;
-                break;
-            }
+            reportError("", "estimateExternalWrenches", "NaN found in estimation result, estimation failed");
+            return false;
         }
+    }
+
+    return true;
+}
 
-        if (someResultIsNan)
+bool estimateExternalWrenches(const Model& model,
+                              const SubModelDecomposition& subModels,
+                              const SensorsList& sensors,
+                              const LinkUnknownWrenchContacts& unknownWrenches,
+                              const JointPosDoubleArray & jointPos,
+                              const LinkVelArray& linkVel,
+                              const LinkAccArray& linkProperAcc,
+                              const SensorsMeasurements& ftSensorsMeasurements,
+                                    estimateExternalWrenchesBuffers& bufs,
+                                    LinkContactWrenches& outputContactWrenches,
+                                    ThreadPool& threadPool)
+{
+    // Resize the output data structure (before the parallel part, as it is shared among the submodels)
+    outputContactWrenches.resize(model);
+
+    // Solve the problem for each submodel in parallel
+    std::atomic<bool> someResultIsNan(false);
+    threadPool.parallelFor(subModels.getNrOfSubModels(), [&](size_t sm)
+    {
+        if( !estimateExternalWrenchesOfSubModel(model,subModels,sensors,unknownWrenches,jointPos,linkVel,linkProperAcc,
+                                                ftSensorsMeasurements,sm,bufs,outputContactWrenches) )
         {
-            reportError("", "estimateExternalWrenches", "NaN found in estimation result, estimation failed");
-            return false;
+            someResultIsNan = true;
         }
+    });
 
-        // We copy the estimated unknowns in the outputContactWrenches
-        // Note that the logic of conversion between input/output contacts should be
-        // the same used before in computeMatrixOfEstimationEquation
-        storeResultsOfEstimation(subModelTraversal,unknownWrenches,sm,bufs,outputContactWrenches);
+    if (someResultIsNan)
+    {
+        reportError("", "estimateExternalWrenches", "NaN found in estimation result, estimation failed");
+        return false;
     }
 
     return true;
@@ -0,0 +1,557 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/RecursiveInertialParametersEstimator.h>
+
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/InertiaNonLinearParametrization.h>
+#include <iDynTree/Core/SpatialInertia.h>
+#include <iDynTree/Core/Utils.h>
+#include <iDynTree/Core/VectorDynSize.h>
+
+#include <iDynTree/Model/ForwardKinematics.h>
+#include <iDynTree/Model/FreeFloatingState.h>
+#include <iDynTree/Model/LinkState.h>
+#include <iDynTree/Model/Model.h>
+#include <iDynTree/Model/Traversal.h>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace iDynTree
+{
+
+// When the accumulated forgetting scale falls below this value, it is folded in the information
+static const double MINIMUM_INFORMATION_SCALE = 1e-6;
+
+class RecursiveInertialParametersEstimator::RecursiveInertialParametersEstimatorPimpl
+{
+public:
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RegressorMatrix;
+
+    bool valid;
+
+    iDynTree::Model model;
+    iDynTree::Traversal traversal;
+
+    size_t nrOfParameters;
+    size_t nrOfMeasurements;
+
+    // Options
+    double forgettingFactor;
+    double priorWeight;
+    double minimumLinkMass;
+    Eigen::VectorXd priorParameters;
+    Eigen::VectorXd measurementsWeights;
+
+    /**
+     * For each row of the regressor, the links whose parameters have a nonzero regressor block:
+     * all the links for the base rows, the links in the subtree of the joint for the DOF rows.
+     */
+    std::vector<std::vector<LinkIndex> > rowLinks;
+
+    // The information is stored as informationScale*(informationMatrix, informationVector),
+    // so that the forgetting does not require to scale the whole matrix at each sample
+    Eigen::MatrixXd informationMatrix;
+    Eigen::VectorXd informationVector;
+    double informationScale;
+    size_t nrOfProcessedSamples;
+
+    // Buffers of the sample update
+    RegressorMatrix regressor;
+    Eigen::VectorXd generalizedForces;
+    iDynTree::FreeFloatingPos robotPos;
+    iDynTree::FreeFloatingVel robotVel;
+    iDynTree::FreeFloatingAcc robotAcc;
+    iDynTree::LinkPositions base_H_link;
+    iDynTree::LinkVelArray linksVel;
+    iDynTree::LinkAccArray linksProperAcc;
+
+    // Buffers of the estimate
+    Eigen::MatrixXd systemMatrix;
+    Eigen::VectorXd systemVector;
+    Eigen::LLT<Eigen::MatrixXd> systemDecomposition;
+    iDynTree::VectorDynSize unconstrainedParameters;
+    iDynTree::VectorDynSize estimatedParameters;
+
+    RecursiveInertialParametersEstimatorPimpl()
+    : valid(false)
+    , nrOfParameters(0)
+    , nrOfMeasurements(0)
+    , forgettingFactor(1.0)
+    , priorWeight(1e-3)
+    , minimumLinkMass(1e-3)
+    , informationScale(1.0)
+    , nrOfProcessedSamples(0)
+    {}
+
+    void computeRowLinks();
+    void computeRegressor();
+    void accumulateRegressor();
+    void projectOnPhysicallyConsistentParameters();
+};
+
+void RecursiveInertialParametersEstimator::RecursiveInertialParametersEstimatorPimpl::computeRowLinks()
+{
+    rowLinks.assign(nrOfMeasurements, std::vector<LinkIndex>());
+
+    for (TraversalIndex l = 0; l < static_cast<TraversalIndex>(traversal.getNrOfVisitedLinks()); l++)
+    {
+        LinkIndex lnkIdx = traversal.getLink(l)->getIndex();
+
+        for (size_t i = 0; i < 6; i++)
+        {
+            rowLinks[i].push_back(lnkIdx);
+        }
+
+        // The link affects the rows of the DOFs of the joints from itself to the base
+        LinkIndex visitedLinkIdx = lnkIdx;
+        while (visitedLinkIdx != traversal.getBaseLink()->getIndex())
+        {
+            IJointConstPtr joint = traversal.getParentJointFromLinkIndex(visitedLinkIdx);
+            for (unsigned int i = 0; i < joint->getNrOfDOFs(); i++)
+            {
+                rowLinks[6 + joint->getDOFsOffset() + i].push_back(lnkIdx);
+            }
+            visitedLinkIdx = traversal.getParentLinkFromLinkIndex(visitedLinkIdx)->getIndex();
+        }
+    }
+}
+
+void RecursiveInertialParametersEstimator::RecursiveInertialParametersEstimatorPimpl::computeRegressor()
+{
+    // Same computation of InverseDynamicsInertialParametersRegressor, but only the
+    // nonzero blocks are written and only fixed size temporaries are used
+    Eigen::Matrix<double, 6, 10> linkRegressor;
+    Eigen::Matrix<double, 6, 10> visitedLinkRegressor;
+
+    for (TraversalIndex l = 0; l < static_cast<TraversalIndex>(traversal.getNrOfVisitedLinks()); l++)
+    {
+        LinkIndex lnkIdx = traversal.getLink(l)->getIndex();
+
+        linkRegressor = toEigen(SpatialInertia::momentumDerivativeRegressor(linksVel(lnkIdx),
+                                                                            linksProperAcc(lnkIdx)));
+
+        // Base dynamics, expressed with the orientation of the base and with respect to the base origin
+        regressor.block<6, 10>(0, 10*lnkIdx).noalias() =
+            toEigen(base_H_link(lnkIdx).asAdjointTransformWrench())*linkRegressor;
+
+        LinkIndex visitedLinkIdx = lnkIdx;
+        while (visitedLinkIdx != traversal.getBaseLink()->getIndex())
+        {
+            LinkIndex parentLinkIdx = traversal.getParentLinkFromLinkIndex(visitedLinkIdx)->getIndex();
+            IJointConstPtr joint = traversal.getParentJointFromLinkIndex(visitedLinkIdx);
+
+            Transform visitedLink_H_link = base_H_link(visitedLinkIdx).inverse()*base_H_link(lnkIdx);
+            visitedLinkRegressor.noalias() = toEigen(visitedLink_H_link.asAdjointTransformWrench())*linkRegressor;
+
+            size_t dofOffset = joint->getDOFsOffset();
+            for (unsigned int i = 0; i < joint->getNrOfDOFs(); i++)
+            {
+                SpatialMotionVector S = joint->getMotionSubspaceVector(i, visitedLinkIdx, parentLinkIdx);
+                regressor.block<1, 10>(6 + dofOffset + i, 10*lnkIdx).noalias() =
+                    toEigen(S).transpose()*visitedLinkRegressor;
+            }
+
+            visitedLinkIdx = parentLinkIdx;
+        }
+    }
+}
+
+void RecursiveInertialParametersEstimator::RecursiveInertialParametersEstimatorPimpl::accumulateRegressor()
+{
+    informationScale *= forgettingFactor;
+
+    for (size_t row = 0; row < nrOfMeasurements; row++)
+    {
+        if (measurementsWeights(row) == 0.0)
+        {
+            continue;
+        }
+
+        // Scale the row so that its outer product is already weighted
+        const double rowScale = std::sqrt(measurementsWeights(row)/informationScale);
+        const double measurement = rowScale*generalizedForces(row);
+        const std::vector<LinkIndex>& links = rowLinks[row];
+
+        for (size_t a = 0; a < links.size(); a++)
+        {
+            regressor.block<1, 10>(row, 10*links[a]) *= rowScale;
+        }
+
+        for (size_t a = 0; a < links.size(); a++)
+        {
+            const Eigen::Index offsetA = 10*links[a];
+            informationVector.segment<10>(offsetA) += measurement*regressor.block<1, 10>(row, offsetA).transpose();
+
+            for (size_t b = 0; b < links.size(); b++)
+            {
+                const Eigen::Index offsetB = 10*links[b];
+                informationMatrix.block<10, 10>(offsetA, offsetB).noalias() +=
+                    regressor.block<1, 10>(row, offsetA).transpose()*regressor.block<1, 10>(row, offsetB);
+            }
+        }
+    }
+
+    if (informationScale < MINIMUM_INFORMATION_SCALE)
+    {
+        informationMatrix *= informationScale;
+        informationVector *= informationScale;
+        informationScale = 1.0;
+    }
+
+    nrOfProcessedSamples++;
+}
+
+void RecursiveInertialParametersEstimator::RecursiveInertialParametersEstimatorPimpl::projectOnPhysicallyConsistentParameters()
+{
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigenSolver;
+
+    for (size_t link = 0; link < model.getNrOfLinks(); link++)
+    {
+        const double* params = unconstrainedParameters.data() + 10*link;
+
+        RigidBodyInertiaNonLinearParametrization consistentParams;
+        consistentParams.mass = std::max(params[0], minimumLinkMass);
+
+        Eigen::Vector3d com(params[1], params[2], params[3]);
+        com /= consistentParams.mass;
+        toEigen(consistentParams.com) = com;
+
+        // Rotational inertia w.r.t. the link origin, and then w.r.t. the center of mass
+        Eigen::Matrix3d inertia;
+        inertia << params[4], params[5], params[6],
+                   params[5], params[7], params[8],
+                   params[6], params[8], params[9];
+        Eigen::Matrix3d comSkew;
+        comSkew <<     0.0, -com(2),  com(1),
+                    com(2),     0.0, -com(0),
+                   -com(1),  com(0),     0.0;
+        inertia += consistentParams.mass*comSkew*comSkew;
+
+        // Principal axes and central second moments of mass, clamped to be non-negative
+        eigenSolver.computeDirect(inertia);
+        Eigen::Matrix3d link_R_centroidal = eigenSolver.eigenvectors();
+        if (link_R_centroidal.determinant() < 0.0)
+        {
+            link_R_centroidal.col(2) *= -1.0;
+        }
+        toEigen(consistentParams.link_R_centroidal) = link_R_centroidal;
+
+        const Eigen::Vector3d& principalMoments = eigenSolver.eigenvalues();
+        const double halfTrace = 0.5*principalMoments.sum();
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            consistentParams.centralSecondMomentOfMass(i) = std::max(halfTrace - principalMoments(i), 0.0);
+        }
+
+        Vector10 consistentParamsVector = consistentParams.toRigidBodyInertia().asVector();
+        for (unsigned int i = 0; i < 10; i++)
+        {
+            estimatedParameters(10*link + i) = consistentParamsVector(i);
+        }
+    }
+}
+
+RecursiveInertialParametersEstimator::RecursiveInertialParametersEstimator()
+: m_pimpl(new RecursiveInertialParametersEstimatorPimpl())
+{
+}
+
+RecursiveInertialParametersEstimator::~RecursiveInertialParametersEstimator()
+{
+    assert(m_pimpl);
+    delete m_pimpl;
+    m_pimpl = 0;
+}
+
+bool RecursiveInertialParametersEstimator::setModel(const Model& model, const std::string& baseLink)
+{
+    m_pimpl->valid = false;
+    m_pimpl->model = model;
+
+    LinkIndex baseLinkIndex = m_pimpl->model.getDefaultBaseLink();
+    if (!baseLink.empty())
+    {
+        baseLinkIndex = m_pimpl->model.getLinkIndex(baseLink);
+        if (baseLinkIndex == LINK_INVALID_INDEX)
+        {
+            reportError("RecursiveInertialParametersEstimator", "setModel", ("Unknown base link " + baseLink).c_str());
+            return false;
+        }
+    }
+
+    if (!m_pimpl->model.computeFullTreeTraversal(m_pimpl->traversal, baseLinkIndex))
+    {
+        reportError("RecursiveInertialParametersEstimator", "setModel", "Error in computing the traversal of the model");
+        return false;
+    }
+
+    m_pimpl->nrOfParameters = 10*m_pimpl->model.getNrOfLinks();
+    m_pimpl->nrOfMeasurements = 6 + m_pimpl->model.getNrOfDOFs();
+
+    m_pimpl->computeRowLinks();
+
+    // Prior
+    iDynTree::VectorDynSize modelParameters;
+    m_pimpl->model.getInertialParameters(modelParameters);
+    m_pimpl->priorParameters = toEigen(modelParameters);
+    m_pimpl->measurementsWeights.setOnes(m_pimpl->nrOfMeasurements);
+
+    // Buffers
+    m_pimpl->informationMatrix.resize(m_pimpl->nrOfParameters, m_pimpl->nrOfParameters);
+    m_pimpl->informationVector.resize(m_pimpl->nrOfParameters);
+    m_pimpl->regressor.setZero(m_pimpl->nrOfMeasurements, m_pimpl->nrOfParameters);
+    m_pimpl->generalizedForces.resize(m_pimpl->nrOfMeasurements);
+    m_pimpl->robotPos.resize(m_pimpl->model);
+    m_pimpl->robotPos.worldBasePos() = Transform::Identity();
+    m_pimpl->robotVel.resize(m_pimpl->model);
+    m_pimpl->robotAcc.resize(m_pimpl->model);
+    m_pimpl->base_H_link.resize(m_pimpl->model);
+    m_pimpl->linksVel.resize(m_pimpl->model);
+    m_pimpl->linksProperAcc.resize(m_pimpl->model);
+    m_pimpl->systemMatrix.resize(m_pimpl->nrOfParameters, m_pimpl->nrOfParameters);
+    m_pimpl->systemVector.resize(m_pimpl->nrOfParameters);
+    m_pimpl->systemDecomposition = Eigen::LLT<Eigen::MatrixXd>(m_pimpl->nrOfParameters);
+    m_pimpl->unconstrainedParameters.resize(m_pimpl->nrOfParameters);
+    m_pimpl->estimatedParameters.resize(m_pimpl->nrOfParameters);
+
+    m_pimpl->valid = true;
+    reset();
+    return true;
+}
+
+bool RecursiveInertialParametersEstimator::isValid() const
+{
+    return m_pimpl->valid;
+}
+
+size_t RecursiveInertialParametersEstimator::getNrOfInertialParameters() const
+{
+    return m_pimpl->nrOfParameters;
+}
+
+size_t RecursiveInertialParametersEstimator::getNrOfMeasurements() const
+{
+    return m_pimpl->nrOfMeasurements;
+}
+
+bool RecursiveInertialParametersEstimator::setForgettingFactor(const double forgettingFactor)
+{
+    if (forgettingFactor <= 0.0 || forgettingFactor > 1.0)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setForgettingFactor", "The forgetting factor should be in (0, 1]");
+        return false;
+    }
+
+    m_pimpl->forgettingFactor = forgettingFactor;
+    return true;
+}
+
+double RecursiveInertialParametersEstimator::getForgettingFactor() const
+{
+    return m_pimpl->forgettingFactor;
+}
+
+bool RecursiveInertialParametersEstimator::setPriorWeight(const double priorWeight)
+{
+    if (priorWeight < 0.0)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setPriorWeight", "The prior weight should be non-negative");
+        return false;
+    }
+
+    m_pimpl->priorWeight = priorWeight;
+    return true;
+}
+
+bool RecursiveInertialParametersEstimator::setPriorInertialParameters(const VectorDynSize& priorParameters)
+{
+    if (!m_pimpl->valid)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setPriorInertialParameters", "Model not set");
+        return false;
+    }
+
+    if (priorParameters.size() != m_pimpl->nrOfParameters)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setPriorInertialParameters", "Wrong size of the prior parameters");
+        return false;
+    }
+
+    m_pimpl->priorParameters = toEigen(priorParameters);
+    return true;
+}
+
+bool RecursiveInertialParametersEstimator::setMeasurementsWeights(const VectorDynSize& weights)
+{
+    if (!m_pimpl->valid)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setMeasurementsWeights", "Model not set");
+        return false;
+    }
+
+    if (weights.size() != m_pimpl->nrOfMeasurements)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setMeasurementsWeights", "Wrong size of the weights");
+        return false;
+    }
+
+    if (toEigen(weights).minCoeff() < 0.0)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setMeasurementsWeights", "The weights should be non-negative");
+        return false;
+    }
+
+    m_pimpl->measurementsWeights = toEigen(weights);
+    return true;
+}
+
+bool RecursiveInertialParametersEstimator::setMinimumLinkMass(const double minimumLinkMass)
+{
+    if (minimumLinkMass <= 0.0)
+    {
+        reportError("RecursiveInertialParametersEstimator", "setMinimumLinkMass", "The minimum link mass should be positive");
+        return false;
+    }
+
+    m_pimpl->minimumLinkMass = minimumLinkMass;
+    return true;
+}
+
+void RecursiveInertialParametersEstimator::reset()
+{
+    m_pimpl->informationMatrix.setZero();
+    m_pimpl->informationVector.setZero();
+    m_pimpl->informationScale = 1.0;
+    m_pimpl->nrOfProcessedSamples = 0;
+
+    toEigen(m_pimpl->unconstrainedParameters) = m_pimpl->priorParameters;
+    toEigen(m_pimpl->estimatedParameters) = m_pimpl->priorParameters;
+}
+
+bool RecursiveInertialParametersEstimator::update(const JointPosDoubleArray& jointPos,
+                                                  const Twist& baseVel,
+                                                  const JointDOFsDoubleArray& jointVel,
+                                                  const SpatialAcc& baseProperAcc,
+                                                  const JointDOFsDoubleArray& jointAcc,
+                                                  const FreeFloatingGeneralizedTorques& measuredGeneralizedForces)
+{
+    if (!m_pimpl->valid)
+    {
+        reportError("RecursiveInertialParametersEstimator", "update", "Model not set");
+        return false;
+    }
+
+    const Model& model = m_pimpl->model;
+    if (jointPos.size() != model.getNrOfPosCoords()
+        || jointVel.size() != model.getNrOfDOFs()
+        || jointAcc.size() != model.getNrOfDOFs()
+        || measuredGeneralizedForces.jointTorques().size() != model.getNrOfDOFs())
+    {
+        reportError("RecursiveInertialParametersEstimator", "update", "Input size not consistent with the model");
+        return false;
+    }
+
+    m_pimpl->robotPos.jointPos() = jointPos;
+    m_pimpl->robotVel.baseVel() = baseVel;
+    m_pimpl->robotVel.jointVel() = jointVel;
+    m_pimpl->robotAcc.baseAcc() = baseProperAcc;
+    m_pimpl->robotAcc.jointAcc() = jointAcc;
+
+    bool ok = ForwardPositionKinematics(model, m_pimpl->traversal, m_pimpl->robotPos, m_pimpl->base_H_link);
+    ok = ok && ForwardVelAccKinematics(model, m_pimpl->traversal, m_pimpl->robotPos, m_pimpl->robotVel, m_pimpl->robotAcc,
+                                       m_pimpl->linksVel, m_pimpl->linksProperAcc);
+    if (!ok)
+    {
+        reportError("RecursiveInertialParametersEstimator", "update", "Error in computing the kinematics");
+        return false;
+    }
+
+    m_pimpl->computeRegressor();
+
+    m_pimpl->generalizedForces.head<6>() = toEigen(measuredGeneralizedForces.baseWrench());
+    m_pimpl->generalizedForces.tail(model.getNrOfDOFs()) = toEigen(measuredGeneralizedForces.jointTorques());
+
+    m_pimpl->accumulateRegressor();
+    return true;
+}
+
+bool RecursiveInertialParametersEstimator::updateWithRegressor(MatrixView<const double> regressor,
+                                                               Span<const double> measuredGeneralizedForces)
+{
+    if (!m_pimpl->valid)
+    {
+        reportError("RecursiveInertialParametersEstimator", "updateWithRegressor", "Model not set");
+        return false;
+    }
+
+    if (static_cast<size_t>(regressor.rows()) != m_pimpl->nrOfMeasurements
+        || static_cast<size_t>(regressor.cols()) != m_pimpl->nrOfParameters
+        || static_cast<size_t>(measuredGeneralizedForces.size()) != m_pimpl->nrOfMeasurements)
+    {
+        reportError("RecursiveInertialParametersEstimator", "updateWithRegressor", "Input size not consistent with the model");
+        return false;
+    }
+
+    m_pimpl->regressor = toEigen(regressor);
+    m_pimpl->generalizedForces = toEigen(measuredGeneralizedForces);
+
+    m_pimpl->accumulateRegressor();
+    return true;
+}
+
+size_t RecursiveInertialParametersEstimator::getNrOfProcessedSamples() const
+{
+    return m_pimpl->nrOfProcessedSamples;
+}
+
+bool RecursiveInertialParametersEstimator::computeEstimate()
+{
+    if (!m_pimpl->valid)
+    {
+        reportError("RecursiveInertialParametersEstimator", "computeEstimate", "Model not set");
+        return false;
+    }
+
+    m_pimpl->systemMatrix = m_pimpl->informationScale*m_pimpl->informationMatrix;
+    m_pimpl->systemMatrix.diagonal().array() += m_pimpl->priorWeight;
+    m_pimpl->systemVector = m_pimpl->informationScale*m_pimpl->informationVector
+                            + m_pimpl->priorWeight*m_pimpl->priorParameters;
+
+    m_pimpl->systemDecomposition.compute(m_pimpl->systemMatrix);
+    if (m_pimpl->systemDecomposition.info() != Eigen::Success)
+    {
+        reportError("RecursiveInertialParametersEstimator", "computeEstimate",
+                    "The information matrix is singular, increase the prior weight or process more samples");
+        return false;
+    }
+
+    toEigen(m_pimpl->unconstrainedParameters) = m_pimpl->systemDecomposition.solve(m_pimpl->systemVector);
+
+    m_pimpl->projectOnPhysicallyConsistentParameters();
+    return true;
+}
+
+const VectorDynSize& RecursiveInertialParametersEstimator::getEstimatedInertialParameters() const
+{
+    return m_pimpl->estimatedParameters;
+}
+
+const VectorDynSize& RecursiveInertialParametersEstimator::getUnconstrainedInertialParameters() const
+{
+    return m_pimpl->unconstrainedParameters;
+}
+
+}
@@ -19,6 +19,7 @@
 
 #include <iDynTree/ModelIO/ModelLoader.h>
 
+#include <algorithm>
 #include <sstream>
 
 namespace iDynTree
@@ -30,7 +31,8 @@ SimpleLeggedOdometry::SimpleLeggedOdometry(): m_model(),
                                               m_kinematicsUpdated(false),
                                               m_isOdometryInitialized(false),
                                               m_fixedLinkIndex(iDynTree::LINK_INVALID_INDEX),
-                                              m_world_H_fixedLink(Transform::Identity())
+                                              m_world_H_fixedLink(Transform::Identity()),
+                                              m_usePartialForwardKinematics(false)
 {
 }
 
@@ -71,6 +73,7 @@ bool SimpleLeggedOdometry::init(const FrameIndex initialFixedFrameIndex,
     Transform initalFixedFrame_H_fixedLink =  m_model.getFrameTransform(initialFixedFrameIndex).inverse();
 
     m_world_H_fixedLink = world_H_initialFixedFrame*initalFixedFrame_H_fixedLink;
+    updateFixedLinkPath();
 
     m_isOdometryInitialized = true;
 
@@ -118,11 +121,12 @@ bool SimpleLeggedOdometry::init(const FrameIndex initialFixedFrameIndex,
 
     m_fixedLinkIndex = m_model.getFrameLink(initialFixedFrameIndex);
     LinkIndex linkAttachedToWorldIndex = m_model.getFrameLink(initalReferenceFrameIndexForWorld);
+    updateFixedLinkPath();
 
     Transform world_H_initialReferenceFrame = initialReferenceFrame_H_world.inverse();
     Transform initalReferenceFrame_H_linkAttachedToWorld =  m_model.getFrameTransform(initalReferenceFrameIndexForWorld).inverse();
-    Transform linkAttachedToWorld_H_floatingBase = m_base_H_link(linkAttachedToWorldIndex).inverse();
-    Transform floatingBase_H_fixedLink           = m_base_H_link(m_fixedLinkIndex);
+    Transform linkAttachedToWorld_H_floatingBase = getBase_H_link(linkAttachedToWorldIndex).inverse();
+    Transform floatingBase_H_fixedLink           = getBase_H_link(m_fixedLinkIndex);
 
     m_world_H_fixedLink = world_H_initialReferenceFrame*initalReferenceFrame_H_linkAttachedToWorld*linkAttachedToWorld_H_floatingBase*floatingBase_H_fixedLink;
 
@@ -147,13 +151,110 @@ bool SimpleLeggedOdometry::updateKinematics(JointPosDoubleArray& jointPos)
         return false;
     }
 
-    bool ok = ForwardPositionKinematics(m_model,m_traversal,
-                                        Transform::Identity(),jointPos,
-                                        m_base_H_link);
+    // The joint positions are also used by getBase_H_link to compute on request
+    // the links that are not on the fixed link path, so they are copied in the
+    // buffer allocated by setModel
+    if( m_jointPos.size() != jointPos.size() )
+    {
+        reportError("SimpleLeggedOdometry",
+                    "updateKinematics","error in size of input jointPos");
+        return false;
+    }
+    std::copy(jointPos.data(), jointPos.data() + jointPos.size(), m_jointPos.data());
+
+    if( !m_usePartialForwardKinematics )
+    {
+        bool ok = ForwardPositionKinematics(m_model,m_traversal,
+                                            Transform::Identity(),jointPos,
+                                            m_base_H_link);
+        std::fill(m_isLinkPoseUpdated.begin(), m_isLinkPoseUpdated.end(), ok);
+        m_kinematicsUpdated = ok;
+
+        return ok;
+    }
 
-    m_kinematicsUpdated = ok;
+    // Only evaluate the joints between the base and the fixed link,
+    // the other links are computed by getBase_H_link when requested
+    std::fill(m_isLinkPoseUpdated.begin(), m_isLinkPoseUpdated.end(), 0);
+
+    LinkIndex baseLink = m_traversal.getBaseLink()->getIndex();
+    m_base_H_link(baseLink) = Transform::Identity();
+    m_isLinkPoseUpdated[baseLink] = 1;
+
+    for(size_t i=0; i < m_fixedLinkPath.size(); i++)
+    {
+        LinkIndex visitedLink = m_fixedLinkPath[i];
+        LinkIndex parentLink = m_traversal.getParentLinkFromLinkIndex(visitedLink)->getIndex();
+        IJointConstPtr toParentJoint = m_traversal.getParentJointFromLinkIndex(visitedLink);
+
+        m_base_H_link(visitedLink) = m_base_H_link(parentLink)*toParentJoint->getTransform(m_jointPos,parentLink,visitedLink);
+        m_isLinkPoseUpdated[visitedLink] = 1;
+    }
+
+    m_kinematicsUpdated = true;
+
+    return true;
+}
+
+void SimpleLeggedOdometry::setUsePartialForwardKinematics(const bool usePartialForwardKinematics)
+{
+    m_usePartialForwardKinematics = usePartialForwardKinematics;
+}
+
+bool SimpleLeggedOdometry::usePartialForwardKinematics() const
+{
+    return m_usePartialForwardKinematics;
+}
+
+void SimpleLeggedOdometry::updateFixedLinkPath()
+{
+    m_fixedLinkPath.clear();
+
+    if( !m_model.isValidLinkIndex(m_fixedLinkIndex) )
+    {
+        return;
+    }
+
+    // Walk from the fixed link to the base, and then reverse the path
+    // so that each link is visited after its parent
+    LinkIndex link = m_fixedLinkIndex;
+    while( m_traversal.getParentLinkFromLinkIndex(link) != 0 )
+    {
+        m_fixedLinkPath.push_back(link);
+        link = m_traversal.getParentLinkFromLinkIndex(link)->getIndex();
+    }
+
+    std::reverse(m_fixedLinkPath.begin(), m_fixedLinkPath.end());
+}
+
+const Transform& SimpleLeggedOdometry::getBase_H_link(const LinkIndex link)
+{
+    if( m_isLinkPoseUpdated[link] )
+    {
+        return m_base_H_link(link);
+    }
+
+    // Walk towards the base until a link whose pose is already updated,
+    // then compute the poses of the visited links starting from the closest to the base
+    m_linkPathBuffer.clear();
+    LinkIndex visitedLink = link;
+    while( !m_isLinkPoseUpdated[visitedLink] )
+    {
+        m_linkPathBuffer.push_back(visitedLink);
+        visitedLink = m_traversal.getParentLinkFromLinkIndex(visitedLink)->getIndex();
+    }
+
+    for(size_t i=m_linkPathBuffer.size(); i > 0; i--)
+    {
+        LinkIndex childLink = m_linkPathBuffer[i-1];
+        LinkIndex parentLink = m_traversal.getParentLinkFromLinkIndex(childLink)->getIndex();
+        IJointConstPtr toParentJoint = m_traversal.getParentJointFromLinkIndex(childLink);
+
+        m_base_H_link(childLink) = m_base_H_link(parentLink)*toParentJoint->getTransform(m_jointPos,parentLink,childLink);
+        m_isLinkPoseUpdated[childLink] = 1;
+    }
 
-    return ok;
+    return m_base_H_link(link);
 }
 
 
@@ -178,6 +279,11 @@ bool SimpleLeggedOdometry::setModel(const Model& _model)
 
     // Resize the linkPositions
     m_base_H_link.resize(m_model);
+    m_isLinkPoseUpdated.assign(m_model.getNrOfLinks(), 0);
+    m_jointPos.resize(m_model);
+    m_fixedLinkIndex = LINK_INVALID_INDEX;
+    m_fixedLinkPath.clear();
+    m_linkPathBuffer.reserve(m_model.getNrOfLinks());
 
     return true;
 }
@@ -219,10 +325,11 @@ bool SimpleLeggedOdometry::changeFixedFrame(const FrameIndex newFixedFrame)
 
     Transform world_H_oldFixed = this->m_world_H_fixedLink;
     LinkIndex oldFixedLink = m_fixedLinkIndex;
-    Transform oldFixed_H_newFixed = m_base_H_link(oldFixedLink).inverse()*m_base_H_link(newFixedLink);
+    Transform oldFixed_H_newFixed = getBase_H_link(oldFixedLink).inverse()*getBase_H_link(newFixedLink);
     Transform world_H_newFixed = world_H_oldFixed*oldFixed_H_newFixed;
     this->m_world_H_fixedLink = world_H_newFixed;
     this->m_fixedLinkIndex = newFixedLink;
+    updateFixedLinkPath();
 
     return true;
 }
@@ -250,6 +357,7 @@ bool SimpleLeggedOdometry::changeFixedFrame(const FrameIndex newFixedFrame, cons
     Transform newFixedFrame_H_newFixedLink = m_model.getFrameTransform(newFixedFrame).inverse();
     this->m_world_H_fixedLink = world_H_newFixedFrame * newFixedFrame_H_newFixedLink;
     this->m_fixedLinkIndex = newFixedLink;
+    updateFixedLinkPath();
 
     return true;
 }
@@ -303,8 +411,8 @@ Transform SimpleLeggedOdometry::getWorldLinkTransform(const LinkIndex link_index
     }
 
     assert(m_fixedLinkIndex < static_cast<LinkIndex>(m_base_H_link.getNrOfLinks()));
-    Transform base_H_fixed = m_base_H_link(m_fixedLinkIndex);
-    Transform base_H_link =  m_base_H_link(link_index);
+    Transform base_H_fixed = getBase_H_link(m_fixedLinkIndex);
+    Transform base_H_link =  getBase_H_link(link_index);
 
     return m_world_H_fixedLink*base_H_fixed.inverse()*base_H_link;
 }
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/SkinTaxelPatches.h>
+#include <iDynTree/Estimation/ExternalWrenchesEstimation.h>
+
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Utils.h>
+
+#include <Eigen/Dense>
+
+#include <sstream>
+
+namespace iDynTree
+{
+
+namespace
+{
+    const size_t nrOfTaxelPlanes = 9;
+
+    typedef Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > ConstTaxelPlanesMap;
+
+    // Block of the planes of a patch: rows 0-2 are the normals, 3-5 the moments, 6-8 the positions
+    ConstTaxelPlanesMap patchPlanes(const std::vector<double>& taxelPlanes,
+                                    const size_t taxelsOffset,
+                                    const size_t nrOfTaxels)
+    {
+        return ConstTaxelPlanesMap(taxelPlanes.data() + nrOfTaxelPlanes*taxelsOffset,
+                                   nrOfTaxelPlanes, nrOfTaxels);
+    }
+}
+
+SkinTaxelPatches::SkinTaxelPatches(): m_patchOffsets(1, 0)
+{
+}
+
+bool SkinTaxelPatches::init(const Model& model)
+{
+    m_model = model;
+    m_patchLinks.clear();
+    m_patchContactIds.clear();
+    m_patchOffsets.assign(1, 0);
+    m_contactIdToPatch.clear();
+    m_taxelPlanes.clear();
+    m_activeForces.clear();
+
+    return true;
+}
+
+bool SkinTaxelPatches::addPatch(const std::string& frameName,
+                                MatrixView<const double> taxelPositions,
+                                MatrixView<const double> taxelNormals,
+                                const unsigned long contactId)
+{
+    FrameIndex frameIndex = m_model.getFrameIndex(frameName);
+    if (frameIndex == FRAME_INVALID_INDEX)
+    {
+        std::stringstream ss;
+        ss << "Frame " << frameName << " not found in the model.";
+        reportError("SkinTaxelPatches", "addPatch", ss.str().c_str());
+        return false;
+    }
+
+    if (taxelPositions.cols() != 3 || taxelNormals.cols() != 3
+        || taxelPositions.rows() != taxelNormals.rows())
+    {
+        reportError("SkinTaxelPatches", "addPatch",
+                    "The taxel positions and normals should be matrices with the same number of rows and 3 columns.");
+        return false;
+    }
+
+    if (m_contactIdToPatch.find(contactId) != m_contactIdToPatch.end())
+    {
+        std::stringstream ss;
+        ss << "A patch with contact id " << contactId << " already exists.";
+        reportError("SkinTaxelPatches", "addPatch", ss.str().c_str());
+        return false;
+    }
+
+    const size_t nrOfTaxels = taxelPositions.rows();
+    Eigen::Matrix<double, Eigen::Dynamic, 3> normals(nrOfTaxels, 3);
+    for (size_t taxel = 0; taxel < nrOfTaxels; taxel++)
+    {
+        Eigen::Vector3d normal(taxelNormals(taxel, 0), taxelNormals(taxel, 1), taxelNormals(taxel, 2));
+        double norm = normal.norm();
+        if (norm <= 0.0)
+        {
+            std::stringstream ss;
+            ss << "The normal of taxel " << taxel << " is zero.";
+            reportError("SkinTaxelPatches", "addPatch", ss.str().c_str());
+            return false;
+        }
+        normals.row(taxel) = normal.transpose()/norm;
+    }
+
+    // Express the taxels in the link frame, and precompute the moments of the normals
+    // around the link origin, so that the wrench of a patch is a single matrix-vector product
+    const Transform link_H_frame = m_model.getFrameTransform(frameIndex);
+    const Eigen::Matrix3d link_R_frame = toEigen(link_H_frame.getRotation());
+    const Eigen::Vector3d link_p_frame = toEigen(link_H_frame.getPosition());
+
+    const size_t taxelsOffset = m_patchOffsets.back();
+    m_taxelPlanes.resize(nrOfTaxelPlanes*(taxelsOffset + nrOfTaxels));
+    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> >
+        planes(m_taxelPlanes.data() + nrOfTaxelPlanes*taxelsOffset, nrOfTaxelPlanes, nrOfTaxels);
+
+    for (size_t taxel = 0; taxel < nrOfTaxels; taxel++)
+    {
+        Eigen::Vector3d position(taxelPositions(taxel, 0), taxelPositions(taxel, 1), taxelPositions(taxel, 2));
+        Eigen::Vector3d link_position = link_R_frame*position + link_p_frame;
+        Eigen::Vector3d link_normal = link_R_frame*normals.row(taxel).transpose();
+
+        planes.block<3, 1>(0, taxel) = link_normal;
+        planes.block<3, 1>(3, taxel) = link_position.cross(link_normal);
+        planes.block<3, 1>(6, taxel) = link_position;
+    }
+
+    m_patchLinks.push_back(m_model.getFrameLink(frameIndex));
+    m_patchContactIds.push_back(contactId);
+    m_patchOffsets.push_back(taxelsOffset + nrOfTaxels);
+    m_contactIdToPatch[contactId] = m_patchLinks.size() - 1;
+    m_activeForces.resize(taxelsOffset + nrOfTaxels);
+
+    return true;
+}
+
+size_t SkinTaxelPatches::getNrOfPatches() const
+{
+    return m_patchLinks.size();
+}
+
+size_t SkinTaxelPatches::getNrOfTaxels() const
+{
+    return m_patchOffsets.back();
+}
+
+bool SkinTaxelPatches::isValidPatch(const size_t patchIndex, const char* methodName) const
+{
+    if (patchIndex >= m_patchLinks.size())
+    {
+        std::stringstream ss;
+        ss << "Patch index " << patchIndex << " is out of bounds, the number of patches is " << m_patchLinks.size() << ".";
+        reportError("SkinTaxelPatches", methodName, ss.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+size_t SkinTaxelPatches::getNrOfTaxelsOfPatch(const size_t patchIndex) const
+{
+    if (!isValidPatch(patchIndex, "getNrOfTaxelsOfPatch"))
+    {
+        return 0;
+    }
+    return m_patchOffsets[patchIndex + 1] - m_patchOffsets[patchIndex];
+}
+
+size_t SkinTaxelPatches::getTaxelsOffsetOfPatch(const size_t patchIndex) const
+{
+    if (!isValidPatch(patchIndex, "getTaxelsOffsetOfPatch"))
+    {
+        return 0;
+    }
+    return m_patchOffsets[patchIndex];
+}
+
+LinkIndex SkinTaxelPatches::getLinkOfPatch(const size_t patchIndex) const
+{
+    if (!isValidPatch(patchIndex, "getLinkOfPatch"))
+    {
+        return LINK_INVALID_INDEX;
+    }
+    return m_patchLinks[patchIndex];
+}
+
+unsigned long SkinTaxelPatches::getContactIdOfPatch(const size_t patchIndex) const
+{
+    if (!isValidPatch(patchIndex, "getContactIdOfPatch"))
+    {
+        return 0;
+    }
+    return m_patchContactIds[patchIndex];
+}
+
+bool SkinTaxelPatches::getPatchIndex(const unsigned long contactId, size_t& patchIndex) const
+{
+    std::unordered_map<unsigned long, size_t>::const_iterator it = m_contactIdToPatch.find(contactId);
+    if (it == m_contactIdToPatch.end())
+    {
+        return false;
+    }
+    patchIndex = it->second;
+    return true;
+}
+
+bool SkinTaxelPatches::checkTaxelForcesSize(Span<const double> taxelForces, const char* methodName) const
+{
+    if (static_cast<size_t>(taxelForces.size()) != getNrOfTaxels())
+    {
+        std::stringstream ss;
+        ss << "The size of the taxel forces is " << taxelForces.size() << ", expected " << getNrOfTaxels() << ".";
+        reportError("SkinTaxelPatches", methodName, ss.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SkinTaxelPatches::computePatchesWrenches(Span<const double> taxelForces,
+                                              MatrixView<double> patchesWrenches) const
+{
+    if (!checkTaxelForcesSize(taxelForces, "computePatchesWrenches"))
+    {
+        return false;
+    }
+
+    if (static_cast<size_t>(patchesWrenches.rows()) != getNrOfPatches() || patchesWrenches.cols() != 6)
+    {
+        reportError("SkinTaxelPatches", "computePatchesWrenches",
+                    "The patches wrenches should be a matrix with a row for each patch and 6 columns.");
+        return false;
+    }
+
+    Eigen::Matrix<double, 6, 1> wrench;
+    for (size_t patch = 0; patch < getNrOfPatches(); patch++)
+    {
+        const size_t offset = m_patchOffsets[patch];
+        const size_t nrOfTaxels = m_patchOffsets[patch + 1] - offset;
+        Eigen::Map<const Eigen::VectorXd> forces(taxelForces.data() + offset, nrOfTaxels);
+
+        wrench.noalias() = -patchPlanes(m_taxelPlanes, offset, nrOfTaxels).topRows<6>()*forces;
+
+        for (size_t i = 0; i < 6; i++)
+        {
+            patchesWrenches(patch, i) = wrench(i);
+        }
+    }
+
+    return true;
+}
+
+bool SkinTaxelPatches::computeLinkNetExternalWrenches(Span<const double> taxelForces,
+                                                      LinkNetExternalWrenches& netWrenches) const
+{
+    if (!checkTaxelForcesSize(taxelForces, "computeLinkNetExternalWrenches"))
+    {
+        return false;
+    }
+
+    if (netWrenches.getNrOfLinks() != m_model.getNrOfLinks())
+    {
+        netWrenches.resize(m_model);
+    }
+    netWrenches.zero();
+
+    Eigen::Matrix<double, 6, 1> wrench;
+    for (size_t patch = 0; patch < getNrOfPatches(); patch++)
+    {
+        const size_t offset = m_patchOffsets[patch];
+        const size_t nrOfTaxels = m_patchOffsets[patch + 1] - offset;
+        Eigen::Map<const Eigen::VectorXd> forces(taxelForces.data() + offset, nrOfTaxels);
+
+        wrench.noalias() = -patchPlanes(m_taxelPlanes, offset, nrOfTaxels).topRows<6>()*forces;
+
+        Wrench& linkWrench = netWrenches(m_patchLinks[patch]);
+        toEigen(linkWrench.getLinearVec3()) += wrench.head<3>();
+        toEigen(linkWrench.getAngularVec3()) += wrench.tail<3>();
+    }
+
+    return true;
+}
+
+bool SkinTaxelPatches::computeUnknownWrenchContacts(Span<const double> taxelForces,
+                                                    const double activationThreshold,
+                                                    LinkUnknownWrenchContacts& unknowns)
+{
+    if (!checkTaxelForcesSize(taxelForces, "computeUnknownWrenchContacts"))
+    {
+        return false;
+    }
+
+    Eigen::Map<const Eigen::VectorXd> allForces(taxelForces.data(), taxelForces.size());
+    Eigen::Map<Eigen::VectorXd> allActiveForces(m_activeForces.data(), m_activeForces.size());
+    allActiveForces = (allForces.array() > activationThreshold).select(allForces, 0.0);
+
+    UnknownWrenchContact unknownWrench;
+    Eigen::Vector3d normalsSum, positionsSum;
+    for (size_t patch = 0; patch < getNrOfPatches(); patch++)
+    {
+        const size_t offset = m_patchOffsets[patch];
+        const size_t nrOfTaxels = m_patchOffsets[patch + 1] - offset;
+        Eigen::Map<const Eigen::VectorXd> activeForces(m_activeForces.data() + offset, nrOfTaxels);
+
+        const double totalForce = activeForces.sum();
+        if (totalForce <= 0.0)
+        {
+            continue;
+        }
+
+        ConstTaxelPlanesMap planes = patchPlanes(m_taxelPlanes, offset, nrOfTaxels);
+        normalsSum.noalias() = planes.topRows<3>()*activeForces;
+        positionsSum.noalias() = planes.bottomRows<3>()*activeForces;
+
+        toEigen(unknownWrench.contactPoint) = positionsSum/totalForce;
+
+        const double normalsSumNorm = normalsSum.norm();
+        if (normalsSumNorm > totalForce*1e-6)
+        {
+            unknownWrench.unknownType = PURE_FORCE_WITH_KNOWN_DIRECTION;
+            toEigen(unknownWrench.forceDirection) = -normalsSum/normalsSumNorm;
+        }
+        else
+        {
+            unknownWrench.unknownType = PURE_FORCE;
+            unknownWrench.forceDirection = Direction::Default();
+        }
+        unknownWrench.contactId = m_patchContactIds[patch];
+
+        unknowns.addNewContactForLink(m_patchLinks[patch], unknownWrench);
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/AttitudeEstimatorBatch.h>
+#include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Core/VectorDynSize.h>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace iDynTree;
+
+const size_t nrOfIMUs = 7;
+const size_t nrOfTicks = 50;
+
+void getRandomMeasurements(VectorDynSize& acc, VectorDynSize& gyro, VectorDynSize& mag)
+{
+    for (size_t imu = 0; imu < nrOfIMUs; imu++)
+    {
+        for (size_t i = 0; i < 3; i++)
+        {
+            acc(3*imu + i) = getRandomDouble(-1.0, 1.0);
+            gyro(3*imu + i) = getRandomDouble(-0.5, 0.5);
+            mag(3*imu + i) = getRandomDouble(-1.0, 1.0);
+        }
+        acc(3*imu + 2) -= 9.81;
+        mag(3*imu + 2) += 1.0;
+    }
+}
+
+void checkBatchAgainstSingleFilters(AttitudeEstimatorBatch& batch,
+                                    std::vector<std::unique_ptr<IAttitudeEstimator>>& filters,
+                                    bool useMagnetometer)
+{
+    std::vector<double> initialOrientations(4*nrOfIMUs);
+    for (size_t imu = 0; imu < nrOfIMUs; imu++)
+    {
+        UnitQuaternion q = getRandomRotation().asQuaternion();
+        for (size_t i = 0; i < 4; i++)
+        {
+            initialOrientations[4*imu + i] = q(i);
+        }
+        Span<double> qSpan(q.data(), q.size());
+        ASSERT_IS_TRUE(filters[imu]->setInternalStateInitialOrientation(qSpan));
+    }
+    ASSERT_IS_TRUE(batch.setInternalStateInitialOrientations(MatrixView<const double>(initialOrientations.data(), nrOfIMUs, 4)));
+
+    VectorDynSize acc(3*nrOfIMUs), gyro(3*nrOfIMUs), mag(3*nrOfIMUs);
+    for (size_t tick = 0; tick < nrOfTicks; tick++)
+    {
+        getRandomMeasurements(acc, gyro, mag);
+
+        ASSERT_IS_TRUE(batch.propagateStates());
+        if (useMagnetometer)
+        {
+            ASSERT_IS_TRUE(batch.updateFilterWithMeasurements(make_span(acc), make_span(gyro), make_span(mag)));
+        }
+        else
+        {
+            ASSERT_IS_TRUE(batch.updateFilterWithMeasurements(make_span(acc), make_span(gyro)));
+        }
+
+        MatrixView<const double> orientations = batch.getOrientationEstimatesAsQuaternions();
+        ASSERT_EQUAL_DOUBLE(orientations.rows(), nrOfIMUs);
+        ASSERT_EQUAL_DOUBLE(orientations.cols(), 4);
+
+        for (size_t imu = 0; imu < nrOfIMUs; imu++)
+        {
+            LinearAccelerometerMeasurements imuAcc(acc.data() + 3*imu, 3);
+            GyroscopeMeasurements imuGyro(gyro.data() + 3*imu, 3);
+            MagnetometerMeasurements imuMag(mag.data() + 3*imu, 3);
+
+            ASSERT_IS_TRUE(filters[imu]->propagateStates());
+            if (useMagnetometer)
+            {
+                ASSERT_IS_TRUE(filters[imu]->updateFilterWithMeasurements(imuAcc, imuGyro, imuMag));
+            }
+            else
+            {
+                ASSERT_IS_TRUE(filters[imu]->updateFilterWithMeasurements(imuAcc, imuGyro));
+            }
+
+            UnitQuaternion expected, batchQuaternion;
+            filters[imu]->getOrientationEstimateAsQuaternion(expected);
+            ASSERT_IS_TRUE(batch.getOrientationEstimateAsQuaternion(imu, batchQuaternion));
+            ASSERT_EQUAL_VECTOR_TOL(batchQuaternion, expected, 1e-9);
+            for (size_t i = 0; i < 4; i++)
+            {
+                ASSERT_EQUAL_DOUBLE_TOL(orientations(imu, i), expected(i), 1e-9);
+            }
+        }
+    }
+}
+
+void testMahonyBatch(bool useMagnetometer)
+{
+    AttitudeMahonyFilterParameters params;
+    params.time_step_in_seconds = 0.01;
+    params.kp = 0.7;
+    params.ki = 0.01;
+    params.use_magnetometer_measurements = useMagnetometer;
+    params.confidence_magnetometer_measurements = useMagnetometer ? 0.3 : 0.0;
+
+    AttitudeEstimatorBatch batch;
+    batch.setMahonyFilterParameters(params);
+    ASSERT_IS_TRUE(batch.init(nrOfIMUs, ATTITUDE_BATCH_MAHONY_FILTER));
+
+    std::vector<std::unique_ptr<IAttitudeEstimator>> filters;
+    for (size_t imu = 0; imu < nrOfIMUs; imu++)
+    {
+        std::unique_ptr<AttitudeMahonyFilter> filter = std::make_unique<AttitudeMahonyFilter>();
+        filter->setParameters(params);
+        filters.push_back(std::move(filter));
+    }
+
+    checkBatchAgainstSingleFilters(batch, filters, useMagnetometer);
+}
+
+void testQuaternionEKFBatch(bool useMagnetometer)
+{
+    AttitudeQuaternionEKFParameters params;
+    params.time_step_in_seconds = 0.01;
+    params.accelerometer_noise_variance = 0.03;
+    params.magnetometer_noise_variance = 0.1;
+    params.gyroscope_noise_variance = 0.5;
+    params.gyro_bias_noise_variance = 10e-11;
+    params.initial_orientation_error_variance = 10e-6;
+    params.initial_ang_vel_error_variance = 10e-1;
+    params.initial_gyro_bias_error_variance = 10e-11;
+    params.bias_correlation_time_factor = 10e-3;
+    params.use_magnetometer_measurements = useMagnetometer;
+
+    AttitudeEstimatorBatch batch;
+    ASSERT_IS_TRUE(batch.init(nrOfIMUs, ATTITUDE_BATCH_QUATERNION_EKF));
+    ASSERT_IS_TRUE(batch.setQuaternionEKFParameters(params));
+
+    std::vector<std::unique_ptr<IAttitudeEstimator>> filters;
+    for (size_t imu = 0; imu < nrOfIMUs; imu++)
+    {
+        std::unique_ptr<AttitudeQuaternionEKF> filter = std::make_unique<AttitudeQuaternionEKF>();
+        filter->setParameters(params);
+        ASSERT_IS_TRUE(filter->initializeFilter());
+        filters.push_back(std::move(filter));
+    }
+
+    checkBatchAgainstSingleFilters(batch, filters, useMagnetometer);
+}
+
+void testInvalidInputs()
+{
+    AttitudeEstimatorBatch batch;
+    ASSERT_IS_TRUE(batch.init(nrOfIMUs, ATTITUDE_BATCH_MAHONY_FILTER));
+
+    VectorDynSize acc(3*nrOfIMUs), gyro(3*nrOfIMUs), mag(3*nrOfIMUs);
+    getRandomMeasurements(acc, gyro, mag);
+
+    VectorDynSize shortGyro(3*nrOfIMUs - 1);
+    ASSERT_IS_FALSE(batch.updateFilterWithMeasurements(make_span(acc), make_span(shortGyro)));
+
+    acc(3) = acc(4) = acc(5) = 0.0;
+    ASSERT_IS_FALSE(batch.updateFilterWithMeasurements(make_span(acc), make_span(gyro)));
+
+    std::vector<double> wrongOrientations(4*(nrOfIMUs + 1), 0.0);
+    ASSERT_IS_FALSE(batch.setInternalStateInitialOrientations(MatrixView<const double>(wrongOrientations.data(), nrOfIMUs + 1, 4)));
+}
+
+int main()
+{
+    testMahonyBatch(false);
+    testMahonyBatch(true);
+    testQuaternionEKFBatch(false);
+    testQuaternionEKFBatch(true);
+    testInvalidInputs();
+
+    return EXIT_SUCCESS;
+}
@@ -120,6 +120,68 @@ int main()
 
     std::cout << "\nQuaternion EKF runs without faults." << std::endl;
 
+    std::cout << "\nChecking the EKF interface of the quaternion EKF..." << std::endl;
+
+    // The same steps run through the ekf methods and through the IAttitudeEstimator methods give the same state
+    iDynTree::AttitudeQuaternionEKF ekfFilter, attitudeFilter, dummyVarianceFilter;
+    ekfFilter.setParameters(params);
+    attitudeFilter.setParameters(params);
+    dummyVarianceFilter.setParameters(params);
+    ASSERT_IS_TRUE(ekfFilter.initializeFilter());
+    ASSERT_IS_TRUE(attitudeFilter.initializeFilter());
+    ASSERT_IS_TRUE(dummyVarianceFilter.initializeFilter());
+    ASSERT_IS_TRUE(ekfFilter.ekfInit());
+    ASSERT_IS_TRUE(ekfFilter.ekfSetInitialState(x0_span));
+    ASSERT_IS_TRUE(attitudeFilter.setInternalState(x0_span));
+    ASSERT_IS_TRUE(dummyVarianceFilter.ekfSetInitialState(x0_span));
+
+    // The variance of the dummy fourth measurement used without the magnetometer does not affect the estimate
+    iDynTree::MatrixDynSize R(iDynTree::output_dimensions_with_magnetometer, iDynTree::output_dimensions_with_magnetometer);
+    R.zero();
+    for (size_t i = 0; i < iDynTree::output_dimensions_without_magnetometer; i++)
+    {
+        R(i, i) = params.accelerometer_noise_variance;
+    }
+    R(3, 3) = 100.0;
+    ASSERT_IS_TRUE(dummyVarianceFilter.ekfSetMeasurementNoiseCovariance(iDynTree::Span<double>(R.data(), R.rows()*R.cols())));
+
+    iDynTree::VectorDynSize states(x_size), ekfStates(x_size);
+    ASSERT_IS_TRUE(ekfFilter.ekfGetStates(ekfStates));
+    ASSERT_EQUAL_VECTOR(ekfStates, x0);
+
+    iDynTree::LinearAccelerometerMeasurements tiltedAcc;
+    tiltedAcc(0) = 0.0;
+    tiltedAcc(1) = 0.6;
+    tiltedAcc(2) = -0.8;
+    gyro.zero();
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_IS_TRUE(attitudeFilter.propagateStates());
+        ASSERT_IS_TRUE(attitudeFilter.updateFilterWithMeasurements(tiltedAcc, gyro));
+
+        // Without the magnetometer, the measurements of the ekf methods have three elements
+        ASSERT_IS_TRUE(ekfFilter.ekfSetInputVector(gyro));
+        ASSERT_IS_TRUE(ekfFilter.ekfPredict());
+        ASSERT_IS_TRUE(ekfFilter.ekfSetMeasurementVector(tiltedAcc));
+        ASSERT_IS_TRUE(ekfFilter.ekfUpdate());
+
+        ASSERT_IS_TRUE(dummyVarianceFilter.ekfSetInputVector(gyro));
+        ASSERT_IS_TRUE(dummyVarianceFilter.ekfPredict());
+        ASSERT_IS_TRUE(dummyVarianceFilter.ekfSetMeasurementVector(tiltedAcc));
+        ASSERT_IS_TRUE(dummyVarianceFilter.ekfUpdate());
+
+        ASSERT_IS_TRUE(attitudeFilter.getInternalState(states));
+        ASSERT_IS_TRUE(ekfFilter.ekfGetStates(ekfStates));
+        ASSERT_EQUAL_VECTOR(ekfStates, states);
+        ASSERT_IS_TRUE(dummyVarianceFilter.ekfGetStates(ekfStates));
+        ASSERT_EQUAL_VECTOR(ekfStates, states);
+    }
+
+    iDynTree::MatrixDynSize P(x_size, x_size);
+    ASSERT_IS_TRUE(ekfFilter.ekfGetStateCovariance(iDynTree::Span<double>(P.data(), x_size*x_size)));
+    iDynTree::VectorDynSize wrongSizeStates(x_size + 1);
+    ASSERT_IS_FALSE(ekfFilter.ekfGetStates(wrongSizeStates));
+
     std::cout << "\n\n Mahony filter running..." << std::endl;
 
     std::unique_ptr<iDynTree::AttitudeMahonyFilter> mahony_filt;
@@ -11,13 +11,24 @@
 #include <iDynTree/Estimation/BerdySparseMAPSolver.h>
 
 #include <iDynTree/Estimation/BerdyHelper.h>
+#include <iDynTree/Estimation/ExtWrenchesAndJointTorquesEstimator.h>
+
+#include "testModels.h"
 
 #include <iDynTree/Core/EigenHelpers.h>
 #include <iDynTree/Core/EigenSparseHelpers.h>
 #include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Core/SparseMatrix.h>
+#include <iDynTree/Core/VectorDynSize.h>
+#include <iDynTree/Model/JointState.h>
+
+#include <Eigen/SparseLU>
 
 #include <cstdio>
+#include <algorithm>
 #include <cstdlib>
+#include <iostream>
+#include <vector>
 
 using namespace iDynTree;
 
@@ -29,9 +40,211 @@ void testEmptyHelper()
     ASSERT_IS_FALSE(solver.isValid());
 }
 
+struct WindowSample
+{
+    Eigen::SparseMatrix<double> informationMatrix;
+    Eigen::VectorXd informationVector;
+    JointDOFsDoubleArray jointsVelocity;
+};
+
+// Information form of the a posteriori of a single sample, computed from the berdy matrices
+WindowSample computeSampleInformation(BerdyHelper& berdyHelper,
+                                      const BerdySparseMAPSolver& solver,
+                                      const JointDOFsDoubleArray& jointsVelocity,
+                                      const VectorDynSize& measurements)
+{
+    SparseMatrix<iDynTree::ColumnMajor> D, Y;
+    VectorDynSize bD, bY;
+    ASSERT_IS_TRUE(berdyHelper.getBerdyMatrices(D, bD, Y, bY));
+
+    Eigen::SparseMatrix<double> SigmaDInv = toEigen(solver.dynamicsConstraintsPriorCovarianceInverse());
+    Eigen::SparseMatrix<double> SigmadInv = toEigen(solver.dynamicsRegularizationPriorCovarianceInverse());
+    Eigen::SparseMatrix<double> SigmayInv = toEigen(solver.measurementsPriorCovarianceInverse());
+    Eigen::SparseMatrix<double> DEigen = toEigen(D);
+    Eigen::SparseMatrix<double> YEigen = toEigen(Y);
+
+    WindowSample sample;
+    sample.informationMatrix = SigmadInv;
+    sample.informationMatrix += Eigen::SparseMatrix<double>(DEigen.transpose() * SigmaDInv * DEigen);
+    sample.informationMatrix += Eigen::SparseMatrix<double>(YEigen.transpose() * SigmayInv * YEigen);
+    sample.informationVector = SigmadInv * toEigen(solver.dynamicsRegularizationPriorExpectedValue())
+                               - DEigen.transpose() * (SigmaDInv * toEigen(bD))
+                               + YEigen.transpose() * (SigmayInv * (toEigen(measurements) - toEigen(bY)));
+    sample.jointsVelocity = jointsVelocity;
+    return sample;
+}
+
+// Maximum a posteriori of the whole window, from the probabilistic model of the fixed-lag smoother
+Eigen::VectorXd computeWindowEstimate(const BerdyHelper& berdyHelper,
+                                      const std::vector<WindowSample>& samples,
+                                      const Eigen::SparseMatrix<double>& processModelInverse,
+                                      const double samplingTime,
+                                      const double jointAccelerationVariance)
+{
+    const Eigen::Index n = berdyHelper.getNrOfDynamicVariables();
+    const Eigen::Index windowSize = n * samples.size();
+    std::vector<Eigen::Triplet<double> > triplets;
+    Eigen::VectorXd rhs = Eigen::VectorXd::Zero(windowSize);
+
+    for (size_t k = 0; k < samples.size(); ++k) {
+        for (Eigen::Index col = 0; col < samples[k].informationMatrix.outerSize(); ++col) {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(samples[k].informationMatrix, col); it; ++it) {
+                triplets.push_back(Eigen::Triplet<double>(k * n + it.row(), k * n + it.col(), it.value()));
+            }
+        }
+        rhs.segment(k * n, n) += samples[k].informationVector;
+    }
+
+    // Random walk d_{k+1} - d_k ~ N(0, Sigma_p)
+    for (size_t k = 0; k + 1 < samples.size(); ++k) {
+        for (Eigen::Index col = 0; col < processModelInverse.outerSize(); ++col) {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(processModelInverse, col); it; ++it) {
+                triplets.push_back(Eigen::Triplet<double>(k * n + it.row(), k * n + it.col(), it.value()));
+                triplets.push_back(Eigen::Triplet<double>((k + 1) * n + it.row(), (k + 1) * n + it.col(), it.value()));
+                triplets.push_back(Eigen::Triplet<double>(k * n + it.row(), (k + 1) * n + it.col(), -it.value()));
+                triplets.push_back(Eigen::Triplet<double>((k + 1) * n + it.row(), k * n + it.col(), -it.value()));
+            }
+        }
+    }
+
+    // Trapezoidal integration: the residual dt/2 (dds_k + dds_{k+1}) - (ds_{k+1} - ds_k) ~ N(0, sigma^2)
+    for (size_t k = 0; k + 1 < samples.size(); ++k) {
+        for (DOFIndex dof = 0; dof < static_cast<DOFIndex>(berdyHelper.model().getNrOfDOFs()); ++dof) {
+            const Eigen::Index offset = berdyHelper.getRangeDOFVariable(DOF_ACCELERATION, dof).offset;
+            const double velocityIncrement = samples[k + 1].jointsVelocity(dof) - samples[k].jointsVelocity(dof);
+            const Eigen::Index rows[2] = {static_cast<Eigen::Index>(k * n + offset), static_cast<Eigen::Index>((k + 1) * n + offset)};
+            for (Eigen::Index row : rows) {
+                for (Eigen::Index col : rows) {
+                    triplets.push_back(Eigen::Triplet<double>(row, col, samplingTime * samplingTime / (4.0 * jointAccelerationVariance)));
+                }
+                rhs(row) += samplingTime / (2.0 * jointAccelerationVariance) * velocityIncrement;
+            }
+        }
+    }
+
+    Eigen::SparseMatrix<double> windowMatrix(windowSize, windowSize);
+    windowMatrix.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::SparseLU<Eigen::SparseMatrix<double> > solver(windowMatrix);
+    ASSERT_IS_TRUE(solver.info() == Eigen::Success);
+    return solver.solve(rhs);
+}
+
+void testFixedLagSmoothing(const std::string& fileName)
+{
+    ExtWrenchesAndJointTorquesEstimator estimator;
+    bool ok = estimator.loadModelAndSensorsFromFile(fileName);
+    ASSERT_IS_TRUE(ok);
+
+    BerdyHelper berdyHelper;
+    BerdyOptions options;
+    options.berdyVariant = iDynTree::BERDY_FLOATING_BASE;
+    options.includeAllNetExternalWrenchesAsDynamicVariables = true;
+    options.includeAllNetExternalWrenchesAsSensors = true;
+    options.includeAllJointAccelerationsAsSensors = true;
+    ok = berdyHelper.init(estimator.model(), estimator.sensors(), options);
+    ASSERT_IS_TRUE(ok);
+
+    BerdySparseMAPSolver singleSampleSolver(berdyHelper);
+    ASSERT_IS_TRUE(singleSampleSolver.initialize());
+    BerdySparseMAPSolver smoother(berdyHelper);
+    ASSERT_IS_TRUE(smoother.initialize());
+
+    const size_t windowLength = 4;
+    const double samplingTime = 0.01;
+    ASSERT_IS_TRUE(smoother.setFixedLagWindow(windowLength, samplingTime));
+
+    JointPosDoubleArray jointsPos(berdyHelper.model());
+    JointDOFsDoubleArray jointsVel(berdyHelper.model());
+    VectorDynSize measurements(berdyHelper.getNrOfSensorsMeasurements());
+    Vector3 angularVelocity;
+    getRandomVector(jointsPos);
+    getRandomVector(jointsVel);
+    getRandomVector(measurements);
+    getRandomVector(angularVelocity);
+    FrameIndex baseFrame = berdyHelper.dynamicTraversal().getBaseLink()->getIndex();
+
+    singleSampleSolver.updateEstimateInformationFloatingBase(jointsPos, jointsVel, baseFrame, angularVelocity, measurements);
+    ASSERT_IS_TRUE(singleSampleSolver.doEstimate());
+
+    // With constant inputs, the process model is always satisfied by the estimate of the single sample
+    VectorDynSize smoothedEstimate;
+    for (size_t sample = 0; sample < 2 * windowLength; ++sample) {
+        smoother.updateEstimateInformationFloatingBase(jointsPos, jointsVel, baseFrame, angularVelocity, measurements);
+        ASSERT_IS_TRUE(smoother.doEstimate());
+        ASSERT_EQUAL_DOUBLE(smoother.getNrOfSamplesInWindow(), std::min(sample + 1, windowLength));
+        ASSERT_EQUAL_VECTOR_TOL(smoother.getLastEstimate(), singleSampleSolver.getLastEstimate(), 1e-6);
+        ASSERT_IS_TRUE(smoother.getSmoothedEstimate(smoother.getNrOfSamplesInWindow() - 1, smoothedEstimate));
+        ASSERT_EQUAL_VECTOR_TOL(smoothedEstimate, singleSampleSolver.getLastEstimate(), 1e-6);
+    }
+    ASSERT_IS_FALSE(smoother.getSmoothedEstimate(windowLength, smoothedEstimate));
+
+    // With a loose process model, the samples are decoupled
+    SparseMatrix<iDynTree::ColumnMajor> processCovariance(berdyHelper.getNrOfDynamicVariables(), berdyHelper.getNrOfDynamicVariables());
+    Triplets triplets;
+    triplets.setDiagonalMatrix(0, 0, 1e10, berdyHelper.getNrOfDynamicVariables());
+    processCovariance.setFromTriplets(triplets);
+    smoother.setProcessModelCovariance(processCovariance);
+    smoother.resetFixedLagWindow();
+
+    for (size_t sample = 0; sample < 2 * windowLength; ++sample) {
+        getRandomVector(measurements);
+        smoother.updateEstimateInformationFloatingBase(jointsPos, jointsVel, baseFrame, angularVelocity, measurements);
+        ASSERT_IS_TRUE(smoother.doEstimate());
+        singleSampleSolver.updateEstimateInformationFloatingBase(jointsPos, jointsVel, baseFrame, angularVelocity, measurements);
+        ASSERT_IS_TRUE(singleSampleSolver.doEstimate());
+        ASSERT_EQUAL_VECTOR_TOL(smoother.getLastEstimate(), singleSampleSolver.getLastEstimate(), 1e-4);
+    }
+
+    // A covariance of the wrong size is rejected
+    SparseMatrix<iDynTree::ColumnMajor> wrongCovariance(1, 1);
+    ASSERT_IS_FALSE(smoother.setProcessModelCovariance(wrongCovariance));
+
+    // Coupling of the samples with the process model and the integration of the joint accelerations
+    const double jointAccelerationVariance = 1e-2;
+    triplets.clear();
+    triplets.setDiagonalMatrix(0, 0, 10.0, berdyHelper.getNrOfDynamicVariables());
+    processCovariance.setFromTriplets(triplets);
+    ASSERT_IS_TRUE(smoother.setProcessModelCovariance(processCovariance));
+    smoother.setJointAccelerationIntegrationVariance(jointAccelerationVariance);
+    smoother.resetFixedLagWindow();
+
+    const size_t nrOfDynVariables = berdyHelper.getNrOfDynamicVariables();
+    Eigen::SparseMatrix<double> processModelInverse = toEigen(smoother.processModelCovarianceInverse());
+    std::vector<WindowSample> window;
+    for (size_t sample = 0; sample < 2 * windowLength; ++sample) {
+        getRandomVector(jointsVel);
+        getRandomVector(measurements);
+        smoother.updateEstimateInformationFloatingBase(jointsPos, jointsVel, baseFrame, angularVelocity, measurements);
+        ASSERT_IS_TRUE(smoother.doEstimate());
+
+        if (window.size() == windowLength) {
+            window.erase(window.begin());
+        }
+        window.push_back(computeSampleInformation(berdyHelper, smoother, jointsVel, measurements));
+        Eigen::VectorXd expectedWindow = computeWindowEstimate(berdyHelper, window, processModelInverse,
+                                                               samplingTime, jointAccelerationVariance);
+
+        VectorDynSize expected(nrOfDynVariables);
+        toEigen(expected) = expectedWindow.tail(nrOfDynVariables);
+        ASSERT_EQUAL_VECTOR_TOL(smoother.getLastEstimate(), expected, 1e-6);
+        for (size_t lag = 0; lag < window.size(); ++lag) {
+            toEigen(expected) = expectedWindow.segment((window.size() - 1 - lag) * nrOfDynVariables, nrOfDynVariables);
+            ASSERT_IS_TRUE(smoother.getSmoothedEstimate(lag, smoothedEstimate));
+            ASSERT_EQUAL_VECTOR_TOL(smoothedEstimate, expected, 1e-6);
+        }
+    }
+}
+
 int main()
 {
     testEmptyHelper();
 
+    for (unsigned int mdl = 0; mdl < IDYNTREE_TESTS_URDFS_NR; mdl++)
+    {
+        std::string urdfFileName = getAbsModelPath(std::string(IDYNTREE_TESTS_URDFS[mdl]));
+        std::cout << "BerdyMAPSolverUnitTest, testing file " << std::string(IDYNTREE_TESTS_URDFS[mdl]) << std::endl;
+        testFixedLagSmoothing(urdfFileName);
+    }
+
     return EXIT_SUCCESS;
 }
@@ -202,6 +202,128 @@ int main()
     // The sum of the netWrenchesWithoutGravity of all the links should be equal to the sum of the external wrenches
     ASSERT_EQUAL_SPATIAL_FORCE_TOL(momentumDerivative,externalForces,1e-8);
 
+    // The parallel estimation of the submodels should give the same results of the sequential one
+    LinkUnknownWrenchContacts subModelsUnknowns(estimatorIMU.model());
+    for(size_t sm=0; sm < estimatorIMU.submodels().getNrOfSubModels(); sm++)
+    {
+        LinkIndex subModelBase = estimatorIMU.submodels().getTraversal(sm).getBaseLink()->getIndex();
+        subModelsUnknowns.addNewContactForLink(subModelBase,unknown);
+    }
+
+    LinkContactWrenches sequentialContactWrenches(estimatorIMU.model()), parallelContactWrenches(estimatorIMU.model());
+    JointDOFsDoubleArray sequentialJointTorques(estimatorIMU.model()), parallelJointTorques(estimatorIMU.model());
+    ok = estimatorIMU.estimateExtWrenchesAndJointTorques(subModelsUnknowns,sensOffsetIMU,sequentialContactWrenches,sequentialJointTorques);
+    ASSERT_IS_TRUE(ok);
+
+    estimatorIMU.setNrOfEstimationWorkerThreads(3);
+    ASSERT_IS_TRUE(estimatorIMU.getNrOfEstimationWorkerThreads() == 3);
+    ok = estimatorIMU.estimateExtWrenchesAndJointTorques(subModelsUnknowns,sensOffsetIMU,parallelContactWrenches,parallelJointTorques);
+    ASSERT_IS_TRUE(ok);
+
+    for(LinkIndex idx = 0; idx < estimatorIMU.model().getNrOfLinks(); idx++)
+    {
+        ASSERT_IS_TRUE(sequentialContactWrenches.getNrOfContactsForLink(idx) == parallelContactWrenches.getNrOfContactsForLink(idx));
+        for(size_t contact=0; contact < sequentialContactWrenches.getNrOfContactsForLink(idx); contact++)
+        {
+            ASSERT_EQUAL_SPATIAL_FORCE(sequentialContactWrenches.contactWrench(idx,contact).contactWrench(),
+                                       parallelContactWrenches.contactWrench(idx,contact).contactWrench());
+        }
+    }
+    ASSERT_EQUAL_VECTOR(sequentialJointTorques,parallelJointTorques);
+
+    estimatorIMU.setNrOfEstimationWorkerThreads(0);
+    ASSERT_IS_TRUE(estimatorIMU.getNrOfEstimationWorkerThreads() == 0);
+
+    // The batch estimation should give the same results of the sample by sample estimation
+    const size_t nrOfSamples = 17;
+    const size_t nrOfDOFs = estimatorIMU.model().getNrOfDOFs();
+    const size_t nrOfFTs = estimatorIMU.sensors().getNrOfSensors(iDynTree::SIX_AXIS_FORCE_TORQUE);
+
+    std::vector<LinkUnknownWrenchContacts> contactSets;
+    contactSets.push_back(fullBodyUnknowns);
+    contactSets.push_back(subModelsUnknowns);
+    size_t maxNrOfContacts = estimatorIMU.submodels().getNrOfSubModels();
+
+    std::vector<size_t> contactSetOfSample(nrOfSamples);
+    MatrixDynSize batchJointPos(nrOfSamples,nrOfDOFs), batchJointVel(nrOfSamples,nrOfDOFs), batchJointAcc(nrOfSamples,nrOfDOFs);
+    MatrixDynSize batchProperAcc(nrOfSamples,3), batchAngularVel(nrOfSamples,3), batchAngularAcc(nrOfSamples,3);
+    MatrixDynSize batchFTs(nrOfSamples,6*nrOfFTs);
+    MatrixDynSize expectedContactWrenches(nrOfSamples,6*maxNrOfContacts), expectedJointTorques(nrOfSamples,nrOfDOFs);
+    expectedContactWrenches.zero();
+
+    SensorsMeasurements sampleFTs(estimatorIMU.sensors());
+    LinkContactWrenches sampleContactWrenches(estimatorIMU.model());
+    JointDOFsDoubleArray sampleJointTorques(estimatorIMU.model());
+    Vector3 sampleProperAcc, sampleAngularVel, sampleAngularAcc;
+    for(size_t sample=0; sample < nrOfSamples; sample++)
+    {
+        contactSetOfSample[sample] = (sample/4)%2;
+        for(size_t i=0; i < nrOfDOFs; i++)
+        {
+            batchJointPos(sample,i) = qj(i) = getRandomDouble(-1.0,1.0);
+            batchJointVel(sample,i) = dqj(i) = getRandomDouble(-1.0,1.0);
+            batchJointAcc(sample,i) = ddqj(i) = getRandomDouble(-1.0,1.0);
+        }
+        for(unsigned int i=0; i < 3; i++)
+        {
+            batchProperAcc(sample,i) = sampleProperAcc(i) = getRandomDouble(-10.0,10.0);
+            batchAngularVel(sample,i) = sampleAngularVel(i) = getRandomDouble(-1.0,1.0);
+            batchAngularAcc(sample,i) = sampleAngularAcc(i) = getRandomDouble(-1.0,1.0);
+        }
+        for(size_t ft=0; ft < nrOfFTs; ft++)
+        {
+            Wrench ftMeasure = getRandomWrench();
+            for(unsigned int i=0; i < 6; i++)
+            {
+                batchFTs(sample,6*ft+i) = ftMeasure(i);
+            }
+            sampleFTs.setMeasurement(iDynTree::SIX_AXIS_FORCE_TORQUE,ft,ftMeasure);
+        }
+
+        ok = estimatorIMU.updateKinematicsFromFloatingBase(qj,dqj,ddqj,imu_frame_index,sampleProperAcc,sampleAngularVel,sampleAngularAcc);
+        ASSERT_IS_TRUE(ok);
+        ok = estimatorIMU.estimateExtWrenchesAndJointTorques(contactSets[contactSetOfSample[sample]],sampleFTs,sampleContactWrenches,sampleJointTorques);
+        ASSERT_IS_TRUE(ok);
+
+        size_t col = 0;
+        for(LinkIndex idx = 0; idx < estimatorIMU.model().getNrOfLinks(); idx++)
+        {
+            for(size_t contact=0; contact < sampleContactWrenches.getNrOfContactsForLink(idx); contact++)
+            {
+                for(unsigned int i=0; i < 6; i++)
+                {
+                    expectedContactWrenches(sample,col++) = sampleContactWrenches.contactWrench(idx,contact).contactWrench()(i);
+                }
+            }
+        }
+        for(size_t i=0; i < nrOfDOFs; i++)
+        {
+            expectedJointTorques(sample,i) = sampleJointTorques(i);
+        }
+    }
+
+    for(size_t nrOfWorkerThreads=0; nrOfWorkerThreads < 4; nrOfWorkerThreads += 3)
+    {
+        estimatorIMU.setNrOfEstimationWorkerThreads(nrOfWorkerThreads);
+        MatrixDynSize batchContactWrenches(nrOfSamples,6*maxNrOfContacts), batchJointTorques(nrOfSamples,nrOfDOFs);
+        ok = estimatorIMU.estimateExtWrenchesAndJointTorquesBatch(batchJointPos,batchJointVel,batchJointAcc,imu_frame_index,
+                                                                  batchProperAcc,batchAngularVel,batchAngularAcc,batchFTs,
+                                                                  contactSets,contactSetOfSample,
+                                                                  batchContactWrenches,batchJointTorques);
+        ASSERT_IS_TRUE(ok);
+        ASSERT_EQUAL_MATRIX_TOL(expectedContactWrenches,batchContactWrenches,1e-8);
+        ASSERT_EQUAL_MATRIX_TOL(expectedJointTorques,batchJointTorques,1e-8);
+    }
+
+    // Wrong sizes should be detected
+    MatrixDynSize tooSmallContactWrenches(nrOfSamples,6), batchJointTorques(nrOfSamples,nrOfDOFs);
+    ok = estimatorIMU.estimateExtWrenchesAndJointTorquesBatch(batchJointPos,batchJointVel,batchJointAcc,imu_frame_index,
+                                                              batchProperAcc,batchAngularVel,batchAngularAcc,batchFTs,
+                                                              contactSets,contactSetOfSample,
+                                                              tooSmallContactWrenches,batchJointTorques);
+    ASSERT_IS_FALSE(ok);
+    estimatorIMU.setNrOfEstimationWorkerThreads(0);
+
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/ExtendedKalmanFilter.h>
+#include <iDynTree/Estimation/ExtendedKalmanFilterFixedSize.h>
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/TestUtils.h>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace iDynTree;
+
+/**
+ * Linear system x_{k+1} = A x_k + B u_k, y_k = C x_k,
+ * for which the EKF reduces to the standard Kalman filter.
+ */
+class LinearSystemEKF : public DiscreteExtendedKalmanFilterHelper
+{
+public:
+    MatrixDynSize A, B, C;
+
+    LinearSystemEKF(const MatrixDynSize& _A, const MatrixDynSize& _B, const MatrixDynSize& _C) : A(_A), B(_B), C(_C)
+    {
+    }
+
+    bool ekf_f(const VectorDynSize& x_k, const VectorDynSize& u_k, VectorDynSize& xhat_k_plus_one) override
+    {
+        toEigen(xhat_k_plus_one) = toEigen(A)*toEigen(x_k) + toEigen(B)*toEigen(u_k);
+        return true;
+    }
+
+    bool ekf_h(const VectorDynSize& xhat_k_plus_one, VectorDynSize& zhat_k_plus_one) override
+    {
+        toEigen(zhat_k_plus_one) = toEigen(C)*toEigen(xhat_k_plus_one);
+        return true;
+    }
+
+    bool ekfComputeJacobianF(VectorDynSize& x, MatrixDynSize& F) override
+    {
+        ignore(x);
+        F = A;
+        return true;
+    }
+
+    bool ekfComputeJacobianF(VectorDynSize& x, VectorDynSize& u, MatrixDynSize& F) override
+    {
+        ignore(u);
+        return ekfComputeJacobianF(x, F);
+    }
+
+    bool ekfComputeJacobianH(VectorDynSize& x, MatrixDynSize& H) override
+    {
+        ignore(x);
+        H = C;
+        return true;
+    }
+};
+
+/**
+ * Same linear system, with compile-time dimensions.
+ */
+template <unsigned int nx, unsigned int nu, unsigned int ny>
+class LinearSystemFixedSizeEKF : public DiscreteExtendedKalmanFilterFixedSizeHelper<LinearSystemFixedSizeEKF<nx, nu, ny>, nx, nu, ny>
+{
+public:
+    typedef DiscreteExtendedKalmanFilterFixedSizeHelper<LinearSystemFixedSizeEKF<nx, nu, ny>, nx, nu, ny> Base;
+    MatrixDynSize A, B, C;
+
+    LinearSystemFixedSizeEKF(const MatrixDynSize& _A, const MatrixDynSize& _B, const MatrixDynSize& _C) : A(_A), B(_B), C(_C)
+    {
+    }
+
+    bool ekf_f(const typename Base::StateVector& x_k, const typename Base::InputVector& u_k, typename Base::StateVector& xhat_k_plus_one)
+    {
+        toEigen(xhat_k_plus_one) = toEigen(A)*toEigen(x_k) + toEigen(B)*toEigen(u_k);
+        return true;
+    }
+
+    bool ekf_h(const typename Base::StateVector& xhat_k_plus_one, typename Base::OutputVector& zhat_k_plus_one)
+    {
+        toEigen(zhat_k_plus_one) = toEigen(C)*toEigen(xhat_k_plus_one);
+        return true;
+    }
+
+    bool ekfComputeJacobianF(const typename Base::StateVector& x, const typename Base::InputVector& u, typename Base::StateMatrix& F)
+    {
+        toEigen(F) = toEigen(A);
+        return true;
+    }
+
+    bool ekfComputeJacobianH(const typename Base::StateVector& x, typename Base::OutputJacobianMatrix& H)
+    {
+        toEigen(H) = toEigen(C);
+        return true;
+    }
+};
+
+void runFilter(LinearSystemEKF& filter,
+               const EKFUpdateMode mode,
+               const std::vector<double>& R,
+               const std::vector<VectorDynSize>& inputs,
+               const std::vector<VectorDynSize>& measurements,
+               VectorDynSize& finalState,
+               MatrixDynSize& finalCovariance)
+{
+    const size_t nx = filter.A.rows();
+    const size_t nu = filter.B.cols();
+    const size_t ny = filter.C.rows();
+
+    std::vector<double> x0(nx, 0.0), P0(nx*nx, 0.0), Q(nx*nx, 0.0), Rcopy(R);
+    for (size_t i = 0; i < nx; i++)
+    {
+        P0[i*nx + i] = 1.0;
+        Q[i*nx + i] = 1e-3;
+    }
+
+    bool ok = filter.ekfReset(nx, nu, ny, make_span(x0), make_span(P0), make_span(Q), make_span(Rcopy));
+    ASSERT_IS_TRUE(ok);
+    filter.ekfSetUpdateMode(mode);
+    ASSERT_IS_TRUE(filter.ekfGetUpdateMode() == mode);
+
+    for (size_t k = 0; k < inputs.size(); k++)
+    {
+        VectorDynSize u(inputs[k]), y(measurements[k]);
+        ASSERT_IS_TRUE(filter.ekfSetInputVector(make_span(u)));
+        ASSERT_IS_TRUE(filter.ekfPredict());
+        ASSERT_IS_TRUE(filter.ekfSetMeasurementVector(make_span(y)));
+        ASSERT_IS_TRUE(filter.ekfUpdate());
+    }
+
+    finalState.resize(nx);
+    finalCovariance.resize(nx, nx);
+    ASSERT_IS_TRUE(filter.ekfGetStates(make_span(finalState)));
+    ASSERT_IS_TRUE(filter.ekfGetStateCovariance(make_span(finalCovariance.data(), nx*nx)));
+}
+
+int main()
+{
+    const size_t nx = 6, nu = 2, ny = 4, nrOfSteps = 50;
+
+    MatrixDynSize A(nx, nx), B(nx, nu), C(ny, nx);
+    getRandomMatrix(A);
+    toEigen(A) = 0.05*toEigen(A) + 0.8*Eigen::MatrixXd::Identity(nx, nx);
+    getRandomMatrix(B);
+    getRandomMatrix(C);
+
+    std::vector<VectorDynSize> inputs(nrOfSteps), measurements(nrOfSteps);
+    for (size_t k = 0; k < nrOfSteps; k++)
+    {
+        inputs[k].resize(nu);
+        getRandomVector(inputs[k], -1.0, 1.0);
+        measurements[k].resize(ny);
+        getRandomVector(measurements[k], -1.0, 1.0);
+    }
+
+    // Diagonal measurement noise covariance
+    std::vector<double> R(ny*ny, 0.0);
+    for (size_t i = 0; i < ny; i++)
+    {
+        R[i*ny + i] = 0.1*(i + 1);
+    }
+
+    LinearSystemEKF filter(A, B, C);
+    VectorDynSize xStandard, x;
+    MatrixDynSize PStandard, P;
+    runFilter(filter, EKF_UPDATE_STANDARD, R, inputs, measurements, xStandard, PStandard);
+
+    // All the update modes should give the same estimate
+    EKFUpdateMode modes[] = {EKF_UPDATE_CHOLESKY, EKF_UPDATE_JOSEPH, EKF_UPDATE_SEQUENTIAL};
+    for (EKFUpdateMode mode : modes)
+    {
+        runFilter(filter, mode, R, inputs, measurements, x, P);
+        ASSERT_EQUAL_VECTOR_TOL(xStandard, x, 1e-7);
+        ASSERT_EQUAL_MATRIX_TOL(PStandard, P, 1e-7);
+    }
+
+    // The fixed size filter should give the same estimate of the dynamic one
+    const unsigned int fnx = 6, fnu = 2, fny = 4;
+    for (EKFUpdateMode mode : modes)
+    {
+        LinearSystemFixedSizeEKF<fnx, fnu, fny> fixedSizeFilter(A, B, C);
+        LinearSystemFixedSizeEKF<fnx, fnu, fny>::StateMatrix P0, Q;
+        LinearSystemFixedSizeEKF<fnx, fnu, fny>::OutputMatrix Rfixed;
+        LinearSystemFixedSizeEKF<fnx, fnu, fny>::StateVector x0;
+        toEigen(P0).setIdentity();
+        toEigen(Q) = 1e-3*Eigen::MatrixXd::Identity(nx, nx);
+        x0.zero();
+        fixedSizeFilter.ekfSetInitialState(x0);
+        fixedSizeFilter.ekfSetStateCovariance(P0);
+        fixedSizeFilter.ekfSetSystemNoiseCovariance(Q);
+        ASSERT_IS_TRUE(fixedSizeFilter.ekfSetMeasurementNoiseCovariance(make_span(R)));
+        fixedSizeFilter.ekfSetUpdateMode(mode);
+
+        for (size_t k = 0; k < nrOfSteps; k++)
+        {
+            ASSERT_IS_TRUE(fixedSizeFilter.ekfSetInputVector(make_span(inputs[k])));
+            ASSERT_IS_TRUE(fixedSizeFilter.ekfPredict());
+            ASSERT_IS_TRUE(fixedSizeFilter.ekfSetMeasurementVector(make_span(measurements[k])));
+            ASSERT_IS_TRUE(fixedSizeFilter.ekfUpdate());
+        }
+
+        ASSERT_EQUAL_VECTOR_TOL(xStandard, fixedSizeFilter.ekfStates(), 1e-7);
+        ASSERT_EQUAL_MATRIX_TOL(PStandard, fixedSizeFilter.ekfStateCovariance(), 1e-7);
+    }
+
+    // The sequential update is not possible with a non diagonal measurement noise covariance
+    R[1] = R[ny] = 0.01;
+    runFilter(filter, EKF_UPDATE_JOSEPH, R, inputs, measurements, x, P);
+    std::vector<double> x0(nx, 0.0), P0(nx*nx, 0.0), Q(nx*nx, 0.0);
+    for (size_t i = 0; i < nx; i++)
+    {
+        P0[i*nx + i] = 1.0;
+    }
+    ASSERT_IS_TRUE(filter.ekfReset(nx, nu, ny, make_span(x0), make_span(P0), make_span(Q), make_span(R)));
+    filter.ekfSetUpdateMode(EKF_UPDATE_SEQUENTIAL);
+    VectorDynSize u(inputs[0]), y(measurements[0]);
+    ASSERT_IS_TRUE(filter.ekfSetInputVector(make_span(u)));
+    ASSERT_IS_TRUE(filter.ekfPredict());
+    ASSERT_IS_TRUE(filter.ekfSetMeasurementVector(make_span(y)));
+    ASSERT_IS_FALSE(filter.ekfUpdate());
+
+    return EXIT_SUCCESS;
+}
@@ -189,9 +189,80 @@ void checkRandomModelExternalWrenchEstimation(size_t nrOfJoints)
     SpatialForceVector zero = SpatialForceVector::Zero();
     ASSERT_EQUAL_SPATIAL_FORCE(trqs.baseWrench(),zero);
 
+    // The complete orthogonal decomposition should give the same minimum norm solution
+    LinkContactWrenches contactWrenchesCOD(model);
+    bufs.pseudoInverseMethod = COMPLETE_ORTHOGONAL_DECOMPOSITION_PSEUDOINVERSE;
+    estimateExternalWrenchesWithoutInternalFT(model,traversal,unknownWrenches,robotPos.jointPos(),vels,properAccs,bufs,contactWrenchesCOD);
+    ASSERT_EQUAL_SPATIAL_FORCE(contactWrenchesCOD.contactWrench(contactLink,0).contactWrench(),
+                               contactWrenches.contactWrench(contactLink,0).contactWrench());
+
+    // If the contacts and the joint positions are unchanged, the cached pseudo inverse is used
+    MatrixDynSize cachedPinvA = bufs.pinvA[0];
+    robotVel.baseVel() = getRandomTwist();
+    ForwardVelAccKinematics(model,traversal,robotPos,robotVel,robotAcc,vels,properAccs);
+    estimateExternalWrenchesWithoutInternalFT(model,traversal,unknownWrenches,robotPos.jointPos(),vels,properAccs,bufs,contactWrenchesCOD);
+    ASSERT_EQUAL_MATRIX(cachedPinvA,bufs.pinvA[0]);
+    contactWrenchesCOD.computeNetWrenches(newContactWrenches);
+    RNEADynamicPhase(model,traversal,robotPos.jointPos(),vels,properAccs,newContactWrenches,internalWrenches,trqs);
+    ASSERT_EQUAL_SPATIAL_FORCE(trqs.baseWrench(),zero);
+
     // Once we computed a resonable force, we simulate some ft sensors measures
 }
 
+void checkRankDeficientExternalWrenchEstimation(size_t nrOfJoints)
+{
+    std::cerr << "Check rank deficient estimation on random model with " << nrOfJoints << " joints." << std::endl;
+
+    Model model = getRandomModel(nrOfJoints);
+
+    Traversal traversal;
+    model.computeFullTreeTraversal(traversal);
+
+    FreeFloatingPos robotPos(model);
+    FreeFloatingVel robotVel(model);
+    FreeFloatingAcc robotAcc(model);
+
+    robotPos.worldBasePos() = getRandomTransform();
+    getRandomVector(robotPos.jointPos());
+    robotVel.baseVel() = getRandomTwist();
+    getRandomVector(robotVel.jointVel());
+    robotAcc.baseAcc() = getRandomTwist();
+    getRandomVector(robotAcc.jointAcc());
+
+    LinkVelArray vels(model);
+    LinkAccArray properAccs(model);
+    ForwardVelAccKinematics(model,traversal,robotPos,robotVel,robotAcc,vels,properAccs);
+
+    // Two pure forces applied on the same link at points that coincide or that are very close:
+    // the smallest singular values of A are zero or below the estimation tolerance, but above
+    // the default threshold of the decompositions, so they must be discarded by the pseudo inverse
+    const double offsets[] = {0.0, 1e-10};
+    for(double offset : offsets)
+    {
+        LinkUnknownWrenchContacts unknownWrenches(model);
+        LinkIndex contactLink = getRandomLinkIndexOfModel(model);
+        UnknownWrenchContact unknownWrench;
+        unknownWrench.unknownType = PURE_FORCE;
+        unknownWrench.contactPoint = getRandomPosition();
+        unknownWrenches.addNewContactForLink(contactLink,unknownWrench);
+        unknownWrench.contactPoint(0) += offset;
+        unknownWrenches.addNewContactForLink(contactLink,unknownWrench);
+
+        LinkContactWrenches contactWrenchesSVD(model), contactWrenchesCOD(model);
+        estimateExternalWrenchesBuffers bufs(1,model.getNrOfLinks());
+        ASSERT_IS_TRUE(estimateExternalWrenchesWithoutInternalFT(model,traversal,unknownWrenches,robotPos.jointPos(),vels,properAccs,bufs,contactWrenchesSVD));
+        bufs.pseudoInverseMethod = COMPLETE_ORTHOGONAL_DECOMPOSITION_PSEUDOINVERSE;
+        ASSERT_IS_TRUE(estimateExternalWrenchesWithoutInternalFT(model,traversal,unknownWrenches,robotPos.jointPos(),vels,properAccs,bufs,contactWrenchesCOD));
+
+        // Both methods give the same minimum norm solution, that splits the force between the two contacts
+        for(size_t contact=0; contact < 2; contact++)
+        {
+            ASSERT_EQUAL_SPATIAL_FORCE_TOL(contactWrenchesCOD.contactWrench(contactLink,contact).contactWrench(),
+                                           contactWrenchesSVD.contactWrench(contactLink,contact).contactWrench(),1e-6);
+        }
+    }
+}
+
 void checkSimpleModelExternalWrenchEstimationWithFTSensors()
 {
     std::cerr << "checkSimpleModelExternalWrenchEstimationWithFTSensors " << std::endl;
@@ -385,6 +456,9 @@ int main()
     checkRandomModelExternalWrenchEstimation(10);
     checkRandomModelExternalWrenchEstimation(20);
 
+    checkRankDeficientExternalWrenchEstimation(0);
+    checkRankDeficientExternalWrenchEstimation(5);
+
     checkSimpleModelExternalWrenchEstimationWithFTSensors();
 
     return EXIT_SUCCESS;
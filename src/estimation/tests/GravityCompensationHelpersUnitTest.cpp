@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/GravityCompensationHelpers.h>
+
+#include <iDynTree/Model/ModelTestUtils.h>
+
+#include <iDynTree/Core/TestUtils.h>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace iDynTree;
+
+int main()
+{
+    const size_t nrOfSamples = 10;
+    Model model = getRandomModel(15);
+
+    GravityCompensationHelper helper;
+    ASSERT_IS_TRUE(helper.loadModel(model, model.getLinkName(getRandomLinkIndexOfModel(model))));
+
+    FrameIndex floatingFrame = getRandomInteger(0, model.getNrOfFrames()-1);
+    Vector3 gravity;
+    getRandomVector(gravity, -10.0, 10.0);
+
+    const size_t nrOfDOFs = model.getNrOfDOFs();
+    std::vector<double> jointPositions(nrOfSamples*nrOfDOFs), batchTorques(nrOfSamples*nrOfDOFs);
+    for (size_t i = 0; i < jointPositions.size(); i++)
+    {
+        jointPositions[i] = getRandomDouble(-3.0, 3.0);
+    }
+
+    ASSERT_IS_TRUE(helper.getGravityCompensationTorquesBatch(MatrixView<const double>(jointPositions.data(), nrOfSamples, nrOfDOFs),
+                                                             floatingFrame, gravity,
+                                                             MatrixView<double>(batchTorques.data(), nrOfSamples, nrOfDOFs)));
+
+    JointPosDoubleArray jointPos(model);
+    JointDOFsDoubleArray torques(model);
+    for (size_t sample = 0; sample < nrOfSamples; sample++)
+    {
+        for (size_t i = 0; i < nrOfDOFs; i++)
+        {
+            jointPos(i) = jointPositions[sample*nrOfDOFs + i];
+        }
+
+        ASSERT_IS_TRUE(helper.updateKinematicsFromGravity(jointPos, floatingFrame, gravity));
+        ASSERT_IS_TRUE(helper.getGravityCompensationTorques(torques));
+
+        for (size_t i = 0; i < nrOfDOFs; i++)
+        {
+            ASSERT_EQUAL_DOUBLE_TOL(batchTorques[sample*nrOfDOFs + i], torques(i), 1e-10);
+        }
+    }
+
+    ASSERT_IS_FALSE(helper.getGravityCompensationTorquesBatch(MatrixView<const double>(jointPositions.data(), nrOfSamples, nrOfDOFs),
+                                                              floatingFrame, gravity,
+                                                              MatrixView<double>(batchTorques.data(), nrOfSamples - 1, nrOfDOFs)));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/RecursiveInertialParametersEstimator.h>
+
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/InertiaNonLinearParametrization.h>
+#include <iDynTree/Core/MatrixDynSize.h>
+#include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Core/VectorDynSize.h>
+
+#include <iDynTree/Model/Dynamics.h>
+#include <iDynTree/Model/ForwardKinematics.h>
+#include <iDynTree/Model/FreeFloatingState.h>
+#include <iDynTree/Model/LinkState.h>
+#include <iDynTree/Model/Model.h>
+#include <iDynTree/Model/ModelTestUtils.h>
+#include <iDynTree/Model/Traversal.h>
+
+#include <cstdlib>
+
+using namespace iDynTree;
+
+/**
+ * Random state of the model, and the corresponding generalized forces and regressor
+ */
+struct Sample
+{
+    FreeFloatingPos pos;
+    FreeFloatingVel vel;
+    FreeFloatingAcc properAcc;
+    FreeFloatingGeneralizedTorques generalizedForces;
+    MatrixDynSize regressor;
+    VectorDynSize generalizedForcesVector;
+};
+
+Sample getRandomSample(const Model& model, const Traversal& traversal)
+{
+    Sample sample;
+    sample.pos.resize(model);
+    sample.vel.resize(model);
+    sample.properAcc.resize(model);
+    sample.generalizedForces.resize(model);
+
+    sample.pos.worldBasePos() = Transform::Identity();
+    getRandomVector(sample.pos.jointPos(), -3.14, 3.14);
+    sample.vel.baseVel() = getRandomTwist();
+    getRandomVector(sample.vel.jointVel(), -1.0, 1.0);
+    sample.properAcc.baseAcc() = getRandomTwist();
+    getRandomVector(sample.properAcc.jointAcc(), -1.0, 1.0);
+
+    LinkPositions base_H_link(model);
+    LinkVelArray linksVel(model);
+    LinkAccArray linksProperAcc(model);
+    LinkNetExternalWrenches zeroExtWrenches(model);
+    zeroExtWrenches.zero();
+    LinkInternalWrenches linkIntWrenches(model);
+
+    bool ok = ForwardPositionKinematics(model, traversal, sample.pos, base_H_link);
+    ok = ok && ForwardVelAccKinematics(model, traversal, sample.pos, sample.vel, sample.properAcc, linksVel, linksProperAcc);
+    ok = ok && RNEADynamicPhase(model, traversal, sample.pos.jointPos(), linksVel, linksProperAcc,
+                                zeroExtWrenches, linkIntWrenches, sample.generalizedForces);
+    ok = ok && InverseDynamicsInertialParametersRegressor(model, traversal, base_H_link, linksVel, linksProperAcc,
+                                                          sample.regressor);
+    ASSERT_IS_TRUE(ok);
+
+    sample.generalizedForcesVector.resize(6 + model.getNrOfDOFs());
+    toEigen(sample.generalizedForcesVector).head<6>() = toEigen(sample.generalizedForces.baseWrench());
+    toEigen(sample.generalizedForcesVector).tail(model.getNrOfDOFs()) = toEigen(sample.generalizedForces.jointTorques());
+
+    return sample;
+}
+
+bool update(RecursiveInertialParametersEstimator& estimator, const Sample& sample)
+{
+    return estimator.update(sample.pos.jointPos(), sample.vel.baseVel(), sample.vel.jointVel(),
+                            sample.properAcc.baseAcc(), sample.properAcc.jointAcc(), sample.generalizedForces);
+}
+
+void checkPredictedGeneralizedForces(const Model& model, const Traversal& traversal, const VectorDynSize& params)
+{
+    for (size_t i = 0; i < 10; i++)
+    {
+        Sample sample = getRandomSample(model, traversal);
+        VectorDynSize predicted(sample.generalizedForcesVector.size());
+        toEigen(predicted) = toEigen(sample.regressor)*toEigen(params);
+        ASSERT_EQUAL_VECTOR_TOL(predicted, sample.generalizedForcesVector, 1e-5);
+    }
+}
+
+void checkPhysicalConsistency(const Model& model, const VectorDynSize& params, const double minimumLinkMass)
+{
+    for (size_t link = 0; link < model.getNrOfLinks(); link++)
+    {
+        Vector10 linkParams;
+        toEigen(linkParams) = toEigen(params).segment<10>(10*link);
+        RigidBodyInertiaNonLinearParametrization linkParametrization;
+        linkParametrization.fromInertialParameters(linkParams);
+        // The projection can put the central second moments of mass on the boundary of the consistent set
+        ASSERT_IS_TRUE(linkParametrization.mass > 0.0);
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            ASSERT_IS_TRUE(linkParametrization.centralSecondMomentOfMass(i) >= -1e-9);
+        }
+        ASSERT_IS_TRUE(linkParams(0) >= minimumLinkMass - 1e-12);
+    }
+}
+
+void testConvergence(const Model& model)
+{
+    Traversal traversal;
+    ASSERT_IS_TRUE(model.computeFullTreeTraversal(traversal));
+
+    RecursiveInertialParametersEstimator estimator;
+    ASSERT_IS_TRUE(estimator.setModel(model));
+    ASSERT_EQUAL_DOUBLE(estimator.getNrOfInertialParameters(), 10*model.getNrOfLinks());
+    ASSERT_EQUAL_DOUBLE(estimator.getNrOfMeasurements(), 6 + model.getNrOfDOFs());
+
+    // Before any sample, the estimate is the prior, i.e. the parameters of the model
+    VectorDynSize trueParams;
+    model.getInertialParameters(trueParams);
+    ASSERT_IS_TRUE(estimator.computeEstimate());
+    ASSERT_EQUAL_VECTOR_TOL(estimator.getUnconstrainedInertialParameters(), trueParams, 1e-9);
+
+    // Start from a wrong prior
+    VectorDynSize wrongParams = trueParams;
+    for (size_t i = 0; i < wrongParams.size(); i++)
+    {
+        wrongParams(i) += getRandomDouble(-0.5, 0.5);
+    }
+    ASSERT_IS_TRUE(estimator.setPriorInertialParameters(wrongParams));
+    ASSERT_IS_TRUE(estimator.setPriorWeight(1e-6));
+    estimator.reset();
+
+    // The same samples are passed with the precomputed regressor to a second estimator
+    RecursiveInertialParametersEstimator estimatorWithRegressor;
+    ASSERT_IS_TRUE(estimatorWithRegressor.setModel(model));
+    ASSERT_IS_TRUE(estimatorWithRegressor.setPriorInertialParameters(wrongParams));
+    ASSERT_IS_TRUE(estimatorWithRegressor.setPriorWeight(1e-6));
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        Sample sample = getRandomSample(model, traversal);
+        ASSERT_IS_TRUE(update(estimator, sample));
+        ASSERT_IS_TRUE(estimatorWithRegressor.updateWithRegressor(sample.regressor,
+                                                                  make_span(sample.generalizedForcesVector)));
+    }
+    ASSERT_EQUAL_DOUBLE(estimator.getNrOfProcessedSamples(), 100);
+
+    ASSERT_IS_TRUE(estimator.computeEstimate());
+    ASSERT_IS_TRUE(estimatorWithRegressor.computeEstimate());
+
+    // The parameters that are not identifiable are only determined by the prior, so the
+    // two estimates are compared through the generalized forces they predict
+    checkPredictedGeneralizedForces(model, traversal, estimator.getUnconstrainedInertialParameters());
+    checkPredictedGeneralizedForces(model, traversal, estimatorWithRegressor.getUnconstrainedInertialParameters());
+    checkPhysicalConsistency(model, estimator.getEstimatedInertialParameters(), 1e-3);
+}
+
+void testPayloadChange(const Model& model)
+{
+    Traversal traversal;
+    ASSERT_IS_TRUE(model.computeFullTreeTraversal(traversal));
+
+    RecursiveInertialParametersEstimator estimator;
+    ASSERT_IS_TRUE(estimator.setModel(model));
+    ASSERT_IS_TRUE(estimator.setForgettingFactor(0.9));
+    ASSERT_IS_TRUE(estimator.setPriorWeight(1e-6));
+
+    // Only the joint torques are measured
+    VectorDynSize weights(estimator.getNrOfMeasurements());
+    toEigen(weights).setOnes();
+    toEigen(weights).head<6>().setZero();
+    ASSERT_IS_TRUE(estimator.setMeasurementsWeights(weights));
+
+    for (size_t i = 0; i < 50; i++)
+    {
+        ASSERT_IS_TRUE(update(estimator, getRandomSample(model, traversal)));
+    }
+
+    // Add a payload to a random link
+    Model modelWithPayload = model;
+    LinkIndex payloadLink = getRandomLinkIndexOfModel(model);
+    SpatialInertia payload(2.0, getRandomPosition(), RotationalInertiaRaw::Zero());
+    SpatialInertia inertiaWithPayload = model.getLink(payloadLink)->getInertia() + payload;
+    modelWithPayload.getLink(payloadLink)->setInertia(inertiaWithPayload);
+
+    for (size_t i = 0; i < 500; i++)
+    {
+        ASSERT_IS_TRUE(update(estimator, getRandomSample(modelWithPayload, traversal)));
+    }
+
+    ASSERT_IS_TRUE(estimator.computeEstimate());
+
+    // Only the joint torques can be predicted
+    for (size_t i = 0; i < 10; i++)
+    {
+        Sample sample = getRandomSample(modelWithPayload, traversal);
+        VectorDynSize predicted(sample.generalizedForcesVector.size());
+        toEigen(predicted) = toEigen(sample.regressor)*toEigen(estimator.getUnconstrainedInertialParameters());
+        for (size_t dof = 0; dof < model.getNrOfDOFs(); dof++)
+        {
+            ASSERT_EQUAL_DOUBLE_TOL(predicted(6 + dof), sample.generalizedForcesVector(6 + dof), 1e-5);
+        }
+    }
+}
+
+void testInvalidInputs(const Model& model)
+{
+    RecursiveInertialParametersEstimator estimator;
+    ASSERT_IS_FALSE(estimator.isValid());
+    ASSERT_IS_FALSE(estimator.computeEstimate());
+    ASSERT_IS_FALSE(estimator.setModel(model, "notExistingLink"));
+
+    ASSERT_IS_TRUE(estimator.setModel(model, model.getLinkName(getRandomLinkIndexOfModel(model))));
+    ASSERT_IS_TRUE(estimator.isValid());
+    ASSERT_IS_FALSE(estimator.setForgettingFactor(0.0));
+    ASSERT_IS_FALSE(estimator.setForgettingFactor(1.1));
+    ASSERT_IS_FALSE(estimator.setPriorWeight(-1.0));
+    ASSERT_IS_FALSE(estimator.setMinimumLinkMass(0.0));
+    ASSERT_IS_FALSE(estimator.setPriorInertialParameters(VectorDynSize(3)));
+    ASSERT_IS_FALSE(estimator.setMeasurementsWeights(VectorDynSize(estimator.getNrOfMeasurements() + 1)));
+
+    MatrixDynSize wrongRegressor(estimator.getNrOfMeasurements(), estimator.getNrOfInertialParameters() + 1);
+    VectorDynSize generalizedForces(estimator.getNrOfMeasurements());
+    ASSERT_IS_FALSE(estimator.updateWithRegressor(wrongRegressor, make_span(generalizedForces)));
+
+    // Without prior and without samples, the information matrix is singular
+    ASSERT_IS_TRUE(estimator.setPriorWeight(0.0));
+    ASSERT_IS_FALSE(estimator.computeEstimate());
+}
+
+int main()
+{
+    for (unsigned int joints = 0; joints < 10; joints += 3)
+    {
+        Model model = getRandomModel(joints);
+        testConvergence(model);
+        testPayloadChange(model);
+        testInvalidInputs(model);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -65,6 +65,50 @@ void setDOFsSubSetPositionsInDegrees(const iDynTree::Model & model,
     }
 }
 
+void testPartialForwardKinematics(const iDynTree::Model & model)
+{
+    SimpleLeggedOdometry fullOdometry, partialOdometry;
+    ASSERT_IS_TRUE(fullOdometry.setModel(model));
+    ASSERT_IS_TRUE(partialOdometry.setModel(model));
+    partialOdometry.setUsePartialForwardKinematics(true);
+    ASSERT_IS_TRUE(partialOdometry.usePartialForwardKinematics());
+
+    Transform l_sole_H_world = iDynTree::getRandomTransform();
+    ASSERT_IS_TRUE(fullOdometry.init("l_sole",l_sole_H_world));
+    ASSERT_IS_TRUE(partialOdometry.init("l_sole",l_sole_H_world));
+
+    std::vector<std::string> fixedFrames;
+    fixedFrames.push_back("r_sole");
+    fixedFrames.push_back("head");
+    fixedFrames.push_back("l_sole");
+
+    // Joint positions of the wrong size are rejected
+    JointPosDoubleArray wrongSizeQj(model.getNrOfPosCoords() + 1);
+    ASSERT_IS_FALSE(fullOdometry.updateKinematics(wrongSizeQj));
+    ASSERT_IS_FALSE(partialOdometry.updateKinematics(wrongSizeQj));
+
+    JointPosDoubleArray qj(model);
+    for(int tick=0; tick < 30; tick++)
+    {
+        getRandomVector(qj,-1.0,1.0);
+        ASSERT_IS_TRUE(fullOdometry.updateKinematics(qj));
+        ASSERT_IS_TRUE(partialOdometry.updateKinematics(qj));
+
+        if( tick % 5 == 4 )
+        {
+            std::string newFixedFrame = fixedFrames[(tick/5) % fixedFrames.size()];
+            ASSERT_IS_TRUE(fullOdometry.changeFixedFrame(newFixedFrame));
+            ASSERT_IS_TRUE(partialOdometry.changeFixedFrame(newFixedFrame));
+            ASSERT_EQUAL_STRING(fullOdometry.getCurrentFixedLink(),partialOdometry.getCurrentFixedLink());
+        }
+
+        for(FrameIndex frame=0; frame < static_cast<FrameIndex>(model.getNrOfFrames()); frame++)
+        {
+            ASSERT_EQUAL_TRANSFORM(fullOdometry.getWorldFrameTransform(frame),
+                                   partialOdometry.getWorldFrameTransform(frame));
+        }
+    }
+}
 
 int main()
 {
@@ -108,6 +152,7 @@ int main()
     std::vector<std::string> dofNames;
     std::vector<double> dofPositionsInDegrees;
 
+    testPartialForwardKinematics(simpleOdometry.model());
 
     return EXIT_SUCCESS;
 }
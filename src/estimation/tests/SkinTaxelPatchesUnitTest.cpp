@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Estimation/SkinTaxelPatches.h>
+#include <iDynTree/Estimation/ExternalWrenchesEstimation.h>
+
+#include <iDynTree/Model/Model.h>
+#include <iDynTree/Model/ModelTestUtils.h>
+
+#include <iDynTree/Core/TestUtils.h>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace iDynTree;
+
+const size_t nrOfPatches = 6;
+
+struct TestPatch
+{
+    FrameIndex frame;
+    std::vector<double> positions;
+    std::vector<double> normals;
+};
+
+std::vector<TestPatch> addRandomPatches(const Model& model, SkinTaxelPatches& skin)
+{
+    std::vector<TestPatch> patches;
+    for (size_t patch = 0; patch < nrOfPatches; patch++)
+    {
+        TestPatch testPatch;
+        testPatch.frame = model.getNrOfLinks() + (rand() % (model.getNrOfFrames() - model.getNrOfLinks()));
+
+        size_t nrOfTaxels = 1 + rand() % 200;
+        for (size_t taxel = 0; taxel < nrOfTaxels; taxel++)
+        {
+            Direction normal = getRandomAxis().getDirection();
+            Position position = getRandomPosition();
+            for (size_t i = 0; i < 3; i++)
+            {
+                testPatch.normals.push_back(normal(i));
+                testPatch.positions.push_back(position(i));
+            }
+        }
+
+        ASSERT_IS_TRUE(skin.addPatch(model.getFrameName(testPatch.frame),
+                                     MatrixView<const double>(testPatch.positions.data(), nrOfTaxels, 3),
+                                     MatrixView<const double>(testPatch.normals.data(), nrOfTaxels, 3),
+                                     100 + patch));
+        patches.push_back(testPatch);
+    }
+
+    return patches;
+}
+
+void testNetWrenches(const Model& model, const SkinTaxelPatches& skin, const std::vector<TestPatch>& patches)
+{
+    std::vector<double> taxelForces(skin.getNrOfTaxels());
+    for (size_t taxel = 0; taxel < taxelForces.size(); taxel++)
+    {
+        taxelForces[taxel] = getRandomDouble(0.0, 2.0);
+    }
+
+    LinkNetExternalWrenches expected(model);
+    expected.zero();
+    std::vector<double> expectedPatchWrenches(6*nrOfPatches, 0.0);
+    for (size_t patch = 0; patch < nrOfPatches; patch++)
+    {
+        Transform link_H_frame = model.getFrameTransform(patches[patch].frame);
+        size_t offset = skin.getTaxelsOffsetOfPatch(patch);
+        Wrench patchWrench;
+        patchWrench.zero();
+        for (size_t taxel = 0; taxel < skin.getNrOfTaxelsOfPatch(patch); taxel++)
+        {
+            const double* p = patches[patch].positions.data() + 3*taxel;
+            const double* n = patches[patch].normals.data() + 3*taxel;
+            double f = taxelForces[offset + taxel];
+            Transform frame_H_taxel(Rotation::Identity(), Position(p[0], p[1], p[2]));
+            Wrench taxelWrench(Force(-f*n[0], -f*n[1], -f*n[2]), Torque(0.0, 0.0, 0.0));
+            patchWrench = patchWrench + link_H_frame*(frame_H_taxel*taxelWrench);
+        }
+
+        LinkIndex link = model.getFrameLink(patches[patch].frame);
+        ASSERT_EQUAL_DOUBLE(skin.getLinkOfPatch(patch), link);
+        expected(link) = expected(link) + patchWrench;
+        for (size_t i = 0; i < 6; i++)
+        {
+            expectedPatchWrenches[6*patch + i] = patchWrench(i);
+        }
+    }
+
+    std::vector<double> patchWrenches(6*nrOfPatches);
+    ASSERT_IS_TRUE(skin.computePatchesWrenches(make_span(taxelForces),
+                                               MatrixView<double>(patchWrenches.data(), nrOfPatches, 6)));
+    for (size_t i = 0; i < patchWrenches.size(); i++)
+    {
+        ASSERT_EQUAL_DOUBLE_TOL(patchWrenches[i], expectedPatchWrenches[i], 1e-9);
+    }
+
+    LinkNetExternalWrenches netWrenches;
+    ASSERT_IS_TRUE(skin.computeLinkNetExternalWrenches(make_span(taxelForces), netWrenches));
+    ASSERT_EQUAL_DOUBLE(netWrenches.getNrOfLinks(), model.getNrOfLinks());
+    for (LinkIndex link = 0; link < static_cast<LinkIndex>(model.getNrOfLinks()); link++)
+    {
+        ASSERT_EQUAL_VECTOR_TOL(netWrenches(link), expected(link), 1e-9);
+    }
+
+    std::vector<double> wrongSizeForces(skin.getNrOfTaxels() + 1, 0.0);
+    ASSERT_IS_FALSE(skin.computeLinkNetExternalWrenches(make_span(wrongSizeForces), netWrenches));
+}
+
+void testUnknownContacts(const Model& model, SkinTaxelPatches& skin, const std::vector<TestPatch>& patches)
+{
+    // Only the taxels of the first and last patch are active, and only the first taxel of the last patch
+    const double threshold = 0.5;
+    std::vector<double> taxelForces(skin.getNrOfTaxels(), 0.2);
+    for (size_t taxel = 0; taxel < skin.getNrOfTaxelsOfPatch(0); taxel++)
+    {
+        taxelForces[taxel] = getRandomDouble(1.0, 2.0);
+    }
+    const size_t lastPatch = nrOfPatches - 1;
+    taxelForces[skin.getTaxelsOffsetOfPatch(lastPatch)] = 3.0;
+
+    LinkUnknownWrenchContacts unknowns(model);
+    ASSERT_IS_TRUE(skin.computeUnknownWrenchContacts(make_span(taxelForces), threshold, unknowns));
+
+    size_t nrOfContacts = 0;
+    for (LinkIndex link = 0; link < static_cast<LinkIndex>(model.getNrOfLinks()); link++)
+    {
+        nrOfContacts += unknowns.getNrOfContactsForLink(link);
+    }
+    ASSERT_EQUAL_DOUBLE(nrOfContacts, 2);
+
+    // The contact of the last patch is on its only active taxel
+    size_t patchIndex = 0;
+    ASSERT_IS_TRUE(skin.getPatchIndex(100 + lastPatch, patchIndex));
+    ASSERT_EQUAL_DOUBLE(patchIndex, lastPatch);
+    ASSERT_IS_FALSE(skin.getPatchIndex(99, patchIndex));
+
+    LinkIndex link = skin.getLinkOfPatch(lastPatch);
+    const UnknownWrenchContact& contact = unknowns.contactWrench(link, unknowns.getNrOfContactsForLink(link) - 1);
+    ASSERT_EQUAL_DOUBLE(contact.contactId, 100 + lastPatch);
+    ASSERT_IS_TRUE(contact.unknownType == PURE_FORCE_WITH_KNOWN_DIRECTION);
+
+    Transform link_H_frame = model.getFrameTransform(patches[lastPatch].frame);
+    const double* p = patches[lastPatch].positions.data();
+    const double* n = patches[lastPatch].normals.data();
+    Position expectedContactPoint = link_H_frame*Position(p[0], p[1], p[2]);
+    Direction expectedDirection = link_H_frame.getRotation()*Direction(-n[0], -n[1], -n[2]);
+    ASSERT_EQUAL_VECTOR_TOL(contact.contactPoint, expectedContactPoint, 1e-9);
+    ASSERT_EQUAL_VECTOR_TOL(contact.forceDirection, expectedDirection, 1e-9);
+}
+
+void testInvalidPatches(const Model& model)
+{
+    SkinTaxelPatches skin;
+    ASSERT_IS_TRUE(skin.init(model));
+
+    std::vector<double> positions(9, 0.0), normals(9, 0.0);
+    normals[2] = normals[5] = normals[8] = 1.0;
+    ASSERT_IS_FALSE(skin.addPatch("notExistingFrame",
+                                  MatrixView<const double>(positions.data(), 3, 3),
+                                  MatrixView<const double>(normals.data(), 3, 3), 0));
+    ASSERT_IS_FALSE(skin.addPatch(model.getFrameName(0),
+                                  MatrixView<const double>(positions.data(), 3, 3),
+                                  MatrixView<const double>(normals.data(), 2, 3), 0));
+    ASSERT_IS_TRUE(skin.addPatch(model.getFrameName(0),
+                                 MatrixView<const double>(positions.data(), 3, 3),
+                                 MatrixView<const double>(normals.data(), 3, 3), 0));
+    ASSERT_IS_FALSE(skin.addPatch(model.getFrameName(0),
+                                  MatrixView<const double>(positions.data(), 3, 3),
+                                  MatrixView<const double>(normals.data(), 3, 3), 0));
+    normals[5] = 0.0;
+    ASSERT_IS_FALSE(skin.addPatch(model.getFrameName(0),
+                                  MatrixView<const double>(positions.data(), 3, 3),
+                                  MatrixView<const double>(normals.data(), 3, 3), 1));
+    ASSERT_EQUAL_DOUBLE(skin.getNrOfPatches(), 1);
+    ASSERT_EQUAL_DOUBLE(skin.getNrOfTaxels(), 3);
+}
+
+int main()
+{
+    Model model = getRandomModel(20);
+
+    SkinTaxelPatches skin;
+    ASSERT_IS_TRUE(skin.init(model));
+    std::vector<TestPatch> patches = addRandomPatches(model, skin);
+    ASSERT_EQUAL_DOUBLE(skin.getNrOfPatches(), nrOfPatches);
+
+    testNetWrenches(model, skin, patches);
+    testUnknownContacts(model, skin, patches);
+    testInvalidPatches(model);
+
+    return EXIT_SUCCESS;
+}
@@ -175,15 +175,15 @@ public:
     /** Internal wrenches, in body-fixed representation */
     LinkInternalWrenches m_invDynInternalWrenches;
 
-    /** Buffer of robot velocity, always set to zero for gravity computations */
-    FreeFloatingVel m_invDynZeroVel;
-
-    /** Buffer of link velocities, always set to zero for gravity computations */
+    /** Buffer of link velocities, always set to zero for external forces */
     LinkVelArray m_invDynZeroLinkVel;
 
     /** Buffer of link proper accelerations, always set to zero for external forces */
     LinkAccArray m_invDynZeroLinkProperAcc;
 
+    /** Buffers of the gravity-only inverse dynamics */
+    GravityGeneralizedForcesInternalBuffers m_gravityForcesBuffers;
+
     KinDynComputationsPrivateAttributes()
     {
         m_isModelValid = false;
@@ -346,11 +346,9 @@ void KinDynComputations::resizeInternalDataStructures()
     this->pimpl->m_invDynNetExtWrenches.resize(this->pimpl->m_robot_model);
     this->pimpl->m_invDynInternalWrenches.resize(this->pimpl->m_robot_model);
     this->pimpl->m_invDynLinkProperAccs.resize(this->pimpl->m_robot_model);
-    this->pimpl->m_invDynZeroVel.resize(this->pimpl->m_robot_model);
-    this->pimpl->m_invDynZeroVel.baseVel().zero();
-    this->pimpl->m_invDynZeroVel.jointVel().zero();
     this->pimpl->m_invDynZeroLinkVel.resize(this->pimpl->m_robot_model);
     this->pimpl->m_invDynZeroLinkProperAcc.resize(this->pimpl->m_robot_model);
+    this->pimpl->m_gravityForcesBuffers.resize(this->pimpl->m_robot_model);
     this->pimpl->m_traversalCache.resize(this->pimpl->m_robot_model);
     this->pimpl->m_generalizedForcesContainer.resize(this->pimpl->m_robot_model);
 
@@ -2841,33 +2839,19 @@ bool KinDynComputations::generalizedBiasForces(Span<double> generalizedBiasForce
 
 bool KinDynComputations::generalizedGravityForces(FreeFloatingGeneralizedTorques & generalizedGravityForces)
 {
-    // Clear input buffers that need to be cleared
-    for(LinkIndex lnkIdx = 0; lnkIdx < static_cast<LinkIndex>(pimpl->m_robot_model.getNrOfLinks()); lnkIdx++)
-    {
-        pimpl->m_invDynNetExtWrenches(lnkIdx).zero();
-    }
-    pimpl->m_invDynGeneralizedProperAccs.baseAcc().zero();
-    toEigen(pimpl->m_invDynGeneralizedProperAccs.baseAcc().getLinearVec3()) =
-            - toEigen(pimpl->m_gravityAccInBaseLinkFrame);
-    pimpl->m_invDynGeneralizedProperAccs.jointAcc().zero();
-
-    // Run inverse dynamics
-    ForwardAccKinematics(pimpl->m_robot_model,
-                         pimpl->m_traversal,
-                         pimpl->m_pos,
-                         pimpl->m_invDynZeroVel,
-                         pimpl->m_invDynGeneralizedProperAccs,
-                         pimpl->m_invDynZeroLinkVel,
-                         pimpl->m_invDynLinkProperAccs);
-
-    RNEADynamicPhase(pimpl->m_robot_model,
-                     pimpl->m_traversal,
-                     pimpl->m_pos.jointPos(),
-                     pimpl->m_invDynZeroLinkVel,
-                     pimpl->m_invDynLinkProperAccs,
-                     pimpl->m_invDynNetExtWrenches,
-                     pimpl->m_invDynInternalWrenches,
-                     generalizedGravityForces);
+    // With zero velocities and accelerations, the proper acceleration
+    // of the base is just minus the gravity acceleration
+    Vector3 baseProperLinearAcc;
+    toEigen(baseProperLinearAcc) = -toEigen(pimpl->m_gravityAccInBaseLinkFrame);
+
+    // Run the gravity-only inverse dynamics
+    ComputeGravityGeneralizedForces(pimpl->m_robot_model,
+                                    pimpl->m_traversal,
+                                    pimpl->m_pos.jointPos(),
+                                    pimpl->m_traversal.getBaseLink()->getIndex(),
+                                    baseProperLinearAcc,
+                                    pimpl->m_gravityForcesBuffers,
+                                    generalizedGravityForces);
 
 
     // Convert output base force
@@ -263,6 +263,36 @@ void testInverseDynamics(KinDynComputations & dynComp)
     }
 }
 
+void testGravityForces(KinDynComputations & dynComp)
+{
+    size_t dofs = dynComp.getNrOfDegreesOfFreedom();
+    Transform worldTbase;
+    Twist baseVel;
+    Vector3 gravity;
+    iDynTree::VectorDynSize qj(dofs), dqj(dofs);
+    dynComp.getRobotState(worldTbase, qj, baseVel, dqj, gravity);
+
+    // With zero velocities the bias forces are equal to the gravity forces
+    Twist zeroBaseVel;
+    zeroBaseVel.zero();
+    iDynTree::VectorDynSize zeroDqj(dofs);
+    zeroDqj.zero();
+    bool ok = dynComp.setRobotState(worldTbase, qj, zeroBaseVel, zeroDqj, gravity);
+    ASSERT_IS_TRUE(ok);
+
+    FreeFloatingGeneralizedTorques biasForces(dynComp.model());
+    FreeFloatingGeneralizedTorques gravityForces(dynComp.model());
+    ok = dynComp.generalizedBiasForces(biasForces);
+    ok = ok && dynComp.generalizedGravityForces(gravityForces);
+    ASSERT_IS_TRUE(ok);
+
+    ASSERT_EQUAL_SPATIAL_FORCE(gravityForces.baseWrench(), biasForces.baseWrench());
+    ASSERT_EQUAL_VECTOR(gravityForces.jointTorques(), biasForces.jointTorques());
+
+    ok = dynComp.setRobotState(worldTbase, qj, baseVel, dqj, gravity);
+    ASSERT_IS_TRUE(ok);
+}
+
 void testRelativeJacobians(KinDynComputations & dynComp)
 {
     if (dynComp.getNrOfLinks() < 2) return;
@@ -410,6 +440,7 @@ void testModelConsistency(std::string modelFilePath, const FrameVelocityRepresen
         testRelativeTransform(dynComp);
         testAverageVelocityAndTotalMomentumJacobian(dynComp);
         testInverseDynamics(dynComp);
+        testGravityForces(dynComp);
         testRelativeJacobians(dynComp);
         testAbsoluteJacobiansAndFrameBiasAcc(dynComp);
     }
@@ -117,6 +117,146 @@ namespace iDynTree
         const Vector2 & operator()(const size_t idx) const;
     };
 
+    /**
+     * Convex hull of a set of 2D points, that can be updated incrementally.
+     *
+     * Each point is identified by the id returned by addPoint, so that the points of a support
+     * polygon can be removed when the corresponding contact is broken.
+     * Adding a point inside the hull or removing a point that is not a vertex of the hull
+     * does not change the hull. Adding a point outside the hull only replaces the sides visible
+     * from the point, while removing a vertex of the hull rebuilds the hull from the remaining points.
+     *
+     * The sides of the hull are also stored as half-planes with unit normals, so that
+     * checking if a point is in the hull and computing its distance from the boundary
+     * do not require any memory allocation.
+     */
+    class ConvexHull2D
+    {
+        std::vector<Vector2> m_points;
+        std::vector<bool> m_isPointUsed;
+        std::vector<size_t> m_unusedPointIDs;
+        size_t m_nrOfPoints;
+
+        std::vector<size_t> m_hullPointIDs;
+        Polygon2D m_convexHull;
+        MatrixDynSize m_halfPlanesMatrix;
+        VectorDynSize m_halfPlanesVector;
+        std::vector<double> m_sidesLengths;
+
+        // Workspaces of the hull updates, to avoid allocating memory at each update
+        std::vector<size_t> m_sortedPointIDs;
+        std::vector<bool> m_isSideVisible;
+        std::vector<size_t> m_newHullPointIDs;
+
+        size_t storePoint(const Vector2& point);
+        bool releasePoint(const size_t pointID, bool& isHullVertex);
+        void rebuildConvexHull();
+        void insertPointInConvexHull(size_t pointID);
+        void updateHalfPlanes();
+
+    public:
+        /**
+         * Default constructor: build an empty set of points.
+         */
+        ConvexHull2D();
+
+        /**
+         * Remove all the points.
+         */
+        void clear();
+
+        /**
+         * Set the points, computing the convex hull with the Monotone Chain algorithm.
+         *
+         * The ids of the points are their indices in the input vector.
+         */
+        void setPoints(const std::vector<Vector2>& points);
+
+        /**
+         * Add a point.
+         * @return the id of the point, to be used to remove it.
+         */
+        size_t addPoint(const Vector2& point);
+
+        /**
+         * Add several points.
+         *
+         * If the convex hull is not valid, it is rebuilt once after adding all the points.
+         * @param[out] pointIDs the ids of the points, to be used to remove them. Resized if necessary.
+         */
+        void addPoints(const std::vector<Vector2>& points, std::vector<size_t>& pointIDs);
+
+        /**
+         * Remove a point.
+         * @return true if the point was removed, false if the id does not correspond to a point.
+         */
+        bool removePoint(const size_t pointID);
+
+        /**
+         * Remove several points.
+         *
+         * The convex hull is rebuilt at most once, even if several of its vertices are removed.
+         * @return true if all the points were removed, false if some ids do not correspond to a point
+         *         (the other points are removed anyway).
+         */
+        bool removePoints(const std::vector<size_t>& pointIDs);
+
+        /**
+         * Get the number of points (not only the vertices of the convex hull).
+         */
+        size_t getNrOfPoints() const;
+
+        /**
+         * Check if the convex hull is valid, i.e. if it has at least three vertices.
+         */
+        bool isValid() const;
+
+        /**
+         * Get the convex hull.
+         *
+         * The vertices are in counter-clockwise order, starting from the one with the lowest
+         * x (and the lowest y among the ones with the same x). Collinear points are not vertices.
+         */
+        const Polygon2D& getConvexHull() const;
+
+        /**
+         * Get the matrix A of the half-plane representation of the convex hull.
+         *
+         * The i-th row is the outward unit normal of the side from the vertex i to the vertex i+1,
+         * so that A x <= b iff x is in the convex hull, and b(i) - A(i, :) x is the distance of x
+         * from the line of the i-th side.
+         */
+        const MatrixDynSize& getHalfPlanesMatrix() const;
+
+        /**
+         * Get the vector b of the half-plane representation of the convex hull.
+         * @see getHalfPlanesMatrix
+         */
+        const VectorDynSize& getHalfPlanesVector() const;
+
+        /**
+         * Check if a point is in the convex hull.
+         * @param tolerance the point is considered inside if its distance from the convex hull is less than the tolerance.
+         */
+        bool contains(const Vector2& point, const double tolerance = 0.0) const;
+
+        /**
+         * Compute the distance of a point from the boundary of the convex hull.
+         *
+         * The distance is positive if the point is inside the convex hull,
+         * zero if the point is on the boundary of the convex hull,
+         * and negative if it is outside of the convex hull.
+         * @note the convex hull should be valid.
+         */
+        double computeMargin(const Vector2& point) const;
+
+        /**
+         * Compute the margin (see computeMargin) of several points.
+         * @param[out] margins the margins of the points, resized if necessary.
+         */
+        void computeMargins(const std::vector<Vector2>& points, VectorDynSize& margins) const;
+    };
+
     /**
      * ConvexHullProjectionConstraint helper.
      *
@@ -133,6 +273,41 @@ namespace iDynTree
          * Flag to specify if the constraint is active or not.
          */
         bool m_isActive;
+
+        /**
+         * Projected convex hull, with its half-plane representation.
+         */
+        ConvexHull2D m_convexHull;
+
+        /**
+         * Projected points of the support polygons used in the last call to buildConvexHull,
+         * and their ids in m_convexHull.
+         */
+        std::vector<Vector2> m_projectedPoints;
+        std::vector<size_t> m_projectedPointIDs;
+
+        /**
+         * Workspaces of updateConvexHullPoints, to avoid allocating memory at each call.
+         */
+        std::vector<size_t> m_sortedOldPointIndices;
+        std::vector<size_t> m_sortedNewPointIndices;
+        std::vector<bool> m_isOldPointKept;
+        std::vector<bool> m_isNewPointKept;
+        std::vector<Vector2> m_newProjectedPoints;
+        std::vector<size_t> m_newProjectedPointIDs;
+        std::vector<size_t> m_removedPointIDs;
+        std::vector<Vector2> m_addedPoints;
+        std::vector<size_t> m_addedPointIDs;
+
+        /**
+         * Update the points of m_convexHull: the points of the previous call that are still
+         * present are kept, the others are removed, and only the new points are added.
+         *
+         * The points are matched sorting them in lexographical order, and two points are
+         * considered the same if their coordinates differ less than a small tolerance,
+         * so that recomputing the same contact transform does not replace its points.
+         */
+        void updateConvexHullPoints(const std::vector<Vector2>& projectedPoints);
     public:
         /**
          * Set if the constraint is active or not.
@@ -195,6 +370,10 @@ namespace iDynTree
         /**
          * Build the projected convex hull.
          *
+         * The convex hull is updated incrementally: the projected points of the supports that did not change
+         * since the previous call are kept, the ones of the broken contacts are removed and the ones of
+         * the new contacts are added.
+         *
          * @param projectionPlaneXaxisInAbsoluteFrame X direction of the projection axis, in the absolute frame.
          * @param projectionPlaneYaxisInAbsoluteFrame Y direction of the projection axis, in the absolute frame.
          * @param supportPolygonsExpressedInSupportFrame Vector of the support polygons, expressed in the support frames.
@@ -249,6 +428,28 @@ namespace iDynTree
          */
         Vector2 projectAlongDirection(iDynTree::Position& posIn3dInAbsoluteFrame);
 
+        /**
+         * Project several points along the direction defined by the projection matrix 'Pdirection'.
+         *
+         * @param[in] positionsIn3dInAbsoluteFrame the points to project
+         * @param[out] projections the projected points, resized if necessary
+         */
+        void projectAlongDirection(const std::vector<iDynTree::Position>& positionsIn3dInAbsoluteFrame,
+                                   std::vector<Vector2>& projections) const;
+
+        /**
+         * Compute the margin (see computeMargin) of the projections along the direction
+         * defined by the projection matrix 'Pdirection' of several points.
+         *
+         * This can be used to check the feasibility of many center of mass positions
+         * without building the convex hull again.
+         *
+         * @param[in] positionsIn3dInAbsoluteFrame the points to project
+         * @param[out] margins the margins of the projected points, resized if necessary
+         */
+        void computeMargins(const std::vector<iDynTree::Position>& positionsIn3dInAbsoluteFrame,
+                            VectorDynSize& margins) const;
+
     };
 }
 
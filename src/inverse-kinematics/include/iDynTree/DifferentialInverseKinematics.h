@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2016 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+
+#ifndef IDYNTREE_DIFFERENTIALINVERSEKINEMATICS_H
+#define IDYNTREE_DIFFERENTIALINVERSEKINEMATICS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <iDynTree/ConvexHullHelpers.h>
+#include <iDynTree/Core/Direction.h>
+
+namespace iDynTree {
+    class VectorDynSize;
+    class Transform;
+    class Position;
+    class Rotation;
+    class Twist;
+    class Model;
+    class Polygon;
+    class DifferentialInverseKinematics;
+}
+
+/*!
+ * \ingroup iDynTreeExperimental
+ *
+ * @brief QP-based differential inverse kinematics
+ *
+ * Fast alternative to iDynTree::InverseKinematics for control loops, in which
+ * the targets move slightly between two consecutive calls. Instead of solving
+ * the full nonlinear problem, each call to solve() computes a single linearized
+ * step \f$ \delta \in \mathbb{R}^{6+n} \f$ around the current configuration,
+ * with the base increment expressed in the mixed representation
+ * (linear and angular part expressed in the world frame), as the solution of the QP
+ * \f[
+ *   \min_{\delta} \sum_i \| J_i \delta - k e_i \|^2_{W_i} + w_q \| \delta_s - k (s^d - s) \|^2 + \lambda \| \delta \|^2
+ * \f]
+ * subject to
+ * \f[
+ *   J_c \delta = k e_c, \quad A P J_{CoM} \delta \leq b - A P (c - o), \quad s_{min} - s \leq \delta_s \leq s_{max} - s,
+ * \f]
+ * where \f$ J_i \f$ and \f$ e_i \f$ are the Jacobian and the error of the i-th target,
+ * \f$ J_c \f$ and \f$ e_c \f$ the ones of the frame constraints, and \f$ k \f$ is the task gain.
+ *
+ * The targets, the frame constraints, the center of mass projection constraint and the joint limits
+ * are specified as in iDynTree::InverseKinematics. The QP is solved with
+ * iDynTree::optimization::OsqpInterface, warm started with the solution of the previous call.
+ * The buffers of the QP are allocated only when the structure of the problem changes, and
+ * the sparsity pattern of the QP does not change otherwise, so that the solver only updates
+ * the values of its matrices.
+ * @note OsqpInterface still rebuilds its sparse copies of the matrices of the QP at each call,
+ *       so solve() is not free of memory allocations.
+ *
+ * Calling solve() and then setCurrentRobotConfiguration() with the returned
+ * configuration iterates a damped Gauss-Newton method on the inverse kinematics problem.
+ *
+ * Example
+ * @code
+ * iDynTree::DifferentialInverseKinematics ik;
+ * ik.setModel(model);
+ * ik.addFrameConstraint("l_sole", l_sole_transform);
+ * ik.addTarget("r_hand", desired_r_hand);
+ * // in the control loop
+ * ik.setCurrentRobotConfiguration(basePose, jointPositions);
+ * ik.updateTarget("r_hand", desired_r_hand);
+ * ik.solve();
+ * ik.getVelocitySolution(dt, baseVelocity, jointVelocities);
+ * @endcode
+ *
+ * @note all the cartesian frames must be specified w.r.t. the same global frame.
+ *
+ * @note The class is usable only if iDynTree is compiled with the IDYNTREE_USES_OSQPEIGEN CMake option
+ *       set to ON, otherwise solve() always fails.
+ *
+ * @warning This class is still in active development, and so API interface can change between iDynTree versions.
+ */
+class iDynTree::DifferentialInverseKinematics
+{
+    class DifferentialInverseKinematicsPimpl;
+    std::unique_ptr<DifferentialInverseKinematicsPimpl> m_pimpl;
+
+    DifferentialInverseKinematics(const DifferentialInverseKinematics&) = delete;
+    DifferentialInverseKinematics& operator=(const DifferentialInverseKinematics&) = delete;
+
+public:
+    /*!
+     * Default constructor
+     */
+    DifferentialInverseKinematics();
+
+    /*!
+     * Destructor
+     */
+    ~DifferentialInverseKinematics();
+
+    /*!
+     * @brief set the kinematic model to be used in the optimization
+     *
+     * All the degrees of freedom listed in the second parameters will be used as
+     * optimization variables.
+     * If the vector is empty, all the joints will be used.
+     *
+     * @param model the kinematic model to be used in the optimization
+     * @param consideredJoints list of joints used as optimization variables
+     * @return true if successful. False otherwise
+     */
+    bool setModel(const iDynTree::Model &model,
+                  const std::vector<std::string> &consideredJoints = std::vector<std::string>());
+
+    /*!
+     * Set new joint limits
+     *
+     * @param jointLimits vector of new joint limits to be imposed, one for each dof of the model
+     * @return true if successful, false otherwise
+     */
+    bool setJointLimits(const std::vector<std::pair<double, double> >& jointLimits);
+
+    /*!
+     * Get current joint limits
+     *
+     * @param jointLimits vector of current joint limits
+     * @return true if successful, false otherwise
+     */
+    bool getJointLimits(std::vector<std::pair<double, double> >& jointLimits) const;
+
+    /*!
+     * Reset the variables.
+     * @note the model is not removed
+     */
+    void clearProblem();
+
+    /*!
+     * Sets the robot configuration around which the problem is linearized
+     *
+     * @param baseConfiguration  the base pose
+     * @param jointConfiguration the joints configuration, one for each dof of the model
+     * @return true if successful, false otherwise.
+     */
+    bool setCurrentRobotConfiguration(const iDynTree::Transform& baseConfiguration,
+                                      const iDynTree::VectorDynSize& jointConfiguration);
+
+    /*!
+     * Set the gain used to compute the desired variation of the tasks from their errors.
+     *
+     * A gain of 1 (default) asks to recover the whole error in a single step, while smaller
+     * values distribute the correction over several calls to solve().
+     *
+     * @param gain task gain, in the (0, 1] interval
+     */
+    void setTaskGain(const double gain);
+
+    /*!
+     * Get the gain used to compute the desired variation of the tasks.
+     */
+    double taskGain() const;
+
+    /*!
+     * Set the weight of the regularization term on the norm of the step (default 1e-6).
+     *
+     * The term makes the QP strictly convex and damps the solution close to singular configurations.
+     *
+     * @param weight regularization weight, strictly positive
+     */
+    void setRegularizationWeight(const double weight);
+
+    /*!
+     * Get the weight of the regularization term on the norm of the step.
+     */
+    double regularizationWeight() const;
+
+    /*!
+     * Sets the maximum number of iterations of the QP solver (default 4000).
+     */
+    void setMaxIterations(const int max_iter);
+
+    /*!
+     * Gets the maximum number of iterations of the QP solver.
+     */
+    int maxIterations() const;
+
+    /*!
+     * Sets the absolute and relative tolerance on the primal and dual residuals of the QP solver (default 1e-5).
+     */
+    void setTolerance(const double tol);
+
+    /*!
+     * Gets the tolerance of the QP solver.
+     */
+    double tolerance() const;
+
+    /*!
+     * Adds a (constancy) constraint for the specified frame
+     *
+     * The constraint is \f$ {}^w X_{frame}(q) = {}^w X_{frame}^d \f$, with explicit constraint value
+     *
+     * @param frameName the name of the frame on which to attach the constraint
+     * @param constraintValue the value of the constraint
+     * @return true if successful, false otherwise.
+     */
+    bool addFrameConstraint(const std::string& frameName,
+                            const iDynTree::Transform& constraintValue);
+
+    /*!
+     * Adds a (constancy) position constraint for the specified frame
+     *
+     * @param frameName the name of the frame on which to attach the constraint
+     * @param constraintValue the value of the constraint
+     * @return true if successful, false otherwise.
+     */
+    bool addFramePositionConstraint(const std::string& frameName,
+                                    const iDynTree::Position& constraintValue);
+
+    /*!
+     * Adds a (constancy) orientation constraint for the specified frame
+     *
+     * @param frameName the name of the frame on which to attach the constraint
+     * @param constraintValue the value of the constraint
+     * @return true if successful, false otherwise.
+     */
+    bool addFrameRotationConstraint(const std::string& frameName,
+                                    const iDynTree::Rotation& constraintValue);
+
+    /*!
+     * Activate a given constraint previously added with an addFrame**Constraint method,
+     * with a new constraint value.
+     *
+     * @param frameName the name of the frame on which the constraint is attached
+     * @param newConstraintValue the new value of the constraint. Only the constrained components are used.
+     * @return true if successful (i.e. the constraint is present) , false otherwise.
+     */
+    bool activateFrameConstraint(const std::string& frameName,
+                                 const iDynTree::Transform& newConstraintValue);
+
+    /*!
+     * Deactivate a given constraint previously added with an addFrame**Constraint method.
+     *
+     * @param frameName the name of the frame on which the constraint is attached
+     * @return true if successful (i.e. the constraint is present) , false otherwise.
+     */
+    bool deactivateFrameConstraint(const std::string& frameName);
+
+    /*!
+     * Check if a given constraint is active or not.
+     *
+     * @param frameName the name of the frame on which the constraint is attached
+     * @return true if the constraint is active, false if it is not active or it does not exist.
+     */
+    bool isFrameConstraintActive(const std::string& frameName) const;
+
+    /*!
+     * Add a constant inequality constraint on the projection of the center of mass,
+     * as in InverseKinematics::addCenterOfMassProjectionConstraint.
+     *
+     * The convex hull is computed from the active frame constraints of the support frames,
+     * that for this reason must be subject to a frame constraint.
+     */
+    bool addCenterOfMassProjectionConstraint(const std::vector<std::string>& supportFrames,
+                                             const std::vector<iDynTree::Polygon>& supportPolygons,
+                                             const iDynTree::Direction xAxisOfPlaneInWorld = iDynTree::Direction(1.0,0,0),
+                                             const iDynTree::Direction yAxisOfPlaneInWorld = iDynTree::Direction(0,1.0,0),
+                                             const iDynTree::Position originOfPlaneInWorld = iDynTree::Position(0,0,0));
+
+    /*!
+     * Get the convex hull used by the center of mass projection constraint.
+     *
+     * @param[out] convexHull constraint convex hull for the projected center of mass.
+     * @return true if the center of mass projection constraint is active, false otherwise.
+     */
+    bool getCenterOfMassProjectConstraintConvexHull(iDynTree::Polygon2D& convexHull);
+
+    /*!
+     * Adds a target for the specified frame
+     *
+     * @param frameName the name of the frame which represents the target
+     * @param targetValue the value the frame should reach
+     * @param positionWeight (default 1) the weight of the position part of the target
+     * @param rotationWeight (default 1) the weight of the rotation part of the target
+     * @return true if successful, false otherwise
+     */
+    bool addTarget(const std::string& frameName,
+                   const iDynTree::Transform& targetValue,
+                   const double positionWeight=1.0,
+                   const double rotationWeight=1.0);
+
+    /*!
+     * Adds a position (3D) target for the specified frame
+     *
+     * @param frameName the name of the frame which represents the target
+     * @param targetValue the position the frame should reach
+     * @param positionWeight (default 1) the weight of the target
+     * @return true if successful, false otherwise
+     */
+    bool addPositionTarget(const std::string& frameName,
+                           const iDynTree::Position& targetValue,
+                           const double positionWeight=1.0);
+
+    /*!
+     * Adds an orientation target for the specified frame
+     *
+     * @param frameName the name of the frame which represents the target
+     * @param targetValue the orientation the frame should reach
+     * @param rotationWeight (default 1) the weight of the target
+     * @return true if successful, false otherwise
+     */
+    bool addRotationTarget(const std::string& frameName,
+                           const iDynTree::Rotation& targetValue,
+                           const double rotationWeight=1.0);
+
+    /*!
+     * Update the desired target and weights for the specified frame
+     *
+     * @param frameName the name of the frame which represents the target
+     * @param targetValue the value the frame should reach
+     * @param positionWeight the weight of the position part of the target (if negative, the old one is kept)
+     * @param rotationWeight the weight of the rotation part of the target (if negative, the old one is kept)
+     * @return true if successful, false otherwise (e.g. the target was never added)
+     */
+    bool updateTarget(const std::string& frameName,
+                      const iDynTree::Transform& targetValue,
+                      const double positionWeight=-1.0,
+                      const double rotationWeight=-1.0);
+
+    /*!
+     * Update the position target and weight for the specified frame
+     *
+     * @return true if successful, false otherwise (e.g. the target has no position part)
+     */
+    bool updatePositionTarget(const std::string& frameName,
+                              const iDynTree::Position& targetValue,
+                              const double positionWeight=-1.0);
+
+    /*!
+     * Update the orientation target and weight for the specified frame
+     *
+     * @return true if successful, false otherwise (e.g. the target has no rotation part)
+     */
+    bool updateRotationTarget(const std::string& frameName,
+                              const iDynTree::Rotation& targetValue,
+                              const double rotationWeight=-1.0);
+
+    /*!
+     * Set a target (as cost) for the center of mass position.
+     *
+     * @param desiredPosition desired position of the center of mass, in the world frame
+     * @param weight weight of the target
+     */
+    void setCOMTarget(const iDynTree::Position& desiredPosition, const double weight = 1.0);
+
+    /*!
+     * Check if the center of mass target is active.
+     */
+    bool isCOMTargetActive() const;
+
+    /*!
+     * Deactivate the center of mass target.
+     */
+    void deactivateCOMTarget();
+
+    /*!
+     * Sets a desired final configuration for all the robot joints.
+     *
+     * The solver will try to obtain solutions as similar to the specified configuration as possible
+     *
+     * @param[in] desiredJointConfiguration configuration for the joints, one for each dof of the model
+     * @param[in] weight weight for the joint configuration cost. If it is not passed, the previous passed value will be mantained.
+     * @return true if successful, false otherwise.
+     */
+    bool setDesiredFullJointsConfiguration(const iDynTree::VectorDynSize& desiredJointConfiguration, double weight=-1.0);
+
+    /*!
+     * Compute the step toward the targets from the current configuration
+     *
+     * @return true if the QP was built and solved, false otherwise.
+     *         If the solver fails (e.g. it reaches the maximum number of iterations or the QP is infeasible)
+     *         no step is available, and the solution getters return the current configuration.
+     */
+    bool solve();
+
+    /*!
+     * Get the configuration obtained applying the last computed step to the current configuration
+     *
+     * @param[out] baseTransformSolution the base pose
+     * @param[out] shapeSolution the joints configuration, one for each dof of the model
+     */
+    void getFullJointsSolution(iDynTree::Transform& baseTransformSolution,
+                               iDynTree::VectorDynSize& shapeSolution);
+
+    /*!
+     * Get the last computed step as velocities, assuming that it is applied in the given time step
+     *
+     * @param[in] timeStep duration of the step, strictly positive
+     * @param[out] baseVelocity the base velocity, in the mixed representation
+     * @param[out] jointVelocities the joints velocities, one for each dof of the model
+     * @return true if successful, false otherwise
+     */
+    bool getVelocitySolution(const double timeStep,
+                             iDynTree::Twist& baseVelocity,
+                             iDynTree::VectorDynSize& jointVelocities);
+};
+
+#endif /* end of include guard: IDYNTREE_DIFFERENTIALINVERSEKINEMATICS_H */
@@ -17,9 +17,11 @@
 
 #include <iDynTree/ConvexHullHelpers.h>
 #include <iDynTree/Core/Direction.h>
+#include <iDynTree/Core/VectorDynSize.h>
 
 namespace iDynTree {
     class VectorDynSize;
+    class MatrixDynSize;
     class Transform;
     class Position;
     class Rotation;
@@ -64,6 +66,91 @@ namespace iDynTree {
         InverseKinematicsTreatTargetAsConstraintRotationOnly = 1 << 1, //rotation as constraint, position as cost
         InverseKinematicsTreatTargetAsConstraintFull = InverseKinematicsTreatTargetAsConstraintPositionOnly | InverseKinematicsTreatTargetAsConstraintRotationOnly, //both as constraints
     };
+
+    /*!
+     * @brief Options of the multi-start search of InverseKinematics::solveMultiStart
+     */
+    struct InverseKinematicsMultiStartOptions
+    {
+        /*!
+         * Initial conditions for the joints provided by the user, one for each dof of the model.
+         */
+        std::vector<iDynTree::VectorDynSize> jointsSeeds;
+
+        /*!
+         * Number of initial conditions sampled uniformly within the joint limits,
+         * in addition to jointsSeeds (default 10).
+         * The joints without limits are sampled in [-pi, pi].
+         */
+        size_t nrOfRandomSeeds;
+
+        /*!
+         * Seed of the random number generator used to sample the initial conditions (default 0).
+         */
+        unsigned int randomSeed;
+
+        /*!
+         * Number of threads used to run the optimizations.
+         * If zero (default), the number of hardware threads available in the system is used.
+         * A single thread is used if the linear solver is not thread-safe, see InverseKinematics::solveMultiStart.
+         */
+        size_t nrOfThreads;
+
+        /*!
+         * If positive, the search stops as soon as a converged solution with a cost
+         * lower than this value is found (default -1, i.e. all the initial conditions are used).
+         */
+        double costThreshold;
+
+        /*!
+         * Two solutions are considered distinct if the maximum absolute difference
+         * of their joints and base position, or the angle (in radians) of the rotation
+         * between their base orientations, is greater than this value (default 1e-3).
+         */
+        double distinctSolutionsTolerance;
+
+        InverseKinematicsMultiStartOptions()
+        : nrOfRandomSeeds(10)
+        , randomSeed(0)
+        , nrOfThreads(0)
+        , costThreshold(-1.0)
+        , distinctSolutionsTolerance(1e-3)
+        {
+        }
+    };
+
+    /*!
+     * @brief Options of the trajectory solution of InverseKinematics::solveTrajectory
+     */
+    struct InverseKinematicsTrajectoryOptions
+    {
+        /*!
+         * Number of segments in which the sequence of targets is divided.
+         * If zero (default), one segment for each thread is used.
+         */
+        size_t nrOfSegments;
+
+        /*!
+         * Number of threads used to solve the segments.
+         * If zero (default), the number of hardware threads available in the system is used.
+         * A single thread is used if the linear solver is not thread-safe, see InverseKinematics::solveTrajectory.
+         */
+        size_t nrOfThreads;
+
+        /*!
+         * Weight of the cost \f$ \| s_k - s_{k-1} \|^2 \f$ between the joints of consecutive
+         * frames of the same segment (default 0, i.e. no smoothness regularization).
+         * It is added to the cost on the desired joints configuration.
+         */
+        double smoothnessWeight;
+
+        InverseKinematicsTrajectoryOptions()
+        : nrOfSegments(0)
+        , nrOfThreads(0)
+        , smoothnessWeight(0.0)
+        {
+        }
+    };
 }
 
 /*!
@@ -273,6 +360,51 @@ public:
     std::string linearSolverName();
     void setLinearSolverName(const std::string &solverName);
 
+    /**
+     * Sets how the Hessian of the Lagrangian is computed.
+     *
+     * By default the Hessian is approximated with limited-memory quasi-Newton updates.
+     * If useApproximatedHessian is false, the exact Hessian is computed analytically, exploiting
+     * the sparsity given by the kinematic tree: each iteration is more expensive, but
+     * usually fewer iterations are needed to converge.
+     *
+     * @param useApproximatedHessian true to use the limited-memory approximation, false to use the exact Hessian.
+     */
+    void useApproximatedHessians(bool useApproximatedHessian = true);
+
+    /**
+     * Returns true if the Hessian of the Lagrangian is approximated.
+     * @see useApproximatedHessians
+     * @return true if the Hessian is approximated, false if the exact Hessian is used.
+     */
+    bool usesApproximatedHessians() const;
+
+    /**
+     * Sets the tracking mode, to be used when solve() is called at a high rate
+     * while only the values of the targets change (e.g. in a retargeting loop).
+     *
+     * In tracking mode:
+     * - if the structure of the problem (targets, constraints, resolution modes and parameters)
+     *   did not change since the last call to solve(), the solver reuses its internal data structures;
+     * - the optimization starts from the last solution, and the multipliers are initialized with the last ones.
+     *   An initial condition set with setFullJointsInitialCondition or setReducedInitialCondition is used instead
+     *   of the last solution in the next call to solve();
+     * - if the solver reaches the maximum number of iterations or the maximum CPU time (see setMaxIterations
+     *   and setMaxCPUTime), solve() returns true and the last iterate is the solution. Use lastSolveConverged
+     *   to check if the solution reached the required tolerances.
+     *
+     * In this way the computation time of each call to solve() can be bounded.
+     * @param useTrackingMode true to enable the tracking mode, false otherwise.
+     */
+    void useTrackingMode(bool useTrackingMode = true);
+
+    /**
+     * Returns true if the tracking mode is enabled.
+     * @see useTrackingMode
+     * @return true if the tracking mode is enabled, false otherwise.
+     */
+    bool usesTrackingMode() const;
+
     ///@}
 
 
@@ -736,6 +868,116 @@ public:
     void getReducedSolution(iDynTree::Transform& baseTransformSolution,
                             iDynTree::VectorDynSize& shapeSolution);
 
+    /*!
+     * Return the wall clock time spent in the last call to solve()
+     *
+     * @return the time, in seconds
+     */
+    double lastSolveTime() const;
+
+    /*!
+     * Return the number of iterations of the solver in the last call to solve()
+     *
+     * @return the number of iterations
+     */
+    int lastSolveIterations() const;
+
+    /*!
+     * Return true if the solution of the last call to solve() satisfies the required tolerances
+     *
+     * In tracking mode, solve() can return true also if the solver stopped because of the limits on the
+     * number of iterations or on the CPU time.
+     * @return true if the last solve converged, false otherwise
+     */
+    bool lastSolveConverged() const;
+
+    /*!
+     * Return the value of the cost function at the solution of the last call to solve()
+     *
+     * @return the cost of the last solution
+     */
+    double lastSolveCost() const;
+
+    /*!
+     * Solve the problem from multiple initial conditions, distributing the optimizations on a pool of threads.
+     *
+     * Each thread solves an independent copy of the problem. The initial condition for the base
+     * is the one set with setFullJointsInitialCondition or setReducedInitialCondition, or the
+     * current base configuration if not set. The joints which are not optimised keep their current configuration.
+     * After the call, getFullJointsSolution and getReducedSolution return the converged solution with the lowest cost,
+     * while all the distinct converged solutions can be obtained with getMultiStartSolution.
+     *
+     * @note the optimizations run concurrently only if the linear solver set with setLinearSolverName() (or the default
+     *       linear solver of Ipopt, if it was not set) is known to be thread-safe, i.e. ma57, ma86, ma97, or mumps with
+     *       Ipopt 3.14 or later. Otherwise a warning is reported and they run one after the other on the calling thread.
+     * @param options the initial conditions and the parameters of the search
+     * @return true if at least one optimization converged, false otherwise
+     */
+    bool solveMultiStart(const InverseKinematicsMultiStartOptions& options = InverseKinematicsMultiStartOptions());
+
+    /*!
+     * Return the number of distinct solutions found by the last call to solveMultiStart()
+     */
+    size_t getNrOfMultiStartSolutions() const;
+
+    /*!
+     * Get one of the distinct solutions found by the last call to solveMultiStart(), sorted by increasing cost
+     *
+     * @param[in] index index of the solution, in [0, getNrOfMultiStartSolutions())
+     * @param[out] baseTransformSolution the base pose
+     * @param[out] shapeSolution the full joints configuration
+     * @param[out] cost the value of the cost function at the solution
+     * @return true if successful, false if the index is not valid
+     */
+    bool getMultiStartSolution(const size_t index,
+                               iDynTree::Transform& baseTransformSolution,
+                               iDynTree::VectorDynSize& shapeSolution,
+                               double& cost) const;
+
+    /*!
+     * Solve the problem for a sequence of values of the targets, as in an offline retargeting.
+     *
+     * The targets must have been already added to the problem. For each time frame k, the
+     * targets are updated with targetValues[i][k] (only the components of the target are used)
+     * and the problem is solved.
+     * The sequence is divided in contiguous segments, that are solved in parallel on a pool of threads,
+     * each with its own copy of the problem. Inside a segment, each optimization starts from the solution
+     * of the previous frame (as in tracking mode), while the first frame of each segment starts from the
+     * initial condition of the problem.
+     * The targets of this object are not modified.
+     *
+     * @note the segments are solved concurrently only if the linear solver set with setLinearSolverName() (or the default
+     *       linear solver of Ipopt, if it was not set) is known to be thread-safe, i.e. ma57, ma86, ma97, or mumps with
+     *       Ipopt 3.14 or later. Otherwise a warning is reported and they are solved one after the other on the calling thread.
+     * @param[in] targetFrames names of the frames with a target
+     * @param[in] targetValues for each frame in targetFrames, the values of the target at each time frame
+     * @param[out] jointsTrajectory full joints configuration at each time frame (one row for each time frame)
+     * @param[out] baseTrajectory base pose at each time frame
+     * @param[out] convergedFrames true for the time frames whose optimization converged. The configuration of the
+     *             other time frames is the last iterate of the solver, or the one of the previous time frame of the
+     *             segment if the solver failed before starting the iterations.
+     * @param[in] options segmentation and regularization options
+     * @return true if the optimizations of all the time frames converged, false otherwise
+     */
+    bool solveTrajectory(const std::vector<std::string>& targetFrames,
+                         const std::vector<std::vector<iDynTree::Transform> >& targetValues,
+                         iDynTree::MatrixDynSize& jointsTrajectory,
+                         std::vector<iDynTree::Transform>& baseTrajectory,
+                         std::vector<bool>& convergedFrames,
+                         const InverseKinematicsTrajectoryOptions& options = InverseKinematicsTrajectoryOptions());
+
+    /*!
+     * Solve the problem for a sequence of values of the targets, without returning the convergence of each time frame.
+     *
+     * @see solveTrajectory(const std::vector<std::string>&, const std::vector<std::vector<iDynTree::Transform> >&,
+     *      iDynTree::MatrixDynSize&, std::vector<iDynTree::Transform>&, std::vector<bool>&, const InverseKinematicsTrajectoryOptions&)
+     */
+    bool solveTrajectory(const std::vector<std::string>& targetFrames,
+                         const std::vector<std::vector<iDynTree::Transform> >& targetValues,
+                         iDynTree::MatrixDynSize& jointsTrajectory,
+                         std::vector<iDynTree::Transform>& baseTrajectory,
+                         const InverseKinematicsTrajectoryOptions& options = InverseKinematicsTrajectoryOptions());
+
     ///@}
 
 
@@ -25,6 +25,7 @@
 #include <IpIpoptApplication.hpp>
 
 
+#include <atomic>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -140,6 +141,28 @@ public:
 
     bool m_problemInitialized;
     bool m_warmStartEnabled;
+    bool m_canReoptimizeProblem; /*!< True if the solver can be called again on the same problem structure (tracking mode) */
+    bool m_reoptimizingProblem; /*!< True if the solver has been told that the problem structure did not change */
+    bool m_lastSolutionIsInitialCondition; /*!< True if the next optimization starts from the last solution (tracking mode) */
+
+    //Statistics of the last call to solveProblem
+    double m_lastSolveTime; /*!< Wall clock time (in seconds) of the last solve */
+    int m_lastSolveIterations; /*!< Number of iterations of the last solve */
+    bool m_lastSolveConverged; /*!< True if the last solve converged to the required tolerances */
+    double m_lastSolveCost; /*!< Value of the cost function at the solution of the last solve */
+
+    /*!
+     * If not null, the solver stops at the next iteration once the pointed flag is set.
+     * Used to interrupt the optimizations of a multi-start search from other threads.
+     */
+    const std::atomic<bool>* m_stopRequest;
+
+    struct MultiStartSolution {
+        iDynTree::Transform basePose;
+        iDynTree::VectorDynSize jointsConfiguration;
+        double cost;
+    };
+    std::vector<MultiStartSolution> m_multiStartSolutions; /*!< Distinct solutions of the last multi-start search, sorted by cost */
     size_t m_numberOfOptimisationVariables;
     size_t m_numberOfOptimisationConstraints;
     Ipopt::SmartPtr<Ipopt::IpoptApplication> m_solver; /*!< Instance of IPOPT solver */
@@ -165,6 +188,17 @@ public:
      */
     void configureCenterOfMassProjectionConstraint();
 
+    /*!
+     * Pass the optimization-related parameters to the solver
+     */
+    void updateSolverOptions();
+
+    /*!
+     * Disable the warm start, so that the next optimization starts from the initial condition
+     * without using the multipliers of the last solution
+     */
+    void disableWarmStart();
+
     /*! @name Optimization-related parameters
      */
     ///@{
@@ -175,6 +209,9 @@ public:
     double m_constrTol; /*!< Tolerance for the constraints */
     int m_verbosityLevel; /*!< Verbosity level */
     std::string m_solverName;
+    bool m_useApproximatedHessians; /*!< True if the Hessian of the Lagrangian is approximated with limited-memory quasi-Newton updates */
+    bool m_useTrackingMode; /*!< True if the problem structure and the last solution are reused between consecutive solves */
+    bool m_solverOptionsChanged; /*!< True if the parameters have been modified since they were passed to the solver */
 
     ///@}
 
@@ -312,6 +349,24 @@ public:
      */
     enum iDynTree::InverseKinematicsTreatTargetAsConstraint targetResolutionMode(TransformMap::iterator target) const;
 
+    /*!
+     * Copy the model, the targets, the constraints and the parameters of another problem.
+     *
+     * The solver instance and the results are not copied. This is used to create
+     * independent copies of the same problem, that can be solved in parallel.
+     * @param other the problem to be copied
+     * @return true if successful, false otherwise
+     */
+    bool copyProblemFrom(const InverseKinematicsData& other);
+
+    /*! Create and initialize the solver, if it was not already done
+     *
+     * After the call, m_solverName is the linear solver that will be used,
+     * also if it was not set (i.e. the default one of Ipopt).
+     * @return true if successful, false otherwise
+     */
+    bool initializeSolver();
+
     /*! Solve the NLP problem
      *
      * @return true if the problem is solved. False otherwise
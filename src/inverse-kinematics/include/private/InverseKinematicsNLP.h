@@ -17,8 +17,10 @@
 #include <iDynTree/Core/MatrixDynSize.h>
 #include <iDynTree/Core/Twist.h>
 #include <iDynTree/Core/Transform.h>
+#include <iDynTree/Model/Traversal.h>
 
 #include <map>
+#include <vector>
 
 // use expression as sub-expression,
 // then make type of full expression int, discard result
@@ -228,8 +230,10 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
      */
     struct FrameInfo {
         iDynTree::Transform transform; /*!< frame w.r.t. global frame, i.e. \f$ {}^w R_f \f$ */
-        iDynTree::MatrixDynSize jacobian; /*!< Jacobian */
+        iDynTree::MatrixDynSize jacobian; /*!< Jacobian. Only the base columns and the ones of dofsOnPath are nonzero */
+        iDynTree::MatrixDynSize constraintJacobian; /*!< Jacobian w.r.t. the optimization variables. Only the base columns and the ones of dofsOnPath are nonzero */
         iDynTree::MatrixFixSize<4, 3> quaternionDerivativeMap; /*!< map used during the derivative if the quaternion representation is used */
+        std::vector<size_t> dofsOnPath; /*!< dofs between the frame and the floating base, i.e. the ones moving the frame */
     };
     typedef std::map<int, FrameInfo> FrameInfoMap;
 
@@ -237,7 +241,7 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
 
     //Buffers and variables used in the optimization
     iDynTree::MatrixFixSize<3, 4> quaternionDerivativeInverseMapBuffer; /*!< this is used to contain the quaternionDerivativeInverseMap, computed once for each optimization step */
-    iDynTree::MatrixDynSize finalJacobianBuffer; /*!< Buffer to contain the Jacobian as modified to handle quaternions */
+    iDynTree::MatrixDynSize finalJacobianBuffer; /*!< Buffer used to compute the sparsity pattern of the Jacobian as modified to handle quaternions */
 
     FrameInfoMap constraintsInfo; /*!< FrameInfo map for the constraints */
     FrameInfoMap targetsInfo; /*!< FrameInfo map for the targets */
@@ -248,6 +252,7 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
         iDynTree::MatrixDynSize comJacobian; /*!< 3 X (6 + nDofs) center of mass jacobian */
         iDynTree::MatrixDynSize comJacobianAnalytical; /*!< 3 x ( 3 + sizeOfRotationParams + nDofs) processed jacobian */
         iDynTree::MatrixDynSize projectedComJacobian; /*!< 2 x ( 3 + sizeOfRotationParams + nDofs) processed jacobian */
+        iDynTree::MatrixDynSize comJacobianWithJointsAxes; /*!< 6 X (6 + nDofs) center of mass jacobian (linear part) and joints axes (angular part), used by the Hessian */
     };
 
     COMInfo comInfo;
@@ -256,6 +261,17 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
     iDynTree::Position optimizedBasePosition; /*!< Hold the base frame origin at an optimization step */
     iDynTree::Vector4 optimizedBaseOrientation; /*!< Hold the base frame orientation at an optimization step. Note that if orientation is RPY, the last component should not be accessed */
     iDynTree::VectorDynSize jointsAtOptimisationStep; /*!< Hold the joints configuration at an optimization step */
+    iDynTree::MatrixDynSize jointsMotionSubspacesBuffer; /*!< 6 x nDofs motion subspace vectors of the joints w.r.t. the world frame, shared by the Jacobians of all the frames */
+
+    //Buffers and variables used to compute the Hessian of the Lagrangian
+    iDynTree::Traversal m_traversal; /*!< traversal of the model from the floating base */
+    std::vector<bool> m_dofsAncestors; /*!< element (i * dofs + j) is true if the dof j is the dof i or moves the child link of dof i */
+    std::vector<Ipopt::Index> m_hessianRows; /*!< rows of the nonzeros of the lower triangular part of the Hessian */
+    std::vector<Ipopt::Index> m_hessianColumns; /*!< columns of the nonzeros of the lower triangular part of the Hessian */
+    std::vector<Ipopt::Index> m_hessianEntries; /*!< element (row * nVariables + col), col <= row, is the index of (row, col) in the nonzeros of the Hessian, or -1 if it is not in the pattern */
+    iDynTree::MatrixDynSize baseOrientationMapBuffer; /*!< 3 x sizeOfRotationParams map from the base orientation parameters derivative to the base angular velocity */
+    std::vector<iDynTree::MatrixDynSize> baseOrientationMapDerivativesBuffer; /*!< derivatives of baseOrientationMapBuffer w.r.t. each base orientation parameter */
+    iDynTree::MatrixDynSize analyticalJacobianBuffer; /*!< 6 x (3 + sizeOfRotationParams + nDofs) derivative of the frame position (linear part) and rotation (angular part) w.r.t. the optimization variables */
 
     /*!
      * @brief update all the configuration dependent variables
@@ -268,6 +284,41 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
      */
     bool updateState(const Ipopt::Number * x);
 
+    /*!
+     * @brief initialize the information of a frame which does not depend on the configuration
+     *
+     * Resize the Jacobian buffers and compute the dofs moving the frame
+     * @param frameIndex index of the frame
+     * @param[out] frameInfo the information to initialize
+     */
+    void initializeFrameInfo(int frameIndex, FrameInfo& frameInfo);
+
+    /*!
+     * @brief update the Jacobian of a frame
+     *
+     * The Jacobian (in the mixed representation) is computed from the frame position
+     * and the motion subspaces of the joints in jointsMotionSubspacesBuffer.
+     * Only the base columns and the columns of the dofs on the path are written.
+     * @param frameInfo the information of the frame, with the updated transform
+     */
+    void updateFrameJacobian(FrameInfo& frameInfo);
+
+    /*!
+     * @brief add the product of a block of rows of a constraint Jacobian with a vector to the gradient
+     *
+     * Only the structurally nonzero columns of the Jacobian are considered
+     * @param frameInfo the information of the frame, with the updated constraintJacobian
+     * @param firstRow first row of the block
+     * @param numberOfRows number of rows of the block
+     * @param coefficients vector (of size numberOfRows) multiplying the rows of the block
+     * @param[in,out] gradient the gradient to be updated
+     */
+    void addToGradient(const FrameInfo& frameInfo,
+                       unsigned firstRow,
+                       unsigned numberOfRows,
+                       const double* coefficients,
+                       Ipopt::Number* gradient);
+
     /*!
      * Specify which part of the Jacobian should be computed/updated
      */
@@ -290,18 +341,22 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
      * @param[in] quaternionDerivativeMapBuffer map for the quaternion derivative
      * @param[in] quaternionDerivativeInverseMapBuffer inverse map for the quaternion derivative
      * @param[in] computationOption bitwise mask of ComputeContraintJacobianOption
+     * @param[in] dofsOnPath the dofs whose columns are nonzero. The other columns
+     *                       of constraintJacobianBuffer are not written and should be already zero
      * @param[out] constraintJacobianBuffer resulting IPOPT compatible Jacobian
      */
     void computeConstraintJacobian(const iDynTree::MatrixDynSize& transformJacobian,
                                    const iDynTree::MatrixFixSize<4, 3>& quaternionDerivativeMapBuffer,
                                    const iDynTree::MatrixFixSize<3, 4>& quaternionDerivativeInverseMapBuffer,
                                    const int computationOption,
+                                   const std::vector<size_t>& dofsOnPath,
                                    iDynTree::MatrixDynSize& constraintJacobianBuffer);
 
     void computeConstraintJacobianRPY(const iDynTree::MatrixDynSize& transformJacobian,
                                       const iDynTree::MatrixFixSize<3, 3>& rpyDerivativeMapBuffer,
                                       const iDynTree::MatrixFixSize<3, 3>& rpyDerivativeInverseMapBuffer,
                                       const int computationOption,
+                                      const std::vector<size_t>& dofsOnPath,
                                       iDynTree::MatrixDynSize& constraintJacobianBuffer);
 
     void computeConstraintJacobianCOMRPY(const iDynTree::MatrixDynSize& comJacobianBuffer,
@@ -323,14 +378,78 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
     void omegaToRPYParameters(const iDynTree::Vector3& rpyAngles,
                               iDynTree::Matrix3x3& map);
 
+    /*!
+     * @brief update the map between the base orientation parameters and the base angular velocity
+     *
+     * Computes, for the current base orientation, the map \f$ M \f$ such that
+     * \f$ {}^I \omega_B = M \dot{\theta} \f$, where \f$ \theta \f$ are the base orientation parameters,
+     * and its derivatives w.r.t. each parameter.
+     */
+    void updateBaseOrientationMaps();
+
+    /*!
+     * @brief compute the derivative of a frame w.r.t. the optimization variables
+     *
+     * The first three rows of the output are the derivative of the frame position,
+     * the last three rows are the (inertial) angular velocity of the frame corresponding to a variation of each variable.
+     * Differently from computeConstraintJacobian the rotation part is not mapped to the orientation parametrization.
+     * @note it uses the base orientation map computed by updateBaseOrientationMaps
+     * @param[in] transformJacobian the 6 x (6 + nDofs) mixed free floating Jacobian of the frame
+     * @param[out] analyticalJacobian the resulting 6 x (3 + sizeOfRotationParams + nDofs) Jacobian
+     */
+    void computeAnalyticalJacobian(const iDynTree::MatrixDynSize& transformJacobian,
+                                   iDynTree::MatrixDynSize& analyticalJacobian);
+
+    /*!
+     * @brief add to the Hessian buffer the second derivative of a weighted point position
+     *
+     * Adds \f$ \frac{\partial^2 (u^\top p(x))}{\partial x^2} \f$ to the nonzeros of the Hessian.
+     * The second derivatives are computed from the first ones, exploiting the kinematic tree:
+     * if the variable \f$ x_j \f$ moves the joint of the variable \f$ x_i \f$,
+     * \f$ \frac{\partial^2 p}{\partial x_i \partial x_j} = \omega_j \times \frac{\partial p}{\partial x_i} \f$.
+     * @param analyticalJacobian derivative of the point as computed by computeAnalyticalJacobian.
+     *                           The angular part must contain the axis of all the joints moving the point.
+     * @param point the point position
+     * @param weights the weights \f$ u \f$ of the point coordinates
+     * @param[in,out] hessianValues the nonzeros of the Hessian, ordered as m_hessianRows
+     */
+    void addPointHessian(const iDynTree::MatrixDynSize& analyticalJacobian,
+                         const iDynTree::Position& point,
+                         const iDynTree::Vector3& weights,
+                         Ipopt::Number* hessianValues);
+
+    /*!
+     * @brief add to the Hessian buffer the second derivative of a weighted function of a frame rotation
+     *
+     * Given a scalar function \f$ \phi(R) \f$ of the frame rotation, consider its first and
+     * second derivatives w.r.t. a (inertial) rotation vector \f$ \psi \f$, i.e.
+     * \f$ \phi(e^{\psi^\wedge} R) \simeq \phi(R) + g^\top \psi + \frac{1}{2} \psi^\top T \psi \f$
+     * where the last term is not symmetrized, i.e. \f$ T \f$ is the derivative of \f$ g^\top \f$ w.r.t. \f$ \psi \f$.
+     * This method adds \f$ \frac{\partial^2 \phi(R(x))}{\partial x^2} \f$ to the nonzeros of the Hessian.
+     * @param analyticalJacobian derivative of the frame as computed by computeAnalyticalJacobian
+     * @param angularCurvature the matrix \f$ T \f$
+     * @param angularGradient the vector \f$ g \f$
+     * @param[in,out] hessianValues the nonzeros of the Hessian, ordered as m_hessianRows
+     */
+    void addRotationHessian(const iDynTree::MatrixDynSize& analyticalJacobian,
+                            const iDynTree::Matrix3x3& angularCurvature,
+                            const iDynTree::Vector3& angularGradient,
+                            Ipopt::Number* hessianValues);
+
 
     /**
      * Helper method to create sparity information for a specific constraint
      *
      * @param constraintID id of the constraint
      * @param constraint constraint object
+     * @param constraintInfo information of the constrained frame
+     * @param computationOption bitwise mask of ComputeContraintJacobianOption with the parts of the
+     *        constraint that are enforced as constraints (e.g. only the position part of a target)
      */
-    void addSparsityInformationForConstraint(int constraintID, const internal::kinematics::TransformConstraint& constraint);
+    void addSparsityInformationForConstraint(int constraintID,
+                                             const internal::kinematics::TransformConstraint& constraint,
+                                             FrameInfo& constraintInfo,
+                                             int computationOption = ComputeContraintJacobianOptionLinearPart|ComputeContraintJacobianOptionAngularPart);
 
     /**
      * Initialize the sparsity information
@@ -339,6 +458,21 @@ class internal::kinematics::InverseKinematicsNLP : public Ipopt::TNLP {
      */
     void initializeSparsityInformation();
 
+    /**
+     * Initialize the sparsity pattern of the Hessian of the Lagrangian
+     *
+     * Two joints variables appear in the same element of the Hessian only if one of the joints moves the other,
+     * (or if the center of mass is a target treated as cost).
+     * @note this method should be called after all constraints have been specified.
+     */
+    void initializeHessianSparsityInformation();
+
+    /**
+     * Index of the element (row, col), col <= row, in the nonzeros of the Hessian
+     * @note the element must be in the sparsity pattern computed by initializeHessianSparsityInformation
+     */
+    Ipopt::Index hessianEntry(Ipopt::Index row, Ipopt::Index col) const;
+
 #ifndef NDEBUG
     // IpOpt should not call the same callback twice for the same set of input parameters
     // To be sure of this, we add some assert in the code
@@ -16,6 +16,8 @@
 #include <Eigen/Core>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace iDynTree
 {
@@ -114,6 +116,406 @@ namespace iDynTree
         return ((a(0)-o(0))*(b(1)-o(1))-(a(1)-o(1))*(b(0)-o(0)));
     }
 
+    bool vector2lexographical(const Vector2& a, const Vector2& b)
+    {
+        return (a(0) < b(0)) || ( (a(0) == b(0)) && (a(1) < b(1)) );
+    }
+
+    bool vector2AreClose(const Vector2& a, const Vector2& b, const double tolerance)
+    {
+        return std::abs(a(0) - b(0)) <= tolerance && std::abs(a(1) - b(1)) <= tolerance;
+    }
+
+    // Tolerance used to consider the same two projected points of the supports
+    const double projectedPointsMatchingTolerance = 1e-12;
+
+    ConvexHull2D::ConvexHull2D(): m_nrOfPoints(0)
+    {
+
+    }
+
+    void ConvexHull2D::clear()
+    {
+        m_points.clear();
+        m_isPointUsed.clear();
+        m_unusedPointIDs.clear();
+        m_nrOfPoints = 0;
+        m_hullPointIDs.clear();
+        m_convexHull.setNrOfVertices(0);
+        updateHalfPlanes();
+    }
+
+    void ConvexHull2D::setPoints(const std::vector<Vector2>& points)
+    {
+        m_points = points;
+        m_isPointUsed.assign(points.size(), true);
+        m_unusedPointIDs.clear();
+        m_nrOfPoints = points.size();
+        rebuildConvexHull();
+    }
+
+    size_t ConvexHull2D::storePoint(const Vector2& point)
+    {
+        size_t pointID;
+        if (m_unusedPointIDs.empty())
+        {
+            pointID = m_points.size();
+            m_points.push_back(point);
+            m_isPointUsed.push_back(true);
+        }
+        else
+        {
+            pointID = m_unusedPointIDs.back();
+            m_unusedPointIDs.pop_back();
+            m_points[pointID] = point;
+            m_isPointUsed[pointID] = true;
+        }
+        m_nrOfPoints++;
+
+        return pointID;
+    }
+
+    bool ConvexHull2D::releasePoint(const size_t pointID, bool& isHullVertex)
+    {
+        if (pointID >= m_points.size() || !m_isPointUsed[pointID])
+        {
+            return false;
+        }
+
+        m_isPointUsed[pointID] = false;
+        m_unusedPointIDs.push_back(pointID);
+        m_nrOfPoints--;
+
+        isHullVertex = std::find(m_hullPointIDs.begin(), m_hullPointIDs.end(), pointID) != m_hullPointIDs.end();
+        return true;
+    }
+
+    size_t ConvexHull2D::addPoint(const Vector2& point)
+    {
+        size_t pointID = storePoint(point);
+
+        if (isValid())
+        {
+            insertPointInConvexHull(pointID);
+        }
+        else
+        {
+            rebuildConvexHull();
+        }
+
+        return pointID;
+    }
+
+    void ConvexHull2D::addPoints(const std::vector<Vector2>& points, std::vector<size_t>& pointIDs)
+    {
+        pointIDs.resize(points.size());
+        if (points.empty())
+        {
+            return;
+        }
+
+        // If the hull is not valid, the points are not inserted one by one but the hull is rebuilt once
+        bool wasValid = isValid();
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            pointIDs[i] = storePoint(points[i]);
+            if (wasValid)
+            {
+                insertPointInConvexHull(pointIDs[i]);
+            }
+        }
+
+        if (!wasValid)
+        {
+            rebuildConvexHull();
+        }
+    }
+
+    bool ConvexHull2D::removePoint(const size_t pointID)
+    {
+        bool isHullVertex = false;
+        if (!releasePoint(pointID, isHullVertex))
+        {
+            return false;
+        }
+
+        // If the point is not a vertex, the hull does not change
+        if (isHullVertex)
+        {
+            rebuildConvexHull();
+        }
+
+        return true;
+    }
+
+    bool ConvexHull2D::removePoints(const std::vector<size_t>& pointIDs)
+    {
+        bool allRemoved = true;
+        bool isHullChanged = false;
+        for (size_t i = 0; i < pointIDs.size(); i++)
+        {
+            bool isHullVertex = false;
+            allRemoved = releasePoint(pointIDs[i], isHullVertex) && allRemoved;
+            isHullChanged = isHullChanged || isHullVertex;
+        }
+
+        // The hull is rebuilt at most once, even if several vertices are removed
+        if (isHullChanged)
+        {
+            rebuildConvexHull();
+        }
+
+        return allRemoved;
+    }
+
+    size_t ConvexHull2D::getNrOfPoints() const
+    {
+        return m_nrOfPoints;
+    }
+
+    bool ConvexHull2D::isValid() const
+    {
+        return m_convexHull.isValid();
+    }
+
+    const Polygon2D& ConvexHull2D::getConvexHull() const
+    {
+        return m_convexHull;
+    }
+
+    const MatrixDynSize& ConvexHull2D::getHalfPlanesMatrix() const
+    {
+        return m_halfPlanesMatrix;
+    }
+
+    const VectorDynSize& ConvexHull2D::getHalfPlanesVector() const
+    {
+        return m_halfPlanesVector;
+    }
+
+    void ConvexHull2D::rebuildConvexHull()
+    {
+        // Order the ids of the points with a lexographical ordering of the points
+        std::vector<size_t>& sortedPointIDs = m_sortedPointIDs;
+        sortedPointIDs.clear();
+        for (size_t i = 0; i < m_points.size(); i++)
+        {
+            if (m_isPointUsed[i])
+            {
+                sortedPointIDs.push_back(i);
+            }
+        }
+
+        std::sort(sortedPointIDs.begin(), sortedPointIDs.end(),
+                  [this](size_t a, size_t b) { return vector2lexographical(m_points[a], m_points[b]); });
+
+        // Compute the convex hull using the Monotone Chain
+        m_hullPointIDs.resize(2*sortedPointIDs.size());
+        size_t k = 0;
+
+        // Build the lower hull
+        for (size_t i = 0; i < sortedPointIDs.size(); ++i)
+        {
+            while (k >= 2 && monotono_chain_cross(m_points[m_hullPointIDs[k-2]],
+                                                  m_points[m_hullPointIDs[k-1]],
+                                                  m_points[sortedPointIDs[i]]) <= 0)
+            {
+                k = k-1;
+            }
+
+            m_hullPointIDs[k] = sortedPointIDs[i];
+            k = k+1;
+        }
+
+        // Build the upper hull
+        const size_t t = k+1;
+        for (int i = static_cast<int>(sortedPointIDs.size())-2; i >= 0; i--)
+        {
+            while (k >= t && monotono_chain_cross(m_points[m_hullPointIDs[k-2]],
+                                                  m_points[m_hullPointIDs[k-1]],
+                                                  m_points[sortedPointIDs[i]]) <= 0)
+            {
+                k = k-1;
+            }
+
+            m_hullPointIDs[k] = sortedPointIDs[i];
+            k = k+1;
+        }
+
+        // The last point is equal to the first one (if there is more than one point)
+        m_hullPointIDs.resize(k > 1 ? k-1 : k);
+
+        m_convexHull.setNrOfVertices(m_hullPointIDs.size());
+        for (size_t i = 0; i < m_hullPointIDs.size(); i++)
+        {
+            m_convexHull(i) = m_points[m_hullPointIDs[i]];
+        }
+
+        updateHalfPlanes();
+    }
+
+    void ConvexHull2D::insertPointInConvexHull(size_t pointID)
+    {
+        const Vector2& point = m_points[pointID];
+        size_t nrOfVertices = m_hullPointIDs.size();
+
+        // A side is visible from the point if the point is not on its inner side.
+        // If the point is outside the hull, the visible sides are consecutive.
+        bool isOutside = false;
+        std::vector<bool>& isSideVisible = m_isSideVisible;
+        isSideVisible.assign(nrOfVertices, false);
+        for (size_t i = 0; i < nrOfVertices; i++)
+        {
+            double cross = monotono_chain_cross(m_convexHull(i), m_convexHull((i + 1) % nrOfVertices), point);
+            isSideVisible[i] = cross <= 0;
+            isOutside = isOutside || cross < 0;
+        }
+
+        if (!isOutside)
+        {
+            return;
+        }
+
+        // Find the first visible side, i.e. the one following a side that is not visible
+        size_t firstVisibleSide = nrOfVertices;
+        for (size_t i = 0; i < nrOfVertices; i++)
+        {
+            if (isSideVisible[i] && !isSideVisible[(i + nrOfVertices - 1) % nrOfVertices])
+            {
+                firstVisibleSide = i;
+                break;
+            }
+        }
+
+        if (firstVisibleSide == nrOfVertices)
+        {
+            rebuildConvexHull();
+            return;
+        }
+
+        // The vertices between the visible sides are replaced by the point
+        std::vector<size_t>& newHullPointIDs = m_newHullPointIDs;
+        newHullPointIDs.clear();
+        size_t vertex = firstVisibleSide;
+        newHullPointIDs.push_back(m_hullPointIDs[vertex]);
+        newHullPointIDs.push_back(pointID);
+        while (isSideVisible[vertex])
+        {
+            vertex = (vertex + 1) % nrOfVertices;
+        }
+        while (vertex != firstVisibleSide)
+        {
+            newHullPointIDs.push_back(m_hullPointIDs[vertex]);
+            vertex = (vertex + 1) % nrOfVertices;
+        }
+
+        // Start from the lowest point in the lexographical ordering, as the Monotone Chain
+        std::vector<size_t>::iterator firstVertex =
+            std::min_element(newHullPointIDs.begin(), newHullPointIDs.end(),
+                             [this](size_t a, size_t b) { return vector2lexographical(m_points[a], m_points[b]); });
+        std::rotate(newHullPointIDs.begin(), firstVertex, newHullPointIDs.end());
+        m_hullPointIDs.swap(newHullPointIDs);
+
+        m_convexHull.setNrOfVertices(m_hullPointIDs.size());
+        for (size_t i = 0; i < m_hullPointIDs.size(); i++)
+        {
+            m_convexHull(i) = m_points[m_hullPointIDs[i]];
+        }
+
+        updateHalfPlanes();
+    }
+
+    void ConvexHull2D::updateHalfPlanes()
+    {
+        size_t nrOfSides = m_convexHull.getNrOfVertices() > 1 ? m_convexHull.getNrOfVertices() : 0;
+        m_halfPlanesMatrix.resize(nrOfSides, 2);
+        m_halfPlanesVector.resize(nrOfSides);
+        m_sidesLengths.resize(nrOfSides);
+
+        // The vertices are in counter-clockwise order, so the outward normal of
+        // the side p0 -> p1 is the direction of the side rotated clockwise
+        for (size_t i = 0; i < nrOfSides; i++)
+        {
+            const Vector2& p0 = m_convexHull(i);
+            const Vector2& p1 = m_convexHull((i + 1) % nrOfSides);
+
+            Eigen::Vector2d side = toEigen(p1) - toEigen(p0);
+            m_sidesLengths[i] = side.norm();
+            Eigen::Vector2d normal(side(1), -side(0));
+            if (m_sidesLengths[i] > 0)
+            {
+                normal /= m_sidesLengths[i];
+            }
+
+            toEigen(m_halfPlanesMatrix).row(i) = normal.transpose();
+            m_halfPlanesVector(i) = normal.dot(toEigen(p0));
+        }
+    }
+
+    bool ConvexHull2D::contains(const Vector2& point, const double tolerance) const
+    {
+        if (!isValid())
+        {
+            return false;
+        }
+
+        return computeMargin(point) >= -tolerance;
+    }
+
+    double ConvexHull2D::computeMargin(const Vector2& point) const
+    {
+        size_t nrOfSides = m_halfPlanesVector.size();
+        if (nrOfSides == 0)
+        {
+            return -std::numeric_limits<double>::infinity();
+        }
+
+        // Inside the hull, the distance from the boundary is the distance from the closest line of the sides.
+        // Outside, the closest point of the boundary belongs to one of the sides whose half-plane is violated.
+        bool isInside = true;
+        double distanceFromSides = std::numeric_limits<double>::infinity();
+        double squaredDistanceFromViolatedSides = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < nrOfSides; i++)
+        {
+            double normalX = m_halfPlanesMatrix(i, 0);
+            double normalY = m_halfPlanesMatrix(i, 1);
+            double distanceFromLine = m_halfPlanesVector(i) - normalX*point(0) - normalY*point(1);
+
+            if (distanceFromLine >= 0)
+            {
+                distanceFromSides = std::min(distanceFromSides, distanceFromLine);
+                continue;
+            }
+
+            isInside = false;
+
+            // The direction of the side is the normal rotated counter-clockwise
+            const Vector2& p0 = m_convexHull(i);
+            double relativeX = point(0) - p0(0);
+            double relativeY = point(1) - p0(1);
+            double alongSide = std::max(0.0, std::min(m_sidesLengths[i], -normalY*relativeX + normalX*relativeY));
+            double distanceX = relativeX + normalY*alongSide;
+            double distanceY = relativeY - normalX*alongSide;
+            squaredDistanceFromViolatedSides = std::min(squaredDistanceFromViolatedSides, distanceX*distanceX + distanceY*distanceY);
+        }
+
+        if (isInside)
+        {
+            return distanceFromSides;
+        }
+
+        return -std::sqrt(squaredDistanceFromViolatedSides);
+    }
+
+    void ConvexHull2D::computeMargins(const std::vector<Vector2>& points, VectorDynSize& margins) const
+    {
+        margins.resize(points.size());
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            margins(i) = computeMargin(points[i]);
+        }
+    }
+
     void ConvexHullProjectionConstraint::setActive(const bool isActive)
     {
         m_isActive = isActive;
@@ -167,63 +569,120 @@ namespace iDynTree
             return false;
         }
 
-        // Compute the convex hull using the Monotone Chain
+        // Update the convex hull with the points of the contacts that changed since the last call
+        updateConvexHullPoints(projectedPoints);
+        projectedConvexHull = m_convexHull.getConvexHull();
 
-        // Order the projected points with a lexographical ordering
-        struct
-        {
-            bool operator()(Vector2 a, Vector2 b)
-            {
-                return (a(0) < b(0)) || ( (a(0) == b(0)) && (a(1) < b(1)) );
-            }
-        } vector2lexographical;
+        // Build the constraint matrix
+        buildConstraintMatrix();
 
-        std::sort(projectedPoints.begin(), projectedPoints.end(), vector2lexographical);
+        // Update AtimesP matrix
+        AtimesP.resize(A.rows(),P.cols());
 
-        // Reset the convex hull (it will be properly resized after running the algorithm
-        projectedConvexHull.m_vertices.resize(2*projectedPoints.size());
-        size_t k = 0;
+        toEigen(AtimesP) = toEigen(A)*toEigen(P);
 
-        // Build the upper hull
-        for (int i = 0; i < projectedPoints.size(); ++i)
+        return true;
+    }
+
+    void ConvexHullProjectionConstraint::updateConvexHullPoints(const std::vector<Vector2>& projectedPoints)
+    {
+        // Sort the old and the new points in lexographical order
+        m_sortedOldPointIndices.resize(m_projectedPoints.size());
+        for (size_t i = 0; i < m_projectedPoints.size(); i++)
+        {
+            m_sortedOldPointIndices[i] = i;
+        }
+        std::sort(m_sortedOldPointIndices.begin(), m_sortedOldPointIndices.end(),
+                  [this](size_t a, size_t b) { return vector2lexographical(m_projectedPoints[a], m_projectedPoints[b]); });
+
+        m_sortedNewPointIndices.resize(projectedPoints.size());
+        for (size_t j = 0; j < projectedPoints.size(); j++)
+        {
+            m_sortedNewPointIndices[j] = j;
+        }
+        std::sort(m_sortedNewPointIndices.begin(), m_sortedNewPointIndices.end(),
+                  [&projectedPoints](size_t a, size_t b) { return vector2lexographical(projectedPoints[a], projectedPoints[b]); });
+
+        // The points of the supports that did not move are the same as in the previous call.
+        // A point that is not matched is just removed and added again, so the hull is correct anyway.
+        m_isOldPointKept.assign(m_projectedPoints.size(), false);
+        m_isNewPointKept.assign(projectedPoints.size(), false);
+        m_newProjectedPoints.resize(projectedPoints.size());
+        m_newProjectedPointIDs.resize(projectedPoints.size());
+        size_t nrOfKeptPoints = 0;
+        size_t oldIdx = 0;
+        size_t newIdx = 0;
+        while (oldIdx < m_sortedOldPointIndices.size() && newIdx < m_sortedNewPointIndices.size())
         {
-            while (k >= 2 && monotono_chain_cross(projectedConvexHull.m_vertices[k-2],
-                                                  projectedConvexHull.m_vertices[k-1],
-                                                  projectedPoints[i]) <= 0)
+            size_t i = m_sortedOldPointIndices[oldIdx];
+            size_t j = m_sortedNewPointIndices[newIdx];
+            if (vector2AreClose(m_projectedPoints[i], projectedPoints[j], projectedPointsMatchingTolerance))
             {
-                k = k-1;
+                // Keep the point stored in the hull, so that it does not drift within the tolerance
+                m_isOldPointKept[i] = true;
+                m_isNewPointKept[j] = true;
+                m_newProjectedPoints[j] = m_projectedPoints[i];
+                m_newProjectedPointIDs[j] = m_projectedPointIDs[i];
+                nrOfKeptPoints++;
+                oldIdx++;
+                newIdx++;
+            }
+            else if (vector2lexographical(m_projectedPoints[i], projectedPoints[j]))
+            {
+                oldIdx++;
+            }
+            else
+            {
+                newIdx++;
             }
-
-            projectedConvexHull.m_vertices[k] = projectedPoints[i];
-            k = k+1;
-
         }
 
-        // Build the lower hull
-        for (int i = projectedPoints.size()-2, t = k+1; i >= 0; i--)
+        // If all the supports changed, compute the convex hull from scratch using the Monotone Chain
+        if (nrOfKeptPoints == 0)
         {
-            while (k >= t && monotono_chain_cross(projectedConvexHull.m_vertices[k-2],
-                                                  projectedConvexHull.m_vertices[k-1],
-                                                  projectedPoints[i]) <= 0)
+            m_convexHull.setPoints(projectedPoints);
+            m_projectedPoints = projectedPoints;
+            m_projectedPointIDs.resize(projectedPoints.size());
+            for (size_t i = 0; i < projectedPoints.size(); i++)
             {
-                k = k-1;
+                m_projectedPointIDs[i] = i;
             }
-
-            projectedConvexHull.m_vertices[k] = projectedPoints[i];
-            k = k+1;
+            return;
         }
 
-        projectedConvexHull.m_vertices.resize(k-1);
-
-        // Build the constraint matrix
-        buildConstraintMatrix();
-
-        // Update AtimesP matrix
-        AtimesP.resize(A.rows(),P.cols());
+        // Otherwise remove the points of the broken contacts, and add the ones of the new contacts
+        m_removedPointIDs.clear();
+        for (size_t i = 0; i < m_projectedPoints.size(); i++)
+        {
+            if (!m_isOldPointKept[i])
+            {
+                m_removedPointIDs.push_back(m_projectedPointIDs[i]);
+            }
+        }
+        m_convexHull.removePoints(m_removedPointIDs);
 
-        toEigen(AtimesP) = toEigen(A)*toEigen(P);
+        m_addedPoints.clear();
+        for (size_t j = 0; j < projectedPoints.size(); j++)
+        {
+            if (!m_isNewPointKept[j])
+            {
+                m_addedPoints.push_back(projectedPoints[j]);
+            }
+        }
+        m_convexHull.addPoints(m_addedPoints, m_addedPointIDs);
 
-        return true;
+        size_t addedIdx = 0;
+        for (size_t j = 0; j < projectedPoints.size(); j++)
+        {
+            if (!m_isNewPointKept[j])
+            {
+                m_newProjectedPoints[j] = projectedPoints[j];
+                m_newProjectedPointIDs[j] = m_addedPointIDs[addedIdx];
+                addedIdx++;
+            }
+        }
+        m_projectedPoints.swap(m_newProjectedPoints);
+        m_projectedPointIDs.swap(m_newProjectedPointIDs);
     }
 
     void ConvexHullProjectionConstraint::buildConstraintMatrix()
@@ -265,90 +724,9 @@ namespace iDynTree
         return projected;
     }
 
-    double distanceBetweentTwoPoints(const Vector2& firstPoint,
-                                     const Vector2& secondPoint)
-    {
-        return (toEigen(firstPoint)-toEigen(secondPoint)).norm();
-    }
-
-    double distanceBetweenPointAndSegment(const Vector2& point,
-                                          const Vector2& segmentFirstPoint,
-                                          const Vector2& segmentLastPoint)
-    {
-        double segmentLengthSquared = (toEigen(segmentLastPoint)-toEigen(segmentFirstPoint)).squaredNorm();
-
-        // First case: the segment is actually a point
-        if (segmentLengthSquared == 0.0)
-        {
-            return distanceBetweentTwoPoints(point, segmentFirstPoint);
-        }
-
-        // The segment can be written as the set of segment points sp that can be written as:
-        // sp = segmentFirstPoint + t*( segmentLastPoint - segmentFirstPoint )
-        // for t \in [0, 1]
-        // To find the segment point closest to the point, we can just find the t of the projection
-        // of the point in the segment, and clamp it to [0, 1]
-        double tProjection = ((toEigen(point)-toEigen(segmentFirstPoint)).dot(toEigen(segmentLastPoint)-toEigen(segmentFirstPoint)))/segmentLengthSquared;
-
-        double tClosestPoint = std::max(0.0, std::min(1.0, tProjection));
-
-        Vector2 closestPoint;
-        toEigen(closestPoint) = toEigen(segmentFirstPoint) + tClosestPoint*(toEigen(segmentLastPoint)-toEigen(segmentFirstPoint));
-
-        return distanceBetweentTwoPoints(point, closestPoint);
-    }
-
     double ConvexHullProjectionConstraint::computeMargin(const Vector2& posIn2D)
     {
-        bool isInside = true;
-
-        // First check if the point is inside the convex hull or not
-        iDynTree::VectorDynSize Ax(A.rows());
-
-        toEigen(Ax) = toEigen(A)*toEigen(posIn2D);
-
-        // If even one of the constraint is violated, then the point is outside the convex hull
-        for (int i=0; i < Ax.size(); i++)
-        {
-            if (!(Ax(i) <= b(i)))
-            {
-                isInside = false;
-                break;
-            }
-        }
-
-        // Then, compute the distance between each segment of the convex hull and the point :
-        // the minimum one is the distance of the point from the convex hull
-
-        // We start from the last segment that do not follow the segment[i],segment[i+1] structure
-        double distanceWithoutSign = distanceBetweenPointAndSegment(posIn2D,
-                                                                    projectedConvexHull(projectedConvexHull.getNrOfVertices()-1),
-                                                                    projectedConvexHull(0));
-        // Find the minimum distance
-        for (int i=0; i < projectedConvexHull.getNrOfVertices()-1; i++)
-        {
-            double candidateDistance = distanceBetweenPointAndSegment(posIn2D,
-                                                                      projectedConvexHull(i),
-                                                                      projectedConvexHull(i+1));
-
-            if (candidateDistance < distanceWithoutSign)
-            {
-                distanceWithoutSign = candidateDistance;
-            }
-        }
-
-        double margin;
-        // If the point is inside the convex hull, we return the distance, otherwise the negated distance
-        if (isInside)
-        {
-            margin = distanceWithoutSign;
-        }
-        else
-        {
-            margin = -distanceWithoutSign;
-        }
-
-        return margin;
+        return m_convexHull.computeMargin(posIn2D);
     }
 
     void ConvexHullProjectionConstraint::setProjectionAlongDirection(Vector3 direction)
@@ -378,4 +756,26 @@ namespace iDynTree
         return projected;
     }
 
+    void ConvexHullProjectionConstraint::projectAlongDirection(const std::vector<iDynTree::Position>& positionsIn3dInAbsoluteFrame,
+                                                               std::vector<Vector2>& projections) const
+    {
+        projections.resize(positionsIn3dInAbsoluteFrame.size());
+        for (size_t i = 0; i < positionsIn3dInAbsoluteFrame.size(); i++)
+        {
+            toEigen(projections[i]) = toEigen(Pdirection) * (toEigen(positionsIn3dInAbsoluteFrame[i]) - toEigen(o));
+        }
+    }
+
+    void ConvexHullProjectionConstraint::computeMargins(const std::vector<iDynTree::Position>& positionsIn3dInAbsoluteFrame,
+                                                        VectorDynSize& margins) const
+    {
+        margins.resize(positionsIn3dInAbsoluteFrame.size());
+        iDynTree::Vector2 projected;
+        for (size_t i = 0; i < positionsIn3dInAbsoluteFrame.size(); i++)
+        {
+            toEigen(projected) = toEigen(Pdirection) * (toEigen(positionsIn3dInAbsoluteFrame[i]) - toEigen(o));
+            margins(i) = m_convexHull.computeMargin(projected);
+        }
+    }
+
 }
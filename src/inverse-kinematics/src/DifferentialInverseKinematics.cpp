@@ -0,0 +1,1064 @@
+/*
+ * Copyright (C) 2016 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/DifferentialInverseKinematics.h>
+
+#include <iDynTree/Core/Axis.h>
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Transform.h>
+#include <iDynTree/Core/Twist.h>
+#include <iDynTree/Core/Utils.h>
+#include <iDynTree/Core/VectorDynSize.h>
+#include <iDynTree/KinDynComputations.h>
+#include <iDynTree/Model/Model.h>
+
+#ifdef IDYNTREE_USES_OSQPEIGEN
+#include <iDynTree/Core/MatrixDynSize.h>
+#include <iDynTree/OptimizationProblem.h>
+#include <iDynTree/Optimizers/OsqpInterface.h>
+#endif
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+#ifndef IDYNTREE_USES_OSQPEIGEN
+    bool missingOsqpErrorReport() {
+        iDynTree::reportError("DifferentialInverseKinematics", "", "IDYNTREE_USES_OSQPEIGEN CMake option need to be set to ON to use DifferentialInverseKinematics");
+        return false;
+    }
+#endif
+
+    /*
+     * A target or a constraint on the pose of a frame
+     */
+    struct FrameTask
+    {
+        iDynTree::FrameIndex frameIndex;
+        bool hasPosition;
+        bool hasRotation;
+        iDynTree::Transform value;
+        double positionWeight;
+        double rotationWeight;
+        bool isActive;
+
+        unsigned nrOfRows() const
+        {
+            return (hasPosition ? 3 : 0) + (hasRotation ? 3 : 0);
+        }
+    };
+
+    FrameTask* findTask(std::vector<FrameTask>& tasks, const iDynTree::FrameIndex frameIndex)
+    {
+        for (FrameTask& task : tasks) {
+            if (task.frameIndex == frameIndex) {
+                return &task;
+            }
+        }
+        return nullptr;
+    }
+
+    /*
+     * Buffers of the QP
+     *   min 1/2 x' P x + q' x  s.t.  l <= A x <= u
+     * resized only when the structure of the problem changes.
+     */
+    struct QuadraticProgram
+    {
+        Eigen::MatrixXd P;
+        Eigen::VectorXd q;
+        Eigen::MatrixXd A;
+        Eigen::VectorXd l;
+        Eigen::VectorXd u;
+
+        void resize(const Eigen::Index nrOfVariables, const Eigen::Index nrOfConstraints)
+        {
+            P.setZero(nrOfVariables, nrOfVariables);
+            q.setZero(nrOfVariables);
+            A.setZero(nrOfConstraints, nrOfVariables);
+            l.setZero(nrOfConstraints);
+            u.setZero(nrOfConstraints);
+        }
+    };
+
+#ifdef IDYNTREE_USES_OSQPEIGEN
+    /*
+     * Exposes the QP to iDynTree::optimization::OsqpInterface.
+     * The rows of the constraints on the joints (the last ones) have a single nonzero element,
+     * all the other blocks are dense.
+     */
+    class QuadraticProgramProblem : public iDynTree::optimization::OptimizationProblem
+    {
+        const QuadraticProgram& m_qp;
+        size_t m_nrOfJointRows;
+        Eigen::VectorXd m_variables;
+
+    public:
+        QuadraticProgramProblem(const QuadraticProgram& qp)
+        : m_qp(qp)
+        , m_nrOfJointRows(0)
+        {
+            m_infoData->hasLinearConstraints = true;
+            m_infoData->hasNonLinearConstraints = false;
+            m_infoData->costIsQuadratic = true;
+            m_infoData->costIsNonLinear = false;
+            m_infoData->hasSparseConstraintJacobian = true;
+            m_infoData->hasSparseHessian = true;
+            m_infoData->hessianIsProvided = true;
+        }
+
+        void setNumberOfJointRows(const size_t nrOfJointRows)
+        {
+            m_nrOfJointRows = nrOfJointRows;
+        }
+
+        virtual bool prepare() override
+        {
+            m_variables.setZero(m_qp.P.rows());
+            return true;
+        }
+
+        virtual unsigned int numberOfVariables() override
+        {
+            return static_cast<unsigned int>(m_qp.P.rows());
+        }
+
+        virtual unsigned int numberOfConstraints() override
+        {
+            return static_cast<unsigned int>(m_qp.A.rows());
+        }
+
+        virtual bool getConstraintsBounds(iDynTree::VectorDynSize& constraintsLowerBounds,
+                                          iDynTree::VectorDynSize& constraintsUpperBounds) override
+        {
+            constraintsLowerBounds.resize(numberOfConstraints());
+            constraintsUpperBounds.resize(numberOfConstraints());
+            toEigen(constraintsLowerBounds) = m_qp.l;
+            toEigen(constraintsUpperBounds) = m_qp.u;
+            return true;
+        }
+
+        virtual bool getConstraintsJacobianInfo(std::vector<size_t>& nonZeroElementRows,
+                                                std::vector<size_t>& nonZeroElementColumns) override
+        {
+            size_t denseRows = m_qp.A.rows() - m_nrOfJointRows;
+            size_t nrOfVariables = m_qp.A.cols();
+            nonZeroElementRows.clear();
+            nonZeroElementColumns.clear();
+            for (size_t row = 0; row < denseRows; ++row) {
+                for (size_t col = 0; col < nrOfVariables; ++col) {
+                    nonZeroElementRows.push_back(row);
+                    nonZeroElementColumns.push_back(col);
+                }
+            }
+            for (size_t i = 0; i < m_nrOfJointRows; ++i) {
+                nonZeroElementRows.push_back(denseRows + i);
+                nonZeroElementColumns.push_back(nrOfVariables - m_nrOfJointRows + i);
+            }
+            return true;
+        }
+
+        virtual bool getHessianInfo(std::vector<size_t>& nonZeroElementRows,
+                                    std::vector<size_t>& nonZeroElementColumns) override
+        {
+            size_t nrOfVariables = m_qp.P.rows();
+            nonZeroElementRows.clear();
+            nonZeroElementColumns.clear();
+            for (size_t row = 0; row < nrOfVariables; ++row) {
+                for (size_t col = 0; col < nrOfVariables; ++col) {
+                    nonZeroElementRows.push_back(row);
+                    nonZeroElementColumns.push_back(col);
+                }
+            }
+            return true;
+        }
+
+        virtual bool setVariables(const iDynTree::VectorDynSize& variables) override
+        {
+            if (variables.size() != numberOfVariables()) {
+                return false;
+            }
+            m_variables = toEigen(variables);
+            return true;
+        }
+
+        virtual bool evaluateCostFunction(double& costValue) override
+        {
+            costValue = 0.5 * m_variables.dot(m_qp.P * m_variables) + m_qp.q.dot(m_variables);
+            return true;
+        }
+
+        virtual bool evaluateCostGradient(iDynTree::VectorDynSize& gradient) override
+        {
+            gradient.resize(numberOfVariables());
+            toEigen(gradient) = m_qp.q;
+            toEigen(gradient).noalias() += m_qp.P * m_variables;
+            return true;
+        }
+
+        virtual bool evaluateCostHessian(iDynTree::MatrixDynSize& hessian) override
+        {
+            hessian.resize(numberOfVariables(), numberOfVariables());
+            toEigen(hessian) = m_qp.P;
+            return true;
+        }
+
+        virtual bool evaluateConstraints(iDynTree::VectorDynSize& constraints) override
+        {
+            constraints.resize(numberOfConstraints());
+            toEigen(constraints).noalias() = m_qp.A * m_variables;
+            return true;
+        }
+
+        virtual bool evaluateConstraintsJacobian(iDynTree::MatrixDynSize& jacobian) override
+        {
+            jacobian.resize(numberOfConstraints(), numberOfVariables());
+            toEigen(jacobian) = m_qp.A;
+            return true;
+        }
+    };
+#endif
+}
+
+namespace iDynTree {
+
+    class DifferentialInverseKinematics::DifferentialInverseKinematicsPimpl
+    {
+    public:
+        iDynTree::KinDynComputations m_dynamics;
+        size_t m_dofs;
+        std::vector<size_t> m_optimisedDofs;
+        std::vector<std::pair<double, double> > m_jointLimits;
+
+        iDynTree::Transform m_baseTransform;
+        iDynTree::VectorDynSize m_jointPositions;
+        iDynTree::Twist m_zeroBaseVelocity;
+        iDynTree::VectorDynSize m_zeroJointVelocities;
+        iDynTree::Vector3 m_gravity;
+
+        std::vector<FrameTask> m_targets;
+        std::vector<FrameTask> m_constraints;
+
+        bool m_comTargetActive;
+        iDynTree::Position m_comTarget;
+        double m_comTargetWeight;
+
+        bool m_comHullRequested;
+        bool m_comHullActive;
+        iDynTree::ConvexHullProjectionConstraint m_comHullConstraint;
+        std::vector<iDynTree::FrameIndex> m_comHullSupportFrames;
+        std::vector<iDynTree::Polygon> m_comHullSupportPolygons;
+        iDynTree::Direction m_comHullXAxis;
+        iDynTree::Direction m_comHullYAxis;
+        iDynTree::Position m_comHullOrigin;
+
+        bool m_postureActive;
+        iDynTree::VectorDynSize m_desiredJoints;
+        double m_postureWeight;
+
+        double m_gain;
+        double m_regularization;
+        int m_maxIterations;
+        double m_tolerance;
+
+        bool m_structureChanged;
+        size_t m_nrOfConstraintRows;
+        iDynTree::MatrixDynSize m_frameJacobian;
+        iDynTree::MatrixDynSize m_comJacobian;
+        Eigen::MatrixXd m_reducedJacobian;
+        Eigen::MatrixXd m_comHullProjection;
+        Eigen::MatrixXd m_projectedComJacobian;
+        Eigen::VectorXd m_constraintsValues;
+        QuadraticProgram m_qp;
+        double m_infinity;
+#ifdef IDYNTREE_USES_OSQPEIGEN
+        std::shared_ptr<QuadraticProgramProblem> m_problem;
+        iDynTree::optimization::OsqpInterface m_osqp;
+#endif
+
+        bool m_hasSolution;
+        iDynTree::VectorDynSize m_step;
+
+        DifferentialInverseKinematicsPimpl()
+        : m_dofs(0)
+        , m_comTargetActive(false)
+        , m_comTargetWeight(1.0)
+        , m_comHullRequested(false)
+        , m_comHullActive(false)
+        , m_postureActive(false)
+        , m_postureWeight(1e-6)
+        , m_gain(1.0)
+        , m_regularization(1e-6)
+        , m_maxIterations(4000)
+        , m_tolerance(1e-5)
+        , m_structureChanged(true)
+        , m_nrOfConstraintRows(0)
+        , m_infinity(std::numeric_limits<double>::infinity())
+        , m_hasSolution(false)
+        {
+            m_zeroBaseVelocity.zero();
+            m_gravity.zero();
+#ifdef IDYNTREE_USES_OSQPEIGEN
+            m_problem = std::make_shared<QuadraticProgramProblem>(m_qp);
+            m_osqp.setProblem(m_problem);
+            m_osqp.settings().verbose = false;
+            m_infinity = m_osqp.plusInfinity();
+#endif
+        }
+
+        size_t nrOfVariables() const
+        {
+            return 6 + m_optimisedDofs.size();
+        }
+
+        // Copy the columns of the free floating jacobian related to the optimisation variables
+        void reduceJacobian(const iDynTree::MatrixDynSize& fullJacobian, const Eigen::Index rows)
+        {
+            iDynTree::iDynTreeEigenConstMatrixMap full = toEigen(fullJacobian);
+            m_reducedJacobian.topLeftCorner(rows, 6) = full.topLeftCorner(rows, 6);
+            for (size_t i = 0; i < m_optimisedDofs.size(); ++i) {
+                m_reducedJacobian.block(0, 6 + i, rows, 1) = full.block(0, 6 + m_optimisedDofs[i], rows, 1);
+            }
+        }
+
+        void configureCenterOfMassProjectionConstraint()
+        {
+            m_comHullActive = false;
+            m_comHullConstraint.setActive(false);
+            if (!m_comHullRequested) {
+                return;
+            }
+
+            std::vector<iDynTree::Transform> world_H_support;
+            std::vector<iDynTree::Polygon> usedPolygons;
+            m_comHullConstraint.supportFrameIndices.resize(0);
+            for (size_t i = 0; i < m_comHullSupportFrames.size(); ++i) {
+                FrameTask* constraint = findTask(m_constraints, m_comHullSupportFrames[i]);
+                if (constraint && constraint->isActive) {
+                    world_H_support.push_back(constraint->value);
+                    usedPolygons.push_back(m_comHullSupportPolygons[i]);
+                    m_comHullConstraint.supportFrameIndices.push_back(m_comHullSupportFrames[i]);
+                }
+            }
+
+            if (usedPolygons.empty()) {
+                return;
+            }
+
+            iDynTree::Direction zAxisOfPlaneInWorld;
+            toEigen(zAxisOfPlaneInWorld) = toEigen(m_comHullXAxis).cross(toEigen(m_comHullYAxis));
+            m_comHullConstraint.setProjectionAlongDirection(zAxisOfPlaneInWorld);
+
+            if (!m_comHullConstraint.buildConvexHull(m_comHullXAxis, m_comHullYAxis, m_comHullOrigin,
+                                                     usedPolygons, world_H_support)) {
+                reportWarning("DifferentialInverseKinematics", "solve", "Unable to build the convex hull of the support polygons, the center of mass projection constraint is ignored");
+                return;
+            }
+            m_comHullConstraint.absoluteFrame_X_supportFrame = world_H_support;
+            m_comHullConstraint.setActive(true);
+            m_comHullActive = true;
+        }
+
+        void updateStructure()
+        {
+            configureCenterOfMassProjectionConstraint();
+
+            m_nrOfConstraintRows = 0;
+            for (const FrameTask& constraint : m_constraints) {
+                if (constraint.isActive) {
+                    m_nrOfConstraintRows += constraint.nrOfRows();
+                }
+            }
+            size_t nrOfHullRows = m_comHullActive ? m_comHullConstraint.getNrOfConstraints() : 0;
+
+            size_t n = nrOfVariables();
+            m_qp.resize(n, m_nrOfConstraintRows + nrOfHullRows + m_optimisedDofs.size());
+#ifdef IDYNTREE_USES_OSQPEIGEN
+            m_problem->setNumberOfJointRows(m_optimisedDofs.size());
+#endif
+            m_reducedJacobian.setZero(6, n);
+            m_projectedComJacobian.setZero(nrOfHullRows, n);
+            m_constraintsValues.setZero(m_qp.A.rows());
+
+            // The hull and the projection direction change only with the structure of the problem
+            m_comHullProjection.resize(nrOfHullRows, 3);
+            if (m_comHullActive) {
+                m_comHullProjection.noalias() = toEigen(m_comHullConstraint.A) * toEigen(m_comHullConstraint.Pdirection);
+            }
+            m_structureChanged = false;
+        }
+
+        // Add w || J delta - gain e ||^2 to the cost, with J given by the rows of the reduced jacobian
+        void addLeastSquaresTerm(const Eigen::Index firstRow, const Eigen::Ref<const Eigen::Vector3d>& error, const double weight)
+        {
+            auto jacobian = m_reducedJacobian.middleRows<3>(firstRow);
+            m_qp.P.noalias() += weight * jacobian.transpose() * jacobian;
+            m_qp.q.noalias() -= (weight * m_gain) * jacobian.transpose() * error;
+        }
+
+        // Add the equality rows J delta = gain e to the constraints
+        void addEqualityRows(Eigen::Index& row, const Eigen::Index firstRow, const Eigen::Ref<const Eigen::Vector3d>& error)
+        {
+            m_qp.A.middleRows<3>(row) = m_reducedJacobian.middleRows<3>(firstRow);
+            m_qp.l.segment<3>(row) = m_gain * error;
+            m_qp.u.segment<3>(row) = m_gain * error;
+            row += 3;
+        }
+
+        bool buildProblem()
+        {
+            m_qp.P.setZero();
+            m_qp.q.setZero();
+            m_qp.A.setZero();
+
+            Eigen::Vector3d positionError;
+            Eigen::Vector3d rotationError;
+
+            for (const FrameTask& target : m_targets) {
+                if (!m_dynamics.getFrameFreeFloatingJacobian(target.frameIndex, m_frameJacobian)) {
+                    return false;
+                }
+                reduceJacobian(m_frameJacobian, 6);
+                const iDynTree::Transform world_H_frame = m_dynamics.getWorldTransform(target.frameIndex);
+
+                if (target.hasPosition) {
+                    positionError = toEigen(target.value.getPosition()) - toEigen(world_H_frame.getPosition());
+                    addLeastSquaresTerm(0, positionError, target.positionWeight);
+                }
+                if (target.hasRotation) {
+                    rotationError = toEigen((target.value.getRotation() * world_H_frame.getRotation().inverse()).log());
+                    addLeastSquaresTerm(3, rotationError, target.rotationWeight);
+                }
+            }
+
+            if (m_comTargetActive || m_comHullActive) {
+                if (!m_dynamics.getCenterOfMassJacobian(m_comJacobian)) {
+                    return false;
+                }
+                reduceJacobian(m_comJacobian, 3);
+            }
+
+            iDynTree::Position com;
+            if (m_comTargetActive || m_comHullActive) {
+                com = m_dynamics.getCenterOfMassPosition();
+            }
+
+            if (m_comTargetActive) {
+                positionError = toEigen(m_comTarget) - toEigen(com);
+                addLeastSquaresTerm(0, positionError, m_comTargetWeight);
+            }
+
+            // Joint-space terms and regularization
+            for (size_t i = 0; i < m_optimisedDofs.size(); ++i) {
+                if (m_postureActive) {
+                    size_t dof = m_optimisedDofs[i];
+                    m_qp.P(6 + i, 6 + i) += m_postureWeight;
+                    m_qp.q(6 + i) -= m_postureWeight * m_gain * (m_desiredJoints(dof) - m_jointPositions(dof));
+                }
+            }
+            m_qp.P.diagonal().array() += m_regularization;
+
+            // Constraints
+            Eigen::Index row = 0;
+            if (m_comHullActive) {
+                size_t nrOfHullRows = m_comHullConstraint.getNrOfConstraints();
+                m_projectedComJacobian.noalias() = m_comHullProjection * m_reducedJacobian.topRows<3>();
+                m_qp.A.topRows(nrOfHullRows) = m_projectedComJacobian;
+                iDynTree::Vector2 projectedCom = m_comHullConstraint.projectAlongDirection(com);
+                m_qp.l.head(nrOfHullRows).setConstant(-m_infinity);
+                m_qp.u.head(nrOfHullRows) = toEigen(m_comHullConstraint.b);
+                m_qp.u.head(nrOfHullRows).noalias() -= toEigen(m_comHullConstraint.A) * toEigen(projectedCom);
+                row += nrOfHullRows;
+            }
+
+            for (const FrameTask& constraint : m_constraints) {
+                if (!constraint.isActive) {
+                    continue;
+                }
+                if (!m_dynamics.getFrameFreeFloatingJacobian(constraint.frameIndex, m_frameJacobian)) {
+                    return false;
+                }
+                reduceJacobian(m_frameJacobian, 6);
+                const iDynTree::Transform world_H_frame = m_dynamics.getWorldTransform(constraint.frameIndex);
+
+                if (constraint.hasPosition) {
+                    positionError = toEigen(constraint.value.getPosition()) - toEigen(world_H_frame.getPosition());
+                    addEqualityRows(row, 0, positionError);
+                }
+                if (constraint.hasRotation) {
+                    rotationError = toEigen((constraint.value.getRotation() * world_H_frame.getRotation().inverse()).log());
+                    addEqualityRows(row, 3, rotationError);
+                }
+            }
+
+            for (size_t i = 0; i < m_optimisedDofs.size(); ++i, ++row) {
+                size_t dof = m_optimisedDofs[i];
+                m_qp.A(row, 6 + i) = 1.0;
+                m_qp.l(row) = m_jointLimits[dof].first <= -1e19 ? -m_infinity
+                                                                    : m_jointLimits[dof].first - m_jointPositions(dof);
+                m_qp.u(row) = m_jointLimits[dof].second >= 1e19 ? m_infinity
+                                                                    : m_jointLimits[dof].second - m_jointPositions(dof);
+            }
+
+            return true;
+        }
+
+        // Check that the step satisfies the constraints, with the termination criterion of OSQP on the primal residual
+        bool isStepFeasible()
+        {
+            if (m_qp.A.rows() == 0) {
+                return true;
+            }
+            m_constraintsValues.noalias() = m_qp.A * toEigen(m_step);
+            double residual = (m_constraintsValues.cwiseMax(m_qp.l).cwiseMin(m_qp.u) - m_constraintsValues).lpNorm<Eigen::Infinity>();
+            double scale = std::max(m_constraintsValues.lpNorm<Eigen::Infinity>(),
+                                    m_constraintsValues.cwiseMax(m_qp.l).cwiseMin(m_qp.u).lpNorm<Eigen::Infinity>());
+            return residual <= 10.0 * m_tolerance * (1.0 + scale);
+        }
+
+        bool addFrameTask(std::vector<FrameTask>& tasks, const char* method, const std::string& frameName,
+                          const bool hasPosition, const bool hasRotation, const iDynTree::Transform& value,
+                          const double positionWeight, const double rotationWeight)
+        {
+            iDynTree::FrameIndex frameIndex = m_dynamics.getFrameIndex(frameName);
+            if (frameIndex == iDynTree::FRAME_INVALID_INDEX) {
+                std::stringstream ss;
+                ss << "Frame " << frameName << " not found in the model";
+                reportError("DifferentialInverseKinematics", method, ss.str().c_str());
+                return false;
+            }
+            if (findTask(tasks, frameIndex)) {
+                std::stringstream ss;
+                ss << "Frame " << frameName << " is already in use";
+                reportError("DifferentialInverseKinematics", method, ss.str().c_str());
+                return false;
+            }
+
+            FrameTask task;
+            task.frameIndex = frameIndex;
+            task.hasPosition = hasPosition;
+            task.hasRotation = hasRotation;
+            task.value = value;
+            task.positionWeight = positionWeight;
+            task.rotationWeight = rotationWeight;
+            task.isActive = true;
+            tasks.push_back(task);
+            return true;
+        }
+
+        FrameTask* getFrameTask(std::vector<FrameTask>& tasks, const char* method, const std::string& frameName)
+        {
+            FrameTask* task = findTask(tasks, m_dynamics.getFrameIndex(frameName));
+            if (!task) {
+                std::stringstream ss;
+                ss << "Frame " << frameName << " is not a target or a constraint";
+                reportError("DifferentialInverseKinematics", method, ss.str().c_str());
+            }
+            return task;
+        }
+
+        bool isSupportFrame(const iDynTree::FrameIndex frameIndex) const
+        {
+            return m_comHullRequested && std::find(m_comHullSupportFrames.begin(), m_comHullSupportFrames.end(), frameIndex) != m_comHullSupportFrames.end();
+        }
+    };
+
+    DifferentialInverseKinematics::DifferentialInverseKinematics()
+    : m_pimpl(new DifferentialInverseKinematicsPimpl())
+    {
+    }
+
+    DifferentialInverseKinematics::~DifferentialInverseKinematics()
+    {
+    }
+
+    bool DifferentialInverseKinematics::setModel(const iDynTree::Model& model, const std::vector<std::string>& consideredJoints)
+    {
+        if (!m_pimpl->m_dynamics.loadRobotModel(model) || !m_pimpl->m_dynamics.isValid()) {
+            reportError("DifferentialInverseKinematics", "setModel", "Error loading robot model");
+            return false;
+        }
+        m_pimpl->m_dynamics.setFrameVelocityRepresentation(iDynTree::MIXED_REPRESENTATION);
+
+        m_pimpl->m_dofs = model.getNrOfDOFs();
+        m_pimpl->m_optimisedDofs.clear();
+        if (consideredJoints.empty()) {
+            for (size_t dof = 0; dof < m_pimpl->m_dofs; ++dof) {
+                m_pimpl->m_optimisedDofs.push_back(dof);
+            }
+        } else {
+            for (const std::string& jointName : consideredJoints) {
+                iDynTree::JointIndex jointIndex = model.getJointIndex(jointName);
+                if (jointIndex == iDynTree::JOINT_INVALID_INDEX) {
+                    std::stringstream ss;
+                    ss << "Joint " << jointName << " not found in the model";
+                    reportError("DifferentialInverseKinematics", "setModel", ss.str().c_str());
+                    return false;
+                }
+                iDynTree::IJointConstPtr joint = model.getJoint(jointIndex);
+                for (unsigned dof = 0; dof < joint->getNrOfDOFs(); ++dof) {
+                    m_pimpl->m_optimisedDofs.push_back(joint->getDOFsOffset() + dof);
+                }
+            }
+        }
+
+        //default: no limits
+        m_pimpl->m_jointLimits.assign(m_pimpl->m_dofs, std::pair<double, double>(-2e+19, 2e+19));
+        for (iDynTree::JointIndex jointIdx = 0; jointIdx < static_cast<iDynTree::JointIndex>(model.getNrOfJoints()); ++jointIdx) {
+            iDynTree::IJointConstPtr joint = model.getJoint(jointIdx);
+            if (!joint->hasPosLimits())
+                continue;
+            for (unsigned dof = 0; dof < joint->getNrOfDOFs(); ++dof) {
+                joint->getPosLimits(dof,
+                                    m_pimpl->m_jointLimits[joint->getDOFsOffset() + dof].first,
+                                    m_pimpl->m_jointLimits[joint->getDOFsOffset() + dof].second);
+            }
+        }
+
+        m_pimpl->m_frameJacobian.resize(6, 6 + m_pimpl->m_dofs);
+        m_pimpl->m_comJacobian.resize(3, 6 + m_pimpl->m_dofs);
+        m_pimpl->m_zeroJointVelocities.resize(m_pimpl->m_dofs);
+        m_pimpl->m_zeroJointVelocities.zero();
+        m_pimpl->m_desiredJoints.resize(m_pimpl->m_dofs);
+        m_pimpl->m_desiredJoints.zero();
+
+        //We set a new model, clear the variables
+        clearProblem();
+
+        m_pimpl->m_baseTransform = iDynTree::Transform::Identity();
+        m_pimpl->m_jointPositions.resize(m_pimpl->m_dofs);
+        m_pimpl->m_jointPositions.zero();
+        return setCurrentRobotConfiguration(m_pimpl->m_baseTransform, m_pimpl->m_jointPositions);
+    }
+
+    bool DifferentialInverseKinematics::setJointLimits(const std::vector<std::pair<double, double> >& jointLimits)
+    {
+        if (jointLimits.size() != m_pimpl->m_jointLimits.size()) {
+            reportError("DifferentialInverseKinematics", "setJointLimits", "Size mismatch between the joint limits and the model dofs");
+            return false;
+        }
+        m_pimpl->m_jointLimits = jointLimits;
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::getJointLimits(std::vector<std::pair<double, double> >& jointLimits) const
+    {
+        jointLimits = m_pimpl->m_jointLimits;
+        return true;
+    }
+
+    void DifferentialInverseKinematics::clearProblem()
+    {
+        m_pimpl->m_targets.clear();
+        m_pimpl->m_constraints.clear();
+        m_pimpl->m_comTargetActive = false;
+        m_pimpl->m_comHullRequested = false;
+        m_pimpl->m_comHullActive = false;
+        m_pimpl->m_comHullConstraint.setActive(false);
+        m_pimpl->m_comHullSupportFrames.clear();
+        m_pimpl->m_comHullSupportPolygons.clear();
+        m_pimpl->m_postureActive = false;
+        m_pimpl->m_structureChanged = true;
+        m_pimpl->m_hasSolution = false;
+    }
+
+    bool DifferentialInverseKinematics::setCurrentRobotConfiguration(const iDynTree::Transform& baseConfiguration,
+                                                                     const iDynTree::VectorDynSize& jointConfiguration)
+    {
+        if (jointConfiguration.size() != m_pimpl->m_dofs) {
+            reportError("DifferentialInverseKinematics", "setCurrentRobotConfiguration", "Size mismatch between the joint configuration and the model dofs");
+            return false;
+        }
+        m_pimpl->m_baseTransform = baseConfiguration;
+        m_pimpl->m_jointPositions = jointConfiguration;
+        m_pimpl->m_hasSolution = false;
+        return m_pimpl->m_dynamics.setRobotState(baseConfiguration, jointConfiguration,
+                                                 m_pimpl->m_zeroBaseVelocity, m_pimpl->m_zeroJointVelocities,
+                                                 m_pimpl->m_gravity);
+    }
+
+    void DifferentialInverseKinematics::setTaskGain(const double gain)
+    {
+        if (gain <= 0.0 || gain > 1.0) {
+            reportError("DifferentialInverseKinematics", "setTaskGain", "The gain must be in the (0, 1] interval");
+            return;
+        }
+        m_pimpl->m_gain = gain;
+    }
+
+    double DifferentialInverseKinematics::taskGain() const
+    {
+        return m_pimpl->m_gain;
+    }
+
+    void DifferentialInverseKinematics::setRegularizationWeight(const double weight)
+    {
+        if (weight <= 0.0) {
+            reportError("DifferentialInverseKinematics", "setRegularizationWeight", "The weight must be strictly positive");
+            return;
+        }
+        m_pimpl->m_regularization = weight;
+    }
+
+    double DifferentialInverseKinematics::regularizationWeight() const
+    {
+        return m_pimpl->m_regularization;
+    }
+
+    void DifferentialInverseKinematics::setMaxIterations(const int max_iter)
+    {
+        if (max_iter > 0) {
+            m_pimpl->m_maxIterations = max_iter;
+        }
+    }
+
+    int DifferentialInverseKinematics::maxIterations() const
+    {
+        return m_pimpl->m_maxIterations;
+    }
+
+    void DifferentialInverseKinematics::setTolerance(const double tol)
+    {
+        if (tol > 0.0) {
+            m_pimpl->m_tolerance = tol;
+        }
+    }
+
+    double DifferentialInverseKinematics::tolerance() const
+    {
+        return m_pimpl->m_tolerance;
+    }
+
+    bool DifferentialInverseKinematics::addFrameConstraint(const std::string& frameName,
+                                                           const iDynTree::Transform& constraintValue)
+    {
+        m_pimpl->m_structureChanged = true;
+        return m_pimpl->addFrameTask(m_pimpl->m_constraints, "addFrameConstraint", frameName,
+                                     true, true, constraintValue, 1.0, 1.0);
+    }
+
+    bool DifferentialInverseKinematics::addFramePositionConstraint(const std::string& frameName,
+                                                                   const iDynTree::Position& constraintValue)
+    {
+        m_pimpl->m_structureChanged = true;
+        return m_pimpl->addFrameTask(m_pimpl->m_constraints, "addFramePositionConstraint", frameName,
+                                     true, false, iDynTree::Transform(iDynTree::Rotation::Identity(), constraintValue), 1.0, 1.0);
+    }
+
+    bool DifferentialInverseKinematics::addFrameRotationConstraint(const std::string& frameName,
+                                                                   const iDynTree::Rotation& constraintValue)
+    {
+        m_pimpl->m_structureChanged = true;
+        return m_pimpl->addFrameTask(m_pimpl->m_constraints, "addFrameRotationConstraint", frameName,
+                                     false, true, iDynTree::Transform(constraintValue, iDynTree::Position::Zero()), 1.0, 1.0);
+    }
+
+    bool DifferentialInverseKinematics::activateFrameConstraint(const std::string& frameName,
+                                                                const iDynTree::Transform& newConstraintValue)
+    {
+        FrameTask* constraint = m_pimpl->getFrameTask(m_pimpl->m_constraints, "activateFrameConstraint", frameName);
+        if (!constraint) {
+            return false;
+        }
+        // The convex hull of the center of mass projection constraint depends on the support frames constraints
+        if (!constraint->isActive || m_pimpl->isSupportFrame(constraint->frameIndex)) {
+            m_pimpl->m_structureChanged = true;
+        }
+        constraint->isActive = true;
+        constraint->value = newConstraintValue;
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::deactivateFrameConstraint(const std::string& frameName)
+    {
+        FrameTask* constraint = m_pimpl->getFrameTask(m_pimpl->m_constraints, "deactivateFrameConstraint", frameName);
+        if (!constraint) {
+            return false;
+        }
+        if (constraint->isActive) {
+            m_pimpl->m_structureChanged = true;
+        }
+        constraint->isActive = false;
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::isFrameConstraintActive(const std::string& frameName) const
+    {
+        FrameTask* constraint = findTask(m_pimpl->m_constraints, m_pimpl->m_dynamics.getFrameIndex(frameName));
+        return constraint && constraint->isActive;
+    }
+
+    bool DifferentialInverseKinematics::addCenterOfMassProjectionConstraint(const std::vector<std::string>& supportFrames,
+                                                                            const std::vector<iDynTree::Polygon>& supportPolygons,
+                                                                            const iDynTree::Direction xAxisOfPlaneInWorld,
+                                                                            const iDynTree::Direction yAxisOfPlaneInWorld,
+                                                                            const iDynTree::Position originOfPlaneInWorld)
+    {
+        if (supportFrames.size() == 0) {
+            reportError("DifferentialInverseKinematics", "addCenterOfMassProjectionConstraint", "No support frames specified");
+            return false;
+        }
+
+        if (supportFrames.size() != supportPolygons.size()) {
+            reportError("DifferentialInverseKinematics", "addCenterOfMassProjectionConstraint", "Size mismatch between supportFrames and supportPolygons");
+            return false;
+        }
+
+        std::vector<iDynTree::FrameIndex> supportFrameIndices(supportFrames.size());
+        for (size_t i = 0; i < supportFrames.size(); ++i) {
+            supportFrameIndices[i] = m_pimpl->m_dynamics.getFrameIndex(supportFrames[i]);
+            if (supportFrameIndices[i] == iDynTree::FRAME_INVALID_INDEX) {
+                std::stringstream ss;
+                ss << "Frame " << supportFrames[i] << " not found in the model";
+                reportError("DifferentialInverseKinematics", "addCenterOfMassProjectionConstraint", ss.str().c_str());
+                return false;
+            }
+            if (!findTask(m_pimpl->m_constraints, supportFrameIndices[i])) {
+                std::stringstream ss;
+                ss << "Frame " << supportFrames[i] << " is not subject to a constraint";
+                reportError("DifferentialInverseKinematics", "addCenterOfMassProjectionConstraint", ss.str().c_str());
+                return false;
+            }
+        }
+
+        m_pimpl->m_comHullRequested = true;
+        m_pimpl->m_comHullSupportFrames = supportFrameIndices;
+        m_pimpl->m_comHullSupportPolygons = supportPolygons;
+        m_pimpl->m_comHullXAxis = xAxisOfPlaneInWorld;
+        m_pimpl->m_comHullYAxis = yAxisOfPlaneInWorld;
+        m_pimpl->m_comHullOrigin = originOfPlaneInWorld;
+        m_pimpl->m_structureChanged = true;
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::getCenterOfMassProjectConstraintConvexHull(iDynTree::Polygon2D& convexHull)
+    {
+        if (m_pimpl->m_structureChanged) {
+            m_pimpl->updateStructure();
+        }
+        if (!m_pimpl->m_comHullActive) {
+            return false;
+        }
+        convexHull = m_pimpl->m_comHullConstraint.projectedConvexHull;
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::addTarget(const std::string& frameName,
+                                                  const iDynTree::Transform& targetValue,
+                                                  const double positionWeight,
+                                                  const double rotationWeight)
+    {
+        return m_pimpl->addFrameTask(m_pimpl->m_targets, "addTarget", frameName,
+                                     true, true, targetValue, positionWeight, rotationWeight);
+    }
+
+    bool DifferentialInverseKinematics::addPositionTarget(const std::string& frameName,
+                                                          const iDynTree::Position& targetValue,
+                                                          const double positionWeight)
+    {
+        return m_pimpl->addFrameTask(m_pimpl->m_targets, "addPositionTarget", frameName,
+                                     true, false, iDynTree::Transform(iDynTree::Rotation::Identity(), targetValue), positionWeight, 1.0);
+    }
+
+    bool DifferentialInverseKinematics::addRotationTarget(const std::string& frameName,
+                                                          const iDynTree::Rotation& targetValue,
+                                                          const double rotationWeight)
+    {
+        return m_pimpl->addFrameTask(m_pimpl->m_targets, "addRotationTarget", frameName,
+                                     false, true, iDynTree::Transform(targetValue, iDynTree::Position::Zero()), 1.0, rotationWeight);
+    }
+
+    bool DifferentialInverseKinematics::updateTarget(const std::string& frameName,
+                                                     const iDynTree::Transform& targetValue,
+                                                     const double positionWeight,
+                                                     const double rotationWeight)
+    {
+        FrameTask* target = m_pimpl->getFrameTask(m_pimpl->m_targets, "updateTarget", frameName);
+        if (!target) {
+            return false;
+        }
+        target->value = targetValue;
+        if (positionWeight >= 0.0) {
+            target->positionWeight = positionWeight;
+        }
+        if (rotationWeight >= 0.0) {
+            target->rotationWeight = rotationWeight;
+        }
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::updatePositionTarget(const std::string& frameName,
+                                                             const iDynTree::Position& targetValue,
+                                                             const double positionWeight)
+    {
+        FrameTask* target = m_pimpl->getFrameTask(m_pimpl->m_targets, "updatePositionTarget", frameName);
+        if (!target) {
+            return false;
+        }
+        if (!target->hasPosition) {
+            reportError("DifferentialInverseKinematics", "updatePositionTarget", "The target has no position component");
+            return false;
+        }
+        target->value.setPosition(targetValue);
+        if (positionWeight >= 0.0) {
+            target->positionWeight = positionWeight;
+        }
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::updateRotationTarget(const std::string& frameName,
+                                                             const iDynTree::Rotation& targetValue,
+                                                             const double rotationWeight)
+    {
+        FrameTask* target = m_pimpl->getFrameTask(m_pimpl->m_targets, "updateRotationTarget", frameName);
+        if (!target) {
+            return false;
+        }
+        if (!target->hasRotation) {
+            reportError("DifferentialInverseKinematics", "updateRotationTarget", "The target has no rotation component");
+            return false;
+        }
+        target->value.setRotation(targetValue);
+        if (rotationWeight >= 0.0) {
+            target->rotationWeight = rotationWeight;
+        }
+        return true;
+    }
+
+    void DifferentialInverseKinematics::setCOMTarget(const iDynTree::Position& desiredPosition, const double weight)
+    {
+        m_pimpl->m_comTargetActive = true;
+        m_pimpl->m_comTarget = desiredPosition;
+        m_pimpl->m_comTargetWeight = weight;
+    }
+
+    bool DifferentialInverseKinematics::isCOMTargetActive() const
+    {
+        return m_pimpl->m_comTargetActive;
+    }
+
+    void DifferentialInverseKinematics::deactivateCOMTarget()
+    {
+        m_pimpl->m_comTargetActive = false;
+    }
+
+    bool DifferentialInverseKinematics::setDesiredFullJointsConfiguration(const iDynTree::VectorDynSize& desiredJointConfiguration, double weight)
+    {
+        if (desiredJointConfiguration.size() != m_pimpl->m_dofs) {
+            reportError("DifferentialInverseKinematics", "setDesiredFullJointsConfiguration", "Size mismatch between the desired configuration and the model dofs");
+            return false;
+        }
+        m_pimpl->m_desiredJoints = desiredJointConfiguration;
+        if (weight >= 0.0) {
+            m_pimpl->m_postureWeight = weight;
+        }
+        m_pimpl->m_postureActive = true;
+        return true;
+    }
+
+    bool DifferentialInverseKinematics::solve()
+    {
+#ifndef IDYNTREE_USES_OSQPEIGEN
+        m_pimpl->m_hasSolution = false;
+        return missingOsqpErrorReport();
+#else
+        if (!m_pimpl->m_dynamics.isValid()) {
+            reportError("DifferentialInverseKinematics", "solve", "No model has been set");
+            return false;
+        }
+
+        if (m_pimpl->m_structureChanged) {
+            m_pimpl->updateStructure();
+        }
+
+        if (!m_pimpl->buildProblem()) {
+            reportError("DifferentialInverseKinematics", "solve", "Error while computing the jacobians of the tasks");
+            return false;
+        }
+
+        m_pimpl->m_hasSolution = false;
+        iDynTree::optimization::OsqpSettings& settings = m_pimpl->m_osqp.settings();
+        settings.max_iter = static_cast<unsigned int>(m_pimpl->m_maxIterations);
+        settings.eps_abs = m_pimpl->m_tolerance;
+        settings.eps_rel = m_pimpl->m_tolerance;
+
+        if (!m_pimpl->m_osqp.solve() || !m_pimpl->m_osqp.getPrimalVariables(m_pimpl->m_step)) {
+            reportError("DifferentialInverseKinematics", "solve", "The QP solver failed");
+            return false;
+        }
+        if (!toEigen(m_pimpl->m_step).allFinite()) {
+            reportError("DifferentialInverseKinematics", "solve", "The QP solver returned a non finite step");
+            return false;
+        }
+        // Depending on the version of OsqpEigen, a solution is returned also if OSQP stops
+        // without solving the QP (e.g. at the maximum number of iterations), so check it explicitly
+        if (!m_pimpl->isStepFeasible()) {
+            reportError("DifferentialInverseKinematics", "solve", "The QP solver did not find a step that satisfies the constraints");
+            return false;
+        }
+        m_pimpl->m_hasSolution = true;
+        return true;
+#endif
+    }
+
+    void DifferentialInverseKinematics::getFullJointsSolution(iDynTree::Transform& baseTransformSolution,
+                                                              iDynTree::VectorDynSize& shapeSolution)
+    {
+        baseTransformSolution = m_pimpl->m_baseTransform;
+        shapeSolution = m_pimpl->m_jointPositions;
+        if (!m_pimpl->m_hasSolution) {
+            return;
+        }
+
+        const iDynTree::VectorDynSize& step = m_pimpl->m_step;
+        iDynTree::Position basePosition = m_pimpl->m_baseTransform.getPosition();
+        toEigen(basePosition) += toEigen(step).head<3>();
+        iDynTree::AngularMotionVector3 baseRotationStep;
+        toEigen(baseRotationStep) = toEigen(step).segment<3>(3);
+        baseTransformSolution.setPosition(basePosition);
+        baseTransformSolution.setRotation(baseRotationStep.exp() * m_pimpl->m_baseTransform.getRotation());
+
+        for (size_t i = 0; i < m_pimpl->m_optimisedDofs.size(); ++i) {
+            shapeSolution(m_pimpl->m_optimisedDofs[i]) += step(6 + i);
+        }
+    }
+
+    bool DifferentialInverseKinematics::getVelocitySolution(const double timeStep,
+                                                            iDynTree::Twist& baseVelocity,
+                                                            iDynTree::VectorDynSize& jointVelocities)
+    {
+        if (timeStep <= 0.0) {
+            reportError("DifferentialInverseKinematics", "getVelocitySolution", "The time step must be strictly positive");
+            return false;
+        }
+
+        baseVelocity.zero();
+        jointVelocities.resize(m_pimpl->m_dofs);
+        jointVelocities.zero();
+        if (!m_pimpl->m_hasSolution) {
+            return true;
+        }
+
+        const iDynTree::VectorDynSize& step = m_pimpl->m_step;
+        for (unsigned i = 0; i < 6; ++i) {
+            baseVelocity.setVal(i, step(i) / timeStep);
+        }
+        for (size_t i = 0; i < m_pimpl->m_optimisedDofs.size(); ++i) {
+            jointVelocities(m_pimpl->m_optimisedDofs[i]) = step(6 + i) / timeStep;
+        }
+        return true;
+    }
+}
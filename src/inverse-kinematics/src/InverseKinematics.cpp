@@ -8,6 +8,12 @@
  * at your option.
  */
 
+//For using the M_PI macro in visual studio it
+//is necessary to define _USE_MATH_DEFINES
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+
 #include <iDynTree/InverseKinematics.h>
 #ifdef IDYNTREE_USES_IPOPT
 #include "InverseKinematicsData.h"
@@ -15,13 +21,20 @@
 
 #include <iDynTree/Core/Axis.h>
 #include <iDynTree/Core/Direction.h>
+#include <iDynTree/Core/MatrixDynSize.h>
 #include <iDynTree/Core/Transform.h>
+#include <iDynTree/Core/ThreadPool.h>
 #include <iDynTree/ModelIO/ModelLoader.h>
 
 #include <iDynTree/Core/EigenHelpers.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <random>
 
 // TODO: directly access the raw data, thus removing the methods in IKData class
 #define IK_PIMPL(x) static_cast<internal::kinematics::InverseKinematicsData*>((x))
@@ -42,6 +55,49 @@ namespace iDynTree {
         reportError("InverseKinematics", "", "IDYNTREE_USES_IPOPT CMake option need to be set to ON to use InverseKinematics");
         return false;
     }
+#else
+    /*
+     * Return true if Ipopt can run concurrent optimizations with the linear solver solverName.
+     * The MUMPS interface of Ipopt is protected by a mutex only from Ipopt 3.14.
+     */
+    static bool isLinearSolverThreadSafe(const std::string& solverName)
+    {
+        if (solverName == "ma57" || solverName == "ma86" || solverName == "ma97") {
+            return true;
+        }
+#if defined(IPOPT_VERSION_MAJOR) && defined(IPOPT_VERSION_MINOR)
+        if (solverName == "mumps") {
+            return IPOPT_VERSION_MAJOR > 3 || (IPOPT_VERSION_MAJOR == 3 && IPOPT_VERSION_MINOR >= 14);
+        }
+#endif
+        return false;
+    }
+
+    /*
+     * Return the number of threads to be used to run nrOfTasks optimizations of the problem in data.
+     * If the linear solver (the default one of Ipopt, if it was not set) is not thread-safe,
+     * a single thread is used and a warning is reported.
+     */
+    static size_t getNrOfOptimizationThreads(internal::kinematics::InverseKinematicsData& data,
+                                             const size_t requestedNrOfThreads,
+                                             const size_t nrOfTasks,
+                                             const char* method)
+    {
+        size_t nrOfThreads = requestedNrOfThreads > 0 ? requestedNrOfThreads : iDynTree::ThreadPool::getNrOfAvailableHardwareThreads();
+        nrOfThreads = std::min(nrOfThreads, nrOfTasks);
+        if (nrOfThreads <= 1) {
+            return 1;
+        }
+
+        if (!data.initializeSolver() || !isLinearSolverThreadSafe(data.m_solverName)) {
+            std::stringstream ss;
+            ss << "The linear solver \"" << data.m_solverName << "\" is not known to be thread-safe, "
+               << "the optimizations are run one after the other";
+            reportWarning("InverseKinematics", method, ss.str().c_str());
+            return 1;
+        }
+        return nrOfThreads;
+    }
 #endif
 
     InverseKinematics::InverseKinematics()
@@ -183,6 +239,7 @@ namespace iDynTree {
             IK_PIMPL(m_pimpl)->m_maxIter = max_iter;
         else
             IK_PIMPL(m_pimpl)->m_maxIter = std::numeric_limits<int>::max();
+        IK_PIMPL(m_pimpl)->m_solverOptionsChanged = true;
 #else
         missingIpoptErrorReport();
 #endif
@@ -201,6 +258,7 @@ namespace iDynTree {
     {
 #ifdef IDYNTREE_USES_IPOPT
         IK_PIMPL(m_pimpl)->m_maxCpuTime = max_cpu_time;
+        IK_PIMPL(m_pimpl)->m_solverOptionsChanged = true;
 #else
         missingIpoptErrorReport();
 #endif
@@ -219,6 +277,7 @@ namespace iDynTree {
     {
 #ifdef IDYNTREE_USES_IPOPT
         IK_PIMPL(m_pimpl)->m_tol = tol;
+        IK_PIMPL(m_pimpl)->m_solverOptionsChanged = true;
 #else
         missingIpoptErrorReport();
 #endif
@@ -237,6 +296,7 @@ namespace iDynTree {
     {
 #ifdef IDYNTREE_USES_IPOPT
         IK_PIMPL(m_pimpl)->m_constrTol = constr_tol;
+        IK_PIMPL(m_pimpl)->m_solverOptionsChanged = true;
 #else
         missingIpoptErrorReport();
 #endif
@@ -256,6 +316,7 @@ namespace iDynTree {
 #ifdef IDYNTREE_USES_IPOPT
         assert(m_pimpl);
         IK_PIMPL(m_pimpl)->m_verbosityLevel = verbose;
+        IK_PIMPL(m_pimpl)->m_solverOptionsChanged = true;
 #else
         missingIpoptErrorReport();
 #endif
@@ -277,11 +338,53 @@ namespace iDynTree {
 #ifdef IDYNTREE_USES_IPOPT
         assert(m_pimpl);
         IK_PIMPL(m_pimpl)->m_solverName = solverName;
+        IK_PIMPL(m_pimpl)->m_solverOptionsChanged = true;
+#else
+        missingIpoptErrorReport();
+#endif
+    }
+
+    void InverseKinematics::useApproximatedHessians(bool useApproximatedHessian)
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        IK_PIMPL(m_pimpl)->m_useApproximatedHessians = useApproximatedHessian;
+        IK_PIMPL(m_pimpl)->m_solverOptionsChanged = true;
+#else
+        missingIpoptErrorReport();
+#endif
+    }
+
+    bool InverseKinematics::usesApproximatedHessians() const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        return IK_PIMPL(m_pimpl)->m_useApproximatedHessians;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
+    void InverseKinematics::useTrackingMode(bool useTrackingMode)
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        IK_PIMPL(m_pimpl)->m_useTrackingMode = useTrackingMode;
 #else
         missingIpoptErrorReport();
 #endif
     }
 
+    bool InverseKinematics::usesTrackingMode() const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        return IK_PIMPL(m_pimpl)->m_useTrackingMode;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
     bool InverseKinematics::addFrameConstraint(const std::string& frameName)
     {
 #ifdef IDYNTREE_USES_IPOPT
@@ -358,13 +461,16 @@ namespace iDynTree {
             return false;
         }
 
+        // The problem needs to be reinitialized if the constraint was not active,
+        // or if the center of mass projection constraint depends on the constraint value
+        if (!it->second.isActive() || IK_PIMPL(m_pimpl)->m_comHullConstraint.isActive()) {
+            IK_PIMPL(m_pimpl)->m_problemInitialized = false;
+        }
+
         it->second.setActive(true);
         it->second.setPosition(newConstraintValue.getPosition());
         it->second.setRotation(newConstraintValue.getRotation());
 
-        // The problem needs to be reinitialized
-        IK_PIMPL(m_pimpl)->m_problemInitialized = false;
-
         return true;
 #else
         return missingIpoptErrorReport();
@@ -786,6 +892,8 @@ namespace iDynTree {
             IK_PIMPL(m_pimpl)->m_jointInitialConditions = *initialCondition;
             IK_PIMPL(m_pimpl)->m_areJointsInitialConditionsSet = internal::kinematics::InverseKinematicsData::InverseKinematicsInitialConditionFull;
         }
+        // The initial condition overrides the last solution in tracking mode
+        IK_PIMPL(m_pimpl)->m_lastSolutionIsInitialCondition = false;
         return true;
 #else
         return missingIpoptErrorReport();
@@ -809,6 +917,8 @@ namespace iDynTree {
             }
             IK_PIMPL(m_pimpl)->m_areJointsInitialConditionsSet = internal::kinematics::InverseKinematicsData::InverseKinematicsInitialConditionPartial;
         }
+        // The initial condition overrides the last solution in tracking mode
+        IK_PIMPL(m_pimpl)->m_lastSolutionIsInitialCondition = false;
         return true;
 #else
         return missingIpoptErrorReport();
@@ -918,6 +1028,363 @@ namespace iDynTree {
 #endif
     }
 
+    double InverseKinematics::lastSolveTime() const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        return IK_PIMPL(m_pimpl)->m_lastSolveTime;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
+    int InverseKinematics::lastSolveIterations() const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        return IK_PIMPL(m_pimpl)->m_lastSolveIterations;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
+    bool InverseKinematics::lastSolveConverged() const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        return IK_PIMPL(m_pimpl)->m_lastSolveConverged;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
+    double InverseKinematics::lastSolveCost() const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        return IK_PIMPL(m_pimpl)->m_lastSolveCost;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
+    bool InverseKinematics::solveMultiStart(const InverseKinematicsMultiStartOptions& options)
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        internal::kinematics::InverseKinematicsData& data = *IK_PIMPL(m_pimpl);
+        std::chrono::steady_clock::time_point solveStart = std::chrono::steady_clock::now();
+        data.m_multiStartSolutions.clear();
+
+        // Collect the initial conditions: the ones of the user and the sampled ones
+        std::vector<iDynTree::VectorDynSize> seeds;
+        for (const iDynTree::VectorDynSize& seed : options.jointsSeeds) {
+            if (seed.size() != data.m_dofs) {
+                reportError("InverseKinematics", "solveMultiStart", "Size mismatch between a joint seed and the model dofs");
+                return false;
+            }
+            seeds.push_back(seed);
+        }
+
+        std::mt19937 generator(options.randomSeed);
+        for (size_t s = 0; s < options.nrOfRandomSeeds; ++s) {
+            iDynTree::VectorDynSize seed = data.m_state.jointsConfiguration;
+            for (size_t i = 0; i < data.m_dofs; ++i) {
+                if (data.m_reducedVariablesInfo.fixedVariables[i]) continue;
+                double lowerLimit = data.m_jointLimits[i].first;
+                double upperLimit = data.m_jointLimits[i].second;
+                if (lowerLimit <= -1e19 || upperLimit >= 1e19) {
+                    lowerLimit = -M_PI;
+                    upperLimit = M_PI;
+                }
+                seed(i) = std::uniform_real_distribution<double>(lowerLimit, upperLimit)(generator);
+            }
+            seeds.push_back(seed);
+        }
+
+        if (seeds.empty()) {
+            reportError("InverseKinematics", "solveMultiStart", "No initial conditions specified");
+            return false;
+        }
+
+        iDynTree::Transform baseSeed = data.m_areBaseInitialConditionsSet ? data.m_baseInitialCondition : data.m_state.basePose;
+
+        struct SeedResult {
+            bool converged;
+            double cost;
+            int iterations;
+            iDynTree::Transform basePose;
+            iDynTree::VectorDynSize jointsConfiguration;
+        };
+        std::vector<SeedResult> results(seeds.size());
+        for (SeedResult& result : results) {
+            result.converged = false;
+        }
+
+        size_t nrOfThreads = getNrOfOptimizationThreads(data, options.nrOfThreads, seeds.size(), "solveMultiStart");
+
+        std::atomic<bool> stopRequest(false);
+        std::atomic<bool> copyFailed(false);
+        std::atomic<size_t> nextSeed(0);
+
+        // Each thread solves its own copy of the problem, taking the next initial condition when it is done
+        iDynTree::ThreadPool pool(nrOfThreads - 1);
+        pool.parallelFor(nrOfThreads, [&](size_t) {
+            internal::kinematics::InverseKinematicsData worker;
+            if (!worker.copyProblemFrom(data)) {
+                copyFailed = true;
+                return;
+            }
+            worker.m_stopRequest = &stopRequest;
+
+            for (size_t s = nextSeed++; s < seeds.size() && !stopRequest; s = nextSeed++) {
+                worker.disableWarmStart();
+                worker.m_baseInitialCondition = baseSeed;
+                worker.m_areBaseInitialConditionsSet = true;
+                worker.m_jointInitialConditions = seeds[s];
+                worker.m_areJointsInitialConditionsSet = internal::kinematics::InverseKinematicsData::InverseKinematicsInitialConditionFull;
+
+                if (!worker.solveProblem() || !worker.m_lastSolveConverged) continue;
+
+                results[s].converged = true;
+                results[s].cost = worker.m_lastSolveCost;
+                results[s].iterations = worker.m_lastSolveIterations;
+                results[s].basePose = worker.m_baseResults;
+                results[s].jointsConfiguration = worker.m_jointsResults;
+
+                if (options.costThreshold > 0 && worker.m_lastSolveCost <= options.costThreshold) {
+                    stopRequest = true;
+                }
+            }
+        });
+
+        if (copyFailed) {
+            reportError("InverseKinematics", "solveMultiStart", "Error while copying the problem");
+            return false;
+        }
+
+        // Sort the converged solutions by cost, and discard the duplicated ones
+        std::vector<size_t> converged;
+        for (size_t s = 0; s < results.size(); ++s) {
+            if (results[s].converged) converged.push_back(s);
+        }
+        std::sort(converged.begin(), converged.end(), [&results](size_t first, size_t second) {
+            return results[first].cost < results[second].cost;
+        });
+
+        for (size_t s : converged) {
+            bool isDistinct = true;
+            for (const internal::kinematics::InverseKinematicsData::MultiStartSolution& solution : data.m_multiStartSolutions) {
+                double distance = (iDynTree::toEigen(results[s].jointsConfiguration) - iDynTree::toEigen(solution.jointsConfiguration)).cwiseAbs().maxCoeff();
+                distance = std::max(distance, (iDynTree::toEigen(results[s].basePose.getPosition()) - iDynTree::toEigen(solution.basePose.getPosition())).cwiseAbs().maxCoeff());
+                // Angle of the rotation between the two base orientations
+                iDynTree::AngularMotionVector3 baseRotationDifference = (results[s].basePose.getRotation() * solution.basePose.getRotation().inverse()).log();
+                distance = std::max(distance, iDynTree::toEigen(baseRotationDifference).norm());
+                if (distance <= options.distinctSolutionsTolerance) {
+                    isDistinct = false;
+                    break;
+                }
+            }
+            if (isDistinct) {
+                internal::kinematics::InverseKinematicsData::MultiStartSolution solution;
+                solution.basePose = results[s].basePose;
+                solution.jointsConfiguration = results[s].jointsConfiguration;
+                solution.cost = results[s].cost;
+                data.m_multiStartSolutions.push_back(solution);
+            }
+        }
+
+        // The solver of this object did not take part in the search, so its warm start is not valid anymore
+        data.disableWarmStart();
+        data.m_canReoptimizeProblem = false;
+
+        data.m_lastSolveConverged = !converged.empty();
+        if (data.m_lastSolveConverged) {
+            data.m_baseResults = results[converged.front()].basePose;
+            data.m_jointsResults = results[converged.front()].jointsConfiguration;
+            data.m_lastSolveCost = results[converged.front()].cost;
+            data.m_lastSolveIterations = results[converged.front()].iterations;
+            data.m_lastSolutionIsInitialCondition = true;
+        }
+
+        std::chrono::duration<double> solveDuration = std::chrono::steady_clock::now() - solveStart;
+        data.m_lastSolveTime = solveDuration.count();
+
+        return data.m_lastSolveConverged;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
+    bool InverseKinematics::solveTrajectory(const std::vector<std::string>& targetFrames,
+                                            const std::vector<std::vector<iDynTree::Transform> >& targetValues,
+                                            iDynTree::MatrixDynSize& jointsTrajectory,
+                                            std::vector<iDynTree::Transform>& baseTrajectory,
+                                            std::vector<bool>& convergedFrames,
+                                            const InverseKinematicsTrajectoryOptions& options)
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        internal::kinematics::InverseKinematicsData& data = *IK_PIMPL(m_pimpl);
+        std::chrono::steady_clock::time_point solveStart = std::chrono::steady_clock::now();
+
+        if (targetFrames.empty() || targetFrames.size() != targetValues.size()) {
+            reportError("InverseKinematics", "solveTrajectory", "Size mismatch between targetFrames and targetValues");
+            return false;
+        }
+
+        size_t nrOfTimeFrames = targetValues[0].size();
+        for (size_t i = 0; i < targetFrames.size(); ++i) {
+            if (targetValues[i].size() != nrOfTimeFrames) {
+                reportError("InverseKinematics", "solveTrajectory", "All the targets should have the same number of values");
+                return false;
+            }
+            if (data.getTargetRefIfItExists(targetFrames[i]) == data.m_targets.end()) {
+                std::stringstream ss;
+                ss << "No target for frame " << targetFrames[i] << " was added to the InverseKinematics problem.";
+                reportError("InverseKinematics", "solveTrajectory", ss.str().c_str());
+                return false;
+            }
+        }
+
+        if (nrOfTimeFrames == 0) {
+            reportError("InverseKinematics", "solveTrajectory", "No target values specified");
+            return false;
+        }
+
+        jointsTrajectory.resize(nrOfTimeFrames, data.m_dofs);
+        baseTrajectory.resize(nrOfTimeFrames);
+        // Written by different threads, so std::vector<bool> cannot be used
+        std::vector<char> converged(nrOfTimeFrames, 0);
+
+        size_t nrOfSegments = options.nrOfSegments > 0 ? options.nrOfSegments
+                                                       : (options.nrOfThreads > 0 ? options.nrOfThreads : iDynTree::ThreadPool::getNrOfAvailableHardwareThreads());
+        nrOfSegments = std::min(nrOfSegments, nrOfTimeFrames);
+        size_t nrOfThreads = getNrOfOptimizationThreads(data, options.nrOfThreads, nrOfSegments, "solveTrajectory");
+
+        std::atomic<bool> copyFailed(false);
+        std::atomic<size_t> nextSegment(0);
+
+        // Each thread solves its own copy of the problem, taking the next segment when it is done
+        iDynTree::ThreadPool pool(nrOfThreads - 1);
+        pool.parallelFor(nrOfThreads, [&](size_t) {
+            internal::kinematics::InverseKinematicsData worker;
+            if (!worker.copyProblemFrom(data)) {
+                copyFailed = true;
+                return;
+            }
+            // Consecutive frames of a segment start from the last solution
+            worker.m_useTrackingMode = true;
+
+            std::vector<internal::kinematics::TransformMap::iterator> targets(targetFrames.size());
+            for (size_t i = 0; i < targetFrames.size(); ++i) {
+                targets[i] = worker.getTargetRefIfItExists(targetFrames[i]);
+            }
+
+            for (size_t segment = nextSegment++; segment < nrOfSegments; segment = nextSegment++) {
+                size_t firstFrame = segment * nrOfTimeFrames / nrOfSegments;
+                size_t lastFrame = (segment + 1) * nrOfTimeFrames / nrOfSegments;
+
+                worker.disableWarmStart();
+                worker.m_preferredJointsConfiguration = data.m_preferredJointsConfiguration;
+                worker.m_preferredJointsWeight = data.m_preferredJointsWeight;
+
+                for (size_t k = firstFrame; k < lastFrame; ++k) {
+                    for (size_t i = 0; i < targets.size(); ++i) {
+                        if (targets[i]->second.hasPositionConstraint()) {
+                            worker.updatePositionTarget(targets[i], targetValues[i][k].getPosition(), -1.0);
+                        }
+                        if (targets[i]->second.hasRotationConstraint()) {
+                            worker.updateRotationTarget(targets[i], targetValues[i][k].getRotation(), -1.0);
+                        }
+                    }
+
+                    // The smoothness cost is merged with the cost on the desired joints configuration:
+                    // w_d |s - s_d|^2 + w_s |s - s_prev|^2 = (w_d + w_s) |s - (w_d s_d + w_s s_prev) / (w_d + w_s)|^2 + const
+                    if (options.smoothnessWeight > 0 && k > firstFrame) {
+                        for (size_t j = 0; j < data.m_dofs; ++j) {
+                            double weight = data.m_preferredJointsWeight(j) + options.smoothnessWeight;
+                            worker.m_preferredJointsConfiguration(j) = (data.m_preferredJointsWeight(j) * data.m_preferredJointsConfiguration(j)
+                                                                        + options.smoothnessWeight * jointsTrajectory(k - 1, j)) / weight;
+                            worker.m_preferredJointsWeight(j) = weight;
+                        }
+                    }
+
+                    converged[k] = worker.solveProblem() && worker.m_lastSolveConverged;
+                    baseTrajectory[k] = worker.m_baseResults;
+                    for (size_t j = 0; j < data.m_dofs; ++j) {
+                        jointsTrajectory(k, j) = worker.m_jointsResults(j);
+                    }
+                }
+            }
+        });
+
+        if (copyFailed) {
+            reportError("InverseKinematics", "solveTrajectory", "Error while copying the problem");
+            return false;
+        }
+
+        // The solution of the object is the one of the last time frame
+        data.disableWarmStart();
+        data.m_canReoptimizeProblem = false;
+        data.m_baseResults = baseTrajectory.back();
+        for (size_t j = 0; j < data.m_dofs; ++j) {
+            data.m_jointsResults(j) = jointsTrajectory(nrOfTimeFrames - 1, j);
+        }
+        convergedFrames.assign(converged.begin(), converged.end());
+        data.m_lastSolveConverged = std::find(converged.begin(), converged.end(), 0) == converged.end();
+
+        std::chrono::duration<double> solveDuration = std::chrono::steady_clock::now() - solveStart;
+        data.m_lastSolveTime = solveDuration.count();
+
+        return data.m_lastSolveConverged;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
+    bool InverseKinematics::solveTrajectory(const std::vector<std::string>& targetFrames,
+                                            const std::vector<std::vector<iDynTree::Transform> >& targetValues,
+                                            iDynTree::MatrixDynSize& jointsTrajectory,
+                                            std::vector<iDynTree::Transform>& baseTrajectory,
+                                            const InverseKinematicsTrajectoryOptions& options)
+    {
+        std::vector<bool> convergedFrames;
+        return solveTrajectory(targetFrames, targetValues, jointsTrajectory, baseTrajectory, convergedFrames, options);
+    }
+
+    size_t InverseKinematics::getNrOfMultiStartSolutions() const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        return IK_PIMPL(m_pimpl)->m_multiStartSolutions.size();
+#else
+        missingIpoptErrorReport();
+        return 0;
+#endif
+    }
+
+    bool InverseKinematics::getMultiStartSolution(const size_t index,
+                                                  iDynTree::Transform& baseTransformSolution,
+                                                  iDynTree::VectorDynSize& shapeSolution,
+                                                  double& cost) const
+    {
+#ifdef IDYNTREE_USES_IPOPT
+        assert(m_pimpl);
+        const internal::kinematics::InverseKinematicsData& data = *IK_PIMPL(m_pimpl);
+        if (index >= data.m_multiStartSolutions.size()) {
+            reportError("InverseKinematics", "getMultiStartSolution", "Solution index out of range");
+            return false;
+        }
+        baseTransformSolution = data.m_multiStartSolutions[index].basePose;
+        shapeSolution = data.m_multiStartSolutions[index].jointsConfiguration;
+        cost = data.m_multiStartSolutions[index].cost;
+        return true;
+#else
+        return missingIpoptErrorReport();
+#endif
+    }
+
     bool InverseKinematics::getPoseForFrame(const std::string& frameName,
                                             iDynTree::Transform& transform)
     {
@@ -19,6 +19,7 @@
 #include <iDynTree/Core/EigenHelpers.h>
 
 #include <cassert>
+#include <chrono>
 #include <private/InverseKinematicsData.h>
 
 namespace internal {
@@ -35,6 +36,14 @@ namespace kinematics {
     , m_areJointsInitialConditionsSet(InverseKinematicsInitialConditionNotSet)
     , m_problemInitialized(false)
     , m_warmStartEnabled(false)
+    , m_canReoptimizeProblem(false)
+    , m_reoptimizingProblem(false)
+    , m_lastSolutionIsInitialCondition(false)
+    , m_lastSolveTime(0)
+    , m_lastSolveIterations(0)
+    , m_lastSolveConverged(false)
+    , m_lastSolveCost(0)
+    , m_stopRequest(0)
     , m_numberOfOptimisationVariables(0)
     , m_numberOfOptimisationConstraints(0)
     , m_solver(NULL)
@@ -47,6 +56,9 @@ namespace kinematics {
     , m_tol(1e-8)
     , m_constrTol(1e-4)
     , m_verbosityLevel(0)
+    , m_useApproximatedHessians(true)
+    , m_useTrackingMode(false)
+    , m_solverOptionsChanged(true)
     {
         //These variables are touched only once.
         m_state.worldGravity.zero();
@@ -164,8 +176,15 @@ namespace kinematics {
         m_comTarget.constraintTolerance = 1e-8;
 
         m_problemInitialized = false;
+        disableWarmStart();
+    }
+
+    void InverseKinematicsData::disableWarmStart()
+    {
+        m_lastSolutionIsInitialCondition = false;
         if (m_warmStartEnabled) {
             m_warmStartEnabled = false;
+            m_reoptimizingProblem = false;
             if (!Ipopt::IsNull(m_solver)) {
                 m_solver->Options()->SetStringValue("warm_start_init_point", "no");
                 m_solver->Options()->SetStringValue("warm_start_same_structure", "no");
@@ -173,6 +192,54 @@ namespace kinematics {
         }
     }
 
+    bool InverseKinematicsData::copyProblemFrom(const InverseKinematicsData& other)
+    {
+        // The joints are already reduced in other, so the full model is loaded
+        // and the reduction information is copied afterwards
+        if (!setModel(other.m_dynamics.model())) {
+            return false;
+        }
+        m_reducedVariablesInfo = other.m_reducedVariablesInfo;
+        m_jointLimits = other.m_jointLimits;
+
+        m_state = other.m_state;
+        updateRobotConfiguration();
+
+        m_rotationParametrization = other.m_rotationParametrization;
+        m_defaultTargetResolutionMode = other.m_defaultTargetResolutionMode;
+        m_constraints = other.m_constraints;
+        m_targets = other.m_targets;
+        m_comTarget = other.m_comTarget;
+
+        m_comHullConstraint = other.m_comHullConstraint;
+        m_comHullConstraint_projDirection = other.m_comHullConstraint_projDirection;
+        m_comHullConstraint_supportFramesIndeces = other.m_comHullConstraint_supportFramesIndeces;
+        m_comHullConstraint_supportPolygons = other.m_comHullConstraint_supportPolygons;
+        m_comHullConstraint_xAxisOfPlaneInWorld = other.m_comHullConstraint_xAxisOfPlaneInWorld;
+        m_comHullConstraint_yAxisOfPlaneInWorld = other.m_comHullConstraint_yAxisOfPlaneInWorld;
+        m_comHullConstraint_originOfPlaneInWorld = other.m_comHullConstraint_originOfPlaneInWorld;
+
+        m_preferredJointsConfiguration = other.m_preferredJointsConfiguration;
+        m_preferredJointsWeight = other.m_preferredJointsWeight;
+
+        m_areBaseInitialConditionsSet = other.m_areBaseInitialConditionsSet;
+        m_areJointsInitialConditionsSet = other.m_areJointsInitialConditionsSet;
+        m_baseInitialCondition = other.m_baseInitialCondition;
+        m_jointInitialConditions = other.m_jointInitialConditions;
+
+        m_maxIter = other.m_maxIter;
+        m_maxCpuTime = other.m_maxCpuTime;
+        m_tol = other.m_tol;
+        m_constrTol = other.m_constrTol;
+        m_verbosityLevel = other.m_verbosityLevel;
+        m_solverName = other.m_solverName;
+        m_useApproximatedHessians = other.m_useApproximatedHessians;
+        m_solverOptionsChanged = true;
+
+        m_problemInitialized = false;
+        return true;
+    }
+
     bool InverseKinematicsData::addFrameConstraint(const kinematics::TransformConstraint& frameTransformConstraint)
     {
         int frameIndex = m_dynamics.getFrameIndex(frameTransformConstraint.getFrameName());
@@ -254,6 +321,10 @@ namespace kinematics {
 
     void InverseKinematicsData::setRotationParametrization(enum iDynTree::InverseKinematicsRotationParametrization parametrization)
     {
+        if (m_rotationParametrization != parametrization) {
+            // The number of variables and constraints changes
+            m_problemInitialized = false;
+        }
         m_rotationParametrization = parametrization;
     }
 
@@ -272,26 +343,35 @@ namespace kinematics {
     {
         //Do all stuff needed before starting an optimization problem
         //1) prepare initial condition if not explicitly set
-        if (!m_areBaseInitialConditionsSet) {
-            m_baseInitialCondition = m_state.basePose;
-        }
+        if (m_useTrackingMode && m_lastSolutionIsInitialCondition) {
+            //In tracking mode start from the last solution
+            //The joints which are not optimised are taken from the robot configuration
+            m_baseInitialCondition = m_baseResults;
+            for (size_t i = 0; i < m_reducedVariablesInfo.fixedVariables.size(); ++i) {
+                m_jointInitialConditions(i) = m_reducedVariablesInfo.fixedVariables[i] ? m_state.jointsConfiguration(i) : m_jointsResults(i);
+            }
+        } else {
+            if (!m_areBaseInitialConditionsSet) {
+                m_baseInitialCondition = m_state.basePose;
+            }
 
-        switch (m_areJointsInitialConditionsSet) {
-            case InverseKinematicsInitialConditionNotSet:
-                m_jointInitialConditions = m_state.jointsConfiguration;
-                break;
-            case InverseKinematicsInitialConditionPartial:
-                // in this case we have to set in m_jointInitialConditions
-                // the joints in m_state.jointsConfiguration which are not considered
-                // in the reduced variables
-                for (size_t i = 0; i < m_reducedVariablesInfo.fixedVariables.size(); ++i) {
-                    if (!m_reducedVariablesInfo.fixedVariables[i]) continue;
-                    // joint is fixed => set the initial condition
-                    m_jointInitialConditions(i) = m_state.jointsConfiguration(i);
-                }
-                break;
-            default:
-                break;
+            switch (m_areJointsInitialConditionsSet) {
+                case InverseKinematicsInitialConditionNotSet:
+                    m_jointInitialConditions = m_state.jointsConfiguration;
+                    break;
+                case InverseKinematicsInitialConditionPartial:
+                    // in this case we have to set in m_jointInitialConditions
+                    // the joints in m_state.jointsConfiguration which are not considered
+                    // in the reduced variables
+                    for (size_t i = 0; i < m_reducedVariablesInfo.fixedVariables.size(); ++i) {
+                        if (!m_reducedVariablesInfo.fixedVariables[i]) continue;
+                        // joint is fixed => set the initial condition
+                        m_jointInitialConditions(i) = m_state.jointsConfiguration(i);
+                    }
+                    break;
+                default:
+                    break;
+            }
         }
 
         //2) Check joint limits..
@@ -330,6 +410,10 @@ namespace kinematics {
     void InverseKinematicsData::setTargetResolutionMode(TransformMap::iterator target, iDynTree::InverseKinematicsTreatTargetAsConstraint mode)
     {
        assert(target != m_targets.end());
+       if (target->second.targetResolutionMode() != mode) {
+           // The target moves between the cost and the constraints
+           m_problemInitialized = false;
+       }
        target->second.setTargetResolutionMode(mode);
     }
 
@@ -339,32 +423,35 @@ namespace kinematics {
         return target->second.targetResolutionMode();
     }
 
-    bool InverseKinematicsData::solveProblem()
+    void InverseKinematicsData::updateSolverOptions()
     {
-        Ipopt::ApplicationReturnStatus solverStatus;
+        m_solver->Options()->SetIntegerValue("print_level",m_verbosityLevel);
+        m_solver->Options()->SetIntegerValue("max_iter", m_maxIter);
+        m_solver->Options()->SetNumericValue("max_cpu_time", m_maxCpuTime);
+        m_solver->Options()->SetNumericValue("tol", m_tol);
+        m_solver->Options()->SetNumericValue("constr_viol_tol", m_constrTol);
+        if (!m_solverName.empty()) {
+            m_solver->Options()->SetStringValue("linear_solver", m_solverName);
+        } else {
+            m_solver->Options()->GetStringValue("linear_solver", m_solverName, "");
+        }
+        m_solver->Options()->SetStringValue("hessian_approximation", m_useApproximatedHessians ? "limited-memory" : "exact");
+        m_solverOptionsChanged = false;
+    }
 
+    bool InverseKinematicsData::initializeSolver()
+    {
         if (Ipopt::IsNull(m_solver)) {
             m_solver = IpoptApplicationFactory();
 
             //TODO: set options
             //For example, one needed option is the linear solver type
             //Best thing is to wrap the IPOPT options with new structure so as to abstract them
-            m_solver->Options()->SetStringValue("hessian_approximation", "limited-memory");
-            m_solver->Options()->SetIntegerValue("print_level",m_verbosityLevel);
-            m_solver->Options()->SetIntegerValue("max_iter", m_maxIter);
-            m_solver->Options()->SetNumericValue("max_cpu_time", m_maxCpuTime);
-            m_solver->Options()->SetNumericValue("tol", m_tol);
-            m_solver->Options()->SetNumericValue("constr_viol_tol", m_constrTol);
             m_solver->Options()->SetIntegerValue("acceptable_iter", 5);
             m_solver->Options()->SetStringValue("fixed_variable_treatment", "make_parameter"); //which btw is the default option
 #ifndef NDEBUG
             m_solver->Options()->SetStringValue("derivative_test", "first-order");
 #endif
-            if (!m_solverName.empty()) {
-                m_solver->Options()->SetStringValue("linear_solver", m_solverName);
-            } else {
-                m_solver->Options()->GetStringValue("linear_solver", m_solverName, "");
-            }
 
             m_solver->Options()->SetNumericValue("warm_start_bound_frac", 1e-6);
             m_solver->Options()->SetNumericValue("warm_start_bound_push", 1e-6);
@@ -372,10 +459,27 @@ namespace kinematics {
             m_solver->Options()->SetNumericValue("warm_start_slack_bound_frac", 1e-6);
             m_solver->Options()->SetNumericValue("warm_start_slack_bound_push", 1e-6);
 
-            solverStatus = m_solver->Initialize();
-            if (solverStatus != Ipopt::Solve_Succeeded) {
+            if (m_solver->Initialize() != Ipopt::Solve_Succeeded) {
                 return false;
             }
+            m_solverOptionsChanged = true;
+        }
+
+        // The options are passed to the solver only if they changed since the last solve
+        if (m_solverOptionsChanged) {
+            updateSolverOptions();
+            m_canReoptimizeProblem = false;
+        }
+        return true;
+    }
+
+    bool InverseKinematicsData::solveProblem()
+    {
+        std::chrono::steady_clock::time_point solveStart = std::chrono::steady_clock::now();
+        Ipopt::ApplicationReturnStatus solverStatus;
+
+        if (!initializeSolver()) {
+            return false;
         }
 
         if (!m_problemInitialized) {
@@ -383,26 +487,54 @@ namespace kinematics {
         }
 
         prepareForOptimization();
+
+        // In tracking mode, if the structure of the problem did not change,
+        // the solver reuses the data structures of the last solve
+        bool reoptimize = m_useTrackingMode && m_canReoptimizeProblem;
+        if (reoptimize != m_reoptimizingProblem) {
+            m_solver->Options()->SetStringValue("warm_start_same_structure", reoptimize ? "yes" : "no");
+            m_reoptimizingProblem = reoptimize;
+        }
+
         // Ask Ipopt to solve the problem
-        solverStatus = m_solver->OptimizeTNLP(m_nlpProblem);
+        if (reoptimize) {
+            solverStatus = m_solver->ReOptimizeTNLP(m_nlpProblem);
+        } else {
+            solverStatus = m_solver->OptimizeTNLP(m_nlpProblem);
+        }
+
+        m_lastSolveConverged = solverStatus == Ipopt::Solve_Succeeded || solverStatus == Ipopt::Solved_To_Acceptable_Level;
+        // In tracking mode the last iterate is accepted if the solver reached the maximum number of iterations or time
+        bool solutionAccepted = m_lastSolveConverged
+            || (m_useTrackingMode && (solverStatus == Ipopt::Maximum_Iterations_Exceeded || solverStatus == Ipopt::Maximum_CpuTime_Exceeded));
+
+        Ipopt::SmartPtr<Ipopt::SolveStatistics> statistics = m_solver->Statistics();
+        m_lastSolveIterations = Ipopt::IsValid(statistics) ? statistics->IterationCount() : 0;
+
+        m_canReoptimizeProblem = solutionAccepted;
+        m_lastSolutionIsInitialCondition = solutionAccepted;
 
-        if (solverStatus == Ipopt::Solve_Succeeded || solverStatus == Ipopt::Solved_To_Acceptable_Level ) {
+        if (solutionAccepted) {
             if (!m_warmStartEnabled) {
                 m_warmStartEnabled = true;
                 m_solver->Options()->SetStringValue("warm_start_init_point", "yes");
             }
-            return true;
-        } else {
-            return false;
         }
+
+        std::chrono::duration<double> solveDuration = std::chrono::steady_clock::now() - solveStart;
+        m_lastSolveTime = solveDuration.count();
+
+        return solutionAccepted;
     }
-    
+
     void InverseKinematicsData::setCoMTarget(iDynTree::Position& desiredPosition, double weight){
         this->m_comTarget.desiredPosition = desiredPosition;
 
-        if (!this->m_comTarget.isActive
-            && m_defaultTargetResolutionMode & iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly) {
-            this->m_comTarget.isConstraint = true;
+        if (!this->m_comTarget.isActive) {
+            if (m_defaultTargetResolutionMode & iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly) {
+                this->m_comTarget.isConstraint = true;
+            }
+            m_problemInitialized = false;
         }
         
         if (!(weight < 0)) {
@@ -414,6 +546,9 @@ namespace kinematics {
 
     void InverseKinematicsData::setCoMasConstraint(bool asConstraint)
     {
+        if (this->m_comTarget.isConstraint != asConstraint) {
+            m_problemInitialized = false;
+        }
         this->m_comTarget.isConstraint = asConstraint;
     }
 
@@ -433,6 +568,9 @@ namespace kinematics {
 
     void InverseKinematicsData::setCoMTargetInactive()
     {
+        if (this->m_comTarget.isActive) {
+            m_problemInitialized = false;
+        }
         this->m_comTarget.isActive = false;
         this->m_comTarget.weight = 0;
         this->m_comTarget.desiredPosition.zero();
@@ -440,6 +578,9 @@ namespace kinematics {
 
     void InverseKinematicsData::computeProblemSizeAndResizeBuffers()
     {
+        // The structure of the problem may change
+        m_canReoptimizeProblem = false;
+
         //Size of optimization variables is 3 + Orientation (base) + size of joints we optimize
         m_numberOfOptimisationVariables = 3 + sizeOfRotationParametrization(m_rotationParametrization) + m_dofs;
 
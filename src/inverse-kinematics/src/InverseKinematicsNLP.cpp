@@ -20,6 +20,7 @@
 
 #include <Eigen/Core>
 #include <iDynTree/Core/EigenHelpers.h>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -34,6 +35,81 @@ namespace kinematics {
     template<unsigned row, unsigned col>
     struct is_matrixfixsize<iDynTree::MatrixFixSize<row, col>> : std::true_type {};
 
+    namespace {
+        /*!
+         * Adds \f$ w J^\top J \f$ to the nonzeros of the (lower triangular part of the) Hessian,
+         * evaluating only the entries of the sparsity pattern.
+         */
+        template <typename JacobianType>
+        void addGaussNewtonHessian(const Eigen::MatrixBase<JacobianType>& jacobian, double weight,
+                                   const std::vector<Ipopt::Index>& rows,
+                                   const std::vector<Ipopt::Index>& columns,
+                                   Ipopt::Number* hessianValues)
+        {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                hessianValues[i] += weight * jacobian.col(rows[i]).dot(jacobian.col(columns[i]));
+            }
+        }
+
+        /*!
+         * Computes the first and second derivatives of \f$ u^\top z(A R) \f$ w.r.t. an inertial rotation vector
+         * applied to \f$ R \f$ (see InverseKinematicsNLP::addRotationHessian),
+         * where \f$ z \f$ is the quaternion of the rotation, and \f$ A \f$ is a constant rotation.
+         */
+        void computeQuaternionHessianMaps(const iDynTree::Vector4& quaternion,
+                                          const Eigen::Ref<const Eigen::Vector4d>& weights,
+                                          const iDynTree::Rotation& constantRotation,
+                                          iDynTree::Matrix3x3& angularCurvature,
+                                          iDynTree::Vector3& angularGradient)
+        {
+            // The derivative map is linear in the quaternion
+            const iDynTree::MatrixFixSize<4, 3> derivativeMap = iDynTree::Rotation::QuaternionRightTrivializedDerivative(quaternion);
+            Eigen::Map<const Eigen::Matrix<double, 4, 3, Eigen::RowMajor> > map = iDynTree::toEigen(derivativeMap);
+            Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> > A = iDynTree::toEigen(constantRotation);
+
+            Eigen::Matrix3d curvature = Eigen::Matrix3d::Zero();
+            for (unsigned d = 0; d < 4; ++d) {
+                iDynTree::Vector4 element;
+                element.zero();
+                element(d) = 1.0;
+                iDynTree::MatrixFixSize<4, 3> mapDerivative = iDynTree::Rotation::QuaternionRightTrivializedDerivative(element);
+                curvature += map.row(d).transpose() * (weights.transpose() * iDynTree::toEigen(mapDerivative));
+            }
+
+            iDynTree::toEigen(angularCurvature) = A.transpose() * curvature * A;
+            iDynTree::toEigen(angularGradient) = A.transpose() * map.transpose() * weights;
+        }
+
+        /*!
+         * Computes the first and second derivatives of \f$ u^\top \text{rpy}(A R) \f$ w.r.t. an inertial rotation vector
+         * applied to \f$ R \f$ (see InverseKinematicsNLP::addRotationHessian),
+         * where \f$ \text{rpy} \f$ are the RPY angles of the rotation, and \f$ A \f$ is a constant rotation.
+         */
+        void computeRPYHessianMaps(const iDynTree::Vector3& rpy,
+                                   const Eigen::Ref<const Eigen::Vector3d>& weights,
+                                   const iDynTree::Rotation& constantRotation,
+                                   iDynTree::Matrix3x3& angularCurvature,
+                                   iDynTree::Vector3& angularGradient)
+        {
+            const iDynTree::Matrix3x3 derivativeMap = iDynTree::Rotation::RPYRightTrivializedDerivativeInverse(rpy(0), rpy(1), rpy(2));
+            Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> > map = iDynTree::toEigen(derivativeMap);
+            Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> > A = iDynTree::toEigen(constantRotation);
+
+            Eigen::Matrix3d curvature = Eigen::Matrix3d::Zero();
+            for (unsigned d = 0; d < 3; ++d) {
+                iDynTree::Vector3 element;
+                element.zero();
+                element(d) = 1.0;
+                iDynTree::Matrix3x3 mapDerivative = iDynTree::Rotation::RPYRightTrivializedDerivativeInverseRateOfChange(rpy(0), rpy(1), rpy(2),
+                                                                                                                       element(0), element(1), element(2));
+                curvature += map.row(d).transpose() * (weights.transpose() * iDynTree::toEigen(mapDerivative));
+            }
+
+            iDynTree::toEigen(angularCurvature) = A.transpose() * curvature * A;
+            iDynTree::toEigen(angularGradient) = A.transpose() * map.transpose() * weights;
+        }
+    }
+
     //MARK: - SparsityHelper implementation
 
     const std::vector<size_t> SparsityHelper::s_nullVector = std::vector<size_t>();
@@ -199,21 +275,19 @@ namespace kinematics {
         constraintsInfo.clear();
         targetsInfo.clear();
 
+        const iDynTree::Model& model = m_data.m_dynamics.model();
+        model.computeFullTreeTraversal(m_traversal, model.getLinkIndex(m_data.m_dynamics.getFloatingBase()));
+        jointsMotionSubspacesBuffer.resize(6, m_data.m_dofs);
+
         //prepare buffers for constraints and targets
         for (TransformMap::const_iterator target = m_data.m_targets.begin();
              target != m_data.m_targets.end(); ++target) {
-            FrameInfo info;
-            info.jacobian.resize(6, m_data.m_dofs + 6);
-            info.jacobian.zero();
-            targetsInfo.insert(FrameInfoMap::value_type(target->first, info));
+            initializeFrameInfo(target->first, targetsInfo[target->first]);
         }
 
         for (TransformMap::const_iterator constraint = m_data.m_constraints.begin();
              constraint != m_data.m_constraints.end(); ++constraint) {
-            FrameInfo info;
-            info.jacobian.resize(6, m_data.m_dofs + 6);
-            info.jacobian.zero();
-            constraintsInfo.insert(FrameInfoMap::value_type(constraint->first, info));
+            initializeFrameInfo(constraint->first, constraintsInfo[constraint->first]);
         }
 
         //prepare buffer for COM constraint
@@ -221,18 +295,52 @@ namespace kinematics {
         comInfo.comJacobian.resize(3, m_data.m_dofs + 6);
         comInfo.comJacobianAnalytical.resize(3, m_data.m_dofs + 3 + sizeOfRotationParametrization(m_data.m_rotationParametrization));
         comInfo.projectedComJacobian.resize(m_data.m_comHullConstraint.getNrOfConstraints(), m_data.m_dofs + 3 + sizeOfRotationParametrization(m_data.m_rotationParametrization));
+        comInfo.comJacobianWithJointsAxes.resize(6, m_data.m_dofs + 6);
+        comInfo.comJacobianWithJointsAxes.zero();
+
+        //prepare buffers for the Hessian
+        unsigned rotationSize = sizeOfRotationParametrization(m_data.m_rotationParametrization);
+        analyticalJacobianBuffer.resize(6, 3 + rotationSize + m_data.m_dofs);
+        baseOrientationMapBuffer.resize(3, rotationSize);
+        baseOrientationMapDerivativesBuffer.resize(rotationSize);
+        for (auto& mapDerivative : baseOrientationMapDerivativesBuffer) {
+            mapDerivative.resize(3, rotationSize);
+        }
 
         initializeSparsityInformation();
+        initializeHessianSparsityInformation();
     }
 
-void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
-                                                               const internal::kinematics::TransformConstraint& constraint)
+    void InverseKinematicsNLP::initializeFrameInfo(int frameIndex, FrameInfo& frameInfo)
+    {
+        frameInfo.jacobian.resize(6, m_data.m_dofs + 6);
+        frameInfo.jacobian.zero();
+        frameInfo.constraintJacobian.resize(finalJacobianBuffer.rows(), finalJacobianBuffer.cols());
+        frameInfo.constraintJacobian.zero();
+
+        //The dofs moving the frame are the ones of the joints from its link to the base
+        frameInfo.dofsOnPath.clear();
+        iDynTree::LinkIndex visitedLinkIdx = m_data.m_dynamics.model().getFrameLink(frameIndex);
+        while (visitedLinkIdx != m_traversal.getBaseLink()->getIndex()) {
+            const iDynTree::IJoint* joint = m_traversal.getParentJointFromLinkIndex(visitedLinkIdx);
+            for (unsigned i = 0; i < joint->getNrOfDOFs(); ++i) {
+                frameInfo.dofsOnPath.push_back(joint->getDOFsOffset() + i);
+            }
+            visitedLinkIdx = m_traversal.getParentLinkFromLinkIndex(visitedLinkIdx)->getIndex();
+        }
+        std::sort(frameInfo.dofsOnPath.begin(), frameInfo.dofsOnPath.end());
+    }
+
+    void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
+                                                                   const internal::kinematics::TransformConstraint& constraint,
+                                                                   FrameInfo& constraintInfo,
+                                                                   int computationOption)
     {
         //For each constraint compute its jacobian pattern
-        FrameInfo &constraintInfo = constraintsInfo[constraintID];
         // iDynTree pattern
         m_data.dynamics().getFrameFreeFloatingJacobianSparsityPattern(constraintID, constraintInfo.jacobian);
         // Now we have to modify it depending on the orientation parametrization
+        finalJacobianBuffer.zero();
 
 
         if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
@@ -244,11 +352,11 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
             iDynTree::MatrixFixSize<4, 3> quaternionDerivativeMap;
             iDynTree::toEigen(quaternionDerivativeMap).setOnes();
 
-            finalJacobianBuffer.zero();
             computeConstraintJacobian(constraintInfo.jacobian, // this has the sparsity
                                       quaternionDerivativeMap, // this is a all 1s matrix
                                       quaternionDerivativeInverseMap, // this is a all 1s matrix
                                       ComputeContraintJacobianOptionLinearPart|ComputeContraintJacobianOptionAngularPart,
+                                      constraintInfo.dofsOnPath,
                                       finalJacobianBuffer);
 
 
@@ -282,9 +390,13 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                          omegaToRPYMap_target,
                                          RPYToOmega,
                                          ComputeContraintJacobianOptionLinearPart|ComputeContraintJacobianOptionAngularPart,
+                                         constraintInfo.dofsOnPath,
                                          finalJacobianBuffer);
         }
 
+        //The pattern of the jacobian buffer is used also for the values
+        constraintInfo.jacobian.zero();
+
         // Now "normalize" (i.e. only 0.0 and 1.0) the result
         for (unsigned row = 0; row < finalJacobianBuffer.rows(); ++row) {
             for (unsigned col = 0; col < finalJacobianBuffer.cols(); ++col) {
@@ -294,11 +406,11 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
         //Now that we computed the actual Jacobian needed by IPOPT
         //We have to assign it to the correct variable
-        if (constraint.hasPositionConstraint()) {
+        if ((computationOption & ComputeContraintJacobianOptionLinearPart) && constraint.hasPositionConstraint()) {
             //Position part
             m_jacobianSparsityHelper.addConstraintSparsityPattern(finalJacobianBuffer, {0, 3});
         }
-        if (constraint.hasRotationConstraint()) {
+        if ((computationOption & ComputeContraintJacobianOptionAngularPart) && constraint.hasRotationConstraint()) {
             //Orientation part
             m_jacobianSparsityHelper.addConstraintSparsityPattern(finalJacobianBuffer, {3, sizeOfRotationParametrization(m_data.m_rotationParametrization)});
         }
@@ -311,7 +423,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
         for (TransformMap::const_iterator constraint = m_data.m_constraints.begin();
              constraint != m_data.m_constraints.end(); ++constraint) {
             if (constraint->second.isActive()) {
-                addSparsityInformationForConstraint(constraint->first, constraint->second);
+                addSparsityInformationForConstraint(constraint->first, constraint->second, constraintsInfo[constraint->first]);
             }
         }
 
@@ -329,7 +441,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                 m_jacobianSparsityHelper.addConstraintSparsityPattern(comInfo.projectedComJacobian);
             }
 
-            if (m_data.isCoMTargetActive()) {
+            if (m_data.isCoMTargetActive() && m_data.isCoMaConstraint()) {
                 m_jacobianSparsityHelper.addConstraintSparsityPattern(comInfo.comJacobianAnalytical);
             }
         }
@@ -350,7 +462,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
                 if (computationOption == 0) continue; // no need for further computations
 
-                addSparsityInformationForConstraint(target->first, target->second);
+                addSparsityInformationForConstraint(target->first, target->second, targetsInfo[target->first], computationOption);
             }
 
         }
@@ -368,6 +480,57 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
     }
 
+    void InverseKinematicsNLP::initializeHessianSparsityInformation()
+    {
+        //For each dof, mark the dofs of the joints between its child link and the base
+        m_dofsAncestors.assign(m_data.m_dofs * m_data.m_dofs, false);
+        for (unsigned traversalIndex = 1; traversalIndex < m_traversal.getNrOfVisitedLinks(); ++traversalIndex) {
+            const iDynTree::IJoint* joint = m_traversal.getParentJoint(traversalIndex);
+            for (unsigned i = 0; i < joint->getNrOfDOFs(); ++i) {
+                size_t dof = joint->getDOFsOffset() + i;
+
+                iDynTree::LinkIndex visitedLinkIdx = m_traversal.getLink(traversalIndex)->getIndex();
+                while (visitedLinkIdx != m_traversal.getBaseLink()->getIndex()) {
+                    const iDynTree::IJoint* ancestorJoint = m_traversal.getParentJointFromLinkIndex(visitedLinkIdx);
+                    for (unsigned j = 0; j < ancestorJoint->getNrOfDOFs(); ++j) {
+                        m_dofsAncestors[dof * m_data.m_dofs + ancestorJoint->getDOFsOffset() + j] = true;
+                    }
+                    visitedLinkIdx = m_traversal.getParentLinkFromLinkIndex(visitedLinkIdx)->getIndex();
+                }
+            }
+        }
+
+        //The base variables couple with all the variables, while two joints are coupled only
+        //if they are on the same branch. If the COM is a cost, the Gauss-Newton term of its
+        //cost couples all the joints.
+        bool denseJointsBlock = m_data.isCoMTargetActive() && !m_data.isCoMaConstraint();
+        Ipopt::Index baseSize = 3 + sizeOfRotationParametrization(m_data.m_rotationParametrization);
+        Ipopt::Index numberOfVariables = baseSize + m_data.m_dofs;
+
+        m_hessianRows.clear();
+        m_hessianColumns.clear();
+        m_hessianEntries.assign(numberOfVariables * numberOfVariables, -1);
+        for (Ipopt::Index row = 0; row < numberOfVariables; ++row) {
+            for (Ipopt::Index col = 0; col <= row; ++col) {
+                if (col >= baseSize && !denseJointsBlock
+                    && !m_dofsAncestors[(row - baseSize) * m_data.m_dofs + (col - baseSize)]
+                    && !m_dofsAncestors[(col - baseSize) * m_data.m_dofs + (row - baseSize)]) {
+                    continue;
+                }
+                m_hessianEntries[row * numberOfVariables + col] = static_cast<Ipopt::Index>(m_hessianRows.size());
+                m_hessianRows.push_back(row);
+                m_hessianColumns.push_back(col);
+            }
+        }
+    }
+
+    Ipopt::Index InverseKinematicsNLP::hessianEntry(Ipopt::Index row, Ipopt::Index col) const
+    {
+        Ipopt::Index numberOfVariables = 3 + sizeOfRotationParametrization(m_data.m_rotationParametrization) + m_data.m_dofs;
+        assert(col <= row && m_hessianEntries[row * numberOfVariables + col] >= 0);
+        return m_hessianEntries[row * numberOfVariables + col];
+    }
+
     bool InverseKinematicsNLP::updateState(const Ipopt::Number * x)
     {
         //This method computes all the data which is needed in more than one place.
@@ -465,6 +628,21 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
             return false;
         }
 
+        //The motion subspaces of the joints w.r.t. the world frame are the same
+        //for all the frames on the same branch, so they are computed once
+        iDynTree::iDynTreeEigenMatrixMap jointsMotionSubspaces = iDynTree::toEigen(jointsMotionSubspacesBuffer);
+        for (unsigned traversalIndex = 1; traversalIndex < m_traversal.getNrOfVisitedLinks(); ++traversalIndex) {
+            const iDynTree::IJoint* joint = m_traversal.getParentJoint(traversalIndex);
+            iDynTree::LinkIndex childLinkIdx = m_traversal.getLink(traversalIndex)->getIndex();
+            iDynTree::LinkIndex parentLinkIdx = m_traversal.getParentLink(traversalIndex)->getIndex();
+            iDynTree::Transform world_H_child = m_data.m_dynamics.getWorldTransform(childLinkIdx);
+
+            for (unsigned i = 0; i < joint->getNrOfDOFs(); ++i) {
+                iDynTree::SpatialMotionVector jointMotionSubspace = world_H_child * joint->getMotionSubspaceVector(i, childLinkIdx, parentLinkIdx);
+                jointsMotionSubspaces.col(joint->getDOFsOffset() + i) = iDynTree::toEigen(jointMotionSubspace);
+            }
+        }
+
         // Common computation
         // - for each target: transform (f, grad_f, g, grad_g)
         // - Jacobian of target frames (grad_f, grad_g)
@@ -475,7 +653,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
             FrameInfo &frameInfo = targetsInfo[target->first];
             frameInfo.transform = m_data.m_dynamics.getWorldTransform(target->first);
-            m_data.m_dynamics.getFrameFreeFloatingJacobian(target->first, frameInfo.jacobian);
+            updateFrameJacobian(frameInfo);
 
             iDynTree::Vector4 transformQuat;
             frameInfo.transform.getRotation().getQuaternion(transformQuat);
@@ -507,7 +685,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
             if (constraint->second.isActive()) {
                 FrameInfo &frameInfo = constraintsInfo[constraint->first];
                 frameInfo.transform = m_data.m_dynamics.getWorldTransform(constraint->first);
-                m_data.m_dynamics.getFrameFreeFloatingJacobian(constraint->first, frameInfo.jacobian);
+                updateFrameJacobian(frameInfo);
 
                 iDynTree::Vector4 transformQuat;
                 frameInfo.transform.getRotation().getQuaternion(transformQuat);
@@ -538,6 +716,40 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
         return true;
     }
 
+    void InverseKinematicsNLP::updateFrameJacobian(FrameInfo& frameInfo)
+    {
+        //In the mixed representation the velocity of the frame is expressed w.r.t. the
+        //frame origin, while the motion subspaces are expressed w.r.t. the world origin
+        iDynTree::iDynTreeEigenMatrixMap jacobian = iDynTree::toEigen(frameInfo.jacobian);
+        iDynTree::iDynTreeEigenMatrixMap jointsMotionSubspaces = iDynTree::toEigen(jointsMotionSubspacesBuffer);
+        Eigen::Vector3d framePosition = iDynTree::toEigen(frameInfo.transform.getPosition());
+
+        jacobian.leftCols<6>().setIdentity();
+        jacobian.block<3, 3>(0, 3) = iDynTree::skew(iDynTree::toEigen(optimizedBasePosition) - framePosition);
+
+        for (size_t dof : frameInfo.dofsOnPath) {
+            Eigen::Matrix<double, 6, 1> motionSubspace = jointsMotionSubspaces.col(dof);
+            jacobian.block<3, 1>(0, 6 + dof) = motionSubspace.head<3>() - framePosition.cross(motionSubspace.tail<3>());
+            jacobian.block<3, 1>(3, 6 + dof) = motionSubspace.tail<3>();
+        }
+    }
+
+    void InverseKinematicsNLP::addToGradient(const FrameInfo& frameInfo,
+                                             unsigned firstRow,
+                                             unsigned numberOfRows,
+                                             const double* coefficients,
+                                             Ipopt::Number* gradient)
+    {
+        iDynTree::iDynTreeEigenConstMatrixMap constraintJacobian = iDynTree::toEigen(frameInfo.constraintJacobian);
+        Eigen::Map<const Eigen::VectorXd> rowsCoefficients(coefficients, numberOfRows);
+        Eigen::Index baseSize = 3 + sizeOfRotationParametrization(m_data.m_rotationParametrization);
+
+        Eigen::Map<Eigen::VectorXd>(gradient, baseSize) += constraintJacobian.block(firstRow, 0, numberOfRows, baseSize).transpose() * rowsCoefficients;
+        for (size_t dof : frameInfo.dofsOnPath) {
+            gradient[baseSize + dof] += constraintJacobian.block(firstRow, baseSize + dof, numberOfRows, 1).col(0).dot(rowsCoefficients);
+        }
+    }
+
     bool InverseKinematicsNLP::get_nlp_info(Ipopt::Index& n,
                                             Ipopt::Index& m,
                                             Ipopt::Index& nnz_jac_g,
@@ -549,7 +761,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
         nnz_jac_g = m_jacobianSparsityHelper.numberOfNonZeros();
 
-        nnz_h_lag = n * n; //this is currently ignored
+        nnz_h_lag = m_hessianRows.size();
 
         index_style = C_STYLE;
 
@@ -896,14 +1108,16 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                     target->second.targetResolutionMode() == iDynTree::InverseKinematicsTreatTargetAsConstraintNone)
                 && target->second.hasPositionConstraint()) {
                 //this implies that position is a soft constraint.
-                iDynTree::Position positionError = targetsInfo[target->first].transform.getPosition() - target->second.getPosition();
+                FrameInfo &targetInfo = targetsInfo[target->first];
+                iDynTree::Position positionError = targetInfo.transform.getPosition() - target->second.getPosition();
 
                 if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
-                    computeConstraintJacobian(targetsInfo[target->first].jacobian,
-                                              targetsInfo[target->first].quaternionDerivativeMap,
+                    computeConstraintJacobian(targetInfo.jacobian,
+                                              targetInfo.quaternionDerivativeMap,
                                               quaternionDerivativeInverseMapBuffer,
                                               ComputeContraintJacobianOptionLinearPart,
-                                              finalJacobianBuffer);
+                                              targetInfo.dofsOnPath,
+                                              targetInfo.constraintJacobian);
                 } else if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw) {
                     //RPY parametrization for the base
                     iDynTree::Vector3 rpy;
@@ -911,30 +1125,30 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                     iDynTree::Matrix3x3 RPYToOmega = iDynTree::Rotation::RPYRightTrivializedDerivative(rpy(0), rpy(1), rpy(2));
 
                     // RPY parametrization for the constraint
-                    iDynTree::Vector3 rpy_target = targetsInfo[target->first].transform.getRotation().asRPY();
+                    iDynTree::Vector3 rpy_target = targetInfo.transform.getRotation().asRPY();
                     iDynTree::Matrix3x3 omegaToRPYMap_target = iDynTree::Rotation::RPYRightTrivializedDerivativeInverse(rpy_target(0), rpy_target(1), rpy_target(2));
 
-                    computeConstraintJacobianRPY(targetsInfo[target->first].jacobian,
+                    computeConstraintJacobianRPY(targetInfo.jacobian,
                                                  omegaToRPYMap_target,
                                                  RPYToOmega,
                                                  ComputeContraintJacobianOptionLinearPart,
-                                                 finalJacobianBuffer);
+                                                 targetInfo.dofsOnPath,
+                                                 targetInfo.constraintJacobian);
                 }
 
-
-                //Note: transpose probably creates a temporary matrix. As position is
-                //Fixedsize this should not fire a memory allocation in the heap, but we should
-                //profile the code at some point
-                gradient +=  target->second.getPositionWeight() * iDynTree::toEigen(positionError).transpose() * iDynTree::toEigen(finalJacobianBuffer).topRows<3>();
+                iDynTree::Vector3 weightedPositionError;
+                iDynTree::toEigen(weightedPositionError) = target->second.getPositionWeight() * iDynTree::toEigen(positionError);
+                addToGradient(targetInfo, 0, 3, weightedPositionError.data(), grad_f);
 
             }
             if ((target->second.targetResolutionMode() == iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly||
                     target->second.targetResolutionMode() == iDynTree::InverseKinematicsTreatTargetAsConstraintNone)
                 && target->second.hasRotationConstraint()) {
                 
+                FrameInfo &targetInfo = targetsInfo[target->first];
                 if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
                     //Derivative is (\tilde{Q} - 1) \partial_x Q
-                    iDynTree::Rotation transformError = targetsInfo[target->first].transform.getRotation() * target->second.getRotation().inverse();
+                    iDynTree::Rotation transformError = targetInfo.transform.getRotation() * target->second.getRotation().inverse();
 
                     iDynTree::Vector4 orientationErrorQuaternion;
                     transformError.getQuaternion(orientationErrorQuaternion);
@@ -944,22 +1158,26 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
                     //assert(m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion);
 
+                    //The error has the same angular velocity of the frame, but the derivative
+                    //of its quaternion depends on the error quaternion itself
+                    iDynTree::MatrixFixSize<4, 3> errorQuaternionDerivativeMap = iDynTree::Rotation::QuaternionRightTrivializedDerivative(orientationErrorQuaternion);
 
-                    computeConstraintJacobian(targetsInfo[target->first].jacobian,
-                                            targetsInfo[target->first].quaternionDerivativeMap,
+                    computeConstraintJacobian(targetInfo.jacobian,
+                                            errorQuaternionDerivativeMap,
                                             quaternionDerivativeInverseMapBuffer,
                                             ComputeContraintJacobianOptionAngularPart,
-                                            finalJacobianBuffer);
+                                            targetInfo.dofsOnPath,
+                                            targetInfo.constraintJacobian);
 
-                    //These are the first baseSize columns + the joint columns
-                    gradient += target->second.getRotationWeight()*(iDynTree::toEigen(orientationErrorQuaternion) - iDynTree::toEigen(identityQuaternion)).transpose() * iDynTree::toEigen(finalJacobianBuffer).bottomRows(sizeOfRotationParametrization(m_data.m_rotationParametrization));
+                    iDynTree::Vector4 weightedOrientationError;
+                    iDynTree::toEigen(weightedOrientationError) = target->second.getRotationWeight() * (iDynTree::toEigen(orientationErrorQuaternion) - iDynTree::toEigen(identityQuaternion));
+                    addToGradient(targetInfo, 3, 4, weightedOrientationError.data(), grad_f);
                 }
                 else if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw){
                     //RPY parametrization for the base
                     iDynTree::Vector3 rpy;
                     iDynTree::toEigen(rpy) = iDynTree::toEigen(this->optimizedBaseOrientation).head<3>();
                     iDynTree::Matrix3x3 RPYToOmega = iDynTree::Rotation::RPYRightTrivializedDerivative(rpy(0), rpy(1), rpy(2));
-                    FrameInfo &targetInfo = targetsInfo[target->first];
 
                     iDynTree::Rotation rotation_target = targetInfo.transform.getRotation();
                     iDynTree::Rotation rotation_desired = target->second.getRotation();
@@ -973,9 +1191,12 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                                 omegaToRPYMap_target,
                                                 RPYToOmega,
                                                 ComputeContraintJacobianOptionAngularPart,
-                                                finalJacobianBuffer);
+                                                targetInfo.dofsOnPath,
+                                                targetInfo.constraintJacobian);
                     //TODO Investigate the derivative of the cost using the RPY representation of the error matrix R*\hat{R}'
-                    gradient += target->second.getRotationWeight()*( iDynTree::toEigen(rpy_error)).transpose() * iDynTree::toEigen(finalJacobianBuffer).bottomRows(sizeOfRotationParametrization(m_data.m_rotationParametrization));
+                    iDynTree::Vector3 weightedRPYError;
+                    iDynTree::toEigen(weightedRPYError) = target->second.getRotationWeight() * iDynTree::toEigen(rpy_error);
+                    addToGradient(targetInfo, 3, 3, weightedRPYError.data(), grad_f);
                     
                 }
             }
@@ -1167,7 +1388,8 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                                   quaternionDerivativeInverseMapBuffer,
                                                   ComputeContraintJacobianOptionLinearPart |
                                                   ComputeContraintJacobianOptionAngularPart,
-                                                  finalJacobianBuffer);
+                                                  constraintInfo.dofsOnPath,
+                                                  constraintInfo.constraintJacobian);
 
                     } else if (m_data.m_rotationParametrization ==
                                iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw) {
@@ -1188,7 +1410,8 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                                      RPYToOmega,
                                                      ComputeContraintJacobianOptionLinearPart |
                                                      ComputeContraintJacobianOptionAngularPart,
-                                                     finalJacobianBuffer);
+                                                     constraintInfo.dofsOnPath,
+                                                     constraintInfo.constraintJacobian);
                     }
 
 
@@ -1197,7 +1420,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                     if (constraint->second.hasPositionConstraint()) {
                         //Position part
                         m_jacobianSparsityHelper.assignActualMatrixValues({constraintIndex, 3},
-                                                                          finalJacobianBuffer, 0,
+                                                                          constraintInfo.constraintJacobian, 0,
                                                                           values);
                         constraintIndex += 3;
                     }
@@ -1205,7 +1428,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                         //Orientation part
                         m_jacobianSparsityHelper.assignActualMatrixValues({constraintIndex,
                                                                            sizeOfRotationParametrization(m_data.m_rotationParametrization)},
-                                                                          finalJacobianBuffer, 3,
+                                                                          constraintInfo.constraintJacobian, 3,
                                                                           values);
                         constraintIndex += sizeOfRotationParametrization(m_data.m_rotationParametrization);
                     }
@@ -1233,7 +1456,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                     constraintIndex += comInfo.projectedComJacobian.rows();
                 }
                 
-                if (m_data.isCoMTargetActive()) {
+                if (m_data.isCoMTargetActive() && m_data.isCoMaConstraint()) {
                     m_jacobianSparsityHelper.assignActualMatrixValues({constraintIndex, static_cast<ptrdiff_t>(comInfo.comJacobianAnalytical.rows())},
                                                                       comInfo.comJacobianAnalytical, 0,
                                                                       values);
@@ -1269,7 +1492,8 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                               targetInfo.quaternionDerivativeMap,
                                               quaternionDerivativeInverseMapBuffer,
                                               computationOption,
-                                              finalJacobianBuffer);
+                                              targetInfo.dofsOnPath,
+                                              targetInfo.constraintJacobian);
 
                 } else if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw) {
                     //RPY parametrization for the base
@@ -1285,7 +1509,8 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                                  omegaToRPYMap_target,
                                                  RPYToOmega,
                                                  computationOption,
-                                                 finalJacobianBuffer);
+                                                 targetInfo.dofsOnPath,
+                                                 targetInfo.constraintJacobian);
                 }
 
                 if (target->second.targetResolutionMode() & iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly
@@ -1293,7 +1518,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
                     //Copy position part
                     m_jacobianSparsityHelper.assignActualMatrixValues({constraintIndex, 3},
-                                                                      finalJacobianBuffer, 0,
+                                                                      targetInfo.constraintJacobian, 0,
                                                                       values);
                     constraintIndex += 3;
                 }
@@ -1303,7 +1528,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                     //Orientation part
                     m_jacobianSparsityHelper.assignActualMatrixValues({constraintIndex,
                         sizeOfRotationParametrization(m_data.m_rotationParametrization)},
-                                                                      finalJacobianBuffer, 3,
+                                                                      targetInfo.constraintJacobian, 3,
                                                                       values);
                     constraintIndex += sizeOfRotationParametrization(m_data.m_rotationParametrization);
                 }
@@ -1314,8 +1539,8 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
             if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
                 //Quaternion norm derivative
                 // = 2 * Q^\top
-                Eigen::Map<Eigen::VectorXd> quaternionDerivative(&values[constraintIndex * n], 4);
-                quaternionDerivative = 2 * iDynTree::toEigen(this->optimizedBaseOrientation).transpose();
+                Eigen::Map<Eigen::VectorXd> quaternionDerivative(&values[m_jacobianSparsityHelper.totalNumberOfNonZerosBeforeRow(constraintIndex)], 4);
+                quaternionDerivative = 2 * iDynTree::toEigen(this->optimizedBaseOrientation);
                 constraintIndex++;
             }
 
@@ -1330,12 +1555,227 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                       bool new_lambda, Ipopt::Index nele_hess, Ipopt::Index* iRow,
                                       Ipopt::Index* jCol, Ipopt::Number* values)
     {
+        UNUSED_VARIABLE(n);
+        UNUSED_VARIABLE(new_lambda);
+
+        if (!values) {
+            //Define the sparsity pattern of the (lower triangular part of the) Hessian
+            assert(nele_hess == static_cast<Ipopt::Index>(m_hessianRows.size()));
+            for (size_t i = 0; i < m_hessianRows.size(); ++i) {
+                iRow[i] = m_hessianRows[i];
+                jCol[i] = m_hessianColumns[i];
+            }
+            return true;
+        }
+
         if (new_x) {
+#ifndef NDEBUG
+            eval_f_called = false;
+            eval_grad_f_called = false;
+            eval_g_called = false;
+            eval_jac_g_called = false;
+#endif
             if (!updateState(x))
                 return false;
         }
-        //TODO: hessian of Lagrangian
-        return false;
+
+        updateBaseOrientationMaps();
+
+        std::fill(values, values + nele_hess, 0.0);
+
+        Ipopt::Index rotationSize = sizeOfRotationParametrization(m_data.m_rotationParametrization);
+        Ipopt::Index baseSize = 3 + rotationSize;
+        iDynTree::Matrix3x3 angularCurvature;
+        iDynTree::Vector3 angularGradient;
+        iDynTree::Vector3 pointWeights;
+
+        //Cost: preferred joints configuration
+        for (size_t i = 0; i < m_data.m_dofs; ++i) {
+            values[hessianEntry(baseSize + i, baseSize + i)] += obj_factor * m_data.m_preferredJointsWeight(i);
+        }
+
+        //Cost: targets. Each cost is 1/2 w ||r(x)||^2, whose Hessian is
+        //w (dr/dx)^T dr/dx + w sum_i r_i d^2 r_i/dx^2
+        for (TransformMap::const_iterator target = m_data.m_targets.begin();
+             target != m_data.m_targets.end(); ++target) {
+
+            bool positionCost = (target->second.targetResolutionMode() == iDynTree::InverseKinematicsTreatTargetAsConstraintRotationOnly ||
+                                 target->second.targetResolutionMode() == iDynTree::InverseKinematicsTreatTargetAsConstraintNone)
+                                && target->second.hasPositionConstraint();
+            bool rotationCost = (target->second.targetResolutionMode() == iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly ||
+                                 target->second.targetResolutionMode() == iDynTree::InverseKinematicsTreatTargetAsConstraintNone)
+                                && target->second.hasRotationConstraint();
+            if (!positionCost && !rotationCost) continue;
+
+            FrameInfo &targetInfo = targetsInfo[target->first];
+            computeAnalyticalJacobian(targetInfo.jacobian, analyticalJacobianBuffer);
+            iDynTree::iDynTreeEigenMatrixMap analyticalJacobian = iDynTree::toEigen(analyticalJacobianBuffer);
+
+            if (positionCost) {
+                double weight = obj_factor * target->second.getPositionWeight();
+                iDynTree::Position positionError = targetInfo.transform.getPosition() - target->second.getPosition();
+
+                addGaussNewtonHessian(analyticalJacobian.topRows<3>(), weight, m_hessianRows, m_hessianColumns, values);
+                iDynTree::toEigen(pointWeights) = weight * iDynTree::toEigen(positionError);
+                addPointHessian(analyticalJacobianBuffer, targetInfo.transform.getPosition(), pointWeights, values);
+            }
+
+            if (rotationCost) {
+                double weight = obj_factor * target->second.getRotationWeight();
+
+                if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
+                    //Error is w_R_f * (w_R_f^d)^{-1}, which has the same angular velocity of the frame
+                    iDynTree::Rotation transformError = targetInfo.transform.getRotation() * target->second.getRotation().inverse();
+                    iDynTree::Vector4 orientationErrorQuaternion;
+                    transformError.getQuaternion(orientationErrorQuaternion);
+                    iDynTree::Vector4 identityQuaternion;
+                    iDynTree::Rotation::Identity().getQuaternion(identityQuaternion);
+
+                    iDynTree::MatrixFixSize<4, 3> errorQuaternionDerivativeMap = iDynTree::Rotation::QuaternionRightTrivializedDerivative(orientationErrorQuaternion);
+                    Eigen::Matrix<double, 4, Eigen::Dynamic> errorJacobian = iDynTree::toEigen(errorQuaternionDerivativeMap) * analyticalJacobian.bottomRows<3>();
+                    addGaussNewtonHessian(errorJacobian, weight, m_hessianRows, m_hessianColumns, values);
+
+                    computeQuaternionHessianMaps(orientationErrorQuaternion,
+                                                 weight * (iDynTree::toEigen(orientationErrorQuaternion) - iDynTree::toEigen(identityQuaternion)),
+                                                 iDynTree::Rotation::Identity(),
+                                                 angularCurvature, angularGradient);
+
+                } else if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw) {
+                    //Error is (w_R_f^d)^{-1} * w_R_f, whose angular velocity is the one of the frame rotated by (w_R_f^d)^{-1}
+                    iDynTree::Rotation rotation_desired_inverse = target->second.getRotation().inverse();
+                    iDynTree::Rotation rotation_error = rotation_desired_inverse * targetInfo.transform.getRotation();
+                    iDynTree::Vector3 rpy_error = rotation_error.asRPY();
+
+                    iDynTree::Matrix3x3 omegaToRPYMap_error = iDynTree::Rotation::RPYRightTrivializedDerivativeInverse(rpy_error(0), rpy_error(1), rpy_error(2));
+                    Eigen::Matrix<double, 3, Eigen::Dynamic> errorJacobian = iDynTree::toEigen(omegaToRPYMap_error) * iDynTree::toEigen(rotation_desired_inverse) * analyticalJacobian.bottomRows<3>();
+                    addGaussNewtonHessian(errorJacobian, weight, m_hessianRows, m_hessianColumns, values);
+
+                    computeRPYHessianMaps(rpy_error, weight * iDynTree::toEigen(rpy_error),
+                                          rotation_desired_inverse,
+                                          angularCurvature, angularGradient);
+                }
+                addRotationHessian(analyticalJacobianBuffer, angularCurvature, angularGradient, values);
+            }
+        }
+
+        //COM: the derivatives of the COM are the mass-weighted derivatives of the links COM,
+        //so its second derivatives can be computed from the COM Jacobian and the joints axes
+        bool comCost = m_data.isCoMTargetActive() && !m_data.isCoMaConstraint();
+        bool comConstraint = m_data.isCoMTargetActive() && m_data.isCoMaConstraint();
+        if (comCost || comConstraint || m_data.m_comHullConstraint.isActive()) {
+            iDynTree::iDynTreeEigenMatrixMap comJacobianWithJointsAxes = iDynTree::toEigen(comInfo.comJacobianWithJointsAxes);
+            comJacobianWithJointsAxes.topRows<3>() = iDynTree::toEigen(comInfo.comJacobian);
+            comJacobianWithJointsAxes.block<3, 3>(3, 3).setIdentity();
+            comJacobianWithJointsAxes.bottomRightCorner(3, m_data.m_dofs) = iDynTree::toEigen(jointsMotionSubspacesBuffer).bottomRows<3>();
+            computeAnalyticalJacobian(comInfo.comJacobianWithJointsAxes, analyticalJacobianBuffer);
+
+            if (comCost) {
+                double weight = obj_factor * m_data.m_comTarget.weight;
+                iDynTree::Position comPositionError = comInfo.com - m_data.m_comTarget.desiredPosition;
+
+                iDynTree::iDynTreeEigenMatrixMap analyticalJacobian = iDynTree::toEigen(analyticalJacobianBuffer);
+                addGaussNewtonHessian(analyticalJacobian.topRows<3>(), weight, m_hessianRows, m_hessianColumns, values);
+                iDynTree::toEigen(pointWeights) = weight * iDynTree::toEigen(comPositionError);
+                addPointHessian(analyticalJacobianBuffer, comInfo.com, pointWeights, values);
+            }
+        }
+
+        //Constraints, in the same order of eval_g
+        Ipopt::Index constraintIndex = 0;
+        Eigen::Map<const Eigen::VectorXd> multipliers(lambda, m);
+
+        for (TransformMap::const_iterator constraint = m_data.m_constraints.begin();
+             constraint != m_data.m_constraints.end(); ++constraint) {
+            if (!constraint->second.isActive()) continue;
+
+            FrameInfo &constraintInfo = constraintsInfo[constraint->first];
+            computeAnalyticalJacobian(constraintInfo.jacobian, analyticalJacobianBuffer);
+
+            if (constraint->second.hasPositionConstraint()) {
+                iDynTree::toEigen(pointWeights) = multipliers.segment<3>(constraintIndex);
+                addPointHessian(analyticalJacobianBuffer, constraintInfo.transform.getPosition(), pointWeights, values);
+                constraintIndex += 3;
+            }
+            if (constraint->second.hasRotationConstraint()) {
+                if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
+                    iDynTree::Vector4 quaternion;
+                    constraintInfo.transform.getRotation().getQuaternion(quaternion);
+                    computeQuaternionHessianMaps(quaternion, multipliers.segment<4>(constraintIndex),
+                                                 iDynTree::Rotation::Identity(),
+                                                 angularCurvature, angularGradient);
+                } else if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw) {
+                    computeRPYHessianMaps(constraintInfo.transform.getRotation().asRPY(), multipliers.segment<3>(constraintIndex),
+                                          iDynTree::Rotation::Identity(),
+                                          angularCurvature, angularGradient);
+                }
+                addRotationHessian(analyticalJacobianBuffer, angularCurvature, angularGradient, values);
+                constraintIndex += rotationSize;
+            }
+        }
+
+        // COM constraints
+        if (m_data.m_comHullConstraint.isActive()) {
+            //The constraint is A * Pdirection * (com - o)
+            iDynTree::toEigen(pointWeights) = iDynTree::toEigen(m_data.m_comHullConstraint.Pdirection).transpose()
+                * iDynTree::toEigen(m_data.m_comHullConstraint.A).transpose()
+                * multipliers.segment(constraintIndex, m_data.m_comHullConstraint.getNrOfConstraints());
+            computeAnalyticalJacobian(comInfo.comJacobianWithJointsAxes, analyticalJacobianBuffer);
+            addPointHessian(analyticalJacobianBuffer, comInfo.com, pointWeights, values);
+            constraintIndex += m_data.m_comHullConstraint.getNrOfConstraints();
+        }
+
+        if (comConstraint) {
+            iDynTree::toEigen(pointWeights) = multipliers.segment<3>(constraintIndex);
+            computeAnalyticalJacobian(comInfo.comJacobianWithJointsAxes, analyticalJacobianBuffer);
+            addPointHessian(analyticalJacobianBuffer, comInfo.com, pointWeights, values);
+            constraintIndex += 3;
+        }
+
+        //Targets considered as constraints
+        for (TransformMap::const_iterator target = m_data.m_targets.begin();
+             target != m_data.m_targets.end(); ++target) {
+
+            bool positionConstraint = target->second.targetResolutionMode() & iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly
+                                      && target->second.hasPositionConstraint();
+            bool rotationConstraint = target->second.targetResolutionMode() & iDynTree::InverseKinematicsTreatTargetAsConstraintRotationOnly
+                                      && target->second.hasRotationConstraint();
+            if (!positionConstraint && !rotationConstraint) continue;
+
+            FrameInfo &targetInfo = targetsInfo[target->first];
+            computeAnalyticalJacobian(targetInfo.jacobian, analyticalJacobianBuffer);
+
+            if (positionConstraint) {
+                iDynTree::toEigen(pointWeights) = multipliers.segment<3>(constraintIndex);
+                addPointHessian(analyticalJacobianBuffer, targetInfo.transform.getPosition(), pointWeights, values);
+                constraintIndex += 3;
+            }
+            if (rotationConstraint) {
+                if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
+                    iDynTree::Vector4 quaternion;
+                    targetInfo.transform.getRotation().getQuaternion(quaternion);
+                    computeQuaternionHessianMaps(quaternion, multipliers.segment<4>(constraintIndex),
+                                                 iDynTree::Rotation::Identity(),
+                                                 angularCurvature, angularGradient);
+                } else if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw) {
+                    computeRPYHessianMaps(targetInfo.transform.getRotation().asRPY(), multipliers.segment<3>(constraintIndex),
+                                          iDynTree::Rotation::Identity(),
+                                          angularCurvature, angularGradient);
+                }
+                addRotationHessian(analyticalJacobianBuffer, angularCurvature, angularGradient, values);
+                constraintIndex += rotationSize;
+            }
+        }
+
+        //Norm of the base orientation quaternion: || Q ||^2
+        if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
+            for (Ipopt::Index i = 0; i < 4; ++i) {
+                values[hessianEntry(3 + i, 3 + i)] += 2 * multipliers(constraintIndex);
+            }
+            constraintIndex++;
+        }
+
+        assert(constraintIndex == m);
+        return true;
     }
 
     void InverseKinematicsNLP::finalize_solution(Ipopt::SolverReturn status, Ipopt::Index n,
@@ -1346,7 +1786,7 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                                  Ipopt::IpoptCalculatedQuantities* ip_cq)
     {
         //TODO: save the status
-
+        m_data.m_lastSolveCost = obj_value;
 
         //Obtain base position
         iDynTree::Position basePosition;
@@ -1414,16 +1854,12 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                                          const iDynTree::MatrixFixSize<4, 3>& _quaternionDerivativeMap,
                                                          const iDynTree::MatrixFixSize<3, 4>& _quaternionDerivativeInverseMap,
                                                          const int computationOption,
+                                                         const std::vector<size_t>& dofsOnPath,
                                                          iDynTree::MatrixDynSize& constraintJacobianBuffer)
     {
         Eigen::Map<const Eigen::Matrix<double, 4, 3, Eigen::RowMajor> > quaternionDerivativeMap = iDynTree::toEigen(_quaternionDerivativeMap);
         Eigen::Map<const Eigen::Matrix<double, 3, 4, Eigen::RowMajor> > quaternionDerivativeInverseMap = iDynTree::toEigen(_quaternionDerivativeInverseMap);
 
-        //Number of joints
-        unsigned n = constraintJacobianBuffer.cols() - 7;
-
-        constraintJacobianBuffer.zero();
-
         //I have to obtain a Jacobian in 7 x 7 + dofs
         iDynTree::iDynTreeEigenConstMatrixMap frameJacobian = iDynTree::toEigen(transformJacobianBuffer);
         iDynTree::iDynTreeEigenMatrixMap constraintJacobian = iDynTree::toEigen(constraintJacobianBuffer);
@@ -1433,14 +1869,18 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
             //Position (linear) part of the Jacobian
             constraintJacobian.topLeftCorner<3, 3>() = frameJacobian.topLeftCorner<3, 3>();
             constraintJacobian.block<3, 4>(0, 3) = frameJacobian.block<3, 3>(0, 3) * quaternionDerivativeInverseMap;
-            constraintJacobian.topRightCorner(3, n) = frameJacobian.topRightCorner(3, n);
+            for (size_t dof : dofsOnPath) {
+                constraintJacobian.block<3, 1>(0, 7 + dof) = frameJacobian.block<3, 1>(0, 6 + dof);
+            }
         }
 
         if (computationOption & ComputeContraintJacobianOptionAngularPart) {
             //Angular part of the Jacobian
             constraintJacobian.bottomLeftCorner<4, 3>() = quaternionDerivativeMap * frameJacobian.bottomLeftCorner<3, 3>();
             constraintJacobian.block<4, 4>(3, 3) = quaternionDerivativeMap * frameJacobian.block<3, 3>(3, 3) * quaternionDerivativeInverseMap;
-            constraintJacobian.bottomRightCorner(4, n) = quaternionDerivativeMap * frameJacobian.bottomRightCorner(3, n);
+            for (size_t dof : dofsOnPath) {
+                constraintJacobian.block<4, 1>(3, 7 + dof) = quaternionDerivativeMap * frameJacobian.block<3, 1>(3, 6 + dof);
+            }
         }
     }
 
@@ -1448,16 +1888,12 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                                                             const iDynTree::MatrixFixSize<3, 3>& _rpyDerivativeMap,
                                                             const iDynTree::MatrixFixSize<3, 3>& _rpyDerivativeInverseMap,
                                                             const int computationOption,
+                                                            const std::vector<size_t>& dofsOnPath,
                                                             iDynTree::MatrixDynSize& constraintJacobianBuffer)
     {
         Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> > rpyDerivativeMap = iDynTree::toEigen(_rpyDerivativeMap);
         Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> > rpyDerivativeInverseMap = iDynTree::toEigen(_rpyDerivativeInverseMap);
 
-        //Number of joints
-        unsigned n = constraintJacobianBuffer.cols() - 6;
-
-        constraintJacobianBuffer.zero();
-
         iDynTree::iDynTreeEigenConstMatrixMap frameJacobian = iDynTree::toEigen(transformJacobianBuffer);
         iDynTree::iDynTreeEigenMatrixMap constraintJacobian = iDynTree::toEigen(constraintJacobianBuffer);
 
@@ -1465,14 +1901,18 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
             //Position (linear) part of the Jacobian
             constraintJacobian.topLeftCorner<3, 3>() = frameJacobian.topLeftCorner<3, 3>();
             constraintJacobian.block<3, 3>(0, 3) = frameJacobian.block<3, 3>(0, 3) * rpyDerivativeInverseMap;
-            constraintJacobian.topRightCorner(3, n) = frameJacobian.topRightCorner(3, n);
+            for (size_t dof : dofsOnPath) {
+                constraintJacobian.block<3, 1>(0, 6 + dof) = frameJacobian.block<3, 1>(0, 6 + dof);
+            }
         }
 
         if (computationOption & ComputeContraintJacobianOptionAngularPart) {
             //Angular part of the Jacobian
             constraintJacobian.bottomLeftCorner<3, 3>() = rpyDerivativeMap * frameJacobian.bottomLeftCorner<3, 3>();
             constraintJacobian.block<3, 3>(3, 3) = rpyDerivativeMap * frameJacobian.block<3, 3>(3, 3) * rpyDerivativeInverseMap;
-            constraintJacobian.bottomRightCorner(3, n) = rpyDerivativeMap * frameJacobian.bottomRightCorner(3, n);
+            for (size_t dof : dofsOnPath) {
+                constraintJacobian.block<3, 1>(3, 6 + dof) = rpyDerivativeMap * frameJacobian.block<3, 1>(3, 6 + dof);
+            }
         }
     }
 
@@ -1497,6 +1937,140 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
         constraintJacobian.topRightCorner(3, n) = comJacobian.topRightCorner(3, n);
     }
 
+    void InverseKinematicsNLP::updateBaseOrientationMaps()
+    {
+        iDynTree::iDynTreeEigenMatrixMap map = iDynTree::toEigen(baseOrientationMapBuffer);
+
+        if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationQuaternion) {
+            /*!
+             * As the quaternion given by IPOPT may be not normalized, the map is
+             * \f[
+             * M(\bar{z}) = G^{-1}\left(\frac{\bar{z}}{\norm{\bar{z}}}\right) \frac{\partial}{\partial \bar{z}} \frac{\bar{z}}{\norm{\bar{z}}} = \frac{G^{-1}(\bar{z})}{\norm{\bar{z}}^2},
+             * \f]
+             * (the same computed in updateState) where \f$ G^{-1} \f$ is linear in the quaternion.
+             */
+            double quaternionSNorm = iDynTree::toEigen(this->optimizedBaseOrientation).squaredNorm();
+            iDynTree::MatrixFixSize<3, 4> inverseMap = iDynTree::Rotation::QuaternionRightTrivializedDerivativeInverse(this->optimizedBaseOrientation);
+            map = iDynTree::toEigen(inverseMap) / quaternionSNorm;
+
+            for (unsigned j = 0; j < 4; ++j) {
+                iDynTree::Vector4 element;
+                element.zero();
+                element(j) = 1.0;
+                iDynTree::MatrixFixSize<3, 4> inverseMapDerivative = iDynTree::Rotation::QuaternionRightTrivializedDerivativeInverse(element);
+                iDynTree::toEigen(baseOrientationMapDerivativesBuffer[j]) = iDynTree::toEigen(inverseMapDerivative) / quaternionSNorm
+                    - 2.0 * this->optimizedBaseOrientation(j) / (quaternionSNorm * quaternionSNorm) * iDynTree::toEigen(inverseMap);
+            }
+
+        } else if (m_data.m_rotationParametrization == iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw) {
+            const iDynTree::Vector4& rpy = this->optimizedBaseOrientation;
+            iDynTree::Matrix3x3 RPYToOmega = iDynTree::Rotation::RPYRightTrivializedDerivative(rpy(0), rpy(1), rpy(2));
+            map = iDynTree::toEigen(RPYToOmega);
+
+            for (unsigned j = 0; j < 3; ++j) {
+                iDynTree::Vector3 element;
+                element.zero();
+                element(j) = 1.0;
+                iDynTree::Matrix3x3 RPYToOmegaDerivative = iDynTree::Rotation::RPYRightTrivializedDerivativeRateOfChange(rpy(0), rpy(1), rpy(2),
+                                                                                                                         element(0), element(1), element(2));
+                iDynTree::toEigen(baseOrientationMapDerivativesBuffer[j]) = iDynTree::toEigen(RPYToOmegaDerivative);
+            }
+        }
+    }
+
+    void InverseKinematicsNLP::computeAnalyticalJacobian(const iDynTree::MatrixDynSize& transformJacobianBuffer,
+                                                         iDynTree::MatrixDynSize& analyticalJacobianBuffer)
+    {
+        iDynTree::iDynTreeEigenConstMatrixMap frameJacobian = iDynTree::toEigen(transformJacobianBuffer);
+        iDynTree::iDynTreeEigenMatrixMap analyticalJacobian = iDynTree::toEigen(analyticalJacobianBuffer);
+        iDynTree::iDynTreeEigenMatrixMap map = iDynTree::toEigen(baseOrientationMapBuffer);
+
+        analyticalJacobian.leftCols<3>() = frameJacobian.leftCols<3>();
+        analyticalJacobian.middleCols(3, map.cols()) = frameJacobian.middleCols<3>(3) * map;
+        analyticalJacobian.rightCols(m_data.m_dofs) = frameJacobian.rightCols(m_data.m_dofs);
+    }
+
+    void InverseKinematicsNLP::addPointHessian(const iDynTree::MatrixDynSize& analyticalJacobianBuffer,
+                                               const iDynTree::Position& point,
+                                               const iDynTree::Vector3& weights,
+                                               Ipopt::Number* hessianValues)
+    {
+        iDynTree::iDynTreeEigenConstMatrixMap jacobian = iDynTree::toEigen(analyticalJacobianBuffer);
+        Eigen::Map<const Eigen::Vector3d> u = iDynTree::toEigen(weights);
+
+        Eigen::Index rotationSize = sizeOfRotationParametrization(m_data.m_rotationParametrization);
+        Eigen::Index baseSize = 3 + rotationSize;
+        Eigen::Vector3d basePointPosition = iDynTree::toEigen(point) - iDynTree::toEigen(optimizedBasePosition);
+
+        //Base position: the derivative of the point is constant.
+        //Base orientation: the derivative of the point is m_i x (p - p_b),
+        //where m_i is the column of the base orientation map
+        for (Eigen::Index i = 0; i < rotationSize; ++i) {
+            for (Eigen::Index j = 0; j <= i; ++j) {
+                Eigen::Vector3d mapColumnDerivative = iDynTree::toEigen(baseOrientationMapDerivativesBuffer[j]).col(i);
+                hessianValues[hessianEntry(3 + i, 3 + j)] += u.dot(mapColumnDerivative.cross(basePointPosition)
+                                                                   + jacobian.block<3, 1>(3, 3 + i).cross(jacobian.block<3, 1>(0, 3 + j)));
+            }
+        }
+
+        for (Eigen::Index dof = 0; dof < static_cast<Eigen::Index>(m_data.m_dofs); ++dof) {
+            //u^T (w_j x dp/dx_i) = w_j^T (dp/dx_i x u)
+            Eigen::Vector3d pointDerivativeCrossWeights = jacobian.block<3, 1>(0, baseSize + dof).cross(u);
+
+            //The base orientation moves all the joints
+            for (Eigen::Index i = 0; i < rotationSize; ++i) {
+                hessianValues[hessianEntry(baseSize + dof, 3 + i)] += jacobian.block<3, 1>(3, 3 + i).dot(pointDerivativeCrossWeights);
+            }
+
+            for (Eigen::Index ancestor = 0; ancestor < static_cast<Eigen::Index>(m_data.m_dofs); ++ancestor) {
+                if (!m_dofsAncestors[dof * m_data.m_dofs + ancestor]) continue;
+                hessianValues[hessianEntry(baseSize + std::max(dof, ancestor), baseSize + std::min(dof, ancestor))] +=
+                    jacobian.block<3, 1>(3, baseSize + ancestor).dot(pointDerivativeCrossWeights);
+            }
+        }
+    }
+
+    void InverseKinematicsNLP::addRotationHessian(const iDynTree::MatrixDynSize& analyticalJacobianBuffer,
+                                                  const iDynTree::Matrix3x3& angularCurvature,
+                                                  const iDynTree::Vector3& angularGradient,
+                                                  Ipopt::Number* hessianValues)
+    {
+        iDynTree::iDynTreeEigenConstMatrixMap jacobian = iDynTree::toEigen(analyticalJacobianBuffer);
+        Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> > T = iDynTree::toEigen(angularCurvature);
+        Eigen::Map<const Eigen::Vector3d> g = iDynTree::toEigen(angularGradient);
+
+        Eigen::Index rotationSize = sizeOfRotationParametrization(m_data.m_rotationParametrization);
+        Eigen::Index baseSize = 3 + rotationSize;
+
+        //The element (r, c) is the derivative w.r.t. x_c of the derivative w.r.t. x_r, i.e.
+        //w_c^T T w_r + g^T dw_r/dx_c. The angular velocities of two joints which are not
+        //on the same branch cannot be both nonzero, so only the entries of the pattern are needed.
+        for (size_t entry = 0; entry < m_hessianRows.size(); ++entry) {
+            if (m_hessianColumns[entry] < 3) continue;
+            hessianValues[entry] += jacobian.block<3, 1>(3, m_hessianColumns[entry]).dot(T * jacobian.block<3, 1>(3, m_hessianRows[entry]));
+        }
+
+        //Base orientation: the angular velocity is the column of the base orientation map
+        for (Eigen::Index i = 0; i < rotationSize; ++i) {
+            for (Eigen::Index j = 0; j <= i; ++j) {
+                hessianValues[hessianEntry(3 + i, 3 + j)] += g.dot(iDynTree::toEigen(baseOrientationMapDerivativesBuffer[j]).col(i));
+            }
+        }
+
+        //Joints: the axis of a joint is moved (only) by the base and by its ancestors
+        for (Eigen::Index dof = 0; dof < static_cast<Eigen::Index>(m_data.m_dofs); ++dof) {
+            Eigen::Vector3d omegaCrossGradient = jacobian.block<3, 1>(3, baseSize + dof).cross(g);
+            for (Eigen::Index i = 0; i < rotationSize; ++i) {
+                hessianValues[hessianEntry(baseSize + dof, 3 + i)] += jacobian.block<3, 1>(3, 3 + i).dot(omegaCrossGradient);
+            }
+
+            for (Eigen::Index ancestor = 0; ancestor < dof; ++ancestor) {
+                if (!m_dofsAncestors[dof * m_data.m_dofs + ancestor]) continue;
+                hessianValues[hessianEntry(baseSize + dof, baseSize + ancestor)] += jacobian.block<3, 1>(3, baseSize + ancestor).dot(omegaCrossGradient);
+            }
+        }
+    }
+
     void InverseKinematicsNLP::omegaToRPYParameters(const iDynTree::Vector3& rpyAngles,
                                                     iDynTree::Matrix3x3 &map)
     {
@@ -1557,8 +2131,8 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 //        }
 //
 
-
-        return true;
+        // Returning false asks the solver to stop
+        return !(m_data.m_stopRequest && m_data.m_stopRequest->load());
     }
 
     void InverseKinematicsNLP::testDerivatives(const iDynTree::VectorDynSize& derivativePoint, int frameIndex, double epsilon, double tolerance, int _parametrization)
@@ -1597,15 +2171,20 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
 
         if (parametrization == InverseKinematicsRotationParametrizationQuaternion) {
             iDynTree::MatrixFixSize<4, 3> quaternionDerivativeMapBuffer;
+            std::vector<size_t> allDofs(m_data.m_dofs);
+            for (size_t dof = 0; dof < allDofs.size(); ++dof) {
+                allDofs[dof] = dof;
+            }
             computeConstraintJacobian(dynTreeJacobian,
                                       quaternionDerivativeMapBuffer,
                                       quaternionDerivativeInverseMapBuffer,
                                       ComputeContraintJacobianOptionLinearPart|ComputeContraintJacobianOptionAngularPart,
+                                      allDofs,
                                       _analyticalJacobian);
         } else if (parametrization == InverseKinematicsRotationParametrizationRollPitchYaw) {
             analyticalJacobian = toEigen(dynTreeJacobian);
             iDynTree::Transform currentTransform = m_data.m_dynamics.getWorldTransform(frameIndex);
-            Vector3 rpy;
+            iDynTree::Vector3 rpy;
             currentTransform.getRotation().getRPY(rpy(0), rpy(1), rpy(2));
             std::cerr << "RPY\n" << rpy.toString() << "\n";
 
@@ -1642,12 +2221,12 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                 const iDynTree::Rotation& currentRotation = currentTransform.getRotation();
                 if (parametrization == InverseKinematicsRotationParametrizationQuaternion) {
                     //get quaternion
-                    Vector4 quaternion;
+                    iDynTree::Vector4 quaternion;
                     currentRotation.getQuaternion(quaternion);
                     positiveIncrement.tail<4>() = iDynTree::toEigen(quaternion);
                 } else if (parametrization == InverseKinematicsRotationParametrizationRollPitchYaw) {
                     //get quaternion
-                    Vector3 rpy;
+                    iDynTree::Vector3 rpy;
                     currentRotation.getRPY(rpy(0), rpy(1), rpy(2));
                     positiveIncrement.tail<3>() = iDynTree::toEigen(rpy);
                 }
@@ -1670,13 +2249,13 @@ void InverseKinematicsNLP::addSparsityInformationForConstraint(int constraintID,
                 const iDynTree::Rotation& currentRotation = currentTransform.getRotation();
                 if (parametrization == InverseKinematicsRotationParametrizationQuaternion) {
                     //get quaternion
-                    Vector4 quaternion;
+                    iDynTree::Vector4 quaternion;
                     currentRotation.getQuaternion(quaternion);
                     negativeIncrement.tail<4>() = iDynTree::toEigen(quaternion);
                     //                std::cerr << "Quat-:\t" << quaternion.toString() << "\n";
                 } else if (parametrization == InverseKinematicsRotationParametrizationRollPitchYaw) {
                     //get quaternion
-                    Vector3 rpy;
+                    iDynTree::Vector3 rpy;
                     currentRotation.getRPY(rpy(0), rpy(1), rpy(2));
                     negativeIncrement.tail<3>() = iDynTree::toEigen(rpy);
                 }
@@ -13,6 +13,11 @@
 #include <iDynTree/Core/Axis.h>
 #include <iDynTree/Core/TestUtils.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
 void testConvexHullProjectionConstraint()
 {
     // Check that given an "easy" problem the constraint works fine
@@ -130,10 +135,298 @@ void testConvexHullProjectionWithGravity()
 
 }
 
+double distanceBetweenPointAndSegment(const iDynTree::Vector2& point,
+                                      const iDynTree::Vector2& p0,
+                                      const iDynTree::Vector2& p1)
+{
+    double sideX = p1(0) - p0(0);
+    double sideY = p1(1) - p0(1);
+    double alongSide = ((point(0) - p0(0))*sideX + (point(1) - p0(1))*sideY)/(sideX*sideX + sideY*sideY);
+    alongSide = std::max(0.0, std::min(1.0, alongSide));
+    return std::hypot(point(0) - p0(0) - alongSide*sideX, point(1) - p0(1) - alongSide*sideY);
+}
+
+/**
+ * Signed distance of a point from the boundary of a counter-clockwise convex polygon,
+ * computed directly from its sides.
+ */
+double referenceMargin(const iDynTree::Polygon2D& hull, const iDynTree::Vector2& point)
+{
+    bool isInside = true;
+    double distance = 1e10;
+    for (size_t i = 0; i < hull.getNrOfVertices(); i++)
+    {
+        const iDynTree::Vector2& p0 = hull(i);
+        const iDynTree::Vector2& p1 = hull((i + 1) % hull.getNrOfVertices());
+        double cross = (p1(0) - p0(0))*(point(1) - p0(1)) - (p1(1) - p0(1))*(point(0) - p0(0));
+        isInside = isInside && cross >= 0;
+        distance = std::min(distance, distanceBetweenPointAndSegment(point, p0, p1));
+    }
+
+    return isInside ? distance : -distance;
+}
+
+void checkSameConvexHull(const iDynTree::ConvexHull2D& hull, const std::vector<iDynTree::Vector2>& points)
+{
+    iDynTree::ConvexHull2D rebuiltHull;
+    rebuiltHull.setPoints(points);
+
+    ASSERT_EQUAL_DOUBLE(hull.getNrOfPoints(), points.size());
+    ASSERT_EQUAL_DOUBLE(hull.getConvexHull().getNrOfVertices(), rebuiltHull.getConvexHull().getNrOfVertices());
+    for (size_t i = 0; i < hull.getConvexHull().getNrOfVertices(); i++)
+    {
+        ASSERT_EQUAL_VECTOR(hull.getConvexHull()(i), rebuiltHull.getConvexHull()(i));
+    }
+    ASSERT_EQUAL_MATRIX(hull.getHalfPlanesMatrix(), rebuiltHull.getHalfPlanesMatrix());
+    ASSERT_EQUAL_VECTOR(hull.getHalfPlanesVector(), rebuiltHull.getHalfPlanesVector());
+}
+
+void testIncrementalConvexHull()
+{
+    iDynTree::ConvexHull2D hull;
+    std::vector<iDynTree::Vector2> points;
+    std::vector<size_t> pointIDs;
+
+    // Add the points one at a time, checking that the hull is the same one obtained from scratch
+    for (size_t i = 0; i < 60; i++)
+    {
+        iDynTree::Vector2 point;
+        point(0) = iDynTree::getRandomDouble(-1.0, 1.0);
+        point(1) = iDynTree::getRandomDouble(-1.0, 1.0);
+        points.push_back(point);
+        pointIDs.push_back(hull.addPoint(point));
+        checkSameConvexHull(hull, points);
+    }
+    ASSERT_IS_TRUE(hull.isValid());
+
+    // The rows of the half planes matrix are the outward normals of the sides
+    for (size_t i = 0; i < hull.getConvexHull().getNrOfVertices(); i++)
+    {
+        ASSERT_EQUAL_DOUBLE(std::hypot(hull.getHalfPlanesMatrix()(i, 0), hull.getHalfPlanesMatrix()(i, 1)), 1.0);
+    }
+
+    // Remove the points in a random order, both vertices of the hull and internal points
+    for (size_t iteration = 0; points.size() > 3; iteration++)
+    {
+        size_t index = static_cast<size_t>(std::rand()) % points.size();
+        ASSERT_IS_TRUE(hull.removePoint(pointIDs[index]));
+        ASSERT_IS_FALSE(hull.removePoint(pointIDs[index]));
+        points.erase(points.begin() + index);
+        pointIDs.erase(pointIDs.begin() + index);
+        checkSameConvexHull(hull, points);
+
+        // The ids of the removed points can be reused
+        if (iteration % 4 == 0)
+        {
+            iDynTree::Vector2 point;
+            point(0) = iDynTree::getRandomDouble(-1.0, 1.0);
+            point(1) = iDynTree::getRandomDouble(-1.0, 1.0);
+            points.push_back(point);
+            pointIDs.push_back(hull.addPoint(point));
+            checkSameConvexHull(hull, points);
+        }
+    }
+
+    // Check the margins with respect to the distance from the sides
+    std::vector<iDynTree::Vector2> testPoints(100);
+    for (size_t i = 0; i < testPoints.size(); i++)
+    {
+        testPoints[i](0) = iDynTree::getRandomDouble(-2.0, 2.0);
+        testPoints[i](1) = iDynTree::getRandomDouble(-2.0, 2.0);
+    }
+
+    iDynTree::VectorDynSize margins;
+    hull.computeMargins(testPoints, margins);
+    ASSERT_EQUAL_DOUBLE(margins.size(), testPoints.size());
+    for (size_t i = 0; i < testPoints.size(); i++)
+    {
+        ASSERT_EQUAL_DOUBLE(hull.computeMargin(testPoints[i]), referenceMargin(hull.getConvexHull(), testPoints[i]));
+        ASSERT_EQUAL_DOUBLE(margins(i), hull.computeMargin(testPoints[i]));
+        ASSERT_IS_TRUE(hull.contains(testPoints[i]) == (margins(i) >= 0));
+    }
+
+    // The vertices are on the boundary
+    for (size_t i = 0; i < hull.getConvexHull().getNrOfVertices(); i++)
+    {
+        ASSERT_IS_TRUE(hull.contains(hull.getConvexHull()(i), 1e-10));
+    }
+
+    hull.clear();
+    ASSERT_IS_FALSE(hull.isValid());
+    ASSERT_EQUAL_DOUBLE(hull.getNrOfPoints(), 0);
+}
+
+void testBatchConvexHullUpdates()
+{
+    iDynTree::ConvexHull2D hull;
+    std::vector<iDynTree::Vector2> points(30);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        points[i](0) = iDynTree::getRandomDouble(-1.0, 1.0);
+        points[i](1) = iDynTree::getRandomDouble(-1.0, 1.0);
+    }
+
+    // Adding the points to an empty hull is the same as setting them
+    std::vector<size_t> pointIDs;
+    hull.addPoints(points, pointIDs);
+    ASSERT_EQUAL_DOUBLE(pointIDs.size(), points.size());
+    ASSERT_EQUAL_DOUBLE(hull.getNrOfPoints(), points.size());
+    checkSameConvexHull(hull, points);
+
+    // Remove all the vertices of the hull, together with some internal points
+    std::vector<size_t> removedPointIDs;
+    std::vector<iDynTree::Vector2> remainingPoints;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        bool isVertex = false;
+        for (size_t v = 0; v < hull.getConvexHull().getNrOfVertices(); v++)
+        {
+            isVertex = isVertex || (hull.getConvexHull()(v)(0) == points[i](0) && hull.getConvexHull()(v)(1) == points[i](1));
+        }
+
+        if (isVertex || i % 5 == 0)
+        {
+            removedPointIDs.push_back(pointIDs[i]);
+        }
+        else
+        {
+            remainingPoints.push_back(points[i]);
+        }
+    }
+    ASSERT_IS_TRUE(hull.removePoints(removedPointIDs));
+    ASSERT_EQUAL_DOUBLE(hull.getNrOfPoints(), remainingPoints.size());
+    checkSameConvexHull(hull, remainingPoints);
+
+    // The points were already removed
+    ASSERT_IS_FALSE(hull.removePoints(removedPointIDs));
+    ASSERT_EQUAL_DOUBLE(hull.getNrOfPoints(), remainingPoints.size());
+
+    // Add points to the valid hull, reusing the ids of the removed ones
+    std::vector<iDynTree::Vector2> newPoints(10);
+    for (size_t i = 0; i < newPoints.size(); i++)
+    {
+        newPoints[i](0) = iDynTree::getRandomDouble(-2.0, 2.0);
+        newPoints[i](1) = iDynTree::getRandomDouble(-2.0, 2.0);
+        remainingPoints.push_back(newPoints[i]);
+    }
+    hull.addPoints(newPoints, pointIDs);
+    ASSERT_EQUAL_DOUBLE(pointIDs.size(), newPoints.size());
+    checkSameConvexHull(hull, remainingPoints);
+}
+
+void testConvexHullProjectionContactChanges()
+{
+    iDynTree::ConvexHullProjectionConstraint projectionConstraint;
+
+    iDynTree::Polygon foot;
+    foot.m_vertices.push_back(iDynTree::Position( 0.1, 0.05, 0.0));
+    foot.m_vertices.push_back(iDynTree::Position(-0.1, 0.05, 0.0));
+    foot.m_vertices.push_back(iDynTree::Position(-0.1, -0.05, 0.0));
+    foot.m_vertices.push_back(iDynTree::Position( 0.1, -0.05, 0.0));
+
+    std::vector<iDynTree::Transform> footTransforms;
+    for (size_t i = 0; i < 4; i++)
+    {
+        iDynTree::Transform transform = iDynTree::Transform::Identity();
+        transform.setPosition(iDynTree::Position(iDynTree::getRandomDouble(-1.0, 1.0),
+                                                 iDynTree::getRandomDouble(-1.0, 1.0), 0.0));
+        footTransforms.push_back(transform);
+    }
+
+    iDynTree::Direction xAxis(1.0, 0.0, 0.0);
+    iDynTree::Direction yAxis(0.0, 1.0, 0.0);
+
+    // Sequence of supports: make and break the contacts, and move one foot
+    std::vector<std::vector<size_t> > contacts = {{0, 1}, {0}, {0, 2}, {0, 2, 3}, {2, 3}, {1}, {1, 3}, {0, 1, 2, 3}};
+    for (size_t step = 0; step < contacts.size(); step++)
+    {
+        if (step == 4)
+        {
+            footTransforms[3].setPosition(iDynTree::Position(0.5, 0.5, 0.0));
+        }
+
+        // Recomputing the transform of a foot gives the same points, up to the numerical noise
+        if (step == 6)
+        {
+            iDynTree::Position position = footTransforms[1].getPosition();
+            position(0) += 1e-14;
+            footTransforms[1].setPosition(position);
+        }
+
+        std::vector<iDynTree::Polygon> polygons;
+        std::vector<iDynTree::Transform> transforms;
+        for (size_t contact : contacts[step])
+        {
+            polygons.push_back(foot);
+            transforms.push_back(footTransforms[contact]);
+        }
+        ASSERT_IS_TRUE(projectionConstraint.buildConvexHull(xAxis, yAxis, iDynTree::Position::Zero(), polygons, transforms));
+
+        // The convex hull is the same one obtained from scratch
+        iDynTree::ConvexHullProjectionConstraint rebuiltConstraint;
+        ASSERT_IS_TRUE(rebuiltConstraint.buildConvexHull(xAxis, yAxis, iDynTree::Position::Zero(), polygons, transforms));
+        ASSERT_EQUAL_DOUBLE(projectionConstraint.projectedConvexHull.getNrOfVertices(),
+                            rebuiltConstraint.projectedConvexHull.getNrOfVertices());
+        for (size_t i = 0; i < projectionConstraint.projectedConvexHull.getNrOfVertices(); i++)
+        {
+            ASSERT_EQUAL_VECTOR(projectionConstraint.projectedConvexHull(i), rebuiltConstraint.projectedConvexHull(i));
+        }
+        ASSERT_EQUAL_MATRIX(projectionConstraint.A, rebuiltConstraint.A);
+        ASSERT_EQUAL_VECTOR(projectionConstraint.b, rebuiltConstraint.b);
+    }
+}
+
+void testBatchConvexHullProjectionMargins()
+{
+    iDynTree::ConvexHullProjectionConstraint projectionConstraint;
+
+    iDynTree::Polygon square;
+    square.m_vertices.push_back(iDynTree::Position( 1.0, 1.0, 0.0));
+    square.m_vertices.push_back(iDynTree::Position(-1.0, 1.0, 0.0));
+    square.m_vertices.push_back(iDynTree::Position(-1.0, -1.0, 0.0));
+    square.m_vertices.push_back(iDynTree::Position( 1.0, -1.0, 0.0));
+    std::vector<iDynTree::Polygon> polygons(1, square);
+    std::vector<iDynTree::Transform> transforms(1, iDynTree::Transform::Identity());
+
+    iDynTree::Direction xAxis(1, 0, 0);
+    iDynTree::Direction yAxis(0, 1, 0);
+    iDynTree::Position originPlane(0, 0, 0);
+    ASSERT_IS_TRUE(projectionConstraint.buildConvexHull(xAxis, yAxis, originPlane, polygons, transforms));
+
+    iDynTree::Vector3 gravity;
+    gravity(0) = 0.2;
+    gravity(1) = -0.1;
+    gravity(2) = -9.81;
+    projectionConstraint.setProjectionAlongDirection(gravity);
+
+    std::vector<iDynTree::Position> testPositions(50);
+    for (size_t i = 0; i < testPositions.size(); i++)
+    {
+        testPositions[i] = iDynTree::getRandomPosition();
+    }
+
+    std::vector<iDynTree::Vector2> projections;
+    projectionConstraint.projectAlongDirection(testPositions, projections);
+    iDynTree::VectorDynSize margins;
+    projectionConstraint.computeMargins(testPositions, margins);
+    ASSERT_EQUAL_DOUBLE(projections.size(), testPositions.size());
+    ASSERT_EQUAL_DOUBLE(margins.size(), testPositions.size());
+    for (size_t i = 0; i < testPositions.size(); i++)
+    {
+        iDynTree::Vector2 projection = projectionConstraint.projectAlongDirection(testPositions[i]);
+        ASSERT_EQUAL_VECTOR(projections[i], projection);
+        ASSERT_EQUAL_DOUBLE(margins(i), projectionConstraint.computeMargin(projection));
+    }
+}
+
 int main()
 {
     testConvexHullProjectionConstraint();
     testConvexHullProjectionWithGravity();
+    testIncrementalConvexHull();
+    testBatchConvexHullUpdates();
+    testConvexHullProjectionContactChanges();
+    testBatchConvexHullProjectionMargins();
 
     return EXIT_SUCCESS;
 }
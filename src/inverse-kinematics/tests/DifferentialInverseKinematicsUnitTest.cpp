@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2017 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/DifferentialInverseKinematics.h>
+#include <iDynTree/KinDynComputations.h>
+
+#include <iDynTree/Core/Transform.h>
+#include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Core/Twist.h>
+#include <iDynTree/Model/ModelTestUtils.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace iDynTree;
+
+/**
+ * Compute the pose of a frame of the model in a given configuration.
+ */
+Transform forwardKinematics(KinDynComputations& dynamics,
+                            const Transform& basePose,
+                            const VectorDynSize& jointPos,
+                            const std::string& frameName)
+{
+    Twist baseVel;
+    baseVel.zero();
+    VectorDynSize jointVel(jointPos.size());
+    jointVel.zero();
+    Vector3 gravity;
+    gravity.zero();
+    dynamics.setRobotState(basePose, jointPos, baseVel, jointVel, gravity);
+    return dynamics.getWorldTransform(frameName);
+}
+
+void getPerturbedJointPositions(const VectorDynSize& jointPos, double maxDelta, VectorDynSize& perturbed)
+{
+    perturbed = jointPos;
+    for (size_t i = 0; i < perturbed.size(); i++) {
+        perturbed(i) += getRandomDouble(-maxDelta, maxDelta);
+    }
+}
+
+/**
+ * Iterate the differential inverse kinematics on a fixed base chain,
+ * and check that the target reachable by the chain is obtained.
+ */
+void convergenceTest(const Model& model)
+{
+    KinDynComputations dynamics;
+    ASSERT_IS_TRUE(dynamics.loadRobotModel(model));
+
+    std::string endEffector = model.getLinkName(model.getNrOfLinks() - 1);
+    std::string base = model.getLinkName(model.getDefaultBaseLink());
+
+    Transform basePose = getRandomTransform();
+    VectorDynSize jointPos(model.getNrOfDOFs());
+    getRandomVector(jointPos, -1.0, 1.0);
+    VectorDynSize desiredJointPos;
+    getPerturbedJointPositions(jointPos, 0.2, desiredJointPos);
+    Transform target = forwardKinematics(dynamics, basePose, desiredJointPos, endEffector);
+
+    DifferentialInverseKinematics ik;
+    ASSERT_IS_TRUE(ik.setModel(model));
+    ASSERT_IS_TRUE(ik.setCurrentRobotConfiguration(basePose, jointPos));
+    ASSERT_IS_TRUE(ik.addFrameConstraint(base, basePose));
+    ASSERT_IS_TRUE(ik.addTarget(endEffector, target));
+    // A frame can have only one target
+    ASSERT_IS_FALSE(ik.addTarget(endEffector, target));
+    ASSERT_IS_TRUE(ik.isFrameConstraintActive(base));
+
+    Transform baseSolution;
+    VectorDynSize jointSolution;
+    for (int i = 0; i < 50; i++) {
+        ASSERT_IS_TRUE(ik.solve());
+        ik.getFullJointsSolution(baseSolution, jointSolution);
+        ASSERT_IS_TRUE(ik.setCurrentRobotConfiguration(baseSolution, jointSolution));
+    }
+
+    ASSERT_EQUAL_TRANSFORM_TOL(baseSolution, basePose, 1e-4);
+    ASSERT_EQUAL_TRANSFORM_TOL(forwardKinematics(dynamics, baseSolution, jointSolution, endEffector), target, 1e-4);
+
+    // Once converged, the step is zero
+    Twist baseVelocity;
+    VectorDynSize jointVelocities;
+    ASSERT_IS_TRUE(ik.solve());
+    ASSERT_IS_TRUE(ik.getVelocitySolution(0.01, baseVelocity, jointVelocities));
+    VectorDynSize zeros(model.getNrOfDOFs());
+    zeros.zero();
+    ASSERT_EQUAL_VECTOR_TOL(jointVelocities, zeros, 1e-2);
+}
+
+/**
+ * Check that each step keeps the joints within their limits.
+ */
+void jointLimitsTest(const Model& model)
+{
+    std::string endEffector = model.getLinkName(model.getNrOfLinks() - 1);
+
+    Transform basePose = Transform::Identity();
+    VectorDynSize jointPos(model.getNrOfDOFs());
+    getRandomVector(jointPos, -1.0, 1.0);
+
+    std::vector<std::pair<double, double> > limits(model.getNrOfDOFs());
+    for (size_t i = 0; i < limits.size(); i++) {
+        limits[i] = std::make_pair(jointPos(i) - 0.05, jointPos(i) + 0.05);
+    }
+
+    DifferentialInverseKinematics ik;
+    ASSERT_IS_TRUE(ik.setModel(model));
+    ASSERT_IS_TRUE(ik.setJointLimits(limits));
+    ASSERT_IS_TRUE(ik.setCurrentRobotConfiguration(basePose, jointPos));
+    ASSERT_IS_TRUE(ik.addFrameConstraint(model.getLinkName(model.getDefaultBaseLink()), basePose));
+    ASSERT_IS_TRUE(ik.addPositionTarget(endEffector, getRandomPosition()));
+
+    Transform baseSolution;
+    VectorDynSize jointSolution;
+    for (int i = 0; i < 10; i++) {
+        ASSERT_IS_TRUE(ik.solve());
+        ik.getFullJointsSolution(baseSolution, jointSolution);
+        for (size_t j = 0; j < limits.size(); j++) {
+            ASSERT_IS_TRUE(jointSolution(j) >= limits[j].first - 1e-3);
+            ASSERT_IS_TRUE(jointSolution(j) <= limits[j].second + 1e-3);
+        }
+        ASSERT_IS_TRUE(ik.setCurrentRobotConfiguration(baseSolution, jointSolution));
+    }
+}
+
+/**
+ * Check that a failure of the QP solver (infeasible problem or maximum number of iterations)
+ * is reported, and that the step computed by a previous call is not returned.
+ */
+void solverFailureTest(const Model& model)
+{
+    std::string endEffector = model.getLinkName(model.getNrOfLinks() - 1);
+
+    Transform basePose = Transform::Identity();
+    VectorDynSize jointPos(model.getNrOfDOFs());
+    getRandomVector(jointPos, -1.0, 1.0);
+
+    DifferentialInverseKinematics ik;
+    ASSERT_IS_TRUE(ik.setModel(model));
+    ASSERT_IS_TRUE(ik.setCurrentRobotConfiguration(basePose, jointPos));
+    ASSERT_IS_TRUE(ik.addFrameConstraint(model.getLinkName(model.getDefaultBaseLink()), basePose));
+    ASSERT_IS_TRUE(ik.addPositionTarget(endEffector, getRandomPosition()));
+    ASSERT_IS_TRUE(ik.solve());
+
+    // Lower limits greater than the upper ones make the QP infeasible
+    std::vector<std::pair<double, double> > limits(model.getNrOfDOFs());
+    for (size_t i = 0; i < limits.size(); i++) {
+        limits[i] = std::make_pair(jointPos(i) + 0.1, jointPos(i) - 0.1);
+    }
+    ASSERT_IS_TRUE(ik.setJointLimits(limits));
+    ASSERT_IS_FALSE(ik.solve());
+
+    Transform baseSolution;
+    VectorDynSize jointSolution;
+    ik.getFullJointsSolution(baseSolution, jointSolution);
+    ASSERT_EQUAL_TRANSFORM(baseSolution, basePose);
+    ASSERT_EQUAL_VECTOR(jointSolution, jointPos);
+
+    // Stopping at the maximum number of iterations, before the constraints are satisfied, is a failure too
+    DifferentialInverseKinematics limitedIk;
+    ASSERT_IS_TRUE(limitedIk.setModel(model));
+    ASSERT_IS_TRUE(limitedIk.setCurrentRobotConfiguration(basePose, jointPos));
+    ASSERT_IS_TRUE(limitedIk.addFrameConstraint(model.getLinkName(model.getDefaultBaseLink()), getRandomTransform()));
+    ASSERT_IS_TRUE(limitedIk.addTarget(endEffector, getRandomTransform()));
+    limitedIk.setMaxIterations(1);
+    ASSERT_IS_FALSE(limitedIk.solve());
+
+    limitedIk.getFullJointsSolution(baseSolution, jointSolution);
+    ASSERT_EQUAL_TRANSFORM(baseSolution, basePose);
+    ASSERT_EQUAL_VECTOR(jointSolution, jointPos);
+
+    // With enough iterations the same problem is solved
+    limitedIk.setMaxIterations(4000);
+    ASSERT_IS_TRUE(limitedIk.solve());
+}
+
+/**
+ * Track a slowly moving target, as in a control loop.
+ */
+void trackingTimeTest(const Model& model)
+{
+    KinDynComputations dynamics;
+    ASSERT_IS_TRUE(dynamics.loadRobotModel(model));
+
+    std::string base = model.getLinkName(model.getDefaultBaseLink());
+    std::vector<std::string> endEffectors;
+    for (unsigned i = 0; i < 4; i++) {
+        endEffectors.push_back(model.getLinkName(getRandomLinkIndexOfModel(model)));
+    }
+
+    Transform basePose = getRandomTransform();
+    VectorDynSize jointPos(model.getNrOfDOFs());
+    getRandomVector(jointPos, -1.0, 1.0);
+
+    DifferentialInverseKinematics ik;
+    ASSERT_IS_TRUE(ik.setModel(model));
+    ASSERT_IS_TRUE(ik.setCurrentRobotConfiguration(basePose, jointPos));
+    ASSERT_IS_TRUE(ik.addFrameConstraint(base, basePose));
+    for (const std::string& endEffector : endEffectors) {
+        if (endEffector != base) {
+            ik.addTarget(endEffector, forwardKinematics(dynamics, basePose, jointPos, endEffector));
+        }
+    }
+    ik.setDesiredFullJointsConfiguration(jointPos, 1e-3);
+
+    int nrOfSteps = 100;
+    double totalTime = 0.0;
+    VectorDynSize desiredJointPos;
+    Transform baseSolution;
+    VectorDynSize jointSolution;
+    for (int i = 0; i < nrOfSteps; i++) {
+        getPerturbedJointPositions(jointPos, 0.01, desiredJointPos);
+        for (const std::string& endEffector : endEffectors) {
+            if (endEffector != base) {
+                ik.updateTarget(endEffector, forwardKinematics(dynamics, basePose, desiredJointPos, endEffector));
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_IS_TRUE(ik.solve());
+        totalTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        ik.getFullJointsSolution(baseSolution, jointSolution);
+        ASSERT_IS_TRUE(ik.setCurrentRobotConfiguration(baseSolution, jointSolution));
+        jointPos = jointSolution;
+    }
+
+    std::printf("Differential IK with %d dofs: average solve time %f ms\n",
+                static_cast<int>(model.getNrOfDOFs()), 1e3 * totalTime / nrOfSteps);
+}
+
+int main()
+{
+    for (int i = 0; i < 5; i++) {
+        Model chain = getRandomChain(10, 0, true);
+        convergenceTest(chain);
+        jointLimitsTest(chain);
+    }
+
+    solverFailureTest(getRandomChain(10, 0, true));
+
+    trackingTimeTest(getRandomChain(40, 0, true));
+    trackingTimeTest(getRandomModel(40, 0));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2017 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/InverseKinematics.h>
+
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Model/ModelTestUtils.h>
+
+// Internal classes of the library, used to check the derivatives given to Ipopt
+#include "InverseKinematicsData.h"
+#include "InverseKinematicsNLP.h"
+#include "TransformConstraint.h"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+enum NLPDerivativesCoMMode {
+    NLPDerivativesCoMNone,
+    NLPDerivativesCoMAsCost,
+    NLPDerivativesCoMAsConstraint,
+    NLPDerivativesCoMAsCostWithConvexHull
+};
+
+/**
+ * Build the problem solved by Ipopt for a random model with a frame constraint, targets of all the
+ * types solved as targetResolutionMode, the posture cost and the center of mass target or the center of mass
+ * projection constraint, and compare the gradient of the cost, the Jacobian of the constraints and the Hessian
+ * of the Lagrangian with their finite differences.
+ */
+void checkNLPDerivatives(const iDynTree::InverseKinematicsRotationParametrization rotationParametrization,
+                         const iDynTree::InverseKinematicsTreatTargetAsConstraint targetResolutionMode,
+                         const NLPDerivativesCoMMode comMode)
+{
+    std::cerr << "~~~~~~~> checkNLPDerivatives(" << rotationParametrization << ", " << targetResolutionMode << ", " << comMode << ")" << std::endl;
+    iDynTree::Model model = iDynTree::getRandomModel(8, 6);
+    ASSERT_IS_TRUE(model.getNrOfFrames() >= 5);
+
+    internal::kinematics::InverseKinematicsData data;
+    ASSERT_IS_TRUE(data.setModel(model));
+    data.setRotationParametrization(rotationParametrization);
+
+    std::string constrainedFrame = model.getFrameName(model.getNrOfFrames() - 1);
+    ASSERT_IS_TRUE(data.addFrameConstraint(internal::kinematics::TransformConstraint::fullTransformConstraint(constrainedFrame, iDynTree::getRandomTransform())));
+
+    std::string fullTargetFrame = model.getFrameName(model.getNrOfFrames() - 2);
+    std::string positionTargetFrame = model.getFrameName(model.getNrOfFrames() - 3);
+    std::string rotationTargetFrame = model.getFrameName(model.getNrOfFrames() - 4);
+    ASSERT_IS_TRUE(data.addTarget(internal::kinematics::TransformConstraint::fullTransformConstraint(fullTargetFrame, iDynTree::getRandomTransform(), 2.0, 3.0)));
+    ASSERT_IS_TRUE(data.addTarget(internal::kinematics::TransformConstraint::positionConstraint(positionTargetFrame, iDynTree::getRandomPosition(), 1.2)));
+    ASSERT_IS_TRUE(data.addTarget(internal::kinematics::TransformConstraint::rotationConstraint(rotationTargetFrame, iDynTree::getRandomRotation(), 1.5)));
+    data.setTargetResolutionMode(data.getTargetRefIfItExists(fullTargetFrame), targetResolutionMode);
+    data.setTargetResolutionMode(data.getTargetRefIfItExists(positionTargetFrame), targetResolutionMode);
+    data.setTargetResolutionMode(data.getTargetRefIfItExists(rotationTargetFrame), targetResolutionMode);
+
+    iDynTree::getRandomVector(data.m_preferredJointsConfiguration);
+    iDynTree::toEigen(data.m_preferredJointsWeight).setConstant(0.7);
+
+    if (comMode != NLPDerivativesCoMNone) {
+        iDynTree::Position comTarget = iDynTree::getRandomPosition();
+        data.setCoMTarget(comTarget, 1.3);
+        data.setCoMasConstraint(comMode == NLPDerivativesCoMAsConstraint);
+    }
+
+    if (comMode == NLPDerivativesCoMAsCostWithConvexHull) {
+        // Same configuration of InverseKinematics::addCenterOfMassProjectionConstraint
+        data.m_comHullConstraint_supportFramesIndeces.assign(1, model.getFrameIndex(constrainedFrame));
+        data.m_comHullConstraint_supportPolygons.assign(1, iDynTree::Polygon::XYRectangleFromOffsets(0.1, 0.1, 0.1, 0.1));
+        data.m_comHullConstraint_xAxisOfPlaneInWorld = iDynTree::Direction(1.0, 0.0, 0.0);
+        data.m_comHullConstraint_yAxisOfPlaneInWorld = iDynTree::Direction(0.0, 1.0, 0.0);
+        data.m_comHullConstraint_originOfPlaneInWorld.zero();
+        data.m_comHullConstraint_projDirection = iDynTree::Direction(0.0, 0.0, 1.0);
+        data.m_comHullConstraint.setActive(true);
+    }
+
+    data.computeProblemSizeAndResizeBuffers();
+    data.prepareForOptimization();
+    internal::kinematics::InverseKinematicsNLP& nlp = *data.m_nlpProblem;
+
+    Ipopt::Index n, m, nnzJacobian, nnzHessian;
+    Ipopt::TNLP::IndexStyleEnum indexStyle;
+    ASSERT_IS_TRUE(nlp.get_nlp_info(n, m, nnzJacobian, nnzHessian, indexStyle));
+
+    std::vector<Ipopt::Index> jacobianRows(nnzJacobian), jacobianCols(nnzJacobian);
+    std::vector<Ipopt::Index> hessianRows(nnzHessian), hessianCols(nnzHessian);
+    ASSERT_IS_TRUE(nlp.eval_jac_g(n, nullptr, false, m, nnzJacobian, jacobianRows.data(), jacobianCols.data(), nullptr));
+    ASSERT_IS_TRUE(nlp.eval_h(n, nullptr, false, 1.0, m, nullptr, false, nnzHessian, hessianRows.data(), hessianCols.data(), nullptr));
+
+    // Random point, with a quaternion far from the unit norm, and random multipliers
+    Eigen::VectorXd x = Eigen::VectorXd::Random(n);
+    Eigen::VectorXd lambda = Eigen::VectorXd::Random(m);
+    const double objectiveFactor = 0.8;
+
+    // Gradient of the Lagrangian, i.e. objectiveFactor * grad f(x) + J_g(x)^T lambda
+    Eigen::VectorXd gradient(n), jacobianValues(nnzJacobian);
+    auto lagrangianGradient = [&](const Eigen::VectorXd& point) -> Eigen::VectorXd {
+        ASSERT_IS_TRUE(nlp.eval_grad_f(n, point.data(), true, gradient.data()));
+        ASSERT_IS_TRUE(nlp.eval_jac_g(n, point.data(), true, m, nnzJacobian, nullptr, nullptr, jacobianValues.data()));
+        Eigen::VectorXd result = objectiveFactor * gradient;
+        for (Ipopt::Index k = 0; k < nnzJacobian; ++k) {
+            result(jacobianCols[k]) += lambda(jacobianRows[k]) * jacobianValues(k);
+        }
+        return result;
+    };
+
+    const double step = 1e-6;
+
+    // The Jacobian is compared on the whole matrix, so that the nonzeros missing in its sparsity pattern are detected as well
+    Eigen::VectorXd costGradient(n);
+    ASSERT_IS_TRUE(nlp.eval_grad_f(n, x.data(), true, costGradient.data()));
+    ASSERT_IS_TRUE(nlp.eval_jac_g(n, x.data(), true, m, nnzJacobian, nullptr, nullptr, jacobianValues.data()));
+    Eigen::MatrixXd constraintsJacobian = Eigen::MatrixXd::Zero(m, n);
+    for (Ipopt::Index k = 0; k < nnzJacobian; ++k) {
+        constraintsJacobian(jacobianRows[k], jacobianCols[k]) += jacobianValues(k);
+    }
+
+    Eigen::VectorXd finiteDifferencesGradient(n);
+    Eigen::MatrixXd finiteDifferencesJacobian(m, n);
+    Eigen::VectorXd forwardConstraints(m), backwardConstraints(m);
+    for (Ipopt::Index i = 0; i < n; ++i) {
+        Eigen::VectorXd forward = x, backward = x;
+        forward(i) += step;
+        backward(i) -= step;
+        double forwardCost = 0, backwardCost = 0;
+        ASSERT_IS_TRUE(nlp.eval_f(n, forward.data(), true, forwardCost));
+        ASSERT_IS_TRUE(nlp.eval_f(n, backward.data(), true, backwardCost));
+        finiteDifferencesGradient(i) = (forwardCost - backwardCost) / (2 * step);
+        ASSERT_IS_TRUE(nlp.eval_g(n, forward.data(), true, m, forwardConstraints.data()));
+        ASSERT_IS_TRUE(nlp.eval_g(n, backward.data(), true, m, backwardConstraints.data()));
+        finiteDifferencesJacobian.col(i) = (forwardConstraints - backwardConstraints) / (2 * step);
+    }
+
+    double tolerance = 1e-5 * std::max(1.0, finiteDifferencesGradient.cwiseAbs().maxCoeff());
+    ASSERT_IS_TRUE((costGradient - finiteDifferencesGradient).cwiseAbs().maxCoeff() < tolerance);
+    if (m > 0) {
+        tolerance = 1e-5 * std::max(1.0, finiteDifferencesJacobian.cwiseAbs().maxCoeff());
+        ASSERT_IS_TRUE((constraintsJacobian - finiteDifferencesJacobian).cwiseAbs().maxCoeff() < tolerance);
+    }
+
+    Eigen::MatrixXd finiteDifferencesHessian(n, n);
+    for (Ipopt::Index i = 0; i < n; ++i) {
+        Eigen::VectorXd forward = x, backward = x;
+        forward(i) += step;
+        backward(i) -= step;
+        finiteDifferencesHessian.col(i) = (lagrangianGradient(forward) - lagrangianGradient(backward)) / (2 * step);
+    }
+
+    // Only the lower triangular part is given to Ipopt
+    Eigen::VectorXd hessianValues(nnzHessian);
+    ASSERT_IS_TRUE(nlp.eval_h(n, x.data(), true, objectiveFactor, m, lambda.data(), true, nnzHessian, nullptr, nullptr, hessianValues.data()));
+    Eigen::MatrixXd hessian = Eigen::MatrixXd::Zero(n, n);
+    for (Ipopt::Index k = 0; k < nnzHessian; ++k) {
+        ASSERT_IS_TRUE(hessianRows[k] >= hessianCols[k]);
+        hessian(hessianRows[k], hessianCols[k]) += hessianValues(k);
+        if (hessianRows[k] != hessianCols[k]) {
+            hessian(hessianCols[k], hessianRows[k]) += hessianValues(k);
+        }
+    }
+
+    tolerance = 1e-5 * std::max(1.0, finiteDifferencesHessian.cwiseAbs().maxCoeff());
+    ASSERT_IS_TRUE((hessian - finiteDifferencesHessian).cwiseAbs().maxCoeff() < tolerance);
+}
+
+int main()
+{
+    // Improve repetability (at least in the same platform)
+    srand(1);
+
+    // The center of mass target and the center of mass projection constraint support only the RPY parametrization
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw, iDynTree::InverseKinematicsTreatTargetAsConstraintNone, NLPDerivativesCoMAsCost);
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw, iDynTree::InverseKinematicsTreatTargetAsConstraintFull, NLPDerivativesCoMAsConstraint);
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw, iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly, NLPDerivativesCoMAsCostWithConvexHull);
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw, iDynTree::InverseKinematicsTreatTargetAsConstraintRotationOnly, NLPDerivativesCoMNone);
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationQuaternion, iDynTree::InverseKinematicsTreatTargetAsConstraintNone, NLPDerivativesCoMNone);
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationQuaternion, iDynTree::InverseKinematicsTreatTargetAsConstraintFull, NLPDerivativesCoMNone);
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationQuaternion, iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly, NLPDerivativesCoMNone);
+    checkNLPDerivatives(iDynTree::InverseKinematicsRotationParametrizationQuaternion, iDynTree::InverseKinematicsTreatTargetAsConstraintRotationOnly, NLPDerivativesCoMNone);
+
+    return EXIT_SUCCESS;
+}
@@ -8,9 +8,16 @@
  * at your option.
  */
 
+//For using the M_PI macro in visual studio it
+//is necessary to define _USE_MATH_DEFINES
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+
 #include <iDynTree/InverseKinematics.h>
 #include <iDynTree/KinDynComputations.h>
 
+#include <iDynTree/Core/MatrixDynSize.h>
 #include <iDynTree/Core/Transform.h>
 #include <iDynTree/Core/TestUtils.h>
 #include <iDynTree/Model/JointState.h>
@@ -19,6 +26,7 @@
 
 #include "testModels.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -87,14 +95,15 @@ struct simpleChainIKOptions
     bool useDesiredJointPositionsToRandomValue;
 };
 
-void simpleChainIK(int minNrOfJoints, int maxNrOfJoints, const iDynTree::InverseKinematicsRotationParametrization rotationParametrization)
+void simpleChainIK(int minNrOfJoints, int maxNrOfJoints, const iDynTree::InverseKinematicsRotationParametrization rotationParametrization,
+                   bool useApproximatedHessians = true)
 {
     // Solve a simple IK problem for a chain, with no constraints
     for (int i = minNrOfJoints; i <= maxNrOfJoints; i++)
     {
         assert(i >= 2);
 
-        std::cerr << "~~~~~~~> simpleChainIK with " << i << " dofs " << std::endl;
+        std::cerr << "~~~~~~~> simpleChainIK with " << i << " dofs" << (useApproximatedHessians ? "" : " and the exact Hessian") << std::endl;
         bool noFixedJoints = true;
         iDynTree::Model chain = iDynTree::getRandomChain(i, 10, noFixedJoints);
 
@@ -117,6 +126,11 @@ void simpleChainIK(int minNrOfJoints, int maxNrOfJoints, const iDynTree::Inverse
         ik.setCostTolerance(1e-6);
         ik.setConstraintsTolerance(1e-7);
 
+        // The limited-memory approximation of the Hessian is the default
+        ASSERT_IS_TRUE(ik.usesApproximatedHessians());
+        ik.useApproximatedHessians(useApproximatedHessians);
+        ASSERT_IS_TRUE(ik.usesApproximatedHessians() == useApproximatedHessians);
+
         // Create also a KinDyn object to perform forward kinematics for the desired values and the optimized ones
         iDynTree::KinDynComputations kinDynDes;
         ok = kinDynDes.loadRobotModel(ik.fullModel());
@@ -623,12 +637,325 @@ void COMConvexHullConstraintWithSwitchingConstraints()
 
 }
 
+void multiStartChainIK(const iDynTree::InverseKinematicsRotationParametrization rotationParametrization)
+{
+    // Solve a position target for a redundant chain from multiple initial conditions
+    std::cerr << "~~~~~~~> multiStartChainIK" << std::endl;
+    iDynTree::Model chain = iDynTree::getRandomChain(4, 10, true);
+    std::string targetFrame = "link3";
+
+    iDynTree::InverseKinematics ik;
+    ik.setVerbosity(0);
+    ASSERT_IS_TRUE(ik.setModel(chain));
+    ik.setRotationParametrization(rotationParametrization);
+    ik.setCostTolerance(1e-6);
+
+    iDynTree::KinDynComputations kinDyn;
+    ASSERT_IS_TRUE(kinDyn.loadRobotModel(ik.fullModel()));
+    iDynTree::JointPosDoubleArray s = getRandomJointPositions(kinDyn.model());
+    ASSERT_IS_TRUE(kinDyn.setJointPos(s));
+
+    ASSERT_IS_TRUE(ik.addFrameConstraint("baseLink", kinDyn.getWorldTransform("baseLink")));
+    iDynTree::Position targetPosition = kinDyn.getWorldTransform(targetFrame).getPosition();
+    ASSERT_IS_TRUE(ik.addPositionTarget(targetFrame, targetPosition));
+
+    iDynTree::InverseKinematicsMultiStartOptions options;
+    options.jointsSeeds.push_back(s);
+    options.nrOfRandomSeeds = 7;
+    options.nrOfThreads = 4;
+    ASSERT_IS_TRUE(ik.solveMultiStart(options));
+    ASSERT_IS_TRUE(ik.getNrOfMultiStartSolutions() >= 1);
+
+    // The solutions are sorted by cost, and the best one is the solution of the problem
+    iDynTree::Transform baseOpt, baseBest;
+    iDynTree::VectorDynSize sOpt(chain.getNrOfDOFs()), sBest(chain.getNrOfDOFs());
+    double cost = 0, previousCost = 0;
+    for (size_t i = 0; i < ik.getNrOfMultiStartSolutions(); i++) {
+        ASSERT_IS_TRUE(ik.getMultiStartSolution(i, baseOpt, sOpt, cost));
+        ASSERT_IS_TRUE(i == 0 || cost >= previousCost);
+        previousCost = cost;
+    }
+    ASSERT_IS_FALSE(ik.getMultiStartSolution(ik.getNrOfMultiStartSolutions(), baseOpt, sOpt, cost));
+
+    ASSERT_IS_TRUE(ik.getMultiStartSolution(0, baseBest, sBest, cost));
+    ik.getFullJointsSolution(baseOpt, sOpt);
+    ASSERT_EQUAL_VECTOR(sOpt, sBest);
+    ASSERT_EQUAL_DOUBLE(ik.lastSolveCost(), cost);
+
+    iDynTree::Twist dummyVel;
+    dummyVel.zero();
+    iDynTree::Vector3 dummyGrav;
+    dummyGrav.zero();
+    iDynTree::JointDOFsDoubleArray dummyJointVel(ik.fullModel());
+    dummyJointVel.zero();
+    kinDyn.setRobotState(baseOpt, sOpt, dummyVel, dummyJointVel, dummyGrav);
+    ASSERT_EQUAL_VECTOR_TOL(kinDyn.getWorldTransform(targetFrame).getPosition(), targetPosition, 1e-3);
+
+    // With a cost threshold and a single thread, the search stops at the first initial condition, that is already a solution
+    options.costThreshold = 1e-3;
+    options.nrOfThreads = 1;
+    ASSERT_IS_TRUE(ik.solveMultiStart(options));
+    ASSERT_EQUAL_DOUBLE(ik.getNrOfMultiStartSolutions(), 1);
+}
+
+void trajectoryChainIK(const iDynTree::InverseKinematicsRotationParametrization rotationParametrization)
+{
+    // Solve the targets obtained from a smooth joints trajectory, splitting it in segments solved in parallel
+    std::cerr << "~~~~~~~> trajectoryChainIK" << std::endl;
+    iDynTree::Model chain = iDynTree::getRandomChain(6, 10, true);
+    std::string targetFrame = chain.getLinkName(chain.getNrOfLinks() - 1);
+
+    iDynTree::InverseKinematics ik;
+    ik.setVerbosity(0);
+    ASSERT_IS_TRUE(ik.setModel(chain));
+    ik.setRotationParametrization(rotationParametrization);
+    ik.setCostTolerance(1e-6);
+
+    iDynTree::KinDynComputations kinDyn;
+    ASSERT_IS_TRUE(kinDyn.loadRobotModel(ik.fullModel()));
+    iDynTree::JointPosDoubleArray s = getRandomJointPositions(kinDyn.model());
+    iDynTree::JointPosDoubleArray sFinal = getRandomJointPositionsCloseTo(kinDyn.model(), s, 0.5);
+    ASSERT_IS_TRUE(kinDyn.setJointPos(s));
+    iDynTree::Transform basePose = kinDyn.getWorldTransform("baseLink");
+
+    ASSERT_IS_TRUE(ik.addFrameConstraint("baseLink", basePose));
+    ASSERT_IS_TRUE(ik.addTarget(targetFrame, kinDyn.getWorldTransform(targetFrame)));
+    ASSERT_IS_TRUE(ik.setFullJointsInitialCondition(&basePose, &s));
+
+    size_t nrOfTimeFrames = 40;
+    std::vector<std::string> targetFrames(1, targetFrame);
+    std::vector<std::vector<iDynTree::Transform> > targetValues(1);
+    iDynTree::JointPosDoubleArray sTrajectory(kinDyn.model());
+    for (size_t k = 0; k < nrOfTimeFrames; k++) {
+        double alpha = 0.5 * (1 - std::cos(M_PI * k / (nrOfTimeFrames - 1)));
+        for (size_t j = 0; j < s.size(); j++) {
+            sTrajectory(j) = (1 - alpha) * s(j) + alpha * sFinal(j);
+        }
+        ASSERT_IS_TRUE(kinDyn.setJointPos(sTrajectory));
+        targetValues[0].push_back(kinDyn.getWorldTransform(targetFrame));
+    }
+
+    iDynTree::InverseKinematicsTrajectoryOptions options;
+    options.nrOfSegments = 4;
+    options.nrOfThreads = 2;
+    iDynTree::MatrixDynSize jointsTrajectory;
+    std::vector<iDynTree::Transform> baseTrajectory;
+    std::vector<bool> convergedFrames;
+    ASSERT_IS_TRUE(ik.solveTrajectory(targetFrames, targetValues, jointsTrajectory, baseTrajectory, convergedFrames, options));
+    ASSERT_IS_TRUE(ik.lastSolveConverged());
+    ASSERT_EQUAL_DOUBLE(convergedFrames.size(), nrOfTimeFrames);
+    for (size_t k = 0; k < nrOfTimeFrames; k++) {
+        ASSERT_IS_TRUE(convergedFrames[k]);
+    }
+    ASSERT_EQUAL_DOUBLE(jointsTrajectory.rows(), nrOfTimeFrames);
+    ASSERT_EQUAL_DOUBLE(jointsTrajectory.cols(), chain.getNrOfDOFs());
+    ASSERT_EQUAL_DOUBLE(baseTrajectory.size(), nrOfTimeFrames);
+
+    iDynTree::Twist dummyVel;
+    dummyVel.zero();
+    iDynTree::Vector3 dummyGrav;
+    dummyGrav.zero();
+    iDynTree::JointDOFsDoubleArray dummyJointVel(ik.fullModel());
+    dummyJointVel.zero();
+    for (size_t k = 0; k < nrOfTimeFrames; k++) {
+        for (size_t j = 0; j < sTrajectory.size(); j++) {
+            sTrajectory(j) = jointsTrajectory(k, j);
+        }
+        kinDyn.setRobotState(baseTrajectory[k], sTrajectory, dummyVel, dummyJointVel, dummyGrav);
+        ASSERT_EQUAL_TRANSFORM_TOL(kinDyn.getWorldTransform("baseLink"), basePose, 1e-3);
+        ASSERT_EQUAL_TRANSFORM_TOL(kinDyn.getWorldTransform(targetFrame), targetValues[0][k], 1e-3);
+    }
+
+    // The solution of the object is the one of the last time frame
+    iDynTree::Transform baseOpt;
+    iDynTree::VectorDynSize sOpt(chain.getNrOfDOFs());
+    ik.getFullJointsSolution(baseOpt, sOpt);
+    ASSERT_EQUAL_VECTOR(sOpt, sTrajectory);
+
+    // With the smoothness cost, the targets are still tracked (without asking the convergence of each time frame)
+    options.smoothnessWeight = 1e-3;
+    ASSERT_IS_TRUE(ik.solveTrajectory(targetFrames, targetValues, jointsTrajectory, baseTrajectory, options));
+    for (size_t k = 0; k < nrOfTimeFrames; k++) {
+        for (size_t j = 0; j < sTrajectory.size(); j++) {
+            sTrajectory(j) = jointsTrajectory(k, j);
+        }
+        kinDyn.setRobotState(baseTrajectory[k], sTrajectory, dummyVel, dummyJointVel, dummyGrav);
+        ASSERT_EQUAL_VECTOR_TOL(kinDyn.getWorldTransform(targetFrame).getPosition(), targetValues[0][k].getPosition(), 1e-2);
+    }
+
+    // Targets and values must be consistent
+    targetValues[0].pop_back();
+    targetFrames.push_back(targetFrame);
+    targetValues.push_back(std::vector<iDynTree::Transform>(nrOfTimeFrames));
+    ASSERT_IS_FALSE(ik.solveTrajectory(targetFrames, targetValues, jointsTrajectory, baseTrajectory, convergedFrames, options));
+}
+
+void trackingModeChainIK()
+{
+    // Stream target values to a problem solved in tracking mode, changing the parameters
+    // and the structure of the problem between the solves
+    std::cerr << "~~~~~~~> trackingModeChainIK" << std::endl;
+    iDynTree::Model chain = iDynTree::getRandomChain(6, 10, true);
+    std::string targetFrame = chain.getLinkName(chain.getNrOfLinks() - 1);
+
+    iDynTree::InverseKinematics ik;
+    ik.setVerbosity(0);
+    ASSERT_IS_TRUE(ik.setModel(chain));
+    ik.setRotationParametrization(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw);
+    ik.setCostTolerance(1e-6);
+    ik.useTrackingMode();
+    ASSERT_IS_TRUE(ik.usesTrackingMode());
+
+    iDynTree::KinDynComputations kinDyn;
+    ASSERT_IS_TRUE(kinDyn.loadRobotModel(ik.fullModel()));
+    iDynTree::JointPosDoubleArray s = getRandomJointPositions(kinDyn.model());
+    ASSERT_IS_TRUE(kinDyn.setJointPos(s));
+    iDynTree::Transform basePose = kinDyn.getWorldTransform("baseLink");
+    iDynTree::Transform targetValue = kinDyn.getWorldTransform(targetFrame);
+
+    ASSERT_IS_TRUE(ik.addFrameConstraint("baseLink", basePose));
+    ASSERT_IS_TRUE(ik.addTarget(targetFrame, targetValue));
+    ASSERT_IS_TRUE(ik.setFullJointsInitialCondition(&basePose, &s));
+    ASSERT_IS_TRUE(ik.solve());
+    ASSERT_IS_TRUE(ik.lastSolveConverged());
+
+    iDynTree::Twist dummyVel;
+    dummyVel.zero();
+    iDynTree::Vector3 dummyGrav;
+    dummyGrav.zero();
+    iDynTree::JointDOFsDoubleArray dummyJointVel(ik.fullModel());
+    dummyJointVel.zero();
+    iDynTree::Transform baseOpt;
+    iDynTree::JointPosDoubleArray sOpt(kinDyn.model());
+    iDynTree::JointPosDoubleArray sTarget = s;
+
+    // Move the target to the pose of the frame in a random configuration close to the one of the last target
+    auto updateTarget = [&](double maxDelta) {
+        sTarget = getRandomJointPositionsCloseTo(kinDyn.model(), sTarget, maxDelta);
+        ASSERT_IS_TRUE(kinDyn.setRobotState(basePose, sTarget, dummyVel, dummyJointVel, dummyGrav));
+        targetValue = kinDyn.getWorldTransform(targetFrame);
+        ASSERT_IS_TRUE(ik.updateTarget(targetFrame, targetValue));
+    };
+
+    auto checkSolution = [&](double tol) {
+        ik.getFullJointsSolution(baseOpt, sOpt);
+        ASSERT_IS_TRUE(kinDyn.setRobotState(baseOpt, sOpt, dummyVel, dummyJointVel, dummyGrav));
+        ASSERT_EQUAL_TRANSFORM_TOL(kinDyn.getWorldTransform(targetFrame), targetValue, tol);
+    };
+
+    // Each solve starts from the last solution, and the solver reuses the structure of the problem
+    for (size_t k = 0; k < 10; k++) {
+        updateTarget(0.05);
+        ASSERT_IS_TRUE(ik.solve());
+        ASSERT_IS_TRUE(ik.lastSolveConverged());
+        ASSERT_IS_TRUE(ik.lastSolveIterations() > 0);
+        ASSERT_IS_TRUE(ik.lastSolveIterations() <= ik.maxIterations());
+        checkSolution(1e-3);
+    }
+
+    // The maximum number of iterations is applied also after the first solve.
+    // In tracking mode the last iterate is accepted as solution
+    ik.setMaxIterations(1);
+    ASSERT_EQUAL_DOUBLE(ik.maxIterations(), 1);
+    updateTarget(1.0);
+    ASSERT_IS_TRUE(ik.solve());
+    ASSERT_IS_TRUE(ik.lastSolveIterations() <= 1);
+    ASSERT_IS_FALSE(ik.lastSolveConverged());
+
+    ik.setMaxIterations(3000);
+    ASSERT_IS_TRUE(ik.solve());
+    ASSERT_IS_TRUE(ik.lastSolveConverged());
+    ASSERT_IS_TRUE(ik.lastSolveIterations() > 1);
+    checkSolution(1e-3);
+
+    // Changing the resolution mode of the target rebuilds the problem, that now has the target constraints
+    ASSERT_IS_TRUE(ik.setTargetResolutionMode(targetFrame, iDynTree::InverseKinematicsTreatTargetAsConstraintFull));
+    updateTarget(0.2);
+    ASSERT_IS_TRUE(ik.solve());
+    ASSERT_IS_TRUE(ik.lastSolveConverged());
+    checkSolution(1e-3);
+
+    // Changing the rotation parametrization rebuilds the problem, that now has a different number of variables.
+    // The base is left free, as the quaternion constraint on the base is redundant with the constraint on its norm
+    ASSERT_IS_TRUE(ik.setTargetResolutionMode(targetFrame, iDynTree::InverseKinematicsTreatTargetAsConstraintNone));
+    ASSERT_IS_TRUE(ik.deactivateFrameConstraint("baseLink"));
+    ik.setRotationParametrization(iDynTree::InverseKinematicsRotationParametrizationQuaternion);
+    updateTarget(0.2);
+    ASSERT_IS_TRUE(ik.solve());
+    checkSolution(1e-3);
+
+    ik.setRotationParametrization(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw);
+    updateTarget(0.2);
+    ASSERT_IS_TRUE(ik.solve());
+    ASSERT_IS_TRUE(ik.lastSolveConverged());
+    checkSolution(1e-3);
+}
+
+void targetResolutionModesChainIK(const iDynTree::InverseKinematicsTreatTargetAsConstraint targetResolutionMode,
+                                  bool useApproximatedHessians)
+{
+    // Solve for full, position and rotation targets on different links of a chain, all taken from the same
+    // configuration, so that the gradient of the cost and the Jacobian of the constraints given to the solver
+    // are used for all the kinds of targets and resolution modes
+    std::cerr << "~~~~~~~> targetResolutionModesChainIK(" << targetResolutionMode << ", " << useApproximatedHessians << ")" << std::endl;
+    iDynTree::Model chain = iDynTree::getRandomChain(8, 10, true);
+    std::string fullTargetFrame = chain.getLinkName(chain.getNrOfLinks() - 1);
+    std::string positionTargetFrame = chain.getLinkName(chain.getNrOfLinks() - 3);
+    std::string rotationTargetFrame = chain.getLinkName(chain.getNrOfLinks() - 5);
+
+    iDynTree::InverseKinematics ik;
+    ik.setVerbosity(0);
+    ASSERT_IS_TRUE(ik.setModel(chain));
+    ik.setRotationParametrization(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw);
+    ik.setDefaultTargetResolutionMode(targetResolutionMode);
+    ik.useApproximatedHessians(useApproximatedHessians);
+    ik.setCostTolerance(1e-6);
+    ik.setConstraintsTolerance(1e-7);
+
+    iDynTree::KinDynComputations kinDynDes;
+    ASSERT_IS_TRUE(kinDynDes.loadRobotModel(ik.fullModel()));
+    iDynTree::JointPosDoubleArray s = getRandomJointPositions(kinDynDes.model());
+    ASSERT_IS_TRUE(kinDynDes.setJointPos(s));
+    iDynTree::Transform basePose = kinDynDes.getWorldTransform("baseLink");
+
+    ASSERT_IS_TRUE(ik.addFrameConstraint("baseLink", basePose));
+    ASSERT_IS_TRUE(ik.addTarget(fullTargetFrame, kinDynDes.getWorldTransform(fullTargetFrame)));
+    ASSERT_IS_TRUE(ik.addPositionTarget(positionTargetFrame, kinDynDes.getWorldTransform(positionTargetFrame).getPosition()));
+    ASSERT_IS_TRUE(ik.addRotationTarget(rotationTargetFrame, kinDynDes.getWorldTransform(rotationTargetFrame).getRotation()));
+
+    iDynTree::JointPosDoubleArray sInitial = getRandomJointPositionsCloseTo(ik.fullModel(), s, 0.05);
+    ASSERT_IS_TRUE(ik.setFullJointsInitialCondition(&basePose, &sInitial));
+    ASSERT_IS_TRUE(ik.solve());
+
+    iDynTree::Transform baseOpt;
+    iDynTree::JointPosDoubleArray sOpt(ik.fullModel());
+    ik.getFullJointsSolution(baseOpt, sOpt);
+    iDynTree::KinDynComputations kinDynOpt;
+    ASSERT_IS_TRUE(kinDynOpt.loadRobotModel(ik.fullModel()));
+    iDynTree::Twist dummyVel;
+    dummyVel.zero();
+    iDynTree::Vector3 dummyGrav;
+    dummyGrav.zero();
+    iDynTree::JointDOFsDoubleArray dummyJointVel(ik.fullModel());
+    dummyJointVel.zero();
+    ASSERT_IS_TRUE(kinDynOpt.setRobotState(baseOpt, sOpt, dummyVel, dummyJointVel, dummyGrav));
+
+    double tolTargets = 1e-3;
+    ASSERT_EQUAL_TRANSFORM_TOL(kinDynOpt.getWorldTransform("baseLink"), basePose, 1e-6);
+    ASSERT_EQUAL_TRANSFORM_TOL(kinDynOpt.getWorldTransform(fullTargetFrame), kinDynDes.getWorldTransform(fullTargetFrame), tolTargets);
+    ASSERT_EQUAL_VECTOR_TOL(kinDynOpt.getWorldTransform(positionTargetFrame).getPosition(),
+                            kinDynDes.getWorldTransform(positionTargetFrame).getPosition(), tolTargets);
+    ASSERT_EQUAL_MATRIX_TOL(kinDynOpt.getWorldTransform(rotationTargetFrame).getRotation(),
+                            kinDynDes.getWorldTransform(rotationTargetFrame).getRotation(), tolTargets);
+}
+
 int main()
 {
     // Improve repetability (at least in the same platform)
     srand(1);
 
     simpleChainIK(2, 13, iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw);
+    simpleChainIK(2, 13, iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw, false);
 
     // This is not working at the moment, there is some problem with quaternion constraints
     //simpleChainIK(10,iDynTree::InverseKinematicsRotationParametrizationQuaternion);
@@ -644,6 +971,22 @@ int main()
 
     COMConvexHullConstraintWithSwitchingConstraints();
 
+    multiStartChainIK(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw);
+
+    trajectoryChainIK(iDynTree::InverseKinematicsRotationParametrizationRollPitchYaw);
+
+    trackingModeChainIK();
+
+    const iDynTree::InverseKinematicsTreatTargetAsConstraint targetResolutionModes[] = {
+        iDynTree::InverseKinematicsTreatTargetAsConstraintNone,
+        iDynTree::InverseKinematicsTreatTargetAsConstraintPositionOnly,
+        iDynTree::InverseKinematicsTreatTargetAsConstraintRotationOnly,
+        iDynTree::InverseKinematicsTreatTargetAsConstraintFull
+    };
+    for (iDynTree::InverseKinematicsTreatTargetAsConstraint targetResolutionMode : targetResolutionModes) {
+        targetResolutionModesChainIK(targetResolutionMode, true);
+        targetResolutionModesChainIK(targetResolutionMode, false);
+    }
 
     return EXIT_SUCCESS;
 }
@@ -12,11 +12,14 @@
 #define IDYNTREE_INVERSE_DYNAMICS_H
 
 #include <iDynTree/Core/MatrixDynSize.h>
+#include <iDynTree/Core/VectorFixSize.h>
 
 #include <iDynTree/Model/Indices.h>
 #include <iDynTree/Model/LinkState.h>
 #include <iDynTree/Model/JointState.h>
 
+#include <vector>
+
 namespace iDynTree
 {
     class Model;
@@ -160,6 +163,67 @@ namespace iDynTree
                                         ArticulatedBodyAlgorithmInternalBuffers & buffers,
                                         FreeFloatingAcc & robotAcc);
 
+    /**
+     * Structure of buffers required by ComputeGravityGeneralizedForces.
+     *
+     * A convenient resize(Model) function is provided to automatically resize
+     * the buffers given a Model.
+     */
+    struct GravityGeneralizedForcesInternalBuffers
+    {
+        GravityGeneralizedForcesInternalBuffers() {};
+
+        /**
+         * Call resize(model);
+         */
+        GravityGeneralizedForcesInternalBuffers(const Model & model);
+
+        /**
+         * Resize all the buffers to the right size given the model.
+         */
+        void resize(const Model& model);
+
+        /**
+         * Check if the dimension of the buffer is consistent
+         * with a model (it should be after a call to resize(model) ).
+         */
+        bool isConsistent(const Model& model) const;
+
+        LinkPositions parent_H_link;
+        std::vector<double> subtreeMass;
+        std::vector<Vector3> subtreeFirstMomentOfMass;
+        std::vector<Vector3> linksProperLinearAcc;
+    };
+
+    /**
+     * \ingroup iDynTreeModel
+     *
+     * @brief Compute the generalized gravity forces, i.e. the inverse dynamics with zero velocities and accelerations.
+     *
+     * The result is the same of running iDynTree::RNEADynamicPhase with zero link velocities and with
+     * the proper accelerations due to gravity, but only the mass and the first moment of mass of
+     * each subtree are propagated from the leaves to the base, without computing any spatial velocity
+     * or product with the full spatial inertias.
+     *
+     * @param[in] model The model used for the computation.
+     * @param[in] traversal The traversal used for the computation, it defines the used base link.
+     * @param[in] jointPos The (internal) joint position of the model.
+     * @param[in] referenceLink Link in which the proper acceleration is specified.
+     * @param[in] referenceLinkProperLinearAcc Proper linear acceleration (i.e. minus the gravity acceleration)
+     *                                         of the reference link, expressed in the reference link frame.
+     * @param[in] buffers Internal buffers, they need to be consistent with the model.
+     * @param[out] baseForceAndJointTorques Generalized gravity forces. The base element is expressed in the base link frame,
+     *                                      consistently with iDynTree::RNEADynamicPhase.
+     * @return true if all went well, false otherwise.
+     */
+    bool ComputeGravityGeneralizedForces(const iDynTree::Model & model,
+                                         const iDynTree::Traversal & traversal,
+                                         const iDynTree::JointPosDoubleArray & jointPos,
+                                         const iDynTree::LinkIndex referenceLink,
+                                         const iDynTree::Vector3 & referenceLinkProperLinearAcc,
+                                               GravityGeneralizedForcesInternalBuffers & buffers,
+                                               iDynTree::FreeFloatingGeneralizedTorques & baseForceAndJointTorques);
+
     /**
      * \ingroup iDynTreeModel
      *
@@ -22,6 +22,7 @@
 #include <iDynTree/Core/SpatialInertia.h>
 #include <iDynTree/Core/SpatialMomentum.h>
 #include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Utils.h>
 
 #include <iDynTree/Model/Dynamics.h>
 
@@ -533,11 +534,135 @@ bool InverseDynamicsInertialParametersRegressor(const iDynTree::Model & model,
     return true;
 }
 
+GravityGeneralizedForcesInternalBuffers::GravityGeneralizedForcesInternalBuffers(const Model& model)
+{
+    resize(model);
+}
+
+void GravityGeneralizedForcesInternalBuffers::resize(const Model& model)
+{
+    parent_H_link.resize(model);
+    subtreeMass.resize(model.getNrOfLinks());
+    subtreeFirstMomentOfMass.resize(model.getNrOfLinks());
+    linksProperLinearAcc.resize(model.getNrOfLinks());
+}
 
+bool GravityGeneralizedForcesInternalBuffers::isConsistent(const Model& model) const
+{
+    return parent_H_link.isConsistent(model)
+           && subtreeMass.size() == model.getNrOfLinks()
+           && subtreeFirstMomentOfMass.size() == model.getNrOfLinks()
+           && linksProperLinearAcc.size() == model.getNrOfLinks();
 }
 
+bool ComputeGravityGeneralizedForces(const Model& model,
+                                     const Traversal& traversal,
+                                     const JointPosDoubleArray& jointPos,
+                                     const LinkIndex referenceLink,
+                                     const Vector3& referenceLinkProperLinearAcc,
+                                           GravityGeneralizedForcesInternalBuffers& bufs,
+                                           FreeFloatingGeneralizedTorques& baseForceAndJointTorques)
+{
+    if( !model.isValidLinkIndex(referenceLink) )
+    {
+        reportError("","ComputeGravityGeneralizedForces","invalid reference link");
+        return false;
+    }
+
+    if( !bufs.isConsistent(model) )
+    {
+        reportError("","ComputeGravityGeneralizedForces","buffers not consistent with the model");
+        return false;
+    }
+
+    // Forward pass: compute the transform between each link and its parent,
+    // and initialize the subtree quantities with the ones of the link
+    for(unsigned int traversalEl=0; traversalEl < traversal.getNrOfVisitedLinks(); traversalEl++)
+    {
+        LinkConstPtr visitedLink = traversal.getLink(traversalEl);
+        LinkIndex    visitedLinkIndex = visitedLink->getIndex();
+        LinkConstPtr parentLink  = traversal.getParentLink(traversalEl);
+        IJointConstPtr toParentJoint = traversal.getParentJoint(traversalEl);
 
+        const SpatialInertia & I = visitedLink->getInertia();
+        bufs.subtreeMass[visitedLinkIndex] = I.getMass();
+        toEigen(bufs.subtreeFirstMomentOfMass[visitedLinkIndex]) = I.getMass()*toEigen(I.getCenterOfMass());
 
+        if( parentLink == 0 )
+        {
+            bufs.parent_H_link(visitedLinkIndex) = Transform::Identity();
+        }
+        else
+        {
+            bufs.parent_H_link(visitedLinkIndex) = toParentJoint->getTransform(jointPos,parentLink->getIndex(),visitedLinkIndex);
+        }
+    }
 
+    // As all the velocities are zero, the proper acceleration of every link is the
+    // same linear acceleration expressed in different frames: express it in the base frame
+    // and then rotate it in the frame of each link
+    Eigen::Vector3d baseProperAcc = toEigen(referenceLinkProperLinearAcc);
+    LinkIndex visitedLinkIndex = referenceLink;
+    while( traversal.getParentLinkFromLinkIndex(visitedLinkIndex) != 0 )
+    {
+        baseProperAcc = toEigen(bufs.parent_H_link(visitedLinkIndex).getRotation())*baseProperAcc;
+        visitedLinkIndex = traversal.getParentLinkFromLinkIndex(visitedLinkIndex)->getIndex();
+    }
 
+    for(unsigned int traversalEl=0; traversalEl < traversal.getNrOfVisitedLinks(); traversalEl++)
+    {
+        LinkIndex    visitedLinkIndex = traversal.getLink(traversalEl)->getIndex();
+        LinkConstPtr parentLink  = traversal.getParentLink(traversalEl);
 
+        if( parentLink == 0 )
+        {
+            toEigen(bufs.linksProperLinearAcc[visitedLinkIndex]) = baseProperAcc;
+        }
+        else
+        {
+            toEigen(bufs.linksProperLinearAcc[visitedLinkIndex]) =
+                toEigen(bufs.parent_H_link(visitedLinkIndex).getRotation()).transpose()*toEigen(bufs.linksProperLinearAcc[parentLink->getIndex()]);
+        }
+    }
+
+    // Backward pass: the wrench transmitted by the parent joint of a link is the one
+    // that accelerates the mass of its subtree, i.e. f = [ m a ; (m c) x a ]
+    Wrench f;
+    for(int traversalEl = traversal.getNrOfVisitedLinks()-1; traversalEl >= 0; traversalEl--)
+    {
+        LinkIndex    visitedLinkIndex = traversal.getLink(traversalEl)->getIndex();
+        LinkConstPtr parentLink  = traversal.getParentLink(traversalEl);
+        IJointConstPtr toParentJoint = traversal.getParentJoint(traversalEl);
+
+        const double subtreeMass = bufs.subtreeMass[visitedLinkIndex];
+        const Eigen::Vector3d h = toEigen(bufs.subtreeFirstMomentOfMass[visitedLinkIndex]);
+        const Eigen::Vector3d a = toEigen(bufs.linksProperLinearAcc[visitedLinkIndex]);
+
+        toEigen(f.getLinearVec3()) = subtreeMass*a;
+        toEigen(f.getAngularVec3()) = h.cross(a);
+
+        if( parentLink == 0 )
+        {
+            baseForceAndJointTorques.baseWrench() = f;
+        }
+        else
+        {
+            LinkIndex parentLinkIndex = parentLink->getIndex();
+            toParentJoint->computeJointTorque(jointPos,
+                                              f,
+                                              parentLinkIndex,
+                                              visitedLinkIndex,
+                                              baseForceAndJointTorques.jointTorques());
+
+            // Add the subtree of the visited link to the subtree of its parent
+            const Transform & parent_H_visited = bufs.parent_H_link(visitedLinkIndex);
+            bufs.subtreeMass[parentLinkIndex] += subtreeMass;
+            toEigen(bufs.subtreeFirstMomentOfMass[parentLinkIndex]) +=
+                subtreeMass*toEigen(parent_H_visited.getPosition()) + toEigen(parent_H_visited.getRotation())*h;
+        }
+    }
+
+    return true;
+}
+
+}
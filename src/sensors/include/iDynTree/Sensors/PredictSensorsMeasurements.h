@@ -14,6 +14,10 @@
 #include <iDynTree/Model/LinkState.h>
 
 #include <iDynTree/Core/GeomVector3.h>
+#include <iDynTree/Core/MatrixFixSize.h>
+#include <iDynTree/Core/Span.h>
+
+#include <vector>
 
 namespace iDynTree
 {
@@ -107,6 +111,118 @@ namespace iDynTree
                                                    const LinkInternalWrenches& buf_internalWrenches,
                                                          SensorsMeasurements &predictedMeasurement);
 
+    /**
+     * \brief Precomputed data to predict the measurements of a set of sensors.
+     *
+     * The plan is built once from a Model, a SensorsList and a Traversal, and stores for
+     * each sensor type the contiguous arrays of the links used by the prediction and the
+     * precomputed transforms from the link frame to the sensor frame, so that the prediction
+     * does not need to access the polymorphic sensors objects or to invert their transforms.
+     *
+     * The plan predicts the same measurements of predictSensorsMeasurementsFromRawBuffers,
+     * and needs to be rebuilt if any of the model, the sensors list or the traversal change.
+     *
+     * \ingroup iDynTreeSensors
+     */
+    class SensorsPredictionPlan
+    {
+    private:
+        // Six axis F/T sensors: child link in the traversal and sensor_X_childLink wrench adjoint,
+        // with the sign change already applied if the measured wrench is the one applied on the parent
+        std::vector<LinkIndex> m_ftChildLinks;
+        std::vector<Matrix6x6> m_ftSensor_X_childLink;
+
+        // Accelerometers: parent link and sensor_X_link motion adjoint
+        std::vector<LinkIndex> m_accParentLinks;
+        std::vector<Matrix6x6> m_accSensor_X_link;
+
+        // Gyroscopes and angular accelerometers: parent link and sensor_R_link rotation
+        std::vector<LinkIndex> m_gyroParentLinks;
+        std::vector<Matrix3x3> m_gyroSensor_R_link;
+        std::vector<LinkIndex> m_angAccParentLinks;
+        std::vector<Matrix3x3> m_angAccSensor_R_link;
+
+        size_t m_nrOfThreeAxisForceTorqueContactSensors;
+        size_t m_nrOfLinks;
+        bool m_isValid;
+
+        bool checkLinkArraysSize(const LinkVelArray& linkVel,
+                                 const LinkAccArray& linkProperAcc,
+                                 const LinkInternalWrenches& internalWrenches) const;
+        void predictAllButContactSensors(const LinkVelArray& buf_linkVel,
+                                         const LinkAccArray& buf_linkProperAcc,
+                                         const LinkInternalWrenches& buf_internalWrenches,
+                                         double* out) const;
+
+    public:
+        /**
+         * Constructor, builds an empty plan.
+         */
+        SensorsPredictionPlan();
+
+        /**
+         * Constructor, equivalent to calling init.
+         */
+        SensorsPredictionPlan(const Model& model,
+                              const SensorsList& sensorsList,
+                              const Traversal& traversal);
+
+        /**
+         * Build the plan for the sensors in sensorsList.
+         *
+         * @param[in] model the model used to predict the sensor measurements.
+         * @param[in] sensorsList the sensors list used to predict the sensors measurements.
+         * @param[in] traversal the Traversal used for predict the sensor measurements.
+         * @return true if all the sensors in the list are valid and attached to links of the model, false otherwise.
+         */
+        bool init(const Model& model,
+                  const SensorsList& sensorsList,
+                  const Traversal& traversal);
+
+        /**
+         * Return true if the plan has been successfully built.
+         */
+        bool isValid() const;
+
+        /**
+         * Get the size of the buffer of all the predicted measurements.
+         *
+         * \note this is equal to SensorsMeasurements::getSizeOfAllSensorsMeasurements for the sensors list used to build the plan.
+         */
+        size_t getSizeOfAllSensorsMeasurements() const;
+
+        /**
+         * Predict the measurements of all the sensors in a contiguous buffer.
+         *
+         * The buffer has the same layout of the vector returned by SensorsMeasurements::toVector.
+         * The measurements of THREE_AXIS_FORCE_TORQUE_CONTACT sensors are not predicted, and are set to zero.
+         *
+         * @param[in] buf_linkVel the velocity of every link in the model.
+         * @param[in] buf_linkProperAcc the proper acceleration of every link in the model.
+         * @param[in] buf_internalWrenches the internal wrenches computed with the traversal used to build the plan.
+         * @param[out] predictedMeasurements buffer of size getSizeOfAllSensorsMeasurements().
+         * @return true if all went well, false otherwise.
+         */
+        bool predictSensorsMeasurements(const LinkVelArray& buf_linkVel,
+                                        const LinkAccArray& buf_linkProperAcc,
+                                        const LinkInternalWrenches& buf_internalWrenches,
+                                        Span<double> predictedMeasurements) const;
+
+        /**
+         * Predict the measurements of all the sensors.
+         *
+         * @param[in] buf_linkVel the velocity of every link in the model.
+         * @param[in] buf_linkProperAcc the proper acceleration of every link in the model.
+         * @param[in] buf_internalWrenches the internal wrenches computed with the traversal used to build the plan.
+         * @param[out] predictedMeasurement the predicted measurements for the sensors, already resized for the sensors list used to build the plan.
+         * @return true if all went well, false otherwise.
+         */
+        bool predictSensorsMeasurements(const LinkVelArray& buf_linkVel,
+                                        const LinkAccArray& buf_linkProperAcc,
+                                        const LinkInternalWrenches& buf_internalWrenches,
+                                        SensorsMeasurements& predictedMeasurement) const;
+    };
+
 }
 
 #endif
@@ -25,6 +25,8 @@ namespace iDynTree {
 #include <iterator>
 
 #include <iDynTree/Core/VectorDynSize.h>
+#include <iDynTree/Core/MatrixView.h>
+#include <iDynTree/Core/Span.h>
 
 #include <iDynTree/Model/Model.h>
 #include <iDynTree/Model/Indices.h>
@@ -514,6 +516,12 @@ namespace iDynTree {
     /**
      * A list of measurements associated with a SensorsList .
      *
+     * The measurements of all the sensors are stored in a single contiguous buffer,
+     * with the same layout of the vector returned by toVector: the measurements of the
+     * sensors of each type are stored contiguously, and the types are ordered as in SensorType.
+     * The buffer can be accessed without copies with getMeasurementsBuffer, getMeasurementsView
+     * and getMeasurementView. The views are invalidated by any method that changes the number of sensors.
+     *
      * \ingroup iDynTreeSensors
      */
     class SensorsMeasurements
@@ -605,6 +613,38 @@ namespace iDynTree {
              * \note this is the size of vector returned by toVector.
              */
             size_t getSizeOfAllSensorsMeasurements() const;
+
+            /**
+             * Get the buffer of all the sensors measurements, of size getSizeOfAllSensorsMeasurements().
+             *
+             * \note the layout of the buffer is the same of the vector returned by toVector.
+             */
+            Span<double> getMeasurementsBuffer();
+            Span<const double> getMeasurementsBuffer() const;
+
+            /**
+             * Get the offset in the measurements buffer of the first measurement of the sensors of type sensor_type.
+             */
+            std::size_t getMeasurementsBufferOffset(const SensorType & sensor_type) const;
+
+            /**
+             * Get a view on the measurements of all the sensors of type sensor_type.
+             *
+             * @return a row major matrix with getNrOfSensors(sensor_type) rows and getSensorTypeSize(sensor_type) columns,
+             *         in which the i-th row is the measurement of the i-th sensor.
+             */
+            MatrixView<double> getMeasurementsView(const SensorType & sensor_type);
+            MatrixView<const double> getMeasurementsView(const SensorType & sensor_type) const;
+
+            /**
+             * Get a view on the measurement of the specified sensor.
+             *
+             * @return a span of size getSensorTypeSize(sensor_type), empty if sensor_index is out of bounds.
+             */
+            Span<double> getMeasurementView(const SensorType & sensor_type,
+                                            const std::ptrdiff_t & sensor_index);
+            Span<const double> getMeasurementView(const SensorType & sensor_type,
+                                                  const std::ptrdiff_t & sensor_index) const;
     };
 
 }
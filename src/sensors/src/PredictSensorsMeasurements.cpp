@@ -24,6 +24,10 @@
 
 #include <iDynTree/Core/SpatialAcc.h>
 #include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/Utils.h>
+
+#include <algorithm>
+#include <sstream>
 
 namespace iDynTree {
 
@@ -123,4 +127,288 @@ bool predictSensorsMeasurementsFromRawBuffers(const Model& /*model*/,
 
 
 
+namespace
+{
+    typedef Eigen::Map<Eigen::Matrix<double, 3, 1> > Vector3Map;
+    typedef Eigen::Map<Eigen::Matrix<double, 6, 1> > Vector6Map;
+
+    inline void predictSixAxisForceTorque(const Matrix6x6& sensor_X_childLink,
+                                          const Wrench& childLinkWrench,
+                                          double* out)
+    {
+        Vector6Map outMap(out);
+        outMap.noalias() = toEigen(sensor_X_childLink)*toEigen(childLinkWrench);
+    }
+
+    inline void predictAccelerometer(const Matrix6x6& sensor_X_link,
+                                     const Twist& linkVel,
+                                     const SpatialAcc& linkProperAcc,
+                                     double* out)
+    {
+        Eigen::Matrix<double, 6, 1> sensorVel, sensorAcc;
+        sensorVel.noalias() = toEigen(sensor_X_link)*toEigen(linkVel);
+        sensorAcc.noalias() = toEigen(sensor_X_link)*toEigen(linkProperAcc);
+        Vector3Map outMap(out);
+        outMap = sensorAcc.head<3>() + sensorVel.tail<3>().cross(sensorVel.head<3>());
+    }
+
+    inline void rotateVector(const Matrix3x3& sensor_R_link,
+                             const Vector3& linkVector,
+                             double* out)
+    {
+        Vector3Map outMap(out);
+        outMap.noalias() = toEigen(sensor_R_link)*toEigen(linkVector);
+    }
+}
+
+SensorsPredictionPlan::SensorsPredictionPlan(): m_nrOfThreeAxisForceTorqueContactSensors(0),
+                                                m_nrOfLinks(0),
+                                                m_isValid(false)
+{
+}
+
+SensorsPredictionPlan::SensorsPredictionPlan(const Model& model,
+                                             const SensorsList& sensorsList,
+                                             const Traversal& traversal): SensorsPredictionPlan()
+{
+    init(model, sensorsList, traversal);
+}
+
+bool SensorsPredictionPlan::init(const Model& model,
+                                 const SensorsList& sensorsList,
+                                 const Traversal& traversal)
+{
+    m_isValid = false;
+    m_nrOfLinks = model.getNrOfLinks();
+
+    auto checkParentLink = [&](const LinkSensor* sensor) -> bool
+    {
+        LinkIndex parentLink = sensor->getParentLinkIndex();
+        if (parentLink < 0 || static_cast<size_t>(parentLink) >= m_nrOfLinks)
+        {
+            std::stringstream ss;
+            ss << "Sensor " << sensor->getName() << " is not attached to a link of the model.";
+            reportError("SensorsPredictionPlan", "init", ss.str().c_str());
+            return false;
+        }
+        return true;
+    };
+
+    size_t numOfFTs = sensorsList.getNrOfSensors(iDynTree::SIX_AXIS_FORCE_TORQUE);
+    m_ftChildLinks.resize(numOfFTs);
+    m_ftSensor_X_childLink.resize(numOfFTs);
+    for (size_t idx = 0; idx < numOfFTs; idx++)
+    {
+        const SixAxisForceTorqueSensor* ftSens =
+            static_cast<const SixAxisForceTorqueSensor*>(sensorsList.getSensor(iDynTree::SIX_AXIS_FORCE_TORQUE, idx));
+
+        LinkIndex firstLink = ftSens->getFirstLinkIndex();
+        LinkIndex secondLink = ftSens->getSecondLinkIndex();
+        if (firstLink < 0 || static_cast<size_t>(firstLink) >= m_nrOfLinks ||
+            secondLink < 0 || static_cast<size_t>(secondLink) >= m_nrOfLinks)
+        {
+            std::stringstream ss;
+            ss << "Sensor " << ftSens->getName() << " is not attached to links of the model.";
+            reportError("SensorsPredictionPlan", "init", ss.str().c_str());
+            return false;
+        }
+
+        // Same logic of SixAxisForceTorqueSensor::predictMeasurement
+        LinkIndex childLink = LINK_INVALID_INDEX;
+        LinkIndex parentLink = LINK_INVALID_INDEX;
+        LinkConstPtr parentOfFirst = traversal.getParentLinkFromLinkIndex(firstLink);
+        LinkConstPtr parentOfSecond = traversal.getParentLinkFromLinkIndex(secondLink);
+        if (parentOfFirst && parentOfFirst->getIndex() == secondLink)
+        {
+            childLink = firstLink;
+            parentLink = secondLink;
+        }
+        else if (parentOfSecond && parentOfSecond->getIndex() == firstLink)
+        {
+            childLink = secondLink;
+            parentLink = firstLink;
+        }
+        else
+        {
+            std::stringstream ss;
+            ss << "The links of sensor " << ftSens->getName() << " are not connected in the traversal.";
+            reportError("SensorsPredictionPlan", "init", ss.str().c_str());
+            return false;
+        }
+
+        Transform childLink_H_sensor;
+        ftSens->getLinkSensorTransform(childLink, childLink_H_sensor);
+        m_ftChildLinks[idx] = childLink;
+        m_ftSensor_X_childLink[idx] = childLink_H_sensor.inverse().asAdjointTransformWrench();
+        if (ftSens->getAppliedWrenchLink() == parentLink)
+        {
+            toEigen(m_ftSensor_X_childLink[idx]) *= -1.0;
+        }
+    }
+
+    size_t numAccl = sensorsList.getNrOfSensors(iDynTree::ACCELEROMETER);
+    m_accParentLinks.resize(numAccl);
+    m_accSensor_X_link.resize(numAccl);
+    for (size_t idx = 0; idx < numAccl; idx++)
+    {
+        const AccelerometerSensor* accelerometer =
+            static_cast<const AccelerometerSensor*>(sensorsList.getSensor(iDynTree::ACCELEROMETER, idx));
+        if (!checkParentLink(accelerometer))
+        {
+            return false;
+        }
+        m_accParentLinks[idx] = accelerometer->getParentLinkIndex();
+        m_accSensor_X_link[idx] = accelerometer->getLinkSensorTransform().inverse().asAdjointTransform();
+    }
+
+    size_t numGyro = sensorsList.getNrOfSensors(iDynTree::GYROSCOPE);
+    m_gyroParentLinks.resize(numGyro);
+    m_gyroSensor_R_link.resize(numGyro);
+    for (size_t idx = 0; idx < numGyro; idx++)
+    {
+        const GyroscopeSensor* gyroscope =
+            static_cast<const GyroscopeSensor*>(sensorsList.getSensor(iDynTree::GYROSCOPE, idx));
+        if (!checkParentLink(gyroscope))
+        {
+            return false;
+        }
+        m_gyroParentLinks[idx] = gyroscope->getParentLinkIndex();
+        m_gyroSensor_R_link[idx] = gyroscope->getLinkSensorTransform().getRotation().inverse();
+    }
+
+    size_t numAngAccl = sensorsList.getNrOfSensors(iDynTree::THREE_AXIS_ANGULAR_ACCELEROMETER);
+    m_angAccParentLinks.resize(numAngAccl);
+    m_angAccSensor_R_link.resize(numAngAccl);
+    for (size_t idx = 0; idx < numAngAccl; idx++)
+    {
+        const ThreeAxisAngularAccelerometerSensor* angAccelerometer =
+            static_cast<const ThreeAxisAngularAccelerometerSensor*>(sensorsList.getSensor(iDynTree::THREE_AXIS_ANGULAR_ACCELEROMETER, idx));
+        if (!checkParentLink(angAccelerometer))
+        {
+            return false;
+        }
+        m_angAccParentLinks[idx] = angAccelerometer->getParentLinkIndex();
+        m_angAccSensor_R_link[idx] = angAccelerometer->getLinkSensorTransform().getRotation().inverse();
+    }
+
+    m_nrOfThreeAxisForceTorqueContactSensors = sensorsList.getNrOfSensors(iDynTree::THREE_AXIS_FORCE_TORQUE_CONTACT);
+
+    m_isValid = true;
+    return true;
+}
+
+bool SensorsPredictionPlan::isValid() const
+{
+    return m_isValid;
+}
+
+size_t SensorsPredictionPlan::getSizeOfAllSensorsMeasurements() const
+{
+    return 6*m_ftChildLinks.size() + 3*m_accParentLinks.size() + 3*m_gyroParentLinks.size()
+           + 3*m_angAccParentLinks.size() + 3*m_nrOfThreeAxisForceTorqueContactSensors;
+}
+
+bool SensorsPredictionPlan::checkLinkArraysSize(const LinkVelArray& linkVel,
+                                                const LinkAccArray& linkProperAcc,
+                                                const LinkInternalWrenches& internalWrenches) const
+{
+    if (!m_isValid)
+    {
+        reportError("SensorsPredictionPlan", "predictSensorsMeasurements", "The plan has not been successfully initialized.");
+        return false;
+    }
+
+    if (linkVel.getNrOfLinks() != m_nrOfLinks ||
+        linkProperAcc.getNrOfLinks() != m_nrOfLinks ||
+        internalWrenches.getNrOfLinks() != m_nrOfLinks)
+    {
+        reportError("SensorsPredictionPlan", "predictSensorsMeasurements", "The size of the link buffers is not consistent with the model.");
+        return false;
+    }
+
+    return true;
+}
+
+void SensorsPredictionPlan::predictAllButContactSensors(const LinkVelArray& buf_linkVel,
+                                                        const LinkAccArray& buf_linkProperAcc,
+                                                        const LinkInternalWrenches& buf_internalWrenches,
+                                                        double* out) const
+{
+    for (size_t idx = 0; idx < m_ftChildLinks.size(); idx++, out += 6)
+    {
+        predictSixAxisForceTorque(m_ftSensor_X_childLink[idx], buf_internalWrenches(m_ftChildLinks[idx]), out);
+    }
+
+    for (size_t idx = 0; idx < m_accParentLinks.size(); idx++, out += 3)
+    {
+        LinkIndex link = m_accParentLinks[idx];
+        predictAccelerometer(m_accSensor_X_link[idx], buf_linkVel(link), buf_linkProperAcc(link), out);
+    }
+
+    for (size_t idx = 0; idx < m_gyroParentLinks.size(); idx++, out += 3)
+    {
+        rotateVector(m_gyroSensor_R_link[idx], buf_linkVel(m_gyroParentLinks[idx]).getAngularVec3(), out);
+    }
+
+    for (size_t idx = 0; idx < m_angAccParentLinks.size(); idx++, out += 3)
+    {
+        rotateVector(m_angAccSensor_R_link[idx], buf_linkProperAcc(m_angAccParentLinks[idx]).getAngularVec3(), out);
+    }
+}
+
+bool SensorsPredictionPlan::predictSensorsMeasurements(const LinkVelArray& buf_linkVel,
+                                                       const LinkAccArray& buf_linkProperAcc,
+                                                       const LinkInternalWrenches& buf_internalWrenches,
+                                                       Span<double> predictedMeasurements) const
+{
+    if (!checkLinkArraysSize(buf_linkVel, buf_linkProperAcc, buf_internalWrenches))
+    {
+        return false;
+    }
+
+    if (predictedMeasurements.size() != static_cast<Span<double>::index_type>(getSizeOfAllSensorsMeasurements()))
+    {
+        std::stringstream ss;
+        ss << "The size of the measurements buffer is " << predictedMeasurements.size()
+           << " while the expected size is " << getSizeOfAllSensorsMeasurements() << ".";
+        reportError("SensorsPredictionPlan", "predictSensorsMeasurements", ss.str().c_str());
+        return false;
+    }
+
+    predictAllButContactSensors(buf_linkVel, buf_linkProperAcc, buf_internalWrenches, predictedMeasurements.data());
+
+    size_t contactOffset = getSizeOfAllSensorsMeasurements() - 3*m_nrOfThreeAxisForceTorqueContactSensors;
+    std::fill(predictedMeasurements.begin() + contactOffset, predictedMeasurements.end(), 0.0);
+
+    return true;
+}
+
+bool SensorsPredictionPlan::predictSensorsMeasurements(const LinkVelArray& buf_linkVel,
+                                                       const LinkAccArray& buf_linkProperAcc,
+                                                       const LinkInternalWrenches& buf_internalWrenches,
+                                                       SensorsMeasurements& predictedMeasurement) const
+{
+    if (!checkLinkArraysSize(buf_linkVel, buf_linkProperAcc, buf_internalWrenches))
+    {
+        return false;
+    }
+
+    if (predictedMeasurement.getNrOfSensors(SIX_AXIS_FORCE_TORQUE) != m_ftChildLinks.size() ||
+        predictedMeasurement.getNrOfSensors(ACCELEROMETER) != m_accParentLinks.size() ||
+        predictedMeasurement.getNrOfSensors(GYROSCOPE) != m_gyroParentLinks.size() ||
+        predictedMeasurement.getNrOfSensors(THREE_AXIS_ANGULAR_ACCELEROMETER) != m_angAccParentLinks.size())
+    {
+        reportError("SensorsPredictionPlan", "predictSensorsMeasurements",
+                    "The number of sensors in the measurements is not consistent with the plan.");
+        return false;
+    }
+
+    // The measurements of the predicted sensor types are stored contiguously at the beginning of the
+    // buffer, with the same layout used by the plan, while the contact sensors measurements are left untouched
+    predictAllButContactSensors(buf_linkVel, buf_linkProperAcc, buf_internalWrenches,
+                                predictedMeasurement.getMeasurementsBuffer().data());
+
+    return true;
+}
+
 }
@@ -21,7 +21,9 @@
 #include <iDynTree/Sensors/GyroscopeSensor.h>
 
 #include <iDynTree/Core/VectorDynSize.h>
+#include <iDynTree/Core/Utils.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -638,14 +640,89 @@ bool JointSensor::isConsistent(const Model& model) const
 
 struct SensorsMeasurements::SensorsMeasurementsPrivateAttributes
 {
-    std::vector< iDynTree::Wrench > SixAxisFTSensorsMeasurements;
-    std::vector< iDynTree::AngVelocity > GyroscopeMeasurements;
-    std::vector< iDynTree::LinAcceleration> AccelerometerMeasurements;
-    std::vector< Vector3 > ThreeAxisAngularAccelerometerMeasurements;
-    std::vector< Vector3 > ThreeAxisForceTorqueContactMeasurements;
+    // The measurements of all the sensors are stored in a single buffer, with the
+    // measurements of each sensor type stored contiguously in the order of SensorType
+    std::size_t nrOfSensors[NR_OF_SENSOR_TYPES];
+    std::size_t offsets[NR_OF_SENSOR_TYPES];
+    std::vector<double> buffer;
 
+    SensorsMeasurementsPrivateAttributes()
+    {
+        for (int i = 0; i < NR_OF_SENSOR_TYPES; i++)
+        {
+            nrOfSensors[i] = 0;
+            offsets[i] = 0;
+        }
+    }
+
+    /**
+     * Resize the buffer, preserving the measurements of the sensors that are still
+     * present and setting to zero the measurements of the new sensors.
+     */
+    void resize(const std::size_t newNrOfSensors[NR_OF_SENSOR_TYPES])
+    {
+        // Nothing to do if the number of sensors did not change: the buffer is kept as it is
+        if (std::equal(newNrOfSensors, newNrOfSensors + NR_OF_SENSOR_TYPES, nrOfSensors))
+        {
+            return;
+        }
+
+        std::size_t newOffsets[NR_OF_SENSOR_TYPES];
+        std::size_t newSize = 0;
+        for (int i = 0; i < NR_OF_SENSOR_TYPES; i++)
+        {
+            newOffsets[i] = newSize;
+            newSize += getSensorTypeSize(static_cast<SensorType>(i))*newNrOfSensors[i];
+        }
+
+        std::vector<double> newBuffer(newSize, 0.0);
+        for (int i = 0; i < NR_OF_SENSOR_TYPES; i++)
+        {
+            std::size_t preserved = getSensorTypeSize(static_cast<SensorType>(i))*std::min(nrOfSensors[i], newNrOfSensors[i]);
+            std::copy(buffer.begin() + offsets[i], buffer.begin() + offsets[i] + preserved,
+                      newBuffer.begin() + newOffsets[i]);
+        }
+
+        buffer.swap(newBuffer);
+        for (int i = 0; i < NR_OF_SENSOR_TYPES; i++)
+        {
+            nrOfSensors[i] = newNrOfSensors[i];
+            offsets[i] = newOffsets[i];
+        }
+    }
+
+    bool isValidSensor(const SensorType& sensor_type, const std::ptrdiff_t& sensor_index) const
+    {
+        return sensor_index >= 0 && static_cast<std::size_t>(sensor_index) < nrOfSensors[sensor_type];
+    }
+
+    double* measurement(const SensorType& sensor_type, const std::ptrdiff_t& sensor_index)
+    {
+        return buffer.data() + offsets[sensor_type] + getSensorTypeSize(sensor_type)*sensor_index;
+    }
+
+    const double* measurement(const SensorType& sensor_type, const std::ptrdiff_t& sensor_index) const
+    {
+        return buffer.data() + offsets[sensor_type] + getSensorTypeSize(sensor_type)*sensor_index;
+    }
 };
 
+namespace
+{
+    inline bool isValidSensorType(const SensorType& sensor_type)
+    {
+        return static_cast<int>(sensor_type) >= 0 && static_cast<int>(sensor_type) < NR_OF_SENSOR_TYPES;
+    }
+
+    inline bool usesVector3Measurement(const SensorType& sensor_type)
+    {
+        return sensor_type == ACCELEROMETER ||
+               sensor_type == GYROSCOPE ||
+               sensor_type == THREE_AXIS_ANGULAR_ACCELEROMETER ||
+               sensor_type == THREE_AXIS_FORCE_TORQUE_CONTACT;
+    }
+}
+
 
  SensorsMeasurements::SensorsMeasurements() : pimpl(new SensorsMeasurementsPrivateAttributes)
 {
@@ -655,10 +732,7 @@ struct SensorsMeasurements::SensorsMeasurementsPrivateAttributes
 SensorsMeasurements::SensorsMeasurements(const SensorsList &sensorsList)
 {
     this->pimpl = new SensorsMeasurementsPrivateAttributes;
-    this->pimpl->SixAxisFTSensorsMeasurements.resize(sensorsList.getNrOfSensors(SIX_AXIS_FORCE_TORQUE));
-    this->pimpl->AccelerometerMeasurements.resize(sensorsList.getNrOfSensors(ACCELEROMETER));
-    this->pimpl->GyroscopeMeasurements.resize(sensorsList.getNrOfSensors(GYROSCOPE));
-    this->pimpl->ThreeAxisAngularAccelerometerMeasurements.resize(sensorsList.getNrOfSensors(THREE_AXIS_ANGULAR_ACCELEROMETER));
+    this->resize(sensorsList);
 }
 SensorsMeasurements::SensorsMeasurements(const SensorsMeasurements & other):
 pimpl(new SensorsMeasurementsPrivateAttributes(*(other.pimpl)))
@@ -682,140 +756,57 @@ SensorsMeasurements::~SensorsMeasurements()
 
 bool SensorsMeasurements::setNrOfSensors(const SensorType& sensor_type, std::size_t nrOfSensors)
 {
-    Wrench zeroWrench;
-    LinAcceleration zeroLinAcc;
-    AngVelocity zeroAngVel;
-    bool ret = true;
-    switch (sensor_type)
-    {
-        case SIX_AXIS_FORCE_TORQUE :
-            zeroWrench.zero();
-            this->pimpl->SixAxisFTSensorsMeasurements.resize(nrOfSensors,zeroWrench);
-            break;
-        case ACCELEROMETER :
-            zeroLinAcc.zero();
-            this->pimpl->AccelerometerMeasurements.resize(nrOfSensors,zeroLinAcc);
-            break;
-        case GYROSCOPE :
-            zeroAngVel.zero();
-            this->pimpl->GyroscopeMeasurements.resize(nrOfSensors,zeroAngVel);
-            break;
-        case THREE_AXIS_ANGULAR_ACCELEROMETER:
-        {
-            Vector3 zeroAngAcc;
-            zeroAngAcc.zero();
-            this->pimpl->ThreeAxisAngularAccelerometerMeasurements.resize(nrOfSensors, zeroAngAcc);
-        }
-            break;
-        case THREE_AXIS_FORCE_TORQUE_CONTACT:
-        {
-            Vector3 zeroFT;
-            zeroFT.zero();
-            this->pimpl->ThreeAxisForceTorqueContactMeasurements.resize(nrOfSensors, zeroFT);
-        }
-            break;
-        default :
-            ret = false;
-            break;
+    if( !isValidSensorType(sensor_type) )
+    {
+        return false;
     }
 
-    return ret;
+    std::size_t newNrOfSensors[NR_OF_SENSOR_TYPES];
+    std::copy(this->pimpl->nrOfSensors, this->pimpl->nrOfSensors + NR_OF_SENSOR_TYPES, newNrOfSensors);
+    newNrOfSensors[sensor_type] = nrOfSensors;
+    this->pimpl->resize(newNrOfSensors);
+
+    return true;
 }
 
 bool SensorsMeasurements::resize(const SensorsList &sensorsList)
 {
-    Wrench zeroWrench;zeroWrench.zero();
-    LinAcceleration zeroLinAcc;zeroLinAcc.zero();
-    AngVelocity zeroAngVel;zeroAngVel.zero();
-    Vector3  zeroVec3; zeroVec3.zero();
-
-    this->pimpl->SixAxisFTSensorsMeasurements.resize(sensorsList.getNrOfSensors(iDynTree::SIX_AXIS_FORCE_TORQUE),zeroWrench);
-    this->pimpl->AccelerometerMeasurements.resize(sensorsList.getNrOfSensors(iDynTree::ACCELEROMETER),zeroLinAcc);
-    this->pimpl->GyroscopeMeasurements.resize(sensorsList.getNrOfSensors(iDynTree::GYROSCOPE),zeroAngVel);
-    this->pimpl->ThreeAxisAngularAccelerometerMeasurements.resize(sensorsList.getNrOfSensors(iDynTree::THREE_AXIS_ANGULAR_ACCELEROMETER),zeroAngVel);
-    this->pimpl->ThreeAxisForceTorqueContactMeasurements.resize(sensorsList.getNrOfSensors(THREE_AXIS_FORCE_TORQUE_CONTACT), zeroVec3);
+    std::size_t newNrOfSensors[NR_OF_SENSOR_TYPES];
+    for(int i=0; i < NR_OF_SENSOR_TYPES; i++)
+    {
+        newNrOfSensors[i] = sensorsList.getNrOfSensors(static_cast<SensorType>(i));
+    }
+    this->pimpl->resize(newNrOfSensors);
 
     return true;
 }
 
 bool SensorsMeasurements::toVector(VectorDynSize & measurementVector) const
 {
-    std::size_t itr;
-    LinAcceleration thisLinAcc;
-    AngVelocity thisAngVel;
-    Wrench thisWrench;
-    std::size_t numFT = this->pimpl->SixAxisFTSensorsMeasurements.size();
-    std::size_t numAcc = this->pimpl->AccelerometerMeasurements.size();
-    std::size_t numGyro = this->pimpl->GyroscopeMeasurements.size();
-    std::size_t numThreeAxisAngularAcc = this->pimpl->ThreeAxisAngularAccelerometerMeasurements.size();
-    std::size_t numThreeAxisFT = this->pimpl->ThreeAxisForceTorqueContactMeasurements.size();
-
-    bool ok = true;
+    measurementVector.resize(this->pimpl->buffer.size());
+    std::copy(this->pimpl->buffer.begin(), this->pimpl->buffer.end(), measurementVector.data());
 
-    measurementVector.resize(6*numFT + 3*numAcc + 3*numGyro + 3*numThreeAxisAngularAcc + 3*numThreeAxisFT);
-
-    for(itr = 0; itr<numFT; itr++)
-    {
-        thisWrench = this->pimpl->SixAxisFTSensorsMeasurements.at(itr);
-
-        ok && measurementVector.setVal(6*itr, thisWrench.getVal(0));
-        ok && measurementVector.setVal(6*itr+1,thisWrench.getVal(1));
-        ok && measurementVector.setVal(6*itr+2,thisWrench.getVal(2));
-        ok && measurementVector.setVal(6*itr+3,thisWrench.getVal(3));
-        ok && measurementVector.setVal(6*itr+4,thisWrench.getVal(4));
-        ok && measurementVector.setVal(6*itr+5,thisWrench.getVal(5));
-    }
-    for(itr = 0; itr<numAcc; itr++)
-    {
-        thisLinAcc =  this->pimpl->AccelerometerMeasurements.at(itr);
-        ok && measurementVector.setVal(6*numFT + 3*itr,thisLinAcc.getVal(0));
-        ok && measurementVector.setVal(6*numFT + 3*itr+1,thisLinAcc.getVal(1));
-        ok && measurementVector.setVal(6*numFT + 3*itr+2,thisLinAcc.getVal(2));
-    }
-    for(itr = 0; itr<numGyro; itr++)
-    {
-        thisAngVel = this->pimpl->GyroscopeMeasurements.at(itr);
-        ok && measurementVector.setVal(6*numFT + 3*numAcc + 3*itr,thisAngVel.getVal(0));
-        ok && measurementVector.setVal(6*numFT + 3*numAcc + 3*itr+1,thisAngVel.getVal(1));
-        ok && measurementVector.setVal(6*numFT + 3*numAcc + 3*itr+2,thisAngVel.getVal(2));
-    }
-    for(itr = 0; itr<numThreeAxisAngularAcc; itr++)
-    {
-        std::ptrdiff_t offset = 6*numFT + 3*numAcc + 3*numGyro + 3*itr;
-        Vector3 thisAngAcc = this->pimpl->ThreeAxisAngularAccelerometerMeasurements.at(itr);
-        ok && measurementVector.setVal(offset,   thisAngAcc.getVal(0));
-        ok && measurementVector.setVal(offset+1, thisAngAcc.getVal(1));
-        ok && measurementVector.setVal(offset+2, thisAngAcc.getVal(2));
-    }
-    for(itr = 0; itr<numThreeAxisFT; itr++)
-    {
-        std::ptrdiff_t offset = 6*numFT + 3*numAcc + 3*numGyro + 3*numThreeAxisAngularAcc + 3*itr;
-        Vector3 thisThreeAxisFT = this->pimpl->ThreeAxisForceTorqueContactMeasurements.at(itr);
-        ok && measurementVector.setVal(offset,   thisThreeAxisFT.getVal(0));
-        ok && measurementVector.setVal(offset+1, thisThreeAxisFT.getVal(1));
-        ok && measurementVector.setVal(offset+2, thisThreeAxisFT.getVal(2));
-    }
-
-    return ok;
+    return true;
 }
 
-
 bool SensorsMeasurements::setMeasurement(const SensorType& sensor_type,
                                          const std::ptrdiff_t& sensor_index,
                                          const iDynTree::Wrench &measurement )
 {
     if( sensor_type == SIX_AXIS_FORCE_TORQUE )
     {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->SixAxisFTSensorsMeasurements.size() )
+        if( this->pimpl->isValidSensor(sensor_type, sensor_index) )
         {
-            this->pimpl->SixAxisFTSensorsMeasurements[sensor_index] = measurement;
+            double* out = this->pimpl->measurement(sensor_type, sensor_index);
+            std::copy(measurement.getLinearVec3().data(), measurement.getLinearVec3().data() + 3, out);
+            std::copy(measurement.getAngularVec3().data(), measurement.getAngularVec3().data() + 3, out + 3);
             return true;
         }
         else
         {
             std::cerr << "[ERROR] setMeasurement failed: sensor_index " << sensor_index
                       << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->SixAxisFTSensorsMeasurements.size() << std::endl;
+                      << this->pimpl->nrOfSensors[sensor_type] << std::endl;
             return false;
         }
     }
@@ -827,66 +818,18 @@ bool SensorsMeasurements::setMeasurement(const SensorType& sensor_type,
                                          const std::ptrdiff_t& sensor_index,
                                          const Vector3& measurement)
 {
-    if( sensor_type == ACCELEROMETER )
-    {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->AccelerometerMeasurements.size() )
-        {
-            this->pimpl->AccelerometerMeasurements[sensor_index] = measurement;
-            return true;
-        }
-        else
-        {
-            std::cerr << "[ERROR] setMeasurement failed: sensor_index " << sensor_index
-                      << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->AccelerometerMeasurements.size() << std::endl;
-            return false;
-        }
-    }
-
-    if( sensor_type == GYROSCOPE )
-    {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->GyroscopeMeasurements.size() )
-        {
-            this->pimpl->GyroscopeMeasurements[sensor_index] = measurement;
-            return true;
-        }
-        else
-        {
-            std::cerr << "[ERROR] setMeasurement failed: sensor_index " << sensor_index
-                      << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->GyroscopeMeasurements.size() << std::endl;
-            return false;
-        }
-    }
-
-    if (sensor_type == THREE_AXIS_ANGULAR_ACCELEROMETER)
+    if( usesVector3Measurement(sensor_type) )
     {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->ThreeAxisAngularAccelerometerMeasurements.size() )
+        if( this->pimpl->isValidSensor(sensor_type, sensor_index) )
         {
-            this->pimpl->ThreeAxisAngularAccelerometerMeasurements[sensor_index] = measurement;
+            std::copy(measurement.data(), measurement.data() + 3, this->pimpl->measurement(sensor_type, sensor_index));
             return true;
         }
         else
         {
             std::cerr << "[ERROR] setMeasurement failed: sensor_index " << sensor_index
                       << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->ThreeAxisAngularAccelerometerMeasurements.size() << std::endl;
-            return false;
-        }
-    }
-
-    if (sensor_type == THREE_AXIS_FORCE_TORQUE_CONTACT)
-    {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->ThreeAxisForceTorqueContactMeasurements.size() )
-        {
-            this->pimpl->ThreeAxisForceTorqueContactMeasurements[sensor_index] = measurement;
-            return true;
-        }
-        else
-        {
-            std::cerr << "[ERROR] setMeasurement failed: sensor_index " << sensor_index
-                      << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->ThreeAxisForceTorqueContactMeasurements.size() << std::endl;
+                      << this->pimpl->nrOfSensors[sensor_type] << std::endl;
             return false;
         }
     }
@@ -900,16 +843,18 @@ bool SensorsMeasurements::getMeasurement(const SensorType& sensor_type,
 {
     if( sensor_type == SIX_AXIS_FORCE_TORQUE )
     {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->SixAxisFTSensorsMeasurements.size() )
+        if( this->pimpl->isValidSensor(sensor_type, sensor_index) )
         {
-            measurement = this->pimpl->SixAxisFTSensorsMeasurements[sensor_index];
+            const double* in = this->pimpl->measurement(sensor_type, sensor_index);
+            std::copy(in, in + 3, measurement.getLinearVec3().data());
+            std::copy(in + 3, in + 6, measurement.getAngularVec3().data());
             return true;
         }
         else
         {
             std::cerr << "[ERROR] getMeasurement failed: sensor_index " << sensor_index
                       << "is out of bounds, because nrOfSensors is "
-                      << this-> pimpl->SixAxisFTSensorsMeasurements.size() << std::endl;
+                      << this->pimpl->nrOfSensors[sensor_type] << std::endl;
             return false;
         }
     }
@@ -920,108 +865,107 @@ bool SensorsMeasurements::getMeasurement(const SensorType& sensor_type,
 bool SensorsMeasurements::getMeasurement(const SensorType &sensor_type, const std::ptrdiff_t &sensor_index,
                                          Vector3 &measurement) const
 {
-    if( sensor_type == ACCELEROMETER )
+    if( usesVector3Measurement(sensor_type) )
     {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->AccelerometerMeasurements.size() )
+        if( this->pimpl->isValidSensor(sensor_type, sensor_index) )
         {
-            measurement = this->pimpl->AccelerometerMeasurements[sensor_index];
+            const double* in = this->pimpl->measurement(sensor_type, sensor_index);
+            std::copy(in, in + 3, measurement.data());
             return true;
         }
         else
         {
             std::cerr << "[ERROR] getMeasurement failed: sensor_index " << sensor_index
                       << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->AccelerometerMeasurements.size() << std::endl;
+                      << this->pimpl->nrOfSensors[sensor_type] << std::endl;
             return false;
         }
     }
 
-    if( sensor_type == GYROSCOPE )
+    return false;
+}
+
+Span<double> SensorsMeasurements::getMeasurementsBuffer()
+{
+    return make_span(this->pimpl->buffer);
+}
+
+Span<const double> SensorsMeasurements::getMeasurementsBuffer() const
+{
+    return make_span(this->pimpl->buffer.data(), this->pimpl->buffer.size());
+}
+
+std::size_t SensorsMeasurements::getMeasurementsBufferOffset(const SensorType& sensor_type) const
+{
+    if( !isValidSensorType(sensor_type) )
     {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->GyroscopeMeasurements.size() )
-        {
-            measurement = this->pimpl->GyroscopeMeasurements[sensor_index];
-            return true;
-        }
-        else
-        {
-            std::cerr << "[ERROR] getMeasurement failed: sensor_index " << sensor_index
-                      << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->GyroscopeMeasurements.size() << std::endl;
-            return false;
-        }
+        return this->pimpl->buffer.size();
     }
 
-    if( sensor_type == THREE_AXIS_ANGULAR_ACCELEROMETER )
+    return this->pimpl->offsets[sensor_type];
+}
+
+MatrixView<double> SensorsMeasurements::getMeasurementsView(const SensorType& sensor_type)
+{
+    if( !isValidSensorType(sensor_type) )
     {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->ThreeAxisAngularAccelerometerMeasurements.size() )
-        {
-            measurement = this->pimpl->ThreeAxisAngularAccelerometerMeasurements[sensor_index];
-            return true;
-        }
-        else
-        {
-            std::cerr << "[ERROR] getMeasurement failed: sensor_index " << sensor_index
-                      << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->ThreeAxisAngularAccelerometerMeasurements.size() << std::endl;
-            return false;
-        }
+        reportError("SensorsMeasurements", "getMeasurementsView", "Unknown sensor type.");
+        return MatrixView<double>();
     }
 
-    if( sensor_type == THREE_AXIS_FORCE_TORQUE_CONTACT )
+    return MatrixView<double>(this->pimpl->buffer.data() + this->pimpl->offsets[sensor_type],
+                              this->pimpl->nrOfSensors[sensor_type], getSensorTypeSize(sensor_type));
+}
+
+MatrixView<const double> SensorsMeasurements::getMeasurementsView(const SensorType& sensor_type) const
+{
+    if( !isValidSensorType(sensor_type) )
     {
-        if( static_cast<std::size_t>(sensor_index) < this->pimpl->ThreeAxisForceTorqueContactMeasurements.size() )
-        {
-            measurement = this->pimpl->ThreeAxisForceTorqueContactMeasurements[sensor_index];
-            return true;
-        }
-        else
-        {
-            std::cerr << "[ERROR] getMeasurement failed: sensor_index " << sensor_index
-                      << "is out of bounds, because nrOfSensors is "
-                      << this->pimpl->ThreeAxisForceTorqueContactMeasurements.size() << std::endl;
-            return false;
-        }
+        reportError("SensorsMeasurements", "getMeasurementsView", "Unknown sensor type.");
+        return MatrixView<const double>();
     }
 
-    return false;
+    return MatrixView<const double>(this->pimpl->buffer.data() + this->pimpl->offsets[sensor_type],
+                                    this->pimpl->nrOfSensors[sensor_type], getSensorTypeSize(sensor_type));
 }
 
-std::size_t SensorsMeasurements::getNrOfSensors(const SensorType& sensor_type) const
+Span<double> SensorsMeasurements::getMeasurementView(const SensorType& sensor_type,
+                                                     const std::ptrdiff_t& sensor_index)
 {
-    std::size_t returnVal = 0;
-    switch (sensor_type)
-    {
-        case SIX_AXIS_FORCE_TORQUE :
-            returnVal =  this->pimpl->SixAxisFTSensorsMeasurements.size();
-            break;
-        case ACCELEROMETER :
-            returnVal =  this->pimpl->AccelerometerMeasurements.size();
-            break;
-        case GYROSCOPE :
-            returnVal =  this->pimpl->GyroscopeMeasurements.size();
-            break;
-        case THREE_AXIS_ANGULAR_ACCELEROMETER :
-            returnVal =  this->pimpl->ThreeAxisAngularAccelerometerMeasurements.size();
-            break;
-        case THREE_AXIS_FORCE_TORQUE_CONTACT :
-            returnVal =  this->pimpl->ThreeAxisForceTorqueContactMeasurements.size();
-            break;
-        default :
-            returnVal = 0;
-    }
-    return(returnVal);
+    if( !isValidSensorType(sensor_type) || !this->pimpl->isValidSensor(sensor_type, sensor_index) )
+    {
+        reportError("SensorsMeasurements", "getMeasurementView", "Unknown sensor type or sensor index out of bounds.");
+        return Span<double>();
+    }
+
+    return make_span(this->pimpl->measurement(sensor_type, sensor_index), getSensorTypeSize(sensor_type));
 }
 
-size_t SensorsMeasurements::getSizeOfAllSensorsMeasurements() const
+Span<const double> SensorsMeasurements::getMeasurementView(const SensorType& sensor_type,
+                                                           const std::ptrdiff_t& sensor_index) const
 {
-    size_t res = 0;
-    for(int i=(int)SIX_AXIS_FORCE_TORQUE; i< NR_OF_SENSOR_TYPES; i++)
+    if( !isValidSensorType(sensor_type) || !this->pimpl->isValidSensor(sensor_type, sensor_index) )
     {
-        SensorType type = (SensorType)i;
-        res += getSensorTypeSize(type)*getNrOfSensors(type);
+        reportError("SensorsMeasurements", "getMeasurementView", "Unknown sensor type or sensor index out of bounds.");
+        return Span<const double>();
     }
-    return res;
+
+    return make_span(this->pimpl->measurement(sensor_type, sensor_index), getSensorTypeSize(sensor_type));
+}
+
+std::size_t SensorsMeasurements::getNrOfSensors(const SensorType& sensor_type) const
+{
+    if( !isValidSensorType(sensor_type) )
+    {
+        return 0;
+    }
+
+    return this->pimpl->nrOfSensors[sensor_type];
+}
+
+size_t SensorsMeasurements::getSizeOfAllSensorsMeasurements() const
+{
+    return this->pimpl->buffer.size();
 }
 
 }
@@ -10,6 +10,8 @@
 
 #include <iDynTree/Core/TestUtils.h>
 #include <iDynTree/Core/Transform.h>
+#include <iDynTree/Core/Wrench.h>
+#include <iDynTree/Core/VectorDynSize.h>
 #include <iDynTree/Sensors/Sensors.h>
 #include <iDynTree/Sensors/AccelerometerSensor.h>
 #include <iDynTree/Sensors/SixAxisForceTorqueSensor.h>
@@ -204,11 +206,74 @@ void checkIterator()
 
 }
 
+void checkMeasurementsViews()
+{
+    std::cout << "Checking SensorsMeasurements views... " << std::endl;
+    using namespace iDynTree;
+
+    SensorsMeasurements meas;
+    ASSERT_IS_TRUE(meas.setNrOfSensors(SIX_AXIS_FORCE_TORQUE, 2));
+    ASSERT_IS_TRUE(meas.setNrOfSensors(GYROSCOPE, 3));
+    ASSERT_IS_TRUE(meas.setNrOfSensors(THREE_AXIS_FORCE_TORQUE_CONTACT, 1));
+    ASSERT_EQUAL_DOUBLE(meas.getSizeOfAllSensorsMeasurements(), 2*6 + 3*3 + 3);
+
+    Wrench ft1 = getRandomWrench();
+    Vector3 gyro2;
+    getRandomVector(gyro2);
+    ASSERT_IS_TRUE(meas.setMeasurement(SIX_AXIS_FORCE_TORQUE, 1, ft1));
+    ASSERT_IS_TRUE(meas.setMeasurement(GYROSCOPE, 2, gyro2));
+    ASSERT_IS_FALSE(meas.setMeasurement(GYROSCOPE, 3, gyro2));
+    ASSERT_IS_FALSE(meas.setMeasurement(SIX_AXIS_FORCE_TORQUE, 0, gyro2));
+
+    // The views share the memory of the measurements
+    MatrixView<double> ftView = meas.getMeasurementsView(SIX_AXIS_FORCE_TORQUE);
+    ASSERT_EQUAL_DOUBLE(ftView.rows(), 2);
+    ASSERT_EQUAL_DOUBLE(ftView.cols(), 6);
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_EQUAL_DOUBLE(ftView(1, i), ft1.getVal(i));
+    }
+
+    Span<double> gyroView = meas.getMeasurementView(GYROSCOPE, 2);
+    ASSERT_EQUAL_DOUBLE(gyroView.size(), 3);
+    ASSERT_EQUAL_VECTOR(gyroView, gyro2);
+    gyroView(0) = 42.0;
+    Vector3 gyro2Read;
+    ASSERT_IS_TRUE(meas.getMeasurement(GYROSCOPE, 2, gyro2Read));
+    ASSERT_EQUAL_DOUBLE(gyro2Read(0), 42.0);
+    ASSERT_EQUAL_DOUBLE(meas.getMeasurementView(GYROSCOPE, 3).size(), 0);
+
+    // The buffer has the same layout of toVector
+    Span<double> buffer = meas.getMeasurementsBuffer();
+    ASSERT_EQUAL_DOUBLE(meas.getMeasurementsBufferOffset(GYROSCOPE), 12);
+    ASSERT_IS_TRUE(gyroView.data() == buffer.data() + 12 + 2*3);
+    VectorDynSize measVector;
+    ASSERT_IS_TRUE(meas.toVector(measVector));
+    ASSERT_EQUAL_VECTOR(measVector, buffer);
+
+    // Adding sensors preserves the existing measurements
+    ASSERT_IS_TRUE(meas.setNrOfSensors(ACCELEROMETER, 4));
+    Wrench ft1Read;
+    ASSERT_IS_TRUE(meas.getMeasurement(SIX_AXIS_FORCE_TORQUE, 1, ft1Read));
+    ASSERT_EQUAL_VECTOR(ft1Read.asVector(), ft1.asVector());
+    ASSERT_IS_TRUE(meas.getMeasurement(GYROSCOPE, 2, gyro2Read));
+    ASSERT_EQUAL_DOUBLE(gyro2Read(0), 42.0);
+    ASSERT_EQUAL_DOUBLE(meas.getMeasurementsView(ACCELEROMETER).rows(), 4);
+    ASSERT_EQUAL_DOUBLE(meas.getMeasurementsBufferOffset(GYROSCOPE), 12 + 4*3);
+
+    // Setting the same number of sensors does not reallocate the buffer
+    const double* bufferData = meas.getMeasurementsBuffer().data();
+    ASSERT_IS_TRUE(meas.setNrOfSensors(ACCELEROMETER, 4));
+    ASSERT_IS_TRUE(meas.getMeasurementsBuffer().data() == bufferData);
+    ASSERT_IS_TRUE(meas.getMeasurement(GYROSCOPE, 2, gyro2Read));
+    ASSERT_EQUAL_DOUBLE(gyro2Read(0), 42.0);
+}
 
 int main()
 {
     checkList();
     checkIterator();
+    checkMeasurementsViews();
 
     return EXIT_SUCCESS;
 }
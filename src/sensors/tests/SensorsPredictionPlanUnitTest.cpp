@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2020 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/Sensors/PredictSensorsMeasurements.h>
+#include <iDynTree/Sensors/AccelerometerSensor.h>
+#include <iDynTree/Sensors/GyroscopeSensor.h>
+#include <iDynTree/Sensors/ThreeAxisAngularAccelerometerSensor.h>
+#include <iDynTree/Sensors/SixAxisForceTorqueSensor.h>
+#include <iDynTree/Sensors/Sensors.h>
+
+#include <iDynTree/Model/Model.h>
+#include <iDynTree/Model/ModelTestUtils.h>
+#include <iDynTree/Model/Traversal.h>
+#include <iDynTree/Model/FreeFloatingState.h>
+
+#include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Core/VectorDynSize.h>
+
+#include <cstdlib>
+
+using namespace iDynTree;
+
+SensorsList getRandomSensorsList(const Model& model)
+{
+    SensorsList sensors;
+
+    for (JointIndex jnt = 0; jnt < static_cast<JointIndex>(model.getNrOfJoints()); jnt += 2)
+    {
+        IJointConstPtr joint = model.getJoint(jnt);
+        LinkIndex firstLink = joint->getFirstAttachedLink();
+        LinkIndex secondLink = joint->getSecondAttachedLink();
+
+        SixAxisForceTorqueSensor ft;
+        ft.setName("ft" + int2string(jnt));
+        ft.setParentJoint(model.getJointName(jnt));
+        ft.setParentJointIndex(jnt);
+        ft.setFirstLinkName(model.getLinkName(firstLink));
+        ft.setSecondLinkName(model.getLinkName(secondLink));
+        ft.setFirstLinkSensorTransform(firstLink, getRandomTransform());
+        ft.setSecondLinkSensorTransform(secondLink, getRandomTransform());
+        ft.setAppliedWrenchLink((jnt % 4 == 0) ? firstLink : secondLink);
+        sensors.addSensor(ft);
+    }
+
+    for (int i = 0; i < 5; i++)
+    {
+        LinkIndex link = getRandomLinkIndexOfModel(model);
+
+        AccelerometerSensor acc;
+        acc.setName("acc" + int2string(i));
+        acc.setParentLink(model.getLinkName(link));
+        acc.setParentLinkIndex(link);
+        acc.setLinkSensorTransform(getRandomTransform());
+        sensors.addSensor(acc);
+
+        GyroscopeSensor gyro;
+        gyro.setName("gyro" + int2string(i));
+        gyro.setParentLink(model.getLinkName(link));
+        gyro.setParentLinkIndex(link);
+        gyro.setLinkSensorTransform(getRandomTransform());
+        sensors.addSensor(gyro);
+
+        ThreeAxisAngularAccelerometerSensor angAcc;
+        angAcc.setName("angAcc" + int2string(i));
+        angAcc.setParentLink(model.getLinkName(link));
+        angAcc.setParentLinkIndex(link);
+        angAcc.setLinkSensorTransform(getRandomTransform());
+        sensors.addSensor(angAcc);
+    }
+
+    return sensors;
+}
+
+void checkPredictionPlanIsConsistentWithRawBuffersPrediction()
+{
+    Model model = getRandomModel(20);
+    Traversal traversal;
+    model.computeFullTreeTraversal(traversal);
+    SensorsList sensors = getRandomSensorsList(model);
+
+    LinkVelArray linkVel(model);
+    LinkAccArray linkProperAcc(model);
+    LinkInternalWrenches internalWrenches(model);
+    for (size_t l = 0; l < model.getNrOfLinks(); l++)
+    {
+        linkVel(l) = getRandomTwist();
+        linkProperAcc(l) = getRandomTwist();
+        internalWrenches(l) = getRandomWrench();
+    }
+
+    SensorsMeasurements expected(sensors);
+    bool ok = predictSensorsMeasurementsFromRawBuffers(model, sensors, traversal, linkVel,
+                                                       linkProperAcc, internalWrenches, expected);
+    ASSERT_IS_TRUE(ok);
+    VectorDynSize expectedVector;
+    expected.toVector(expectedVector);
+
+    SensorsPredictionPlan plan;
+    ASSERT_IS_TRUE(plan.init(model, sensors, traversal));
+    ASSERT_IS_TRUE(plan.isValid());
+    ASSERT_EQUAL_DOUBLE(plan.getSizeOfAllSensorsMeasurements(), expected.getSizeOfAllSensorsMeasurements());
+
+    VectorDynSize predictedBuffer(plan.getSizeOfAllSensorsMeasurements());
+    ASSERT_IS_TRUE(plan.predictSensorsMeasurements(linkVel, linkProperAcc, internalWrenches, make_span(predictedBuffer)));
+    ASSERT_EQUAL_VECTOR(predictedBuffer, expectedVector);
+
+    SensorsMeasurements predicted(sensors);
+    ASSERT_IS_TRUE(plan.predictSensorsMeasurements(linkVel, linkProperAcc, internalWrenches, predicted));
+    VectorDynSize predictedVector;
+    predicted.toVector(predictedVector);
+    ASSERT_EQUAL_VECTOR(predictedVector, expectedVector);
+
+    // A buffer of the wrong size is rejected
+    VectorDynSize wrongBuffer(plan.getSizeOfAllSensorsMeasurements() + 1);
+    ASSERT_IS_FALSE(plan.predictSensorsMeasurements(linkVel, linkProperAcc, internalWrenches, make_span(wrongBuffer)));
+
+    // A sensor that is not attached to the model is rejected
+    AccelerometerSensor detachedAcc;
+    detachedAcc.setName("detachedAcc");
+    detachedAcc.setParentLinkIndex(static_cast<LinkIndex>(model.getNrOfLinks()));
+    sensors.addSensor(detachedAcc);
+    ASSERT_IS_FALSE(plan.init(model, sensors, traversal));
+    ASSERT_IS_FALSE(plan.isValid());
+}
+
+int main()
+{
+    for (int i = 0; i < 10; i++)
+    {
+        checkPredictionPlanIsConsistentWithRawBuffersPrediction();
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2016 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef IDYNTREE_COLLISION_COMPUTATIONS_H
+#define IDYNTREE_COLLISION_COMPUTATIONS_H
+
+#include <iDynTree/Core/Direction.h>
+#include <iDynTree/Core/MatrixView.h>
+#include <iDynTree/Core/Position.h>
+#include <iDynTree/Core/Transform.h>
+#include <iDynTree/Model/Indices.h>
+
+#include <memory>
+#include <string>
+
+namespace iDynTree
+{
+    class KinDynComputations;
+    class Model;
+    class SolidShape;
+
+    /**
+     * Distance between two collision shapes, computed by CollisionComputations.
+     *
+     * The first shape always belongs to a link of the model, while the second one
+     * can belong to a link or to the environment.
+     */
+    struct CollisionPair
+    {
+        /**
+         * Link of the first shape, and index of the shape in the collision shapes of the link
+         * (see Model::collisionSolidShapes).
+         */
+        LinkIndex firstLink;
+        size_t firstShape;
+
+        /**
+         * Link of the second shape, and index of the shape in the collision shapes of the link.
+         * If the shape belongs to the environment, secondLink is LINK_INVALID_INDEX and
+         * secondShape is the index returned by CollisionComputations::addEnvironmentShape.
+         */
+        LinkIndex secondLink;
+        size_t secondShape;
+
+        /**
+         * Distance between the shapes, negative if the shapes are penetrating.
+         * In that case, its absolute value is the penetration depth.
+         */
+        double distance;
+
+        /**
+         * Closest points of the two shapes (witness points), expressed in the world frame.
+         * If the shapes are penetrating, they are the deepest points of each shape inside the other one.
+         */
+        Position firstPoint;
+        Position secondPoint;
+
+        /**
+         * Direction (expressed in the world frame) along which moving the second shape
+         * w.r.t. the first one increases the distance.
+         */
+        Direction normal;
+    };
+
+    /**
+     * @brief Class computing the distances between the collision shapes of a model and of its environment.
+     *
+     * The collision shapes are the ones returned by Model::collisionSolidShapes. The spheres,
+     * the boxes and the cylinders are handled exactly, while the external meshes are loaded
+     * with Assimp (if IDYNTREE_USES_ASSIMP is enabled) and approximated by their convex hull.
+     * The external meshes are ignored if IDYNTREE_USES_ASSIMP is disabled.
+     *
+     * The pose of the shapes is read from a KinDynComputations object with updateShapesPoses().
+     * Then computeDistances() finds the pairs of shapes whose axis aligned bounding boxes are closer than a
+     * given distance with a sweep and prune along the x axis, whose ordering is updated incrementally
+     * from the previous call. The distance of these pairs is computed in closed form if one of the shapes is
+     * a sphere, and with GJK (and EPA, if the shapes are penetrating) otherwise.
+     *
+     * The pairs of shapes belonging to the same link, and to links connected by a joint,
+     * are not checked. This can be changed with setCollisionAllowed().
+     *
+     * Example
+     * @code
+     * iDynTree::CollisionComputations collisions;
+     * collisions.loadModel(kinDyn.model());
+     * collisions.addEnvironmentShape(table, world_H_table);
+     * // in the control loop
+     * collisions.updateShapesPoses(kinDyn);
+     * collisions.computeDistances(0.05);
+     * for (size_t i = 0; i < collisions.getNrOfCollisionPairs(); i++) {
+     *     collisions.getDistanceJacobian(kinDyn, i, distanceJacobian);
+     * }
+     * @endcode
+     *
+     * @warning This class is still in active development, and so API interface can change between iDynTree versions.
+     */
+    class CollisionComputations
+    {
+    private:
+        struct CollisionComputationsPrivateAttributes;
+        std::unique_ptr<CollisionComputationsPrivateAttributes> pimpl;
+
+    public:
+        CollisionComputations();
+        ~CollisionComputations();
+
+        CollisionComputations(const CollisionComputations& other) = delete;
+        CollisionComputations& operator=(const CollisionComputations& other) = delete;
+
+        /**
+         * Load the collision shapes of a model, and compute the pairs of links whose collisions are allowed.
+         *
+         * The environment shapes are removed.
+         *
+         * @return true if all went well, false otherwise.
+         */
+        bool loadModel(const Model& model);
+
+        /**
+         * Return true if a model has been loaded, false otherwise.
+         */
+        bool isValid() const;
+
+        /**
+         * Get the number of shapes attached to the links of the model.
+         */
+        size_t getNrOfLinkShapes() const;
+
+        /**
+         * Allow (or forbid) the collisions between two links, i.e. do not check (or check) the distances between their shapes.
+         *
+         * @return true if all went well, false if a link does not exist.
+         */
+        bool setCollisionAllowed(const std::string& firstLink, const std::string& secondLink, const bool allowed);
+
+        /**
+         * Version of setCollisionAllowed where the links are specified by index.
+         */
+        bool setCollisionAllowed(const LinkIndex firstLink, const LinkIndex secondLink, const bool allowed);
+
+        /**
+         * Return true if the collisions between two links are allowed, i.e. their distance is not checked.
+         */
+        bool isCollisionAllowed(const LinkIndex firstLink, const LinkIndex secondLink) const;
+
+        /**
+         * Add a shape of the environment.
+         *
+         * @param shape the shape, whose pose w.r.t. world_H_frame is given by SolidShape::getLink_H_geometry.
+         * @param world_H_frame pose w.r.t. the world of the frame to which the shape is attached.
+         * @return the index of the shape in the environment.
+         * @note the shape is copied, and it does not need to exist after the call.
+         */
+        size_t addEnvironmentShape(const SolidShape& shape, const Transform& world_H_frame);
+
+        /**
+         * Update the pose of a shape of the environment.
+         *
+         * @return true if all went well, false if the shape does not exist.
+         */
+        bool setEnvironmentShapeTransform(const size_t shapeIndex, const Transform& world_H_frame);
+
+        /**
+         * Get the number of shapes of the environment.
+         */
+        size_t getNrOfEnvironmentShapes() const;
+
+        /**
+         * Remove all the shapes of the environment.
+         */
+        void clearEnvironmentShapes();
+
+        /**
+         * Update the pose of the shapes of the links from the state of a KinDynComputations object.
+         *
+         * @param kinDyn a KinDynComputations object, in which the same model of loadModel has been loaded.
+         * @return true if all went well, false otherwise.
+         */
+        bool updateShapesPoses(KinDynComputations& kinDyn);
+
+        /**
+         * Compute the distances between the pairs of shapes that are closer than maxDistance.
+         *
+         * The pairs of shapes whose bounding boxes are closer than maxDistance are returned, even if
+         * the distance between the shapes is greater than maxDistance.
+         *
+         * @param maxDistance maximum distance between the shapes, in meters.
+         * @return true if all went well, false if the computation of some distances did not converge.
+         */
+        bool computeDistances(const double maxDistance);
+
+        /**
+         * Get the number of pairs whose distance has been computed by the last call to computeDistances().
+         */
+        size_t getNrOfCollisionPairs() const;
+
+        /**
+         * Get a pair whose distance has been computed by the last call to computeDistances().
+         *
+         * @warning the pairs are not sorted, and their order can change between two calls.
+         */
+        const CollisionPair& getCollisionPair(const size_t pairIndex) const;
+
+        /**
+         * Get the minimum distance between the pairs computed by the last call to computeDistances(),
+         * or infinity if there is no pair.
+         */
+        double getMinimumDistance() const;
+
+        /**
+         * Get the Jacobian of the distance of a pair, i.e. the 1 x (6+getNrOfDOFs()) matrix
+         * that multiplied by the velocity of the model gives the time derivative of the distance.
+         *
+         * The velocity of the model is the one of kinDyn, in its FrameVelocityRepresentation.
+         * The witness points are considered fixed w.r.t. their links.
+         *
+         * @param kinDyn the KinDynComputations object used to update the pose of the shapes.
+         * @return true if all went well, false otherwise.
+         */
+        bool getDistanceJacobian(KinDynComputations& kinDyn, const size_t pairIndex, MatrixView<double> distanceJacobian);
+
+        /**
+         * Get the Jacobians of the witness points of a pair, i.e. the 3 x (6+getNrOfDOFs()) matrices
+         * that multiplied by the velocity of the model give the linear velocity of the points
+         * (attached to their links) expressed in the world frame.
+         *
+         * The Jacobian of a point of the environment is zero.
+         *
+         * @return true if all went well, false otherwise.
+         */
+        bool getWitnessPointsJacobians(KinDynComputations& kinDyn,
+                                       const size_t pairIndex,
+                                       MatrixView<double> firstPointJacobian,
+                                       MatrixView<double> secondPointJacobian);
+    };
+}
+
+#endif
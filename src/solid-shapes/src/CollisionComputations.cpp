@@ -0,0 +1,581 @@
+/*
+ * Copyright (C) 2016 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#include <iDynTree/CollisionComputations.h>
+#include <iDynTree/KinDynComputations.h>
+
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/MatrixDynSize.h>
+#include <iDynTree/Core/Utils.h>
+
+#include <iDynTree/Model/Model.h>
+#include <iDynTree/Model/SolidShapes.h>
+
+#include "ConvexShapesDistance.h"
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#ifdef IDYNTREE_USES_ASSIMP
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#endif
+
+namespace iDynTree
+{
+
+#ifdef IDYNTREE_USES_ASSIMP
+// Defined in InertialParametersSolidShapesHelpers.cpp
+void buildMesh(const aiScene* scene, const aiNode* node, const double scale, std::vector<aiVector3D>& vertexVector);
+#endif
+
+namespace
+{
+    /**
+     * Convert a SolidShape to the representation used for the distance computations.
+     */
+    bool convertSolidShape(const SolidShape& solidShape, ConvexShape& shape)
+    {
+        shape.frame_R_shape = toEigen(solidShape.getLink_H_geometry().getRotation());
+        shape.frame_p_shape = toEigen(solidShape.getLink_H_geometry().getPosition());
+
+        if (solidShape.isSphere())
+        {
+            shape.type = ConvexShape::SphereType;
+            shape.radius = solidShape.asSphere()->getRadius();
+            return true;
+        }
+
+        if (solidShape.isBox())
+        {
+            const Box* box = solidShape.asBox();
+            shape.type = ConvexShape::BoxType;
+            shape.halfExtents = 0.5 * Eigen::Vector3d(box->getX(), box->getY(), box->getZ());
+            return true;
+        }
+
+        if (solidShape.isCylinder())
+        {
+            const Cylinder* cylinder = solidShape.asCylinder();
+            shape.type = ConvexShape::CylinderType;
+            shape.radius = cylinder->getRadius();
+            shape.halfLength = 0.5 * cylinder->getLength();
+            return true;
+        }
+
+        if (solidShape.isExternalMesh())
+        {
+#ifdef IDYNTREE_USES_ASSIMP
+            const ExternalMesh* mesh = solidShape.asExternalMesh();
+            Assimp::Importer importer;
+            const aiScene* scene = importer.ReadFile(mesh->getFilename().c_str(), 0);
+            if (!scene)
+            {
+                std::stringstream ss;
+                ss << "Impossible to load mesh " << mesh->getFilename() << " using the Assimp library.";
+                reportError("CollisionComputations", "loadModel", ss.str().c_str());
+                return false;
+            }
+
+            std::vector<aiVector3D> vertices;
+            buildMesh(scene, scene->mRootNode, 1.0, vertices);
+            if (vertices.empty())
+            {
+                return false;
+            }
+
+            Eigen::Vector3d scale = toEigen(mesh->getScale());
+            shape.type = ConvexShape::MeshType;
+            shape.vertices.resize(vertices.size());
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                shape.vertices[i] = scale.cwiseProduct(Eigen::Vector3d(vertices[i].x, vertices[i].y, vertices[i].z));
+            }
+            shape.verticesMin = shape.vertices[0];
+            shape.verticesMax = shape.vertices[0];
+            for (size_t i = 1; i < shape.vertices.size(); i++)
+            {
+                shape.verticesMin = shape.verticesMin.cwiseMin(shape.vertices[i]);
+                shape.verticesMax = shape.verticesMax.cwiseMax(shape.vertices[i]);
+            }
+            return true;
+#else
+            reportWarning("CollisionComputations", "loadModel",
+                          "External meshes are supported only if IDYNTREE_USES_ASSIMP is enabled, the mesh will be ignored.");
+            return false;
+#endif
+        }
+
+        return false;
+    }
+}
+
+struct CollisionComputations::CollisionComputationsPrivateAttributes
+{
+    bool isValid;
+    size_t nrOfLinks;
+    size_t nrOfDOFs;
+
+    /**
+     * Shapes of the links, ordered by link, followed by the shapes of the environment.
+     */
+    std::vector<ConvexShape> shapes;
+    std::vector<LinkIndex> shapesLinks;
+    std::vector<size_t> shapesIndices;
+    size_t nrOfLinkShapes;
+
+    /**
+     * Links with at least a shape. The shapes of the i-th link are the ones in
+     * [linksShapesOffsets[i], linksShapesOffsets[i+1]).
+     */
+    std::vector<LinkIndex> linksWithShapes;
+    std::vector<size_t> linksShapesOffsets;
+
+    /**
+     * nrOfLinks x nrOfLinks matrix of the pairs of links whose collisions are not checked.
+     */
+    std::vector<bool> allowedCollisions;
+    std::vector<std::string> linkNames;
+
+    /**
+     * Shapes ordered by the minimum x of their bounding box, updated at each computeDistances.
+     */
+    std::vector<size_t> sortedShapes;
+
+    std::vector<CollisionPair> pairs;
+
+    MatrixDynSize linkJacobian;
+    MatrixDynSize firstPointJacobian;
+    MatrixDynSize secondPointJacobian;
+
+    CollisionComputationsPrivateAttributes(): isValid(false), nrOfLinks(0), nrOfDOFs(0), nrOfLinkShapes(0)
+    {
+    }
+
+    void addShape(const ConvexShape& shape, const LinkIndex link, const size_t shapeIndex)
+    {
+        shapes.push_back(shape);
+        shapesLinks.push_back(link);
+        shapesIndices.push_back(shapeIndex);
+        sortedShapes.push_back(shapes.size() - 1);
+    }
+
+    bool checkPairIndex(const size_t pairIndex, const char* methodName) const
+    {
+        if (pairIndex >= pairs.size())
+        {
+            std::stringstream ss;
+            ss << "Pair " << pairIndex << " not found, the last call to computeDistances found " << pairs.size() << " pairs.";
+            reportError("CollisionComputations", methodName, ss.str().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Compute the Jacobian of a point attached to a link, given in the world frame.
+     */
+    bool computePointJacobian(KinDynComputations& kinDyn,
+                              const LinkIndex link,
+                              const Eigen::Vector3d& point,
+                              MatrixDynSize& pointJacobian)
+    {
+        pointJacobian.resize(3, 6 + nrOfDOFs);
+        if (link == LINK_INVALID_INDEX)
+        {
+            pointJacobian.zero();
+            return true;
+        }
+
+        if (!kinDyn.getFrameFreeFloatingJacobian(link, linkJacobian))
+        {
+            return false;
+        }
+
+        Transform world_H_link = kinDyn.getWorldTransform(link);
+        Eigen::Vector3d linkToPoint = point - toEigen(world_H_link.getPosition());
+        iDynTreeEigenMatrixMap jacobian = toEigen(linkJacobian);
+
+        // The velocity of the point is v + omega x (p - o), with v the velocity
+        // of the point o whose coordinates depend on the representation
+        switch (kinDyn.getFrameVelocityRepresentation())
+        {
+        case MIXED_REPRESENTATION:
+            toEigen(pointJacobian) = jacobian.topRows<3>() - skew(linkToPoint) * jacobian.bottomRows<3>();
+            break;
+        case INERTIAL_FIXED_REPRESENTATION:
+            toEigen(pointJacobian) = jacobian.topRows<3>() - skew(point) * jacobian.bottomRows<3>();
+            break;
+        case BODY_FIXED_REPRESENTATION:
+        {
+            Eigen::Matrix3d world_R_link = toEigen(world_H_link.getRotation());
+            Eigen::Vector3d linkToPointInLink = world_R_link.transpose() * linkToPoint;
+            toEigen(pointJacobian) = world_R_link * (jacobian.topRows<3>() - skew(linkToPointInLink) * jacobian.bottomRows<3>());
+            break;
+        }
+        }
+
+        return true;
+    }
+};
+
+CollisionComputations::CollisionComputations(): pimpl(new CollisionComputationsPrivateAttributes)
+{
+}
+
+CollisionComputations::~CollisionComputations()
+{
+}
+
+bool CollisionComputations::loadModel(const Model& model)
+{
+    pimpl->isValid = false;
+    pimpl->nrOfLinks = model.getNrOfLinks();
+    pimpl->nrOfDOFs = model.getNrOfDOFs();
+    pimpl->shapes.clear();
+    pimpl->shapesLinks.clear();
+    pimpl->shapesIndices.clear();
+    pimpl->sortedShapes.clear();
+    pimpl->linksWithShapes.clear();
+    pimpl->linksShapesOffsets.clear();
+    pimpl->pairs.clear();
+
+    const std::vector<std::vector<SolidShape*> >& linkSolidShapes = model.collisionSolidShapes().getLinkSolidShapes();
+    for (LinkIndex link = 0; link < static_cast<LinkIndex>(std::min(pimpl->nrOfLinks, linkSolidShapes.size())); link++)
+    {
+        size_t offset = pimpl->shapes.size();
+        for (size_t i = 0; i < linkSolidShapes[link].size(); i++)
+        {
+            ConvexShape shape;
+            if (!linkSolidShapes[link][i] || !convertSolidShape(*linkSolidShapes[link][i], shape))
+            {
+                std::stringstream ss;
+                ss << "Shape " << i << " of link " << model.getLinkName(link) << " is not supported, it will be ignored.";
+                reportWarning("CollisionComputations", "loadModel", ss.str().c_str());
+                continue;
+            }
+            pimpl->addShape(shape, link, i);
+        }
+
+        if (pimpl->shapes.size() > offset)
+        {
+            pimpl->linksWithShapes.push_back(link);
+            pimpl->linksShapesOffsets.push_back(offset);
+        }
+    }
+    pimpl->nrOfLinkShapes = pimpl->shapes.size();
+    pimpl->linksShapesOffsets.push_back(pimpl->nrOfLinkShapes);
+
+    // The links connected by a joint usually intersect, so their collisions are allowed
+    pimpl->allowedCollisions.assign(pimpl->nrOfLinks * pimpl->nrOfLinks, false);
+    for (JointIndex joint = 0; joint < static_cast<JointIndex>(model.getNrOfJoints()); joint++)
+    {
+        setCollisionAllowed(model.getJoint(joint)->getFirstAttachedLink(), model.getJoint(joint)->getSecondAttachedLink(), true);
+    }
+
+    pimpl->linkJacobian.resize(6, 6 + pimpl->nrOfDOFs);
+    pimpl->firstPointJacobian.resize(3, 6 + pimpl->nrOfDOFs);
+    pimpl->secondPointJacobian.resize(3, 6 + pimpl->nrOfDOFs);
+    pimpl->linkNames.clear();
+    for (LinkIndex link = 0; link < static_cast<LinkIndex>(pimpl->nrOfLinks); link++)
+    {
+        pimpl->linkNames.push_back(model.getLinkName(link));
+    }
+
+    pimpl->isValid = true;
+    return true;
+}
+
+bool CollisionComputations::isValid() const
+{
+    return pimpl->isValid;
+}
+
+size_t CollisionComputations::getNrOfLinkShapes() const
+{
+    return pimpl->nrOfLinkShapes;
+}
+
+bool CollisionComputations::setCollisionAllowed(const std::string& firstLink, const std::string& secondLink, const bool allowed)
+{
+    std::vector<std::string>::const_iterator first = std::find(pimpl->linkNames.begin(), pimpl->linkNames.end(), firstLink);
+    std::vector<std::string>::const_iterator second = std::find(pimpl->linkNames.begin(), pimpl->linkNames.end(), secondLink);
+    if (first == pimpl->linkNames.end() || second == pimpl->linkNames.end())
+    {
+        std::stringstream ss;
+        ss << "Link " << (first == pimpl->linkNames.end() ? firstLink : secondLink) << " not found in the model.";
+        reportError("CollisionComputations", "setCollisionAllowed", ss.str().c_str());
+        return false;
+    }
+
+    return setCollisionAllowed(static_cast<LinkIndex>(first - pimpl->linkNames.begin()),
+                               static_cast<LinkIndex>(second - pimpl->linkNames.begin()),
+                               allowed);
+}
+
+bool CollisionComputations::setCollisionAllowed(const LinkIndex firstLink, const LinkIndex secondLink, const bool allowed)
+{
+    if (firstLink < 0 || secondLink < 0 ||
+        static_cast<size_t>(firstLink) >= pimpl->nrOfLinks || static_cast<size_t>(secondLink) >= pimpl->nrOfLinks)
+    {
+        reportError("CollisionComputations", "setCollisionAllowed", "Link index out of bounds.");
+        return false;
+    }
+
+    pimpl->allowedCollisions[firstLink * pimpl->nrOfLinks + secondLink] = allowed;
+    pimpl->allowedCollisions[secondLink * pimpl->nrOfLinks + firstLink] = allowed;
+    return true;
+}
+
+bool CollisionComputations::isCollisionAllowed(const LinkIndex firstLink, const LinkIndex secondLink) const
+{
+    if (firstLink < 0 || secondLink < 0 ||
+        static_cast<size_t>(firstLink) >= pimpl->nrOfLinks || static_cast<size_t>(secondLink) >= pimpl->nrOfLinks)
+    {
+        return false;
+    }
+
+    return firstLink == secondLink || pimpl->allowedCollisions[firstLink * pimpl->nrOfLinks + secondLink];
+}
+
+size_t CollisionComputations::addEnvironmentShape(const SolidShape& shape, const Transform& world_H_frame)
+{
+    ConvexShape convexShape;
+    if (!convertSolidShape(shape, convexShape))
+    {
+        // Keep the indices of the environment shapes consistent with the calls, with a shape that does not collide
+        reportWarning("CollisionComputations", "addEnvironmentShape", "Shape not supported, it will be ignored.");
+        convexShape.type = ConvexShape::SphereType;
+        convexShape.radius = -std::numeric_limits<double>::infinity();
+    }
+
+    size_t shapeIndex = getNrOfEnvironmentShapes();
+    pimpl->addShape(convexShape, LINK_INVALID_INDEX, shapeIndex);
+    setEnvironmentShapeTransform(shapeIndex, world_H_frame);
+    return shapeIndex;
+}
+
+bool CollisionComputations::setEnvironmentShapeTransform(const size_t shapeIndex, const Transform& world_H_frame)
+{
+    if (shapeIndex >= getNrOfEnvironmentShapes())
+    {
+        reportError("CollisionComputations", "setEnvironmentShapeTransform", "Environment shape index out of bounds.");
+        return false;
+    }
+
+    pimpl->shapes[pimpl->nrOfLinkShapes + shapeIndex].setFramePose(toEigen(world_H_frame.getRotation()),
+                                                                   toEigen(world_H_frame.getPosition()));
+    return true;
+}
+
+size_t CollisionComputations::getNrOfEnvironmentShapes() const
+{
+    return pimpl->shapes.size() - pimpl->nrOfLinkShapes;
+}
+
+void CollisionComputations::clearEnvironmentShapes()
+{
+    pimpl->shapes.resize(pimpl->nrOfLinkShapes);
+    pimpl->shapesLinks.resize(pimpl->nrOfLinkShapes);
+    pimpl->shapesIndices.resize(pimpl->nrOfLinkShapes);
+    pimpl->sortedShapes.erase(std::remove_if(pimpl->sortedShapes.begin(), pimpl->sortedShapes.end(),
+                                             [this](size_t shape) { return shape >= pimpl->nrOfLinkShapes; }),
+                              pimpl->sortedShapes.end());
+    pimpl->pairs.clear();
+}
+
+bool CollisionComputations::updateShapesPoses(KinDynComputations& kinDyn)
+{
+    if (!pimpl->isValid)
+    {
+        reportError("CollisionComputations", "updateShapesPoses", "Model not loaded.");
+        return false;
+    }
+
+    if (kinDyn.model().getNrOfLinks() != pimpl->nrOfLinks || kinDyn.getNrOfDegreesOfFreedom() != pimpl->nrOfDOFs)
+    {
+        reportError("CollisionComputations", "updateShapesPoses",
+                    "The model of the KinDynComputations object is not the one passed to loadModel.");
+        return false;
+    }
+
+    for (size_t i = 0; i < pimpl->linksWithShapes.size(); i++)
+    {
+        Transform world_H_link = kinDyn.getWorldTransform(pimpl->linksWithShapes[i]);
+        Eigen::Matrix3d world_R_link = toEigen(world_H_link.getRotation());
+        Eigen::Vector3d world_p_link = toEigen(world_H_link.getPosition());
+        for (size_t shape = pimpl->linksShapesOffsets[i]; shape < pimpl->linksShapesOffsets[i + 1]; shape++)
+        {
+            pimpl->shapes[shape].setFramePose(world_R_link, world_p_link);
+        }
+    }
+
+    return true;
+}
+
+bool CollisionComputations::computeDistances(const double maxDistance)
+{
+    if (!pimpl->isValid)
+    {
+        reportError("CollisionComputations", "computeDistances", "Model not loaded.");
+        return false;
+    }
+
+    pimpl->pairs.clear();
+    const std::vector<ConvexShape>& shapes = pimpl->shapes;
+    std::vector<size_t>& sortedShapes = pimpl->sortedShapes;
+
+    // The shapes move slightly between two calls, so the previous ordering is almost sorted
+    for (size_t i = 1; i < sortedShapes.size(); i++)
+    {
+        size_t shape = sortedShapes[i];
+        size_t j = i;
+        while (j > 0 && shapes[sortedShapes[j - 1]].aabbMin(0) > shapes[shape].aabbMin(0))
+        {
+            sortedShapes[j] = sortedShapes[j - 1];
+            j--;
+        }
+        sortedShapes[j] = shape;
+    }
+
+    bool ok = true;
+    ConvexShapesDistance distance;
+    for (size_t i = 0; i < sortedShapes.size(); i++)
+    {
+        size_t first = sortedShapes[i];
+        for (size_t j = i + 1; j < sortedShapes.size(); j++)
+        {
+            size_t second = sortedShapes[j];
+            if (shapes[second].aabbMin(0) > shapes[first].aabbMax(0) + maxDistance)
+            {
+                break;
+            }
+
+            if (shapes[second].aabbMin(1) > shapes[first].aabbMax(1) + maxDistance ||
+                shapes[first].aabbMin(1) > shapes[second].aabbMax(1) + maxDistance ||
+                shapes[second].aabbMin(2) > shapes[first].aabbMax(2) + maxDistance ||
+                shapes[first].aabbMin(2) > shapes[second].aabbMax(2) + maxDistance)
+            {
+                continue;
+            }
+
+            // The first shape of a pair always belongs to a link
+            size_t firstShape = std::min(first, second);
+            size_t secondShape = std::max(first, second);
+            LinkIndex firstLink = pimpl->shapesLinks[firstShape];
+            LinkIndex secondLink = pimpl->shapesLinks[secondShape];
+            if (firstLink == LINK_INVALID_INDEX ||
+                (secondLink != LINK_INVALID_INDEX && isCollisionAllowed(firstLink, secondLink)))
+            {
+                continue;
+            }
+
+            ok = computeConvexShapesDistance(shapes[firstShape], shapes[secondShape], distance) && ok;
+
+            pimpl->pairs.push_back(CollisionPair());
+            CollisionPair& pair = pimpl->pairs.back();
+            pair.firstLink = firstLink;
+            pair.firstShape = pimpl->shapesIndices[firstShape];
+            pair.secondLink = secondLink;
+            pair.secondShape = pimpl->shapesIndices[secondShape];
+            pair.distance = distance.distance;
+            toEigen(pair.firstPoint) = distance.firstPoint;
+            toEigen(pair.secondPoint) = distance.secondPoint;
+            toEigen(pair.normal) = distance.normal;
+        }
+    }
+
+    return ok;
+}
+
+size_t CollisionComputations::getNrOfCollisionPairs() const
+{
+    return pimpl->pairs.size();
+}
+
+const CollisionPair& CollisionComputations::getCollisionPair(const size_t pairIndex) const
+{
+    assert(pairIndex < pimpl->pairs.size());
+    return pimpl->pairs[pairIndex];
+}
+
+double CollisionComputations::getMinimumDistance() const
+{
+    double minimumDistance = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < pimpl->pairs.size(); i++)
+    {
+        minimumDistance = std::min(minimumDistance, pimpl->pairs[i].distance);
+    }
+    return minimumDistance;
+}
+
+bool CollisionComputations::getDistanceJacobian(KinDynComputations& kinDyn,
+                                                const size_t pairIndex,
+                                                MatrixView<double> distanceJacobian)
+{
+    if (!pimpl->checkPairIndex(pairIndex, "getDistanceJacobian"))
+    {
+        return false;
+    }
+
+    if (distanceJacobian.rows() != 1 || distanceJacobian.cols() != static_cast<std::ptrdiff_t>(6 + pimpl->nrOfDOFs))
+    {
+        reportError("CollisionComputations", "getDistanceJacobian", "Wrong size of the output matrix.");
+        return false;
+    }
+
+    const CollisionPair& pair = pimpl->pairs[pairIndex];
+    if (!pimpl->computePointJacobian(kinDyn, pair.firstLink, toEigen(pair.firstPoint), pimpl->firstPointJacobian) ||
+        !pimpl->computePointJacobian(kinDyn, pair.secondLink, toEigen(pair.secondPoint), pimpl->secondPointJacobian))
+    {
+        return false;
+    }
+
+    toEigen(distanceJacobian) = toEigen(pair.normal).transpose()
+                                * (toEigen(pimpl->secondPointJacobian) - toEigen(pimpl->firstPointJacobian));
+    return true;
+}
+
+bool CollisionComputations::getWitnessPointsJacobians(KinDynComputations& kinDyn,
+                                                      const size_t pairIndex,
+                                                      MatrixView<double> firstPointJacobian,
+                                                      MatrixView<double> secondPointJacobian)
+{
+    if (!pimpl->checkPairIndex(pairIndex, "getWitnessPointsJacobians"))
+    {
+        return false;
+    }
+
+    std::ptrdiff_t cols = static_cast<std::ptrdiff_t>(6 + pimpl->nrOfDOFs);
+    if (firstPointJacobian.rows() != 3 || firstPointJacobian.cols() != cols ||
+        secondPointJacobian.rows() != 3 || secondPointJacobian.cols() != cols)
+    {
+        reportError("CollisionComputations", "getWitnessPointsJacobians", "Wrong size of the output matrices.");
+        return false;
+    }
+
+    const CollisionPair& pair = pimpl->pairs[pairIndex];
+    if (!pimpl->computePointJacobian(kinDyn, pair.firstLink, toEigen(pair.firstPoint), pimpl->firstPointJacobian) ||
+        !pimpl->computePointJacobian(kinDyn, pair.secondLink, toEigen(pair.secondPoint), pimpl->secondPointJacobian))
+    {
+        return false;
+    }
+
+    toEigen(firstPointJacobian) = toEigen(pimpl->firstPointJacobian);
+    toEigen(secondPointJacobian) = toEigen(pimpl->secondPointJacobian);
+    return true;
+}
+
+}
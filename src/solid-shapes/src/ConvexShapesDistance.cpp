@@ -0,0 +1,937 @@
+/*
+ * Copyright (C) 2016 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+//For using the M_PI macro in visual studio it
+//is necessary to define _USE_MATH_DEFINES
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+
+#include "ConvexShapesDistance.h"
+
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace iDynTree
+{
+    namespace
+    {
+        const int GJK_MAX_ITERATIONS = 128;
+        const int GJK_MAX_RESTARTS = 8;
+        const int EPA_MAX_ITERATIONS = 128;
+
+        // Tolerance on the distance computed by GJK, relative to the distance itself
+        const double GJK_RELATIVE_TOLERANCE = 1e-10;
+        // Tolerance on the distance computed by GJK if it stalls before reaching GJK_RELATIVE_TOLERANCE
+        const double GJK_ABSOLUTE_TOLERANCE = 1e-6;
+        // Tolerance on the penetration depth computed by EPA
+        const double EPA_TOLERANCE = 1e-8;
+        // Distance between the cores of two shapes with a margin below which EPA is used
+        const double CORE_DISTANCE_TOLERANCE = 1e-6;
+
+        /**
+         * Point of the Minkowski difference first - second, with the points
+         * of the two shapes that generate it.
+         */
+        struct SupportPoint
+        {
+            Eigen::Vector3d w;
+            Eigen::Vector3d first;
+            Eigen::Vector3d second;
+        };
+
+        void computeMinkowskiSupport(const ConvexShape& first,
+                                     const ConvexShape& second,
+                                     const Eigen::Vector3d& direction,
+                                     const bool includeMargin,
+                                     SupportPoint& point)
+        {
+            point.first = first.support(direction, includeMargin);
+            point.second = second.support(-direction, includeMargin);
+            point.w = point.first - point.second;
+        }
+
+        /**
+         * Closest point to the origin of a segment, a triangle or a tetrahedron.
+         *
+         * The simplex is reduced to the vertices of the smallest sub-simplex
+         * that contains the closest point, and lambdas are set to its barycentric coordinates.
+         *
+         * @return false if the origin is inside the tetrahedron, true otherwise.
+         */
+        bool closestPointOfSimplex(SupportPoint* simplex, int& size, double* lambdas, Eigen::Vector3d& closest);
+
+        void setSimplexVertices(SupportPoint* simplex, int& size, const int* indices, const int newSize)
+        {
+            SupportPoint reduced[4];
+            for (int i = 0; i < newSize; i++)
+            {
+                reduced[i] = simplex[indices[i]];
+            }
+            for (int i = 0; i < newSize; i++)
+            {
+                simplex[i] = reduced[i];
+            }
+            size = newSize;
+        }
+
+        void closestPointOfSegment(SupportPoint* simplex, int& size, double* lambdas, Eigen::Vector3d& closest)
+        {
+            const Eigen::Vector3d& a = simplex[0].w;
+            Eigen::Vector3d ab = simplex[1].w - a;
+            double abSquaredNorm = ab.squaredNorm();
+            double t = abSquaredNorm > 0 ? -a.dot(ab) / abSquaredNorm : 0.0;
+
+            if (t <= 0)
+            {
+                size = 1;
+                lambdas[0] = 1.0;
+                closest = simplex[0].w;
+                return;
+            }
+
+            if (t >= 1)
+            {
+                simplex[0] = simplex[1];
+                size = 1;
+                lambdas[0] = 1.0;
+                closest = simplex[0].w;
+                return;
+            }
+
+            lambdas[0] = 1.0 - t;
+            lambdas[1] = t;
+            closest = a + t * ab;
+        }
+
+        // See "Real-Time Collision Detection", C. Ericson, Section 5.1.5
+        void closestPointOfTriangle(SupportPoint* simplex, int& size, double* lambdas, Eigen::Vector3d& closest)
+        {
+            const Eigen::Vector3d& a = simplex[0].w;
+            const Eigen::Vector3d& b = simplex[1].w;
+            const Eigen::Vector3d& c = simplex[2].w;
+            Eigen::Vector3d ab = b - a;
+            Eigen::Vector3d ac = c - a;
+
+            double d1 = -ab.dot(a);
+            double d2 = -ac.dot(a);
+            if (d1 <= 0 && d2 <= 0)
+            {
+                const int indices[] = {0};
+                setSimplexVertices(simplex, size, indices, 1);
+                lambdas[0] = 1.0;
+                closest = simplex[0].w;
+                return;
+            }
+
+            double d3 = -ab.dot(b);
+            double d4 = -ac.dot(b);
+            if (d3 >= 0 && d4 <= d3)
+            {
+                const int indices[] = {1};
+                setSimplexVertices(simplex, size, indices, 1);
+                lambdas[0] = 1.0;
+                closest = simplex[0].w;
+                return;
+            }
+
+            double vc = d1 * d4 - d3 * d2;
+            if (vc <= 0 && d1 >= 0 && d3 <= 0)
+            {
+                double t = d1 / (d1 - d3);
+                closest = a + t * ab;
+                const int indices[] = {0, 1};
+                setSimplexVertices(simplex, size, indices, 2);
+                lambdas[0] = 1.0 - t;
+                lambdas[1] = t;
+                return;
+            }
+
+            double d5 = -ab.dot(c);
+            double d6 = -ac.dot(c);
+            if (d6 >= 0 && d5 <= d6)
+            {
+                const int indices[] = {2};
+                setSimplexVertices(simplex, size, indices, 1);
+                lambdas[0] = 1.0;
+                closest = simplex[0].w;
+                return;
+            }
+
+            double vb = d5 * d2 - d1 * d6;
+            if (vb <= 0 && d2 >= 0 && d6 <= 0)
+            {
+                double t = d2 / (d2 - d6);
+                closest = a + t * ac;
+                const int indices[] = {0, 2};
+                setSimplexVertices(simplex, size, indices, 2);
+                lambdas[0] = 1.0 - t;
+                lambdas[1] = t;
+                return;
+            }
+
+            double va = d3 * d6 - d5 * d4;
+            if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+            {
+                double t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+                closest = b + t * (c - b);
+                const int indices[] = {1, 2};
+                setSimplexVertices(simplex, size, indices, 2);
+                lambdas[0] = 1.0 - t;
+                lambdas[1] = t;
+                return;
+            }
+
+            double denominator = 1.0 / (va + vb + vc);
+            double v = vb * denominator;
+            double w = vc * denominator;
+            lambdas[0] = 1.0 - v - w;
+            lambdas[1] = v;
+            lambdas[2] = w;
+            closest = a + v * ab + w * ac;
+        }
+
+        void closestPointOfTetrahedron(SupportPoint* simplex, int& size, double* lambdas, Eigen::Vector3d& closest, bool& isOriginInside)
+        {
+            // Faces of the tetrahedron, each one with the vertex opposite to it
+            const int faces[4][4] = {{0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+
+            isOriginInside = true;
+            double bestSquaredDistance = std::numeric_limits<double>::infinity();
+            SupportPoint bestSimplex[3];
+            int bestSize = 0;
+            double bestLambdas[3];
+
+            for (int f = 0; f < 4; f++)
+            {
+                const Eigen::Vector3d& a = simplex[faces[f][0]].w;
+                Eigen::Vector3d normal = (simplex[faces[f][1]].w - a).cross(simplex[faces[f][2]].w - a);
+                double originSide = -normal.dot(a);
+                double oppositeSide = normal.dot(simplex[faces[f][3]].w - a);
+
+                // The origin can be closer to the face only if it is not on the same side of the opposite vertex
+                bool isDegenerate = oppositeSide * oppositeSide <= 1e-24 * normal.squaredNorm();
+                if (!isDegenerate && originSide * oppositeSide >= 0)
+                {
+                    continue;
+                }
+
+                isOriginInside = false;
+                SupportPoint face[3] = {simplex[faces[f][0]], simplex[faces[f][1]], simplex[faces[f][2]]};
+                int faceSize = 3;
+                double faceLambdas[3];
+                Eigen::Vector3d faceClosest;
+                closestPointOfTriangle(face, faceSize, faceLambdas, faceClosest);
+
+                if (faceClosest.squaredNorm() < bestSquaredDistance)
+                {
+                    bestSquaredDistance = faceClosest.squaredNorm();
+                    closest = faceClosest;
+                    bestSize = faceSize;
+                    for (int i = 0; i < faceSize; i++)
+                    {
+                        bestSimplex[i] = face[i];
+                        bestLambdas[i] = faceLambdas[i];
+                    }
+                }
+            }
+
+            if (isOriginInside)
+            {
+                closest.setZero();
+                return;
+            }
+
+            size = bestSize;
+            for (int i = 0; i < bestSize; i++)
+            {
+                simplex[i] = bestSimplex[i];
+                lambdas[i] = bestLambdas[i];
+            }
+        }
+
+        bool closestPointOfSimplex(SupportPoint* simplex, int& size, double* lambdas, Eigen::Vector3d& closest)
+        {
+            switch (size)
+            {
+            case 1:
+                lambdas[0] = 1.0;
+                closest = simplex[0].w;
+                return true;
+            case 2:
+                closestPointOfSegment(simplex, size, lambdas, closest);
+                return true;
+            case 3:
+                closestPointOfTriangle(simplex, size, lambdas, closest);
+                return true;
+            default:
+                bool isOriginInside;
+                closestPointOfTetrahedron(simplex, size, lambdas, closest, isOriginInside);
+                return !isOriginInside;
+            }
+        }
+
+        enum GJKStatus
+        {
+            GJKSeparated,
+            GJKPenetrating,
+            GJKNotConverged
+        };
+
+        /**
+         * Distance between the shapes (or between their cores, if includeMargin is false) with GJK.
+         *
+         * If the shapes are separated, firstPoint and secondPoint are set to the closest points.
+         * If they are penetrating, the simplex contains the origin (or has the origin on its boundary).
+         */
+        GJKStatus runGJK(const ConvexShape& first,
+                         const ConvexShape& second,
+                         const bool includeMargin,
+                         SupportPoint* simplex,
+                         int& size,
+                         Eigen::Vector3d& firstPoint,
+                         Eigen::Vector3d& secondPoint)
+        {
+            Eigen::Vector3d v = first.world_p_shape - second.world_p_shape;
+            if (v.squaredNorm() < 1e-20)
+            {
+                v = Eigen::Vector3d::UnitX();
+            }
+
+            double lambdas[4];
+            size = 0;
+
+            // Best simplex found, used if the iterations stall
+            SupportPoint bestSimplex[4];
+            double bestLambdas[4];
+            int bestSize = 0;
+            double bestSquaredNorm = std::numeric_limits<double>::infinity();
+            int nrOfSlowIterations = 0;
+            int nrOfRestarts = 0;
+
+            GJKStatus status = GJKNotConverged;
+            for (int iteration = 0; iteration < GJK_MAX_ITERATIONS; iteration++)
+            {
+                SupportPoint w;
+                computeMinkowskiSupport(first, second, -v, includeMargin, w);
+
+                double vSquaredNorm = v.squaredNorm();
+                if (size > 0)
+                {
+                    // The gap between v and the support plane bounds the error on the distance
+                    if (vSquaredNorm - v.dot(w.w) <= GJK_RELATIVE_TOLERANCE * vSquaredNorm)
+                    {
+                        status = GJKSeparated;
+                        break;
+                    }
+
+                    bool isDuplicate = false;
+                    for (int i = 0; i < size; i++)
+                    {
+                        isDuplicate = isDuplicate || (simplex[i].w - w.w).squaredNorm() <= 1e-24;
+                    }
+                    if (isDuplicate)
+                    {
+                        status = GJKSeparated;
+                        break;
+                    }
+                }
+
+                simplex[size] = w;
+                size++;
+
+                if (!closestPointOfSimplex(simplex, size, lambdas, v) || v.squaredNorm() <= 1e-24)
+                {
+                    status = GJKPenetrating;
+                    break;
+                }
+
+                if (v.squaredNorm() < bestSquaredNorm)
+                {
+                    bestSquaredNorm = v.squaredNorm();
+                    bestSize = size;
+                    for (int i = 0; i < size; i++)
+                    {
+                        bestSimplex[i] = simplex[i];
+                        bestLambdas[i] = lambdas[i];
+                    }
+                }
+
+                // On curved shapes, a simplex whose vertices were found with old directions can make the
+                // iterations stall: in that case, restart from the current direction with an empty simplex
+                if (size > 1 && vSquaredNorm - v.squaredNorm() <= 1e-6 * vSquaredNorm)
+                {
+                    nrOfSlowIterations++;
+                }
+                if (nrOfSlowIterations == 3)
+                {
+                    nrOfSlowIterations = 0;
+                    if (nrOfRestarts == GJK_MAX_RESTARTS)
+                    {
+                        break;
+                    }
+                    nrOfRestarts++;
+                    v = bestSimplex[0].w * bestLambdas[0];
+                    for (int i = 1; i < bestSize; i++)
+                    {
+                        v += bestLambdas[i] * bestSimplex[i].w;
+                    }
+                    size = 0;
+                }
+            }
+
+            if (status == GJKPenetrating)
+            {
+                return status;
+            }
+
+            if (status == GJKNotConverged && bestSize > 0)
+            {
+                // Accept the best simplex if the gap from its support plane bounds the error on the distance
+                Eigen::Vector3d bestV = bestLambdas[0] * bestSimplex[0].w;
+                for (int i = 1; i < bestSize; i++)
+                {
+                    bestV += bestLambdas[i] * bestSimplex[i].w;
+                }
+                SupportPoint w;
+                computeMinkowskiSupport(first, second, -bestV, includeMargin, w);
+                if (bestV.squaredNorm() - bestV.dot(w.w) <= GJK_ABSOLUTE_TOLERANCE * bestV.norm())
+                {
+                    status = GJKSeparated;
+                }
+            }
+
+            // Compute the closest points from the barycentric coordinates of the best simplex
+            size = bestSize;
+            firstPoint.setZero();
+            secondPoint.setZero();
+            for (int i = 0; i < size; i++)
+            {
+                simplex[i] = bestSimplex[i];
+                firstPoint += bestLambdas[i] * simplex[i].first;
+                secondPoint += bestLambdas[i] * simplex[i].second;
+            }
+
+            return status;
+        }
+
+        /**
+         * Add vertices to the simplex returned by GJK, until it is a tetrahedron.
+         *
+         * @return false if the Minkowski difference is degenerate (i.e. flat).
+         */
+        bool expandSimplexToTetrahedron(const ConvexShape& first,
+                                        const ConvexShape& second,
+                                        SupportPoint* simplex,
+                                        int& size)
+        {
+            const double tolerance = 1e-12;
+
+            if (size == 1)
+            {
+                for (int i = 0; i < 6 && size == 1; i++)
+                {
+                    Eigen::Vector3d direction = Eigen::Vector3d::Zero();
+                    direction(i / 2) = (i % 2 == 0) ? 1.0 : -1.0;
+                    computeMinkowskiSupport(first, second, direction, true, simplex[1]);
+                    if ((simplex[1].w - simplex[0].w).norm() > tolerance)
+                    {
+                        size = 2;
+                    }
+                }
+            }
+
+            if (size == 2)
+            {
+                Eigen::Vector3d axis = (simplex[1].w - simplex[0].w).normalized();
+                Eigen::Index minIndex;
+                axis.cwiseAbs().minCoeff(&minIndex);
+                Eigen::Vector3d direction = axis.cross(Eigen::Vector3d::Unit(minIndex)).normalized();
+
+                // Try directions orthogonal to the segment, rotating around it
+                for (int i = 0; i < 6 && size == 2; i++)
+                {
+                    Eigen::Vector3d rotated = Eigen::AngleAxisd(i * M_PI / 3.0, axis) * direction;
+                    computeMinkowskiSupport(first, second, rotated, true, simplex[2]);
+                    if (axis.cross(simplex[2].w - simplex[0].w).norm() > tolerance)
+                    {
+                        size = 3;
+                    }
+                }
+            }
+
+            if (size == 3)
+            {
+                Eigen::Vector3d normal = (simplex[1].w - simplex[0].w).cross(simplex[2].w - simplex[0].w).normalized();
+                for (int i = 0; i < 2 && size == 3; i++)
+                {
+                    Eigen::Vector3d direction = (i == 0) ? normal : Eigen::Vector3d(-normal);
+                    computeMinkowskiSupport(first, second, direction, true, simplex[3]);
+                    if (std::abs(normal.dot(simplex[3].w - simplex[0].w)) > tolerance)
+                    {
+                        size = 4;
+                    }
+                }
+            }
+
+            return size == 4;
+        }
+
+        struct PolytopeFace
+        {
+            int vertices[3];
+            Eigen::Vector3d normal;
+            double distance;
+        };
+
+        void addPolytopeFace(const std::vector<SupportPoint>& vertices,
+                             const Eigen::Vector3d& interiorPoint,
+                             int a, int b, int c,
+                             std::vector<PolytopeFace>& faces)
+        {
+            PolytopeFace face;
+            face.normal = (vertices[b].w - vertices[a].w).cross(vertices[c].w - vertices[a].w);
+            double norm = face.normal.norm();
+            if (norm > 0)
+            {
+                face.normal /= norm;
+            }
+
+            // Orient the normal outside the polytope
+            if (face.normal.dot(vertices[a].w - interiorPoint) < 0)
+            {
+                std::swap(b, c);
+                face.normal = -face.normal;
+            }
+
+            face.vertices[0] = a;
+            face.vertices[1] = b;
+            face.vertices[2] = c;
+            // Degenerate faces are never selected as the closest one
+            face.distance = norm > 0 ? face.normal.dot(vertices[a].w) : std::numeric_limits<double>::infinity();
+            faces.push_back(face);
+        }
+
+        void addHorizonEdge(int a, int b, std::vector<std::pair<int, int> >& edges)
+        {
+            // An edge shared by two removed faces is not on the horizon
+            for (size_t i = 0; i < edges.size(); i++)
+            {
+                if (edges[i].first == b && edges[i].second == a)
+                {
+                    edges[i] = edges.back();
+                    edges.pop_back();
+                    return;
+                }
+            }
+            edges.push_back(std::make_pair(a, b));
+        }
+
+        /**
+         * Penetration depth of the shapes with EPA, starting from a tetrahedron containing the origin.
+         */
+        bool runEPA(const ConvexShape& first,
+                    const ConvexShape& second,
+                    const SupportPoint* tetrahedron,
+                    ConvexShapesDistance& result)
+        {
+            std::vector<SupportPoint> vertices(tetrahedron, tetrahedron + 4);
+            Eigen::Vector3d interiorPoint = 0.25 * (vertices[0].w + vertices[1].w + vertices[2].w + vertices[3].w);
+
+            std::vector<PolytopeFace> faces;
+            faces.reserve(2 * EPA_MAX_ITERATIONS + 4);
+            addPolytopeFace(vertices, interiorPoint, 0, 1, 2, faces);
+            addPolytopeFace(vertices, interiorPoint, 0, 3, 1, faces);
+            addPolytopeFace(vertices, interiorPoint, 0, 2, 3, faces);
+            addPolytopeFace(vertices, interiorPoint, 1, 3, 2, faces);
+
+            std::vector<std::pair<int, int> > horizon;
+            bool converged = false;
+            size_t closestFace = 0;
+            for (int iteration = 0; iteration < EPA_MAX_ITERATIONS; iteration++)
+            {
+                closestFace = 0;
+                for (size_t f = 1; f < faces.size(); f++)
+                {
+                    if (faces[f].distance < faces[closestFace].distance)
+                    {
+                        closestFace = f;
+                    }
+                }
+
+                SupportPoint w;
+                computeMinkowskiSupport(first, second, faces[closestFace].normal, true, w);
+                if (faces[closestFace].normal.dot(w.w) - faces[closestFace].distance <= EPA_TOLERANCE)
+                {
+                    converged = true;
+                    break;
+                }
+
+                // Remove the faces visible from the new vertex, and close the polytope
+                int newVertex = static_cast<int>(vertices.size());
+                vertices.push_back(w);
+                horizon.clear();
+                for (size_t f = faces.size(); f-- > 0;)
+                {
+                    if (faces[f].normal.dot(w.w - vertices[faces[f].vertices[0]].w) > 0)
+                    {
+                        addHorizonEdge(faces[f].vertices[0], faces[f].vertices[1], horizon);
+                        addHorizonEdge(faces[f].vertices[1], faces[f].vertices[2], horizon);
+                        addHorizonEdge(faces[f].vertices[2], faces[f].vertices[0], horizon);
+                        faces[f] = faces.back();
+                        faces.pop_back();
+                    }
+                }
+
+                for (size_t e = 0; e < horizon.size(); e++)
+                {
+                    addPolytopeFace(vertices, interiorPoint, horizon[e].first, horizon[e].second, newVertex, faces);
+                }
+
+                if (faces.empty())
+                {
+                    return false;
+                }
+            }
+
+            if (!converged)
+            {
+                closestFace = 0;
+                for (size_t f = 1; f < faces.size(); f++)
+                {
+                    if (faces[f].distance < faces[closestFace].distance)
+                    {
+                        closestFace = f;
+                    }
+                }
+            }
+
+            // Barycentric coordinates of the projection of the origin on the closest face
+            const PolytopeFace& face = faces[closestFace];
+            const SupportPoint& a = vertices[face.vertices[0]];
+            const SupportPoint& b = vertices[face.vertices[1]];
+            const SupportPoint& c = vertices[face.vertices[2]];
+            Eigen::Vector3d projection = face.distance * face.normal;
+            Eigen::Vector3d ab = b.w - a.w;
+            Eigen::Vector3d ac = c.w - a.w;
+            Eigen::Vector3d ap = projection - a.w;
+            double d00 = ab.dot(ab);
+            double d01 = ab.dot(ac);
+            double d11 = ac.dot(ac);
+            double d20 = ap.dot(ab);
+            double d21 = ap.dot(ac);
+            double denominator = d00 * d11 - d01 * d01;
+            double lambdaB = 0.0;
+            double lambdaC = 0.0;
+            if (denominator > 0)
+            {
+                lambdaB = std::max(0.0, std::min(1.0, (d11 * d20 - d01 * d21) / denominator));
+                lambdaC = std::max(0.0, std::min(1.0 - lambdaB, (d00 * d21 - d01 * d20) / denominator));
+            }
+            double lambdaA = 1.0 - lambdaB - lambdaC;
+
+            result.distance = -face.distance;
+            result.normal = face.normal;
+            result.firstPoint = lambdaA * a.first + lambdaB * b.first + lambdaC * c.first;
+            result.secondPoint = lambdaA * a.second + lambdaB * b.second + lambdaC * c.second;
+
+            return converged;
+        }
+
+        /**
+         * Distance between a box or a cylinder and a sphere, with the normal from the first to the sphere.
+         */
+        void computeSphereDistance(const ConvexShape& shape,
+                                   const Eigen::Vector3d& center,
+                                   const double radius,
+                                   ConvexShapesDistance& result)
+        {
+            Eigen::Vector3d centerInShape = shape.world_R_shape.transpose() * (center - shape.world_p_shape);
+            Eigen::Vector3d closest;
+            Eigen::Vector3d normalInShape;
+            double distanceFromShape;
+
+            if (shape.type == ConvexShape::BoxType)
+            {
+                closest = centerInShape.cwiseMax(-shape.halfExtents).cwiseMin(shape.halfExtents);
+                if (closest != centerInShape)
+                {
+                    distanceFromShape = (centerInShape - closest).norm();
+                    normalInShape = (centerInShape - closest) / distanceFromShape;
+                }
+                else
+                {
+                    // The center is inside the box: the closest point is on the nearest face
+                    Eigen::Vector3d depths = shape.halfExtents - centerInShape.cwiseAbs();
+                    Eigen::Index axis;
+                    distanceFromShape = -depths.minCoeff(&axis);
+                    double sign = centerInShape(axis) >= 0 ? 1.0 : -1.0;
+                    normalInShape = sign * Eigen::Vector3d::Unit(axis);
+                    closest(axis) = sign * shape.halfExtents(axis);
+                }
+            }
+            else
+            {
+                double radialDistance = centerInShape.head<2>().norm();
+                closest = centerInShape;
+                if (radialDistance > shape.radius)
+                {
+                    closest.head<2>() *= shape.radius / radialDistance;
+                }
+                closest(2) = std::max(-shape.halfLength, std::min(shape.halfLength, centerInShape(2)));
+
+                if (closest != centerInShape)
+                {
+                    distanceFromShape = (centerInShape - closest).norm();
+                    normalInShape = (centerInShape - closest) / distanceFromShape;
+                }
+                else
+                {
+                    // The center is inside the cylinder: the closest point is either on the lateral surface or on a base
+                    double radialDepth = shape.radius - radialDistance;
+                    double axialDepth = shape.halfLength - std::abs(centerInShape(2));
+                    if (radialDepth < axialDepth)
+                    {
+                        distanceFromShape = -radialDepth;
+                        normalInShape.setZero();
+                        if (radialDistance > 0)
+                        {
+                            normalInShape.head<2>() = centerInShape.head<2>() / radialDistance;
+                        }
+                        else
+                        {
+                            normalInShape(0) = 1.0;
+                        }
+                        closest.head<2>() = shape.radius * normalInShape.head<2>();
+                    }
+                    else
+                    {
+                        distanceFromShape = -axialDepth;
+                        double sign = centerInShape(2) >= 0 ? 1.0 : -1.0;
+                        normalInShape = sign * Eigen::Vector3d::UnitZ();
+                        closest(2) = sign * shape.halfLength;
+                    }
+                }
+            }
+
+            result.normal = shape.world_R_shape * normalInShape;
+            result.firstPoint = shape.world_R_shape * closest + shape.world_p_shape;
+            result.secondPoint = center - radius * result.normal;
+            result.distance = distanceFromShape - radius;
+        }
+
+        void swapShapes(ConvexShapesDistance& result)
+        {
+            std::swap(result.firstPoint, result.secondPoint);
+            result.normal = -result.normal;
+        }
+    }
+
+    ConvexShape::ConvexShape(): type(SphereType),
+                                radius(0.0),
+                                halfLength(0.0),
+                                halfExtents(Eigen::Vector3d::Zero()),
+                                verticesMin(Eigen::Vector3d::Zero()),
+                                verticesMax(Eigen::Vector3d::Zero()),
+                                frame_R_shape(Eigen::Matrix3d::Identity()),
+                                frame_p_shape(Eigen::Vector3d::Zero()),
+                                world_R_shape(Eigen::Matrix3d::Identity()),
+                                world_p_shape(Eigen::Vector3d::Zero()),
+                                aabbMin(Eigen::Vector3d::Zero()),
+                                aabbMax(Eigen::Vector3d::Zero())
+    {
+
+    }
+
+    void ConvexShape::setFramePose(const Eigen::Matrix3d& world_R_frame, const Eigen::Vector3d& world_p_frame)
+    {
+        world_R_shape = world_R_frame * frame_R_shape;
+        world_p_shape = world_R_frame * frame_p_shape + world_p_frame;
+
+        Eigen::Vector3d center = world_p_shape;
+        Eigen::Vector3d halfSides;
+        switch (type)
+        {
+        case SphereType:
+            halfSides.setConstant(radius);
+            break;
+        case BoxType:
+            halfSides = world_R_shape.cwiseAbs() * halfExtents;
+            break;
+        case CylinderType:
+            for (int i = 0; i < 3; i++)
+            {
+                double axisComponent = world_R_shape(i, 2);
+                halfSides(i) = radius * std::sqrt(std::max(0.0, 1.0 - axisComponent * axisComponent))
+                               + halfLength * std::abs(axisComponent);
+            }
+            break;
+        case MeshType:
+            center = world_R_shape * (0.5 * (verticesMin + verticesMax)) + world_p_shape;
+            halfSides = world_R_shape.cwiseAbs() * (0.5 * (verticesMax - verticesMin));
+            break;
+        }
+
+        aabbMin = center - halfSides;
+        aabbMax = center + halfSides;
+    }
+
+    double ConvexShape::getMargin() const
+    {
+        return type == SphereType ? radius : 0.0;
+    }
+
+    Eigen::Vector3d ConvexShape::support(const Eigen::Vector3d& direction, const bool includeMargin) const
+    {
+        Eigen::Vector3d directionInShape = world_R_shape.transpose() * direction;
+        Eigen::Vector3d supportInShape;
+
+        switch (type)
+        {
+        case SphereType:
+        {
+            double norm = directionInShape.norm();
+            if (includeMargin && norm > 0)
+            {
+                supportInShape = (radius / norm) * directionInShape;
+            }
+            else
+            {
+                supportInShape.setZero();
+            }
+            break;
+        }
+        case BoxType:
+            for (int i = 0; i < 3; i++)
+            {
+                supportInShape(i) = directionInShape(i) >= 0 ? halfExtents(i) : -halfExtents(i);
+            }
+            break;
+        case CylinderType:
+        {
+            double radialNorm = directionInShape.head<2>().norm();
+            if (radialNorm > 0)
+            {
+                supportInShape.head<2>() = (radius / radialNorm) * directionInShape.head<2>();
+            }
+            else
+            {
+                supportInShape.head<2>().setZero();
+            }
+            supportInShape(2) = directionInShape(2) >= 0 ? halfLength : -halfLength;
+            break;
+        }
+        case MeshType:
+        {
+            size_t bestVertex = 0;
+            double bestProjection = -std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                double projection = vertices[i].dot(directionInShape);
+                if (projection > bestProjection)
+                {
+                    bestProjection = projection;
+                    bestVertex = i;
+                }
+            }
+            supportInShape = vertices.empty() ? Eigen::Vector3d::Zero() : vertices[bestVertex];
+            break;
+        }
+        }
+
+        return world_R_shape * supportInShape + world_p_shape;
+    }
+
+    bool computeConvexShapesDistance(const ConvexShape& first,
+                                     const ConvexShape& second,
+                                     ConvexShapesDistance& result)
+    {
+        bool isFirstSphere = first.type == ConvexShape::SphereType;
+        bool isSecondSphere = second.type == ConvexShape::SphereType;
+
+        // Closed form distances for the spheres
+        if (isFirstSphere && isSecondSphere)
+        {
+            Eigen::Vector3d centersDistance = second.world_p_shape - first.world_p_shape;
+            double norm = centersDistance.norm();
+            result.normal = norm > 0 ? Eigen::Vector3d(centersDistance / norm) : Eigen::Vector3d::UnitZ();
+            result.distance = norm - first.radius - second.radius;
+            result.firstPoint = first.world_p_shape + first.radius * result.normal;
+            result.secondPoint = second.world_p_shape - second.radius * result.normal;
+            return true;
+        }
+
+        if (isSecondSphere && first.type != ConvexShape::MeshType)
+        {
+            computeSphereDistance(first, second.world_p_shape, second.radius, result);
+            return true;
+        }
+
+        if (isFirstSphere && second.type != ConvexShape::MeshType)
+        {
+            computeSphereDistance(second, first.world_p_shape, first.radius, result);
+            swapShapes(result);
+            return true;
+        }
+
+        // Distance between the cores of the shapes
+        SupportPoint simplex[4];
+        int size;
+        Eigen::Vector3d firstCorePoint;
+        Eigen::Vector3d secondCorePoint;
+        GJKStatus status = runGJK(first, second, false, simplex, size, firstCorePoint, secondCorePoint);
+
+        double margin = first.getMargin() + second.getMargin();
+        double coreDistance = (secondCorePoint - firstCorePoint).norm();
+        if (status != GJKPenetrating && (margin == 0 || coreDistance > CORE_DISTANCE_TOLERANCE))
+        {
+            result.normal = coreDistance > 0 ? Eigen::Vector3d((secondCorePoint - firstCorePoint) / coreDistance)
+                                             : Eigen::Vector3d::UnitZ();
+            result.distance = coreDistance - margin;
+            result.firstPoint = firstCorePoint + first.getMargin() * result.normal;
+            result.secondPoint = secondCorePoint - second.getMargin() * result.normal;
+            return status == GJKSeparated;
+        }
+
+        // The shapes are penetrating: if they have a margin, find a simplex containing the origin for the full shapes
+        if (margin > 0)
+        {
+            Eigen::Vector3d firstPoint;
+            Eigen::Vector3d secondPoint;
+            status = runGJK(first, second, true, simplex, size, firstPoint, secondPoint);
+            if (status != GJKPenetrating)
+            {
+                double distance = (secondPoint - firstPoint).norm();
+                result.normal = distance > 0 ? Eigen::Vector3d((secondPoint - firstPoint) / distance)
+                                             : Eigen::Vector3d::UnitZ();
+                result.distance = distance;
+                result.firstPoint = firstPoint;
+                result.secondPoint = secondPoint;
+                return status == GJKSeparated;
+            }
+        }
+
+        if (!expandSimplexToTetrahedron(first, second, simplex, size))
+        {
+            // The shapes are flat and touching
+            result.distance = 0.0;
+            result.normal = Eigen::Vector3d::UnitZ();
+            result.firstPoint = simplex[0].first;
+            result.secondPoint = simplex[0].second;
+            return true;
+        }
+
+        return runEPA(first, second, simplex, result);
+    }
+}
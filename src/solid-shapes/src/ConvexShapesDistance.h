@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2016 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+#ifndef IDYNTREE_CONVEX_SHAPES_DISTANCE_H
+#define IDYNTREE_CONVEX_SHAPES_DISTANCE_H
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace iDynTree
+{
+    /**
+     * Convex shape used by CollisionComputations, with its pose in the world frame.
+     *
+     * The geometry is expressed in the shape frame: the sphere and the box are centered
+     * in its origin, with the box sides aligned to its axes, and the cylinder axis is the z axis.
+     * The meshes are represented by their vertices, i.e. by their convex hull.
+     */
+    struct ConvexShape
+    {
+        enum Type
+        {
+            SphereType,
+            BoxType,
+            CylinderType,
+            MeshType
+        };
+
+        Type type;
+
+        /**
+         * Radius of the sphere or of the cylinder.
+         */
+        double radius;
+
+        /**
+         * Half of the length of the cylinder.
+         */
+        double halfLength;
+
+        /**
+         * Half of the sides of the box.
+         */
+        Eigen::Vector3d halfExtents;
+
+        /**
+         * Vertices of the mesh, in the shape frame.
+         */
+        std::vector<Eigen::Vector3d> vertices;
+
+        /**
+         * Minimum and maximum of the vertices of the mesh, in the shape frame.
+         */
+        Eigen::Vector3d verticesMin;
+        Eigen::Vector3d verticesMax;
+
+        /**
+         * Pose of the shape frame w.r.t. the frame to which the shape is attached.
+         */
+        Eigen::Matrix3d frame_R_shape;
+        Eigen::Vector3d frame_p_shape;
+
+        /**
+         * Pose of the shape frame w.r.t. the world frame.
+         */
+        Eigen::Matrix3d world_R_shape;
+        Eigen::Vector3d world_p_shape;
+
+        /**
+         * Axis aligned bounding box of the shape, in the world frame.
+         */
+        Eigen::Vector3d aabbMin;
+        Eigen::Vector3d aabbMax;
+
+        ConvexShape();
+
+        /**
+         * Set the pose of the shape from the one of the frame to which it is attached,
+         * and update the bounding box.
+         */
+        void setFramePose(const Eigen::Matrix3d& world_R_frame, const Eigen::Vector3d& world_p_frame);
+
+        /**
+         * Radius that is added to the core of the shape, i.e. the radius of a sphere and zero otherwise.
+         */
+        double getMargin() const;
+
+        /**
+         * Point of the shape (in the world frame) that is the furthest along a direction (in the world frame).
+         *
+         * If includeMargin is false, the sphere is reduced to its center.
+         */
+        Eigen::Vector3d support(const Eigen::Vector3d& direction, const bool includeMargin) const;
+    };
+
+    /**
+     * Result of the distance computation between two convex shapes.
+     */
+    struct ConvexShapesDistance
+    {
+        /**
+         * Distance between the shapes, negative if the shapes are penetrating.
+         * In that case, its absolute value is the penetration depth.
+         */
+        double distance;
+
+        /**
+         * Closest points of the two shapes, in the world frame.
+         * If the shapes are penetrating, they are the deepest points of each shape inside the other one.
+         */
+        Eigen::Vector3d firstPoint;
+        Eigen::Vector3d secondPoint;
+
+        /**
+         * Unit vector along which moving the second shape w.r.t. the first one increases the distance.
+         * The distance is equal to normal.dot(secondPoint - firstPoint).
+         */
+        Eigen::Vector3d normal;
+    };
+
+    /**
+     * Compute the distance between two convex shapes.
+     *
+     * The distances between a sphere and a sphere, a box or a cylinder are computed in closed form.
+     * The other distances are computed with GJK (Gilbert-Johnson-Keerthi) on the cores of the shapes and,
+     * if the cores are penetrating, the penetration depth is computed with EPA (Expanding Polytope Algorithm).
+     *
+     * @return false if the computation did not converge, true otherwise.
+     */
+    bool computeConvexShapesDistance(const ConvexShape& first,
+                                     const ConvexShape& second,
+                                     ConvexShapesDistance& result);
+}
+
+#endif
@@ -0,0 +1,429 @@
+/*
+ * Copyright (C) 2016 Fondazione Istituto Italiano di Tecnologia
+ *
+ * Licensed under either the GNU Lesser General Public License v3.0 :
+ * https://www.gnu.org/licenses/lgpl-3.0.html
+ * or the GNU Lesser General Public License v2.1 :
+ * https://www.gnu.org/licenses/old-licenses/lgpl-2.1.html
+ * at your option.
+ */
+
+//For using the M_PI macro in visual studio it
+//is necessary to define _USE_MATH_DEFINES
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+
+#include <iDynTree/CollisionComputations.h>
+#include <iDynTree/KinDynComputations.h>
+
+#include <iDynTree/Core/EigenHelpers.h>
+#include <iDynTree/Core/MatrixDynSize.h>
+#include <iDynTree/Core/TestUtils.h>
+#include <iDynTree/Model/ModelTestUtils.h>
+#include <iDynTree/Model/SolidShapes.h>
+
+#include <Eigen/Geometry>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+using namespace iDynTree;
+
+Sphere createSphere(double radius, const Transform& link_H_geometry = Transform::Identity())
+{
+    Sphere sphere;
+    sphere.setRadius(radius);
+    sphere.setLink_H_geometry(link_H_geometry);
+    return sphere;
+}
+
+Box createBox(double side, const Transform& link_H_geometry = Transform::Identity())
+{
+    Box box;
+    box.setX(side);
+    box.setY(side);
+    box.setZ(side);
+    box.setLink_H_geometry(link_H_geometry);
+    return box;
+}
+
+Cylinder createCylinder(double radius, double length, const Transform& link_H_geometry = Transform::Identity())
+{
+    Cylinder cylinder;
+    cylinder.setRadius(radius);
+    cylinder.setLength(length);
+    cylinder.setLink_H_geometry(link_H_geometry);
+    return cylinder;
+}
+
+Transform createTransform(const Rotation& rotation, double x, double y, double z)
+{
+    return Transform(rotation, Position(x, y, z));
+}
+
+/**
+ * Compute the distance between a shape attached to a link in the origin and a shape of the environment.
+ */
+CollisionPair computeDistance(SolidShape& linkShape, const SolidShape& environmentShape, const Transform& world_H_environment)
+{
+    Model model;
+    Link link;
+    model.addLink("link", link);
+    model.collisionSolidShapes().getLinkSolidShapes()[0].push_back(linkShape.clone());
+
+    KinDynComputations kinDyn;
+    ASSERT_IS_TRUE(kinDyn.loadRobotModel(model));
+
+    CollisionComputations collisions;
+    ASSERT_IS_TRUE(collisions.loadModel(model));
+    ASSERT_EQUAL_DOUBLE(collisions.getNrOfLinkShapes(), 1);
+    ASSERT_EQUAL_DOUBLE(collisions.addEnvironmentShape(environmentShape, world_H_environment), 0);
+    ASSERT_IS_TRUE(collisions.updateShapesPoses(kinDyn));
+    ASSERT_IS_TRUE(collisions.computeDistances(std::numeric_limits<double>::infinity()));
+    ASSERT_EQUAL_DOUBLE(collisions.getNrOfCollisionPairs(), 1);
+
+    const CollisionPair& pair = collisions.getCollisionPair(0);
+    ASSERT_EQUAL_DOUBLE(pair.firstLink, 0);
+    ASSERT_EQUAL_DOUBLE(pair.secondLink, LINK_INVALID_INDEX);
+    ASSERT_EQUAL_DOUBLE(pair.secondShape, 0);
+
+    // The witness points are consistent with the distance
+    ASSERT_EQUAL_DOUBLE_TOL(toEigen(pair.normal).norm(), 1.0, 1e-9);
+    ASSERT_EQUAL_DOUBLE_TOL(toEigen(pair.normal).dot(toEigen(pair.secondPoint) - toEigen(pair.firstPoint)), pair.distance, 1e-6);
+    ASSERT_EQUAL_DOUBLE_TOL((toEigen(pair.secondPoint) - toEigen(pair.firstPoint)).norm(), std::abs(pair.distance), 1e-6);
+
+    return pair;
+}
+
+void testPrimitivesDistances()
+{
+    Sphere sphere = createSphere(0.1);
+    Box box = createBox(0.2);
+    Cylinder cylinder = createCylinder(0.1, 0.4);
+    Rotation identity = Rotation::Identity();
+
+    // Closed form distances of the spheres
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(sphere, createSphere(0.2), createTransform(identity, 1.0, 0.0, 0.0)).distance, 0.7, 1e-9);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(sphere, box, createTransform(identity, 0.0, 0.5, 0.0)).distance, 0.3, 1e-9);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, sphere, createTransform(identity, 0.5, 0.5, 0.0)).distance,
+                            0.4 * std::sqrt(2.0) - 0.1, 1e-9);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(cylinder, sphere, createTransform(identity, 0.0, 0.0, -0.5)).distance, 0.2, 1e-9);
+    Sphere smallSphere = createSphere(0.05);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(smallSphere, box, createTransform(identity, 0.05, 0.0, 0.0)).distance, -0.1, 1e-9);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(cylinder, smallSphere, createTransform(identity, 0.05, 0.0, 0.0)).distance, -0.1, 1e-9);
+
+    // Distances computed with GJK
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, box, createTransform(identity, 0.5, 0.0, 0.0)).distance, 0.3, 1e-9);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, box, createTransform(Rotation::RotZ(M_PI / 4), 0.5, 0.0, 0.0)).distance,
+                            0.4 - 0.1 * std::sqrt(2.0), 1e-9);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, cylinder, createTransform(identity, 0.5, 0.0, 0.0)).distance, 0.3, 1e-6);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, cylinder, createTransform(Rotation::RotY(M_PI / 2), 0.5, 0.0, 0.0)).distance, 0.2, 1e-6);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(cylinder, cylinder, createTransform(identity, 0.3, 0.0, 0.0)).distance, 0.1, 1e-6);
+
+    // Penetration depths computed with EPA
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, box, createTransform(identity, 0.15, 0.0, 0.0)).distance, -0.05, 1e-6);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, box, createTransform(Rotation::RotZ(M_PI / 4), 0.0, 0.0, 0.19)).distance, -0.01, 1e-6);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(cylinder, cylinder, createTransform(identity, 0.15, 0.0, 0.0)).distance, -0.05, 1e-4);
+    ASSERT_EQUAL_DOUBLE_TOL(computeDistance(box, cylinder, createTransform(identity, 0.0, 0.0, 0.25)).distance, -0.05, 1e-6);
+}
+
+/**
+ * Add random primitive shapes to the links of a model.
+ */
+void addRandomShapes(Model& model)
+{
+    for (size_t link = 0; link < model.getNrOfLinks(); link++)
+    {
+        int nrOfShapes = std::rand() % 3;
+        for (int i = 0; i < nrOfShapes; i++)
+        {
+            Transform link_H_geometry = getRandomTransform();
+            Position offset = link_H_geometry.getPosition();
+            toEigen(offset) *= 0.2 / toEigen(offset).norm();
+            link_H_geometry.setPosition(offset);
+            double size = getRandomDouble(0.05, 0.2);
+
+            SolidShape* shape;
+            switch (std::rand() % 3)
+            {
+            case 0:
+                shape = createSphere(size, link_H_geometry).clone();
+                break;
+            case 1:
+                shape = createBox(2.0 * size, link_H_geometry).clone();
+                break;
+            default:
+                shape = createCylinder(size, 3.0 * size, link_H_geometry).clone();
+                break;
+            }
+            model.collisionSolidShapes().getLinkSolidShapes()[link].push_back(shape);
+        }
+    }
+}
+
+void setRandomState(KinDynComputations& kinDyn)
+{
+    VectorDynSize jointPos(kinDyn.getNrOfDegreesOfFreedom());
+    VectorDynSize jointVel(kinDyn.getNrOfDegreesOfFreedom());
+    getRandomVector(jointPos, -1.0, 1.0);
+    getRandomVector(jointVel, -1.0, 1.0);
+    Twist baseVel;
+    toEigen(baseVel.getLinearVec3()) = Eigen::Vector3d::Random();
+    toEigen(baseVel.getAngularVec3()) = Eigen::Vector3d::Random();
+    Vector3 gravity;
+    gravity.zero();
+    ASSERT_IS_TRUE(kinDyn.setRobotState(getRandomTransform(), jointPos, baseVel, jointVel, gravity));
+}
+
+/**
+ * Check that the broad phase finds all the pairs closer than the maximum distance,
+ * and that the allowed collisions are not checked.
+ */
+void testBroadPhase(Model& model)
+{
+    addRandomShapes(model);
+
+    KinDynComputations kinDyn;
+    ASSERT_IS_TRUE(kinDyn.loadRobotModel(model));
+
+    CollisionComputations collisions;
+    ASSERT_IS_TRUE(collisions.loadModel(model));
+    ASSERT_IS_TRUE(collisions.isCollisionAllowed(model.getJoint(0)->getFirstAttachedLink(),
+                                                 model.getJoint(0)->getSecondAttachedLink()));
+    ASSERT_IS_FALSE(collisions.setCollisionAllowed("notExistingLink", model.getLinkName(0), true));
+    collisions.addEnvironmentShape(createBox(0.5), getRandomTransform());
+
+    // Number of pairs that must be checked
+    size_t nrOfPairs = 0;
+    const std::vector<std::vector<SolidShape*> >& shapes = model.collisionSolidShapes().getLinkSolidShapes();
+    for (LinkIndex first = 0; first < static_cast<LinkIndex>(model.getNrOfLinks()); first++)
+    {
+        nrOfPairs += shapes[first].size();
+        for (LinkIndex second = first + 1; second < static_cast<LinkIndex>(model.getNrOfLinks()); second++)
+        {
+            if (!collisions.isCollisionAllowed(first, second))
+            {
+                nrOfPairs += shapes[first].size() * shapes[second].size();
+            }
+        }
+    }
+
+    double maxDistance = 0.1;
+    for (int i = 0; i < 10; i++)
+    {
+        setRandomState(kinDyn);
+        ASSERT_IS_TRUE(collisions.updateShapesPoses(kinDyn));
+
+        ASSERT_IS_TRUE(collisions.computeDistances(std::numeric_limits<double>::infinity()));
+        ASSERT_EQUAL_DOUBLE(collisions.getNrOfCollisionPairs(), nrOfPairs);
+        std::vector<CollisionPair> allPairs;
+        for (size_t p = 0; p < collisions.getNrOfCollisionPairs(); p++)
+        {
+            allPairs.push_back(collisions.getCollisionPair(p));
+            ASSERT_IS_TRUE(allPairs.back().secondLink == LINK_INVALID_INDEX ||
+                           !collisions.isCollisionAllowed(allPairs.back().firstLink, allPairs.back().secondLink));
+        }
+
+        ASSERT_IS_TRUE(collisions.computeDistances(maxDistance));
+        for (size_t p = 0; p < allPairs.size(); p++)
+        {
+            if (allPairs[p].distance >= maxDistance)
+            {
+                continue;
+            }
+
+            bool found = false;
+            for (size_t q = 0; q < collisions.getNrOfCollisionPairs(); q++)
+            {
+                const CollisionPair& pair = collisions.getCollisionPair(q);
+                if (pair.firstLink == allPairs[p].firstLink && pair.firstShape == allPairs[p].firstShape &&
+                    pair.secondLink == allPairs[p].secondLink && pair.secondShape == allPairs[p].secondShape)
+                {
+                    found = true;
+                    ASSERT_EQUAL_DOUBLE(pair.distance, allPairs[p].distance);
+                }
+            }
+            ASSERT_IS_TRUE(found);
+        }
+    }
+
+    // Allowing all the collisions only the environment is checked
+    for (LinkIndex first = 0; first < static_cast<LinkIndex>(model.getNrOfLinks()); first++)
+    {
+        for (LinkIndex second = 0; second < static_cast<LinkIndex>(model.getNrOfLinks()); second++)
+        {
+            ASSERT_IS_TRUE(collisions.setCollisionAllowed(first, second, true));
+        }
+    }
+    ASSERT_IS_TRUE(collisions.computeDistances(std::numeric_limits<double>::infinity()));
+    ASSERT_EQUAL_DOUBLE(collisions.getNrOfCollisionPairs(), collisions.getNrOfLinkShapes());
+
+    collisions.clearEnvironmentShapes();
+    ASSERT_IS_TRUE(collisions.computeDistances(std::numeric_limits<double>::infinity()));
+    ASSERT_EQUAL_DOUBLE(collisions.getNrOfCollisionPairs(), 0);
+}
+
+/**
+ * Check the Jacobians of the distances and of the witness points with finite differences,
+ * moving the model with a random velocity in the mixed representation.
+ */
+void testJacobians(Model& model)
+{
+    addRandomShapes(model);
+
+    KinDynComputations kinDyn;
+    ASSERT_IS_TRUE(kinDyn.loadRobotModel(model));
+    ASSERT_IS_TRUE(kinDyn.setFrameVelocityRepresentation(MIXED_REPRESENTATION));
+    setRandomState(kinDyn);
+
+    CollisionComputations collisions;
+    ASSERT_IS_TRUE(collisions.loadModel(model));
+    Transform world_H_environment = getRandomTransform();
+    collisions.addEnvironmentShape(createCylinder(0.2, 1.0), world_H_environment);
+    ASSERT_IS_TRUE(collisions.updateShapesPoses(kinDyn));
+    ASSERT_IS_TRUE(collisions.computeDistances(std::numeric_limits<double>::infinity()));
+
+    size_t nrOfDOFs = model.getNrOfDOFs();
+    Transform basePose = kinDyn.getWorldBaseTransform();
+    Twist baseVel = kinDyn.getBaseTwist();
+    VectorDynSize jointPos(nrOfDOFs);
+    VectorDynSize jointVel(nrOfDOFs);
+    kinDyn.getJointPos(jointPos);
+    kinDyn.getJointVel(jointVel);
+    Eigen::VectorXd velocity(6 + nrOfDOFs);
+    velocity << toEigen(baseVel.getLinearVec3()), toEigen(baseVel.getAngularVec3()), toEigen(jointVel);
+
+    // Pose of the model after a small motion with the velocity
+    double dt = 1e-7;
+    Transform perturbedBasePose = basePose;
+    Eigen::Vector3d angularVelocity = toEigen(baseVel.getAngularVec3());
+    Position perturbedBasePosition;
+    toEigen(perturbedBasePosition) = toEigen(basePose.getPosition()) + dt * toEigen(baseVel.getLinearVec3());
+    perturbedBasePose.setPosition(perturbedBasePosition);
+    Eigen::Matrix3d perturbedRotation = Eigen::AngleAxisd(dt * angularVelocity.norm(), angularVelocity.normalized()).toRotationMatrix()
+                                        * toEigen(basePose.getRotation());
+    perturbedBasePose.setRotation(Rotation(perturbedRotation(0, 0), perturbedRotation(0, 1), perturbedRotation(0, 2),
+                                           perturbedRotation(1, 0), perturbedRotation(1, 1), perturbedRotation(1, 2),
+                                           perturbedRotation(2, 0), perturbedRotation(2, 1), perturbedRotation(2, 2)));
+    VectorDynSize perturbedJointPos(nrOfDOFs);
+    toEigen(perturbedJointPos) = toEigen(jointPos) + dt * toEigen(jointVel);
+
+    KinDynComputations perturbedKinDyn;
+    ASSERT_IS_TRUE(perturbedKinDyn.loadRobotModel(model));
+    Vector3 gravity;
+    gravity.zero();
+    ASSERT_IS_TRUE(perturbedKinDyn.setRobotState(perturbedBasePose, perturbedJointPos, baseVel, jointVel, gravity));
+
+    // The distances are computed also after a larger motion, to limit the effect of the tolerances of GJK
+    double distanceDt = 1e-5;
+    KinDynComputations distancePerturbedKinDyn;
+    ASSERT_IS_TRUE(distancePerturbedKinDyn.loadRobotModel(model));
+    toEigen(perturbedBasePosition) = toEigen(basePose.getPosition()) + distanceDt * toEigen(baseVel.getLinearVec3());
+    perturbedBasePose.setPosition(perturbedBasePosition);
+    perturbedRotation = Eigen::AngleAxisd(distanceDt * angularVelocity.norm(), angularVelocity.normalized()).toRotationMatrix()
+                        * toEigen(basePose.getRotation());
+    perturbedBasePose.setRotation(Rotation(perturbedRotation(0, 0), perturbedRotation(0, 1), perturbedRotation(0, 2),
+                                           perturbedRotation(1, 0), perturbedRotation(1, 1), perturbedRotation(1, 2),
+                                           perturbedRotation(2, 0), perturbedRotation(2, 1), perturbedRotation(2, 2)));
+    toEigen(perturbedJointPos) = toEigen(jointPos) + distanceDt * toEigen(jointVel);
+    ASSERT_IS_TRUE(distancePerturbedKinDyn.setRobotState(perturbedBasePose, perturbedJointPos, baseVel, jointVel, gravity));
+
+    CollisionComputations perturbedCollisions;
+    ASSERT_IS_TRUE(perturbedCollisions.loadModel(model));
+    perturbedCollisions.addEnvironmentShape(createCylinder(0.2, 1.0), world_H_environment);
+    ASSERT_IS_TRUE(perturbedCollisions.updateShapesPoses(distancePerturbedKinDyn));
+    ASSERT_IS_TRUE(perturbedCollisions.computeDistances(std::numeric_limits<double>::infinity()));
+    ASSERT_EQUAL_DOUBLE(perturbedCollisions.getNrOfCollisionPairs(), collisions.getNrOfCollisionPairs());
+
+    MatrixDynSize distanceJacobian(1, 6 + nrOfDOFs);
+    MatrixDynSize firstPointJacobian(3, 6 + nrOfDOFs);
+    MatrixDynSize secondPointJacobian(3, 6 + nrOfDOFs);
+    for (size_t p = 0; p < collisions.getNrOfCollisionPairs(); p++)
+    {
+        CollisionPair pair = collisions.getCollisionPair(p);
+        ASSERT_IS_TRUE(collisions.getDistanceJacobian(kinDyn, p, distanceJacobian));
+        ASSERT_IS_TRUE(collisions.getWitnessPointsJacobians(kinDyn, p, firstPointJacobian, secondPointJacobian));
+
+        // Velocity of the witness points, attached to their links
+        Position firstPointInLink = kinDyn.getWorldTransform(pair.firstLink).inverse() * pair.firstPoint;
+        Position firstPointVelocity;
+        toEigen(firstPointVelocity) = (toEigen(perturbedKinDyn.getWorldTransform(pair.firstLink) * firstPointInLink)
+                                       - toEigen(pair.firstPoint)) / dt;
+        Position jacobianVelocity;
+        toEigen(jacobianVelocity) = toEigen(firstPointJacobian) * velocity;
+        ASSERT_EQUAL_VECTOR_TOL(firstPointVelocity, jacobianVelocity, 1e-5);
+
+        Position secondPointVelocity;
+        secondPointVelocity.zero();
+        if (pair.secondLink != LINK_INVALID_INDEX)
+        {
+            Position secondPointInLink = kinDyn.getWorldTransform(pair.secondLink).inverse() * pair.secondPoint;
+            toEigen(secondPointVelocity) = (toEigen(perturbedKinDyn.getWorldTransform(pair.secondLink) * secondPointInLink)
+                                            - toEigen(pair.secondPoint)) / dt;
+        }
+        toEigen(jacobianVelocity) = toEigen(secondPointJacobian) * velocity;
+        ASSERT_EQUAL_VECTOR_TOL(secondPointVelocity, jacobianVelocity, 1e-5);
+
+        double distanceVelocity = toEigen(pair.normal).dot(toEigen(secondPointVelocity) - toEigen(firstPointVelocity));
+        ASSERT_EQUAL_DOUBLE_TOL((toEigen(distanceJacobian) * velocity)(0), distanceVelocity, 1e-5);
+
+        // Check the Jacobian against the distance computed after the motion, for the separated pairs
+        if (pair.distance < 1e-2)
+        {
+            continue;
+        }
+        for (size_t q = 0; q < perturbedCollisions.getNrOfCollisionPairs(); q++)
+        {
+            const CollisionPair& perturbedPair = perturbedCollisions.getCollisionPair(q);
+            if (perturbedPair.firstLink == pair.firstLink && perturbedPair.firstShape == pair.firstShape &&
+                perturbedPair.secondLink == pair.secondLink && perturbedPair.secondShape == pair.secondShape)
+            {
+                ASSERT_EQUAL_DOUBLE_TOL((perturbedPair.distance - pair.distance) / distanceDt,
+                                        (toEigen(distanceJacobian) * velocity)(0), 1e-3);
+            }
+        }
+    }
+
+    // The time derivative of the distance does not depend on the representation of the velocity
+    for (FrameVelocityRepresentation representation : {BODY_FIXED_REPRESENTATION, INERTIAL_FIXED_REPRESENTATION})
+    {
+        MatrixDynSize mixedDistanceJacobian(1, 6 + nrOfDOFs);
+        ASSERT_IS_TRUE(kinDyn.setFrameVelocityRepresentation(representation));
+        Twist otherBaseVel = kinDyn.getBaseTwist();
+        Eigen::VectorXd otherVelocity(6 + nrOfDOFs);
+        otherVelocity << toEigen(otherBaseVel.getLinearVec3()), toEigen(otherBaseVel.getAngularVec3()), toEigen(jointVel);
+
+        for (size_t p = 0; p < collisions.getNrOfCollisionPairs(); p++)
+        {
+            ASSERT_IS_TRUE(kinDyn.setFrameVelocityRepresentation(MIXED_REPRESENTATION));
+            ASSERT_IS_TRUE(collisions.getDistanceJacobian(kinDyn, p, mixedDistanceJacobian));
+            ASSERT_IS_TRUE(kinDyn.setFrameVelocityRepresentation(representation));
+            ASSERT_IS_TRUE(collisions.getDistanceJacobian(kinDyn, p, distanceJacobian));
+            ASSERT_EQUAL_DOUBLE_TOL((toEigen(distanceJacobian) * otherVelocity)(0),
+                                    (toEigen(mixedDistanceJacobian) * velocity)(0), 1e-8);
+        }
+    }
+}
+
+int main()
+{
+    testPrimitivesDistances();
+
+    for (int i = 0; i < 5; i++)
+    {
+        Model chain = getRandomChain(10, 0, true);
+        testBroadPhase(chain);
+        Model tree = getRandomModel(10, 0);
+        testBroadPhase(tree);
+    }
+
+    for (int i = 0; i < 5; i++)
+    {
+        Model model = getRandomModel(10, 0);
+        testJacobians(model);
+    }
+
+    return EXIT_SUCCESS;
+}
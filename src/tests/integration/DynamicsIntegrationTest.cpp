@@ -168,6 +168,55 @@ void checkInverseAndForwardDynamicsAreIdempotent(const Model & model,
     ASSERT_EQUAL_VECTOR_TOL(REGR_jointTorques, RNEA_baseForceAndJointTorques.jointTorques(), tolRegr);
 }
 
+void checkGravityGeneralizedForcesAreConsistentWithRNEA(const Model & model,
+                                                        const Traversal & traversal)
+{
+    FreeFloatingPos robotPos(model);
+    FreeFloatingVel robotVel(model);
+    FreeFloatingAcc robotProperAcc(model);
+
+    // Zero velocities and accelerations, only gravity
+    robotPos.worldBasePos() = Transform::Identity();
+    getRandomVector(robotPos.jointPos());
+    robotVel.baseVel().zero();
+    robotVel.jointVel().zero();
+    robotProperAcc.baseAcc().zero();
+    robotProperAcc.jointAcc().zero();
+    Vector3 baseProperLinearAcc;
+    getRandomVector(baseProperLinearAcc,-10.0,10.0);
+    robotProperAcc.baseAcc().setLinearVec3(baseProperLinearAcc);
+
+    LinkVelArray linksVel(model);
+    LinkAccArray linksProperAcc(model);
+    LinkNetExternalWrenches zeroExtWrenches(model);
+    zeroExtWrenches.zero();
+    LinkInternalWrenches linkIntWrenches(model);
+    FreeFloatingGeneralizedTorques RNEA_gravityForces(model);
+    for(LinkIndex link=0; link < static_cast<LinkIndex>(model.getNrOfLinks()); link++)
+    {
+        linksVel(link).zero();
+    }
+
+    bool ok = ForwardAccKinematics(model,traversal,robotPos,robotVel,robotProperAcc,linksVel,linksProperAcc);
+    ok = ok && RNEADynamicPhase(model,traversal,robotPos.jointPos(),linksVel,linksProperAcc,
+                                zeroExtWrenches,linkIntWrenches,RNEA_gravityForces);
+    ASSERT_IS_TRUE(ok);
+
+    // The proper acceleration can be specified in any link
+    LinkIndex referenceLink = getRandomInteger(0,model.getNrOfLinks()-1);
+    Vector3 referenceLinkProperLinearAcc = linksProperAcc(referenceLink).getLinearVec3();
+
+    GravityGeneralizedForcesInternalBuffers buffers(model);
+    FreeFloatingGeneralizedTorques gravityForces(model);
+    ok = ComputeGravityGeneralizedForces(model,traversal,robotPos.jointPos(),
+                                         referenceLink,referenceLinkProperLinearAcc,
+                                         buffers,gravityForces);
+    ASSERT_IS_TRUE(ok);
+
+    ASSERT_EQUAL_VECTOR_TOL(gravityForces.baseWrench().asVector(), RNEA_gravityForces.baseWrench().asVector(), 1e-8);
+    ASSERT_EQUAL_VECTOR_TOL(gravityForces.jointTorques(), RNEA_gravityForces.jointTorques(), 1e-8);
+}
+
 int main()
 {
     for(unsigned int mdl = 0; mdl < IDYNTREE_TESTS_URDFS_NR; mdl++ )
@@ -182,5 +231,6 @@ int main()
         ok = model.computeFullTreeTraversal(traversal);
         assert(ok);
         checkInverseAndForwardDynamicsAreIdempotent(model,traversal);
+        checkGravityGeneralizedForcesAreConsistentWithRNEA(model,traversal);
     }
 }